@@ -0,0 +1,67 @@
+#include <vector>
+
+#include <celero/Celero.h>
+
+#include "noise/Noise.hpp"
+#include "ThreadPool.hpp"
+
+CELERO_MAIN
+
+class Fixture : public celero::TestFixture
+{
+public:
+	std::vector<celero::TestFixture::ExperimentValue> getExperimentValues() const override
+	{
+		// Grid width and height
+		return {{256}, {1024}, {4096}};
+	}
+
+	void setUp(const celero::TestFixture::ExperimentValue& experimentValue) override
+	{
+		size = static_cast<uint32_t>(experimentValue.Value);
+		values.resize(static_cast<size_t>(size) * size);
+
+		noise.setNoiseType(FastNoise::SimplexFractal);
+		noise.setFrequency(0.01f);
+		noise.setFractalOctaves(4);
+	}
+
+	void tearDown() override
+	{
+		values.clear();
+		values.shrink_to_fit();
+	}
+
+	ice_engine::noise::Noise noise{1337};
+	ice_engine::ThreadPool threadPool;
+
+	uint32_t size = 0;
+	std::vector<float> values;
+};
+
+BASELINE_F(NoiseGrid, GetNoise, Fixture, 3, 1)
+{
+	for (uint32_t j = 0; j < size; ++j)
+	{
+		for (uint32_t i = 0; i < size; ++i)
+		{
+			values[j * size + i] = noise.getNoise(static_cast<float>(i), static_cast<float>(j));
+		}
+	}
+
+	celero::DoNotOptimizeAway(values[0]);
+}
+
+BENCHMARK_F(NoiseGrid, FillGrid, Fixture, 3, 1)
+{
+	noise.fillGrid(values.data(), glm::vec2(0.0f), glm::vec2(1.0f), size, size);
+
+	celero::DoNotOptimizeAway(values[0]);
+}
+
+BENCHMARK_F(NoiseGrid, FillGridThreadPool, Fixture, 3, 1)
+{
+	noise.fillGrid(values.data(), glm::vec2(0.0f), glm::vec2(1.0f), size, size, &threadPool);
+
+	celero::DoNotOptimizeAway(values[0]);
+}
@@ -0,0 +1,255 @@
+#include <fstream>
+
+#include <celero/Celero.h>
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "GameEngine.hpp"
+#include "Scene.hpp"
+#include "PluginManager.hpp"
+
+#include "ecs/DirtyComponent.hpp"
+
+#include "fs/FileSystem.hpp"
+#include "utilities/Properties.hpp"
+#include "logger/Logger.hpp"
+
+CELERO_MAIN
+
+namespace
+{
+
+// Headless, so no window and no plugins, and on a fixed clock so every run simulates the same ticks
+const std::string SETTINGS = R"END(
+[engine]
+headless=true
+
+[simulation]
+fixeddelta=0.0166667
+
+[logging]
+async=false
+)END";
+
+const std::string SCRIPT = R"END(
+uint64 ticks = 0;
+
+class Mover
+{
+	void tick(const float delta)
+	{
+		ticks++;
+	}
+
+	void serialize(Entity entity)
+	{
+	}
+
+	void deserialize(Entity entity)
+	{
+	}
+}
+)END";
+
+const ice_engine::float32 TICK_DELTA = 1.0f / 60.0f;
+
+std::unique_ptr<ice_engine::GameEngine> createGameEngine()
+{
+	auto properties = std::make_unique<ice_engine::utilities::Properties>(SETTINGS);
+	auto fileSystem = std::make_unique<ice_engine::fs::FileSystem>();
+	auto logger = std::make_unique<ice_engine::logger::Logger>();
+	auto pluginManager = std::make_unique<ice_engine::PluginManager>(properties.get(), fileSystem.get(), logger.get());
+
+	return std::make_unique<ice_engine::GameEngine>(std::move(properties), std::move(fileSystem), std::move(pluginManager), std::move(logger));
+}
+
+// Uncompressed 24 bit tga, so loading measures the decoding and copying rather than decompression
+void writeImage(const std::string& filename, const ice_engine::uint32 size)
+{
+	char header[18] = {};
+	header[2] = 2;
+	header[12] = static_cast<char>(size & 0xFF);
+	header[13] = static_cast<char>(size >> 8);
+	header[14] = static_cast<char>(size & 0xFF);
+	header[15] = static_cast<char>(size >> 8);
+	header[16] = 24;
+
+	std::vector<char> pixels(size * size * 3);
+	for (size_t i = 0; i < pixels.size(); ++i) pixels[i] = static_cast<char>(i * 7);
+
+	std::ofstream file(filename, std::ios::binary);
+	file.write(header, sizeof(header));
+	file.write(pixels.data(), static_cast<std::streamsize>(pixels.size()));
+}
+
+}
+
+class Fixture : public celero::TestFixture
+{
+public:
+	std::vector<celero::TestFixture::ExperimentValue> getExperimentValues() const override
+	{
+		return {{100}, {1000}, {10000}};
+	}
+
+	void setUp(const celero::TestFixture::ExperimentValue& experimentValue) override
+	{
+		gameEngine = createGameEngine();
+		filename = gameEngine->fileSystem()->generateTempFilename();
+
+		moduleHandle = gameEngine->scriptingEngine()->createModule("benchmark", {SCRIPT});
+		scene = gameEngine->createScene("benchmark", moduleHandle);
+		collisionShapeHandle = gameEngine->createStaticSphereShape("sphere", 1.0f);
+
+		entities.clear();
+
+		for (int64_t i = 0; i < experimentValue.Value; ++i)
+		{
+			entities.push_back(createEntity(static_cast<float>(i)));
+		}
+
+		// Listeners and dirty flags settle on the first tick
+		scene->tick(TICK_DELTA);
+	}
+
+	void tearDown() override
+	{
+		gameEngine->destroyScene(scene);
+		gameEngine->scriptingEngine()->destroyModule(moduleHandle);
+
+		if (gameEngine->fileSystem()->exists(filename)) gameEngine->fileSystem()->deleteFile(filename);
+
+		gameEngine.reset();
+	}
+
+	virtual ice_engine::ecs::Entity createEntity(const float value) = 0;
+
+	std::unique_ptr<ice_engine::GameEngine> gameEngine;
+	ice_engine::scripting::ModuleHandle moduleHandle;
+	ice_engine::Scene* scene = nullptr;
+	ice_engine::physics::CollisionShapeHandle collisionShapeHandle;
+	std::vector<ice_engine::ecs::Entity> entities;
+
+	// Serialized scenes go to a temporary file rather than the working directory
+	std::string filename;
+};
+
+class StaticFixture : public Fixture
+{
+public:
+	ice_engine::ecs::Entity createEntity(const float value) override
+	{
+		auto entity = scene->createEntity();
+
+		entity.assign<ice_engine::ecs::PositionComponent>(glm::vec3(value, 0.0f, -value));
+		entity.assign<ice_engine::ecs::OrientationComponent>(glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+
+		return entity;
+	}
+};
+
+class PhysicsFixture : public Fixture
+{
+public:
+	ice_engine::ecs::Entity createEntity(const float value) override
+	{
+		auto entity = scene->createEntity();
+
+		entity.assign<ice_engine::ecs::PositionComponent>(glm::vec3(value, 100.0f, -value));
+		entity.assign<ice_engine::ecs::OrientationComponent>(glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+		entity.assign<ice_engine::ecs::RigidBodyObjectComponent>(collisionShapeHandle, 1.0f, 1.0f, 1.0f);
+
+		return entity;
+	}
+};
+
+class ScriptedFixture : public Fixture
+{
+public:
+	ice_engine::ecs::Entity createEntity(const float value) override
+	{
+		auto entity = scene->createEntity();
+
+		entity.assign<ice_engine::ecs::PositionComponent>(glm::vec3(value, 100.0f, -value));
+		entity.assign<ice_engine::ecs::OrientationComponent>(glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+		entity.assign<ice_engine::ecs::RigidBodyObjectComponent>(collisionShapeHandle, 1.0f, 1.0f, 1.0f);
+		entity.assign<ice_engine::ecs::ScriptObjectComponent>(gameEngine->scriptingEngine()->createUninitializedScriptObject(moduleHandle, "Mover"));
+
+		return entity;
+	}
+};
+
+// Entities that never change - the cost of the tick itself
+BASELINE_F(SceneTick, Static, StaticFixture, 10, 100)
+{
+	scene->tick(TICK_DELTA);
+}
+
+// Every body moves every tick, so every entity takes the physics change back
+BENCHMARK_F(SceneTick, Physics, PhysicsFixture, 10, 100)
+{
+	scene->tick(TICK_DELTA);
+}
+
+BENCHMARK_F(SceneTick, Scripted, ScriptedFixture, 10, 100)
+{
+	scene->tick(TICK_DELTA);
+}
+
+// Every entity moved by a script every tick - the applyChangesToEntities stage on top of the static tick
+BENCHMARK_F(SceneTick, ScriptMoved, StaticFixture, 10, 100)
+{
+	for (auto& entity : entities)
+	{
+		entity.component<ice_engine::ecs::PositionComponent>()->position.y += 0.01f;
+		entity.assign<ice_engine::ecs::DirtyComponent>(ice_engine::ecs::DirtyFlags::DIRTY_SOURCE_SCRIPT | ice_engine::ecs::DirtyFlags::DIRTY_POSITION);
+	}
+
+	scene->tick(TICK_DELTA);
+}
+
+BASELINE_F(SceneSerialize, Physics, PhysicsFixture, 10, 10)
+{
+	scene->serialize("scene_benchmark.bin");
+}
+
+BENCHMARK_F(SceneSerialize, Scripted, ScriptedFixture, 10, 10)
+{
+	scene->serialize("scene_benchmark.bin");
+}
+
+class ImageFixture : public celero::TestFixture
+{
+public:
+	std::vector<celero::TestFixture::ExperimentValue> getExperimentValues() const override
+	{
+		return {{256}, {1024}, {2048}};
+	}
+
+	void setUp(const celero::TestFixture::ExperimentValue& experimentValue) override
+	{
+		gameEngine = createGameEngine();
+		filename = gameEngine->fileSystem()->generateTempFilename() + ".tga";
+
+		writeImage(filename, static_cast<ice_engine::uint32>(experimentValue.Value));
+	}
+
+	void tearDown() override
+	{
+		gameEngine->fileSystem()->deleteFile(filename);
+
+		gameEngine.reset();
+	}
+
+	std::unique_ptr<ice_engine::GameEngine> gameEngine;
+	std::string filename;
+};
+
+// Loading from disk through the resource cache - models need assimp and model files, so only images are measured
+BASELINE_F(AssetLoading, Image, ImageFixture, 10, 10)
+{
+	gameEngine->loadImage("benchmark", filename);
+	gameEngine->unloadImage("benchmark");
+}
@@ -0,0 +1,134 @@
+#include <sstream>
+
+#include <celero/Celero.h>
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+
+#include "SceneSnapshot.hpp"
+
+#include "ecs/EntityComponentSystem.hpp"
+
+#include "serialization/TextOutArchive.hpp"
+#include "serialization/TextInArchive.hpp"
+
+#include "logger/Logger.hpp"
+
+CELERO_MAIN
+
+class Fixture : public celero::TestFixture
+{
+public:
+	std::vector<celero::TestFixture::ExperimentValue> getExperimentValues() const override
+	{
+		return {{1000}, {10000}, {100000}};
+	}
+
+	void setUp(const celero::TestFixture::ExperimentValue& experimentValue) override
+	{
+		entityComponentSystem = std::make_unique<ice_engine::ecs::EntityComponentSystem>(nullptr);
+
+		for (int64_t i = 0; i < experimentValue.Value; ++i)
+		{
+			auto entity = entityComponentSystem->create();
+
+			const float value = static_cast<float>(i);
+			entityComponentSystem->assign<ice_engine::ecs::PositionComponent>(entity.id(), glm::vec3(value, value * 0.5f, -value));
+			entityComponentSystem->assign<ice_engine::ecs::OrientationComponent>(entity.id(), glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+			entityComponentSystem->assign<ice_engine::ecs::PersistableComponent>(entity.id());
+		}
+
+		{
+			std::ostringstream stream;
+			ice_engine::serialization::TextOutArchive ar(stream);
+			ar & *entityComponentSystem;
+			text = stream.str();
+		}
+
+		{
+			std::ostringstream stream;
+			ice_engine::SceneSnapshotWriter writer(stream, true);
+			writer.writeEntities(*entityComponentSystem);
+			writer.finish();
+			snapshot = stream.str();
+		}
+	}
+
+	void tearDown() override
+	{
+		entityComponentSystem.reset();
+	}
+
+	std::unique_ptr<ice_engine::logger::ILogger> logger = std::make_unique<ice_engine::logger::Logger>();
+	std::unique_ptr<ice_engine::ecs::EntityComponentSystem> entityComponentSystem;
+
+	std::string text;
+	std::string snapshot;
+};
+
+BASELINE_F(SceneSave, TextArchive, Fixture, 10, 10)
+{
+	std::ostringstream stream;
+	ice_engine::serialization::TextOutArchive ar(stream);
+	ar & *entityComponentSystem;
+
+	celero::DoNotOptimizeAway(stream.str().size());
+}
+
+BENCHMARK_F(SceneSave, Snapshot, Fixture, 10, 10)
+{
+	std::ostringstream stream;
+	ice_engine::SceneSnapshotWriter writer(stream, false);
+	writer.writeEntities(*entityComponentSystem);
+	writer.finish();
+
+	celero::DoNotOptimizeAway(stream.str().size());
+}
+
+BENCHMARK_F(SceneSave, CompressedSnapshot, Fixture, 10, 10)
+{
+	std::ostringstream stream;
+	ice_engine::SceneSnapshotWriter writer(stream, true);
+	writer.writeEntities(*entityComponentSystem);
+	writer.finish();
+
+	celero::DoNotOptimizeAway(stream.str().size());
+}
+
+// What a background save costs the tick - copying the component data
+BENCHMARK_F(SceneSave, Capture, Fixture, 10, 10)
+{
+	ice_engine::EntitySnapshot entitySnapshot(*entityComponentSystem);
+
+	celero::DoNotOptimizeAway(entitySnapshot.indices().size());
+}
+
+// Finding the changed entities for an incremental save, done on the background thread
+BENCHMARK_F(SceneSave, IncrementalChanges, Fixture, 10, 10)
+{
+	ice_engine::EntitySnapshot entitySnapshot(*entityComponentSystem);
+
+	celero::DoNotOptimizeAway(entitySnapshot.hashes().size());
+}
+
+BASELINE_F(SceneLoad, TextArchive, Fixture, 10, 10)
+{
+	ice_engine::ecs::EntityComponentSystem loaded(nullptr);
+
+	std::istringstream stream(text);
+	ice_engine::serialization::TextInArchive ar(stream);
+	ar & loaded;
+
+	celero::DoNotOptimizeAway(loaded.numEntities());
+}
+
+BENCHMARK_F(SceneLoad, CompressedSnapshot, Fixture, 10, 10)
+{
+	ice_engine::ecs::EntityComponentSystem loaded(nullptr);
+
+	std::istringstream stream(snapshot);
+	ice_engine::SceneSnapshotReader reader(stream, logger.get());
+	reader.readEntities(loaded);
+
+	celero::DoNotOptimizeAway(loaded.numEntities());
+}
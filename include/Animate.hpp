@@ -5,6 +5,7 @@
 #include <unordered_map>
 #include <string>
 #include <chrono>
+#include <limits>
 
 #define GLM_FORCE_RADIANS
 #include <glm/glm.hpp>
@@ -22,6 +23,16 @@ void animateSkeleton(std::vector< glm::mat4 >& transformations, const glm::mat4&
 void animateSkeleton(std::vector< glm::mat4 >& transformations, const glm::mat4& globalInverseTransformation, const std::unordered_map< std::string, AnimatedBoneNode >& animatedBoneNodes, const BoneNode& rootBoneNode, const BoneData& boneData, std::chrono::duration<float32> duration, float32 ticksPerSecond, std::chrono::duration<float32> runningTime, std::vector<uint32>& indexCache);
 void animateSkeleton(std::vector< glm::mat4 >& transformations, const glm::mat4& globalInverseTransformation, const std::unordered_map< std::string, AnimatedBoneNode >& animatedBoneNodes, const BoneNode& rootBoneNode, const BoneData& boneData, std::chrono::duration<float32> duration, float32 ticksPerSecond, std::chrono::duration<float32> runningTime, std::vector<uint32>& indexCache, uint32 startFrame, uint32 endFrame);
 
+/**
+ * Animate into caller owned storage (i.e. a bone palette arena) - nothing is allocated.
+ *
+ * Only the transformations of bones in the hierarchy are written, the caller is responsible for initializing the rest.
+ * Bones deeper in the hierarchy than maxAnimatedDepth are not sampled and keep their rest transformation (used for
+ * animation LOD).
+ */
+void animateSkeleton(glm::mat4* transformations, uint32 numberOfTransformations, const glm::mat4& globalInverseTransformation, const std::unordered_map< std::string, AnimatedBoneNode >& animatedBoneNodes, const BoneNode& rootBoneNode, const BoneData& boneData, std::chrono::duration<float32> duration, float32 ticksPerSecond, std::chrono::duration<float32> runningTime, uint32 maxAnimatedDepth = std::numeric_limits<uint32>::max());
+void animateSkeleton(glm::mat4* transformations, uint32 numberOfTransformations, const glm::mat4& globalInverseTransformation, const std::unordered_map< std::string, AnimatedBoneNode >& animatedBoneNodes, const BoneNode& rootBoneNode, const BoneData& boneData, std::chrono::duration<float32> duration, float32 ticksPerSecond, std::chrono::duration<float32> runningTime, uint32 startFrame, uint32 endFrame, uint32 maxAnimatedDepth = std::numeric_limits<uint32>::max());
+
 }
 
 #endif /* ANIMATE_H_ */
@@ -0,0 +1,53 @@
+#ifndef ANIMATIONLODSETTINGS_H_
+#define ANIMATIONLODSETTINGS_H_
+
+#include "utilities/Properties.hpp"
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+
+/**
+ * Thresholds for animation level of detail, read from the [animation] section of the settings.
+ *
+ * Distances are from the scene's animation LOD camera:
+ *  - closer than halfRateDistance, skeletons are sampled every tick
+ *  - closer than quarterRateDistance, every 2nd tick
+ *  - anything further, every 4th tick
+ *  - further than cullDistance (or outside the camera's field of view), not at all
+ * In between samples the bone palettes are interpolated.  Beyond reducedBonesDistance, only the top reducedBonesDepth
+ * levels of the bone hierarchy are sampled.
+ */
+struct AnimationLodSettings
+{
+	AnimationLodSettings() = default;
+
+	AnimationLodSettings(const utilities::Properties& properties)
+	:
+		enabled(properties.getBoolValue("animation.lod", false)),
+		halfRateDistance(properties.getFloatValue("animation.halfratedistance", 30.0f)),
+		quarterRateDistance(properties.getFloatValue("animation.quarterratedistance", 60.0f)),
+		cullDistance(properties.getFloatValue("animation.culldistance", 250.0f)),
+		reducedBonesDistance(properties.getFloatValue("animation.reducedbonesdistance", 60.0f)),
+		reducedBonesDepth(static_cast<uint32>(properties.getIntValue("animation.reducedbonesdepth", 4))),
+		fieldOfView(properties.getFloatValue("animation.fieldofview", 90.0f)),
+		boundingRadius(properties.getFloatValue("animation.boundingradius", 2.0f))
+	{
+	}
+
+	bool enabled = false;
+	float32 halfRateDistance = 30.0f;
+	float32 quarterRateDistance = 60.0f;
+	float32 cullDistance = 250.0f;
+	float32 reducedBonesDistance = 60.0f;
+	uint32 reducedBonesDepth = 4;
+
+	// Full angle in degrees
+	float32 fieldOfView = 90.0f;
+	float32 boundingRadius = 2.0f;
+};
+
+}
+
+#endif /* ANIMATIONLODSETTINGS_H_ */
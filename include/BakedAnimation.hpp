@@ -0,0 +1,119 @@
+#ifndef BAKEDANIMATION_H_
+#define BAKEDANIMATION_H_
+
+#include <vector>
+#include <unordered_map>
+#include <string>
+#include <chrono>
+#include <limits>
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "Animation.hpp"
+#include "Skeleton.hpp"
+#include "Mesh.hpp"
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+
+/**
+ * An animation clip resampled at a fixed rate into a table of quantized poses.
+ *
+ * Every animated bone gets one pose per sample: the rotation is stored as the 'smallest three' components of the
+ * quaternion (15 bits each, plus the index of the dropped component), and the translation and scaling as 16 bit
+ * values within the bone's range over the clip.  Sampling a bone is two table fetches and a lerp, instead of searching
+ * the key frames and interpolating each channel.
+ *
+ * Start and end frames are resolved against the key frame times of the bone with the most position keys, so bones
+ * are assumed to share their key frame times (which is the case for clips exported with a fixed sample rate).
+ */
+class BakedAnimation
+{
+public:
+	BakedAnimation() = default;
+
+	/**
+	 * @param animation The clip to bake.
+	 * @param sampleRate Samples per second of animation.
+	 */
+	BakedAnimation(const Animation& animation, const float32 sampleRate);
+
+	/**
+	 * Same contract as the non baked animateSkeleton(glm::mat4*, ...) - only transformations of bones in the hierarchy are written.
+	 */
+	void animateSkeleton(
+		glm::mat4* transformations,
+		const uint32 numberOfTransformations,
+		const glm::mat4& globalInverseTransformation,
+		const BoneNode& rootBoneNode,
+		const BoneData& boneData,
+		const std::chrono::duration<float32> runningTime,
+		const uint32 startFrame = 0,
+		const uint32 endFrame = 0,
+		const uint32 maxAnimatedDepth = std::numeric_limits<uint32>::max()
+	) const;
+
+	uint32 numberOfSamples() const;
+	float32 sampleRate() const;
+
+	/**
+	 * Size in bytes of the pose table.
+	 */
+	size_t memoryUsage() const;
+
+	static void compress(const glm::quat& quaternion, uint16* result);
+	static glm::quat decompress(const uint16* compressed);
+
+private:
+	struct QuantizedPose
+	{
+		uint16 rotation[3];
+		uint16 translation[3];
+		uint16 scaling[3];
+	};
+
+	struct Track
+	{
+		glm::vec3 translationMinimum;
+		glm::vec3 translationExtent;
+		glm::vec3 scalingMinimum;
+		glm::vec3 scalingExtent;
+		uint32 numberOfPositionKeyFrames = 0;
+	};
+
+	float32 sampleRate_ = 0.0f;
+	float32 ticksPerSecond_ = 0.0f;
+	float32 ticksPerSample_ = 0.0f;
+	std::chrono::duration<float32> duration_ = std::chrono::duration<float32>(0.0f);
+	uint32 numberOfSamples_ = 0;
+
+	std::unordered_map<std::string, uint32> trackIndices_;
+	std::vector<Track> tracks_;
+	std::vector<std::chrono::duration<float32>> keyFrameTimes_;
+
+	// Sample major - all of the tracks' poses for a sample are contiguous
+	std::vector<QuantizedPose> poses_;
+
+	glm::mat4 sample(const uint32 track, const std::chrono::duration<float32> animationTime) const;
+
+	void readNodeHeirarchy(
+		glm::mat4* transformations,
+		const std::chrono::duration<float32> animationTime,
+		const glm::mat4& globalInverseTransformation,
+		const BoneNode& rootBoneNode,
+		const BoneData& boneData,
+		const uint32 startFrame,
+		const uint32 endFrame,
+		const glm::mat4& parentTransformation,
+		const uint32 depth,
+		const uint32 maxAnimatedDepth
+	) const;
+};
+
+}
+
+#endif /* BAKEDANIMATION_H_ */
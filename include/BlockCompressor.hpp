@@ -0,0 +1,41 @@
+#ifndef BLOCKCOMPRESSOR_H_
+#define BLOCKCOMPRESSOR_H_
+
+#include <vector>
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+
+/**
+ * Fast lossless compression of in memory blocks, using the LZ4 block format.
+ *
+ * Compression is a single greedy pass with a hash table of recent 4 byte sequences, and decompression is
+ * literal and match copies - both run at memory speeds rather than disk speeds, so compressing blocks before
+ * writing them is close to free.
+ */
+class BlockCompressor
+{
+public:
+	/**
+	 * Compress size bytes from source.
+	 */
+	static std::vector<byte> compress(const byte* source, const size_t size);
+
+	/**
+	 * Decompress a block produced by compress into destination, which must be exactly the size of the original data.
+	 *
+	 * Throws a RuntimeException if the block is malformed.
+	 */
+	static void decompress(const byte* source, const size_t sourceSize, byte* destination, const size_t destinationSize);
+
+	/**
+	 * Worst case compressed size of size bytes.
+	 */
+	static size_t compressBound(const size_t size);
+};
+
+}
+
+#endif /* BLOCKCOMPRESSOR_H_ */
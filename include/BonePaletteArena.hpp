@@ -0,0 +1,82 @@
+#ifndef BONEPALETTEARENA_H_
+#define BONEPALETTEARENA_H_
+
+#include <array>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+
+/**
+ * Triple buffered storage for bone palettes.
+ *
+ * Animation workers allocate a palette from the current frame's buffer (a lock free bump allocation), write the
+ * bone transformations straight into it and hand the palette to the render thread, which reads it in place.  A
+ * frame's buffer is only reused NUMBER_OF_FRAMES frames later, so the render thread can lag behind the workers by
+ * up to NUMBER_OF_FRAMES - 1 frames without the data being overwritten underneath it.
+ */
+class BonePaletteArena
+{
+public:
+	static constexpr uint32 NUMBER_OF_FRAMES = 3;
+
+	struct Palette
+	{
+		glm::mat4* transformations = nullptr;
+		uint32 size = 0;
+		uint64 frame = 0;
+	};
+
+	/**
+	 * @param capacity The initial number of matrices per frame - the arena grows to fit the largest frame seen.
+	 */
+	BonePaletteArena(const uint32 capacity = 100 * 64);
+
+	/**
+	 * Start a new frame - must not be called while any allocation is in progress (i.e. once per tick, before animation work is posted).
+	 */
+	void beginFrame();
+
+	/**
+	 * Allocate a palette of size matrices from the current frame, initialized to identity.  Safe to call from any thread.
+	 */
+	Palette allocate(const uint32 size);
+
+	/**
+	 * Returns true if the palette's storage has not been reused by a later frame yet.
+	 */
+	bool valid(const Palette& palette) const;
+
+	uint64 frame() const;
+
+	/**
+	 * Number of palettes in the current frame that didn't fit in its buffer.
+	 */
+	uint32 overflows() const;
+
+private:
+	struct Frame
+	{
+		std::vector<glm::mat4> buffer;
+		std::atomic<uint32> offset{0};
+
+		// Allocations that didn't fit in the buffer - the buffer is grown to fit them the next time the frame is reused
+		mutable std::mutex overflowMutex;
+		std::vector<std::unique_ptr<glm::mat4[]>> overflow;
+	};
+
+	std::array<Frame, NUMBER_OF_FRAMES> frames_;
+	std::atomic<uint64> frame_{0};
+};
+
+}
+
+#endif /* BONEPALETTEARENA_H_ */
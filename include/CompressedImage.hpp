@@ -0,0 +1,92 @@
+#ifndef COMPRESSEDIMAGE_H_
+#define COMPRESSEDIMAGE_H_
+
+#include <vector>
+
+#include "graphics/ICompressedImage.hpp"
+
+#include "detail/Assert.hpp"
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+
+class CompressedImage : public graphics::ICompressedImage
+{
+public:
+	struct Level
+	{
+		Level() = default;
+
+		Level(uint32 width, uint32 height, std::vector<byte> data)
+		:
+			width(width),
+			height(height),
+			data(std::move(data))
+		{
+		}
+
+		uint32 width = 0;
+		uint32 height = 0;
+		std::vector<byte> data;
+	};
+
+	CompressedImage() = default;
+
+	CompressedImage(std::vector<Level> levels, graphics::ICompressedImage::Format format)
+	:
+		levels_(std::move(levels)),
+		format_(format)
+	{
+	}
+
+	~CompressedImage() override = default;
+
+	uint32 levels() const override
+	{
+		return static_cast<uint32>(levels_.size());
+	}
+
+	const std::vector<byte>& data(const uint32 level) const override
+	{
+		ICE_ENGINE_ASSERT(level < levels_.size());
+
+		return levels_[level].data;
+	}
+
+	uint32 width(const uint32 level) const override
+	{
+		ICE_ENGINE_ASSERT(level < levels_.size());
+
+		return levels_[level].width;
+	}
+
+	uint32 height(const uint32 level) const override
+	{
+		ICE_ENGINE_ASSERT(level < levels_.size());
+
+		return levels_[level].height;
+	}
+
+	int32 format() const override
+	{
+		return format_;
+	}
+
+	/**
+	 * Returns the size in bytes of a single 4x4 block for the given format (8 for BC1, 16 for everything else).
+	 */
+	static uint32 blockSize(const graphics::ICompressedImage::Format format)
+	{
+		return (format == graphics::ICompressedImage::Format::FORMAT_BC1 ? 8 : 16);
+	}
+
+private:
+	std::vector<Level> levels_;
+	graphics::ICompressedImage::Format format_ = graphics::ICompressedImage::Format::FORMAT_UNKNOWN;
+};
+
+}
+
+#endif /* COMPRESSEDIMAGE_H_ */
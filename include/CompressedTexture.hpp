@@ -0,0 +1,48 @@
+#ifndef COMPRESSEDTEXTURE_H_
+#define COMPRESSEDTEXTURE_H_
+
+#include <string>
+
+#include "graphics/ICompressedTexture.hpp"
+
+#include "CompressedImage.hpp"
+
+namespace ice_engine
+{
+
+class CompressedTexture : public graphics::ICompressedTexture
+{
+public:
+
+	CompressedTexture() = default;
+
+	CompressedTexture(
+		std::string name,
+		const CompressedImage* image
+	)
+	:
+		name_(std::move(name)),
+		image_(image)
+	{
+	}
+
+	~CompressedTexture() override = default;
+
+	const std::string& name() const override
+	{
+		return name_;
+	}
+
+	const graphics::ICompressedImage* image() const override
+	{
+		return image_;
+	}
+
+private:
+	std::string name_;
+	const CompressedImage* image_ = nullptr;
+};
+
+}
+
+#endif /* COMPRESSEDTEXTURE_H_ */
@@ -12,6 +12,10 @@ struct EngineStatistics
 {
 	float32 fps;
     std::chrono::duration<float32> renderTime;
+
+	// Simulation ticks run in the last frame, and wall clock seconds the simulation has fallen behind in total
+	uint32 ticks = 0;
+	float32 droppedTime = 0.0f;
 };
 
 }
@@ -17,6 +17,9 @@ public:
 	void receive(const entityx::EntityDestroyedEvent& event);
 	void receive(const entityx::ComponentAddedEvent<ecs::GraphicsComponent>& event);
 	void receive(const entityx::ComponentRemovedEvent<ecs::GraphicsComponent>& event);
+	void receive(const entityx::ComponentRemovedEvent<ecs::GraphicsTerrainComponent>& event);
+	void receive(const entityx::ComponentAddedEvent<ecs::PositionComponent>& event);
+	void receive(const entityx::ComponentRemovedEvent<ecs::PositionComponent>& event);
 	void receive(const entityx::ComponentRemovedEvent<ecs::AnimationComponent>& event);
 	void receive(const entityx::ComponentRemovedEvent<ecs::RigidBodyObjectComponent>& event);
 	void receive(const entityx::ComponentRemovedEvent<ecs::GhostObjectComponent>& event);
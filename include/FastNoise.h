@@ -161,6 +161,14 @@ public:
 	// Returns the maximum warp distance from original location when using GradientPerturb{Fractal}(...)
 	FN_DECIMAL GetGradientPerturbAmp() const { return m_gradientPerturbAmp; }
 
+	// Lookup tables and derived state, for evaluating noise in batches outside of FastNoise (ice_engine noise::Noise::fillGrid)
+	const unsigned char* GetPermutationTable() const { return m_perm; }
+	const unsigned char* GetPermutationTable12() const { return m_perm12; }
+	FN_DECIMAL GetFractalBounding() const { return m_fractalBounding; }
+	static const FN_DECIMAL* GetValueLookupTable();
+	static const FN_DECIMAL* GetGradientTableX();
+	static const FN_DECIMAL* GetGradientTableY();
+
 	//2D
 	FN_DECIMAL GetValue(FN_DECIMAL x, FN_DECIMAL y) const;
 	FN_DECIMAL GetValueFractal(FN_DECIMAL x, FN_DECIMAL y) const;
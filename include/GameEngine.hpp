@@ -18,12 +18,16 @@
 #include <glm/glm.hpp>
 #include <glm/glm.hpp>
 
+#include <boost/thread/shared_mutex.hpp>
+#include <boost/thread/shared_lock_guard.hpp>
+
 #include "graphics/exceptions/GraphicsException.hpp"
 
 #include "Platform.hpp"
 #include "Types.hpp"
 
 #include "EngineStatistics.hpp"
+#include "SimulationClock.hpp"
 #include "IThreadPool.hpp"
 #include "IOpenGlLoader.hpp"
 #include "ModelHandle.hpp"
@@ -64,6 +68,8 @@
 #include "IPluginManager.hpp"
 
 #include "Heightfield.hpp"
+#include "TextureCache.hpp"
+#include "CompressedTexture.hpp"
 #include "PathfindingTerrain.hpp"
 
 #include "graphics/IGraphicsEngineFactory.hpp"
@@ -78,6 +84,7 @@
 
 #include "networking/INetworkingEngineFactory.hpp"
 #include "networking/INetworkingEngine.hpp"
+#include "networking/BatchingNetworkingEngine.hpp"
 #include "networking/IEventListener.hpp"
 
 #include "pathfinding/IPathfindingEngineFactory.hpp"
@@ -92,6 +99,11 @@
 #include "Model.hpp"
 
 #include "Animate.hpp"
+#include "BonePaletteArena.hpp"
+#include "RenderState.hpp"
+#include "Profiler.hpp"
+#include "Metrics.hpp"
+#include "BakedAnimation.hpp"
 
 namespace ice_engine
 {
@@ -126,6 +138,32 @@ public:
 
 	const EngineStatistics& getEngineStatistics() const;
 
+	/**
+	 * Timings of a profiler zone - only recorded when built with ICEENGINE_ENABLE_PROFILING and the profiler is enabled.
+	 */
+	const ProfileZoneStatistics& getProfileZoneStatistics(const std::string& name) const;
+	void setProfilerEnabled(const bool enabled);
+	bool profilerEnabled() const;
+
+	/**
+	 * Writes the profiler's recent zones as a Chrome trace (open it in chrome://tracing or Perfetto).
+	 */
+	void exportProfile(const std::string& filename) const;
+
+	/**
+	 * Telemetry - counters only go up, gauges are set, and histograms record a distribution of values.
+	 */
+	void incrementCounter(const std::string& name, const uint64 value);
+	uint64 getCounter(const std::string& name) const;
+	void setGauge(const std::string& name, const int64 value);
+	int64 getGauge(const std::string& name) const;
+	void recordHistogram(const std::string& name, const uint64 value);
+
+	/**
+	 * Appends every metric to the metrics file now, rather than waiting for the next periodic dump.
+	 */
+	void dumpMetrics() const;
+
 	void setIGameInstance(void* object);
 
 	/**
@@ -142,10 +180,6 @@ public:
 	IThreadPool* backgroundThreadPool() const;
 	IThreadPool* foregroundThreadPool() const;
 	IOpenGlLoader* openGlLoader() const;
-	IOpenGlLoader* foregroundGraphicsThreadPool() const
-	{
-		return forgroundGraphicsThreadPool_.get();
-	}
 	logger::ILogger* logger() const;
 	fs::IFileSystem* fileSystem() const;
 	ResourceCache& resourceCache()
@@ -562,6 +596,61 @@ public:
         const SkeletonHandle& skeletonHandle
     );
 
+    /**
+     * Animate into a palette allocated from the bone palette arena for the current frame.
+     *
+     * The palette can be handed to the render thread as is - it stays valid until the arena reuses the frame.
+     */
+    BonePaletteArena::Palette animateSkeleton(
+        const std::chrono::duration<float32> runningTime,
+        const uint32 startFrame,
+        const uint32 endFrame,
+        const graphics::MeshHandle& meshHandle,
+        const AnimationHandle& animationHandle,
+        const SkeletonHandle& skeletonHandle,
+        const uint32 maxAnimatedDepth = std::numeric_limits<uint32>::max()
+    );
+
+    /**
+     * Animate into caller owned storage, which must hold at least numberOfBones(meshHandle) matrices.
+     */
+    void animateSkeleton(
+        glm::mat4* transformations,
+        const uint32 numberOfTransformations,
+        const std::chrono::duration<float32> runningTime,
+        const uint32 startFrame,
+        const uint32 endFrame,
+        const graphics::MeshHandle& meshHandle,
+        const AnimationHandle& animationHandle,
+        const SkeletonHandle& skeletonHandle,
+        const uint32 maxAnimatedDepth = std::numeric_limits<uint32>::max()
+    );
+
+    uint32 numberOfBones(const graphics::MeshHandle& meshHandle) const
+    {
+        const auto it = meshes_.find(meshHandle);
+
+        if (it != meshes_.end())
+        {
+            return static_cast<uint32>(it->second.boneData().boneTransform.size());
+        }
+
+        return 0;
+    }
+
+    BonePaletteArena& bonePaletteArena()
+    {
+        return bonePaletteArena_;
+    }
+
+    /**
+     * The render state scenes write their graphics updates into - nullptr unless the simulation is pipelined.
+     */
+    RenderState* renderState() const
+    {
+        return renderState_.get();
+    }
+
     void destroySkeleton(const std::string& name)
     {
         const auto handle = resourceHandleCache_.getSkeletonHandle(name);
@@ -595,9 +684,25 @@ public:
 
     AnimationHandle createAnimation(const std::string& name, const Animation& animation)
     {
+        // Bake before taking the lock, so animation workers aren't held up by it
+        BakedAnimation bakedAnimation;
+        if (animationBakeRate_ > 0.0f)
+        {
+            bakedAnimation = BakedAnimation(animation, animationBakeRate_);
+        }
+
+        std::unique_lock<boost::shared_mutex> lock(animationsMutex_);
+
         auto handle = animations_.create();
         animations_[handle] = Animation(animation);
 
+        if (animationBakeRate_ > 0.0f)
+        {
+            bakedAnimations_[handle] = std::move(bakedAnimation);
+        }
+
+        lock.unlock();
+
         resourceHandleCache_.addAnimationHandle(name, handle);
 
         return handle;
@@ -610,6 +715,9 @@ public:
         {
             resourceHandleCache_.removeAnimationHandle(name);
 
+            std::unique_lock<boost::shared_mutex> lock(animationsMutex_);
+
+            bakedAnimations_.erase(handle);
             animations_.destroy(handle);
         }
     }
@@ -690,6 +798,22 @@ public:
         return handle;
     }
 
+    /**
+     * Create a texture from the block compressed mip chain of the provided texture's image.
+     *
+     * The mip chain is read from the texture cache, and only encoded (and stored in the cache) if it isn't there yet.
+     */
+    graphics::TextureHandle createCompressedTexture(const std::string& name, const Texture& texture, const graphics::ICompressedImage::Format format)
+    {
+        const auto compressedImage = textureCache_->get(*texture.image(), format);
+
+        auto handle = graphicsEngine_->createTexture2d(CompressedTexture(texture.name(), &compressedImage));
+
+        resourceHandleCache_.addTextureHandle(name, handle);
+
+        return handle;
+    }
+
     void destroyTexture(const std::string& name)
     {
         const auto handle = resourceHandleCache_.getTextureHandle(name);
@@ -947,6 +1071,13 @@ private:
 	handles::HandleVector<Skeleton, SkeletonHandle> skeletons_;
 	handles::HandleVector<Animation, AnimationHandle> animations_;
 
+	// Clips baked into quantized pose tables at this rate (samples per second) when they're created - 0 disables baking
+	float32 animationBakeRate_ = 0.0f;
+	std::unordered_map<AnimationHandle, BakedAnimation> bakedAnimations_;
+
+	// Animation workers read animations_ and bakedAnimations_ while the main thread creates and destroys animations
+	boost::shared_mutex animationsMutex_;
+
 	std::vector<std::unique_ptr<Scene>> scenes_;
 
 	std::unordered_map<std::string, graphics::VertexShaderHandle> vertexShaderHandles_;
@@ -965,6 +1096,10 @@ private:
 	EngineStatistics engineStatistics_;
 
 	void tick(const float32 delta);
+	void tickScript(const float32 delta);
+	void tickScenes(const float32 delta);
+	void tickModulesAndGuis(const float32 delta);
+	void updateMetrics(const float32 delta);
     void render();
 	void initialize();
 	void destroy();
@@ -994,6 +1129,7 @@ private:
 	void initializeNetworkingSubSystem();
 	void initializeInputSubSystem();
 	void initializeScriptingSubSystem();
+	void initializeScriptingBindings();
 	void initializeThreadingSubSystem();
 	void initializeTerrainSubSystem();
 	void initializeDataStoreSubSystem();
@@ -1045,7 +1181,23 @@ private:
 	std::unique_ptr<ThreadPool> backgroundThreadPool_;
 	std::unique_ptr<ThreadPool> foregroundThreadPool_;
 	std::unique_ptr<OpenGlLoader> openGlLoader_;
-	std::unique_ptr<OpenGlLoader> forgroundGraphicsThreadPool_;
+
+	// Time the render thread may spend on queued OpenGl work each frame
+	std::chrono::microseconds openGlLoaderBudget_ = std::chrono::microseconds(2000);
+
+	std::unique_ptr<TextureCache> textureCache_;
+	BonePaletteArena bonePaletteArena_;
+
+	// Only when the simulation is pipelined - scenes simulate on the single thread of simulationThreadPool_ (which
+	// in turn uses the foreground pool) while the main thread renders
+	std::unique_ptr<RenderState> renderState_;
+	std::unique_ptr<ThreadPool> simulationThreadPool_;
+
+	MetricsSettings metricsSettings_;
+	float32 metricsTime_ = 0.0f;
+
+	// Stand-in engines take the place of the graphics, audio, networking, physics and pathfinding plugins
+	bool headless_ = false;
 
 	//std::unique_ptr<pyliteserializer::SqliteDataStore> dataStore_;
 };
@@ -0,0 +1,86 @@
+#ifndef HEIGHTGRID_H_
+#define HEIGHTGRID_H_
+
+#include <vector>
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+
+#include "graphics/IImage.hpp"
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+
+/**
+ * A grid of terrain heights, stored packed as 16 bit unsigned integers (R16) or 32 bit floats (R32F).
+ *
+ * Heights are normalized - R16 samples map [0, 65535] to [0, 1], and R32F samples are expected to be in [0, 1].  Grid
+ * coordinates outside of the grid are clamped to its edges, so an empty grid mustn't be sampled.
+ */
+class HeightGrid
+{
+public:
+	enum class Format
+	{
+		R16,
+		R32F
+	};
+
+	HeightGrid() = default;
+	HeightGrid(std::vector<uint16> heights, const uint32 width, const uint32 length);
+	HeightGrid(std::vector<float32> heights, const uint32 width, const uint32 length);
+
+	/**
+	 * Heights from an image's alpha channel (RGBA), or the average of its channels (RGB) - the same heights HeightMap uses.
+	 */
+	HeightGrid(const graphics::IImage& image, const Format format = Format::R16);
+
+	Format format() const;
+	uint32 width() const;
+	uint32 length() const;
+	bool empty() const;
+
+	/**
+	 * The packed samples, row major (length rows of width samples) - only the one matching format() is filled.
+	 */
+	const std::vector<uint16>& heights16() const;
+	const std::vector<float32>& heights32f() const;
+
+	/**
+	 * The height of the sample at (x, z).
+	 */
+	float32 height(const int64 x, const int64 z) const;
+
+	float32 sampleBilinear(const float32 x, const float32 z) const;
+
+	/**
+	 * Catmull-Rom interpolation over the surrounding 4x4 samples - smoother than bilinear, but can overshoot slightly
+	 * near sharp changes in height.
+	 */
+	float32 sampleBicubic(const float32 x, const float32 z) const;
+
+	/**
+	 * Sample many points at once - out must have room for count heights.
+	 */
+	void sampleBilinear(const glm::vec2* points, float32* out, const size_t count) const;
+	void sampleBicubic(const glm::vec2* points, float32* out, const size_t count) const;
+
+	/**
+	 * Copy of the width x length samples starting at (left, top), clamped to the edges of this grid like height().
+	 */
+	HeightGrid region(const int64 left, const int64 top, const uint32 width, const uint32 length) const;
+
+private:
+	Format format_ = Format::R16;
+	uint32 width_ = 0;
+	uint32 length_ = 0;
+
+	std::vector<uint16> heights16_;
+	std::vector<float32> heights32f_;
+};
+
+}
+
+#endif /* HEIGHTGRID_H_ */
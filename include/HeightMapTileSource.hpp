@@ -0,0 +1,50 @@
+#ifndef HEIGHTMAPTILESOURCE_H_
+#define HEIGHTMAPTILESOURCE_H_
+
+#include "ITerrainTileSource.hpp"
+
+#include "HeightMap.hpp"
+#include "HeightGrid.hpp"
+
+namespace ice_engine
+{
+
+/**
+ * Cuts a height map into tiles.  The height map is centered on the origin, like the monolithic terrain.
+ */
+class HeightMapTileSource : public ITerrainTileSource
+{
+public:
+	HeightMapTileSource(const HeightMap& heightMap) : heightGrid_(*heightMap.image())
+	{
+	}
+
+	~HeightMapTileSource() override = default;
+
+	bool contains(const int32 x, const int32 z, const uint32 tileSize) const override
+	{
+		const int64 width = heightGrid_.width();
+		const int64 length = heightGrid_.length();
+
+		const int64 left = static_cast<int64>(x) * tileSize + width / 2;
+		const int64 top = static_cast<int64>(z) * tileSize + length / 2;
+
+		return left < width && left + tileSize > 0 && top < length && top + tileSize > 0;
+	}
+
+	HeightGrid heights(const int32 x, const int32 z, const uint32 tileSize) const override
+	{
+		const int64 left = static_cast<int64>(x) * tileSize + heightGrid_.width() / 2;
+		const int64 top = static_cast<int64>(z) * tileSize + heightGrid_.length() / 2;
+
+		// Samples outside of the height map are clamped to its edge
+		return heightGrid_.region(left, top, tileSize + 1, tileSize + 1);
+	}
+
+private:
+	HeightGrid heightGrid_;
+};
+
+}
+
+#endif /* HEIGHTMAPTILESOURCE_H_ */
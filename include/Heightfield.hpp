@@ -2,9 +2,12 @@
 #define HEIGHTFIELD_H_
 
 #include <vector>
+#include <cstring>
+#include <algorithm>
 
 #include "physics/IHeightfield.hpp"
 
+#include "HeightGrid.hpp"
 #include "Image.hpp"
 
 namespace ice_engine
@@ -21,6 +24,15 @@ public:
 		generateHeightfield(image);
 	}
 
+	/**
+	 * Keeps the grid's packed 16 bit or float samples, unless fullPrecision is false - then they're reduced to bytes, for
+	 * physics engines that don't read dataType().
+	 */
+	Heightfield(const HeightGrid& heightGrid, const bool fullPrecision = true)
+	{
+		generateHeightfield(heightGrid, fullPrecision);
+	}
+
 	virtual ~Heightfield() override = default;
 
 	virtual const std::vector<byte>& data() const override
@@ -44,11 +56,50 @@ public:
         return 15;
     }
 
+	virtual physics::HeightfieldDataType dataType() const override
+	{
+		return dataType_;
+	}
+
 private:
 	std::vector<byte> data_;
 	uint32 width_ = 0;
 	uint32 length_ = 0;
 	uint32 height_ = 0;
+	physics::HeightfieldDataType dataType_ = physics::HeightfieldDataType::UNSIGNED_BYTE;
+
+	void generateHeightfield(const HeightGrid& heightGrid, const bool fullPrecision)
+	{
+		width_ = heightGrid.width();
+		length_ = heightGrid.length();
+
+		if (heightGrid.empty()) return;
+
+		if (!fullPrecision)
+		{
+			data_.resize(width_ * length_);
+
+			for (uint32 j = 0; j < length_; ++j)
+			{
+				for (uint32 i = 0; i < width_; ++i)
+				{
+					data_[j * width_ + i] = static_cast<byte>(std::min(std::max(heightGrid.height(i, j), 0.0f), 1.0f) * 255.0f + 0.5f);
+				}
+			}
+		}
+		else if (heightGrid.format() == HeightGrid::Format::R16)
+		{
+			dataType_ = physics::HeightfieldDataType::UNSIGNED_SHORT;
+			data_.resize(heightGrid.heights16().size() * sizeof(uint16));
+			std::memcpy(data_.data(), heightGrid.heights16().data(), data_.size());
+		}
+		else
+		{
+			dataType_ = physics::HeightfieldDataType::FLOAT;
+			data_.resize(heightGrid.heights32f().size() * sizeof(float32));
+			std::memcpy(data_.data(), heightGrid.heights32f().data(), data_.size());
+		}
+	}
 
 	void generateHeightfield(const IImage& image)
 	{
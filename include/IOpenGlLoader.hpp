@@ -3,6 +3,7 @@
 
 #include <functional>
 #include <future>
+#include <chrono>
 
 #include "Types.hpp"
 
@@ -12,6 +13,18 @@ namespace ice_engine
 class IOpenGlLoader
 {
 public:
+	/**
+	 * Work is run in priority order - high priority work (i.e. per frame updates like bone transformations) is
+	 * run before normal priority work (i.e. asset uploads).
+	 */
+	enum Priority
+	{
+		PRIORITY_HIGH = 0,
+		PRIORITY_NORMAL,
+
+		PRIORITY_COUNT
+	};
+
 	virtual ~IOpenGlLoader()
 	{
 	}
@@ -19,11 +32,25 @@ public:
 	
 	virtual std::future<void> postWork(const std::function<void()>& work) = 0;
 	virtual std::future<void> postWork(std::function<void()>&& work) = 0;
+
+	/**
+	 * Post work with the given priority and an estimate of how long it will take to run.
+	 *
+	 * A cost of zero means 'unknown', in which case the average measured cost of work with the same priority is used.
+	 */
+	virtual std::future<void> postWork(std::function<void()>&& work, const Priority priority, const std::chrono::microseconds cost = std::chrono::microseconds(0)) = 0;
 	virtual void waitAll() = 0;
 	
 	virtual uint32 getWorkQueueCount() const = 0;
 	
 	virtual void tick() = 0;
+
+	/**
+	 * Run queued work until the (estimated) time spent would exceed the provided budget.
+	 *
+	 * At least one piece of work from each priority is run per call, so nothing is starved if the budget is too small.
+	 */
+	virtual void tick(const std::chrono::microseconds budget) = 0;
 	
 	virtual void block() = 0;
 	virtual void unblock() = 0;
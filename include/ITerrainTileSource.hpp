@@ -0,0 +1,37 @@
+#ifndef ITERRAINTILESOURCE_H_
+#define ITERRAINTILESOURCE_H_
+
+#include "HeightGrid.hpp"
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+
+/**
+ * Provides the height data for the tiles of a streaming terrain.
+ *
+ * Tile (x, z) covers world x from x * tileSize to (x + 1) * tileSize (and likewise for z), with one height sample per
+ * world unit.  Neighbouring tiles share their edge samples, so a tile has (tileSize + 1)^2 samples.
+ */
+class ITerrainTileSource
+{
+public:
+	virtual ~ITerrainTileSource() = default;
+
+	/**
+	 * Returns false if the source has no data for the tile - it won't be loaded.
+	 */
+	virtual bool contains(const int32 x, const int32 z, const uint32 tileSize) const = 0;
+
+	/**
+	 * Returns the tile's (tileSize + 1) x (tileSize + 1) height samples, in either format.
+	 *
+	 * This is called from the background thread pool, possibly for several tiles at once, so it must be thread safe.
+	 */
+	virtual HeightGrid heights(const int32 x, const int32 z, const uint32 tileSize) const = 0;
+};
+
+}
+
+#endif /* ITERRAINTILESOURCE_H_ */
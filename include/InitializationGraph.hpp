@@ -0,0 +1,72 @@
+#ifndef INITIALIZATIONGRAPH_H_
+#define INITIALIZATIONGRAPH_H_
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <chrono>
+
+#include "IThreadPool.hpp"
+
+#include "logger/ILogger.hpp"
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+
+/**
+ * Steps of initialization and what each one needs done first.
+ *
+ * Steps start as soon as the steps they depend on finish, so independent steps run at the same time on a thread
+ * pool.  Every step is timed and logged.
+ */
+class InitializationGraph
+{
+public:
+	InitializationGraph(logger::ILogger* logger);
+
+	InitializationGraph(const InitializationGraph& other) = delete;
+	InitializationGraph& operator=(const InitializationGraph& other) = delete;
+
+	/**
+	 * Adds a step that runs after the named dependencies, which must have been added already.
+	 *
+	 * A main thread step runs on the thread that calls run() - for things like windows, that belong to the thread
+	 * that creates them.
+	 */
+	void add(const std::string& name, std::function<void()> step, const std::vector<std::string>& dependencies = {}, const bool mainThread = false);
+
+	/**
+	 * Runs every step - on threadPool where dependencies allow, or one after another without it.
+	 *
+	 * Once a step throws, no more steps start, and the exception is rethrown when the running ones are done.
+	 */
+	void run(IThreadPool* threadPool = nullptr);
+
+	/**
+	 * How long the step took to run.
+	 */
+	std::chrono::duration<float32> duration(const std::string& name) const;
+
+private:
+	struct Step
+	{
+		std::string name;
+		std::function<void()> function;
+		std::vector<uint32> dependents;
+		uint32 numberOfDependencies = 0;
+		bool mainThread = false;
+		std::chrono::duration<float32> duration = std::chrono::duration<float32>(0.0f);
+	};
+
+	logger::ILogger* logger_;
+
+	std::vector<Step> steps_;
+	std::unordered_map<std::string, uint32> indices_;
+};
+
+}
+
+#endif /* INITIALIZATIONGRAPH_H_ */
@@ -0,0 +1,197 @@
+#ifndef METRICS_H_
+#define METRICS_H_
+
+#include <string>
+#include <array>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <ostream>
+
+#include "utilities/Properties.hpp"
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+
+/**
+ * Settings for the metrics registry, read from the [metrics] section of the settings.
+ *
+ * When enabled, every metric is appended to filename every dumpInterval seconds.
+ */
+struct MetricsSettings
+{
+	MetricsSettings() = default;
+
+	MetricsSettings(const utilities::Properties& properties)
+	:
+		enabled(properties.getBoolValue("metrics.enabled", false)),
+		dumpInterval(properties.getFloatValue("metrics.dumpinterval", 10.0f)),
+		filename(properties.getStringValue("metrics.filename", "metrics.log"))
+	{
+	}
+
+	bool enabled = false;
+	float32 dumpInterval = 10.0f;
+	std::string filename = "metrics.log";
+};
+
+/**
+ * A count that only goes up.
+ *
+ * The count is split across stripes on separate cache lines, and each thread adds to its own stripe - threads
+ * counting the same thing don't take the cache line from each other.
+ */
+class MetricCounter
+{
+public:
+	static constexpr uint32 NUMBER_OF_STRIPES = 8;
+
+	void increment(const uint64 value = 1)
+	{
+		stripes_[stripe()].value.fetch_add(value, std::memory_order_relaxed);
+	}
+
+	uint64 value() const;
+
+private:
+	// Padded rather than aligned - over aligned allocation isn't guaranteed before C++17
+	struct Stripe
+	{
+		std::atomic<uint64> value{0};
+		char padding[64 - sizeof(std::atomic<uint64>)];
+	};
+
+	std::array<Stripe, NUMBER_OF_STRIPES> stripes_;
+
+	static uint32 stripe();
+};
+
+/**
+ * A value that is set, like a queue depth.
+ */
+class MetricGauge
+{
+public:
+	void set(const int64 value)
+	{
+		value_.store(value, std::memory_order_relaxed);
+	}
+
+	void add(const int64 value)
+	{
+		value_.fetch_add(value, std::memory_order_relaxed);
+	}
+
+	int64 value() const
+	{
+		return value_.load(std::memory_order_relaxed);
+	}
+
+private:
+	char paddingBefore_[64];
+	std::atomic<int64> value_{0};
+	char paddingAfter_[64 - sizeof(std::atomic<int64>)];
+};
+
+/**
+ * Summary of the values a histogram recorded - values are exact below 64 and within about 3% above.
+ */
+struct MetricHistogramSnapshot
+{
+	uint64 count = 0;
+	uint64 minimum = 0;
+	uint64 maximum = 0;
+	float64 mean = 0.0;
+	uint64 percentile50 = 0;
+	uint64 percentile95 = 0;
+	uint64 percentile99 = 0;
+};
+
+/**
+ * A distribution of values, like frame times in microseconds or message sizes in bytes.
+ *
+ * Buckets are log-linear as in an HDR histogram - each power of 2 is split into 32 buckets, so recording a value
+ * is a single atomic increment of one bucket whatever its size.
+ */
+class MetricHistogram
+{
+public:
+	static constexpr uint32 NUMBER_OF_BUCKETS = 64 + 58 * 32;
+
+	void record(const uint64 value)
+	{
+		buckets_[bucket(value)].fetch_add(1, std::memory_order_relaxed);
+	}
+
+	/**
+	 * Summarizes what was recorded - with reset, recording starts over.  Values recorded while a snapshot is
+	 * taken end up in either this one or the next.
+	 */
+	MetricHistogramSnapshot snapshot(const bool reset = false);
+
+	static uint32 bucket(const uint64 value);
+
+	/**
+	 * Smallest and largest values that fall into the bucket.
+	 */
+	static uint64 lowest(const uint32 bucket);
+	static uint64 highest(const uint32 bucket);
+
+private:
+	std::array<std::atomic<uint64>, NUMBER_OF_BUCKETS> buckets_{};
+};
+
+/**
+ * Named counters, gauges and histograms that subsystems and scripts update.
+ *
+ * Metrics are registered on first use and live as long as the registry - hot code looks a metric up once and keeps
+ * the reference.  Updates are lock free, only registration and write() take a lock.
+ */
+class Metrics
+{
+public:
+	Metrics() = default;
+
+	Metrics(const Metrics& other) = delete;
+	Metrics& operator=(const Metrics& other) = delete;
+
+	/**
+	 * The registry engine subsystems record into.
+	 */
+	static Metrics& instance();
+
+	MetricCounter& counter(const std::string& name);
+	MetricGauge& gauge(const std::string& name);
+	MetricHistogram& histogram(const std::string& name);
+
+	/**
+	 * Writes every metric in InfluxDB line protocol, one line each with the given timestamp in nanoseconds.
+	 *
+	 * Counters give their total and how much they went up since the last write, and histograms summarize the values
+	 * recorded since the last write.
+	 */
+	void write(std::ostream& stream, const int64 timestamp);
+
+private:
+	struct Counter
+	{
+		MetricCounter counter;
+		uint64 written = 0;
+	};
+
+	// Metrics are in deques so the references handed out stay where they are
+	std::mutex mutex_;
+	std::deque<Counter> counters_;
+	std::deque<MetricGauge> gauges_;
+	std::deque<MetricHistogram> histograms_;
+	std::map<std::string, Counter*> counterNames_;
+	std::map<std::string, MetricGauge*> gaugeNames_;
+	std::map<std::string, MetricHistogram*> histogramNames_;
+};
+
+}
+
+#endif /* METRICS_H_ */
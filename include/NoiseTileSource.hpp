@@ -0,0 +1,56 @@
+#ifndef NOISETILESOURCE_H_
+#define NOISETILESOURCE_H_
+
+#include <algorithm>
+
+#include "ITerrainTileSource.hpp"
+
+#include "noise/Noise.hpp"
+
+namespace ice_engine
+{
+
+/**
+ * Generates an unbounded terrain from noise, using the noise's configured noise type.
+ */
+class NoiseTileSource : public ITerrainTileSource
+{
+public:
+	NoiseTileSource(const noise::Noise& noise) : noise_(noise)
+	{
+	}
+
+	~NoiseTileSource() override = default;
+
+	bool contains(const int32 x, const int32 z, const uint32 tileSize) const override
+	{
+		return true;
+	}
+
+	HeightGrid heights(const int32 x, const int32 z, const uint32 tileSize) const override
+	{
+		const float32 left = static_cast<float32>(static_cast<int64>(x) * tileSize);
+		const float32 top = static_cast<float32>(static_cast<int64>(z) * tileSize);
+
+		const uint32 samples = tileSize + 1;
+
+		// Tiles are already generated on the thread pool, so don't split the grid across it as well
+		std::vector<float32> values(samples * samples);
+		noise_.fillGrid(values.data(), glm::vec2(left, top), glm::vec2(1.0f, 1.0f), samples, samples);
+
+		for (auto& value : values)
+		{
+			// Noise is in [-1, 1]
+			value = std::min(std::max((value + 1.0f) * 0.5f, 0.0f), 1.0f);
+		}
+
+		return HeightGrid(std::move(values), samples, samples);
+	}
+
+private:
+	noise::Noise noise_;
+};
+
+}
+
+#endif /* NOISETILESOURCE_H_ */
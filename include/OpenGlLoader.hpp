@@ -3,35 +3,80 @@
 
 #include <mutex>
 #include <deque>
+#include <array>
+#include <atomic>
 #include <memory>
 
 #include "IOpenGlLoader.hpp"
 
+#include "detail/MpscRingBuffer.hpp"
+
 namespace ice_engine
 {
 
+/**
+ * Queue of work that has to run on the render thread (i.e. OpenGL uploads).
+ *
+ * Producers post work lock free into a ring buffer per priority, and the render thread runs it in priority
+ * order within a per frame time budget.  If a ring buffer is full, work spills into a mutex protected overflow
+ * queue instead of blocking the producer.
+ */
 class OpenGlLoader : public IOpenGlLoader
 {
 public:
-	OpenGlLoader();
+	OpenGlLoader(const uint32 capacity = 4096);
 	virtual ~OpenGlLoader();
 	
 	virtual std::future<void> postWork(const std::function<void()>& work) override;
 	virtual std::future<void> postWork(std::function<void()>&& work) override;
+	virtual std::future<void> postWork(std::function<void()>&& work, const Priority priority, const std::chrono::microseconds cost = std::chrono::microseconds(0)) override;
 	virtual void waitAll() override;
 	
 	virtual uint32 getWorkQueueCount() const override;
 	
 	virtual void tick() override;
+	virtual void tick(const std::chrono::microseconds budget) override;
 	
 	virtual void block() override;
 	virtual void unblock() override;
 	
 private:
-	mutable std::mutex enqueuedWorkMutex_;
-	std::deque< std::shared_ptr<std::packaged_task<void()>> > enqueuedWork_;
+	struct Work
+	{
+		std::packaged_task<void()> task;
+		std::chrono::microseconds cost{0};
+	};
+
+	struct Lane
+	{
+		Lane(const uint32 capacity) : ringBuffer(capacity)
+		{
+		}
+
+		detail::MpscRingBuffer<Work> ringBuffer;
+
+		// Once anything is in the overflow queue, new work goes there too until the render thread has drained it,
+		// so work posted from a single thread always runs in the order it was posted
+		std::mutex overflowMutex;
+		std::deque<Work> overflow;
+		std::atomic<uint32> overflowCount{0};
+
+		// Only touched by the render thread
+		Work deferred;
+		bool hasDeferred = false;
+		std::chrono::microseconds averageCost{50};
+	};
+
+	std::array<std::unique_ptr<Lane>, PRIORITY_COUNT> lanes_;
+	std::atomic<uint32> workQueueCount_{0};
+
+	// Held by the render thread while running work, and by block()/unblock()
+	std::mutex tickMutex_;
+
+	void initialize(const uint32 capacity);
 
-	void initialize();
+	bool pop(Lane& lane, Work& work);
+	void run(Lane& lane, Work& work);
 };
 
 }
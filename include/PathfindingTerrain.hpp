@@ -4,6 +4,7 @@
 #include "pathfinding/ITerrain.hpp"
 
 #include "HeightMap.hpp"
+#include "HeightGrid.hpp"
 
 namespace ice_engine
 {
@@ -16,7 +17,29 @@ public:
 	
 	PathfindingTerrain(const HeightMap& heightMap)
 	{
-		generatePathfindingTerrain(heightMap);
+		generatePathfindingTerrain(HeightGrid(*heightMap.image()));
+	}
+
+	/**
+	 * maximumError is how far (vertically, in world units) the navigation input may stray from the height samples -
+	 * flat areas are merged into large triangles, and 0 only merges what is exactly flat.
+	 */
+	PathfindingTerrain(const HeightGrid& heightGrid, const float32 maximumError = 0.0f)
+	{
+		generatePathfindingTerrain(heightGrid, maximumError);
+	}
+
+	/**
+	 * Terrain for a tile of a streaming terrain - one vertex per height sample, placed at origin + (x, height, z).
+	 */
+	PathfindingTerrain(const HeightMap& heightMap, const glm::vec3& origin)
+	{
+		generatePathfindingTerrain(HeightGrid(*heightMap.image()), origin);
+	}
+
+	PathfindingTerrain(const HeightGrid& heightGrid, const glm::vec3& origin, const float32 maximumError = 0.0f)
+	{
+		generatePathfindingTerrain(heightGrid, origin, maximumError);
 	}
 	
 	~PathfindingTerrain() override = default;
@@ -35,7 +58,8 @@ private:
 	std::vector<glm::vec3> vertices_;
 	std::vector<uint32> indices_;
 
-	void generatePathfindingTerrain(const HeightMap& heightMap);
+	void generatePathfindingTerrain(const HeightGrid& heightGrid, const float32 maximumError = 0.0f);
+	void generatePathfindingTerrain(const HeightGrid& heightGrid, const glm::vec3& origin, const float32 maximumError = 0.0f);
 };
 
 }
@@ -0,0 +1,253 @@
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+#include <string>
+#include <vector>
+#include <array>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <ostream>
+
+#include "detail/MpscRingBuffer.hpp"
+
+#include "utilities/Properties.hpp"
+
+#include "Types.hpp"
+
+/**
+ * Scoped profiling zones - PROFILE_ZONE("Scene::tickPhysics") times the rest of the enclosing scope.
+ *
+ * Zones only exist when the engine is built with ICEENGINE_ENABLE_PROFILING, otherwise the macro expands to nothing.
+ * When built in but switched off at runtime, a zone costs a relaxed atomic load.
+ */
+#if defined(ICEENGINE_ENABLE_PROFILING)
+	#define ICEENGINE_PROFILE_CONCATENATE_(a, b) a##b
+	#define ICEENGINE_PROFILE_CONCATENATE(a, b) ICEENGINE_PROFILE_CONCATENATE_(a, b)
+	#define PROFILE_ZONE(name) \
+		static const ice_engine::uint32 ICEENGINE_PROFILE_CONCATENATE(profileZoneId, __LINE__) = ice_engine::Profiler::instance().zone(name); \
+		const ice_engine::ProfileZone ICEENGINE_PROFILE_CONCATENATE(profileZone, __LINE__)(ice_engine::Profiler::instance(), ICEENGINE_PROFILE_CONCATENATE(profileZoneId, __LINE__));
+#else
+	#define PROFILE_ZONE(name)
+#endif
+
+namespace ice_engine
+{
+
+/**
+ * Settings for the profiler, read from the [profiler] section of the settings.
+ *
+ * Each thread records into a ring buffer of threadBufferSize events (a power of 2) that is drained once a frame - a
+ * thread that records more than that in a frame loses the rest.  The last traceEvents events are kept for trace
+ * export, and the last histogramSamples durations of each zone for its statistics.
+ */
+struct ProfilerSettings
+{
+	ProfilerSettings() = default;
+
+	ProfilerSettings(const utilities::Properties& properties)
+	:
+		enabled(properties.getBoolValue("profiler.enabled", false)),
+		threadBufferSize(static_cast<uint32>(properties.getIntValue("profiler.threadbuffersize", 16384))),
+		traceEvents(static_cast<uint32>(properties.getIntValue("profiler.traceevents", 200000))),
+		histogramSamples(static_cast<uint32>(properties.getIntValue("profiler.histogramsamples", 1024)))
+	{
+	}
+
+	bool enabled = false;
+	uint32 threadBufferSize = 16384;
+	uint32 traceEvents = 200000;
+	uint32 histogramSamples = 1024;
+};
+
+/**
+ * Statistics of a zone over its last ProfilerSettings::histogramSamples runs - all times are in milliseconds.
+ */
+struct ProfileZoneStatistics
+{
+	uint32 count = 0;
+	float32 mean = 0.0f;
+	float32 minimum = 0.0f;
+	float32 maximum = 0.0f;
+	float32 median = 0.0f;
+	float32 percentile95 = 0.0f;
+	float32 percentile99 = 0.0f;
+};
+
+/**
+ * Collects profiling zones from every thread.
+ *
+ * Recording is lock free - each thread pushes into a ring buffer of its own.  Once a frame, collect() drains the
+ * buffers into a rolling trace (exported as Chrome trace event JSON, which chrome://tracing and Perfetto open) and a
+ * rolling histogram per zone.
+ */
+class Profiler
+{
+public:
+	static constexpr uint32 NUMBER_OF_BUCKETS = 32;
+
+	Profiler(const ProfilerSettings& profilerSettings = ProfilerSettings());
+	~Profiler();
+
+	Profiler(const Profiler& other) = delete;
+	Profiler& operator=(const Profiler& other) = delete;
+
+	/**
+	 * The profiler the PROFILE_ZONE macro records into.
+	 */
+	static Profiler& instance();
+
+	/**
+	 * Applies new settings and clears everything recorded so far - nothing may be recording at the time.
+	 */
+	void initialize(const ProfilerSettings& profilerSettings);
+
+	void setEnabled(const bool enabled);
+
+	bool enabled() const
+	{
+		return enabled_.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * Id of the zone with the given name, registering it the first time.  Safe to call from any thread.
+	 */
+	uint32 zone(const std::string& name);
+
+	/**
+	 * Names the calling thread in exported traces.
+	 */
+	void setThreadName(const std::string& name);
+
+	/**
+	 * Records a run of a zone on the calling thread - begin and end come from now().
+	 */
+	void record(const uint32 zone, const int64 begin, const int64 end);
+
+	/**
+	 * Nanoseconds on a monotonic clock.
+	 */
+	static int64 now()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	/**
+	 * Drains the threads' buffers into the trace and the histograms.
+	 */
+	void collect();
+
+	/**
+	 * Statistics of the named zone, as of the last collect() - all zero for a zone that hasn't run.
+	 */
+	const ProfileZoneStatistics& statistics(const std::string& name);
+
+	/**
+	 * Counts of the zone's recent runs by duration - bucket i counts runs of up to bucketLimit(i) microseconds (the
+	 * last bucket counts everything longer).
+	 */
+	std::vector<uint32> histogram(const std::string& name) const;
+
+	static float32 bucketLimit(const uint32 bucket);
+
+	/**
+	 * Writes the trace as Chrome trace event JSON.
+	 */
+	void exportChromeTrace(std::ostream& stream) const;
+
+	/**
+	 * Events lost because a thread's buffer was full.
+	 */
+	uint64 droppedEvents() const;
+
+private:
+	struct Event
+	{
+		uint32 zone = 0;
+		int64 begin = 0;
+		int64 end = 0;
+	};
+
+	struct ThreadBuffer
+	{
+		ThreadBuffer(const uint32 capacity, const uint32 threadId) : events(capacity), threadId(threadId)
+		{
+		}
+
+		detail::MpscRingBuffer<Event> events;
+		uint32 threadId;
+		std::string name;
+		std::atomic<uint64> dropped{0};
+	};
+
+	struct TraceEvent
+	{
+		uint32 zone;
+		uint32 threadId;
+		int64 begin;
+		int64 end;
+	};
+
+	struct Zone
+	{
+		std::string name;
+
+		// Rolling window of durations in nanoseconds, and the histogram of the same durations
+		std::vector<int64> samples;
+		uint32 nextSample = 0;
+		std::array<uint32, NUMBER_OF_BUCKETS> buckets{};
+
+		ProfileZoneStatistics statistics;
+	};
+
+	// Tells apart the thread buffers of different profilers (and of the same profiler before and after initialize)
+	std::atomic<uint64> id_;
+
+	ProfilerSettings profilerSettings_;
+	std::atomic<bool> enabled_{false};
+
+	// Guards the zones and the trace - zones are in a deque so the statistics handed out stay where they are
+	mutable std::mutex mutex_;
+	std::deque<Zone> zones_;
+	std::map<std::string, uint32> zoneIds_;
+	std::vector<TraceEvent> trace_;
+	uint32 nextTraceEvent_ = 0;
+
+	mutable std::mutex threadBuffersMutex_;
+	std::vector<std::shared_ptr<ThreadBuffer>> threadBuffers_;
+
+	ThreadBuffer& threadBuffer();
+	void addSample(Zone& zone, const int64 duration);
+	static uint32 bucket(const int64 duration);
+};
+
+/**
+ * Times its own lifetime as a run of a zone - see PROFILE_ZONE.
+ */
+class ProfileZone
+{
+public:
+	ProfileZone(Profiler& profiler, const uint32 zone) : profiler_(profiler), zone_(zone), begin_(profiler.enabled() ? Profiler::now() : -1)
+	{
+	}
+
+	~ProfileZone()
+	{
+		if (begin_ >= 0) profiler_.record(zone_, begin_, Profiler::now());
+	}
+
+	ProfileZone(const ProfileZone& other) = delete;
+	ProfileZone& operator=(const ProfileZone& other) = delete;
+
+private:
+	Profiler& profiler_;
+	const uint32 zone_;
+	const int64 begin_;
+};
+
+}
+
+#endif /* PROFILER_H_ */
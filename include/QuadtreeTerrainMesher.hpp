@@ -0,0 +1,83 @@
+#ifndef QUADTREETERRAINMESHER_H_
+#define QUADTREETERRAINMESHER_H_
+
+#include <vector>
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+
+#include "HeightGrid.hpp"
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+
+/**
+ * Builds adaptive triangle meshes of a height grid with a restricted quadtree.
+ *
+ * The grid is covered by a quadtree of square nodes; a node is split while its geometric error (the largest vertical
+ * distance between the full resolution samples it covers and its own triangles) is above a threshold.  Neighbouring
+ * leaves differ by at most one level, and leaves add the midpoint of any edge shared with smaller leaves, so meshes
+ * never have cracks or t-junctions - at any level of detail.
+ *
+ * The error pyramid is computed once in the constructor, so generating meshes (e.g. every time the viewer moves) only
+ * costs in proportion to the nodes visited.
+ *
+ * Vertices are at (x, height * heightScale, z) in grid units, for x in [0, cellsX] and z in [0, cellsZ] - samples past
+ * the edge of the grid are clamped like HeightGrid::height.  Triangles are wound counter clockwise seen from above.
+ */
+class QuadtreeTerrainMesher
+{
+public:
+	QuadtreeTerrainMesher(const HeightGrid& heightGrid, const uint32 cellsX, const uint32 cellsZ, const float32 heightScale);
+
+	/**
+	 * Mesh where no full resolution sample is more than maximumError (vertically) away from the mesh.
+	 */
+	void generate(const float32 maximumError, std::vector<glm::vec3>& vertices, std::vector<uint32>& indices) const;
+
+	/**
+	 * View dependent mesh for rendering - the allowed error grows by errorPerDistance for every unit a node is away from
+	 * the viewer (in grid units, like the vertices).
+	 */
+	void generate(const glm::vec3& viewer, const float32 maximumError, const float32 errorPerDistance, std::vector<glm::vec3>& vertices, std::vector<uint32>& indices) const;
+
+private:
+	struct Node
+	{
+		// Geometric error, saturated so that it is never less than any descendant's
+		float32 error = 0.0f;
+		float32 minimumHeight = 0.0f;
+		float32 maximumHeight = 0.0f;
+	};
+
+	uint32 cellsX_ = 0;
+	uint32 cellsZ_ = 0;
+
+	// Size of the root node in cells - a power of two
+	uint32 rootSize_ = 1;
+
+	// The level whose nodes are a single cell
+	uint32 leafLevel_ = 0;
+
+	// (cellsX + 1) x (cellsZ + 1) vertex heights
+	std::vector<float32> heights_;
+
+	// Nodes of each level above the leaf level, row major
+	std::vector<std::vector<Node>> nodes_;
+
+	template <typename Threshold>
+	void generate(const Threshold& threshold, std::vector<glm::vec3>& vertices, std::vector<uint32>& indices) const;
+
+	float32 height(const uint32 x, const uint32 z) const;
+	bool inside(const uint32 level, const int64 i, const int64 j) const;
+	bool outside(const uint32 level, const int64 i, const int64 j) const;
+
+	void computeErrors();
+	void computeNodeError(const uint32 level, const uint32 i, const uint32 j);
+};
+
+}
+
+#endif /* QUADTREETERRAINMESHER_H_ */
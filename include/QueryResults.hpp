@@ -0,0 +1,87 @@
+#ifndef QUERYRESULTS_H_
+#define QUERYRESULTS_H_
+
+#include <vector>
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+
+/**
+ * Results of a batch of queries, stored flat so a caller can keep one buffer and reuse its memory every frame.
+ *
+ * The values found by query i are values()[offsets()[i]] up to values()[offsets()[i + 1]].
+ */
+template <typename T>
+class QueryResults
+{
+public:
+	QueryResults() : offsets_(1, 0)
+	{
+	}
+
+	/**
+	 * Remove all results, keeping the allocated memory.
+	 */
+	void clear()
+	{
+		values_.clear();
+		offsets_.resize(1);
+	}
+
+	void reserve(const uint32 numberOfQueries, const uint32 numberOfValues)
+	{
+		offsets_.reserve(numberOfQueries + 1);
+		values_.reserve(numberOfValues);
+	}
+
+	/**
+	 * Add a value to the current query.
+	 */
+	void add(const T& value)
+	{
+		values_.push_back(value);
+	}
+
+	/**
+	 * Finish the current query - values added afterwards belong to the next one.
+	 */
+	void endQuery()
+	{
+		offsets_.push_back(static_cast<uint32>(values_.size()));
+	}
+
+	uint32 numberOfQueries() const
+	{
+		return static_cast<uint32>(offsets_.size() - 1);
+	}
+
+	uint32 count(const uint32 query) const
+	{
+		return offsets_[query + 1] - offsets_[query];
+	}
+
+	const T& get(const uint32 query, const uint32 index) const
+	{
+		return values_[offsets_[query] + index];
+	}
+
+	const std::vector<T>& values() const
+	{
+		return values_;
+	}
+
+	const std::vector<uint32>& offsets() const
+	{
+		return offsets_;
+	}
+
+private:
+	std::vector<T> values_;
+	std::vector<uint32> offsets_;
+};
+
+}
+
+#endif /* QUERYRESULTS_H_ */
@@ -0,0 +1,119 @@
+#ifndef RENDERSTATE_H_
+#define RENDERSTATE_H_
+
+#include <array>
+#include <vector>
+#include <map>
+#include <utility>
+#include <mutex>
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "graphics/IGraphicsEngine.hpp"
+
+#include "BonePaletteArena.hpp"
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+
+/**
+ * Double buffered graphics updates, for running the simulation of one frame while the previous frame is rendered.
+ *
+ * The simulation writes renderable transforms, bone palettes, point light positions and destroyed renderables and
+ * lights into the back buffer (from any thread) instead of calling the graphics engine.  At the sync point - when the
+ * simulation has finished and nothing is rendering - swap() makes the back buffer the front buffer, and apply() hands
+ * its contents to the graphics engine.  The render thread only ever sees graphics state from the previous buffer.
+ *
+ * Only the last update of a renderable or light per buffer is kept, so running several ticks per frame costs one
+ * graphics engine call per thing that moved.
+ */
+class RenderState
+{
+public:
+	RenderState() = default;
+
+	RenderState(const RenderState& other) = delete;
+	RenderState& operator=(const RenderState& other) = delete;
+
+	void position(const graphics::RenderSceneHandle& renderSceneHandle, const graphics::RenderableHandle& renderableHandle, const glm::vec3& position);
+	void rotation(const graphics::RenderSceneHandle& renderSceneHandle, const graphics::RenderableHandle& renderableHandle, const glm::quat& orientation);
+	void position(const graphics::RenderSceneHandle& renderSceneHandle, const graphics::PointLightHandle& pointLightHandle, const glm::vec3& position);
+
+	/**
+	 * The palette has to stay valid in its arena until the buffer is applied - palettes that have been reused by then
+	 * are skipped.
+	 */
+	void update(
+		const graphics::RenderSceneHandle& renderSceneHandle,
+		const graphics::RenderableHandle& renderableHandle,
+		const graphics::BonesHandle& bonesHandle,
+		const BonePaletteArena::Palette& palette
+	);
+
+	/**
+	 * Destruction is deferred to apply(), after the updates in the same buffer.  Creation isn't, so a handle that is no
+	 * longer valid by then (destroyed directly, or reused by the graphics engine with a newer version) is skipped.
+	 */
+	void destroy(const graphics::RenderSceneHandle& renderSceneHandle, const graphics::RenderableHandle& renderableHandle);
+	void destroy(const graphics::RenderSceneHandle& renderSceneHandle, const graphics::PointLightHandle& pointLightHandle);
+
+	/**
+	 * Makes the back buffer the front buffer, and clears the new back buffer.  Nothing may be writing at the time.
+	 */
+	void swap();
+
+	/**
+	 * Hands the front buffer to the graphics engine - call from the render thread, between swap() and rendering.
+	 * Updates and destruction of handles the graphics engine no longer considers valid are skipped.
+	 */
+	void apply(graphics::IGraphicsEngine* graphicsEngine, const BonePaletteArena& bonePaletteArena) const;
+
+	/**
+	 * Number of updates (including destruction) in the front buffer.
+	 */
+	uint32 size() const;
+
+private:
+	struct Transform
+	{
+		bool hasPosition = false;
+		bool hasOrientation = false;
+		glm::vec3 position;
+		glm::quat orientation;
+	};
+
+	struct BonePaletteUpdate
+	{
+		graphics::BonesHandle bonesHandle;
+		BonePaletteArena::Palette palette;
+	};
+
+	template <typename T>
+	using HandleKey = std::pair<graphics::RenderSceneHandle, T>;
+
+	struct Buffer
+	{
+		std::map<HandleKey<graphics::RenderableHandle>, Transform> transforms;
+		std::map<HandleKey<graphics::RenderableHandle>, BonePaletteUpdate> bonePalettes;
+		std::map<HandleKey<graphics::PointLightHandle>, glm::vec3> pointLights;
+		std::vector<HandleKey<graphics::RenderableHandle>> destroyedRenderables;
+		std::vector<HandleKey<graphics::PointLightHandle>> destroyedPointLights;
+
+		void clear();
+	};
+
+	std::mutex mutex_;
+	std::array<Buffer, 2> buffers_;
+	uint32 back_ = 0;
+
+	Buffer& back();
+	const Buffer& front() const;
+};
+
+}
+
+#endif /* RENDERSTATE_H_ */
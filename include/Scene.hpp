@@ -4,6 +4,8 @@
 #include <vector>
 #include <string>
 #include <unordered_map>
+#include <limits>
+#include <future>
 
 #define GLM_FORCE_RADIANS
 #include <glm/glm.hpp>
@@ -16,10 +18,15 @@
 #include "exceptions/Exception.hpp"
 
 #include "SceneStatistics.hpp"
+#include "SceneSnapshot.hpp"
+#include "AnimationLodSettings.hpp"
 
 #include "ModelHandle.hpp"
 
 #include "Raycast.hpp"
+#include "QueryResults.hpp"
+#include "SpatialIndex.hpp"
+#include "RenderState.hpp"
 
 #include "ScriptFunctionHandleWrapper.hpp"
 
@@ -33,6 +40,8 @@
 #include "ecs/PositionComponent.hpp"
 #include "ecs/OrientationComponent.hpp"
 #include "ecs/PointLightComponent.hpp"
+#include "ecs/ReplicatedComponent.hpp"
+#include "replication/EntityState.hpp"
 
 #include "scripting/ScriptObjectHandle.hpp"
 
@@ -43,12 +52,17 @@
 #include "graphics/TextureHandle.hpp"
 #include "graphics/ShaderProgramHandle.hpp"
 #include "graphics/PointLightHandle.hpp"
+#include "graphics/CameraHandle.hpp"
 #include "physics/CollisionShapeHandle.hpp"
 #include "physics/RigidBodyObjectHandle.hpp"
 #include "physics/GhostObjectHandle.hpp"
+#include "physics/Sphere.hpp"
 
 #include "graphics/IGraphicsEngine.hpp"
 #include "ITerrain.hpp"
+#include "ITerrainTileSource.hpp"
+#include "StreamingTerrain.hpp"
+#include "TerrainStreamingSettings.hpp"
 #include "physics/IPhysicsEngine.hpp"
 #include "pathfinding/IPathfindingEngine.hpp"
 #include "audio/IAudioEngine.hpp"
@@ -107,11 +121,38 @@ public:
 	void tick(const float32 delta);
 	void render();
 
+	/**
+	 * Places the renderables that moved in the last tick between their previous and current transforms - alpha is how
+	 * far the frame is between the two ticks (see SimulationClock::alpha).  Call before render.
+	 */
+	void interpolate(const float32 alpha);
+
+	/**
+	 * Runs the parts of rendering that read simulation state (debug drawing and audio) - when the simulation is
+	 * pipelined, render() leaves them out and the engine calls this at the sync point instead.  While pipelined, this
+	 * is also where terrain ticks and the animation LOD camera is read, as both need the graphics engine.
+	 */
+	void synchronize();
+
 	void setSceneThingyInstance(void* object);
 
 	void setDebugRendering(const bool enabled);
 	bool debugRendering() const;
 
+	/**
+	 * Set the camera that animation level of detail distances and visibility are measured from.
+	 *
+	 * If no camera is set, all skeletons are sampled every tick.
+	 */
+	void setAnimationLodCamera(const graphics::CameraHandle& cameraHandle);
+	const graphics::CameraHandle& animationLodCamera() const;
+
+	/**
+	 * Waits for the skeletal animation work posted by the last tick - the engine calls this before the bone palette
+	 * arena moves on to a new frame.
+	 */
+	void waitForAnimations();
+
 	void createResources(const ecs::Entity& entity);
 	void destroyResources(const ecs::Entity& entity);
 
@@ -254,6 +295,12 @@ public:
 		return terrainPtr;
 	}
 
+	/**
+	 * Create a terrain whose tiles are generated from the tile source and streamed in and out around its focus point,
+	 * using the settings in the [terrain] section.
+	 */
+	StreamingTerrain* createStreamingTerrain(std::unique_ptr<ITerrainTileSource> tileSource, const SplatMap& splatMap, const DisplacementMap& displacementMap);
+
 	graphics::SkyboxRenderableHandle createSkyboxRenderable(const graphics::SkyboxHandle skyboxHandle)
 	{
 		return graphicsEngine_->createSkyboxRenderable(renderSceneHandle_, skyboxHandle);
@@ -304,6 +351,16 @@ public:
 	void serialize(const std::string& filename) override;
 	void deserialize(const std::string& filename) override;
 
+	/**
+	 * Save the scene on the background thread pool.
+	 *
+	 * The scene is captured at the end of the next tick (or a later one, if an earlier save is still being written) and
+	 * then encoded and written in the background.  If incremental is true and the previous incremental save went to
+	 * the same file, only the entities that changed since then are written, to filename.1, filename.2, etc.
+	 * Deserializing filename applies those on top of the full save.
+	 */
+	std::shared_future<void> serializeAsync(const std::string& filename, const bool incremental = false);
+
 	void addPreSerializeCallback(std::function<void(serialization::TextOutArchive&, ecs::EntityComponentSystem&, const unsigned int)> callback)
 	{
 		preSerializeCallbacks_.push_back(callback);
@@ -398,9 +455,41 @@ public:
 
 	Raycast raycast(const ray::Ray& ray);
 
+	/**
+	 * Batched raycasts - raycasts is resized to match rays, so reusing it between calls avoids reallocating.
+	 */
+	void raycast(const std::vector<ray::Ray>& rays, std::vector<Raycast>& raycasts);
+
 	std::vector<ecs::Entity> query(const glm::vec3& origin, const std::vector<glm::vec3>& points);
 	std::vector<ecs::Entity> query(const glm::vec3& origin, const float32 radius);
 
+	/**
+	 * Batched sphere queries - results is cleared, then holds the entities found by each sphere in turn.
+	 */
+	void query(const std::vector<physics::Sphere>& spheres, QueryResults<ecs::Entity>& results);
+
+	/**
+	 * Find entities by position, using the scene's spatial index rather than the physics engine - so entities without
+	 * a physics object are found too.  Results are appended to entities.
+	 */
+	void entitiesInRadius(const glm::vec3& origin, const float32 radius, std::vector<ecs::Entity>& entities);
+	void entitiesInBox(const glm::vec3& minimum, const glm::vec3& maximum, std::vector<ecs::Entity>& entities);
+	void entitiesInFrustum(const glm::mat4& viewProjection, std::vector<ecs::Entity>& entities);
+	void nearestEntities(const glm::vec3& origin, const uint32 k, std::vector<ecs::Entity>& entities, const float32 maxDistance = std::numeric_limits<float32>::max());
+
+	SpatialIndex& spatialIndex();
+
+	/**
+	 * States of the entities with a ReplicatedComponent, with their network ids as ids - states is cleared first.
+	 */
+	void replicationStates(std::vector<replication::EntityState>& states) const;
+
+	/**
+	 * Makes the entities with a ReplicatedComponent match states (from a replication::ReplicationClient).  Entities are
+	 * created for new network ids, and destroyed when their network id is no longer in states.
+	 */
+	void applyReplicationStates(const std::vector<replication::EntityState>& states);
+
 private:
 	friend class boost::serialization::access;
 
@@ -421,6 +510,9 @@ private:
 	IThreadPool* threadPool_;
 	IOpenGlLoader* openGlLoader_;
 
+	// When the simulation is pipelined, graphics updates made while ticking go here instead of to the graphics engine
+	RenderState* renderState_;
+
 	bool debugRendering_ = false;
 
 	audio::AudioSceneHandle audioSceneHandle_;
@@ -434,6 +526,88 @@ private:
 
 	SceneStatistics sceneStatistics_;
 
+	// Positions of all entities with a position component, kept up to date in applyChangesToEntities
+	SpatialIndex spatialIndex_;
+	std::vector<SpatialIndex::Id> spatialIndexResults_;
+
+	// Scratch buffers for batched physics queries
+	std::vector<physics::Raycast> physicsRaycasts_;
+	QueryResults<boost::variant<physics::RigidBodyObjectHandle, physics::GhostObjectHandle>> physicsQueryResults_;
+
+	// Renderables that moved in the last tick, by entity id - they are drawn between their previous and current
+	// transforms until the next tick (unless simulation.interpolation is false)
+	struct InterpolatedTransform
+	{
+		graphics::RenderableHandle renderableHandle;
+		glm::vec3 previousPosition;
+		glm::vec3 position;
+		glm::quat previousOrientation;
+		glm::quat orientation;
+		bool moved = false;
+
+		// Drawn at its transform already - entries are kept while pipelined, as the graphics engine can't be asked
+		// where a renderable is then
+		bool settled = false;
+	};
+
+	bool interpolation_ = true;
+	std::unordered_map<uint64, InterpolatedTransform> interpolatedTransforms_;
+
+	// Animation level of detail
+	struct AnimationLodState
+	{
+		uint32 interval = 1;
+		uint32 ticksUntilSample = 0;
+		uint64 lastTick = 0;
+		bool initialized = false;
+
+		// Bone palettes at the last sample time and the next one - in between samples we interpolate
+		std::vector<glm::mat4> previous;
+		std::vector<glm::mat4> next;
+	};
+
+	// Scene files are written as binary snapshots unless scene.binarysnapshots is false
+	bool binarySnapshots_ = true;
+	bool compressSnapshots_ = true;
+
+	// Everything a snapshot needs, taken at a tick boundary so it can be written on another thread
+	struct CapturedScene
+	{
+		std::string preSerialize;
+		std::string scene;
+		std::string postSerialize;
+		EntitySnapshot entities;
+	};
+
+	struct AsyncSave
+	{
+		std::string filename;
+		bool incremental = false;
+		std::unique_ptr<std::promise<void>> promise;
+	};
+
+	// Only touched by the save in flight - saves are written one at a time
+	struct IncrementalSaveState
+	{
+		std::string filename;
+		uint64 saveId = 0;
+		uint32 sequence = 0;
+		std::unordered_map<uint32, uint64> hashes;
+	};
+
+	std::vector<AsyncSave> asyncSaves_;
+	std::shared_future<void> saveInFlight_;
+	IncrementalSaveState incrementalSaveState_;
+
+	AnimationLodSettings animationLodSettings_;
+	TerrainStreamingSettings terrainStreamingSettings_;
+	graphics::CameraHandle animationLodCameraHandle_;
+	glm::vec3 animationLodCameraPosition_;
+	glm::vec3 animationLodCameraForward_ = glm::vec3(0.0f, 0.0f, -1.0f);
+	std::unordered_map<uint64, AnimationLodState> animationLodStates_;
+	uint64 animationTick_ = 0;
+	std::vector<std::future<void>> animationWork_;
+
 	// ecs::Entity system
 	std::unique_ptr<ecs::EntityComponentSystem> entityComponentSystem_;
 	std::unique_ptr<EntityComponentSystemEventListener> entityComponentSystemEventListener_;
@@ -442,6 +616,9 @@ private:
 
 	std::vector<std::unique_ptr<ITerrain>> terrain_;
 
+	// Time terrain hasn't been ticked for yet, while pipelined
+	float32 terrainDelta_ = 0.0f;
+
     boost::optional<std::vector<std::string>> scriptData_;
 	std::string initializationFunctionName_;
 
@@ -478,12 +655,24 @@ private:
     void tickPhysics(const float32 delta);
     void tickAudio(const float32 delta);
     void tickPathfinding(const float32 delta);
+    void tickTerrain(const float32 delta);
     void tickScriptObjects(const float32 delta);
     void tickAnimations(const float32 delta);
 
     void handleAsyncEntityCreation();
     void handleAsyncEntityDeletion();
+    void handleAsyncSaves();
+
+	void entitiesFromSpatialIndexResults(std::vector<ecs::Entity>& entities);
+	bool entityFromQueryResult(const boost::variant<physics::RigidBodyObjectHandle, physics::GhostObjectHandle>& object, ecs::Entity& entity) const;
+	void fillRaycast(const physics::Raycast& physicsRaycast, Raycast& result) const;
     void handleParentComponentChanges();
+	void beginInterpolationTick();
+	void recordInterpolatedTransform(ecs::Entity& entity);
+	void updateAnimationLodCamera();
+
+	void position(const graphics::RenderableHandle& renderableHandle, const glm::vec3& position);
+	void rotation(const graphics::RenderableHandle& renderableHandle, const glm::quat& orientation);
 
 	void applyChangesToEntities();
 
@@ -532,6 +721,50 @@ private:
 //		loadPhysicsEngineMappings(ar, version);
 	}
 
+	// Resource handle maps as they were when the scene was saved
+	struct SerializedHandleMaps
+	{
+		std::unordered_map<std::string, physics::CollisionShapeHandle> collisionShapeHandleMap;
+		std::unordered_map<std::string, ModelHandle> modelHandleMap;
+		std::unordered_map<std::string, graphics::MeshHandle> meshHandleMap;
+		std::unordered_map<std::string, graphics::TextureHandle> textureHandleMap;
+		std::unordered_map<std::string, SkeletonHandle> skeletonHandleMap;
+		std::unordered_map<std::string, AnimationHandle> animationHandleMap;
+		std::unordered_map<std::string, graphics::TerrainHandle> terrainHandleMap;
+		std::unordered_map<std::string, pathfinding::PolygonMeshHandle> polygonMeshHandleMap;
+		std::unordered_map<std::string, pathfinding::NavigationMeshHandle> navigationMeshHandleMap;
+		std::unordered_map<scripting::ScriptObjectHandle, std::string> scriptObjectHandleMap;
+	};
+
+	template<class Archive>
+	void loadHandleMaps(Archive& ar, SerializedHandleMaps& serializedHandleMaps)
+	{
+		ar & serializedHandleMaps.collisionShapeHandleMap;
+		ar & serializedHandleMaps.modelHandleMap;
+		ar & serializedHandleMaps.meshHandleMap;
+		ar & serializedHandleMaps.textureHandleMap;
+		ar & serializedHandleMaps.skeletonHandleMap;
+		ar & serializedHandleMaps.animationHandleMap;
+		ar & serializedHandleMaps.terrainHandleMap;
+		ar & serializedHandleMaps.polygonMeshHandleMap;
+		ar & serializedHandleMaps.navigationMeshHandleMap;
+		ar & serializedHandleMaps.scriptObjectHandleMap;
+	}
+
+	/**
+	 * Map the saved resource handles onto the currently loaded resources, then run the post deserialize callbacks.
+	 */
+	void resolveHandleMaps(const SerializedHandleMaps& serializedHandleMaps, serialization::TextInArchive& ar, const unsigned int version);
+
+	CapturedScene captureScene();
+	void writeSnapshot(std::ostream& outputStream, const CapturedScene& capturedScene, const EntitySnapshot& entities, const SceneSnapshot::Increment* increment) const;
+	void writeAsyncSave(const CapturedScene& capturedScene, const std::string& filename, const bool incremental);
+	void waitForAsyncSave() const;
+	static std::string incrementalSaveFilename(const std::string& filename, const uint32 sequence);
+
+	void saveSnapshot(std::ostream& outputStream);
+	void loadSnapshot(std::istream& inputStream, const std::string& filename);
+
 	template<class Handle>
 	auto generateNormalizedMap(
 		const std::unordered_map<std::string, Handle>& oldMap,
@@ -643,37 +876,8 @@ private:
 			callback(static_cast<serialization::TextInArchive&>(ar), *entityComponentSystem_, version);
 		}
 
-		std::unordered_map<std::string, physics::CollisionShapeHandle> collisionShapeHandleMap;
-		ar & collisionShapeHandleMap;
-
-		std::unordered_map<std::string, ModelHandle> modelHandleMap;
-		ar & modelHandleMap;
-
-		std::unordered_map<std::string, graphics::MeshHandle> meshHandleMap;
-		ar & meshHandleMap;
-
-		std::unordered_map<std::string, graphics::TextureHandle> textureHandleMap;
-		ar & textureHandleMap;
-
-		std::unordered_map<std::string, SkeletonHandle> skeletonHandleMap;
-		ar & skeletonHandleMap;
-
-		std::unordered_map<std::string, AnimationHandle> animationHandleMap;
-		ar & animationHandleMap;
-
-		std::unordered_map<std::string, graphics::TerrainHandle> terrainHandleMap;
-		ar & terrainHandleMap;
-
-		std::unordered_map<std::string, pathfinding::PolygonMeshHandle> polygonMeshHandleMap;
-		ar & polygonMeshHandleMap;
-
-		std::unordered_map<std::string, pathfinding::NavigationMeshHandle> navigationMeshHandleMap;
-		ar & navigationMeshHandleMap;
-
-		std::unordered_map<scripting::ScriptObjectHandle, std::string> scriptObjectHandleMap;
-		ar & scriptObjectHandleMap;
-
-		std::unordered_map<pathfinding::CrowdHandle, pathfinding::CrowdHandle> normalizedCrowdHandleMap;
+		SerializedHandleMaps serializedHandleMaps;
+		loadHandleMaps(ar, serializedHandleMaps);
 
 		ar & name_;
 
@@ -687,72 +891,7 @@ private:
 
 		ar & *entityComponentSystem_;
 
-		auto normalizedCollisionShapeHandleMap = generateNormalizedMap(collisionShapeHandleMap, gameEngine_->resourceHandleCache().collisionShapeHandleMap(), logger_);
-		auto normalizedModelHandleMap = generateNormalizedMap(modelHandleMap, gameEngine_->resourceHandleCache().modelHandleMap(), logger_);
-		auto normalizedMeshHandleMap = generateNormalizedMap(meshHandleMap, gameEngine_->resourceHandleCache().meshHandleMap(), logger_);
-		auto normalizedTextureHandleMap = generateNormalizedMap(textureHandleMap, gameEngine_->resourceHandleCache().textureHandleMap(), logger_);
-		auto normalizedSkeletonHandleMap = generateNormalizedMap(skeletonHandleMap, gameEngine_->resourceHandleCache().skeletonHandleMap(), logger_);
-		auto normalizedAnimationHandleMap = generateNormalizedMap(animationHandleMap, gameEngine_->resourceHandleCache().animationHandleMap(), logger_);
-		auto normalizedTerrainHandleMap = generateNormalizedMap(terrainHandleMap, gameEngine_->resourceHandleCache().terrainHandleMap(), logger_);
-		auto normalizedNavigationMeshHandleMap = generateNormalizedMap(navigationMeshHandleMap, gameEngine_->resourceHandleCache().navigationMeshHandleMap(), logger_);
-//		generateNormalizedMap(scriptingEngine_, moduleHandle_, executionContextHandle_, scriptObjectHandleMap, logger_);
-
-		normalizeHandles(
-			normalizedCollisionShapeHandleMap,
-			normalizedModelHandleMap,
-			normalizedMeshHandleMap,
-			normalizedTextureHandleMap,
-			normalizedSkeletonHandleMap,
-			normalizedAnimationHandleMap,
-			normalizedTerrainHandleMap,
-			polygonMeshHandleMap,
-			normalizedNavigationMeshHandleMap,
-			scriptObjectHandleMap,
-			normalizedCrowdHandleMap
-		);
-
-		for (auto entity : entityComponentSystem_->template entitiesWithComponents<ecs::ParentBoneAttachmentComponent>())
-		{
-			auto componentHandle = entity.template component<ecs::ParentBoneAttachmentComponent>();
-			entity.template assign<ecs::ParentBoneAttachmentComponent>(ecs::ParentBoneAttachmentComponent(*componentHandle));
-		}
-
-		for (auto entity : entityComponentSystem_->template entitiesWithComponents<ecs::PathfindingObstacleComponent>())
-		{
-			auto componentHandle = entity.template component<ecs::PathfindingObstacleComponent>();
-			componentHandle->obstacleHandle.invalidate();
-			entity.template assign<ecs::PathfindingObstacleComponent>(ecs::PathfindingObstacleComponent(*componentHandle));
-		}
-
-		LOG_DEBUG(logger_, "Calling post deserialize callbacks");
-
-		for (auto& callback : postDeserializeCallbacks_)
-		{
-			callback(
-				static_cast<serialization::TextInArchive&>(ar),
-				*entityComponentSystem_,
-				normalizedCollisionShapeHandleMap,
-				normalizedModelHandleMap,
-				normalizedMeshHandleMap,
-				normalizedTextureHandleMap,
-				normalizedSkeletonHandleMap,
-				normalizedAnimationHandleMap,
-				normalizedTerrainHandleMap,
-				polygonMeshHandleMap,
-				normalizedNavigationMeshHandleMap,
-				scriptObjectHandleMap,
-				normalizedCrowdHandleMap,
-				version
-			);
-		}
-
-		for (auto& scriptFunctionHandleWrapper : scriptPostDeserializeCallbacks_)
-		{
-			scripting::ParameterList params;
-			params.addRef(*this);
-
-			scriptingEngine_->execute(scriptFunctionHandleWrapper.get(), params, executionContextHandle_);
-		}
+		resolveHandleMaps(serializedHandleMaps, static_cast<serialization::TextInArchive&>(ar), version);
 		}
 		 catch(const Exception& e)
 		 {
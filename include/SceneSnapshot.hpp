@@ -0,0 +1,182 @@
+#ifndef SCENESNAPSHOT_H_
+#define SCENESNAPSHOT_H_
+
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <string>
+#include <istream>
+#include <ostream>
+
+#include "ecs/EntityComponentSystem.hpp"
+
+#include "logger/ILogger.hpp"
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+
+/**
+ * Binary, versioned scene snapshot format.
+ *
+ * A snapshot is a header followed by a sequence of tagged blocks:
+ *
+ *   header: magic "ICSS", format version, flags
+ *   block:  tag, block version, flags, uncompressed size, stored size, payload
+ *
+ * All header fields are little endian uint32's.  Payloads are optionally compressed with the BlockCompressor.
+ * Readers skip blocks with tags they don't know, so new block types (i.e. new components) can be added without
+ * breaking older readers.
+ *
+ * Entities are stored as a column of entity indices, followed by one block per component type (tagged
+ * TAG_COMPONENT + the component's id).  A component block holds a column of rows into the entity column, then the
+ * component data - plain data components (position, orientation) as a column of little endian floats that is bulk
+ * copied on load, and everything else as a binary archive of the components.
+ *
+ * Incremental saves are a chain of snapshots that share a save id.  Sequence 0 is a full snapshot, each following
+ * sequence only holds the entities that changed since the one before it, plus the indices of the removed entities.
+ */
+class SceneSnapshot
+{
+public:
+	static const uint32 MAGIC = 0x53534349; // "ICSS"
+	static const uint32 VERSION = 1;
+
+	enum Tag : uint32
+	{
+		TAG_END = 0,
+		TAG_SCENE = 1,
+		TAG_PRE_SERIALIZE = 2,
+		TAG_POST_SERIALIZE = 3,
+		TAG_ENTITIES = 4,
+		TAG_INCREMENT = 5,
+		TAG_COMPONENT = 0x100
+	};
+
+	struct Increment
+	{
+		uint64 saveId = 0;
+		uint32 sequence = 0;
+		std::vector<uint32> removed;
+	};
+
+	/**
+	 * Returns true if the stream starts with a scene snapshot header - the stream position is left unchanged.
+	 */
+	static bool isSnapshot(std::istream& inputStream);
+};
+
+/**
+ * A copy of the persistable entities and their components.
+ *
+ * Taking one only copies component data, so it is cheap enough to do at a tick boundary - the copy can then be hashed,
+ * encoded and written on a background thread while the simulation carries on.
+ */
+class EntitySnapshot
+{
+public:
+	EntitySnapshot();
+	explicit EntitySnapshot(const ecs::EntityComponentSystem& entityComponentSystem);
+	~EntitySnapshot();
+
+	EntitySnapshot(EntitySnapshot&& other);
+	EntitySnapshot& operator=(EntitySnapshot&& other);
+
+	const std::vector<uint32>& indices() const;
+
+	/**
+	 * Hash of each entity's persisted components, keyed by entity index.  Comparing the hashes of two snapshots gives
+	 * the entities that changed in between.
+	 */
+	std::unordered_map<uint32, uint64> hashes() const;
+
+	/**
+	 * Returns a snapshot with only the entities with the given indices - indices that aren't in this snapshot are ignored.
+	 */
+	EntitySnapshot subset(const std::vector<uint32>& indices) const;
+
+private:
+	friend class SceneSnapshotWriter;
+
+	struct Components;
+
+	std::vector<uint32> indices_;
+	std::unique_ptr<Components> components_;
+};
+
+class SceneSnapshotWriter
+{
+public:
+	SceneSnapshotWriter(std::ostream& outputStream, const bool compress);
+
+	void writeBlock(const uint32 tag, const uint32 version, const std::string& data);
+	void writeBlock(const uint32 tag, const uint32 version, const std::vector<byte>& data);
+
+	/**
+	 * Write the entity and component blocks for all persistable entities.
+	 */
+	void writeEntities(const ecs::EntityComponentSystem& entityComponentSystem);
+	void writeEntities(const EntitySnapshot& entitySnapshot);
+
+	void writeIncrement(const SceneSnapshot::Increment& increment);
+
+	/**
+	 * Write the end block - nothing can be written afterwards.
+	 */
+	void finish();
+
+private:
+	std::ostream& outputStream_;
+	bool compress_ = true;
+};
+
+class SceneSnapshotReader
+{
+public:
+	/**
+	 * Reads (and decompresses) every block in the snapshot.
+	 */
+	SceneSnapshotReader(std::istream& inputStream, logger::ILogger* logger);
+
+	bool hasBlock(const uint32 tag) const;
+
+	/**
+	 * Throws a RuntimeException if the snapshot has no block with the given tag.
+	 */
+	const std::vector<byte>& block(const uint32 tag) const;
+	std::string blockString(const uint32 tag) const;
+	uint32 blockVersion(const uint32 tag) const;
+
+	/**
+	 * Create the snapshot's entities and assign their components.
+	 */
+	void readEntities(ecs::EntityComponentSystem& entityComponentSystem) const;
+
+	/**
+	 * Apply an incremental snapshot on top of already loaded entities - removed entities are destroyed, and the
+	 * components of changed entities are replaced.
+	 */
+	void readEntityChanges(ecs::EntityComponentSystem& entityComponentSystem) const;
+
+	/**
+	 * Throws a RuntimeException if the snapshot isn't part of an incremental save.
+	 */
+	SceneSnapshot::Increment increment() const;
+
+private:
+	struct Block
+	{
+		uint32 version = 0;
+		std::vector<byte> data;
+	};
+
+	std::vector<uint32> readEntityIndices() const;
+
+	logger::ILogger* logger_;
+	std::unordered_map<uint32, Block> blocks_;
+};
+
+}
+
+#endif /* SCENESNAPSHOT_H_ */
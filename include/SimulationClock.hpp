@@ -0,0 +1,103 @@
+#ifndef SIMULATIONCLOCK_H_
+#define SIMULATIONCLOCK_H_
+
+#include "utilities/Properties.hpp"
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+
+/**
+ * Settings for the simulation clock, read from the [simulation] section of the settings.
+ *
+ * The simulation ticks tickRate times per second of wall clock time, whatever the frame rate.  A frame runs at most
+ * maxTicksPerFrame ticks, and frames longer than maxFrameDelta (a breakpoint, a level load) only count as
+ * maxFrameDelta - so a slow frame can't cause an ever growing number of ticks the next frame.  Time that can't be
+ * simulated is dropped, unless catchUp is set, in which case up to maxFrameDelta of it is carried over to later frames.
+ *
+ * With interpolation on, renderables are drawn between their transforms of the last two ticks.
+ *
+ * With pipelined on, the scenes simulate a frame on a worker thread while the previous frame renders - see RenderState.
+ * Terrain then ticks and the animation LOD camera is read at the sync point, and a renderable's first move after
+ * standing still isn't interpolated.  Scene scripts must not create renderables or point lights while pipelined.
+ *
+ * A fixedDelta above 0 replaces wall clock time - every frame counts as that long however long it took, so headless
+ * runs and benchmarks simulate exactly the same ticks every time.
+ */
+struct SimulationSettings
+{
+	SimulationSettings() = default;
+
+	SimulationSettings(const utilities::Properties& properties)
+	:
+		tickRate(properties.getFloatValue("simulation.tickrate", 60.0f)),
+		maxTicksPerFrame(static_cast<uint32>(properties.getIntValue("simulation.maxticksperframe", 5))),
+		maxFrameDelta(properties.getFloatValue("simulation.maxframedelta", 0.25f)),
+		catchUp(properties.getBoolValue("simulation.catchup", false)),
+		interpolation(properties.getBoolValue("simulation.interpolation", true)),
+		pipelined(properties.getBoolValue("simulation.pipelined", false)),
+		fixedDelta(properties.getFloatValue("simulation.fixeddelta", 0.0f))
+	{
+	}
+
+	float32 tickRate = 60.0f;
+	uint32 maxTicksPerFrame = 5;
+	float32 maxFrameDelta = 0.25f;
+	bool catchUp = false;
+	bool interpolation = true;
+	bool pipelined = false;
+	float32 fixedDelta = 0.0f;
+};
+
+/**
+ * Fixed timestep clock - turns frame times into a whole number of simulation ticks, plus how far the frame is into
+ * the next tick.
+ *
+ * Simulation time is counted in ticks, so it doesn't drift however long the game runs, and time that is dropped is
+ * counted rather than silently lost.
+ */
+class SimulationClock
+{
+public:
+	SimulationClock(const SimulationSettings& simulationSettings = SimulationSettings());
+
+	/**
+	 * Adds a frame's worth of wall clock time, returning the number of ticks to run.
+	 */
+	uint32 advance(const float32 frameDelta);
+
+	/**
+	 * Duration of a tick.
+	 */
+	float32 tickDelta() const;
+
+	/**
+	 * How far the frame is between the last tick and the next one, from 0 up to (but not including) 1.
+	 */
+	float32 alpha() const;
+
+	uint64 ticks() const;
+
+	/**
+	 * Simulated time in seconds.
+	 */
+	float64 time() const;
+
+	/**
+	 * Wall clock time in seconds that wasn't simulated.
+	 */
+	float64 droppedTime() const;
+
+private:
+	SimulationSettings simulationSettings_;
+	float64 tickDelta_;
+
+	float64 accumulator_ = 0.0;
+	float64 droppedTime_ = 0.0;
+	uint64 ticks_ = 0;
+};
+
+}
+
+#endif /* SIMULATIONCLOCK_H_ */
@@ -0,0 +1,107 @@
+#ifndef SPATIALINDEX_H_
+#define SPATIALINDEX_H_
+
+#include <vector>
+#include <array>
+#include <unordered_map>
+#include <limits>
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+
+/**
+ * Dynamic loose octree over points, keyed by a 64 bit id (the scene uses entity ids).
+ *
+ * Points are placed in the octant of a node that contains them, but a node's bounds for queries are twice its size.
+ * A point that moves only has to be relocated once it leaves its node's loose bounds, so small moves every tick are
+ * just a position update.  Points outside the root's bounds are kept in the root.
+ */
+class SpatialIndex
+{
+public:
+	typedef uint64 Id;
+
+	SpatialIndex(const glm::vec3& center = glm::vec3(0.0f), const float32 halfSize = 4096.0f, const uint32 maxItemsPerNode = 16, const uint32 maxDepth = 10);
+
+	/**
+	 * Insert the point, or move it if it's already in the index.
+	 */
+	void update(const Id id, const glm::vec3& position);
+	void remove(const Id id);
+	bool contains(const Id id) const;
+	void clear();
+
+	size_t size() const;
+
+	/**
+	 * Query results are appended to results.
+	 */
+	void queryRadius(const glm::vec3& center, const float32 radius, std::vector<Id>& results) const;
+	void queryBox(const glm::vec3& minimum, const glm::vec3& maximum, std::vector<Id>& results) const;
+
+	/**
+	 * Planes are (normal, distance) with normals pointing into the frustum - see frustumPlanes.
+	 */
+	void queryFrustum(const std::array<glm::vec4, 6>& planes, std::vector<Id>& results) const;
+
+	/**
+	 * Appends the (up to) k nearest points within maxDistance, nearest first.
+	 */
+	void queryNearest(const glm::vec3& point, const uint32 k, std::vector<Id>& results, const float32 maxDistance = std::numeric_limits<float32>::max()) const;
+
+	/**
+	 * Extract the frustum planes from a view projection matrix.
+	 */
+	static std::array<glm::vec4, 6> frustumPlanes(const glm::mat4& viewProjection);
+
+private:
+	static const uint32 NO_CHILDREN = std::numeric_limits<uint32>::max();
+
+	struct Node
+	{
+		glm::vec3 center;
+		float32 halfSize = 0.0f;
+		uint32 depth = 0;
+
+		// The 8 children are stored contiguously, starting at this index
+		uint32 children = NO_CHILDREN;
+
+		std::vector<uint32> items;
+	};
+
+	struct Item
+	{
+		Id id;
+		glm::vec3 position;
+		uint32 node;
+		uint32 slot;
+	};
+
+	uint32 maxItemsPerNode_;
+	uint32 maxDepth_;
+
+	std::vector<Node> nodes_;
+	std::vector<Item> items_;
+	std::unordered_map<Id, uint32> itemIndices_;
+
+	void insert(const uint32 itemIndex);
+	void addToNode(const uint32 nodeIndex, const uint32 itemIndex);
+	void removeFromNode(const uint32 itemIndex);
+	void split(const uint32 nodeIndex);
+
+	uint32 childFor(const Node& node, const glm::vec3& position) const;
+	bool insideLooseBounds(const Node& node, const glm::vec3& position) const;
+	bool insideBounds(const Node& node, const glm::vec3& position) const;
+
+	template <typename NodeTest, typename ItemTest>
+	void query(NodeTest&& nodeTest, ItemTest&& itemTest, std::vector<Id>& results) const;
+};
+
+}
+
+#endif /* SPATIALINDEX_H_ */
@@ -0,0 +1,160 @@
+#ifndef STREAMINGTERRAIN_H_
+#define STREAMINGTERRAIN_H_
+
+#include <map>
+#include <memory>
+#include <future>
+#include <utility>
+
+#include "ITerrain.hpp"
+#include "ITerrainTileSource.hpp"
+#include "IThreadPool.hpp"
+
+#include "graphics/IGraphicsEngine.hpp"
+#include "pathfinding/IPathfindingEngine.hpp"
+#include "physics/IPhysicsEngine.hpp"
+
+#include "ecs/Entity.hpp"
+
+#include "HeightMap.hpp"
+#include "Heightfield.hpp"
+#include "PathfindingTerrain.hpp"
+#include "TiledNavigationMesh.hpp"
+#include "SplatMap.hpp"
+#include "DisplacementMap.hpp"
+#include "TerrainStreamingSettings.hpp"
+
+#include "logger/ILogger.hpp"
+
+namespace ice_engine
+{
+
+class Scene;
+
+/**
+ * Terrain split into tiles that are streamed in and out around a focus point (or camera).
+ *
+ * Each tile has its own height map, physics heightfield and render terrain.  Navigation goes into one tiled navigation
+ * mesh with a single crowd - loading or unloading a tile only rebuilds the navigation tiles it covers, and agents walk
+ * from terrain tile to terrain tile.  Pathfinding engines without tiled navigation meshes get a navigation mesh and crowd
+ * per tile instead, and agents then don't cross from one tile's crowd into another's.
+ * Tile height data and the derived CPU side data are generated on the background thread pool - the engine resources are
+ * created on the main thread in tick, a few tiles per tick.
+ */
+class StreamingTerrain : public ITerrain
+{
+public:
+	StreamingTerrain(
+		const TerrainStreamingSettings& settings,
+		std::unique_ptr<ITerrainTileSource> tileSource,
+		const SplatMap& splatMap,
+		const DisplacementMap& displacementMap,
+		Scene* scene,
+		IThreadPool* threadPool,
+		logger::ILogger* logger,
+		graphics::IGraphicsEngine* graphicsEngine,
+		pathfinding::IPathfindingEngine* pathfindingEngine,
+		physics::IPhysicsEngine* physicsEngine,
+		graphics::RenderSceneHandle renderSceneHandle
+	);
+	~StreamingTerrain() override;
+
+	void tick(const float32 delta) override;
+	const std::vector<pathfinding::CrowdHandle>& crowds() const override;
+
+	/**
+	 * Stream tiles around the given camera's position - this overrides the focus point.
+	 */
+	void setCamera(const graphics::CameraHandle& cameraHandle);
+	void setFocus(const glm::vec3& focus);
+	const glm::vec3& focus() const;
+
+	uint32 numberOfLoadedTiles() const;
+	uint32 numberOfPendingTiles() const;
+
+private:
+	typedef std::pair<int32, int32> TileCoordinate;
+
+	struct TileData
+	{
+		HeightMap heightMap;
+		Heightfield heightfield;
+		PathfindingTerrain pathfindingTerrain;
+	};
+
+	struct Tile
+	{
+		enum class State
+		{
+			PENDING,
+			LOADED,
+			FAILED
+		};
+
+		State state = State::PENDING;
+
+		std::future<void> future;
+		std::shared_ptr<TileData> data;
+
+		ecs::Entity entity;
+		graphics::TerrainHandle terrainHandle;
+		physics::CollisionShapeHandle collisionShapeHandle;
+		pathfinding::PolygonMeshHandle polygonMeshHandle;
+		pathfinding::NavigationMeshHandle navigationMeshHandle;
+
+		// The tile's part of the tiled navigation mesh geometry
+		PathfindingTerrain pathfindingTerrain;
+	};
+
+	TerrainStreamingSettings settings_;
+	std::unique_ptr<ITerrainTileSource> tileSource_;
+	SplatMap splatMap_;
+	DisplacementMap displacementMap_;
+
+	Scene* scene_;
+	IThreadPool* threadPool_;
+	logger::ILogger* logger_;
+	graphics::IGraphicsEngine* graphicsEngine_;
+	pathfinding::IPathfindingEngine* pathfindingEngine_;
+	physics::IPhysicsEngine* physicsEngine_;
+	graphics::RenderSceneHandle renderSceneHandle_;
+
+	graphics::CameraHandle cameraHandle_;
+	glm::vec3 focus_;
+
+	std::map<TileCoordinate, Tile> tiles_;
+	uint32 numberOfPendingTiles_ = 0;
+
+	std::vector<pathfinding::CrowdHandle> crowdHandles_;
+
+	std::unique_ptr<TiledNavigationMesh> tiledNavigationMesh_;
+	pathfinding::CrowdHandle tiledCrowdHandle_;
+
+	void finishTiles();
+	void unloadTiles();
+	void requestTiles();
+
+	void createTileResources(const TileCoordinate& coordinate, Tile& tile);
+	void destroyTileResources(Tile& tile);
+
+	// Hands the geometry of every loaded tile to the tiled navigation mesh, rebuilding the area from minimum to maximum
+	void updateNavigationGeometry(const glm::vec3& minimum, const glm::vec3& maximum);
+
+	glm::vec3 tileOrigin(const TileCoordinate& coordinate) const;
+	float32 distanceToTile(const TileCoordinate& coordinate) const;
+
+	static void generateTile(
+		TileData& tileData,
+		const ITerrainTileSource& tileSource,
+		const TileCoordinate& coordinate,
+		const glm::vec3& origin,
+		const uint32 tileSize,
+		const bool navigation,
+		const float32 navigationMaximumError,
+		const bool precisePhysicsHeights
+	);
+};
+
+}
+
+#endif /* STREAMINGTERRAIN_H_ */
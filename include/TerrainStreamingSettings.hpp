@@ -0,0 +1,61 @@
+#ifndef TERRAINSTREAMINGSETTINGS_H_
+#define TERRAINSTREAMINGSETTINGS_H_
+
+#include "utilities/Properties.hpp"
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+
+/**
+ * Settings for streaming terrain, read from the [terrain] section of the settings.
+ *
+ * Tiles within loadDistance of the focus point are generated (nearest first), and tiles further than unloadDistance
+ * are destroyed - unloadDistance should be larger than loadDistance, so tiles don't flip in and out at the border.
+ * At most maxPendingTiles tiles are generated in the background at once, and at most maxTilesPerTick generated
+ * tiles get their graphics, physics and pathfinding resources created per tick.
+ */
+struct TerrainStreamingSettings
+{
+	TerrainStreamingSettings() = default;
+
+	TerrainStreamingSettings(const utilities::Properties& properties)
+	:
+		tileSize(static_cast<uint32>(properties.getIntValue("terrain.tilesize", 128))),
+		loadDistance(properties.getFloatValue("terrain.loaddistance", 512.0f)),
+		unloadDistance(properties.getFloatValue("terrain.unloaddistance", 640.0f)),
+		maxPendingTiles(static_cast<uint32>(properties.getIntValue("terrain.maxpendingtiles", 4))),
+		maxTilesPerTick(static_cast<uint32>(properties.getIntValue("terrain.maxtilespertick", 1))),
+		navigation(properties.getBoolValue("terrain.navigation", true)),
+		tiledNavigation(properties.getBoolValue("terrain.tilednavigation", true)),
+		navigationMaximumError(properties.getFloatValue("terrain.navigationmaxerror", 0.1f)),
+		precisePhysicsHeights(properties.getBoolValue("terrain.precisephysicsheights", false))
+	{
+	}
+
+	// Size of a tile in world units (and height samples)
+	uint32 tileSize = 128;
+	float32 loadDistance = 512.0f;
+	float32 unloadDistance = 640.0f;
+	uint32 maxPendingTiles = 4;
+	uint32 maxTilesPerTick = 1;
+
+	// Build navigation meshes and crowds for the tiles
+	bool navigation = true;
+
+	// Share one tiled navigation mesh and crowd between all loaded tiles, so agents can walk from tile to tile - a
+	// navigation mesh and crowd per tile if this is false, or the pathfinding engine has no tiled navigation meshes
+	bool tiledNavigation = true;
+
+	// How far (vertically) the navigation mesh input may be from the terrain - flat areas become a few large triangles
+	float32 navigationMaximumError = 0.1f;
+
+	// Hand tile heights to the physics engine as 16 bit or float samples - only for physics engines that read
+	// IHeightfield::dataType(), everything else gets 8 bit samples
+	bool precisePhysicsHeights = false;
+};
+
+}
+
+#endif /* TERRAINSTREAMINGSETTINGS_H_ */
@@ -0,0 +1,56 @@
+#ifndef TEXTURECACHE_H_
+#define TEXTURECACHE_H_
+
+#include <string>
+#include <iostream>
+
+#include "graphics/IImage.hpp"
+
+#include "CompressedImage.hpp"
+#include "TextureCompressor.hpp"
+#include "IThreadPool.hpp"
+
+#include "logger/ILogger.hpp"
+#include "fs/IFileSystem.hpp"
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+
+/**
+ * On disk cache of block compressed mip chains.
+ *
+ * Entries are keyed by a hash of the source image (dimensions, format and pixel data) and the target format,
+ * so the (slow) encode only happens the first time a given image is seen - after that the compressed levels
+ * are read straight from the cache directory.
+ */
+class TextureCache
+{
+public:
+	TextureCache(std::string cacheDirectory, fs::IFileSystem* fileSystem, logger::ILogger* logger, IThreadPool* threadPool = nullptr);
+
+	/**
+	 * Get the compressed mip chain for the provided image, compressing it and storing it in the cache if required.
+	 */
+	CompressedImage get(const graphics::IImage& image, const graphics::ICompressedImage::Format format);
+
+	bool exists(const graphics::IImage& image, const graphics::ICompressedImage::Format format) const;
+
+	static uint64 hash(const graphics::IImage& image);
+
+	static void save(std::ostream& outputStream, const CompressedImage& compressedImage);
+	static CompressedImage load(std::istream& inputStream);
+
+private:
+	std::string cacheDirectory_;
+	fs::IFileSystem* fileSystem_;
+	logger::ILogger* logger_;
+	TextureCompressor textureCompressor_;
+
+	std::string filename(const graphics::IImage& image, const graphics::ICompressedImage::Format format) const;
+};
+
+}
+
+#endif /* TEXTURECACHE_H_ */
@@ -0,0 +1,64 @@
+#ifndef TEXTURECOMPRESSOR_H_
+#define TEXTURECOMPRESSOR_H_
+
+#include <vector>
+
+#include "graphics/IImage.hpp"
+
+#include "CompressedImage.hpp"
+#include "Image.hpp"
+#include "IThreadPool.hpp"
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+
+/**
+ * Encodes uncompressed RGB/RGBA images into GPU block compressed formats (BC1, BC3, BC5 and BC7).
+ *
+ * Blocks are independent of each other, so each mip level is split into rows of blocks which are encoded
+ * in parallel on the provided thread pool.  If no thread pool is provided, all of the work is done on the
+ * calling thread.
+ *
+ * Note: Do not call compress from a worker of the same thread pool you provide - it waits on the work it posts.
+ */
+class TextureCompressor
+{
+public:
+	TextureCompressor(IThreadPool* threadPool = nullptr);
+
+	/**
+	 * Compress the provided image into the given block compressed format.
+	 *
+	 * @param image The image to compress.
+	 * @param format The block compressed format to encode to.
+	 * @param generateMipmaps Whether to generate and encode the full mip chain or only level 0.
+	 *
+	 * @return The compressed image.
+	 */
+	CompressedImage compress(const graphics::IImage& image, const graphics::ICompressedImage::Format format, const bool generateMipmaps = true) const;
+
+	/**
+	 * Decode a single level of a compressed image back into an RGBA image.
+	 *
+	 * Mostly useful for testing and as a software fallback when the GPU does not support the format.
+	 */
+	Image decompress(const graphics::ICompressedImage& image, const uint32 level = 0) const;
+
+	/**
+	 * Generate the mip chain for the provided image using a 2x2 box filter.
+	 *
+	 * The returned levels are always RGBA, and level 0 is the (converted) source image.
+	 */
+	static std::vector<Image> generateMipChain(const graphics::IImage& image);
+
+private:
+	IThreadPool* threadPool_;
+
+	std::vector<byte> compressLevel(const Image& image, const graphics::ICompressedImage::Format format) const;
+};
+
+}
+
+#endif /* TEXTURECOMPRESSOR_H_ */
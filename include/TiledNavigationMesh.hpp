@@ -0,0 +1,106 @@
+#ifndef TILEDNAVIGATIONMESH_H_
+#define TILEDNAVIGATIONMESH_H_
+
+#include <vector>
+#include <map>
+#include <set>
+#include <utility>
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+
+#include "IThreadPool.hpp"
+
+#include "pathfinding/IPathfindingEngine.hpp"
+
+#include "handles/HandleVector.hpp"
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+
+/**
+ * Navigation mesh built from terrain geometry in independent tiles.
+ *
+ * The geometry is split into tiles of polygonMeshConfig.tileSize cells (plus a border of polygonMeshConfig.borderSize
+ * cells), tiles are rasterized in parallel on the thread pool, and the results are added to a tiled navigation mesh
+ * of the pathfinding engine.  Editing the terrain or adding and removing obstacles only marks the tiles they touch
+ * for rebuilding, so a change costs a few tiles rather than the whole mesh.
+ *
+ * Changes are applied by update(), which has to be called from the engine thread.
+ */
+class TiledNavigationMesh
+{
+public:
+	typedef std::pair<int32, int32> TileCoordinate;
+
+	TiledNavigationMesh(
+		pathfinding::IPathfindingEngine* pathfindingEngine,
+		IThreadPool* threadPool,
+		const glm::vec3& origin,
+		const pathfinding::PolygonMeshConfig& polygonMeshConfig,
+		const pathfinding::NavigationMeshConfig& navigationMeshConfig = pathfinding::NavigationMeshConfig()
+	);
+	~TiledNavigationMesh();
+
+	TiledNavigationMesh(const TiledNavigationMesh& other) = delete;
+	TiledNavigationMesh& operator=(const TiledNavigationMesh& other) = delete;
+
+	const pathfinding::NavigationMeshHandle& navigationMeshHandle() const;
+
+	/**
+	 * Replaces the geometry and marks every tile it (or the previous geometry) covers for rebuilding.
+	 */
+	void setGeometry(const pathfinding::ITerrain& geometry);
+
+	/**
+	 * Replaces the geometry, but only marks the tiles touching the box from minimum to maximum - for edits that are
+	 * known to change only that area.
+	 */
+	void setGeometry(const pathfinding::ITerrain& geometry, const glm::vec3& minimum, const glm::vec3& maximum);
+
+	pathfinding::ObstacleHandle createObstacle(const glm::vec3& position, const float32 radius, const float32 height);
+	void destroy(const pathfinding::ObstacleHandle& obstacleHandle);
+
+	/**
+	 * Builds the tiles marked for rebuilding and adds them to the navigation mesh, returning how many were built.
+	 */
+	uint32 update();
+
+	/**
+	 * Coordinates of the tiles currently in the navigation mesh.
+	 */
+	const std::set<TileCoordinate>& tiles() const;
+
+private:
+	pathfinding::IPathfindingEngine* pathfindingEngine_;
+	IThreadPool* threadPool_;
+
+	glm::vec3 origin_;
+	float32 tileSize_;
+	float32 borderSize_;
+
+	pathfinding::NavigationMeshHandle navigationMeshHandle_;
+
+	std::vector<glm::vec3> vertices_;
+	std::vector<uint32> indices_;
+
+	// Triangles (as indices into indices_ / 3) touching each tile or its border
+	std::map<TileCoordinate, std::vector<uint32>> tileTriangles_;
+
+	handles::HandleVector<pathfinding::Obstacle, pathfinding::ObstacleHandle> obstacles_;
+
+	std::set<TileCoordinate> dirtyTiles_;
+	std::set<TileCoordinate> tiles_;
+
+	void assignTriangles();
+	void markTiles(const glm::vec3& minimum, const glm::vec3& maximum);
+
+	// Inclusive range of tiles whose bounds, grown by the border, overlap [minimum, maximum] on the xz plane
+	std::pair<TileCoordinate, TileCoordinate> tileRange(const glm::vec3& minimum, const glm::vec3& maximum) const;
+};
+
+}
+
+#endif /* TILEDNAVIGATIONMESH_H_ */
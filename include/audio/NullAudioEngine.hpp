@@ -0,0 +1,58 @@
+#ifndef NULLAUDIOENGINE_H_
+#define NULLAUDIOENGINE_H_
+
+#include <atomic>
+
+#include "audio/IAudioEngine.hpp"
+
+namespace ice_engine
+{
+namespace audio
+{
+
+/**
+ * An audio engine without an audio device, for headless runs - sounds are accepted and never heard.
+ */
+class NullAudioEngine : public IAudioEngine
+{
+public:
+	NullAudioEngine() = default;
+	virtual ~NullAudioEngine() override = default;
+
+	virtual AudioSceneHandle createAudioScene() override;
+	virtual void destroyAudioScene(const AudioSceneHandle& audioSceneHandle) override;
+
+	virtual void tick(const AudioSceneHandle audioSceneHandle, const float32 delta) override;
+
+	virtual void beginRender() override;
+	virtual void render(const AudioSceneHandle& audioSceneHandle) override;
+	virtual void endRender() override;
+
+	virtual SoundSourceHandle play(const AudioSceneHandle& audioSceneHandle, const SoundHandle& soundHandle, const glm::vec3& position) override;
+
+	virtual void stop(const AudioSceneHandle& audioSceneHandle, const SoundSourceHandle& soundSourceHandle) override;
+	virtual void stopAll(const AudioSceneHandle& audioSceneHandle) override;
+
+	virtual SoundHandle createSound(const IAudio& audio) override;
+	virtual void destroy(const SoundHandle soundHandle) override;
+
+	virtual ListenerHandle createListener(const AudioSceneHandle& audioSceneHandle, const glm::vec3& position) override;
+
+	virtual void setPosition(const AudioSceneHandle& audioSceneHandle, const SoundSourceHandle& soundSourceHandle, const float32 x, const float32 y, const float32 z) override;
+	virtual void setPosition(const AudioSceneHandle& audioSceneHandle, const SoundSourceHandle& soundSourceHandle, const glm::vec3& position) override;
+	virtual glm::vec3 position(const AudioSceneHandle& audioSceneHandle, const SoundSourceHandle& soundSourceHandle) const override;
+
+	virtual void setPosition(const AudioSceneHandle& audioSceneHandle, const ListenerHandle& listenerHandle, const float32 x, const float32 y, const float32 z) override;
+	virtual void setPosition(const AudioSceneHandle& audioSceneHandle, const ListenerHandle& listenerHandle, const glm::vec3& position) override;
+	virtual glm::vec3 position(const AudioSceneHandle& audioSceneHandle, const ListenerHandle& listenerHandle) const override;
+
+private:
+	std::atomic<uint32> nextIndex_{1};
+
+	uint32 nextIndex();
+};
+
+}
+}
+
+#endif /* NULLAUDIOENGINE_H_ */
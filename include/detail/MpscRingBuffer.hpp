@@ -0,0 +1,118 @@
+#ifndef MPSCRINGBUFFER_H_
+#define MPSCRINGBUFFER_H_
+
+#include <atomic>
+#include <vector>
+#include <utility>
+
+#include "detail/Assert.hpp"
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+namespace detail
+{
+
+/**
+ * Bounded lock free multiple producer, single consumer ring buffer.
+ *
+ * Each cell carries a sequence number that tells producers and the consumer whether the cell is free or
+ * holds a value for the current lap around the ring (Dmitry Vyukov's bounded queue).  Producers only contend
+ * on the enqueue position, and the consumer never takes a lock.
+ *
+ * Capacity must be a power of 2.
+ */
+template <typename T>
+class MpscRingBuffer
+{
+public:
+	MpscRingBuffer(const uint32 capacity) : cells_(capacity), mask_(capacity - 1)
+	{
+		ICE_ENGINE_ASSERT(capacity >= 2 && (capacity & (capacity - 1)) == 0);
+
+		for (uint32 i = 0; i < capacity; ++i)
+		{
+			cells_[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	MpscRingBuffer(const MpscRingBuffer& other) = delete;
+	MpscRingBuffer& operator=(const MpscRingBuffer& other) = delete;
+
+	/**
+	 * Try to push a value into the ring buffer - safe to call from any number of threads.
+	 *
+	 * @return false if the ring buffer is full (in which case value is left untouched).
+	 */
+	bool tryPush(T& value)
+	{
+		uint64 position = enqueuePosition_.load(std::memory_order_relaxed);
+
+		while (true)
+		{
+			Cell& cell = cells_[position & mask_];
+			const uint64 sequence = cell.sequence.load(std::memory_order_acquire);
+			const int64 difference = static_cast<int64>(sequence) - static_cast<int64>(position);
+
+			if (difference == 0)
+			{
+				if (enqueuePosition_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				{
+					cell.value = std::move(value);
+					cell.sequence.store(position + 1, std::memory_order_release);
+
+					return true;
+				}
+			}
+			else if (difference < 0)
+			{
+				return false;
+			}
+			else
+			{
+				position = enqueuePosition_.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	/**
+	 * Try to pop a value from the ring buffer - must only be called from the (single) consumer thread.
+	 *
+	 * @return false if the ring buffer is empty.
+	 */
+	bool tryPop(T& value)
+	{
+		Cell& cell = cells_[dequeuePosition_ & mask_];
+		const uint64 sequence = cell.sequence.load(std::memory_order_acquire);
+
+		if (static_cast<int64>(sequence) - static_cast<int64>(dequeuePosition_ + 1) < 0)
+		{
+			return false;
+		}
+
+		value = std::move(cell.value);
+		cell.sequence.store(dequeuePosition_ + mask_ + 1, std::memory_order_release);
+		++dequeuePosition_;
+
+		return true;
+	}
+
+private:
+	struct Cell
+	{
+		std::atomic<uint64> sequence;
+		T value;
+	};
+
+	std::vector<Cell> cells_;
+	const uint64 mask_;
+
+	alignas(64) std::atomic<uint64> enqueuePosition_{0};
+	alignas(64) uint64 dequeuePosition_ = 0;
+};
+
+}
+}
+
+#endif /* MPSCRINGBUFFER_H_ */
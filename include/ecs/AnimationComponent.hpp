@@ -10,6 +10,7 @@
 
 #include "graphics/BonesHandle.hpp"
 
+#include "serialization/Version.hpp"
 #include "serialization/std/Vector.hpp"
 #include "serialization/glm/Mat4.hpp"
 #include "serialization/std/chrono/Duration.hpp"
@@ -45,7 +46,6 @@ struct AnimationComponent
 	float32 speed = 1.0f;
 	uint32 startFrame = 0;
 	uint32 endFrame = 0;
-	std::vector<glm::mat4> transformations;
 };
 
 }
@@ -59,10 +59,19 @@ namespace serialization
 template<class Archive>
 void serialize(Archive& ar, ice_engine::ecs::AnimationComponent& c, const unsigned int version)
 {
-	ar & c.animationHandle & c.bonesHandle & c.runningTime & c.speed & c.startFrame & c.endFrame & c.transformations;
+	ar & c.animationHandle & c.bonesHandle & c.runningTime & c.speed & c.startFrame & c.endFrame;
+
+	// Version 0 saves still have the bone transformations, which now live in the bone palette arena
+	if (version == 0)
+	{
+		std::vector<glm::mat4> transformations;
+		ar & transformations;
+	}
 }
 
 }
 }
 
+BOOST_CLASS_VERSION(ice_engine::ecs::AnimationComponent, 1)
+
 #endif /* ANIMATIONCOMPONENT_H_ */
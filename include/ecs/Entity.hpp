@@ -27,6 +27,7 @@
 #include "ecs/DirtyComponent.hpp"
 #include "ecs/ParentBoneAttachmentComponent.hpp"
 #include "ecs/PropertiesComponent.hpp"
+#include "ecs/ReplicatedComponent.hpp"
 
 #include "ModelHandle.hpp"
 
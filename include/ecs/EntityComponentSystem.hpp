@@ -17,6 +17,7 @@
 #include "ecs/ScriptObjectComponent.hpp"
 #include "ecs/DirtyComponent.hpp"
 #include "ecs/PersistableComponent.hpp"
+#include "ecs/ReplicatedComponent.hpp"
 
 #include "serialization/std/Bitset.hpp"
 #include "serialization/SplitMember.hpp"
@@ -215,6 +216,14 @@ public:
 		return entities_.size();
 	}
 
+	/**
+	 * One past the highest entity index handed out so far - free slots included.
+	 */
+	size_t capacity() const
+	{
+		return entities_.capacity();
+	}
+
 private:
 	friend class boost::serialization::access;
 
@@ -244,6 +253,7 @@ private:
 		if (entity.hasComponent<ice_engine::ecs::ChildrenComponent>())				mask.set(ice_engine::ecs::ChildrenComponent::id());
 		if (entity.hasComponent<ice_engine::ecs::ParentBoneAttachmentComponent>())	mask.set(ice_engine::ecs::ParentBoneAttachmentComponent::id());
 		if (entity.hasComponent<ice_engine::ecs::PropertiesComponent>())	        mask.set(ice_engine::ecs::PropertiesComponent::id());
+		if (entity.hasComponent<ice_engine::ecs::ReplicatedComponent>())			mask.set(ice_engine::ecs::ReplicatedComponent::id());
 
 		return mask;
 	}
@@ -281,6 +291,7 @@ private:
 		if (entity.hasComponent<ice_engine::ecs::ChildrenComponent>()) saveComponent<Archive, ice_engine::ecs::ChildrenComponent>(ar, entity, version);
 		if (entity.hasComponent<ice_engine::ecs::ParentBoneAttachmentComponent>()) saveComponent<Archive, ice_engine::ecs::ParentBoneAttachmentComponent>(ar, entity, version);
 		if (entity.hasComponent<ice_engine::ecs::PropertiesComponent>()) saveComponent<Archive, ice_engine::ecs::PropertiesComponent>(ar, entity, version);
+		if (entity.hasComponent<ice_engine::ecs::ReplicatedComponent>()) saveComponent<Archive, ice_engine::ecs::ReplicatedComponent>(ar, entity, version);
 	}
 
 	template<class Archive>
@@ -323,6 +334,7 @@ private:
 		if (mask.test(ice_engine::ecs::ChildrenComponent::id())) loadComponent<Archive, ice_engine::ecs::ChildrenComponent>(ar, entity, version);
 		if (mask.test(ice_engine::ecs::ParentBoneAttachmentComponent::id())) loadComponent<Archive, ice_engine::ecs::ParentBoneAttachmentComponent>(ar, entity, version);
 		if (mask.test(ice_engine::ecs::PropertiesComponent::id())) loadComponent<Archive, ice_engine::ecs::PropertiesComponent>(ar, entity, version);
+		if (mask.test(ice_engine::ecs::ReplicatedComponent::id())) loadComponent<Archive, ice_engine::ecs::ReplicatedComponent>(ar, entity, version);
 
 		entity.assign<ice_engine::ecs::PersistableComponent>();
 	}
@@ -0,0 +1,49 @@
+#ifndef REPLICATEDCOMPONENT_H_
+#define REPLICATEDCOMPONENT_H_
+
+#include <vector>
+
+#include "serialization/std/Vector.hpp"
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+namespace ecs
+{
+
+/**
+ * Marks an entity for replication - its position, orientation and custom bytes are sent to clients under networkId.
+ */
+struct ReplicatedComponent
+{
+	ReplicatedComponent() = default;
+
+	ReplicatedComponent(uint32 networkId, std::vector<uint8> custom = std::vector<uint8>()) : networkId(networkId), custom(custom)
+	{
+	};
+
+	static uint8 id()  { return 18; }
+
+	uint32 networkId = 0;
+	std::vector<uint8> custom;
+};
+
+}
+}
+
+namespace boost
+{
+namespace serialization
+{
+
+template<class Archive>
+void serialize(Archive& ar, ice_engine::ecs::ReplicatedComponent& c, const unsigned int version)
+{
+	ar & c.networkId & c.custom;
+}
+
+}
+}
+
+#endif /* REPLICATEDCOMPONENT_H_ */
@@ -0,0 +1,42 @@
+#ifndef ICOMPRESSEDIMAGE_H_
+#define ICOMPRESSEDIMAGE_H_
+
+#include <vector>
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+namespace graphics
+{
+
+/**
+ * A block compressed image with a full (or partial) mip chain, ready to be uploaded to the GPU as is.
+ *
+ * Level 0 is the full resolution image, each following level is half the size of the previous one.
+ */
+class ICompressedImage
+{
+public:
+	enum Format
+	{
+		FORMAT_UNKNOWN = -1,
+		FORMAT_BC1,
+		FORMAT_BC3,
+		FORMAT_BC5,
+		FORMAT_BC7
+	};
+
+	virtual ~ICompressedImage() = default;
+
+	virtual uint32 levels() const = 0;
+	virtual const std::vector<byte>& data(const uint32 level) const = 0;
+	virtual uint32 width(const uint32 level) const = 0;
+	virtual uint32 height(const uint32 level) const = 0;
+	virtual int32 format() const = 0;
+};
+
+}
+}
+
+#endif /* ICOMPRESSEDIMAGE_H_ */
@@ -0,0 +1,25 @@
+#ifndef ICOMPRESSEDTEXTURE_H_
+#define ICOMPRESSEDTEXTURE_H_
+
+#include <string>
+
+#include "graphics/ICompressedImage.hpp"
+
+namespace ice_engine
+{
+namespace graphics
+{
+
+class ICompressedTexture
+{
+public:
+	virtual ~ICompressedTexture() = default;
+
+	virtual const std::string& name() const = 0;
+	virtual const ICompressedImage* image() const = 0;
+};
+
+}
+}
+
+#endif /* ICOMPRESSEDTEXTURE_H_ */
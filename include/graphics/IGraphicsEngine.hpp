@@ -8,6 +8,8 @@
 
 #include "Types.hpp"
 
+#include "exceptions/RuntimeException.hpp"
+
 #include "IEventListener.hpp"
 #include "TransformSpace.hpp"
 #include "RenderSceneHandle.hpp"
@@ -33,6 +35,7 @@
 #include "IDisplacementMap.hpp"
 #include "IMesh.hpp"
 #include "ITexture.hpp"
+#include "ICompressedTexture.hpp"
 #include "ISkeleton.hpp"
 #include "IImage.hpp"
 
@@ -107,6 +110,13 @@ public:
 	virtual void detachBoneAttachment(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle) = 0;
 
 	virtual TextureHandle createTexture2d(const ITexture& texture) = 0;
+	/**
+	 * Creates a texture from precompressed mip levels - engines without compressed texture support throw.
+	 */
+	virtual TextureHandle createTexture2d(const ICompressedTexture& texture)
+	{
+		throw RuntimeException("This graphics engine does not support compressed textures.");
+	}
     virtual bool valid(const TextureHandle& textureHandle) const = 0;
     virtual void destroy(const TextureHandle& textureHandle) = 0;
 
@@ -206,6 +216,19 @@ public:
 	virtual void position(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const float32 x, const float32 y, const float32 z) = 0;
 	virtual void position(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const glm::vec3& position) = 0;
 	virtual glm::vec3 position(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle) const = 0;
+
+	/**
+	 * Moves a terrain renderable (i.e. a streamed terrain tile) - engines without movable terrain throw.
+	 */
+	virtual void position(const RenderSceneHandle& renderSceneHandle, const TerrainRenderableHandle& terrainRenderableHandle, const glm::vec3& position)
+	{
+		throw RuntimeException("This graphics engine does not support positioning terrain renderables.");
+	}
+
+	virtual glm::vec3 position(const RenderSceneHandle& renderSceneHandle, const TerrainRenderableHandle& terrainRenderableHandle) const
+	{
+		throw RuntimeException("This graphics engine does not support positioning terrain renderables.");
+	}
 	virtual void position(const RenderSceneHandle& renderSceneHandle, const PointLightHandle& pointLightHandle, const float32 x, const float32 y, const float32 z) = 0;
 	virtual void position(const RenderSceneHandle& renderSceneHandle, const PointLightHandle& pointLightHandle, const glm::vec3& position) = 0;
 	virtual glm::vec3 position(const RenderSceneHandle& renderSceneHandle, const PointLightHandle& pointLightHandle) const = 0;
@@ -224,6 +247,16 @@ public:
 		const BonesHandle& bonesHandle,
 		const std::vector<glm::mat4>& transformations
 	) = 0;
+	virtual void update(
+		const RenderSceneHandle& renderSceneHandle,
+		const RenderableHandle& renderableHandle,
+		const BonesHandle& bonesHandle,
+		const glm::mat4* transformations,
+		const uint32 numberOfTransformations
+	)
+	{
+		update(renderSceneHandle, renderableHandle, bonesHandle, std::vector<glm::mat4>(transformations, transformations + numberOfTransformations));
+	}
 
 	virtual void setMouseRelativeMode(const bool enabled) = 0;
 	virtual void setWindowGrab(const bool enabled) = 0;
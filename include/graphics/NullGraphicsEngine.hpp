@@ -0,0 +1,226 @@
+#ifndef NULLGRAPHICSENGINE_H_
+#define NULLGRAPHICSENGINE_H_
+
+#include <atomic>
+
+#include <glm/gtc/quaternion.hpp>
+
+#include "graphics/IGraphicsEngine.hpp"
+
+namespace ice_engine
+{
+namespace graphics
+{
+
+/**
+ * A graphics engine without a window or a GPU, for headless runs.
+ *
+ * Everything is accepted and nothing is drawn - created objects get unique handles that stay valid, and queries
+ * return identity transforms.
+ */
+class NullGraphicsEngine : public IGraphicsEngine
+{
+public:
+	NullGraphicsEngine() = default;
+	virtual ~NullGraphicsEngine() override = default;
+
+	virtual void setViewport(const uint32 width, const uint32 height) override;
+	virtual glm::uvec2 getViewport() const override;
+
+	virtual glm::mat4 getModelMatrix() const override;
+	virtual glm::mat4 getViewMatrix() const override;
+	virtual glm::mat4 getProjectionMatrix() const override;
+
+	virtual void beginRender() override;
+	virtual void render(const RenderSceneHandle& renderSceneHandle) override;
+	virtual void renderLine(const glm::vec3& from, const glm::vec3& to, const glm::vec3& color) override;
+	virtual void renderLines(const std::vector<std::tuple<glm::vec3, glm::vec3, glm::vec3>>& lineData) override;
+	virtual void endRender() override;
+
+	virtual RenderSceneHandle createRenderScene() override;
+	virtual bool valid(const RenderSceneHandle& renderSceneHandle) const override;
+	virtual void destroy(const RenderSceneHandle& renderSceneHandle) override;
+
+	virtual CameraHandle createCamera(const glm::vec3& position, const glm::vec3& lookAt = glm::vec3(0.0f, 0.0f, 0.0f)) override;
+	virtual bool valid(const CameraHandle& cameraHandle) const override;
+	virtual void destroy(const CameraHandle& cameraHandle) override;
+
+	virtual PointLightHandle createPointLight(const RenderSceneHandle& renderSceneHandle, const glm::vec3& position) override;
+	virtual bool valid(const RenderSceneHandle& renderSceneHandle, const PointLightHandle& pointLightHandle) const override;
+	virtual void destroy(const RenderSceneHandle& renderSceneHandle, const PointLightHandle& pointLightHandle) override;
+
+	virtual MeshHandle createStaticMesh(const IMesh& mesh) override;
+	virtual MeshHandle createDynamicMesh(const IMesh& mesh) override;
+	virtual bool valid(const MeshHandle& meshHandle) const override;
+	virtual void destroy(const MeshHandle& meshHandle) override;
+
+	virtual SkeletonHandle createSkeleton(const MeshHandle& meshHandle, const ISkeleton& skeleton) override;
+	virtual bool valid(const SkeletonHandle& skeletonHandle) const override;
+	virtual void destroy(const SkeletonHandle& skeletonHandle) override;
+
+	virtual BonesHandle createBones(const uint32 maxNumberOfBones) override;
+	virtual bool valid(const BonesHandle& bonesHandle) const override;
+	virtual void destroy(const BonesHandle& bonesHandle) override;
+
+	virtual void attach(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const BonesHandle& bonesHandle) override;
+	virtual void detach(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const BonesHandle& bonesHandle) override;
+
+	virtual void attachBoneAttachment(
+		const RenderSceneHandle& renderSceneHandle,
+		const RenderableHandle& renderableHandle,
+		const BonesHandle& bonesHandle,
+		const glm::ivec4& boneIds,
+		const glm::vec4& boneWeights
+	) override;
+	virtual void detachBoneAttachment(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle) override;
+
+	virtual TextureHandle createTexture2d(const ITexture& texture) override;
+	virtual TextureHandle createTexture2d(const ICompressedTexture& texture) override;
+	virtual bool valid(const TextureHandle& textureHandle) const override;
+	virtual void destroy(const TextureHandle& textureHandle) override;
+
+	virtual MaterialHandle createMaterial(const IPbrMaterial& pbrMaterial) override;
+	virtual bool valid(const MaterialHandle& materialHandle) const override;
+	virtual void destroy(const MaterialHandle& materialHandle) override;
+
+	virtual TerrainHandle createStaticTerrain(
+			const IHeightMap& heightMap,
+			const ISplatMap& splatMap,
+			const IDisplacementMap& displacementMap
+		) override;
+	virtual bool valid(const TerrainHandle& terrainHandle) const override;
+	virtual void destroy(const TerrainHandle& terrainHandle) override;
+
+	virtual SkyboxHandle createStaticSkybox(const IImage& back, const IImage& down, const IImage& front, const IImage& left, const IImage& right, const IImage& up) override;
+	virtual bool valid(const SkyboxHandle& skyboxHandle) const override;
+	virtual void destroy(const SkyboxHandle& skyboxHandle) override;
+
+	virtual VertexShaderHandle createVertexShader(const std::string& data) override;
+	virtual FragmentShaderHandle createFragmentShader(const std::string& data) override;
+	virtual TessellationControlShaderHandle createTessellationControlShader(const std::string& data) override;
+	virtual TessellationEvaluationShaderHandle createTessellationEvaluationShader(const std::string& data) override;
+	virtual bool valid(const VertexShaderHandle& shaderHandle) const override;
+	virtual bool valid(const FragmentShaderHandle& shaderHandle) const override;
+	virtual bool valid(const TessellationControlShaderHandle& shaderHandle) const override;
+	virtual bool valid(const TessellationEvaluationShaderHandle& shaderHandle) const override;
+	virtual void destroy(const VertexShaderHandle& shaderHandle) override;
+	virtual void destroy(const FragmentShaderHandle& shaderHandle) override;
+	virtual void destroy(const TessellationControlShaderHandle& shaderHandle) override;
+	virtual void destroy(const TessellationEvaluationShaderHandle& shaderHandle) override;
+	virtual ShaderProgramHandle createShaderProgram(const VertexShaderHandle& vertexShaderHandle, const FragmentShaderHandle& fragmentShaderHandle) override;
+	virtual ShaderProgramHandle createShaderProgram(
+		const VertexShaderHandle& vertexShaderHandle,
+		const TessellationControlShaderHandle& tessellationControlShaderHandle,
+		const TessellationEvaluationShaderHandle& tessellationEvaluationShaderHandle,
+		const FragmentShaderHandle& fragmentShaderHandle
+	) override;
+	virtual bool valid(const ShaderProgramHandle& shaderProgramHandle) const override;
+	virtual void destroy(const ShaderProgramHandle& shaderProgramHandle) override;
+
+	virtual RenderableHandle createRenderable(
+		const RenderSceneHandle& renderSceneHandle,
+		const MeshHandle& meshHandle,
+		const TextureHandle& textureHandle,
+		const glm::vec3& position,
+		const glm::quat& orientation,
+		const glm::vec3& scale = glm::vec3(1.0f),
+		const ShaderProgramHandle& shaderProgramHandle = ShaderProgramHandle()
+	) override;
+	virtual RenderableHandle createRenderable(
+		const RenderSceneHandle& renderSceneHandle,
+		const MeshHandle& meshHandle,
+		const MaterialHandle& materialHandle,
+		const glm::vec3& position,
+		const glm::quat& orientation,
+		const glm::vec3& scale = glm::vec3(1.0f)
+	) override;
+	virtual bool valid(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle) const override;
+	virtual void destroy(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle) override;
+
+	virtual TerrainRenderableHandle createTerrainRenderable(
+		const RenderSceneHandle& renderSceneHandle,
+		const TerrainHandle& terrainHandle
+	) override;
+	virtual bool valid(const RenderSceneHandle& renderSceneHandle, const TerrainRenderableHandle& terrainRenderableHandle) const override;
+	virtual void destroy(const RenderSceneHandle& renderSceneHandle, const TerrainRenderableHandle& terrainRenderableHandle) override;
+
+	virtual SkyboxRenderableHandle createSkyboxRenderable(const RenderSceneHandle& renderSceneHandle, const SkyboxHandle& skyboxHandle) override;
+	virtual bool valid(const RenderSceneHandle& renderSceneHandle, const SkyboxRenderableHandle& skyboxRenderableHandle) const override;
+	virtual void destroy(const RenderSceneHandle& renderSceneHandle, const SkyboxRenderableHandle& skyboxRenderableHandle) override;
+
+	virtual void rotate(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const glm::quat& quaternion, const TransformSpace& relativeTo = TransformSpace::TS_LOCAL) override;
+	virtual void rotate(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const float32 degrees, const glm::vec3& axis, const TransformSpace& relativeTo = TransformSpace::TS_LOCAL) override;
+	virtual void rotate(const CameraHandle& cameraHandle, const glm::quat& quaternion, const TransformSpace& relativeTo = TransformSpace::TS_LOCAL) override;
+	virtual void rotate(const CameraHandle& cameraHandle, const float32 degrees, const glm::vec3& axis, const TransformSpace& relativeTo = TransformSpace::TS_LOCAL) override;
+
+	virtual void rotation(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const glm::quat& quaternion) override;
+	virtual void rotation(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const float32 degrees, const glm::vec3& axis) override;
+	virtual glm::quat rotation(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle) const override;
+	virtual void rotation(const CameraHandle& cameraHandle, const glm::quat& quaternion) override;
+	virtual void rotation(const CameraHandle& cameraHandle, const float32 degrees, const glm::vec3& axis) override;
+	virtual glm::quat rotation(const CameraHandle& cameraHandle) const override;
+
+	virtual void translate(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const float32 x, const float32 y, const float32 z) override;
+	virtual void translate(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const glm::vec3& trans) override;
+	virtual void translate(const RenderSceneHandle& renderSceneHandle, const PointLightHandle& pointLightHandle, const float32 x, const float32 y, const float32 z) override;
+	virtual void translate(const RenderSceneHandle& renderSceneHandle, const PointLightHandle& pointLightHandle, const glm::vec3& trans) override;
+	virtual void translate(const CameraHandle& cameraHandle, const float32 x, const float32 y, const float32 z) override;
+	virtual void translate(const CameraHandle& cameraHandle, const glm::vec3& trans) override;
+
+	virtual void scale(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const float32 x, const float32 y, const float32 z) override;
+	virtual void scale(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const glm::vec3& scale) override;
+	virtual void scale(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const float32 scale) override;
+	virtual glm::vec3 scale(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle) const override;
+
+	virtual void position(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const float32 x, const float32 y, const float32 z) override;
+	virtual void position(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const glm::vec3& position) override;
+	virtual glm::vec3 position(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle) const override;
+	virtual void position(const RenderSceneHandle& renderSceneHandle, const TerrainRenderableHandle& terrainRenderableHandle, const glm::vec3& position) override;
+	virtual glm::vec3 position(const RenderSceneHandle& renderSceneHandle, const TerrainRenderableHandle& terrainRenderableHandle) const override;
+	virtual void position(const RenderSceneHandle& renderSceneHandle, const PointLightHandle& pointLightHandle, const float32 x, const float32 y, const float32 z) override;
+	virtual void position(const RenderSceneHandle& renderSceneHandle, const PointLightHandle& pointLightHandle, const glm::vec3& position) override;
+	virtual glm::vec3 position(const RenderSceneHandle& renderSceneHandle, const PointLightHandle& pointLightHandle) const override;
+	virtual void position(const CameraHandle& cameraHandle, const float32 x, const float32 y, const float32 z) override;
+	virtual void position(const CameraHandle& cameraHandle, const glm::vec3& position) override;
+	virtual glm::vec3 position(const CameraHandle& cameraHandle) const override;
+
+	virtual void lookAt(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const glm::vec3& lookAt) override;
+	virtual void lookAt(const CameraHandle& cameraHandle, const glm::vec3& lookAt) override;
+
+	virtual void assign(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const SkeletonHandle& skeletonHandle) override;
+
+	virtual void update(
+		const RenderSceneHandle& renderSceneHandle,
+		const RenderableHandle& renderableHandle,
+		const BonesHandle& bonesHandle,
+		const std::vector<glm::mat4>& transformations
+	) override;
+	virtual void update(
+		const RenderSceneHandle& renderSceneHandle,
+		const RenderableHandle& renderableHandle,
+		const BonesHandle& bonesHandle,
+		const glm::mat4* transformations,
+		const uint32 numberOfTransformations
+	) override;
+
+	virtual void setMouseRelativeMode(const bool enabled) override;
+	virtual void setWindowGrab(const bool enabled) override;
+	virtual bool cursorVisible() const override;
+	virtual void setCursorVisible(const bool visible) override;
+
+	virtual void processEvents() override;
+	virtual void addEventListener(IEventListener* eventListener) override;
+	virtual void removeEventListener(IEventListener* eventListener) override;
+
+private:
+	std::atomic<uint32> nextIndex_{1};
+	glm::uvec2 viewport_ = glm::uvec2(0);
+	bool cursorVisible_ = true;
+
+	uint32 nextIndex();
+};
+
+}
+}
+
+#endif /* NULLGRAPHICSENGINE_H_ */
@@ -0,0 +1,106 @@
+#ifndef ASYNCLOGGER_H_
+#define ASYNCLOGGER_H_
+
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <string>
+
+#include "logger/ILogger.hpp"
+
+#include "detail/MpscRingBuffer.hpp"
+
+#include "utilities/Properties.hpp"
+
+namespace ice_engine
+{
+namespace logger
+{
+
+/**
+ * Settings for asynchronous logging, read from the [logging] section of the settings.
+ *
+ * queueSize records (a power of 2) can wait to be written.  When the queue is full, a record is dropped - or, with
+ * block, the logging thread waits for room.
+ */
+struct AsyncLoggerSettings
+{
+	AsyncLoggerSettings() = default;
+
+	AsyncLoggerSettings(const utilities::Properties& properties)
+	:
+		async(properties.getBoolValue("logging.async", true)),
+		queueSize(static_cast<uint32>(properties.getIntValue("logging.queuesize", 4096))),
+		block(properties.getStringValue("logging.overflow", "drop") == "block")
+	{
+	}
+
+	bool async = true;
+	uint32 queueSize = 4096;
+	bool block = false;
+};
+
+/**
+ * Moves formatting and writing of log messages off the logging threads.
+ *
+ * Records from the LOG_* macros go into a lock free queue shared by all threads, and a background thread formats
+ * them and hands them to the wrapped logger.  Fatal messages are written before the call returns.
+ */
+class AsyncLogger : public ILogger
+{
+public:
+	AsyncLogger(std::unique_ptr<ILogger> logger, const AsyncLoggerSettings& asyncLoggerSettings = AsyncLoggerSettings());
+	virtual ~AsyncLogger();
+
+	AsyncLogger(const AsyncLogger& other) = delete;
+	AsyncLogger& operator=(const AsyncLogger& other) = delete;
+
+	virtual void info(const std::string& message) override;
+	virtual void debug(const std::string& message) override;
+	virtual void trace(const std::string& message) override;
+	virtual void warn(const std::string& message) override;
+	virtual void error(const std::string& message) override;
+	virtual void fatal(const std::string& message) override;
+
+	virtual void info(const std::wstring& message) override;
+	virtual void debug(const std::wstring& message) override;
+	virtual void trace(const std::wstring& message) override;
+	virtual void warn(const std::wstring& message) override;
+	virtual void error(const std::wstring& message) override;
+	virtual void fatal(const std::wstring& message) override;
+
+	virtual void write(LogRecord&& record) override;
+
+	/**
+	 * Waits until every record logged so far has been written.
+	 */
+	void flush();
+
+	/**
+	 * Records lost because the queue was full.
+	 */
+	uint64 droppedRecords() const;
+
+private:
+	std::unique_ptr<ILogger> logger_;
+	AsyncLoggerSettings asyncLoggerSettings_;
+
+	detail::MpscRingBuffer<LogRecord> records_;
+	std::atomic<uint64> pushed_{0};
+	std::atomic<uint64> written_{0};
+	std::atomic<uint64> dropped_{0};
+
+	// Only touched by the thread draining the queue
+	uint64 reportedDropped_ = 0;
+
+	std::atomic<bool> running_{true};
+	std::thread thread_;
+
+	void run();
+	uint64 drain();
+};
+
+}
+}
+
+#endif /* ASYNCLOGGER_H_ */
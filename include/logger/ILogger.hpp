@@ -6,21 +6,29 @@
 
 #include "detail/Format.hpp"
 
-#define LOG_INFO(logger, message, ...) logger->info(std::string(__FUNCTION__) + " line " + std::to_string(__LINE__) + ": " + ice_engine::detail::format(message, ##__VA_ARGS__));
-#define LOG_WARN(logger, message, ...) logger->warn(std::string(__FUNCTION__) + " line " + std::to_string(__LINE__) + ": " + ice_engine::detail::format(message, ##__VA_ARGS__));
-#define LOG_ERROR(logger, message, ...) logger->error(std::string(__FUNCTION__) + " line " + std::to_string(__LINE__) + ": " + ice_engine::detail::format(message, ##__VA_ARGS__));
-#define LOG_FATAL(logger, message, ...) logger->fatal(std::string(__FUNCTION__) + " line " + std::to_string(__LINE__) + ": " + ice_engine::detail::format(message, ##__VA_ARGS__));
+#include "logger/LogRecord.hpp"
+
+/**
+ * The message and its arguments are packed into a LogRecord - formatting is up to the logger, which may defer it to
+ * another thread.  Debug and trace messages are compiled out unless enabled.
+ */
+#define ICEENGINE_LOG(loggerInstance, level, message, ...) loggerInstance->write(ice_engine::logger::LogRecord(level, __FUNCTION__, __LINE__, message, ##__VA_ARGS__));
+
+#define LOG_INFO(loggerInstance, message, ...) ICEENGINE_LOG(loggerInstance, ice_engine::logger::LOG_LEVEL_INFO, message, ##__VA_ARGS__)
+#define LOG_WARN(loggerInstance, message, ...) ICEENGINE_LOG(loggerInstance, ice_engine::logger::LOG_LEVEL_WARN, message, ##__VA_ARGS__)
+#define LOG_ERROR(loggerInstance, message, ...) ICEENGINE_LOG(loggerInstance, ice_engine::logger::LOG_LEVEL_ERROR, message, ##__VA_ARGS__)
+#define LOG_FATAL(loggerInstance, message, ...) ICEENGINE_LOG(loggerInstance, ice_engine::logger::LOG_LEVEL_FATAL, message, ##__VA_ARGS__)
 
 #if defined(DEBUG) || defined(ICEENGINE_ENABLE_DEBUG_LOGGING)
-	#define LOG_DEBUG(logger, message, ...) logger->debug(std::string(__FUNCTION__) + " line " + std::to_string(__LINE__) + ": " + ice_engine::detail::format(message, ##__VA_ARGS__));
+	#define LOG_DEBUG(loggerInstance, message, ...) ICEENGINE_LOG(loggerInstance, ice_engine::logger::LOG_LEVEL_DEBUG, message, ##__VA_ARGS__)
 #else
-	#define LOG_DEBUG(logger, message, ...)
+	#define LOG_DEBUG(loggerInstance, message, ...)
 #endif
 
 #if defined(DEBUG) || defined(ICEENGINE_ENABLE_TRACE_LOGGING)
-	#define LOG_TRACE(logger, message, ...) logger->trace(std::string(__FUNCTION__) + " line " + std::to_string(__LINE__) + ": " + ice_engine::detail::format(message, ##__VA_ARGS__));
+	#define LOG_TRACE(loggerInstance, message, ...) ICEENGINE_LOG(loggerInstance, ice_engine::logger::LOG_LEVEL_TRACE, message, ##__VA_ARGS__)
 #else
-	#define LOG_TRACE(logger, message, ...)
+	#define LOG_TRACE(loggerInstance, message, ...)
 #endif
 
 namespace ice_engine
@@ -46,6 +54,39 @@ public:
 	virtual void warn(const std::wstring& message) = 0;
 	virtual void error(const std::wstring& message) = 0;
 	virtual void fatal(const std::wstring& message) = 0;
+
+	/**
+	 * Writes a record from the LOG_* macros - by default it is formatted and written right away.
+	 */
+	virtual void write(LogRecord&& record)
+	{
+		switch (record.level())
+		{
+			case LOG_LEVEL_TRACE:
+				trace(record.message());
+				break;
+
+			case LOG_LEVEL_DEBUG:
+				debug(record.message());
+				break;
+
+			case LOG_LEVEL_INFO:
+				info(record.message());
+				break;
+
+			case LOG_LEVEL_WARN:
+				warn(record.message());
+				break;
+
+			case LOG_LEVEL_ERROR:
+				error(record.message());
+				break;
+
+			case LOG_LEVEL_FATAL:
+				fatal(record.message());
+				break;
+		}
+	}
 };
 
 static ILogger* gLogger = nullptr;
@@ -0,0 +1,182 @@
+#ifndef LOGRECORD_H_
+#define LOGRECORD_H_
+
+#include <string>
+#include <sstream>
+#include <cstring>
+#include <type_traits>
+
+#include <boost/container/small_vector.hpp>
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+namespace logger
+{
+
+enum LogLevel : uint8
+{
+	LOG_LEVEL_TRACE = 0,
+	LOG_LEVEL_DEBUG,
+	LOG_LEVEL_INFO,
+	LOG_LEVEL_WARN,
+	LOG_LEVEL_ERROR,
+	LOG_LEVEL_FATAL
+};
+
+/**
+ * A log message that hasn't been formatted yet - what the LOG_* macros hand to ILogger::write.
+ *
+ * The format is copied - a char array may as well be a buffer on the caller's stack as a literal - and the
+ * arguments are copied as raw values into a small inline buffer.  Strings are copied by value, and arguments of any other type are streamed
+ * into a string up front, the way boost::format would have streamed them.  Formatting is left to message(),
+ * which an asynchronous logger calls on its own thread.
+ */
+class LogRecord
+{
+public:
+	LogRecord() = default;
+
+	template <typename ... Args>
+	LogRecord(const LogLevel level, const char* function, const uint32 line, const std::string& format, const Args& ... args)
+	:
+		level_(level),
+		function_(function),
+		line_(line),
+		ownedFormat_(format)
+	{
+		add(args ...);
+	}
+
+	/**
+	 * A message that is already formatted - it is written as is.
+	 */
+	LogRecord(const LogLevel level, std::string message) : level_(level), ownedFormat_(std::move(message)), formatted_(true)
+	{
+	}
+
+	LogLevel level() const
+	{
+		return level_;
+	}
+
+	/**
+	 * The formatted message, prefixed with the function and line it was logged from.
+	 *
+	 * Throws what boost::format throws if the arguments don't match the format.
+	 */
+	std::string message() const;
+
+private:
+	enum ArgumentType : uint8
+	{
+		ARGUMENT_TYPE_BOOL = 0,
+		ARGUMENT_TYPE_CHAR,
+		ARGUMENT_TYPE_SIGNED,
+		ARGUMENT_TYPE_UNSIGNED,
+		ARGUMENT_TYPE_FLOAT32,
+		ARGUMENT_TYPE_FLOAT64,
+		ARGUMENT_TYPE_STRING
+	};
+
+	LogLevel level_ = LOG_LEVEL_INFO;
+	const char* function_ = nullptr;
+	uint32 line_ = 0;
+	std::string ownedFormat_;
+	bool formatted_ = false;
+
+	// Each argument is a type tag followed by its value - strings are a length followed by their characters
+	boost::container::small_vector<char, 128> arguments_;
+
+	void add()
+	{
+	}
+
+	template <typename Arg, typename ... Args>
+	void add(const Arg& arg, const Args& ... args)
+	{
+		addArgument(arg);
+		add(args ...);
+	}
+
+	template <typename T>
+	void write(const ArgumentType type, const T& value)
+	{
+		const size_t size = arguments_.size();
+		arguments_.resize(size + 1 + sizeof(T));
+		arguments_[size] = static_cast<char>(type);
+		std::memcpy(&arguments_[size + 1], &value, sizeof(T));
+	}
+
+	void addString(const char* data, const uint32 length)
+	{
+		write(ARGUMENT_TYPE_STRING, length);
+		arguments_.insert(arguments_.end(), data, data + length);
+	}
+
+	void addArgument(const bool value)
+	{
+		write(ARGUMENT_TYPE_BOOL, value);
+	}
+
+	void addArgument(const char value)
+	{
+		write(ARGUMENT_TYPE_CHAR, value);
+	}
+
+	void addArgument(const signed char value)
+	{
+		write(ARGUMENT_TYPE_CHAR, static_cast<char>(value));
+	}
+
+	void addArgument(const unsigned char value)
+	{
+		write(ARGUMENT_TYPE_CHAR, static_cast<char>(value));
+	}
+
+	void addArgument(const float32 value)
+	{
+		write(ARGUMENT_TYPE_FLOAT32, value);
+	}
+
+	void addArgument(const float64 value)
+	{
+		write(ARGUMENT_TYPE_FLOAT64, value);
+	}
+
+	void addArgument(const char* value)
+	{
+		addString(value, static_cast<uint32>(std::strlen(value)));
+	}
+
+	void addArgument(const std::string& value)
+	{
+		addString(value.data(), static_cast<uint32>(value.size()));
+	}
+
+	template <typename T>
+	typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type addArgument(const T value)
+	{
+		write(ARGUMENT_TYPE_SIGNED, static_cast<int64>(value));
+	}
+
+	template <typename T>
+	typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value>::type addArgument(const T value)
+	{
+		write(ARGUMENT_TYPE_UNSIGNED, static_cast<uint64>(value));
+	}
+
+	template <typename T>
+	typename std::enable_if<!std::is_arithmetic<T>::value>::type addArgument(const T& value)
+	{
+		std::ostringstream stream;
+		stream << value;
+		addArgument(stream.str());
+	}
+};
+
+}
+}
+
+#endif /* LOGRECORD_H_ */
@@ -0,0 +1,163 @@
+#ifndef BATCHINGNETWORKINGENGINE_H_
+#define BATCHINGNETWORKINGENGINE_H_
+
+#include <vector>
+#include <map>
+#include <memory>
+#include <tuple>
+
+#include "networking/INetworkingEngine.hpp"
+#include "networking/IEventListener.hpp"
+#include "networking/MessageBuffer.hpp"
+#include "networking/Channel.hpp"
+
+#include "logger/ILogger.hpp"
+
+#include "utilities/Properties.hpp"
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+namespace networking
+{
+
+/**
+ * Settings for message batching, read from the [networking] section of the settings.
+ *
+ * Batches are kept to maxBatchSize bytes (a single larger message gets a batch of its own), and batches of at least
+ * compressionThreshold bytes are compressed when that makes them smaller.
+ */
+struct BatchingSettings
+{
+	BatchingSettings() = default;
+
+	BatchingSettings(const utilities::Properties& properties)
+	:
+		enabled(properties.getBoolValue("networking.batching", false)),
+		maxBatchSize(static_cast<uint32>(properties.getIntValue("networking.maxbatchsize", 1200))),
+		compression(properties.getBoolValue("networking.compression", true)),
+		compressionThreshold(static_cast<uint32>(properties.getIntValue("networking.compressionthreshold", 256)))
+	{
+	}
+
+	// Batching changes the wire format, so it is opt in - peers without it can't read batches
+	bool enabled = false;
+
+	// Stay below the path MTU, so unreliable batches aren't fragmented
+	uint32 maxBatchSize = 1200;
+
+	bool compression = true;
+	uint32 compressionThreshold = 256;
+};
+
+/**
+ * Wraps a networking engine so the messages sent to a connection during a tick go out as a few batches, rather than a
+ * packet each.
+ *
+ * Messages are queued per destination and channel, and tick() packs each queue into batches before ticking the
+ * wrapped engine.  A batch is a flags byte followed by the messages, each prefixed with its length as a variable length
+ * integer - optionally compressed as a whole.  Incoming batches are split back into one MessageEvent per message, so
+ * listeners see the same events as without batching.  Both ends of a connection have to batch.
+ *
+ * Messages keep their order per destination and channel.  Broadcasts and messages to single connections of the same
+ * server keep their order too - queueing one kind sends the other kind's pending messages for that channel first, so
+ * alternating between the two costs batching, but never reorders.
+ */
+class BatchingNetworkingEngine : public INetworkingEngine, public IEventListener
+{
+public:
+	BatchingNetworkingEngine(std::unique_ptr<INetworkingEngine> networkingEngine, logger::ILogger* logger, const BatchingSettings& batchingSettings = BatchingSettings());
+	~BatchingNetworkingEngine() override;
+
+	BatchingNetworkingEngine(const BatchingNetworkingEngine& other) = delete;
+	BatchingNetworkingEngine& operator=(const BatchingNetworkingEngine& other) = delete;
+
+	ServerHandle createServer() override;
+	ClientHandle createClient() override;
+
+	void destroyServer(const ServerHandle& serverHandle) override;
+	void destroyClient(const ClientHandle& clientHandle) override;
+
+	/**
+	 * Sends the queued messages, then ticks the wrapped engine.
+	 */
+	void tick(const float32 delta) override;
+
+	void send(const ServerHandle& serverHandle, const std::vector<uint8>& data) override;
+	void send(const ServerHandle& serverHandle, const RemoteConnectionHandle& remoteConnectionHandle, const std::vector<uint8>& data) override;
+	void send(const ClientHandle& clientHandle, const std::vector<uint8>& data) override;
+
+	void send(const ServerHandle& serverHandle, MessageBuffer data) override;
+	void send(const ServerHandle& serverHandle, const RemoteConnectionHandle& remoteConnectionHandle, MessageBuffer data) override;
+	void send(const ClientHandle& clientHandle, MessageBuffer data) override;
+
+	void send(const ServerHandle& serverHandle, MessageBuffer data, const Channel channel) override;
+	void send(const ServerHandle& serverHandle, const RemoteConnectionHandle& remoteConnectionHandle, MessageBuffer data, const Channel channel) override;
+	void send(const ClientHandle& clientHandle, MessageBuffer data, const Channel channel) override;
+
+	void processEvents() override;
+	void addEventListener(networking::IEventListener* eventListener) override;
+	void removeEventListener(networking::IEventListener* eventListener) override;
+
+	// Events from the wrapped engine
+	bool processEvent(const ConnectEvent& event) override;
+	bool processEvent(const DisconnectEvent& event) override;
+	bool processEvent(const MessageEvent& event) override;
+
+	/**
+	 * Packs and sends the queued messages now, rather than on the next tick.
+	 */
+	void flush();
+
+	/**
+	 * Number of batches and messages sent since construction.
+	 */
+	uint64 batches() const;
+	uint64 messages() const;
+
+	/**
+	 * Appends the messages in a batch to messages - throws a RuntimeException if the batch is malformed.
+	 */
+	static void unpack(const uint8* data, const size_t size, MessageBufferPool& messageBufferPool, std::vector<MessageBuffer>& messages);
+
+private:
+	enum DestinationType
+	{
+		SERVER = 0,
+		SERVER_CONNECTION,
+		CLIENT
+	};
+
+	// Type, server or client handle id, remote connection handle id, channel
+	typedef std::tuple<uint32, uint64, uint64, uint32> Destination;
+
+	struct Queue
+	{
+		std::vector<MessageBuffer> messages;
+	};
+
+	std::unique_ptr<INetworkingEngine> networkingEngine_;
+	logger::ILogger* logger_;
+	BatchingSettings batchingSettings_;
+
+	MessageBufferPool messageBufferPool_;
+
+	std::map<Destination, Queue> queues_;
+	std::vector<networking::IEventListener*> eventListeners_;
+
+	std::vector<uint8> batch_;
+	std::vector<MessageBuffer> received_;
+
+	uint64 batches_ = 0;
+	uint64 messages_ = 0;
+
+	void queue(const Destination& destination, MessageBuffer data);
+	void flush(const Destination& destination, Queue& queue);
+	void sendBatch(const Destination& destination);
+};
+
+}
+}
+
+#endif /* BATCHINGNETWORKINGENGINE_H_ */
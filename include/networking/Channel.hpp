@@ -0,0 +1,22 @@
+#ifndef NETWORKING_CHANNEL_H_
+#define NETWORKING_CHANNEL_H_
+
+namespace ice_engine
+{
+namespace networking
+{
+
+/**
+ * Reliable messages arrive, in order.  Unreliable messages may be dropped, but never hold up later messages - for
+ * state that is resent every tick anyway.
+ */
+enum Channel
+{
+	RELIABLE = 0,
+	UNRELIABLE
+};
+
+}
+}
+
+#endif /* NETWORKING_CHANNEL_H_ */
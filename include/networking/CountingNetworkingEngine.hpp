@@ -0,0 +1,68 @@
+#ifndef COUNTINGNETWORKINGENGINE_H_
+#define COUNTINGNETWORKINGENGINE_H_
+
+#include <vector>
+#include <memory>
+
+#include "networking/INetworkingEngine.hpp"
+#include "networking/IEventListener.hpp"
+
+namespace ice_engine
+{
+namespace networking
+{
+
+/**
+ * Wraps a networking engine and records the traffic through it in the networking.* metrics.
+ *
+ * networking.bytes_sent and networking.bytes_received count the bytes handed to and delivered by the wrapped engine,
+ * and networking.batch_bytes records the size of each send - a whole batch when a BatchingNetworkingEngine sits on top,
+ * otherwise a single message.
+ */
+class CountingNetworkingEngine : public INetworkingEngine, public IEventListener
+{
+public:
+	CountingNetworkingEngine(std::unique_ptr<INetworkingEngine> networkingEngine);
+	~CountingNetworkingEngine() override;
+
+	CountingNetworkingEngine(const CountingNetworkingEngine& other) = delete;
+	CountingNetworkingEngine& operator=(const CountingNetworkingEngine& other) = delete;
+
+	ServerHandle createServer() override;
+	ClientHandle createClient() override;
+
+	void destroyServer(const ServerHandle& serverHandle) override;
+	void destroyClient(const ClientHandle& clientHandle) override;
+
+	void tick(const float32 delta) override;
+
+	void send(const ServerHandle& serverHandle, const std::vector<uint8>& data) override;
+	void send(const ServerHandle& serverHandle, const RemoteConnectionHandle& remoteConnectionHandle, const std::vector<uint8>& data) override;
+	void send(const ClientHandle& clientHandle, const std::vector<uint8>& data) override;
+
+	void send(const ServerHandle& serverHandle, MessageBuffer data) override;
+	void send(const ServerHandle& serverHandle, const RemoteConnectionHandle& remoteConnectionHandle, MessageBuffer data) override;
+	void send(const ClientHandle& clientHandle, MessageBuffer data) override;
+
+	void send(const ServerHandle& serverHandle, MessageBuffer data, const Channel channel) override;
+	void send(const ServerHandle& serverHandle, const RemoteConnectionHandle& remoteConnectionHandle, MessageBuffer data, const Channel channel) override;
+	void send(const ClientHandle& clientHandle, MessageBuffer data, const Channel channel) override;
+
+	void processEvents() override;
+	void addEventListener(networking::IEventListener* eventListener) override;
+	void removeEventListener(networking::IEventListener* eventListener) override;
+
+	// Events from the wrapped engine
+	bool processEvent(const ConnectEvent& event) override;
+	bool processEvent(const DisconnectEvent& event) override;
+	bool processEvent(const MessageEvent& event) override;
+
+private:
+	std::unique_ptr<INetworkingEngine> networkingEngine_;
+	std::vector<networking::IEventListener*> eventListeners_;
+};
+
+}
+}
+
+#endif /* COUNTINGNETWORKINGENGINE_H_ */
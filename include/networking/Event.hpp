@@ -5,6 +5,8 @@
 
 #include "Types.hpp"
 
+#include "MessageBuffer.hpp"
+
 #include "ClientHandle.hpp"
 #include "ServerHandle.hpp"
 #include "RemoteConnectionHandle.hpp"
@@ -48,7 +50,7 @@ struct DisconnectEvent : public GenericEvent
 
 struct MessageEvent : public GenericEvent
 {
-	std::vector<uint8> message;
+	MessageBuffer message;
 };
 
 }
@@ -2,10 +2,13 @@
 #define INETWORKINGENGINE_H_
 
 #include <vector>
+#include <utility>
 
 #include "IEventListener.hpp"
 
 #include "Event.hpp"
+#include "MessageBuffer.hpp"
+#include "Channel.hpp"
 
 #include "ServerHandle.hpp"
 #include "ClientHandle.hpp"
@@ -36,6 +39,46 @@ public:
 	virtual void send(const ServerHandle& serverHandle, const RemoteConnectionHandle& remoteConnectionHandle, const std::vector<uint8>& data) = 0;
 	
 	virtual void send(const ClientHandle& clientHandle, const std::vector<uint8>& data) = 0;
+
+	/**
+	 * Sends that take ownership of a pooled buffer, so engines can queue it (or hand it straight to a local
+	 * connection) without copying the bytes.
+	 *
+	 * The default implementations copy into the vector versions - engines should override them.
+	 */
+	virtual void send(const ServerHandle& serverHandle, MessageBuffer data)
+	{
+		send(serverHandle, data.toVector());
+	}
+
+	virtual void send(const ServerHandle& serverHandle, const RemoteConnectionHandle& remoteConnectionHandle, MessageBuffer data)
+	{
+		send(serverHandle, remoteConnectionHandle, data.toVector());
+	}
+
+	virtual void send(const ClientHandle& clientHandle, MessageBuffer data)
+	{
+		send(clientHandle, data.toVector());
+	}
+
+	/**
+	 * Sends on a channel - engines without unreliable delivery may send everything reliably, which the default
+	 * implementations do.
+	 */
+	virtual void send(const ServerHandle& serverHandle, MessageBuffer data, const Channel channel)
+	{
+		send(serverHandle, std::move(data));
+	}
+
+	virtual void send(const ServerHandle& serverHandle, const RemoteConnectionHandle& remoteConnectionHandle, MessageBuffer data, const Channel channel)
+	{
+		send(serverHandle, remoteConnectionHandle, std::move(data));
+	}
+
+	virtual void send(const ClientHandle& clientHandle, MessageBuffer data, const Channel channel)
+	{
+		send(clientHandle, std::move(data));
+	}
 	
 	virtual void processEvents() = 0;
 	virtual void addEventListener(IEventListener* eventListener) = 0;
@@ -0,0 +1,356 @@
+#ifndef MESSAGEBUFFER_H_
+#define MESSAGEBUFFER_H_
+
+#include <vector>
+#include <array>
+#include <memory>
+#include <new>
+#include <mutex>
+#include <atomic>
+#include <cstring>
+#include <algorithm>
+
+#include "Types.hpp"
+
+#include "exceptions/RuntimeException.hpp"
+
+#include "detail/Format.hpp"
+
+namespace ice_engine
+{
+namespace detail
+{
+
+class MessageBufferAllocator;
+
+/**
+ * Header in front of the bytes of every buffer.
+ */
+struct MessageBufferBlock
+{
+	std::atomic<uint32> references;
+	uint32 sizeClass;
+	size_t size;
+	size_t capacity;
+	MessageBufferAllocator* allocator;
+	MessageBufferBlock* next;
+
+	uint8* data()
+	{
+		return reinterpret_cast<uint8*>(this + 1);
+	}
+};
+
+/**
+ * Slabs of fixed size blocks, one free list per size class.  Messages larger than the largest size class get a heap
+ * allocation of their own.
+ *
+ * The pool and every live block hold a reference, so the memory stays valid until both the pool and the last buffer
+ * are gone - whichever goes first.
+ */
+class MessageBufferAllocator
+{
+public:
+	static constexpr uint32 NUMBER_OF_SIZE_CLASSES = 6;
+	static constexpr uint32 LARGE = NUMBER_OF_SIZE_CLASSES;
+
+	static constexpr size_t sizeOfClass(const uint32 sizeClass)
+	{
+		return size_t(64) << (sizeClass * 2);
+	}
+
+	MessageBufferBlock* allocate(const size_t size)
+	{
+		uint32 sizeClass = 0;
+		while (sizeClass < NUMBER_OF_SIZE_CLASSES && sizeOfClass(sizeClass) < size) ++sizeClass;
+
+		MessageBufferBlock* block = nullptr;
+
+		if (sizeClass == LARGE)
+		{
+			block = reinterpret_cast<MessageBufferBlock*>(new uint8[sizeof(MessageBufferBlock) + size]);
+			block->capacity = size;
+		}
+		else
+		{
+			auto& freeList = freeLists_[sizeClass];
+
+			std::lock_guard<std::mutex> lock(freeList.mutex);
+
+			if (freeList.head == nullptr) allocateSlab(sizeClass);
+
+			block = freeList.head;
+			freeList.head = block->next;
+		}
+
+		new(&block->references) std::atomic<uint32>(1);
+		block->sizeClass = sizeClass;
+		block->size = size;
+		block->allocator = this;
+		block->next = nullptr;
+
+		retain();
+
+		return block;
+	}
+
+	void free(MessageBufferBlock* block)
+	{
+		if (block->sizeClass == LARGE)
+		{
+			delete[] reinterpret_cast<uint8*>(block);
+		}
+		else
+		{
+			auto& freeList = freeLists_[block->sizeClass];
+
+			std::lock_guard<std::mutex> lock(freeList.mutex);
+
+			block->next = freeList.head;
+			freeList.head = block;
+		}
+
+		release();
+	}
+
+	void retain()
+	{
+		references_.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void release()
+	{
+		if (references_.fetch_sub(1, std::memory_order_acq_rel) == 1) delete this;
+	}
+
+private:
+	// Slabs are at least this big, so small size classes don't allocate often
+	static constexpr size_t SLAB_SIZE = 64 * 1024;
+
+	struct FreeList
+	{
+		std::mutex mutex;
+		MessageBufferBlock* head = nullptr;
+		std::vector<std::unique_ptr<uint8[]>> slabs;
+	};
+
+	std::atomic<uint32> references_{1};
+	std::array<FreeList, NUMBER_OF_SIZE_CLASSES> freeLists_;
+
+	void allocateSlab(const uint32 sizeClass)
+	{
+		const size_t blockSize = sizeof(MessageBufferBlock) + sizeOfClass(sizeClass);
+		const size_t numberOfBlocks = std::max<size_t>(4, SLAB_SIZE / blockSize);
+
+		auto& freeList = freeLists_[sizeClass];
+
+		freeList.slabs.push_back(std::unique_ptr<uint8[]>(new uint8[blockSize * numberOfBlocks]));
+		uint8* slab = freeList.slabs.back().get();
+
+		for (size_t i = 0; i < numberOfBlocks; ++i)
+		{
+			auto block = reinterpret_cast<MessageBufferBlock*>(slab + i * blockSize);
+			block->capacity = sizeOfClass(sizeClass);
+			block->next = freeList.head;
+			freeList.head = block;
+		}
+	}
+};
+
+}
+
+namespace networking
+{
+
+/**
+ * Reference counted message bytes allocated from a MessageBufferPool.
+ *
+ * Copies share the same bytes rather than copying them, so a received message can be handed to any number of
+ * listeners - or a sent one queued - for the price of a reference count.  The block goes back to its pool when the
+ * last copy is destroyed, from whichever thread that happens on.
+ */
+class MessageBuffer
+{
+public:
+	MessageBuffer() = default;
+
+	MessageBuffer(const MessageBuffer& other) : block_(other.block_)
+	{
+		if (block_ != nullptr) block_->references.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	MessageBuffer(MessageBuffer&& other) noexcept : block_(other.block_)
+	{
+		other.block_ = nullptr;
+	}
+
+	~MessageBuffer()
+	{
+		reset();
+	}
+
+	MessageBuffer& operator=(const MessageBuffer& other)
+	{
+		MessageBuffer copy(other);
+		std::swap(block_, copy.block_);
+
+		return *this;
+	}
+
+	MessageBuffer& operator=(MessageBuffer&& other) noexcept
+	{
+		std::swap(block_, other.block_);
+
+		return *this;
+	}
+
+	uint8* data()
+	{
+		return block_ != nullptr ? block_->data() : nullptr;
+	}
+
+	const uint8* data() const
+	{
+		return block_ != nullptr ? block_->data() : nullptr;
+	}
+
+	size_t size() const
+	{
+		return block_ != nullptr ? block_->size : 0;
+	}
+
+	size_t capacity() const
+	{
+		return block_ != nullptr ? block_->capacity : 0;
+	}
+
+	bool empty() const
+	{
+		return size() == 0;
+	}
+
+	/**
+	 * Changes the size within the capacity the buffer was allocated with - a buffer never reallocates.
+	 */
+	void resize(const size_t size)
+	{
+		if (size > capacity())
+		{
+			throw RuntimeException(detail::format("Cannot resize message buffer to %s bytes - its capacity is %s bytes.", size, capacity()));
+		}
+
+		if (block_ != nullptr) block_->size = size;
+	}
+
+	uint8* begin()
+	{
+		return data();
+	}
+
+	uint8* end()
+	{
+		return data() + size();
+	}
+
+	const uint8* begin() const
+	{
+		return data();
+	}
+
+	const uint8* end() const
+	{
+		return data() + size();
+	}
+
+	uint8& operator[](const size_t index)
+	{
+		return block_->data()[index];
+	}
+
+	const uint8& operator[](const size_t index) const
+	{
+		return block_->data()[index];
+	}
+
+	/**
+	 * Number of buffers sharing these bytes.
+	 */
+	uint32 useCount() const
+	{
+		return block_ != nullptr ? block_->references.load(std::memory_order_relaxed) : 0;
+	}
+
+	std::vector<uint8> toVector() const
+	{
+		return std::vector<uint8>(begin(), end());
+	}
+
+	void reset()
+	{
+		if (block_ != nullptr && block_->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			block_->allocator->free(block_);
+		}
+
+		block_ = nullptr;
+	}
+
+private:
+	friend class MessageBufferPool;
+
+	explicit MessageBuffer(detail::MessageBufferBlock* block) : block_(block)
+	{
+	}
+
+	detail::MessageBufferBlock* block_ = nullptr;
+};
+
+/**
+ * Thread safe source of MessageBuffers, slab allocated in fixed size classes (64 bytes to 64 KiB, in steps of four).
+ *
+ * Buffers may outlive the pool they came from.
+ */
+class MessageBufferPool
+{
+public:
+	MessageBufferPool() : allocator_(new detail::MessageBufferAllocator())
+	{
+	}
+
+	~MessageBufferPool()
+	{
+		allocator_->release();
+	}
+
+	MessageBufferPool(const MessageBufferPool& other) = delete;
+	MessageBufferPool& operator=(const MessageBufferPool& other) = delete;
+
+	/**
+	 * Uninitialized buffer of the given size.
+	 */
+	MessageBuffer allocate(const size_t size)
+	{
+		return MessageBuffer(allocator_->allocate(size));
+	}
+
+	MessageBuffer allocate(const uint8* data, const size_t size)
+	{
+		MessageBuffer messageBuffer = allocate(size);
+		if (size > 0) std::memcpy(messageBuffer.data(), data, size);
+
+		return messageBuffer;
+	}
+
+	MessageBuffer allocate(const std::vector<uint8>& data)
+	{
+		return allocate(data.data(), data.size());
+	}
+
+private:
+	detail::MessageBufferAllocator* allocator_;
+};
+
+}
+}
+
+#endif /* MESSAGEBUFFER_H_ */
@@ -0,0 +1,53 @@
+#ifndef NULLNETWORKINGENGINE_H_
+#define NULLNETWORKINGENGINE_H_
+
+#include <atomic>
+
+#include "networking/INetworkingEngine.hpp"
+
+namespace ice_engine
+{
+namespace networking
+{
+
+/**
+ * A networking engine that never connects, for headless runs - everything sent is dropped and nothing arrives.
+ */
+class NullNetworkingEngine : public INetworkingEngine
+{
+public:
+	NullNetworkingEngine() = default;
+	virtual ~NullNetworkingEngine() override = default;
+
+	virtual ServerHandle createServer() override;
+	virtual ClientHandle createClient() override;
+
+	virtual void destroyServer(const ServerHandle& serverHandle) override;
+	virtual void destroyClient(const ClientHandle& clientHandle) override;
+
+	virtual void tick(const float32 delta) override;
+
+	virtual void send(const ServerHandle& serverHandle, const std::vector<uint8>& data) override;
+	virtual void send(const ServerHandle& serverHandle, const RemoteConnectionHandle& remoteConnectionHandle, const std::vector<uint8>& data) override;
+
+	virtual void send(const ClientHandle& clientHandle, const std::vector<uint8>& data) override;
+
+	// Dropped as they are, rather than copied into a vector first
+	virtual void send(const ServerHandle& serverHandle, MessageBuffer data) override;
+	virtual void send(const ServerHandle& serverHandle, const RemoteConnectionHandle& remoteConnectionHandle, MessageBuffer data) override;
+	virtual void send(const ClientHandle& clientHandle, MessageBuffer data) override;
+
+	virtual void processEvents() override;
+	virtual void addEventListener(IEventListener* eventListener) override;
+	virtual void removeEventListener(IEventListener* eventListener) override;
+
+private:
+	std::atomic<uint32> nextIndex_{1};
+
+	uint32 nextIndex();
+};
+
+}
+}
+
+#endif /* NULLNETWORKINGENGINE_H_ */
@@ -1,17 +1,27 @@
 #ifndef NOISE_H_
 #define NOISE_H_
 
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+
 #include "FastNoise.h"
 #include "Types.hpp"
 
 namespace ice_engine
 {
+
+class IThreadPool;
+
 namespace noise
 {
 
 class Noise
 {
 public:
+	typedef FastNoise::NoiseType NoiseType;
+	typedef FastNoise::Interp Interpolation;
+	typedef FastNoise::FractalType FractalType;
+
 	Noise() = default;
 
 	Noise(const uint32 seed) : noise_(seed)
@@ -27,18 +37,108 @@ public:
 	{
 		return noise_.GetSeed();
 	}
-	
+
+	void setNoiseType(const NoiseType noiseType)
+	{
+		noise_.SetNoiseType(noiseType);
+	}
+
+	NoiseType getNoiseType() const
+	{
+		return noise_.GetNoiseType();
+	}
+
+	void setFrequency(const float32 frequency)
+	{
+		noise_.SetFrequency(frequency);
+	}
+
+	float32 getFrequency() const
+	{
+		return noise_.GetFrequency();
+	}
+
+	void setInterpolation(const Interpolation interpolation)
+	{
+		noise_.SetInterp(interpolation);
+	}
+
+	Interpolation getInterpolation() const
+	{
+		return noise_.GetInterp();
+	}
+
+	void setFractalType(const FractalType fractalType)
+	{
+		noise_.SetFractalType(fractalType);
+	}
+
+	FractalType getFractalType() const
+	{
+		return noise_.GetFractalType();
+	}
+
+	void setFractalOctaves(const int32 octaves)
+	{
+		noise_.SetFractalOctaves(octaves);
+	}
+
+	int32 getFractalOctaves() const
+	{
+		return noise_.GetFractalOctaves();
+	}
+
+	void setFractalLacunarity(const float32 lacunarity)
+	{
+		noise_.SetFractalLacunarity(lacunarity);
+	}
+
+	float32 getFractalLacunarity() const
+	{
+		return noise_.GetFractalLacunarity();
+	}
+
+	void setFractalGain(const float32 gain)
+	{
+		noise_.SetFractalGain(gain);
+	}
+
+	float32 getFractalGain() const
+	{
+		return noise_.GetFractalGain();
+	}
+
 	float32 getValue(const float32 x, const float32 y) const
 	{
 		return noise_.GetValue(x, y);
 	}
 
+	/**
+	 * Returns the noise of the configured noise type at (x, y).
+	 */
+	float32 getNoise(const float32 x, const float32 y) const
+	{
+		return noise_.GetNoise(x, y);
+	}
+
+	/**
+	 * Fills out (width * height floats, row major) with getNoise(origin.x + i * step.x, origin.y + j * step.y).
+	 *
+	 * Value, perlin and simplex noise (single and fractal) are evaluated with SSE4.1 or AVX2, whichever the cpu supports,
+	 * and the results are bit for bit the same as getNoise's.  Other noise types fall back to calling getNoise per sample.
+	 *
+	 * If a thread pool is given, the rows are split between its workers and this blocks until they are done - don't pass
+	 * the pool this is being called from.
+	 */
+	void fillGrid(float32* out, const glm::vec2& origin, const glm::vec2& step, const uint32 width, const uint32 height, IThreadPool* threadPool = nullptr) const;
+
 private:
 	FastNoise noise_;
+
+	void fillRows(float32* out, const glm::vec2& origin, const glm::vec2& step, const uint32 width, const uint32 rowBegin, const uint32 rowEnd) const;
 };
 
 }
 }
 
 #endif /* NOISE_H_ */
-
@@ -0,0 +1,68 @@
+#ifndef NOISEKERNEL_H_
+#define NOISEKERNEL_H_
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+namespace noise
+{
+namespace detail
+{
+
+/**
+ * Everything a vectorized kernel needs to evaluate a FastNoise instance's 2D noise over a grid.
+ *
+ * Sample (column, row) is at (originX + column * stepX, originY + row * stepY), in the same units as Noise::getNoise.
+ */
+struct GridParameters
+{
+	// FastNoise's permutation tables, widened to 32 bits for gathers
+	int32 perm[512];
+	int32 perm12[512];
+
+	const float32* valueLookupTable = nullptr;
+	const float32* gradientTableX = nullptr;
+	const float32* gradientTableY = nullptr;
+
+	// FastNoise::NoiseType, FastNoise::FractalType and FastNoise::Interp
+	int32 noiseType = 0;
+	int32 fractalType = 0;
+	int32 interpolation = 0;
+
+	int32 octaves = 1;
+	float32 frequency = 0.0f;
+	float32 lacunarity = 0.0f;
+	float32 gain = 0.0f;
+	float32 fractalBounding = 0.0f;
+
+	float32 originX = 0.0f;
+	float32 originY = 0.0f;
+	float32 stepX = 0.0f;
+	float32 stepY = 0.0f;
+	uint32 width = 0;
+};
+
+/**
+ * Fill rows [rowBegin, rowEnd) of the grid - out points at the first sample of the grid.
+ *
+ * Returns false (and writes nothing) if the kernel doesn't support the noise type.  Only call these if the cpu
+ * supports the instruction set.
+ */
+typedef bool (*FillGridFunction)(const GridParameters& parameters, float32* out, const uint32 rowBegin, const uint32 rowEnd);
+
+bool fillGridSse41(const GridParameters& parameters, float32* out, const uint32 rowBegin, const uint32 rowEnd);
+bool fillGridAvx2(const GridParameters& parameters, float32* out, const uint32 rowBegin, const uint32 rowEnd);
+
+// Whether the kernels were compiled in (they aren't on non x86 targets, or without the per file compiler flags)
+extern const bool SSE41_KERNEL_AVAILABLE;
+extern const bool AVX2_KERNEL_AVAILABLE;
+
+bool cpuSupportsSse41();
+bool cpuSupportsAvx2();
+
+}
+}
+}
+
+#endif /* NOISEKERNEL_H_ */
@@ -0,0 +1,324 @@
+/**
+ * Vectorized 2D value, perlin and simplex noise (single and fractal), operation for operation the same as FastNoise's
+ * scalar code, so the results are bit for bit identical (as long as neither side is compiled with fused multiply adds
+ * or x87 math).
+ *
+ * L is the lane type, providing the vector operations - see the instruction set specific translation units that
+ * include this file.  Those translation units are compiled with their instruction set enabled, so nothing in here may
+ * use inline functions from other headers (e.g. the standard library) - the linker could pick the copy compiled for an
+ * instruction set the cpu doesn't have.
+ */
+
+namespace ice_engine
+{
+namespace noise
+{
+namespace detail
+{
+namespace
+{
+
+// Same values as FastNoise::NoiseType, FastNoise::FractalType and FastNoise::Interp
+enum KernelNoiseType
+{
+	KERNEL_VALUE = 0,
+	KERNEL_VALUE_FRACTAL = 1,
+	KERNEL_PERLIN = 2,
+	KERNEL_PERLIN_FRACTAL = 3,
+	KERNEL_SIMPLEX = 4,
+	KERNEL_SIMPLEX_FRACTAL = 5
+};
+
+enum KernelFractalType
+{
+	KERNEL_FBM = 0,
+	KERNEL_BILLOW = 1,
+	KERNEL_RIGID_MULTI = 2
+};
+
+enum KernelInterpolation
+{
+	KERNEL_LINEAR = 0,
+	KERNEL_HERMITE = 1,
+	KERNEL_QUINTIC = 2
+};
+
+template <typename L>
+struct NoiseKernel
+{
+	typedef typename L::F F;
+	typedef typename L::I I;
+
+	// Same as FastNoise's simplex constants
+	static float32 sqrt3() { return float32(1.7320508075688772935274463415059); }
+	static float32 f2() { return float32(0.5) * (sqrt3() - float32(1.0)); }
+	static float32 g2() { return (float32(3.0) - sqrt3()) / float32(6.0); }
+
+	static F lerp(const F a, const F b, const F t)
+	{
+		return L::add(a, L::mul(t, L::sub(b, a)));
+	}
+
+	// (int)f, minus one if f is negative - like FastNoise, negative integers are floored to one less than themselves
+	static I fastFloor(const F f)
+	{
+		return L::addi(L::truncate(f), L::maskToInt(L::lt(f, L::set(0.0f))));
+	}
+
+	static F interpolate(const GridParameters& parameters, const F t)
+	{
+		switch (parameters.interpolation)
+		{
+			case KERNEL_HERMITE:
+				return L::mul(L::mul(t, t), L::sub(L::set(3.0f), L::mul(L::set(2.0f), t)));
+
+			case KERNEL_QUINTIC:
+				return L::mul(L::mul(L::mul(t, t), t), L::add(L::mul(t, L::sub(L::mul(t, L::set(6.0f)), L::set(15.0f))), L::set(10.0f)));
+
+			case KERNEL_LINEAR:
+			default:
+				return t;
+		}
+	}
+
+	static I index2d(const GridParameters& parameters, const I offset, const I x, const I y)
+	{
+		const I mask = L::seti(0xff);
+
+		return L::addi(L::andi(x, mask), L::gather(parameters.perm, L::addi(L::andi(y, mask), offset)));
+	}
+
+	static F valueCoordinate(const GridParameters& parameters, const I offset, const I x, const I y)
+	{
+		return L::gatherf(parameters.valueLookupTable, L::gather(parameters.perm, index2d(parameters, offset, x, y)));
+	}
+
+	static F gradientCoordinate(const GridParameters& parameters, const I offset, const I x, const I y, const F xd, const F yd)
+	{
+		const I lutPosition = L::gather(parameters.perm12, index2d(parameters, offset, x, y));
+
+		return L::add(L::mul(xd, L::gatherf(parameters.gradientTableX, lutPosition)), L::mul(yd, L::gatherf(parameters.gradientTableY, lutPosition)));
+	}
+
+	static F singleValue(const GridParameters& parameters, const I offset, const F x, const F y)
+	{
+		const I x0 = fastFloor(x);
+		const I y0 = fastFloor(y);
+		const I x1 = L::addi(x0, L::seti(1));
+		const I y1 = L::addi(y0, L::seti(1));
+
+		const F xs = interpolate(parameters, L::sub(x, L::toFloat(x0)));
+		const F ys = interpolate(parameters, L::sub(y, L::toFloat(y0)));
+
+		const F xf0 = lerp(valueCoordinate(parameters, offset, x0, y0), valueCoordinate(parameters, offset, x1, y0), xs);
+		const F xf1 = lerp(valueCoordinate(parameters, offset, x0, y1), valueCoordinate(parameters, offset, x1, y1), xs);
+
+		return lerp(xf0, xf1, ys);
+	}
+
+	static F singlePerlin(const GridParameters& parameters, const I offset, const F x, const F y)
+	{
+		const I x0 = fastFloor(x);
+		const I y0 = fastFloor(y);
+		const I x1 = L::addi(x0, L::seti(1));
+		const I y1 = L::addi(y0, L::seti(1));
+
+		const F xd0 = L::sub(x, L::toFloat(x0));
+		const F yd0 = L::sub(y, L::toFloat(y0));
+		const F xd1 = L::sub(xd0, L::set(1.0f));
+		const F yd1 = L::sub(yd0, L::set(1.0f));
+
+		const F xs = interpolate(parameters, xd0);
+		const F ys = interpolate(parameters, yd0);
+
+		const F xf0 = lerp(gradientCoordinate(parameters, offset, x0, y0, xd0, yd0), gradientCoordinate(parameters, offset, x1, y0, xd1, yd0), xs);
+		const F xf1 = lerp(gradientCoordinate(parameters, offset, x0, y1, xd0, yd1), gradientCoordinate(parameters, offset, x1, y1, xd1, yd1), xs);
+
+		return lerp(xf0, xf1, ys);
+	}
+
+	static F simplexCorner(const GridParameters& parameters, const I offset, const I i, const I j, const F x, const F y)
+	{
+		F t = L::sub(L::sub(L::set(0.5f), L::mul(x, x)), L::mul(y, y));
+		const F outside = L::lt(t, L::set(0.0f));
+
+		t = L::mul(t, t);
+		const F n = L::mul(L::mul(t, t), gradientCoordinate(parameters, offset, i, j, x, y));
+
+		return L::select(outside, L::set(0.0f), n);
+	}
+
+	static F singleSimplex(const GridParameters& parameters, const I offset, const F x, const F y)
+	{
+		const float32 G2 = g2();
+
+		F t = L::mul(L::add(x, y), L::set(f2()));
+		const I i = fastFloor(L::add(x, t));
+		const I j = fastFloor(L::add(y, t));
+
+		t = L::mul(L::toFloat(L::addi(i, j)), L::set(G2));
+		const F X0 = L::sub(L::toFloat(i), t);
+		const F Y0 = L::sub(L::toFloat(j), t);
+
+		const F x0 = L::sub(x, X0);
+		const F y0 = L::sub(y, Y0);
+
+		const I i1 = L::andi(L::maskToInt(L::gt(x0, y0)), L::seti(1));
+		const I j1 = L::subi(L::seti(1), i1);
+
+		const F x1 = L::add(L::sub(x0, L::toFloat(i1)), L::set(G2));
+		const F y1 = L::add(L::sub(y0, L::toFloat(j1)), L::set(G2));
+		const F x2 = L::add(L::sub(x0, L::set(1.0f)), L::set(2 * G2));
+		const F y2 = L::add(L::sub(y0, L::set(1.0f)), L::set(2 * G2));
+
+		const I one = L::seti(1);
+
+		const F n0 = simplexCorner(parameters, offset, i, j, x0, y0);
+		const F n1 = simplexCorner(parameters, offset, L::addi(i, i1), L::addi(j, j1), x1, y1);
+		const F n2 = simplexCorner(parameters, offset, L::addi(i, one), L::addi(j, one), x2, y2);
+
+		return L::mul(L::set(70.0f), L::add(L::add(n0, n1), n2));
+	}
+
+	template <int32 NoiseType>
+	static F single(const GridParameters& parameters, const int32 offset, const F x, const F y)
+	{
+		switch (NoiseType)
+		{
+			case KERNEL_VALUE:
+				return singleValue(parameters, L::seti(offset), x, y);
+
+			case KERNEL_PERLIN:
+				return singlePerlin(parameters, L::seti(offset), x, y);
+
+			case KERNEL_SIMPLEX:
+			default:
+				return singleSimplex(parameters, L::seti(offset), x, y);
+		}
+	}
+
+	template <int32 NoiseType>
+	static F fractal(const GridParameters& parameters, F x, F y)
+	{
+		const F lacunarity = L::set(parameters.lacunarity);
+		const F one = L::set(1.0f);
+		const F two = L::set(2.0f);
+
+		F sum;
+		float32 amp = 1.0f;
+
+		switch (parameters.fractalType)
+		{
+			case KERNEL_BILLOW:
+				sum = L::sub(L::mul(L::abs(single<NoiseType>(parameters, parameters.perm[0], x, y)), two), one);
+
+				for (int32 i = 1; i < parameters.octaves; ++i)
+				{
+					x = L::mul(x, lacunarity);
+					y = L::mul(y, lacunarity);
+
+					amp *= parameters.gain;
+					sum = L::add(sum, L::mul(L::sub(L::mul(L::abs(single<NoiseType>(parameters, parameters.perm[i], x, y)), two), one), L::set(amp)));
+				}
+
+				return L::mul(sum, L::set(parameters.fractalBounding));
+
+			case KERNEL_RIGID_MULTI:
+				sum = L::sub(one, L::abs(single<NoiseType>(parameters, parameters.perm[0], x, y)));
+
+				for (int32 i = 1; i < parameters.octaves; ++i)
+				{
+					x = L::mul(x, lacunarity);
+					y = L::mul(y, lacunarity);
+
+					amp *= parameters.gain;
+					sum = L::sub(sum, L::mul(L::sub(one, L::abs(single<NoiseType>(parameters, parameters.perm[i], x, y))), L::set(amp)));
+				}
+
+				return sum;
+
+			case KERNEL_FBM:
+			default:
+				sum = single<NoiseType>(parameters, parameters.perm[0], x, y);
+
+				for (int32 i = 1; i < parameters.octaves; ++i)
+				{
+					x = L::mul(x, lacunarity);
+					y = L::mul(y, lacunarity);
+
+					amp *= parameters.gain;
+					sum = L::add(sum, L::mul(single<NoiseType>(parameters, parameters.perm[i], x, y), L::set(amp)));
+				}
+
+				return L::mul(sum, L::set(parameters.fractalBounding));
+		}
+	}
+
+	static F evaluate(const GridParameters& parameters, const F x, const F y)
+	{
+		switch (parameters.noiseType)
+		{
+			case KERNEL_VALUE:
+				return single<KERNEL_VALUE>(parameters, 0, x, y);
+			case KERNEL_VALUE_FRACTAL:
+				return fractal<KERNEL_VALUE>(parameters, x, y);
+			case KERNEL_PERLIN:
+				return single<KERNEL_PERLIN>(parameters, 0, x, y);
+			case KERNEL_PERLIN_FRACTAL:
+				return fractal<KERNEL_PERLIN>(parameters, x, y);
+			case KERNEL_SIMPLEX:
+				return single<KERNEL_SIMPLEX>(parameters, 0, x, y);
+			case KERNEL_SIMPLEX_FRACTAL:
+			default:
+				return fractal<KERNEL_SIMPLEX>(parameters, x, y);
+		}
+	}
+
+	static bool fillGrid(const GridParameters& parameters, float32* out, const uint32 rowBegin, const uint32 rowEnd)
+	{
+		if (parameters.noiseType < KERNEL_VALUE || parameters.noiseType > KERNEL_SIMPLEX_FRACTAL) return false;
+
+		const F frequency = L::set(parameters.frequency);
+		const F originX = L::set(parameters.originX);
+		const F stepX = L::set(parameters.stepX);
+		const I lanes = L::lanes();
+
+		for (uint32 row = rowBegin; row < rowEnd; ++row)
+		{
+			// Same as Noise::getNoise(originX + column * stepX, originY + row * stepY)
+			const F y = L::mul(L::set(parameters.originY + static_cast<float32>(row) * parameters.stepY), frequency);
+
+			float32* rowOut = out + static_cast<uint64>(row) * parameters.width;
+
+			for (uint32 column = 0; column < parameters.width; column += L::N)
+			{
+				const F columns = L::toFloat(L::addi(L::seti(static_cast<int32>(column)), lanes));
+				const F x = L::mul(L::add(originX, L::mul(columns, stepX)), frequency);
+
+				const F value = evaluate(parameters, x, y);
+
+				if (column + L::N <= parameters.width)
+				{
+					L::store(rowOut + column, value);
+				}
+				else
+				{
+					float32 values[L::N];
+					L::store(values, value);
+
+					for (uint32 i = 0; column + i < parameters.width; ++i)
+					{
+						rowOut[column + i] = values[i];
+					}
+				}
+			}
+		}
+
+		return true;
+	}
+};
+
+}
+}
+}
+}
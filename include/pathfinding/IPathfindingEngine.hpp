@@ -4,15 +4,15 @@
 #include <vector>
 #include <memory>
 
-#include <boost/any.hpp>
-
 #define GLM_FORCE_RADIANS
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 
 #include "Types.hpp"
 
-#include "pathfinding/UserData.hpp"
+#include "exceptions/RuntimeException.hpp"
+
+#include "pathfinding/UserTag.hpp"
 
 #include "pathfinding/PathfindingSceneHandle.hpp"
 #include "pathfinding/PolygonMeshHandle.hpp"
@@ -26,6 +26,7 @@
 #include "pathfinding/AgentParams.hpp"
 #include "pathfinding/AgentState.hpp"
 #include "pathfinding/MovementRequestState.hpp"
+#include "pathfinding/Obstacle.hpp"
 
 #include "pathfinding/IAgentMotionChangeListener.hpp"
 #include "pathfinding/IAgentStateChangeListener.hpp"
@@ -62,6 +63,49 @@ public:
 
 	virtual NavigationMeshHandle createNavigationMesh(const PolygonMeshHandle& polygonMeshHandle, const NavigationMeshConfig& navigationMeshConfig = NavigationMeshConfig()) = 0;
 	virtual void destroy(const NavigationMeshHandle& navigationMeshHandle) = 0;
+
+	/**
+	 * Tiled navigation meshes, built and rebuilt a tile at a time.
+	 *
+	 * Tiles are squares of polygonMeshConfig.tileSize cells on the xz plane, with tile (0, 0) starting at origin.
+	 * buildNavigationMeshTile() rasterizes the geometry and obstacles of one tile (including everything within
+	 * polygonMeshConfig.borderSize cells of it, so neighbouring tiles line up) into tile data without changing any
+	 * engine state, so several tiles can be built at once on worker threads.  addNavigationMeshTile() then links the
+	 * data into the navigation mesh, replacing any tile at the same coordinates - like every other call, it has to be
+	 * made from the engine thread.  Empty tile data means the tile has nothing walkable.
+	 *
+	 * Tiled navigation meshes are destroyed with destroy(NavigationMeshHandle).  The default implementations throw -
+	 * engines that support tiled navigation meshes override all of them.
+	 */
+	virtual NavigationMeshHandle createTiledNavigationMesh(
+		const glm::vec3& origin,
+		const PolygonMeshConfig& polygonMeshConfig,
+		const NavigationMeshConfig& navigationMeshConfig = NavigationMeshConfig()
+	)
+	{
+		throw RuntimeException("This pathfinding engine does not support tiled navigation meshes.");
+	}
+
+	virtual std::vector<byte> buildNavigationMeshTile(
+		const NavigationMeshHandle& navigationMeshHandle,
+		const int32 x,
+		const int32 z,
+		const ITerrain* geometry,
+		const std::vector<Obstacle>& obstacles
+	) const
+	{
+		throw RuntimeException("This pathfinding engine does not support tiled navigation meshes.");
+	}
+
+	virtual void addNavigationMeshTile(const NavigationMeshHandle& navigationMeshHandle, const int32 x, const int32 z, std::vector<byte> data)
+	{
+		throw RuntimeException("This pathfinding engine does not support tiled navigation meshes.");
+	}
+
+	virtual void removeNavigationMeshTile(const NavigationMeshHandle& navigationMeshHandle, const int32 x, const int32 z)
+	{
+		throw RuntimeException("This pathfinding engine does not support tiled navigation meshes.");
+	}
 	
 	virtual CrowdHandle createCrowd(const PathfindingSceneHandle& pathfindingSceneHandle, const NavigationMeshHandle& navigationMeshHandle, const CrowdConfig& crowdConfig) = 0;
 	virtual void destroy(const PathfindingSceneHandle& pathfindingSceneHandle, const CrowdHandle& crowdHandle) = 0;
@@ -74,7 +118,7 @@ public:
             std::unique_ptr<IAgentMotionChangeListener> agentMotionChangeListener = nullptr,
             std::unique_ptr<IAgentStateChangeListener> agentStateChangeListener = nullptr,
             std::unique_ptr<IMovementRequestStateChangeListener> movementRequestStateChangeListener = nullptr,
-            const boost::any& userData = UserData()
+            const UserTag& userTag = UserTag()
 	) = 0;
 	virtual void destroy(const PathfindingSceneHandle& pathfindingSceneHandle, const CrowdHandle& crowdHandle, const AgentHandle& agentHandle) = 0;
 	
@@ -128,13 +172,13 @@ public:
 		std::unique_ptr<IMovementRequestStateChangeListener> movementRequestStateChangeListener
 	) = 0;
 	
-	virtual void setUserData(
+	virtual void setUserTag(
         const PathfindingSceneHandle& pathfindingSceneHandle,
         const CrowdHandle& crowdHandle,
         const AgentHandle& agentHandle,
-        const boost::any& userData
+        const UserTag& userTag
 	) = 0;
-	virtual boost::any& getUserData(
+	virtual UserTag getUserTag(
 		const PathfindingSceneHandle& pathfindingSceneHandle,
 		const CrowdHandle& crowdHandle,
 		const AgentHandle& agentHandle
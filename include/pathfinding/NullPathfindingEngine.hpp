@@ -0,0 +1,115 @@
+#ifndef NULLPATHFINDINGENGINE_H_
+#define NULLPATHFINDINGENGINE_H_
+
+#include <atomic>
+
+#include "pathfinding/IPathfindingEngine.hpp"
+
+namespace ice_engine
+{
+namespace pathfinding
+{
+
+/**
+ * A pathfinding engine that never moves anything, for headless runs - agents are created and stay where they are.
+ */
+class NullPathfindingEngine : public IPathfindingEngine
+{
+public:
+	NullPathfindingEngine() = default;
+	virtual ~NullPathfindingEngine() override = default;
+
+	virtual void tick(const PathfindingSceneHandle& pathfindingSceneHandle, const float32 delta) override;
+	virtual void renderDebug(const PathfindingSceneHandle& pathfindingSceneHandle) override;
+
+	virtual PathfindingSceneHandle createPathfindingScene() override;
+	virtual void destroyPathfindingScene(const PathfindingSceneHandle& pathfindingSceneHandle) override;
+
+	virtual void setPathfindingDebugRenderer(IPathfindingDebugRenderer* pathfindingDebugRenderer) override;
+	virtual void setDebugRendering(const PathfindingSceneHandle& pathfindingSceneHandle, const bool enabled) override;
+
+	virtual PolygonMeshHandle createPolygonMesh(const ITerrain* terrain, const PolygonMeshConfig& polygonMeshConfig = PolygonMeshConfig()) override;
+	virtual void destroy(const PolygonMeshHandle& polygonMeshHandle) override;
+
+	virtual ObstacleHandle createObstacle(const PolygonMeshHandle& polygonMeshHandle, const glm::vec3& position, const float32 radius, const float32 height) override;
+	virtual void destroy(const PolygonMeshHandle& polygonMeshHandle, const ObstacleHandle& obstacleHandle) override;
+
+	virtual NavigationMeshHandle createNavigationMesh(const PolygonMeshHandle& polygonMeshHandle, const NavigationMeshConfig& navigationMeshConfig = NavigationMeshConfig()) override;
+	virtual void destroy(const NavigationMeshHandle& navigationMeshHandle) override;
+
+	virtual CrowdHandle createCrowd(const PathfindingSceneHandle& pathfindingSceneHandle, const NavigationMeshHandle& navigationMeshHandle, const CrowdConfig& crowdConfig) override;
+	virtual void destroy(const PathfindingSceneHandle& pathfindingSceneHandle, const CrowdHandle& crowdHandle) override;
+
+	virtual AgentHandle createAgent(
+			const PathfindingSceneHandle& pathfindingSceneHandle,
+			const CrowdHandle& crowdHandle,
+			const glm::vec3& position,
+			const AgentParams& agentParams = AgentParams(),
+			std::unique_ptr<IAgentMotionChangeListener> agentMotionChangeListener = nullptr,
+			std::unique_ptr<IAgentStateChangeListener> agentStateChangeListener = nullptr,
+			std::unique_ptr<IMovementRequestStateChangeListener> movementRequestStateChangeListener = nullptr,
+			const UserTag& userTag = UserTag()
+	) override;
+	virtual void destroy(const PathfindingSceneHandle& pathfindingSceneHandle, const CrowdHandle& crowdHandle, const AgentHandle& agentHandle) override;
+
+	virtual void requestMoveTarget(
+		const PathfindingSceneHandle& pathfindingSceneHandle,
+		const CrowdHandle& crowdHandle,
+		const AgentHandle& agentHandle,
+		const glm::vec3& position
+	) override;
+
+	virtual void resetMoveTarget(
+		const PathfindingSceneHandle& pathfindingSceneHandle,
+		const CrowdHandle& crowdHandle,
+		const AgentHandle& agentHandle
+	) override;
+
+	virtual void requestMoveVelocity(
+		const PathfindingSceneHandle& pathfindingSceneHandle,
+		const CrowdHandle& crowdHandle,
+		const AgentHandle& agentHandle,
+		const glm::vec3& velocity
+	) override;
+
+	virtual void setMotionChangeListener(
+		const PathfindingSceneHandle& pathfindingSceneHandle,
+		const CrowdHandle& crowdHandle,
+		const AgentHandle& agentHandle,
+		std::unique_ptr<IAgentMotionChangeListener> agentMotionChangeListener
+	) override;
+	virtual void setStateChangeListener(
+		const PathfindingSceneHandle& pathfindingSceneHandle,
+		const CrowdHandle& crowdHandle,
+		const AgentHandle& agentHandle,
+		std::unique_ptr<IAgentStateChangeListener> agentStateChangeListener
+	) override;
+	virtual void setMovementRequestChangeListener(
+		const PathfindingSceneHandle& pathfindingSceneHandle,
+		const CrowdHandle& crowdHandle,
+		const AgentHandle& agentHandle,
+		std::unique_ptr<IMovementRequestStateChangeListener> movementRequestStateChangeListener
+	) override;
+
+	virtual void setUserTag(
+		const PathfindingSceneHandle& pathfindingSceneHandle,
+		const CrowdHandle& crowdHandle,
+		const AgentHandle& agentHandle,
+		const UserTag& userTag
+	) override;
+	virtual UserTag getUserTag(
+		const PathfindingSceneHandle& pathfindingSceneHandle,
+		const CrowdHandle& crowdHandle,
+		const AgentHandle& agentHandle
+	) const override;
+
+private:
+	std::atomic<uint32> nextIndex_{1};
+
+	uint32 nextIndex();
+};
+
+}
+}
+
+#endif /* NULLPATHFINDINGENGINE_H_ */
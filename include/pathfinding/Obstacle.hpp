@@ -0,0 +1,33 @@
+#ifndef PATHFINDING_OBSTACLE_H_
+#define PATHFINDING_OBSTACLE_H_
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+namespace pathfinding
+{
+
+/**
+ * Upright cylinder standing on position, which is marked as unwalkable when navigation mesh tiles are built.
+ */
+struct Obstacle
+{
+	Obstacle() = default;
+
+	Obstacle(const glm::vec3& position, const float32 radius, const float32 height) : position(position), radius(radius), height(height)
+	{
+	}
+
+	glm::vec3 position;
+	float32 radius = 0.0f;
+	float32 height = 0.0f;
+};
+
+}
+}
+
+#endif /* PATHFINDING_OBSTACLE_H_ */
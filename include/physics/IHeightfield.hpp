@@ -10,15 +10,31 @@ namespace ice_engine
 namespace physics
 {
 
+enum class HeightfieldDataType
+{
+	UNSIGNED_BYTE,
+	UNSIGNED_SHORT,
+	FLOAT
+};
+
 class IHeightfield
 {
 public:
 	virtual ~IHeightfield() = default;
 
+	/**
+	 * The packed height samples, width() x length() of dataType() - unsigned bytes span [0, 255], unsigned shorts
+	 * [0, 65535] and floats [0, 1], scaled to [0, height()].
+	 */
 	virtual const std::vector<byte>& data() const = 0;
 	virtual uint32 width() const = 0;
 	virtual uint32 length() const = 0;
 	virtual uint32 height() const = 0;
+
+	virtual HeightfieldDataType dataType() const
+	{
+		return HeightfieldDataType::UNSIGNED_BYTE;
+	}
 };
 
 }
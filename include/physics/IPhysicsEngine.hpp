@@ -1,9 +1,9 @@
 #ifndef IPHYSICSENGINE_H_
 #define IPHYSICSENGINE_H_
 
+#include <vector>
 #include <memory>
 
-#include <boost/any.hpp>
 #include <boost/variant/variant.hpp>
 
 #define GLM_FORCE_RADIANS
@@ -13,6 +13,8 @@
 
 #include "ray/Ray.hpp"
 
+#include "QueryResults.hpp"
+
 #include "IImage.hpp"
 #include "IHeightfield.hpp"
 
@@ -23,6 +25,8 @@
 #include "physics/IMotionChangeListener.hpp"
 #include "physics/IPhysicsDebugRenderer.hpp"
 #include "physics/Raycast.hpp"
+#include "physics/UserTag.hpp"
+#include "physics/Sphere.hpp"
 
 namespace ice_engine
 {
@@ -56,7 +60,7 @@ public:
 		const PhysicsSceneHandle& physicsSceneHandle, 
 		const CollisionShapeHandle& collisionShapeHandle,
 		std::unique_ptr<IMotionChangeListener> motionStateListener = nullptr,
-		const boost::any& userData = boost::any()
+		const UserTag& userTag = UserTag()
 	) = 0;
 	virtual RigidBodyObjectHandle createRigidBodyObject(
 		const PhysicsSceneHandle& physicsSceneHandle, 
@@ -65,7 +69,7 @@ public:
 		const float32 friction,
 		const float32 restitution,
 		std::unique_ptr<IMotionChangeListener> motionStateListener = nullptr,
-		const boost::any& userData = boost::any()
+		const UserTag& userTag = UserTag()
 	) = 0;
 	virtual RigidBodyObjectHandle createRigidBodyObject(
 		const PhysicsSceneHandle& physicsSceneHandle, 
@@ -76,30 +80,65 @@ public:
 		const float32 friction = 1.0f,
 		const float32 restitution = 1.0f,
 		std::unique_ptr<IMotionChangeListener> motionStateListener = nullptr,
-		const boost::any& userData = boost::any()
+		const UserTag& userTag = UserTag()
 	) = 0;
-	virtual GhostObjectHandle createGhostObject(const PhysicsSceneHandle& physicsSceneHandle, const CollisionShapeHandle& collisionShapeHandle, const boost::any& userData = boost::any()) = 0;
+	virtual GhostObjectHandle createGhostObject(const PhysicsSceneHandle& physicsSceneHandle, const CollisionShapeHandle& collisionShapeHandle, const UserTag& userTag = UserTag()) = 0;
 	virtual GhostObjectHandle createGhostObject(
 		const PhysicsSceneHandle& physicsSceneHandle, 
 		const CollisionShapeHandle& collisionShapeHandle,
 		const glm::vec3& position,
 		const glm::quat& orientation,
-		const boost::any& userData = boost::any()
+		const UserTag& userTag = UserTag()
 	) = 0;
 	virtual void destroy(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle) = 0;
 	virtual void destroy(const PhysicsSceneHandle& physicsSceneHandle, const GhostObjectHandle& ghostObjectHandle) = 0;
 	virtual void destroyAllRigidBodies() = 0;
 	
-	virtual void setUserData(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle, const boost::any& userData) = 0;
-	virtual void setUserData(const PhysicsSceneHandle& physicsSceneHandle, const GhostObjectHandle& ghostObjectHandle, const boost::any& userData) = 0;
-	virtual boost::any& getUserData(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle) const = 0;
-	virtual boost::any& getUserData(const PhysicsSceneHandle& physicsSceneHandle, const GhostObjectHandle& ghostObjectHandle) const = 0;
+	virtual void setUserTag(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle, const UserTag& userTag) = 0;
+	virtual void setUserTag(const PhysicsSceneHandle& physicsSceneHandle, const GhostObjectHandle& ghostObjectHandle, const UserTag& userTag) = 0;
+	virtual UserTag getUserTag(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle) const = 0;
+	virtual UserTag getUserTag(const PhysicsSceneHandle& physicsSceneHandle, const GhostObjectHandle& ghostObjectHandle) const = 0;
 	
 	virtual Raycast raycast(const PhysicsSceneHandle& physicsSceneHandle, const ray::Ray& ray) = 0;
 	
 	virtual std::vector<boost::variant<RigidBodyObjectHandle, GhostObjectHandle>> query(const PhysicsSceneHandle& physicsSceneHandle, const glm::vec3& origin, const std::vector<glm::vec3>& points) = 0;
 	virtual std::vector<boost::variant<RigidBodyObjectHandle, GhostObjectHandle>> query(const PhysicsSceneHandle& physicsSceneHandle, const glm::vec3& origin, const float32 radius) = 0;
 
+	/**
+	 * Batched raycasts and sphere queries, written into caller owned buffers that can be reused between calls.
+	 *
+	 * The default implementations call the single versions in turn - engines should override them to run the batch in
+	 * one pass, or in parallel.
+	 */
+	virtual void raycast(const PhysicsSceneHandle& physicsSceneHandle, const std::vector<ray::Ray>& rays, std::vector<Raycast>& raycasts)
+	{
+		raycasts.resize(rays.size());
+
+		for (size_t i = 0; i < rays.size(); ++i)
+		{
+			raycasts[i] = raycast(physicsSceneHandle, rays[i]);
+		}
+	}
+
+	virtual void query(
+		const PhysicsSceneHandle& physicsSceneHandle,
+		const std::vector<Sphere>& spheres,
+		QueryResults<boost::variant<RigidBodyObjectHandle, GhostObjectHandle>>& results
+	)
+	{
+		results.clear();
+
+		for (const auto& sphere : spheres)
+		{
+			for (const auto& object : query(physicsSceneHandle, sphere.origin, sphere.radius))
+			{
+				results.add(object);
+			}
+
+			results.endQuery();
+		}
+	}
+
 	virtual void setMotionChangeListener(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle, std::unique_ptr<IMotionChangeListener> motionStateListener) = 0;
 	
 	virtual void rotation(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle, const glm::quat& orientation) = 0;
@@ -0,0 +1,29 @@
+#ifndef PHYSICSSPHERE_H_
+#define PHYSICSSPHERE_H_
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+namespace physics
+{
+
+struct Sphere
+{
+	Sphere() = default;
+
+	Sphere(const glm::vec3& origin, const float32 radius) : origin(origin), radius(radius)
+	{
+	}
+
+	glm::vec3 origin;
+	float32 radius = 0.0f;
+};
+
+}
+}
+
+#endif /* PHYSICSSPHERE_H_ */
@@ -0,0 +1,162 @@
+#ifndef STUBPHYSICSENGINE_H_
+#define STUBPHYSICSENGINE_H_
+
+#include <memory>
+#include <unordered_map>
+
+#include <glm/gtc/quaternion.hpp>
+
+#include "physics/IPhysicsEngine.hpp"
+
+#include "handles/HandleVector.hpp"
+
+namespace ice_engine
+{
+namespace physics
+{
+
+/**
+ * A physics engine without collisions, for headless runs.
+ *
+ * Bodies with mass fall under gravity and report their motion every tick, so entities move and change as they would
+ * with a real engine.  Nothing ever collides - raycasts hit nothing and sphere queries test positions only.
+ */
+class StubPhysicsEngine : public IPhysicsEngine
+{
+public:
+	StubPhysicsEngine() = default;
+	virtual ~StubPhysicsEngine() override = default;
+
+	virtual void tick(const PhysicsSceneHandle& physicsSceneHandle, const float32 delta) override;
+	virtual void renderDebug(const PhysicsSceneHandle& physicsSceneHandle) override;
+
+	virtual PhysicsSceneHandle createPhysicsScene() override;
+	virtual void destroy(const PhysicsSceneHandle& physicsSceneHandle) override;
+
+	virtual void setGravity(const PhysicsSceneHandle& physicsSceneHandle, const glm::vec3& gravity) override;
+
+	virtual void setPhysicsDebugRenderer(IPhysicsDebugRenderer* physicsDebugRenderer) override;
+	virtual void setDebugRendering(const PhysicsSceneHandle& physicsSceneHandle, const bool enabled) override;
+
+	virtual CollisionShapeHandle createStaticPlaneShape(const glm::vec3& planeNormal, const float32 planeConstant) override;
+	virtual CollisionShapeHandle createStaticBoxShape(const glm::vec3& dimensions) override;
+	virtual CollisionShapeHandle createStaticSphereShape(const float32 radius) override;
+	virtual CollisionShapeHandle createStaticTerrainShape(const IHeightfield& heightfield) override;
+	virtual void destroy(const CollisionShapeHandle& collisionShapeHandle) override;
+	virtual void destroyAllStaticShapes() override;
+
+	virtual RigidBodyObjectHandle createRigidBodyObject(
+		const PhysicsSceneHandle& physicsSceneHandle,
+		const CollisionShapeHandle& collisionShapeHandle,
+		std::unique_ptr<IMotionChangeListener> motionStateListener = nullptr,
+		const UserTag& userTag = UserTag()
+	) override;
+	virtual RigidBodyObjectHandle createRigidBodyObject(
+		const PhysicsSceneHandle& physicsSceneHandle,
+		const CollisionShapeHandle& collisionShapeHandle,
+		const float32 mass,
+		const float32 friction,
+		const float32 restitution,
+		std::unique_ptr<IMotionChangeListener> motionStateListener = nullptr,
+		const UserTag& userTag = UserTag()
+	) override;
+	virtual RigidBodyObjectHandle createRigidBodyObject(
+		const PhysicsSceneHandle& physicsSceneHandle,
+		const CollisionShapeHandle& collisionShapeHandle,
+		const glm::vec3& position,
+		const glm::quat& orientation,
+		const float32 mass = 1.0f,
+		const float32 friction = 1.0f,
+		const float32 restitution = 1.0f,
+		std::unique_ptr<IMotionChangeListener> motionStateListener = nullptr,
+		const UserTag& userTag = UserTag()
+	) override;
+	virtual GhostObjectHandle createGhostObject(const PhysicsSceneHandle& physicsSceneHandle, const CollisionShapeHandle& collisionShapeHandle, const UserTag& userTag = UserTag()) override;
+	virtual GhostObjectHandle createGhostObject(
+		const PhysicsSceneHandle& physicsSceneHandle,
+		const CollisionShapeHandle& collisionShapeHandle,
+		const glm::vec3& position,
+		const glm::quat& orientation,
+		const UserTag& userTag = UserTag()
+	) override;
+	virtual void destroy(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle) override;
+	virtual void destroy(const PhysicsSceneHandle& physicsSceneHandle, const GhostObjectHandle& ghostObjectHandle) override;
+	virtual void destroyAllRigidBodies() override;
+
+	virtual void setUserTag(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle, const UserTag& userTag) override;
+	virtual void setUserTag(const PhysicsSceneHandle& physicsSceneHandle, const GhostObjectHandle& ghostObjectHandle, const UserTag& userTag) override;
+	virtual UserTag getUserTag(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle) const override;
+	virtual UserTag getUserTag(const PhysicsSceneHandle& physicsSceneHandle, const GhostObjectHandle& ghostObjectHandle) const override;
+
+	virtual Raycast raycast(const PhysicsSceneHandle& physicsSceneHandle, const ray::Ray& ray) override;
+
+	virtual std::vector<boost::variant<RigidBodyObjectHandle, GhostObjectHandle>> query(const PhysicsSceneHandle& physicsSceneHandle, const glm::vec3& origin, const std::vector<glm::vec3>& points) override;
+	virtual std::vector<boost::variant<RigidBodyObjectHandle, GhostObjectHandle>> query(const PhysicsSceneHandle& physicsSceneHandle, const glm::vec3& origin, const float32 radius) override;
+
+	virtual void setMotionChangeListener(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle, std::unique_ptr<IMotionChangeListener> motionStateListener) override;
+
+	virtual void rotation(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle, const glm::quat& orientation) override;
+	virtual glm::quat rotation(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle) const override;
+
+	virtual void rotation(const PhysicsSceneHandle& physicsSceneHandle, const GhostObjectHandle& ghostObjectHandle, const glm::quat& orientation) override;
+	virtual glm::quat rotation(const PhysicsSceneHandle& physicsSceneHandle, const GhostObjectHandle& ghostObjectHandle) const override;
+
+	virtual void position(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle, const float32 x, const float32 y, const float32 z) override;
+	virtual void position(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle, const glm::vec3& position) override;
+	virtual glm::vec3 position(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle) const override;
+
+	virtual void position(const PhysicsSceneHandle& physicsSceneHandle, const GhostObjectHandle& ghostObjectHandle, const float32 x, const float32 y, const float32 z) override;
+	virtual void position(const PhysicsSceneHandle& physicsSceneHandle, const GhostObjectHandle& ghostObjectHandle, const glm::vec3& position) override;
+	virtual glm::vec3 position(const PhysicsSceneHandle& physicsSceneHandle, const GhostObjectHandle& ghostObjectHandle) const override;
+
+	virtual void mass(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle, const float32 mass) override;
+	virtual float32 mass(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle) const override;
+
+	virtual void friction(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle, const float32 friction) override;
+	virtual float32 friction(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle) const override;
+
+	virtual void restitution(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle, const float32 restitution) override;
+	virtual float32 restitution(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle) const override;
+
+private:
+	struct GhostObject
+	{
+		glm::vec3 position = glm::vec3(0.0f);
+		glm::quat orientation = glm::quat();
+		UserTag userTag;
+	};
+
+	struct RigidBody : public GhostObject
+	{
+		glm::vec3 velocity = glm::vec3(0.0f);
+		float32 mass = 1.0f;
+		float32 friction = 1.0f;
+		float32 restitution = 1.0f;
+		std::unique_ptr<IMotionChangeListener> motionChangeListener;
+	};
+
+	// Objects are owned by their scene, and their handles point at them
+	struct PhysicsScene
+	{
+		glm::vec3 gravity = glm::vec3(0.0f, -9.8f, 0.0f);
+		std::unordered_map<RigidBody*, std::unique_ptr<RigidBody>> rigidBodies;
+		std::unordered_map<GhostObject*, std::unique_ptr<GhostObject>> ghostObjects;
+	};
+
+	struct CollisionShape
+	{
+	};
+
+	handles::HandleVector<PhysicsScene, PhysicsSceneHandle> physicsScenes_;
+	handles::HandleVector<CollisionShape, CollisionShapeHandle> collisionShapes_;
+
+	PhysicsScene& physicsScene(const PhysicsSceneHandle& physicsSceneHandle) const;
+
+	static RigidBody& rigidBody(const RigidBodyObjectHandle& rigidBodyObjectHandle);
+	static GhostObject& ghostObject(const GhostObjectHandle& ghostObjectHandle);
+};
+
+}
+}
+
+#endif /* STUBPHYSICSENGINE_H_ */
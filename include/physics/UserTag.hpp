@@ -0,0 +1,54 @@
+#ifndef PHYSICS_USERTAG_H_
+#define PHYSICS_USERTAG_H_
+
+#include <limits>
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+namespace physics
+{
+
+/**
+ * Fixed size tag that an object carries for its owner - the engine stores and returns it, but never looks inside.
+ *
+ * The scene stores the owning entity's index and version in it.
+ */
+struct UserTag
+{
+	static const uint32 INVALID_INDEX = std::numeric_limits<uint32>::max();
+
+	uint32 index = INVALID_INDEX;
+	uint32 version = 0;
+
+	UserTag() = default;
+	UserTag(const uint32 index, const uint32 version) : index(index), version(version)
+	{
+	}
+
+	bool valid() const
+	{
+		return index != INVALID_INDEX;
+	}
+
+	explicit operator bool() const
+	{
+		return valid();
+	}
+
+	bool operator==(const UserTag& other) const
+	{
+		return index == other.index && version == other.version;
+	}
+
+	bool operator!=(const UserTag& other) const
+	{
+		return !(*this == other);
+	}
+};
+
+}
+}
+
+#endif /* PHYSICS_USERTAG_H_ */
@@ -0,0 +1,70 @@
+#ifndef REPLICATION_APPLYENTITYSTATE_H_
+#define REPLICATION_APPLYENTITYSTATE_H_
+
+#include "replication/EntityState.hpp"
+
+#include "ecs/Entity.hpp"
+#include "ecs/PositionComponent.hpp"
+#include "ecs/OrientationComponent.hpp"
+#include "ecs/ReplicatedComponent.hpp"
+#include "ecs/DirtyComponent.hpp"
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+namespace replication
+{
+
+/**
+ * Applies a replicated state to an existing replicated entity, assigning the position or orientation it is missing.
+ *
+ * Returns the dirty flags for what changed - DIRTY_POSITION and/or DIRTY_ORIENTATION, or 0 if the entity already
+ * matched the state.
+ */
+inline uint16 applyEntityState(ecs::Entity entity, const EntityState& state)
+{
+	uint16 dirty = 0;
+
+	// A local entity may have been marked replicated before it had a transform
+	if (entity.hasComponent<ecs::PositionComponent>())
+	{
+		auto positionComponent = entity.component<ecs::PositionComponent>();
+
+		if (positionComponent->position != state.position)
+		{
+			positionComponent->position = state.position;
+			dirty |= ecs::DirtyFlags::DIRTY_POSITION;
+		}
+	}
+	else
+	{
+		entity.assign<ecs::PositionComponent>(state.position);
+		dirty |= ecs::DirtyFlags::DIRTY_POSITION;
+	}
+
+	if (entity.hasComponent<ecs::OrientationComponent>())
+	{
+		auto orientationComponent = entity.component<ecs::OrientationComponent>();
+
+		if (orientationComponent->orientation != state.orientation)
+		{
+			orientationComponent->orientation = state.orientation;
+			dirty |= ecs::DirtyFlags::DIRTY_ORIENTATION;
+		}
+	}
+	else
+	{
+		entity.assign<ecs::OrientationComponent>(state.orientation);
+		dirty |= ecs::DirtyFlags::DIRTY_ORIENTATION;
+	}
+
+	entity.component<ecs::ReplicatedComponent>()->custom = state.custom;
+
+	return dirty;
+}
+
+}
+}
+
+#endif /* REPLICATION_APPLYENTITYSTATE_H_ */
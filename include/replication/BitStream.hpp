@@ -0,0 +1,179 @@
+#ifndef REPLICATION_BITSTREAM_H_
+#define REPLICATION_BITSTREAM_H_
+
+#include <vector>
+
+#include "Types.hpp"
+
+#include "exceptions/RuntimeException.hpp"
+
+#include "detail/Format.hpp"
+
+namespace ice_engine
+{
+namespace replication
+{
+
+/**
+ * Packs values of arbitrary bit widths (up to 32) into bytes, least significant bit first.
+ */
+class BitWriter
+{
+public:
+	BitWriter(std::vector<uint8>& data) : data_(data)
+	{
+		data_.clear();
+	}
+
+	void write(const uint32 value, const uint32 bits)
+	{
+		uint64 remaining = bits < 32 ? value & ((uint32(1) << bits) - 1) : value;
+		uint32 remainingBits = bits;
+
+		// Fill up the partially written last byte first, then whole bytes
+		const uint32 offset = position_ & 7;
+
+		if (offset != 0 && remainingBits > 0)
+		{
+			const uint32 free = 8 - offset;
+
+			data_.back() |= static_cast<uint8>(remaining << offset);
+
+			if (remainingBits <= free)
+			{
+				position_ += remainingBits;
+				return;
+			}
+
+			remaining >>= free;
+			remainingBits -= free;
+			position_ += free;
+		}
+
+		while (remainingBits > 0)
+		{
+			data_.push_back(static_cast<uint8>(remaining));
+
+			const uint32 written = remainingBits < 8 ? remainingBits : 8;
+
+			remaining >>= 8;
+			remainingBits -= written;
+			position_ += written;
+		}
+	}
+
+	void writeBool(const bool value)
+	{
+		write(value ? 1 : 0, 1);
+	}
+
+	/**
+	 * Seven bits at a time, with a continuation bit - small values take a single group.
+	 */
+	void writeVariable(uint32 value)
+	{
+		do
+		{
+			write(value & 0x7f, 7);
+			value >>= 7;
+			writeBool(value != 0);
+		}
+		while (value != 0);
+	}
+
+	/**
+	 * Signed values zigzag encoded, preceded by their bit length - zero takes just the length.
+	 */
+	void writeSigned(const int32 value)
+	{
+		const uint32 zigzag = (static_cast<uint32>(value) << 1) ^ static_cast<uint32>(value >> 31);
+
+		uint32 bits = 0;
+		while (bits < 32 && (zigzag >> bits) != 0) ++bits;
+
+		write(bits, 6);
+		write(zigzag, bits);
+	}
+
+	size_t bits() const
+	{
+		return position_;
+	}
+
+private:
+	std::vector<uint8>& data_;
+	size_t position_ = 0;
+};
+
+class BitReader
+{
+public:
+	BitReader(const uint8* data, const size_t size) : data_(data), size_(size)
+	{
+	}
+
+	uint32 read(const uint32 bits)
+	{
+		if (position_ + bits > size_ * 8)
+		{
+			throw RuntimeException(detail::format("Cannot read %s bits at bit %s of a %s byte message.", bits, position_, size_));
+		}
+
+		uint64 value = 0;
+		uint32 readBits = 0;
+
+		while (readBits < bits)
+		{
+			const uint32 offset = position_ & 7;
+			const uint32 available = 8 - offset;
+			const uint32 count = (bits - readBits) < available ? (bits - readBits) : available;
+
+			value |= static_cast<uint64>((data_[position_ >> 3] >> offset) & ((1 << count) - 1)) << readBits;
+
+			readBits += count;
+			position_ += count;
+		}
+
+		return static_cast<uint32>(value);
+	}
+
+	bool readBool()
+	{
+		return read(1) != 0;
+	}
+
+	uint32 readVariable()
+	{
+		uint32 value = 0;
+
+		for (uint32 shift = 0; shift < 35; shift += 7)
+		{
+			value |= read(7) << shift;
+
+			if (!readBool()) return value;
+		}
+
+		throw RuntimeException("Variable length value is longer than 32 bits.");
+	}
+
+	int32 readSigned()
+	{
+		const uint32 bits = read(6);
+
+		if (bits > 32) throw RuntimeException(detail::format("Signed value claims %s bits.", bits));
+
+		const uint32 zigzag = read(bits);
+
+		return static_cast<int32>((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+	}
+
+private:
+	const uint8* data_;
+	size_t size_;
+	size_t position_ = 0;
+};
+
+}
+}
+
+#endif /* REPLICATION_BITSTREAM_H_ */
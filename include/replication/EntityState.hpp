@@ -0,0 +1,77 @@
+#ifndef REPLICATION_ENTITYSTATE_H_
+#define REPLICATION_ENTITYSTATE_H_
+
+#include <vector>
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+namespace replication
+{
+
+/**
+ * The replicated state of an entity - its position, orientation and any game specific bytes.
+ */
+struct EntityState
+{
+	EntityState() = default;
+
+	EntityState(const uint32 id, const glm::vec3& position, const glm::quat& orientation, std::vector<uint8> custom = std::vector<uint8>())
+	:
+		id(id),
+		position(position),
+		orientation(orientation),
+		custom(std::move(custom))
+	{
+	}
+
+	uint32 id = 0;
+	glm::vec3 position;
+	glm::quat orientation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+	std::vector<uint8> custom;
+};
+
+/**
+ * An EntityState as it goes over the wire.
+ *
+ * Positions are integer multiples of the position precision.  Orientations are packed "smallest three" - the index of
+ * the largest component in the top 2 bits, then the other three components in 10 bits each (the largest is implied,
+ * since the quaternion is unit length).
+ */
+struct QuantizedEntityState
+{
+	uint32 id = 0;
+	int32 position[3] = {0, 0, 0};
+	uint32 orientation = 0;
+	std::vector<uint8> custom;
+};
+
+class Quantizer
+{
+public:
+	/**
+	 * positionPrecision is the size of a position step in world units.
+	 */
+	Quantizer(const float32 positionPrecision = 0.01f);
+
+	QuantizedEntityState quantize(const EntityState& entityState) const;
+	EntityState dequantize(const QuantizedEntityState& quantizedEntityState) const;
+
+	uint32 quantize(const glm::quat& orientation) const;
+	glm::quat dequantizeOrientation(const uint32 orientation) const;
+
+	float32 positionPrecision() const;
+
+private:
+	float32 positionPrecision_;
+};
+
+}
+}
+
+#endif /* REPLICATION_ENTITYSTATE_H_ */
@@ -0,0 +1,80 @@
+#ifndef REPLICATION_LOOPBACKREPLICATION_H_
+#define REPLICATION_LOOPBACKREPLICATION_H_
+
+#include <vector>
+#include <string>
+#include <random>
+#include <utility>
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+
+#include "replication/ReplicationServer.hpp"
+#include "replication/ReplicationClient.hpp"
+
+#include "networking/MessageBuffer.hpp"
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+namespace replication
+{
+
+/**
+ * A ReplicationServer and its clients in one process, with the messages between them handed over directly.
+ *
+ * Messages (snapshots and acknowledgements alike) can be dropped with the given probability, to see how replication
+ * behaves on a lossy connection.  Useful for tuning the replication settings against a game's entity counts, since it
+ * reports the bandwidth each client would use.
+ */
+class LoopbackReplication
+{
+public:
+	LoopbackReplication(const uint32 numberOfClients, const ReplicationSettings& replicationSettings = ReplicationSettings(), const float32 packetLoss = 0.0f, const uint32 seed = 0);
+
+	LoopbackReplication(const LoopbackReplication& other) = delete;
+	LoopbackReplication& operator=(const LoopbackReplication& other) = delete;
+
+	void setFocus(const ClientId clientId, const glm::vec3& focus);
+
+	/**
+	 * Sends a snapshot of states to every client, and their acknowledgements back.
+	 */
+	void tick(const std::vector<EntityState>& states, const float32 delta);
+
+	uint32 numberOfClients() const;
+
+	const ReplicationServer& server() const;
+	const ReplicationClient& client(const ClientId clientId) const;
+
+	/**
+	 * Average bytes per second sent to the client since the first tick.
+	 */
+	float32 bandwidth(const ClientId clientId) const;
+
+	/**
+	 * A line per client with its bandwidth, messages and entities.
+	 */
+	std::string report() const;
+
+private:
+	networking::MessageBufferPool messageBufferPool_;
+	ReplicationServer server_;
+	std::vector<ReplicationClient> clients_;
+
+	float32 packetLoss_;
+	std::mt19937 generator_;
+	std::uniform_real_distribution<float32> distribution_;
+
+	float32 time_ = 0.0f;
+
+	std::vector<std::pair<ClientId, networking::MessageBuffer>> messages_;
+
+	bool dropped();
+};
+
+}
+}
+
+#endif /* REPLICATION_LOOPBACKREPLICATION_H_ */
@@ -0,0 +1,59 @@
+#ifndef REPLICATION_REPLICATIONCLIENT_H_
+#define REPLICATION_REPLICATIONCLIENT_H_
+
+#include <vector>
+#include <map>
+
+#include "replication/EntityState.hpp"
+#include "replication/Snapshot.hpp"
+#include "replication/ReplicationSettings.hpp"
+
+#include "networking/MessageBuffer.hpp"
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+namespace replication
+{
+
+/**
+ * Client side of entity replication - decodes snapshots from a ReplicationServer and keeps the ones the server may
+ * still encode against.
+ */
+class ReplicationClient
+{
+public:
+	ReplicationClient(const ReplicationSettings& replicationSettings = ReplicationSettings());
+
+	/**
+	 * Returns false (and ignores the message) if it is older than the latest snapshot, or was encoded against a
+	 * snapshot this client doesn't have.
+	 */
+	bool receive(const networking::MessageBuffer& message);
+	bool receive(const uint8* data, const size_t size);
+
+	/**
+	 * Sequence of the latest snapshot - 0 before the first one arrives.
+	 */
+	uint32 sequence() const;
+
+	std::vector<EntityState> states() const;
+	void states(std::vector<EntityState>& states) const;
+
+	/**
+	 * Message telling the server the latest snapshot arrived.
+	 */
+	networking::MessageBuffer acknowledgement(networking::MessageBufferPool& messageBufferPool) const;
+
+private:
+	Quantizer quantizer_;
+	uint32 snapshotHistory_;
+
+	std::map<uint32, Snapshot> snapshots_;
+};
+
+}
+}
+
+#endif /* REPLICATION_REPLICATIONCLIENT_H_ */
@@ -0,0 +1,114 @@
+#ifndef REPLICATION_REPLICATIONSERVER_H_
+#define REPLICATION_REPLICATIONSERVER_H_
+
+#include <vector>
+#include <deque>
+#include <map>
+#include <utility>
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+
+#include "replication/EntityState.hpp"
+#include "replication/Snapshot.hpp"
+#include "replication/ReplicationSettings.hpp"
+
+#include "networking/MessageBuffer.hpp"
+
+#include "SpatialIndex.hpp"
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+namespace replication
+{
+
+typedef uint32 ClientId;
+
+struct ClientStatistics
+{
+	uint64 bytes = 0;
+	uint32 messages = 0;
+
+	// Entities in the last snapshot sent
+	uint32 entities = 0;
+};
+
+/**
+ * Server side of entity replication.
+ *
+ * Every update quantizes the entity states once, then builds a snapshot per client of the entities it is interested
+ * in and delta encodes it against the last snapshot that client acknowledged.  Messages are returned rather than sent,
+ * so the game decides how client ids map to connections (and the same server works over a loopback).
+ */
+class ReplicationServer
+{
+public:
+	ReplicationServer(networking::MessageBufferPool* messageBufferPool, const ReplicationSettings& replicationSettings = ReplicationSettings());
+
+	void addClient(const ClientId clientId);
+	void removeClient(const ClientId clientId);
+	bool hasClient(const ClientId clientId) const;
+
+	/**
+	 * Point the client's interest radius is centered on - clients without a focus get every entity.
+	 */
+	void setFocus(const ClientId clientId, const glm::vec3& focus);
+
+	/**
+	 * The client has the snapshot with the given sequence - later snapshots are encoded against it.
+	 */
+	void acknowledge(const ClientId clientId, const uint32 sequence);
+
+	/**
+	 * Handles an acknowledgement message from ReplicationClient::acknowledgement.
+	 */
+	void receive(const ClientId clientId, const networking::MessageBuffer& message);
+
+	/**
+	 * Encodes a snapshot of states for each client - messages is cleared, then gets a message per client.
+	 */
+	void update(const std::vector<EntityState>& states, std::vector<std::pair<ClientId, networking::MessageBuffer>>& messages);
+
+	const ClientStatistics& statistics(const ClientId clientId) const;
+
+private:
+	struct Client
+	{
+		bool hasFocus = false;
+		glm::vec3 focus;
+
+		uint32 sequence = 0;
+		uint32 acknowledged = 0;
+
+		// Snapshots sent but not yet superseded by an acknowledgement, oldest first
+		std::deque<Snapshot> history;
+
+		ClientStatistics statistics;
+	};
+
+	networking::MessageBufferPool* messageBufferPool_;
+	ReplicationSettings replicationSettings_;
+	Quantizer quantizer_;
+
+	std::map<ClientId, Client> clients_;
+
+	// Quantized states of the current update, sorted by id
+	std::vector<QuantizedEntityState> states_;
+
+	SpatialIndex spatialIndex_;
+	std::vector<uint32> indexedIds_;
+	std::vector<SpatialIndex::Id> spatialIndexResults_;
+	std::vector<uint8> data_;
+
+	Client& client(const ClientId clientId);
+	const Client& client(const ClientId clientId) const;
+
+	void updateSpatialIndex(const std::vector<EntityState>& states);
+};
+
+}
+}
+
+#endif /* REPLICATION_REPLICATIONSERVER_H_ */
@@ -0,0 +1,41 @@
+#ifndef REPLICATION_REPLICATIONSETTINGS_H_
+#define REPLICATION_REPLICATIONSETTINGS_H_
+
+#include "utilities/Properties.hpp"
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+namespace replication
+{
+
+/**
+ * Settings for entity replication, read from the [replication] section of the settings.
+ *
+ * Positions are sent in steps of positionPrecision world units.  Clients with a focus point only get the entities
+ * within interestRadius of it (0 sends every entity).  The server keeps the last snapshotHistory snapshots it sent each
+ * client, to delta encode against whichever one the client acknowledges - a client that falls further behind gets a
+ * full snapshot.
+ */
+struct ReplicationSettings
+{
+	ReplicationSettings() = default;
+
+	ReplicationSettings(const utilities::Properties& properties)
+	:
+		positionPrecision(properties.getFloatValue("replication.positionprecision", 0.01f)),
+		interestRadius(properties.getFloatValue("replication.interestradius", 0.0f)),
+		snapshotHistory(static_cast<uint32>(properties.getIntValue("replication.snapshothistory", 32)))
+	{
+	}
+
+	float32 positionPrecision = 0.01f;
+	float32 interestRadius = 0.0f;
+	uint32 snapshotHistory = 32;
+};
+
+}
+}
+
+#endif /* REPLICATION_REPLICATIONSETTINGS_H_ */
@@ -0,0 +1,53 @@
+#ifndef REPLICATION_SNAPSHOT_H_
+#define REPLICATION_SNAPSHOT_H_
+
+#include <vector>
+
+#include "replication/EntityState.hpp"
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+namespace replication
+{
+
+/**
+ * The entities a client can see at one point in time, sorted by id.
+ *
+ * Sequence numbers start at 1 - a baseline sequence of 0 means "no baseline".
+ */
+struct Snapshot
+{
+	uint32 sequence = 0;
+	std::vector<QuantizedEntityState> entities;
+};
+
+/**
+ * Bit packs a snapshot as a delta against a baseline snapshot the receiver already has (or against nothing, if
+ * baseline is null).
+ *
+ * The message holds the sequence and baseline sequence (32 bits each), then the ids of the entities that are gone
+ * since the baseline, then the entities that are new or changed (each behind a continuation bit).  Ids are written as
+ * variable length deltas from the previous id.  A changed entity has a 3 bit mask of what changed: positions as per
+ * axis signed deltas, orientations as their 32 packed bits, and custom bytes XORed with the baseline's (a bit per byte,
+ * plus the byte when it differs).  Unchanged entities cost nothing.
+ */
+void encode(const Snapshot& snapshot, const Snapshot* baseline, std::vector<uint8>& data);
+
+/**
+ * The baseline sequence a message was encoded against - the receiver needs that snapshot to decode it.
+ */
+uint32 baselineSequence(const uint8* data, const size_t size);
+uint32 sequence(const uint8* data, const size_t size);
+
+/**
+ * Decodes a message from encode.  baseline has to be the snapshot with the message's baseline sequence (or null if it
+ * is 0).
+ */
+Snapshot decode(const uint8* data, const size_t size, const Snapshot* baseline);
+
+}
+}
+
+#endif /* REPLICATION_SNAPSHOT_H_ */
@@ -0,0 +1,30 @@
+#ifndef BINARYINARCHIVE_H_
+#define BINARYINARCHIVE_H_
+
+#include <string>
+#include <istream>
+
+#include <boost/archive/binary_iarchive.hpp>
+
+namespace ice_engine
+{
+namespace serialization
+{
+
+/**
+ * Binary archive in the host's byte order - used for the blocks of a scene snapshot, which carry their own header.
+ */
+class BinaryInArchive : public boost::archive::binary_iarchive
+{
+public:
+	BinaryInArchive(std::istream& istream) : boost::archive::binary_iarchive(istream, boost::archive::no_header)
+	{
+	}
+
+	virtual ~BinaryInArchive() = default;
+};
+
+}
+}
+
+#endif /* BINARYINARCHIVE_H_ */
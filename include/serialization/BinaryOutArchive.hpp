@@ -0,0 +1,31 @@
+#ifndef BINARYOUTARCHIVE_H_
+#define BINARYOUTARCHIVE_H_
+
+#include <string>
+#include <ostream>
+
+#include <boost/archive/binary_oarchive.hpp>
+
+namespace ice_engine
+{
+namespace serialization
+{
+
+/**
+ * Binary archive in the host's byte order - used for the blocks of a scene snapshot, which carry their own header.
+ */
+class BinaryOutArchive : public boost::archive::binary_oarchive
+{
+public:
+	BinaryOutArchive(std::ostream& ostream) : boost::archive::binary_oarchive(ostream, boost::archive::no_header)
+	{
+
+	}
+
+	virtual ~BinaryOutArchive() = default;
+};
+
+}
+}
+
+#endif /* BINARYOUTARCHIVE_H_ */
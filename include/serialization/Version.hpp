@@ -0,0 +1 @@
+#include <boost/serialization/version.hpp>
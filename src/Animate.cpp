@@ -1,3 +1,5 @@
+#include <limits>
+
 #define GLM_FORCE_RADIANS
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/string_cast.hpp>
@@ -13,7 +15,7 @@ namespace ice_engine
 namespace
 {
 
-uint32 findPosition(const std::chrono::duration<float32> animationTime, const AnimatedBoneNode& animatedBoneNode, std::vector<uint32>& indexCache)
+uint32 findPosition(const std::chrono::duration<float32> animationTime, const AnimatedBoneNode& animatedBoneNode, uint32* indexCache)
 {
 	ICE_ENGINE_ASSERT(animatedBoneNode.positionKeyFrames.size() > 0);
 	
@@ -49,7 +51,7 @@ uint32 findPosition(const std::chrono::duration<float32> animationTime, const An
 	throw RuntimeException("Unable to find appropriate position time - this shouldn't happen.");
 }
 
-uint32 findRotation(const std::chrono::duration<float32> animationTime, const AnimatedBoneNode& animatedBoneNode, std::vector<uint32>& indexCache)
+uint32 findRotation(const std::chrono::duration<float32> animationTime, const AnimatedBoneNode& animatedBoneNode, uint32* indexCache)
 {
 	ICE_ENGINE_ASSERT(animatedBoneNode.rotationKeyFrames.size() > 0);
 	
@@ -86,7 +88,7 @@ uint32 findRotation(const std::chrono::duration<float32> animationTime, const An
 }
 
 
-uint32 findScaling(const std::chrono::duration<float32> animationTime, const AnimatedBoneNode& animatedBoneNode, std::vector<uint32>& indexCache)
+uint32 findScaling(const std::chrono::duration<float32> animationTime, const AnimatedBoneNode& animatedBoneNode, uint32* indexCache)
 {
 	ICE_ENGINE_ASSERT(animatedBoneNode.scalingKeyFrames.size() > 0);
 	
@@ -122,7 +124,7 @@ uint32 findScaling(const std::chrono::duration<float32> animationTime, const Ani
 	throw RuntimeException("Unable to find appropriate scaling time - this shouldn't happen.");
 }
 
-glm::vec3 calcInterpolatedPosition(const std::chrono::duration<float32> animationTime, const AnimatedBoneNode& animatedBoneNode, std::vector<uint32>& indexCache)
+glm::vec3 calcInterpolatedPosition(const std::chrono::duration<float32> animationTime, const AnimatedBoneNode& animatedBoneNode, uint32* indexCache)
 {
 	glm::vec3 result;
 
@@ -150,7 +152,7 @@ glm::vec3 calcInterpolatedPosition(const std::chrono::duration<float32> animatio
 }
 
 
-glm::quat calcInterpolatedRotation(const std::chrono::duration<float32> animationTime, const AnimatedBoneNode& animatedBoneNode, std::vector<uint32>& indexCache)
+glm::quat calcInterpolatedRotation(const std::chrono::duration<float32> animationTime, const AnimatedBoneNode& animatedBoneNode, uint32* indexCache)
 {
 	glm::quat result;
 
@@ -180,7 +182,7 @@ glm::quat calcInterpolatedRotation(const std::chrono::duration<float32> animatio
 }
 
 
-glm::vec3 calcInterpolatedScaling(const std::chrono::duration<float32> animationTime, const AnimatedBoneNode& animatedBoneNode, std::vector<uint32>& indexCache)
+glm::vec3 calcInterpolatedScaling(const std::chrono::duration<float32> animationTime, const AnimatedBoneNode& animatedBoneNode, uint32* indexCache)
 {
 	glm::vec3 result;
 
@@ -206,7 +208,7 @@ glm::vec3 calcInterpolatedScaling(const std::chrono::duration<float32> animation
 	return result;
 }
 
-glm::mat4 calculateNodeTransformation(const std::chrono::duration<float32> animationTime, const AnimatedBoneNode& animatedBoneNode, std::vector<uint32>& indexCache)
+glm::mat4 calculateNodeTransformation(const std::chrono::duration<float32> animationTime, const AnimatedBoneNode& animatedBoneNode, uint32* indexCache)
 {
 	// Interpolate scaling and generate scaling transformation matrix
 	const glm::vec3 scaling = calcInterpolatedScaling(animationTime, animatedBoneNode, indexCache);
@@ -224,10 +226,12 @@ glm::mat4 calculateNodeTransformation(const std::chrono::duration<float32> anima
 	return translationM * rotationM * scalingM;
 }
 
-void readNodeHeirarchy(std::vector<glm::mat4>& transformations, const std::chrono::duration<float32> animationTime, const glm::mat4& globalInverseModelSpaceTransform, const std::unordered_map< std::string, AnimatedBoneNode >& animatedBoneNodes, const BoneNode& rootBoneNode, const BoneData& boneData, const glm::mat4& parentJointSpaceTransform, std::vector<uint32>& indexCache)
+void readNodeHeirarchy(glm::mat4* transformations, const std::chrono::duration<float32> animationTime, const glm::mat4& globalInverseModelSpaceTransform, const std::unordered_map< std::string, AnimatedBoneNode >& animatedBoneNodes, const BoneNode& rootBoneNode, const BoneData& boneData, const glm::mat4& parentJointSpaceTransform, uint32* indexCache, const uint32 depth, const uint32 maxAnimatedDepth)
 {
 	glm::mat4 jointSpaceTransformation = glm::mat4(rootBoneNode.transformation);
 
+	// Bones deeper than the max animated depth keep their rest transformation (relative to their animated parent)
+	if (depth <= maxAnimatedDepth)
 	{
         const auto it = animatedBoneNodes.find(rootBoneNode.name);
 
@@ -253,17 +257,18 @@ void readNodeHeirarchy(std::vector<glm::mat4>& transformations, const std::chron
 
     for (const auto& boneNode : rootBoneNode.children)
 	{
-		readNodeHeirarchy(transformations, animationTime, globalInverseModelSpaceTransform, animatedBoneNodes, boneNode, boneData, modelSpacePoseTansformation, indexCache);
+		readNodeHeirarchy(transformations, animationTime, globalInverseModelSpaceTransform, animatedBoneNodes, boneNode, boneData, modelSpacePoseTansformation, indexCache, depth + 1, maxAnimatedDepth);
 	}
 }
 
-void readNodeHeirarchy(std::vector<glm::mat4>& transformations, const std::chrono::duration<float32> animationTime, const glm::mat4& globalInverseTransform, const std::unordered_map< std::string, AnimatedBoneNode >& animatedBoneNodes, const BoneNode& rootBoneNode, const BoneData& boneData, const uint32 startFrame, const uint32 endFrame, const glm::mat4& parentTransform, std::vector<uint32>& indexCache)
+void readNodeHeirarchy(glm::mat4* transformations, const std::chrono::duration<float32> animationTime, const glm::mat4& globalInverseTransform, const std::unordered_map< std::string, AnimatedBoneNode >& animatedBoneNodes, const BoneNode& rootBoneNode, const BoneData& boneData, const uint32 startFrame, const uint32 endFrame, const glm::mat4& parentTransform, uint32* indexCache, const uint32 depth, const uint32 maxAnimatedDepth)
 {
 	glm::mat4 nodeTransformation = glm::mat4(rootBoneNode.transformation);
 
 	// animatedBoneNodes = Animation
 	// rootBoneNode = Joint
 
+	if (depth <= maxAnimatedDepth)
 	{
         const auto it = animatedBoneNodes.find(rootBoneNode.name);
 
@@ -322,7 +327,7 @@ void readNodeHeirarchy(std::vector<glm::mat4>& transformations, const std::chron
 
 	for (const auto& boneNode : rootBoneNode.children)
 	{
-		readNodeHeirarchy(transformations, animationTime, globalInverseTransform, animatedBoneNodes, boneNode, boneData, startFrame, endFrame, globalTransformation, indexCache);
+		readNodeHeirarchy(transformations, animationTime, globalInverseTransform, animatedBoneNodes, boneNode, boneData, startFrame, endFrame, globalTransformation, indexCache, depth + 1, maxAnimatedDepth);
 	}
 }
 
@@ -330,14 +335,12 @@ void readNodeHeirarchy(std::vector<glm::mat4>& transformations, const std::chron
 
 void animateSkeleton(std::vector<glm::mat4>& transformations, const glm::mat4& globalInverseTransformation, const std::unordered_map< std::string, AnimatedBoneNode >& animatedBoneNodes, const BoneNode& rootBoneNode, const BoneData& boneData, const std::chrono::duration<float32> duration, const float32 ticksPerSecond, const std::chrono::duration<float32> runningTime)
 {
-	std::vector<uint32> indexCache = std::vector<uint32>(3, 0);
-	animateSkeleton( transformations, globalInverseTransformation, animatedBoneNodes, rootBoneNode, boneData, duration, ticksPerSecond, runningTime, indexCache );
+	animateSkeleton( transformations.data(), static_cast<uint32>(transformations.size()), globalInverseTransformation, animatedBoneNodes, rootBoneNode, boneData, duration, ticksPerSecond, runningTime );
 }
 
 void animateSkeleton(std::vector<glm::mat4>& transformations, const glm::mat4& globalInverseTransformation, const std::unordered_map< std::string, AnimatedBoneNode >& animatedBoneNodes, const BoneNode& rootBoneNode, const BoneData& boneData, const std::chrono::duration<float32> duration, const float32 ticksPerSecond, const std::chrono::duration<float32> runningTime, const uint32 startFrame, const uint32 endFrame)
 {
-	std::vector<uint32> indexCache = std::vector<uint32>(3, 0);
-	animateSkeleton( transformations, globalInverseTransformation, animatedBoneNodes, rootBoneNode, boneData, duration, ticksPerSecond, runningTime, indexCache, startFrame, endFrame );
+	animateSkeleton( transformations.data(), static_cast<uint32>(transformations.size()), globalInverseTransformation, animatedBoneNodes, rootBoneNode, boneData, duration, ticksPerSecond, runningTime, startFrame, endFrame );
 }
 
 void animateSkeleton(std::vector<glm::mat4>& transformations, const glm::mat4& globalInverseTransformation, const std::unordered_map< std::string, AnimatedBoneNode >& animatedBoneNodes, const BoneNode& rootBoneNode, const BoneData& boneData, const std::chrono::duration<float32> duration, const float32 ticksPerSecond, const std::chrono::duration<float32> runningTime, std::vector<uint32>& indexCache)
@@ -348,9 +351,7 @@ void animateSkeleton(std::vector<glm::mat4>& transformations, const glm::mat4& g
     const std::chrono::duration<float32> timeInTicks = runningTime * ticksPerSecond;
 	const std::chrono::duration<float32> animationTime = std::chrono::duration<float32>(fmod(timeInTicks.count(), duration.count()));
 
-//	std::cout << animationTime << std::endl;
-
-	readNodeHeirarchy( transformations, animationTime, globalInverseTransformation, animatedBoneNodes, rootBoneNode, boneData, glm::mat4(1.0f), indexCache );
+	readNodeHeirarchy( transformations.data(), animationTime, globalInverseTransformation, animatedBoneNodes, rootBoneNode, boneData, glm::mat4(1.0f), indexCache.data(), 0, std::numeric_limits<uint32>::max() );
 }
 
 void animateSkeleton(std::vector<glm::mat4>& transformations, const glm::mat4& globalInverseTransformation, const std::unordered_map< std::string, AnimatedBoneNode >& animatedBoneNodes, const BoneNode& rootBoneNode, const BoneData& boneData, const std::chrono::duration<float32> duration, const float32 ticksPerSecond, const std::chrono::duration<float32> runningTime, std::vector<uint32>& indexCache, const uint32 startFrame, const uint32 endFrame)
@@ -361,9 +362,31 @@ void animateSkeleton(std::vector<glm::mat4>& transformations, const glm::mat4& g
     const std::chrono::duration<float32> timeInTicks = runningTime * ticksPerSecond;
 	const std::chrono::duration<float32> animationTime = std::chrono::duration<float32>(fmod(timeInTicks.count(), duration.count()));
 
-//	std::cout << animationTime << std::endl;
+	readNodeHeirarchy( transformations.data(), animationTime, globalInverseTransformation, animatedBoneNodes, rootBoneNode, boneData, startFrame, endFrame, glm::mat4(1.0f), indexCache.data(), 0, std::numeric_limits<uint32>::max() );
+}
+
+void animateSkeleton(glm::mat4* transformations, const uint32 numberOfTransformations, const glm::mat4& globalInverseTransformation, const std::unordered_map< std::string, AnimatedBoneNode >& animatedBoneNodes, const BoneNode& rootBoneNode, const BoneData& boneData, const std::chrono::duration<float32> duration, const float32 ticksPerSecond, const std::chrono::duration<float32> runningTime, const uint32 maxAnimatedDepth)
+{
+	ICE_ENGINE_ASSERT(numberOfTransformations >= boneData.boneTransform.size());
+
+	uint32 indexCache[3] = {0, 0, 0};
+
+    const std::chrono::duration<float32> timeInTicks = runningTime * ticksPerSecond;
+	const std::chrono::duration<float32> animationTime = std::chrono::duration<float32>(fmod(timeInTicks.count(), duration.count()));
+
+	readNodeHeirarchy( transformations, animationTime, globalInverseTransformation, animatedBoneNodes, rootBoneNode, boneData, glm::mat4(1.0f), indexCache, 0, maxAnimatedDepth );
+}
+
+void animateSkeleton(glm::mat4* transformations, const uint32 numberOfTransformations, const glm::mat4& globalInverseTransformation, const std::unordered_map< std::string, AnimatedBoneNode >& animatedBoneNodes, const BoneNode& rootBoneNode, const BoneData& boneData, const std::chrono::duration<float32> duration, const float32 ticksPerSecond, const std::chrono::duration<float32> runningTime, const uint32 startFrame, const uint32 endFrame, const uint32 maxAnimatedDepth)
+{
+	ICE_ENGINE_ASSERT(numberOfTransformations >= boneData.boneTransform.size());
+
+	uint32 indexCache[3] = {0, 0, 0};
+
+    const std::chrono::duration<float32> timeInTicks = runningTime * ticksPerSecond;
+	const std::chrono::duration<float32> animationTime = std::chrono::duration<float32>(fmod(timeInTicks.count(), duration.count()));
 
-	readNodeHeirarchy( transformations, animationTime, globalInverseTransformation, animatedBoneNodes, rootBoneNode, boneData, startFrame, endFrame, glm::mat4(1.0f), indexCache );
+	readNodeHeirarchy( transformations, animationTime, globalInverseTransformation, animatedBoneNodes, rootBoneNode, boneData, startFrame, endFrame, glm::mat4(1.0f), indexCache, 0, maxAnimatedDepth );
 }
 
 }
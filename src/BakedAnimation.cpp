@@ -0,0 +1,349 @@
+#include <cmath>
+#include <algorithm>
+
+#include "BakedAnimation.hpp"
+
+#include "detail/Assert.hpp"
+
+#include "exceptions/InvalidArgumentException.hpp"
+
+namespace ice_engine
+{
+namespace
+{
+
+const float32 SQRT_2 = 1.41421356237f;
+
+// If the clip doesn't specify a tick rate, Assimp's documented default
+const float32 DEFAULT_TICKS_PER_SECOND = 25.0f;
+
+template <typename T, typename Interpolate>
+T sampleKeyFrames(const std::vector<KeyFrame<T>>& keyFrames, const std::chrono::duration<float32> time, const T& defaultValue, Interpolate interpolate)
+{
+	if (keyFrames.empty())
+	{
+		return defaultValue;
+	}
+
+	if (keyFrames.size() == 1 || time <= keyFrames.front().time)
+	{
+		return keyFrames.front().transformation;
+	}
+
+	for (size_t i = 0; i < keyFrames.size() - 1; ++i)
+	{
+		if (time < keyFrames[i + 1].time)
+		{
+			const float32 factor = (time - keyFrames[i].time) / (keyFrames[i + 1].time - keyFrames[i].time);
+
+			return interpolate(keyFrames[i].transformation, keyFrames[i + 1].transformation, factor);
+		}
+	}
+
+	return keyFrames.back().transformation;
+}
+
+uint16 quantize(const float32 value, const float32 minimum, const float32 extent)
+{
+	if (extent <= 0.0f)
+	{
+		return 0;
+	}
+
+	return static_cast<uint16>(std::round(glm::clamp((value - minimum) / extent, 0.0f, 1.0f) * 65535.0f));
+}
+
+float32 dequantize(const uint16 value, const float32 minimum, const float32 extent)
+{
+	return minimum + (static_cast<float32>(value) / 65535.0f) * extent;
+}
+
+glm::vec3 dequantize(const uint16* value, const glm::vec3& minimum, const glm::vec3& extent)
+{
+	return glm::vec3(
+		dequantize(value[0], minimum.x, extent.x),
+		dequantize(value[1], minimum.y, extent.y),
+		dequantize(value[2], minimum.z, extent.z)
+	);
+}
+
+}
+
+BakedAnimation::BakedAnimation(const Animation& animation, const float32 sampleRate)
+	:
+		sampleRate_(sampleRate),
+		ticksPerSecond_(animation.ticksPerSecond()),
+		duration_(animation.duration())
+{
+	if (sampleRate <= 0.0f)
+	{
+		throw InvalidArgumentException("Sample rate must be greater than 0.");
+	}
+
+	ticksPerSample_ = (ticksPerSecond_ > 0.0f ? ticksPerSecond_ : DEFAULT_TICKS_PER_SECOND) / sampleRate_;
+	numberOfSamples_ = (duration_.count() > 0.0f ? static_cast<uint32>(std::ceil(duration_.count() / ticksPerSample_)) + 1 : 1);
+
+	const auto& animatedBoneNodes = animation.animatedBoneNodes();
+	const uint32 numberOfTracks = static_cast<uint32>(animatedBoneNodes.size());
+
+	tracks_.resize(numberOfTracks);
+	poses_.resize(numberOfTracks * numberOfSamples_);
+
+	std::vector<glm::vec3> translations(numberOfSamples_);
+	std::vector<glm::vec3> scalings(numberOfSamples_);
+
+	uint32 track = 0;
+	for (const auto& kv : animatedBoneNodes)
+	{
+		const AnimatedBoneNode& animatedBoneNode = kv.second;
+
+		trackIndices_[kv.first] = track;
+		tracks_[track].numberOfPositionKeyFrames = static_cast<uint32>(animatedBoneNode.positionKeyFrames.size());
+
+		if (animatedBoneNode.positionKeyFrames.size() > keyFrameTimes_.size())
+		{
+			keyFrameTimes_.clear();
+			for (const auto& keyFrame : animatedBoneNode.positionKeyFrames)
+			{
+				keyFrameTimes_.push_back(keyFrame.time);
+			}
+		}
+
+		glm::vec3 translationMinimum(std::numeric_limits<float32>::max());
+		glm::vec3 translationMaximum(std::numeric_limits<float32>::lowest());
+		glm::vec3 scalingMinimum(std::numeric_limits<float32>::max());
+		glm::vec3 scalingMaximum(std::numeric_limits<float32>::lowest());
+
+		for (uint32 i = 0; i < numberOfSamples_; ++i)
+		{
+			const auto time = std::min(std::chrono::duration<float32>(ticksPerSample_ * static_cast<float32>(i)), duration_);
+
+			translations[i] = sampleKeyFrames(animatedBoneNode.positionKeyFrames, time, glm::vec3(0.0f), [](const glm::vec3& a, const glm::vec3& b, const float32 factor) {
+				return a + factor * (b - a);
+			});
+			scalings[i] = sampleKeyFrames(animatedBoneNode.scalingKeyFrames, time, glm::vec3(1.0f), [](const glm::vec3& a, const glm::vec3& b, const float32 factor) {
+				return a + factor * (b - a);
+			});
+			const glm::quat rotation = sampleKeyFrames(animatedBoneNode.rotationKeyFrames, time, glm::quat(1.0f, 0.0f, 0.0f, 0.0f), [](const glm::quat& a, const glm::quat& b, const float32 factor) {
+				return glm::normalize(glm::slerp(a, b, factor));
+			});
+
+			compress(rotation, poses_[i * numberOfTracks + track].rotation);
+
+			translationMinimum = glm::min(translationMinimum, translations[i]);
+			translationMaximum = glm::max(translationMaximum, translations[i]);
+			scalingMinimum = glm::min(scalingMinimum, scalings[i]);
+			scalingMaximum = glm::max(scalingMaximum, scalings[i]);
+		}
+
+		Track& t = tracks_[track];
+		t.translationMinimum = translationMinimum;
+		t.translationExtent = translationMaximum - translationMinimum;
+		t.scalingMinimum = scalingMinimum;
+		t.scalingExtent = scalingMaximum - scalingMinimum;
+
+		for (uint32 i = 0; i < numberOfSamples_; ++i)
+		{
+			QuantizedPose& pose = poses_[i * numberOfTracks + track];
+
+			for (int j = 0; j < 3; ++j)
+			{
+				pose.translation[j] = quantize(translations[i][j], t.translationMinimum[j], t.translationExtent[j]);
+				pose.scaling[j] = quantize(scalings[i][j], t.scalingMinimum[j], t.scalingExtent[j]);
+			}
+		}
+
+		++track;
+	}
+}
+
+void BakedAnimation::animateSkeleton(
+	glm::mat4* transformations,
+	const uint32 numberOfTransformations,
+	const glm::mat4& globalInverseTransformation,
+	const BoneNode& rootBoneNode,
+	const BoneData& boneData,
+	const std::chrono::duration<float32> runningTime,
+	const uint32 startFrame,
+	const uint32 endFrame,
+	const uint32 maxAnimatedDepth
+) const
+{
+	ICE_ENGINE_ASSERT(numberOfTransformations >= boneData.boneTransform.size());
+
+	const std::chrono::duration<float32> timeInTicks = runningTime * ticksPerSecond_;
+	std::chrono::duration<float32> animationTime = std::chrono::duration<float32>(std::fmod(timeInTicks.count(), duration_.count()));
+
+	// Clamp animation time between start and end frame
+	if ((startFrame > 0 || endFrame > 0) && startFrame < keyFrameTimes_.size() && endFrame < keyFrameTimes_.size())
+	{
+		const std::chrono::duration<float32> st = keyFrameTimes_[startFrame];
+		const std::chrono::duration<float32> et = keyFrameTimes_[endFrame];
+
+		animationTime = std::chrono::duration<float32>(std::fmod(animationTime.count(), (et - st).count())) + st;
+	}
+
+	readNodeHeirarchy(transformations, animationTime, globalInverseTransformation, rootBoneNode, boneData, startFrame, endFrame, glm::mat4(1.0f), 0, maxAnimatedDepth);
+}
+
+uint32 BakedAnimation::numberOfSamples() const
+{
+	return numberOfSamples_;
+}
+
+float32 BakedAnimation::sampleRate() const
+{
+	return sampleRate_;
+}
+
+size_t BakedAnimation::memoryUsage() const
+{
+	return poses_.size() * sizeof(QuantizedPose) + tracks_.size() * sizeof(Track);
+}
+
+void BakedAnimation::compress(const glm::quat& quaternion, uint16* result)
+{
+	const float32 components[4] = {quaternion.x, quaternion.y, quaternion.z, quaternion.w};
+
+	uint32 largest = 0;
+	for (uint32 i = 1; i < 4; ++i)
+	{
+		if (std::abs(components[i]) > std::abs(components[largest]))
+		{
+			largest = i;
+		}
+	}
+
+	// q and -q are the same rotation, so flip the quaternion so the dropped component is positive
+	const float32 sign = (components[largest] < 0.0f ? -1.0f : 1.0f);
+
+	uint32 j = 0;
+	for (uint32 i = 0; i < 4; ++i)
+	{
+		if (i != largest)
+		{
+			// The smaller components are within [-1/sqrt(2), 1/sqrt(2)]
+			const float32 value = glm::clamp((components[i] * sign * SQRT_2 + 1.0f) * 0.5f, 0.0f, 1.0f);
+			result[j++] = static_cast<uint16>(std::round(value * 32767.0f));
+		}
+	}
+
+	// Index of the dropped component goes in the top bits of the first two values
+	result[0] |= static_cast<uint16>((largest & 1) << 15);
+	result[1] |= static_cast<uint16>((largest >> 1) << 15);
+}
+
+glm::quat BakedAnimation::decompress(const uint16* compressed)
+{
+	const uint32 largest = (compressed[0] >> 15) | ((compressed[1] >> 15) << 1);
+
+	float32 components[4];
+	float32 sumOfSquares = 0.0f;
+
+	uint32 j = 0;
+	for (uint32 i = 0; i < 4; ++i)
+	{
+		if (i != largest)
+		{
+			const float32 value = static_cast<float32>(compressed[j++] & 0x7FFF) / 32767.0f;
+			components[i] = (value * 2.0f - 1.0f) / SQRT_2;
+			sumOfSquares += components[i] * components[i];
+		}
+	}
+
+	components[largest] = std::sqrt(std::max(0.0f, 1.0f - sumOfSquares));
+
+	return glm::quat(components[3], components[0], components[1], components[2]);
+}
+
+glm::mat4 BakedAnimation::sample(const uint32 track, const std::chrono::duration<float32> animationTime) const
+{
+	const float32 position = std::max(0.0f, animationTime.count() / ticksPerSample_);
+
+	const uint32 index = std::min(static_cast<uint32>(position), numberOfSamples_ - 1);
+	const uint32 nextIndex = std::min(index + 1, numberOfSamples_ - 1);
+	const float32 factor = glm::clamp(position - static_cast<float32>(index), 0.0f, 1.0f);
+
+	const uint32 numberOfTracks = static_cast<uint32>(tracks_.size());
+	const QuantizedPose& a = poses_[index * numberOfTracks + track];
+	const QuantizedPose& b = poses_[nextIndex * numberOfTracks + track];
+	const Track& t = tracks_[track];
+
+	const glm::vec3 translationA = dequantize(a.translation, t.translationMinimum, t.translationExtent);
+	const glm::vec3 translationB = dequantize(b.translation, t.translationMinimum, t.translationExtent);
+	const glm::vec3 scalingA = dequantize(a.scaling, t.scalingMinimum, t.scalingExtent);
+	const glm::vec3 scalingB = dequantize(b.scaling, t.scalingMinimum, t.scalingExtent);
+
+	const glm::quat rotationA = decompress(a.rotation);
+	glm::quat rotationB = decompress(b.rotation);
+
+	// Samples are close together, so a normalized lerp (along the shortest path) is indistinguishable from a slerp
+	if (glm::dot(rotationA, rotationB) < 0.0f)
+	{
+		rotationB = -rotationB;
+	}
+
+	const glm::quat rotation = glm::normalize(rotationA * (1.0f - factor) + rotationB * factor);
+	const glm::vec3 translation = translationA + factor * (translationB - translationA);
+	const glm::vec3 scaling = scalingA + factor * (scalingB - scalingA);
+
+	// translation * rotation * scaling
+	glm::mat4 result = glm::mat4_cast(rotation);
+	result[0] *= scaling.x;
+	result[1] *= scaling.y;
+	result[2] *= scaling.z;
+	result[3] = glm::vec4(translation, 1.0f);
+
+	return result;
+}
+
+void BakedAnimation::readNodeHeirarchy(
+	glm::mat4* transformations,
+	const std::chrono::duration<float32> animationTime,
+	const glm::mat4& globalInverseTransformation,
+	const BoneNode& rootBoneNode,
+	const BoneData& boneData,
+	const uint32 startFrame,
+	const uint32 endFrame,
+	const glm::mat4& parentTransformation,
+	const uint32 depth,
+	const uint32 maxAnimatedDepth
+) const
+{
+	glm::mat4 nodeTransformation = rootBoneNode.transformation;
+
+	if (depth <= maxAnimatedDepth)
+	{
+		const auto it = trackIndices_.find(rootBoneNode.name);
+
+		if (it != trackIndices_.end())
+		{
+			const Track& track = tracks_[it->second];
+
+			// Matches the non baked animation - bones without the start and end frame keep their rest transformation
+			if ((startFrame == 0 && endFrame == 0) || (startFrame < track.numberOfPositionKeyFrames && endFrame < track.numberOfPositionKeyFrames))
+			{
+				nodeTransformation = sample(it->second, animationTime);
+			}
+		}
+	}
+
+	const glm::mat4 globalTransformation = parentTransformation * nodeTransformation;
+
+	{
+		const auto it = boneData.boneIndexMap.find(rootBoneNode.name);
+
+		if (it != boneData.boneIndexMap.end())
+		{
+			const uint32 boneIndex = it->second;
+			transformations[boneIndex] = globalInverseTransformation * globalTransformation * boneData.boneTransform[boneIndex].inverseModelSpacePoseTransform;
+		}
+	}
+
+	for (const auto& boneNode : rootBoneNode.children)
+	{
+		readNodeHeirarchy(transformations, animationTime, globalInverseTransformation, boneNode, boneData, startFrame, endFrame, globalTransformation, depth + 1, maxAnimatedDepth);
+	}
+}
+
+}
@@ -41,6 +41,7 @@
 #include "SplatMap.hpp"
 #include "DisplacementMap.hpp"
 #include "Heightfield.hpp"
+#include "HeightGrid.hpp"
 #include "PathfindingTerrain.hpp"
 
 #include "scripting/IScriptingEngine.hpp"
@@ -88,8 +89,12 @@ static void InitConstructorPbrMaterial(PbrMaterial* memory, IImage* albedo, IIma
 static void InitConstructorHeightMap(HeightMap* memory, const IImage& image) { new(memory) HeightMap(image); }
 static void InitConstructorHeightMap(HeightMap* memory, const std::vector<uint8>& imageData, const uint32 width, const uint32 height) { new(memory) HeightMap(imageData, width, height); }
 static void InitConstructorSplatMap(SplatMap* memory, std::vector<PbrMaterial> materialMap, IImage* terrainMap) { new(memory) SplatMap(std::move(materialMap), terrainMap); }
+static void InitConstructorHeightGrid(HeightGrid* memory, const IImage& image) { new(memory) HeightGrid(image); }
 static void InitConstructorHeightfield(Heightfield* memory, const IImage& image) { new(memory) Heightfield(image); }
+static void InitConstructorHeightfield(Heightfield* memory, const HeightGrid& heightGrid) { new(memory) Heightfield(heightGrid); }
 static void InitConstructorPathfindingTerrain(PathfindingTerrain* memory, const HeightMap& heightMap) { new(memory) PathfindingTerrain(heightMap); }
+static void InitConstructorPathfindingTerrain(PathfindingTerrain* memory, const HeightGrid& heightGrid) { new(memory) PathfindingTerrain(heightGrid); }
+static void InitConstructorPathfindingTerrain(PathfindingTerrain* memory, const HeightGrid& heightGrid, const float32 maximumError) { new(memory) PathfindingTerrain(heightGrid, maximumError); }
 static void InitConstructorMesh(Mesh* memory, std::string name, std::vector< glm::vec3 > vertices, std::vector< uint32 > indices, std::vector< glm::vec4 > colors, std::vector< glm::vec3 > normals, std::vector< glm::vec2 > textureCoordinates, VertexBoneData vertexBoneData = VertexBoneData(), BoneData boneData = BoneData()) { new(memory) Mesh(name, vertices, indices, colors, normals, textureCoordinates, vertexBoneData, boneData); }
 static void InitConstructorTexture(Texture* memory, std::string name, IImage* image) { new(memory) Texture(name, image); }
 
@@ -466,16 +471,30 @@ void BindingDelegate::bind()
 	scriptingEngine_->registerObjectBehaviour("DisplacementMap", asBEHAVE_CONSTRUCT, "void f(const DisplacementMap& in)", asFUNCTION(CopyConstructor<DisplacementMap>), asCALL_CDECL_OBJFIRST);
 	scriptingEngine_->registerObjectBehaviour("DisplacementMap", asBEHAVE_DESTRUCT, "void f()", asFUNCTION(DefaultDestructor<DisplacementMap>), asCALL_CDECL_OBJFIRST);
 
+	scriptingEngine_->registerObjectType("HeightGrid", sizeof(HeightGrid), asOBJ_VALUE | asGetTypeTraits<HeightGrid>());
+	scriptingEngine_->registerObjectBehaviour("HeightGrid", asBEHAVE_CONSTRUCT, "void f()", asFUNCTION(DefaultConstructor<HeightGrid>), asCALL_CDECL_OBJFIRST);
+	scriptingEngine_->registerObjectBehaviour("HeightGrid", asBEHAVE_CONSTRUCT, "void f(const IImage& in)", asFUNCTION(InitConstructorHeightGrid), asCALL_CDECL_OBJFIRST);
+	scriptingEngine_->registerObjectBehaviour("HeightGrid", asBEHAVE_CONSTRUCT, "void f(const HeightGrid& in)", asFUNCTION(CopyConstructor<HeightGrid>), asCALL_CDECL_OBJFIRST);
+	scriptingEngine_->registerObjectBehaviour("HeightGrid", asBEHAVE_DESTRUCT, "void f()", asFUNCTION(DefaultDestructor<HeightGrid>), asCALL_CDECL_OBJFIRST);
+    scriptingEngine_->registerClassMethod("HeightGrid", "HeightGrid& opAssign(const HeightGrid& in)", asMETHODPR(HeightGrid, operator=, (const HeightGrid&), HeightGrid&));
+    scriptingEngine_->registerClassMethod("HeightGrid", "uint32 width() const", asMETHOD(HeightGrid, width));
+    scriptingEngine_->registerClassMethod("HeightGrid", "uint32 length() const", asMETHOD(HeightGrid, length));
+    scriptingEngine_->registerClassMethod("HeightGrid", "float sampleBilinear(const float, const float) const", asMETHODPR(HeightGrid, sampleBilinear, (const float32, const float32) const, float32));
+    scriptingEngine_->registerClassMethod("HeightGrid", "float sampleBicubic(const float, const float) const", asMETHODPR(HeightGrid, sampleBicubic, (const float32, const float32) const, float32));
+
 	scriptingEngine_->registerObjectType("Heightfield", sizeof(Heightfield), asOBJ_VALUE | asGetTypeTraits<Heightfield>());
 	scriptingEngine_->registerObjectBehaviour("Heightfield", asBEHAVE_CONSTRUCT, "void f()", asFUNCTION(DefaultConstructor<Heightfield>), asCALL_CDECL_OBJFIRST);
-	scriptingEngine_->registerObjectBehaviour("Heightfield", asBEHAVE_CONSTRUCT, "void f(const IImage& in)", asFUNCTION(InitConstructorHeightfield), asCALL_CDECL_OBJFIRST);
+	scriptingEngine_->registerObjectBehaviour("Heightfield", asBEHAVE_CONSTRUCT, "void f(const IImage& in)", asFUNCTIONPR(InitConstructorHeightfield, (Heightfield*, const IImage&), void), asCALL_CDECL_OBJFIRST);
+	scriptingEngine_->registerObjectBehaviour("Heightfield", asBEHAVE_CONSTRUCT, "void f(const HeightGrid& in)", asFUNCTIONPR(InitConstructorHeightfield, (Heightfield*, const HeightGrid&), void), asCALL_CDECL_OBJFIRST);
 	scriptingEngine_->registerObjectBehaviour("Heightfield", asBEHAVE_CONSTRUCT, "void f(const Heightfield& in)", asFUNCTION(CopyConstructor<Heightfield>), asCALL_CDECL_OBJFIRST);
 	scriptingEngine_->registerObjectBehaviour("Heightfield", asBEHAVE_DESTRUCT, "void f()", asFUNCTION(DefaultDestructor<Heightfield>), asCALL_CDECL_OBJFIRST);
     scriptingEngine_->registerClassMethod("Heightfield", "Heightfield& opAssign(const Heightfield& in)", asMETHOD(Heightfield, operator=));
 
 	scriptingEngine_->registerObjectType("PathfindingTerrain", sizeof(PathfindingTerrain), asOBJ_VALUE | asGetTypeTraits<PathfindingTerrain>());
 	scriptingEngine_->registerObjectBehaviour("PathfindingTerrain", asBEHAVE_CONSTRUCT, "void f()", asFUNCTION(DefaultConstructor<PathfindingTerrain>), asCALL_CDECL_OBJFIRST);
-	scriptingEngine_->registerObjectBehaviour("PathfindingTerrain", asBEHAVE_CONSTRUCT, "void f(const HeightMap& in)", asFUNCTION(InitConstructorPathfindingTerrain), asCALL_CDECL_OBJFIRST);
+	scriptingEngine_->registerObjectBehaviour("PathfindingTerrain", asBEHAVE_CONSTRUCT, "void f(const HeightMap& in)", asFUNCTIONPR(InitConstructorPathfindingTerrain, (PathfindingTerrain*, const HeightMap&), void), asCALL_CDECL_OBJFIRST);
+	scriptingEngine_->registerObjectBehaviour("PathfindingTerrain", asBEHAVE_CONSTRUCT, "void f(const HeightGrid& in)", asFUNCTIONPR(InitConstructorPathfindingTerrain, (PathfindingTerrain*, const HeightGrid&), void), asCALL_CDECL_OBJFIRST);
+	scriptingEngine_->registerObjectBehaviour("PathfindingTerrain", asBEHAVE_CONSTRUCT, "void f(const HeightGrid& in, float)", asFUNCTIONPR(InitConstructorPathfindingTerrain, (PathfindingTerrain*, const HeightGrid&, const float32), void), asCALL_CDECL_OBJFIRST);
 	scriptingEngine_->registerObjectBehaviour("PathfindingTerrain", asBEHAVE_CONSTRUCT, "void f(const PathfindingTerrain& in)", asFUNCTION(CopyConstructor<PathfindingTerrain>), asCALL_CDECL_OBJFIRST);
 	scriptingEngine_->registerObjectBehaviour("PathfindingTerrain", asBEHAVE_DESTRUCT, "void f()", asFUNCTION(DefaultDestructor<PathfindingTerrain>), asCALL_CDECL_OBJFIRST);
     scriptingEngine_->registerClassMethod("PathfindingTerrain", "PathfindingTerrain& opAssign(const PathfindingTerrain& in)", asMETHOD(PathfindingTerrain, operator=));
@@ -547,6 +566,9 @@ void BindingDelegate::bind()
 
 //    registerUnorderedMapBindings<std::string, std::string>(scriptingEngine_, "unordered_mapStringString", "string", "string");
 
+	// Scene methods take a Noise (i.e. createStreamingTerrain), so the type has to exist before they're registered
+	scriptingEngine_->registerObjectType("Noise", sizeof(noise::Noise), asOBJ_VALUE | asOBJ_POD | asOBJ_APP_CLASS_ALLFLOATS | asGetTypeTraits<noise::Noise>());
+
 	scriptingEngine_->registerObjectType("Scene", 0, asOBJ_REF | asOBJ_NOCOUNT);
 	auto entityBindingDelegate = EntityBindingDelegate(logger_, scriptingEngine_, gameEngine_);
 	entityBindingDelegate.bind();
@@ -560,13 +582,36 @@ void BindingDelegate::bind()
 	scriptingEngine_->registerInterfaceMethod("IScriptObject", "void serialize(Entity)");
 	scriptingEngine_->registerInterfaceMethod("IScriptObject", "void deserialize(Entity)");
 
-	scriptingEngine_->registerObjectType("Noise", sizeof(noise::Noise), asOBJ_VALUE | asOBJ_POD | asOBJ_APP_CLASS_ALLFLOATS | asGetTypeTraits<noise::Noise>());
 	scriptingEngine_->registerClassMethod(
 		"Noise",
 		"float getValue(const float, const float) const",
 		asMETHODPR(noise::Noise, getValue, (const float32, const float32) const, float32)
 	);
 
+	scriptingEngine_->registerEnum("NoiseType");
+	scriptingEngine_->registerEnumValue("NoiseType", "NOISE_VALUE", FastNoise::Value);
+	scriptingEngine_->registerEnumValue("NoiseType", "NOISE_VALUE_FRACTAL", FastNoise::ValueFractal);
+	scriptingEngine_->registerEnumValue("NoiseType", "NOISE_PERLIN", FastNoise::Perlin);
+	scriptingEngine_->registerEnumValue("NoiseType", "NOISE_PERLIN_FRACTAL", FastNoise::PerlinFractal);
+	scriptingEngine_->registerEnumValue("NoiseType", "NOISE_SIMPLEX", FastNoise::Simplex);
+	scriptingEngine_->registerEnumValue("NoiseType", "NOISE_SIMPLEX_FRACTAL", FastNoise::SimplexFractal);
+	scriptingEngine_->registerEnumValue("NoiseType", "NOISE_CELLULAR", FastNoise::Cellular);
+	scriptingEngine_->registerEnumValue("NoiseType", "NOISE_WHITE_NOISE", FastNoise::WhiteNoise);
+	scriptingEngine_->registerEnumValue("NoiseType", "NOISE_CUBIC", FastNoise::Cubic);
+	scriptingEngine_->registerEnumValue("NoiseType", "NOISE_CUBIC_FRACTAL", FastNoise::CubicFractal);
+
+	scriptingEngine_->registerClassMethod(
+		"Noise",
+		"float getNoise(const float, const float) const",
+		asMETHODPR(noise::Noise, getNoise, (const float32, const float32) const, float32)
+	);
+	scriptingEngine_->registerClassMethod("Noise", "void setNoiseType(const NoiseType)", asMETHOD(noise::Noise, setNoiseType));
+	scriptingEngine_->registerClassMethod("Noise", "NoiseType getNoiseType() const", asMETHOD(noise::Noise, getNoiseType));
+	scriptingEngine_->registerClassMethod("Noise", "void setFrequency(const float)", asMETHOD(noise::Noise, setFrequency));
+	scriptingEngine_->registerClassMethod("Noise", "float getFrequency() const", asMETHOD(noise::Noise, getFrequency));
+	scriptingEngine_->registerClassMethod("Noise", "void setFractalOctaves(const int32)", asMETHOD(noise::Noise, setFractalOctaves));
+	scriptingEngine_->registerClassMethod("Noise", "int32 getFractalOctaves() const", asMETHOD(noise::Noise, getFractalOctaves));
+
 	// ILogger bindings
 	scriptingEngine_->registerObjectType("ILogger", 0, asOBJ_REF | asOBJ_NOCOUNT);
 	scriptingEngine_->registerGlobalProperty("ILogger logger", logger_);
@@ -635,6 +680,17 @@ void BindingDelegate::bind()
 	scriptingEngine_->registerObjectType("EngineStatistics", 0, asOBJ_REF | asOBJ_NOCOUNT);
 	scriptingEngine_->registerObjectProperty("EngineStatistics", "float fps", asOFFSET(EngineStatistics, fps));
 	scriptingEngine_->registerObjectProperty("EngineStatistics", "chrono::durationFloat renderTime", asOFFSET(EngineStatistics, renderTime));
+	scriptingEngine_->registerObjectProperty("EngineStatistics", "uint32 ticks", asOFFSET(EngineStatistics, ticks));
+	scriptingEngine_->registerObjectProperty("EngineStatistics", "float droppedTime", asOFFSET(EngineStatistics, droppedTime));
+
+	scriptingEngine_->registerObjectType("ProfileZoneStatistics", 0, asOBJ_REF | asOBJ_NOCOUNT);
+	scriptingEngine_->registerObjectProperty("ProfileZoneStatistics", "uint32 count", asOFFSET(ProfileZoneStatistics, count));
+	scriptingEngine_->registerObjectProperty("ProfileZoneStatistics", "float mean", asOFFSET(ProfileZoneStatistics, mean));
+	scriptingEngine_->registerObjectProperty("ProfileZoneStatistics", "float minimum", asOFFSET(ProfileZoneStatistics, minimum));
+	scriptingEngine_->registerObjectProperty("ProfileZoneStatistics", "float maximum", asOFFSET(ProfileZoneStatistics, maximum));
+	scriptingEngine_->registerObjectProperty("ProfileZoneStatistics", "float median", asOFFSET(ProfileZoneStatistics, median));
+	scriptingEngine_->registerObjectProperty("ProfileZoneStatistics", "float percentile95", asOFFSET(ProfileZoneStatistics, percentile95));
+	scriptingEngine_->registerObjectProperty("ProfileZoneStatistics", "float percentile99", asOFFSET(ProfileZoneStatistics, percentile99));
 
 	// IDebugRenderer
 	scriptingEngine_->registerObjectType("IDebugRenderer", 0, asOBJ_REF | asOBJ_NOCOUNT);
@@ -653,6 +709,66 @@ void BindingDelegate::bind()
 		asCALL_THISCALL_ASGLOBAL,
 		gameEngine_
 	);
+	scriptingEngine_->registerGlobalFunction(
+		"const ProfileZoneStatistics@ getProfileZoneStatistics(const string& in)",
+		asMETHODPR(GameEngine, getProfileZoneStatistics, (const std::string&) const, const ProfileZoneStatistics&),
+		asCALL_THISCALL_ASGLOBAL,
+		gameEngine_
+	);
+	scriptingEngine_->registerGlobalFunction(
+		"void setProfilerEnabled(const bool)",
+		asMETHODPR(GameEngine, setProfilerEnabled, (const bool), void),
+		asCALL_THISCALL_ASGLOBAL,
+		gameEngine_
+	);
+	scriptingEngine_->registerGlobalFunction(
+		"bool profilerEnabled()",
+		asMETHODPR(GameEngine, profilerEnabled, () const, bool),
+		asCALL_THISCALL_ASGLOBAL,
+		gameEngine_
+	);
+	scriptingEngine_->registerGlobalFunction(
+		"void exportProfile(const string& in)",
+		asMETHODPR(GameEngine, exportProfile, (const std::string&) const, void),
+		asCALL_THISCALL_ASGLOBAL,
+		gameEngine_
+	);
+	scriptingEngine_->registerGlobalFunction(
+		"void incrementCounter(const string& in, const uint64 = 1)",
+		asMETHODPR(GameEngine, incrementCounter, (const std::string&, const uint64), void),
+		asCALL_THISCALL_ASGLOBAL,
+		gameEngine_
+	);
+	scriptingEngine_->registerGlobalFunction(
+		"uint64 getCounter(const string& in)",
+		asMETHODPR(GameEngine, getCounter, (const std::string&) const, uint64),
+		asCALL_THISCALL_ASGLOBAL,
+		gameEngine_
+	);
+	scriptingEngine_->registerGlobalFunction(
+		"void setGauge(const string& in, const int64)",
+		asMETHODPR(GameEngine, setGauge, (const std::string&, const int64), void),
+		asCALL_THISCALL_ASGLOBAL,
+		gameEngine_
+	);
+	scriptingEngine_->registerGlobalFunction(
+		"int64 getGauge(const string& in)",
+		asMETHODPR(GameEngine, getGauge, (const std::string&) const, int64),
+		asCALL_THISCALL_ASGLOBAL,
+		gameEngine_
+	);
+	scriptingEngine_->registerGlobalFunction(
+		"void recordHistogram(const string& in, const uint64)",
+		asMETHODPR(GameEngine, recordHistogram, (const std::string&, const uint64), void),
+		asCALL_THISCALL_ASGLOBAL,
+		gameEngine_
+	);
+	scriptingEngine_->registerGlobalFunction(
+		"void dumpMetrics()",
+		asMETHODPR(GameEngine, dumpMetrics, () const, void),
+		asCALL_THISCALL_ASGLOBAL,
+		gameEngine_
+	);
 	scriptingEngine_->registerGlobalFunction(
 		"void setIGameInstance(IGame@)",
 		asMETHODPR(GameEngine, setIGameInstance, (void*), void),
@@ -0,0 +1,216 @@
+#include <cstring>
+#include <algorithm>
+
+#include "BlockCompressor.hpp"
+
+#include "exceptions/RuntimeException.hpp"
+
+namespace ice_engine
+{
+namespace
+{
+
+const size_t MIN_MATCH = 4;
+
+// The format requires the last 5 bytes to be literals, and the last match to start at least 12 bytes before the end
+const size_t LAST_LITERALS = 5;
+const size_t MATCH_FIND_LIMIT = 12;
+
+const size_t MAX_OFFSET = 65535;
+
+const uint32 HASH_BITS = 16;
+
+uint32 read32(const byte* data)
+{
+	uint32 value;
+	std::memcpy(&value, data, sizeof(value));
+
+	return value;
+}
+
+uint32 hash(const uint32 sequence)
+{
+	return (sequence * 2654435761u) >> (32 - HASH_BITS);
+}
+
+void writeLength(std::vector<byte>& destination, size_t length)
+{
+	while (length >= 255)
+	{
+		destination.push_back(255);
+		length -= 255;
+	}
+
+	destination.push_back(static_cast<byte>(length));
+}
+
+void writeSequence(std::vector<byte>& destination, const byte* literals, const size_t numberOfLiterals, const size_t offset, const size_t matchLength)
+{
+	const size_t matchCode = (matchLength > 0 ? matchLength - MIN_MATCH : 0);
+
+	const byte token = static_cast<byte>((std::min<size_t>(numberOfLiterals, 15) << 4) | std::min<size_t>(matchCode, 15));
+	destination.push_back(token);
+
+	if (numberOfLiterals >= 15)
+	{
+		writeLength(destination, numberOfLiterals - 15);
+	}
+
+	destination.insert(destination.end(), literals, literals + numberOfLiterals);
+
+	// The last sequence is literals only
+	if (matchLength == 0)
+	{
+		return;
+	}
+
+	destination.push_back(static_cast<byte>(offset & 0xFF));
+	destination.push_back(static_cast<byte>((offset >> 8) & 0xFF));
+
+	if (matchCode >= 15)
+	{
+		writeLength(destination, matchCode - 15);
+	}
+}
+
+size_t readLength(const byte*& source, const byte* sourceEnd, size_t length)
+{
+	if (length != 15)
+	{
+		return length;
+	}
+
+	byte value;
+	do
+	{
+		if (source >= sourceEnd)
+		{
+			throw RuntimeException("Compressed block is truncated.");
+		}
+
+		value = *source++;
+		length += value;
+	}
+	while (value == 255);
+
+	return length;
+}
+
+}
+
+std::vector<byte> BlockCompressor::compress(const byte* source, const size_t size)
+{
+	std::vector<byte> destination;
+	destination.reserve(compressBound(size));
+
+	size_t anchor = 0;
+
+	if (size > MATCH_FIND_LIMIT)
+	{
+		std::vector<uint32> hashTable(1 << HASH_BITS, 0);
+
+		const size_t matchLimit = size - LAST_LITERALS;
+		size_t i = 0;
+
+		while (i + MATCH_FIND_LIMIT <= size)
+		{
+			const uint32 sequence = read32(source + i);
+			const uint32 h = hash(sequence);
+			const size_t candidate = hashTable[h];
+			hashTable[h] = static_cast<uint32>(i);
+
+			// The hash table starts out full of 0's, so a candidate is only a match if the bytes actually match
+			if (candidate < i && i - candidate <= MAX_OFFSET && read32(source + candidate) == sequence)
+			{
+				size_t matchLength = MIN_MATCH;
+				while (i + matchLength < matchLimit && source[candidate + matchLength] == source[i + matchLength])
+				{
+					++matchLength;
+				}
+
+				writeSequence(destination, source + anchor, i - anchor, i - candidate, matchLength);
+
+				i += matchLength;
+				anchor = i;
+			}
+			else
+			{
+				++i;
+			}
+		}
+	}
+
+	writeSequence(destination, source + anchor, size - anchor, 0, 0);
+
+	return destination;
+}
+
+void BlockCompressor::decompress(const byte* source, const size_t sourceSize, byte* destination, const size_t destinationSize)
+{
+	const byte* sourceEnd = source + sourceSize;
+	byte* destinationStart = destination;
+	byte* destinationEnd = destination + destinationSize;
+
+	while (source < sourceEnd)
+	{
+		const byte token = *source++;
+
+		const size_t numberOfLiterals = readLength(source, sourceEnd, token >> 4);
+
+		if (numberOfLiterals > static_cast<size_t>(sourceEnd - source) || numberOfLiterals > static_cast<size_t>(destinationEnd - destination))
+		{
+			throw RuntimeException("Compressed block literals run past the end of the block.");
+		}
+
+		std::memcpy(destination, source, numberOfLiterals);
+		source += numberOfLiterals;
+		destination += numberOfLiterals;
+
+		// The last sequence has no match
+		if (source == sourceEnd)
+		{
+			break;
+		}
+
+		if (sourceEnd - source < 2)
+		{
+			throw RuntimeException("Compressed block is truncated.");
+		}
+
+		const size_t offset = source[0] | (source[1] << 8);
+		source += 2;
+
+		const size_t matchLength = readLength(source, sourceEnd, token & 0x0F) + MIN_MATCH;
+
+		if (offset == 0 || offset > static_cast<size_t>(destination - destinationStart))
+		{
+			throw RuntimeException("Compressed block has an invalid match offset.");
+		}
+
+		if (matchLength > static_cast<size_t>(destinationEnd - destination))
+		{
+			throw RuntimeException("Compressed block match runs past the end of the destination.");
+		}
+
+		// Matches can overlap the bytes they produce, so copy byte by byte
+		const byte* match = destination - offset;
+		for (size_t i = 0; i < matchLength; ++i)
+		{
+			destination[i] = match[i];
+		}
+
+		destination += matchLength;
+	}
+
+	if (destination != destinationEnd)
+	{
+		throw RuntimeException("Compressed block is smaller than expected.");
+	}
+}
+
+size_t BlockCompressor::compressBound(const size_t size)
+{
+	return size + size / 255 + 16;
+}
+
+}
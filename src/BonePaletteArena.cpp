@@ -0,0 +1,83 @@
+#include <algorithm>
+
+#include "BonePaletteArena.hpp"
+
+namespace ice_engine
+{
+
+constexpr uint32 BonePaletteArena::NUMBER_OF_FRAMES;
+
+BonePaletteArena::BonePaletteArena(const uint32 capacity)
+{
+	for (auto& frame : frames_)
+	{
+		frame.buffer.resize(capacity);
+	}
+}
+
+void BonePaletteArena::beginFrame()
+{
+	const uint64 next = frame_.load() + 1;
+	Frame& frame = frames_[next % NUMBER_OF_FRAMES];
+
+	// Nothing can reference this frame's storage anymore, so it's safe to grow it to fit everything that was allocated last time
+	if (frame.offset.load() > frame.buffer.size())
+	{
+		frame.buffer.resize(frame.offset.load());
+		frame.overflow.clear();
+	}
+
+	frame.offset = 0;
+
+	frame_ = next;
+}
+
+BonePaletteArena::Palette BonePaletteArena::allocate(const uint32 size)
+{
+	const uint64 currentFrame = frame_.load();
+	Frame& frame = frames_[currentFrame % NUMBER_OF_FRAMES];
+
+	Palette palette;
+	palette.size = size;
+	palette.frame = currentFrame;
+
+	const uint32 offset = frame.offset.fetch_add(size);
+
+	if (offset + size <= frame.buffer.size())
+	{
+		palette.transformations = &frame.buffer[offset];
+	}
+	else
+	{
+		std::lock_guard<std::mutex> lockGuard(frame.overflowMutex);
+
+		frame.overflow.push_back(std::unique_ptr<glm::mat4[]>(new glm::mat4[size]));
+
+		palette.transformations = frame.overflow.back().get();
+	}
+
+	std::fill(palette.transformations, palette.transformations + size, glm::mat4(1.0f));
+
+	return palette;
+}
+
+bool BonePaletteArena::valid(const Palette& palette) const
+{
+	return (frame_.load() - palette.frame) < NUMBER_OF_FRAMES;
+}
+
+uint64 BonePaletteArena::frame() const
+{
+	return frame_.load();
+}
+
+uint32 BonePaletteArena::overflows() const
+{
+	const Frame& frame = frames_[frame_.load() % NUMBER_OF_FRAMES];
+
+	std::lock_guard<std::mutex> lockGuard(frame.overflowMutex);
+
+	return static_cast<uint32>(frame.overflow.size());
+}
+
+}
@@ -175,8 +175,7 @@ void EntityBindingDelegate::bind()
 			{"chrono::durationFloat runningTime", asOFFSET(ecs::AnimationComponent, runningTime)},
 			{"float speed", asOFFSET(ecs::AnimationComponent, speed)},
 			{"uint32 startFrame", asOFFSET(ecs::AnimationComponent, startFrame)},
-			{"uint32 endFrame", asOFFSET(ecs::AnimationComponent, endFrame)},
-			{"vectorMat4 transformations", asOFFSET(ecs::AnimationComponent, transformations)}
+			{"uint32 endFrame", asOFFSET(ecs::AnimationComponent, endFrame)}
 		},
 		"AnimationHandle"
 	);
@@ -277,6 +276,16 @@ void EntityBindingDelegate::bind()
             "unordered_mapStringString"
     );
 
+	registerComponent<ecs::ReplicatedComponent, uint32, std::vector<uint8>>(
+		scriptingEngine_,
+		"ReplicatedComponent",
+		{
+			{"uint32 networkId", asOFFSET(ecs::ReplicatedComponent, networkId)},
+			{"vectorUInt8 custom", asOFFSET(ecs::ReplicatedComponent, custom)}
+		},
+		"uint32, vectorUInt8"
+	);
+
 	registerComponent<ecs::PersistableComponent>(
 		scriptingEngine_,
 		"PersistableComponent",
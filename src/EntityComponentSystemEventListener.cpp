@@ -14,6 +14,9 @@ EntityComponentSystemEventListener::EntityComponentSystemEventListener(Scene& sc
 	entityComponentSystem.subscribe<entityx::EntityDestroyedEvent>(*this);
 	entityComponentSystem.subscribe<entityx::ComponentAddedEvent<ecs::GraphicsComponent>>(*this);
 	entityComponentSystem.subscribe<entityx::ComponentRemovedEvent<ecs::GraphicsComponent>>(*this);
+	entityComponentSystem.subscribe<entityx::ComponentRemovedEvent<ecs::GraphicsTerrainComponent>>(*this);
+	entityComponentSystem.subscribe<entityx::ComponentAddedEvent<ecs::PositionComponent>>(*this);
+	entityComponentSystem.subscribe<entityx::ComponentRemovedEvent<ecs::PositionComponent>>(*this);
 	entityComponentSystem.subscribe<entityx::ComponentRemovedEvent<ecs::AnimationComponent>>(*this);
 	entityComponentSystem.subscribe<entityx::ComponentRemovedEvent<ecs::RigidBodyObjectComponent>>(*this);
 	entityComponentSystem.subscribe<entityx::ComponentRemovedEvent<ecs::GhostObjectComponent>>(*this);
@@ -45,6 +48,21 @@ void EntityComponentSystemEventListener::receive(const entityx::ComponentRemoved
 	if (event.component->renderableHandle) scene_.destroy(event.component->renderableHandle);
 }
 
+void EntityComponentSystemEventListener::receive(const entityx::ComponentRemovedEvent<ecs::GraphicsTerrainComponent>& event)
+{
+	if (event.component->terrainRenderableHandle) scene_.destroy(event.component->terrainRenderableHandle);
+}
+
+void EntityComponentSystemEventListener::receive(const entityx::ComponentAddedEvent<ecs::PositionComponent>& event)
+{
+	scene_.spatialIndex().update(event.entity.id().id(), event.component->position);
+}
+
+void EntityComponentSystemEventListener::receive(const entityx::ComponentRemovedEvent<ecs::PositionComponent>& event)
+{
+	scene_.spatialIndex().remove(event.entity.id().id());
+}
+
 void EntityComponentSystemEventListener::receive(const entityx::ComponentRemovedEvent<ecs::AnimationComponent>& event)
 {
 	if (event.component->bonesHandle)
@@ -181,6 +181,10 @@ const FN_DECIMAL CELL_3D_Z[] =
 	FN_DECIMAL(0.615630723), FN_DECIMAL(0.3430367014), FN_DECIMAL(0.8193658136), FN_DECIMAL(-0.5829600957), FN_DECIMAL(0.07911697781), FN_DECIMAL(0.7854296063), FN_DECIMAL(-0.4107442306), FN_DECIMAL(0.4766964066), FN_DECIMAL(-0.9045999527), FN_DECIMAL(-0.1673856787), FN_DECIMAL(0.2828077348), FN_DECIMAL(-0.5902737632), FN_DECIMAL(-0.321506229), FN_DECIMAL(-0.5224513133), FN_DECIMAL(-0.4090169985), FN_DECIMAL(-0.3599685311),
 };
 
+const FN_DECIMAL* FastNoise::GetValueLookupTable() { return VAL_LUT; }
+const FN_DECIMAL* FastNoise::GetGradientTableX() { return GRAD_X; }
+const FN_DECIMAL* FastNoise::GetGradientTableY() { return GRAD_Y; }
+
 static int FastFloor(FN_DECIMAL f) { return (f >= 0 ? (int)f : (int)f - 1); }
 static int FastRound(FN_DECIMAL f) { return (f >= 0) ? (int)(f + FN_DECIMAL(0.5)) : (int)(f - FN_DECIMAL(0.5)); }
 static int FastAbs(int i) { return abs(i); }
@@ -30,8 +30,18 @@
 #include "graphics/Event.hpp"
 
 #include "logger/Logger.hpp"
+#include "logger/AsyncLogger.hpp"
 #include "fs/FileSystem.hpp"
+#include "graphics/NullGraphicsEngine.hpp"
+#include "audio/NullAudioEngine.hpp"
+#include "networking/NullNetworkingEngine.hpp"
+#include "networking/CountingNetworkingEngine.hpp"
+#include "physics/StubPhysicsEngine.hpp"
+#include "pathfinding/NullPathfindingEngine.hpp"
 #include "Image.hpp"
+#include "Profiler.hpp"
+#include "Metrics.hpp"
+#include "InitializationGraph.hpp"
 
 #include "resources/EngineResourceManager.MeshHandle.hpp"
 #include "resources/EngineResourceManager.TextureHandle.hpp"
@@ -130,6 +140,64 @@ const EngineStatistics& GameEngine::getEngineStatistics() const
 	return engineStatistics_;
 }
 
+const ProfileZoneStatistics& GameEngine::getProfileZoneStatistics(const std::string& name) const
+{
+	return Profiler::instance().statistics(name);
+}
+
+void GameEngine::setProfilerEnabled(const bool enabled)
+{
+	Profiler::instance().setEnabled(enabled);
+}
+
+bool GameEngine::profilerEnabled() const
+{
+	return Profiler::instance().enabled();
+}
+
+void GameEngine::exportProfile(const std::string& filename) const
+{
+	LOG_INFO(logger_, "Exporting profile to file %s", filename);
+
+	auto file = fileSystem_->open(filename, fs::FileFlags::WRITE);
+
+	Profiler::instance().exportChromeTrace(file->getOutputStream());
+}
+
+void GameEngine::incrementCounter(const std::string& name, const uint64 value)
+{
+	Metrics::instance().counter(name).increment(value);
+}
+
+uint64 GameEngine::getCounter(const std::string& name) const
+{
+	return Metrics::instance().counter(name).value();
+}
+
+void GameEngine::setGauge(const std::string& name, const int64 value)
+{
+	Metrics::instance().gauge(name).set(value);
+}
+
+int64 GameEngine::getGauge(const std::string& name) const
+{
+	return Metrics::instance().gauge(name).value();
+}
+
+void GameEngine::recordHistogram(const std::string& name, const uint64 value)
+{
+	Metrics::instance().histogram(name).record(value);
+}
+
+void GameEngine::dumpMetrics() const
+{
+	auto file = fileSystem_->open(metricsSettings_.filename, fs::FileFlags::WRITE | fs::FileFlags::APPEND);
+
+	const auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+	Metrics::instance().write(file->getOutputStream(), timestamp);
+}
+
 void GameEngine::exit()
 {
 	running_ = false;
@@ -251,12 +319,39 @@ std::shared_future<void> GameEngine::postWorkToOpenGlWorker(void* object) {
 
 void GameEngine::tick(const float32 delta)
 {
+	PROFILE_ZONE("GameEngine::tick");
+
 	handleEvents();
 
+	tickScript(delta);
+	tickScenes(delta);
+	tickModulesAndGuis(delta);
+
+	// Run queued opengl work (bone updates first, then asset uploads) - anything that doesn't fit in the budget waits for the next frame
+	openGlLoader_->tick(openGlLoaderBudget_);
+}
+
+void GameEngine::tickScript(const float32 delta)
+{
+	PROFILE_ZONE("GameEngine::tickScript");
+
 	scripting::ParameterList params;
 	params.add(delta);
 
 	scriptingEngine_->execute(scriptObjectHandle_, "void tick(const float)", params);
+}
+
+void GameEngine::tickScenes(const float32 delta)
+{
+	PROFILE_ZONE("GameEngine::tickScenes");
+
+	// Animation workers from the last tick may still be allocating from or writing into the arena's current frame
+	for (auto& scene : scenes_)
+	{
+		scene->waitForAnimations();
+	}
+
+	bonePaletteArena_.beginFrame();
 
 	std::vector<std::future<void>> futures;
 	for (auto& scene : scenes_)
@@ -277,6 +372,11 @@ void GameEngine::tick(const float32 delta)
 	{
 		// sleep
 	}
+}
+
+void GameEngine::tickModulesAndGuis(const float32 delta)
+{
+	PROFILE_ZONE("GameEngine::tickModulesAndGuis");
 
 	for (auto& module : modules_)
 	{
@@ -308,21 +408,36 @@ void GameEngine::tick(const float32 delta)
 
         guisDeleted_.clear();
     }
+}
 
-	// Load any opengl assets (this needs work...)
-	if (openGlLoader_->getWorkQueueCount() != 0u)
-	{
-		openGlLoader_->tick();
-	}
+void GameEngine::updateMetrics(const float32 delta)
+{
+	static auto& frameTime = Metrics::instance().histogram("engine.frame_us");
+	static auto& foregroundQueueDepth = Metrics::instance().gauge("thread_pool.foreground.queue_depth");
+	static auto& backgroundQueueDepth = Metrics::instance().gauge("thread_pool.background.queue_depth");
+	static auto& openGlLoaderQueueDepth = Metrics::instance().gauge("opengl_loader.queue_depth");
+
+	frameTime.record(static_cast<uint64>(delta * 1000000.0f));
+	foregroundQueueDepth.set(foregroundThreadPool_->getWorkQueueCount());
+	backgroundQueueDepth.set(backgroundThreadPool_->getWorkQueueCount());
+	openGlLoaderQueueDepth.set(openGlLoader_->getWorkQueueCount());
 
-	while (forgroundGraphicsThreadPool_->getWorkQueueCount() != 0u)
+	if (!metricsSettings_.enabled) return;
+
+	metricsTime_ += delta;
+
+	if (metricsTime_ >= metricsSettings_.dumpInterval)
 	{
-		forgroundGraphicsThreadPool_->tick();
+		metricsTime_ = 0.0f;
+
+		dumpMetrics();
 	}
 }
 
 void GameEngine::render()
 {
+    PROFILE_ZONE("GameEngine::render");
+
     graphicsEngine_->beginRender();
 
     for (auto& scene : scenes_)
@@ -350,10 +465,19 @@ void GameEngine::initialize()
 
 	bootstrapScriptName_ = "bootstrap.as";
 
+	const auto begin = std::chrono::high_resolution_clock::now();
+
 	initializeLoggingSubSystem();
 
 	LOG_INFO(logger_, "Initializing...");
 
+	Profiler::instance().initialize(ProfilerSettings(*properties_));
+	Profiler::instance().setThreadName("main");
+
+	metricsSettings_ = MetricsSettings(*properties_);
+
+	headless_ = properties_->getBoolValue("engine.headless", false);
+
 	initializeFileSystemSubSystem();
 
 	initializeDataStoreSubSystem();
@@ -362,29 +486,28 @@ void GameEngine::initialize()
 
 	initializeEntitySubSystem();
 
-	initializeGraphicsSubSystem();
-
-	initializeTerrainSubSystem();
+	// Subsystems start once what they use is ready.  Graphics and modules stay on this thread - windows and OpenGl
+	// contexts belong to the thread that creates them.
+	InitializationGraph initializationGraph(logger_.get());
 
-	initializeAudioSubSystem();
+	initializationGraph.add("graphics", [this]() { initializeGraphicsSubSystem(); }, {}, true);
+	initializationGraph.add("terrain", [this]() { initializeTerrainSubSystem(); });
+	initializationGraph.add("audio", [this]() { initializeAudioSubSystem(); });
+	initializationGraph.add("networking", [this]() { initializeNetworkingSubSystem(); });
+	initializationGraph.add("physics", [this]() { initializePhysicsSubSystem(); }, {"graphics"});
+	initializationGraph.add("pathfinding", [this]() { initializePathfindingSubSystem(); }, {"graphics"});
+	initializationGraph.add("scripting", [this]() { initializeScriptingSubSystem(); });
+	initializationGraph.add("scripting bindings", [this]() { initializeScriptingBindings(); }, {"scripting", "graphics", "audio", "networking", "physics", "pathfinding"});
+	initializationGraph.add("input", [this]() { initializeInputSubSystem(); });
+	initializationGraph.add("modules", [this]() { initializeModuleSubSystem(); }, {"terrain", "scripting bindings", "input"}, true);
+	initializationGraph.add("resource managers", [this]() { initializeResourceManagers(); });
+	initializationGraph.add("engine resource managers", [this]() { initializeEngineResourceManagers(); }, {"graphics"});
 
-	initializeNetworkingSubSystem();
+	initializationGraph.run(properties_->getBoolValue("engine.parallelinitialization", false) ? foregroundThreadPool_.get() : nullptr);
 
-	initializePhysicsSubSystem();
+	const std::chrono::duration<float32> duration = std::chrono::high_resolution_clock::now() - begin;
 
-	initializePathfindingSubSystem();
-
-	initializeScriptingSubSystem();
-
-	initializeInputSubSystem();
-
-	initializeModuleSubSystem();
-
-    initializeResourceManagers();
-
-    initializeEngineResourceManagers();
-
-	LOG_INFO(logger_, "Done initialization.");
+	LOG_INFO(logger_, "Done initialization in %s ms.", duration.count() * 1000.0f);
 }
 
 void GameEngine::initializeLoggingSubSystem()
@@ -392,7 +515,18 @@ void GameEngine::initializeLoggingSubSystem()
 	// Initialize the log using the specified log file
 	if (!logger_)
 	{
-		logger_ = std::make_unique<logger::Logger>("ice_engine.log");
+		auto logger = std::make_unique<logger::Logger>("ice_engine.log");
+
+		const logger::AsyncLoggerSettings asyncLoggerSettings(*properties_);
+
+		if (asyncLoggerSettings.async)
+		{
+			logger_ = std::make_unique<logger::AsyncLogger>(std::move(logger), asyncLoggerSettings);
+		}
+		else
+		{
+			logger_ = std::move(logger);
+		}
 	}
 }
 
@@ -419,20 +553,25 @@ void GameEngine::initializePhysicsSubSystem()
 	{
         const auto physicsPlugin = pluginManager_->getPhysicsPlugin();
 
-		if (physicsPlugin)
+		if (headless_)
+		{
+			LOG_INFO(logger_, "headless - using the stub physics engine.");
+			physicsEngine_ = std::make_unique<physics::StubPhysicsEngine>();
+		}
+		else if (physicsPlugin)
 		{
 			LOG_INFO(logger_, "initializing physics plugin %s.", physicsPlugin->getName());
 			physicsEngineFactory_ = physicsPlugin->createFactory();
 
 			physicsEngine_ = physicsEngineFactory_->create(properties_.get(), fileSystem_.get(), logger_.get());
-
-			physicsEngine_->setPhysicsDebugRenderer(debugRenderer_.get());
 		}
 		else
 		{
 			LOG_INFO(logger_, "physics system not initialized - no physics plugin found.");
 //			physicsEngineFactory_ = std::make_unique<physics::PhysicsEngineFactory>();
 		}
+
+		if (physicsEngine_) physicsEngine_->setPhysicsDebugRenderer(debugRenderer_.get());
 	}
 }
 
@@ -444,20 +583,25 @@ void GameEngine::initializePathfindingSubSystem()
 	{
         const auto pathfindingPlugin = pluginManager_->getPathfindingPlugin();
 
-		if (pathfindingPlugin)
+		if (headless_)
+		{
+			LOG_INFO(logger_, "headless - using the null pathfinding engine.");
+			pathfindingEngine_ = std::make_unique<pathfinding::NullPathfindingEngine>();
+		}
+		else if (pathfindingPlugin)
 		{
 			LOG_INFO(logger_, "initializing pathfinding plugin %s.", pathfindingPlugin->getName());
 			pathfindingEngineFactory_ = pathfindingPlugin->createFactory();
 
 			pathfindingEngine_ = pathfindingEngineFactory_->create(properties_.get(), fileSystem_.get(), logger_.get());
-
-			pathfindingEngine_->setPathfindingDebugRenderer(debugRenderer_.get());
 		}
 		else
 		{
 			LOG_INFO(logger_, "pathfinding system not initialized - no pathfinding plugin found.");
 //			pathfindingEngineFactory_ = std::make_unique<pathfinding::PathfindingEngineFactory>();
 		}
+
+		if (pathfindingEngine_) pathfindingEngine_->setPathfindingDebugRenderer(debugRenderer_.get());
 	}
 }
 
@@ -469,22 +613,33 @@ void GameEngine::initializeGraphicsSubSystem()
 	{
         const auto graphicsPlugin = pluginManager_->getGraphicsPlugin();
 
-		if (graphicsPlugin)
+		if (headless_)
+		{
+			LOG_INFO(logger_, "headless - using the null graphics engine.");
+			graphicsEngine_ = std::make_unique<graphics::NullGraphicsEngine>();
+		}
+		else if (graphicsPlugin)
 		{
 			LOG_INFO(logger_, "initializing graphics plugin %s.", graphicsPlugin->getName());
 			graphicsEngineFactory_ = graphicsPlugin->createFactory();
 
 			graphicsEngine_ = graphicsEngineFactory_->create(properties_.get(), fileSystem_.get(), logger_.get());
-
-			graphicsEngine_->addEventListener(this);
-
-			debugRenderer_ = std::make_unique<DebugRenderer>(graphicsEngine_.get());
 		}
 		else
 		{
 			LOG_INFO(logger_, "graphics system not initialized - no graphics plugin found.");
 //			graphicsEngineFactory_ = std::make_unique<graphics::GraphicsEngineFactory>();
 		}
+
+		if (graphicsEngine_)
+		{
+			graphicsEngine_->addEventListener(this);
+
+			debugRenderer_ = std::make_unique<DebugRenderer>(graphicsEngine_.get());
+
+			const auto textureCacheDirectory = properties_->getStringValue("graphics.texturecache", "texture_cache");
+			textureCache_ = std::make_unique<TextureCache>(textureCacheDirectory, fileSystem_.get(), logger_.get(), backgroundThreadPool_.get());
+		}
 	}
 }
 
@@ -553,7 +708,12 @@ void GameEngine::initializeAudioSubSystem()
 	{
         const auto audioPlugin = pluginManager_->getAudioPlugin();
 
-		if (audioPlugin)
+		if (headless_)
+		{
+			LOG_INFO(logger_, "headless - using the null audio engine.");
+			audioEngine_ = std::make_unique<audio::NullAudioEngine>();
+		}
+		else if (audioPlugin)
 		{
 			LOG_INFO(logger_, "initializing audio plugin %s.", audioPlugin->getName());
 			audioEngineFactory_ = audioPlugin->createFactory();
@@ -576,20 +736,38 @@ void GameEngine::initializeNetworkingSubSystem()
 	{
         const auto networkingPlugin = pluginManager_->getNetworkingPlugin();
 
-		if (networkingPlugin)
+		if (headless_)
+		{
+			LOG_INFO(logger_, "headless - using the null networking engine.");
+			networkingEngine_ = std::make_unique<networking::NullNetworkingEngine>();
+		}
+		else if (networkingPlugin)
 		{
 			LOG_INFO(logger_, "initializing networking plugin %s.", networkingPlugin->getName());
 			networkingEngineFactory_ = networkingPlugin->createFactory();
 
 			networkingEngine_ = networkingEngineFactory_->create(properties_.get(), fileSystem_.get(), logger_.get());
-
-			networkingEngine_->addEventListener(this);
 		}
 		else
 		{
 			LOG_INFO(logger_, "networking system not initialized - no networking plugin found.");
 //			networkingEngineFactory_ = std::make_unique<networking::NetworkingEngineFactory>();
 		}
+
+		if (networkingEngine_)
+		{
+			// Counts what reaches the wrapped engine, so the metrics see batches when batching is on
+			networkingEngine_ = std::make_unique<networking::CountingNetworkingEngine>(std::move(networkingEngine_));
+
+			const networking::BatchingSettings batchingSettings(*properties_);
+
+			if (batchingSettings.enabled)
+			{
+				networkingEngine_ = std::make_unique<networking::BatchingNetworkingEngine>(std::move(networkingEngine_), logger_.get(), batchingSettings);
+			}
+
+			networkingEngine_->addEventListener(this);
+		}
 	}
 }
 
@@ -599,6 +777,21 @@ void GameEngine::initializeScriptingSubSystem()
 
 	scriptingEngine_ = scripting::ScriptingFactory::createScriptingEngine(properties_.get(), fileSystem_.get(), logger_.get());
 
+	scriptingEngine_->debugger()->addDebugEventListener(this);
+
+    debuggerExecutionContext_ = scriptingEngine_->createExecutionContext();
+
+	for (int i=0; i < 2; ++i)
+	{
+		auto context = scriptingEngine_->createExecutionContext();
+		temporaryExecutionContexts_.push(context);
+	}
+}
+
+void GameEngine::initializeScriptingBindings()
+{
+	LOG_INFO(logger_, "Binding scripting...");
+
 	BindingDelegate delegate(logger_.get(), scriptingEngine_.get(), this, graphicsEngine_.get(), audioEngine_.get(), networkingEngine_.get(), physicsEngine_.get(), pathfindingEngine_.get());
 	delegate.bind();
 
@@ -613,16 +806,6 @@ void GameEngine::initializeScriptingSubSystem()
 		scriptingEngineBinding->bind();
 		scriptingEngineBindings_.push_back(std::move(scriptingEngineBinding));
 	}
-
-	scriptingEngine_->debugger()->addDebugEventListener(this);
-
-    debuggerExecutionContext_ = scriptingEngine_->createExecutionContext();
-
-	for (int i=0; i < 2; ++i)
-	{
-		auto context = scriptingEngine_->createExecutionContext();
-		temporaryExecutionContexts_.push(context);
-	}
 }
 
 void GameEngine::initializeThreadingSubSystem()
@@ -633,7 +816,15 @@ void GameEngine::initializeThreadingSubSystem()
 
 	LOG_DEBUG(logger_, "Load opengl loader...");
 	openGlLoader_ = std::make_unique<OpenGlLoader>();
-	forgroundGraphicsThreadPool_ = std::make_unique<OpenGlLoader>();
+	openGlLoaderBudget_ = std::chrono::microseconds(properties_->getIntValue("graphics.uploadbudget", 2000));
+
+	if (SimulationSettings(*properties_).pipelined)
+	{
+		LOG_DEBUG(logger_, "Load simulation thread...");
+		renderState_ = std::make_unique<RenderState>();
+		simulationThreadPool_ = std::make_unique<ThreadPool>(1);
+		simulationThreadPool_->postWork([]() { Profiler::instance().setThreadName("simulation"); });
+	}
 }
 
 void GameEngine::initializeDataStoreSubSystem()
@@ -645,6 +836,11 @@ void GameEngine::initializeDataStoreSubSystem()
 void GameEngine::initializeEntitySubSystem()
 {
 	LOG_INFO(logger_, "Load entity system...");
+
+	if (properties_->getBoolValue("animation.bake", false))
+	{
+		animationBakeRate_ = properties_->getFloatValue("animation.bakerate", 30.0f);
+	}
 }
 
 std::vector<graphics::model::BoneData> boneData;
@@ -1639,50 +1835,86 @@ void GameEngine::animateSkeleton(
 	const SkeletonHandle& skeletonHandle
 )
 {
-    detail::checkHandleValidity(*graphicsEngine_, meshHandle);
-    detail::checkHandleValidity(animations_, animationHandle);
-    detail::checkHandleValidity(skeletons_, skeletonHandle);
+	animateSkeleton(transformations, runningTime, 0, 0, meshHandle, animationHandle, skeletonHandle);
+}
 
-	const auto& mesh = meshes_[meshHandle];
-	const auto& animation = animations_[animationHandle];
-	const auto& skeleton = skeletons_[skeletonHandle];
+void GameEngine::animateSkeleton(
+	std::vector<glm::mat4>& transformations,
+    const std::chrono::duration<float32> runningTime,
+    const uint32 startFrame,
+    const uint32 endFrame,
+	const graphics::MeshHandle& meshHandle,
+	const AnimationHandle& animationHandle,
+	const SkeletonHandle& skeletonHandle
+)
+{
+	// Reuses the existing storage, so only the first call allocates
+	transformations.assign(100, glm::mat4(1.0f));
 
-	transformations = std::vector<glm::mat4>(100, glm::mat4(1.0f));
+	animateSkeleton(transformations.data(), static_cast<uint32>(transformations.size()), runningTime, startFrame, endFrame, meshHandle, animationHandle, skeletonHandle);
+}
 
-	ice_engine::animateSkeleton(
-		transformations,
-		skeleton.globalInverseTransformation(),
-		animation.animatedBoneNodes(),
-		skeleton.rootBoneNode(),
-		mesh.boneData(),
-		animation.duration(),
-		animation.ticksPerSecond(),
-		runningTime
-	);
+BonePaletteArena::Palette GameEngine::animateSkeleton(
+    const std::chrono::duration<float32> runningTime,
+    const uint32 startFrame,
+    const uint32 endFrame,
+	const graphics::MeshHandle& meshHandle,
+	const AnimationHandle& animationHandle,
+	const SkeletonHandle& skeletonHandle,
+	const uint32 maxAnimatedDepth
+)
+{
+	auto palette = bonePaletteArena_.allocate(numberOfBones(meshHandle));
+
+	animateSkeleton(palette.transformations, palette.size, runningTime, startFrame, endFrame, meshHandle, animationHandle, skeletonHandle, maxAnimatedDepth);
+
+	return palette;
 }
 
 void GameEngine::animateSkeleton(
-	std::vector<glm::mat4>& transformations,
+	glm::mat4* transformations,
+	const uint32 numberOfTransformations,
     const std::chrono::duration<float32> runningTime,
     const uint32 startFrame,
     const uint32 endFrame,
 	const graphics::MeshHandle& meshHandle,
 	const AnimationHandle& animationHandle,
-	const SkeletonHandle& skeletonHandle
+	const SkeletonHandle& skeletonHandle,
+	const uint32 maxAnimatedDepth
 )
 {
+    boost::shared_lock_guard<boost::shared_mutex> lock(animationsMutex_);
+
     detail::checkHandleValidity(*graphicsEngine_, meshHandle);
     detail::checkHandleValidity(animations_, animationHandle);
     detail::checkHandleValidity(skeletons_, skeletonHandle);
 
 	const auto& mesh = meshes_[meshHandle];
-	const auto& animation = animations_[animationHandle];
 	const auto& skeleton = skeletons_[skeletonHandle];
 
-	transformations = std::vector<glm::mat4>(100, glm::mat4(1.0f));
+	const auto it = bakedAnimations_.find(animationHandle);
+	if (it != bakedAnimations_.end())
+	{
+		it->second.animateSkeleton(
+			transformations,
+			numberOfTransformations,
+			skeleton.globalInverseTransformation(),
+			skeleton.rootBoneNode(),
+			mesh.boneData(),
+			runningTime,
+			startFrame,
+			endFrame,
+			maxAnimatedDepth
+		);
+
+		return;
+	}
+
+	const auto& animation = animations_[animationHandle];
 
 	ice_engine::animateSkeleton(
 		transformations,
+		numberOfTransformations,
 		skeleton.globalInverseTransformation(),
 		animation.animatedBoneNodes(),
 		skeleton.rootBoneNode(),
@@ -1691,7 +1923,8 @@ void GameEngine::animateSkeleton(
 		animation.ticksPerSecond(),
 		runningTime,
 		startFrame,
-		endFrame
+		endFrame,
+		maxAnimatedDepth
 	);
 }
 
@@ -2311,7 +2544,12 @@ void GameEngine::run()
 		float32 currentFps = 0.0f;
 		float32 tempFps = 0.0f;
 		float32 delta = 0.0f;
-		float32 cumulativeDelta = 0.0f;
+
+		const SimulationSettings simulationSettings(*properties_);
+		SimulationClock simulationClock(simulationSettings);
+
+		// Scene ticks still running from the previous frame, when pipelined
+		std::future<void> simulation;
 
 		//float32 runningTime;
 		//std::vector<glm::mat4> transformations;
@@ -2336,8 +2574,7 @@ void GameEngine::run()
 		while ( running_ )
 		{
 			beginFpsTime = std::chrono::high_resolution_clock::now();
-			delta = std::chrono::duration<float32>(beginFpsTime - endFpsTime).count();
-			cumulativeDelta += delta;
+			delta = simulationSettings.fixedDelta > 0.0f ? simulationSettings.fixedDelta : std::chrono::duration<float32>(beginFpsTime - endFpsTime).count();
 
 			tempFps++;
 
@@ -2348,20 +2585,73 @@ void GameEngine::run()
 				tempFps = 0;
 			}
 
+			if (simulationSettings.pipelined)
+			{
+				// Sync point - the scenes have finished the ticks of the previous frame, and nothing is rendering
+				{
+					PROFILE_ZONE("GameEngine::waitForSimulation");
+
+					if (simulation.valid()) simulation.get();
+				}
+
+				renderState_->swap();
+				renderState_->apply(graphicsEngine_.get(), bonePaletteArena_);
+
+				for (auto& scene : scenes_)
+				{
+					if (simulationSettings.interpolation) scene->interpolate(simulationClock.alpha());
+
+					scene->synchronize();
+				}
+			}
+
 			networkingEngine_->tick(delta);
 
-			const float32 updateFrequency = 1.0f / 60.0f;
-			int a = 0;
-			while (cumulativeDelta >= updateFrequency && a < 3)
+			// The simulation always advances in whole ticks - rendering happens between the last two
+			const uint32 ticks = simulationClock.advance(delta);
+
+			if (simulationSettings.pipelined)
 			{
-				tick(updateFrequency);
-				cumulativeDelta -= updateFrequency;
-				a++;
+				// Scripts, modules and guis call the graphics engine directly, so they tick here while the scenes are idle
+				for (uint32 i = 0; i < ticks; ++i)
+				{
+					handleEvents();
+					tickScript(simulationClock.tickDelta());
+					tickModulesAndGuis(simulationClock.tickDelta());
+				}
+
+				openGlLoader_->tick(openGlLoaderBudget_);
+
+				// The scenes simulate this frame's ticks into the render state while the previous frame renders
+				const float32 tickDelta = simulationClock.tickDelta();
+				simulation = simulationThreadPool_->postWork([this, ticks, tickDelta]() {
+					for (uint32 i = 0; i < ticks; ++i)
+					{
+						tickScenes(tickDelta);
+					}
+				});
 			}
-	//		tick(delta);
+			else
+			{
+				for (uint32 i = 0; i < ticks; ++i)
+				{
+					tick(simulationClock.tickDelta());
+				}
+			}
+
+			engineStatistics_.ticks = ticks;
+			engineStatistics_.droppedTime = static_cast<float32>(simulationClock.droppedTime());
 
 			auto beginRenderTime = std::chrono::high_resolution_clock::now();
 
+			if (simulationSettings.interpolation && !simulationSettings.pipelined)
+			{
+				for (auto& scene : scenes_)
+				{
+					scene->interpolate(simulationClock.alpha());
+				}
+			}
+
             render();
 
             auto endRenderTime = std::chrono::high_resolution_clock::now();
@@ -2371,8 +2661,15 @@ void GameEngine::run()
 			endFpsTime = beginFpsTime;
 
 			engineStatistics_.fps = currentFps;
+
+			// Zones are only visible to statistics and trace export once collected
+			Profiler::instance().collect();
+
+			updateMetrics(delta);
 		}
 
+		if (simulation.valid()) simulation.get();
+
 //		scriptingEngine_->releaseAllScriptObjects();
 //		scriptingEngine_->destroyAllModules();
 
@@ -0,0 +1,281 @@
+#include <algorithm>
+
+#include "HeightGrid.hpp"
+
+#include "exceptions/RuntimeException.hpp"
+
+#include "detail/Format.hpp"
+
+namespace ice_engine
+{
+
+namespace
+{
+
+const float32 R16_SCALE = 1.0f / 65535.0f;
+
+/**
+ * Reads samples of either storage format - the format is dispatched once per call, outside of the sampling loops.
+ *
+ * Coordinates are clamped with min/max rather than branches or wrapping, which compilers turn into conditional moves.
+ */
+template <typename T>
+struct Sampler
+{
+	const T* data;
+	float32 scale;
+	int64 lastX;
+	int64 lastZ;
+	int64 width;
+
+	float32 height(const int64 x, const int64 z) const
+	{
+		const int64 clampedX = std::min(std::max(x, int64(0)), lastX);
+		const int64 clampedZ = std::min(std::max(z, int64(0)), lastZ);
+
+		return static_cast<float32>(data[clampedZ * width + clampedX]) * scale;
+	}
+
+	float32 bilinear(float32 x, float32 z) const
+	{
+		// Clamping first makes truncation the same as flooring
+		x = std::min(std::max(x, 0.0f), static_cast<float32>(lastX));
+		z = std::min(std::max(z, 0.0f), static_cast<float32>(lastZ));
+
+		const int64 x0 = static_cast<int64>(x);
+		const int64 z0 = static_cast<int64>(z);
+		const int64 x1 = std::min(x0 + 1, lastX);
+		const int64 z1 = std::min(z0 + 1, lastZ);
+
+		const float32 tx = x - static_cast<float32>(x0);
+		const float32 tz = z - static_cast<float32>(z0);
+
+		const T* row0 = data + z0 * width;
+		const T* row1 = data + z1 * width;
+
+		const float32 h00 = static_cast<float32>(row0[x0]);
+		const float32 h10 = static_cast<float32>(row0[x1]);
+		const float32 h01 = static_cast<float32>(row1[x0]);
+		const float32 h11 = static_cast<float32>(row1[x1]);
+
+		const float32 top = h00 + (h10 - h00) * tx;
+		const float32 bottom = h01 + (h11 - h01) * tx;
+
+		return (top + (bottom - top) * tz) * scale;
+	}
+
+	static float32 catmullRom(const float32 p0, const float32 p1, const float32 p2, const float32 p3, const float32 t)
+	{
+		const float32 a = -0.5f * p0 + 1.5f * p1 - 1.5f * p2 + 0.5f * p3;
+		const float32 b = p0 - 2.5f * p1 + 2.0f * p2 - 0.5f * p3;
+		const float32 c = -0.5f * p0 + 0.5f * p2;
+
+		return ((a * t + b) * t + c) * t + p1;
+	}
+
+	float32 bicubic(float32 x, float32 z) const
+	{
+		x = std::min(std::max(x, 0.0f), static_cast<float32>(lastX));
+		z = std::min(std::max(z, 0.0f), static_cast<float32>(lastZ));
+
+		const int64 x1 = static_cast<int64>(x);
+		const int64 z1 = static_cast<int64>(z);
+
+		const float32 tx = x - static_cast<float32>(x1);
+		const float32 tz = z - static_cast<float32>(z1);
+
+		int64 columns[4];
+		for (int64 i = 0; i < 4; ++i)
+		{
+			columns[i] = std::min(std::max(x1 - 1 + i, int64(0)), lastX);
+		}
+
+		float32 rows[4];
+		for (int64 j = 0; j < 4; ++j)
+		{
+			const T* row = data + std::min(std::max(z1 - 1 + j, int64(0)), lastZ) * width;
+
+			rows[j] = catmullRom(
+				static_cast<float32>(row[columns[0]]),
+				static_cast<float32>(row[columns[1]]),
+				static_cast<float32>(row[columns[2]]),
+				static_cast<float32>(row[columns[3]]),
+				tx
+			);
+		}
+
+		return catmullRom(rows[0], rows[1], rows[2], rows[3], tz) * scale;
+	}
+};
+
+template <typename T>
+Sampler<T> createSampler(const std::vector<T>& heights, const float32 scale, const uint32 width, const uint32 length)
+{
+	return Sampler<T>{heights.data(), scale, static_cast<int64>(width) - 1, static_cast<int64>(length) - 1, width};
+}
+
+}
+
+HeightGrid::HeightGrid(std::vector<uint16> heights, const uint32 width, const uint32 length)
+	:
+	format_(Format::R16),
+	width_(width),
+	length_(length),
+	heights16_(std::move(heights))
+{
+	if (heights16_.size() != static_cast<size_t>(width) * length)
+	{
+		throw RuntimeException(detail::format("Height grid of size %sx%s needs %s heights, but %s were given.", width, length, static_cast<size_t>(width) * length, heights16_.size()));
+	}
+}
+
+HeightGrid::HeightGrid(std::vector<float32> heights, const uint32 width, const uint32 length)
+	:
+	format_(Format::R32F),
+	width_(width),
+	length_(length),
+	heights32f_(std::move(heights))
+{
+	if (heights32f_.size() != static_cast<size_t>(width) * length)
+	{
+		throw RuntimeException(detail::format("Height grid of size %sx%s needs %s heights, but %s were given.", width, length, static_cast<size_t>(width) * length, heights32f_.size()));
+	}
+}
+
+HeightGrid::HeightGrid(const graphics::IImage& image, const Format format)
+	:
+	format_(format),
+	width_(image.width()),
+	length_(image.height())
+{
+	const size_t size = static_cast<size_t>(width_) * length_;
+	const auto& data = image.data();
+
+	if (format_ == Format::R16) heights16_.resize(size);
+	else heights32f_.resize(size);
+
+	for (size_t i = 0; i < size; ++i)
+	{
+		const byte value = (image.format() == graphics::IImage::Format::FORMAT_RGBA ? data[i * 4 + 3] : static_cast<byte>((data[i * 3] + data[i * 3 + 1] + data[i * 3 + 2]) / 3));
+
+		// 257 maps [0, 255] onto [0, 65535]
+		if (format_ == Format::R16) heights16_[i] = static_cast<uint16>(value * 257);
+		else heights32f_[i] = static_cast<float32>(value) / 255.0f;
+	}
+}
+
+HeightGrid::Format HeightGrid::format() const
+{
+	return format_;
+}
+
+uint32 HeightGrid::width() const
+{
+	return width_;
+}
+
+uint32 HeightGrid::length() const
+{
+	return length_;
+}
+
+bool HeightGrid::empty() const
+{
+	return width_ == 0 || length_ == 0;
+}
+
+const std::vector<uint16>& HeightGrid::heights16() const
+{
+	return heights16_;
+}
+
+const std::vector<float32>& HeightGrid::heights32f() const
+{
+	return heights32f_;
+}
+
+float32 HeightGrid::height(const int64 x, const int64 z) const
+{
+	if (format_ == Format::R16) return createSampler(heights16_, R16_SCALE, width_, length_).height(x, z);
+
+	return createSampler(heights32f_, 1.0f, width_, length_).height(x, z);
+}
+
+float32 HeightGrid::sampleBilinear(const float32 x, const float32 z) const
+{
+	if (format_ == Format::R16) return createSampler(heights16_, R16_SCALE, width_, length_).bilinear(x, z);
+
+	return createSampler(heights32f_, 1.0f, width_, length_).bilinear(x, z);
+}
+
+float32 HeightGrid::sampleBicubic(const float32 x, const float32 z) const
+{
+	if (format_ == Format::R16) return createSampler(heights16_, R16_SCALE, width_, length_).bicubic(x, z);
+
+	return createSampler(heights32f_, 1.0f, width_, length_).bicubic(x, z);
+}
+
+void HeightGrid::sampleBilinear(const glm::vec2* points, float32* out, const size_t count) const
+{
+	if (format_ == Format::R16)
+	{
+		const auto sampler = createSampler(heights16_, R16_SCALE, width_, length_);
+		for (size_t i = 0; i < count; ++i) out[i] = sampler.bilinear(points[i].x, points[i].y);
+	}
+	else
+	{
+		const auto sampler = createSampler(heights32f_, 1.0f, width_, length_);
+		for (size_t i = 0; i < count; ++i) out[i] = sampler.bilinear(points[i].x, points[i].y);
+	}
+}
+
+void HeightGrid::sampleBicubic(const glm::vec2* points, float32* out, const size_t count) const
+{
+	if (format_ == Format::R16)
+	{
+		const auto sampler = createSampler(heights16_, R16_SCALE, width_, length_);
+		for (size_t i = 0; i < count; ++i) out[i] = sampler.bicubic(points[i].x, points[i].y);
+	}
+	else
+	{
+		const auto sampler = createSampler(heights32f_, 1.0f, width_, length_);
+		for (size_t i = 0; i < count; ++i) out[i] = sampler.bicubic(points[i].x, points[i].y);
+	}
+}
+
+HeightGrid HeightGrid::region(const int64 left, const int64 top, const uint32 width, const uint32 length) const
+{
+	const int64 lastX = static_cast<int64>(width_) - 1;
+	const int64 lastZ = static_cast<int64>(length_) - 1;
+
+	auto copyRegion = [&](const auto& source, auto& destination) {
+		destination.resize(static_cast<size_t>(width) * length);
+
+		for (uint32 j = 0; j < length; ++j)
+		{
+			const int64 z = std::min(std::max(top + j, int64(0)), lastZ);
+
+			for (uint32 i = 0; i < width; ++i)
+			{
+				const int64 x = std::min(std::max(left + i, int64(0)), lastX);
+
+				destination[static_cast<size_t>(j) * width + i] = source[z * width_ + x];
+			}
+		}
+	};
+
+	if (format_ == Format::R16)
+	{
+		std::vector<uint16> heights;
+		copyRegion(heights16_, heights);
+
+		return HeightGrid(std::move(heights), width, length);
+	}
+
+	std::vector<float32> heights;
+	copyRegion(heights32f_, heights);
+
+	return HeightGrid(std::move(heights), width, length);
+}
+
+}
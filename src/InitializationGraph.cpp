@@ -0,0 +1,175 @@
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+
+#include "InitializationGraph.hpp"
+
+#include "exceptions/RuntimeException.hpp"
+
+#include "detail/Format.hpp"
+
+namespace ice_engine
+{
+
+InitializationGraph::InitializationGraph(logger::ILogger* logger) : logger_(logger)
+{
+}
+
+void InitializationGraph::add(const std::string& name, std::function<void()> step, const std::vector<std::string>& dependencies, const bool mainThread)
+{
+	if (indices_.find(name) != indices_.end())
+	{
+		throw RuntimeException(detail::format("Initialization step '%s' already exists.", name));
+	}
+
+	const auto index = static_cast<uint32>(steps_.size());
+
+	// Dependencies have to be added first, so there can't be a cycle
+	for (const auto& dependency : dependencies)
+	{
+		const auto it = indices_.find(dependency);
+
+		if (it == indices_.end())
+		{
+			throw RuntimeException(detail::format("Initialization step '%s' depends on '%s', which hasn't been added.", name, dependency));
+		}
+
+		steps_[it->second].dependents.push_back(index);
+	}
+
+	Step s;
+	s.name = name;
+	s.function = std::move(step);
+	s.numberOfDependencies = static_cast<uint32>(dependencies.size());
+	s.mainThread = mainThread;
+
+	steps_.push_back(std::move(s));
+	indices_[name] = index;
+}
+
+void InitializationGraph::run(IThreadPool* threadPool)
+{
+	const auto begin = std::chrono::high_resolution_clock::now();
+
+	std::mutex mutex;
+	std::condition_variable condition;
+
+	std::vector<uint32> remaining(steps_.size());
+	std::deque<uint32> mainThreadSteps;
+	uint32 running = 0;
+	std::exception_ptr exception;
+
+	// Runs the step without the lock - a step only touches its own entry
+	auto execute = [this](const uint32 index) {
+		auto& step = steps_[index];
+
+		std::exception_ptr stepException;
+		const auto stepBegin = std::chrono::high_resolution_clock::now();
+
+		try
+		{
+			step.function();
+		}
+		catch (...)
+		{
+			stepException = std::current_exception();
+		}
+
+		step.duration = std::chrono::high_resolution_clock::now() - stepBegin;
+
+		LOG_INFO(logger_, "Initialized %s in %s ms.", step.name, step.duration.count() * 1000.0f);
+
+		return stepException;
+	};
+
+	// The rest is called with the lock held
+	std::function<void(const uint32)> start;
+
+	auto finish = [this, &remaining, &exception, &start](const uint32 index, std::exception_ptr stepException) {
+		// Only the first failure is rethrown
+		if (stepException && !exception) exception = stepException;
+
+		if (exception) return;
+
+		for (const auto dependent : steps_[index].dependents)
+		{
+			if (--remaining[dependent] == 0) start(dependent);
+		}
+	};
+
+	start = [this, threadPool, &mutex, &condition, &mainThreadSteps, &running, &execute, &finish](const uint32 index) {
+		if (steps_[index].mainThread || threadPool == nullptr)
+		{
+			mainThreadSteps.push_back(index);
+			return;
+		}
+
+		++running;
+
+		threadPool->postWork([index, &mutex, &condition, &running, &execute, &finish]() {
+			auto stepException = execute(index);
+
+			std::lock_guard<std::mutex> lock(mutex);
+
+			finish(index, stepException);
+			--running;
+
+			// Notified with the lock held - run() may return as soon as it is released
+			condition.notify_all();
+		});
+	};
+
+	std::unique_lock<std::mutex> lock(mutex);
+
+	for (uint32 i = 0; i < steps_.size(); ++i)
+	{
+		remaining[i] = steps_[i].numberOfDependencies;
+	}
+
+	for (uint32 i = 0; i < steps_.size(); ++i)
+	{
+		if (remaining[i] == 0) start(i);
+	}
+
+	while (true)
+	{
+		if (!mainThreadSteps.empty() && !exception)
+		{
+			const auto index = mainThreadSteps.front();
+			mainThreadSteps.pop_front();
+
+			lock.unlock();
+			auto stepException = execute(index);
+			lock.lock();
+
+			finish(index, stepException);
+
+			continue;
+		}
+
+		if (running == 0) break;
+
+		condition.wait(lock);
+	}
+
+	if (exception) std::rethrow_exception(exception);
+
+	const std::chrono::duration<float32> duration = std::chrono::high_resolution_clock::now() - begin;
+
+	LOG_INFO(logger_, "Initialized %s steps in %s ms.", steps_.size(), duration.count() * 1000.0f);
+}
+
+std::chrono::duration<float32> InitializationGraph::duration(const std::string& name) const
+{
+	const auto it = indices_.find(name);
+
+	if (it == indices_.end())
+	{
+		throw RuntimeException(detail::format("Initialization step '%s' doesn't exist.", name));
+	}
+
+	return steps_[it->second].duration;
+}
+
+}
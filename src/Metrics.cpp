@@ -0,0 +1,212 @@
+#include <algorithm>
+#include <cmath>
+
+#include "Metrics.hpp"
+
+namespace ice_engine
+{
+
+namespace
+{
+
+std::atomic<uint32> nextStripe{0};
+
+uint32 highestBit(const uint64 value)
+{
+	uint32 bit = 0;
+	uint64 v = value;
+
+	while (v >>= 1) ++bit;
+
+	return bit;
+}
+
+// Measurement names may not contain unescaped commas or spaces
+void writeMeasurement(std::ostream& stream, const std::string& name)
+{
+	for (const char c : name)
+	{
+		if (c == ',' || c == ' ') stream << '\\';
+		stream << c;
+	}
+}
+
+}
+
+uint64 MetricCounter::value() const
+{
+	uint64 value = 0;
+
+	for (const auto& stripe : stripes_)
+	{
+		value += stripe.value.load(std::memory_order_relaxed);
+	}
+
+	return value;
+}
+
+uint32 MetricCounter::stripe()
+{
+	// Threads take stripes in turn the first time they count anything
+	thread_local const uint32 stripe = nextStripe.fetch_add(1, std::memory_order_relaxed) % NUMBER_OF_STRIPES;
+
+	return stripe;
+}
+
+MetricHistogramSnapshot MetricHistogram::snapshot(const bool reset)
+{
+	std::array<uint64, NUMBER_OF_BUCKETS> counts;
+
+	MetricHistogramSnapshot snapshot;
+	float64 total = 0.0;
+
+	for (uint32 i = 0; i < NUMBER_OF_BUCKETS; ++i)
+	{
+		counts[i] = reset ? buckets_[i].exchange(0, std::memory_order_relaxed) : buckets_[i].load(std::memory_order_relaxed);
+
+		if (counts[i] == 0) continue;
+
+		if (snapshot.count == 0) snapshot.minimum = lowest(i);
+		snapshot.maximum = highest(i);
+		snapshot.count += counts[i];
+
+		// Bucket midpoints stand in for the values
+		total += static_cast<float64>(counts[i]) * (static_cast<float64>(lowest(i)) + static_cast<float64>(highest(i))) / 2.0;
+	}
+
+	if (snapshot.count == 0) return snapshot;
+
+	snapshot.mean = total / static_cast<float64>(snapshot.count);
+
+	auto percentile = [&counts, &snapshot](const float64 p) {
+		const auto rank = std::max<uint64>(1, static_cast<uint64>(std::ceil(p * static_cast<float64>(snapshot.count))));
+
+		uint64 seen = 0;
+		for (uint32 i = 0; i < NUMBER_OF_BUCKETS; ++i)
+		{
+			seen += counts[i];
+			if (seen >= rank) return highest(i);
+		}
+
+		return snapshot.maximum;
+	};
+
+	snapshot.percentile50 = percentile(0.5);
+	snapshot.percentile95 = percentile(0.95);
+	snapshot.percentile99 = percentile(0.99);
+
+	return snapshot;
+}
+
+uint32 MetricHistogram::bucket(const uint64 value)
+{
+	if (value < 64) return static_cast<uint32>(value);
+
+	// The 5 bits below the highest one pick the bucket within its power of 2
+	const uint32 exponent = highestBit(value);
+	const auto subBucket = static_cast<uint32>(value >> (exponent - 5)) - 32;
+
+	return 64 + (exponent - 6) * 32 + subBucket;
+}
+
+uint64 MetricHistogram::lowest(const uint32 bucket)
+{
+	if (bucket < 64) return bucket;
+
+	const uint32 exponent = (bucket - 64) / 32 + 6;
+	const uint64 subBucket = (bucket - 64) % 32 + 32;
+
+	return subBucket << (exponent - 5);
+}
+
+uint64 MetricHistogram::highest(const uint32 bucket)
+{
+	if (bucket < 64) return bucket;
+
+	const uint32 exponent = (bucket - 64) / 32 + 6;
+
+	return lowest(bucket) + ((uint64(1) << (exponent - 5)) - 1);
+}
+
+Metrics& Metrics::instance()
+{
+	static Metrics metrics;
+
+	return metrics;
+}
+
+MetricCounter& Metrics::counter(const std::string& name)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	auto& counter = counterNames_[name];
+	if (counter == nullptr)
+	{
+		counters_.emplace_back();
+		counter = &counters_.back();
+	}
+
+	return counter->counter;
+}
+
+MetricGauge& Metrics::gauge(const std::string& name)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	auto& gauge = gaugeNames_[name];
+	if (gauge == nullptr)
+	{
+		gauges_.emplace_back();
+		gauge = &gauges_.back();
+	}
+
+	return *gauge;
+}
+
+MetricHistogram& Metrics::histogram(const std::string& name)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	auto& histogram = histogramNames_[name];
+	if (histogram == nullptr)
+	{
+		histograms_.emplace_back();
+		histogram = &histograms_.back();
+	}
+
+	return *histogram;
+}
+
+void Metrics::write(std::ostream& stream, const int64 timestamp)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	for (auto& entry : counterNames_)
+	{
+		auto& counter = *entry.second;
+		const uint64 value = counter.counter.value();
+
+		writeMeasurement(stream, entry.first);
+		stream << " count=" << value << "i,delta=" << (value - counter.written) << "i " << timestamp << "\n";
+
+		counter.written = value;
+	}
+
+	for (const auto& entry : gaugeNames_)
+	{
+		writeMeasurement(stream, entry.first);
+		stream << " value=" << entry.second->value() << "i " << timestamp << "\n";
+	}
+
+	for (auto& entry : histogramNames_)
+	{
+		const auto snapshot = entry.second->snapshot(true);
+
+		writeMeasurement(stream, entry.first);
+		stream << " count=" << snapshot.count << "i,min=" << snapshot.minimum << "i,mean=" << snapshot.mean
+			<< ",p50=" << snapshot.percentile50 << "i,p95=" << snapshot.percentile95 << "i,p99=" << snapshot.percentile99
+			<< "i,max=" << snapshot.maximum << "i " << timestamp << "\n";
+	}
+}
+
+}
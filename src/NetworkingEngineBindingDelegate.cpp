@@ -10,9 +10,57 @@
 
 #include "GameEngine.hpp"
 
+#include "exceptions/RuntimeException.hpp"
+
+#include "detail/Format.hpp"
+
 namespace ice_engine
 {
 
+uint32 messageBufferSizeProxy(const networking::MessageBuffer* messageBuffer)
+{
+	return static_cast<uint32>(messageBuffer->size());
+}
+
+uint8 messageBufferIndexProxy(const uint32 index, const networking::MessageBuffer* messageBuffer)
+{
+	if (index >= messageBuffer->size())
+	{
+		throw RuntimeException(detail::format("Index %s is out of range for a message of %s bytes.", index, messageBuffer->size()));
+	}
+
+	return (*messageBuffer)[index];
+}
+
+namespace
+{
+
+// Buffers for script sends on a channel - buffers outlive the pool, so it going away at exit is fine
+networking::MessageBufferPool scriptMessageBufferPool;
+
+}
+
+void sendServerChannelProxy(const networking::ServerHandle& serverHandle, const std::vector<uint8>& data, const networking::Channel channel, networking::INetworkingEngine* networkingEngine)
+{
+	networkingEngine->send(serverHandle, scriptMessageBufferPool.allocate(data), channel);
+}
+
+void sendRemoteConnectionChannelProxy(
+	const networking::ServerHandle& serverHandle,
+	const networking::RemoteConnectionHandle& remoteConnectionHandle,
+	const std::vector<uint8>& data,
+	const networking::Channel channel,
+	networking::INetworkingEngine* networkingEngine
+)
+{
+	networkingEngine->send(serverHandle, remoteConnectionHandle, scriptMessageBufferPool.allocate(data), channel);
+}
+
+void sendClientChannelProxy(const networking::ClientHandle& clientHandle, const std::vector<uint8>& data, const networking::Channel channel, networking::INetworkingEngine* networkingEngine)
+{
+	networkingEngine->send(clientHandle, scriptMessageBufferPool.allocate(data), channel);
+}
+
 NetworkingEngineBindingDelegate::NetworkingEngineBindingDelegate(logger::ILogger* logger, scripting::IScriptingEngine* scriptingEngine, GameEngine* gameEngine, networking::INetworkingEngine* networkingEngine)
 	:
 	logger_(logger),
@@ -34,6 +82,10 @@ void NetworkingEngineBindingDelegate::bind()
 	scriptingEngine_->registerEnumValue("NetworkingEventType", "CLIENTCONNECT", networking::CLIENTCONNECT);
 	scriptingEngine_->registerEnumValue("NetworkingEventType", "SERVERMESSAGE", networking::SERVERMESSAGE);
 	scriptingEngine_->registerEnumValue("NetworkingEventType", "CLIENTMESSAGE", networking::CLIENTMESSAGE);
+
+	scriptingEngine_->registerEnum("NetworkingChannel");
+	scriptingEngine_->registerEnumValue("NetworkingChannel", "RELIABLE", networking::RELIABLE);
+	scriptingEngine_->registerEnumValue("NetworkingChannel", "UNRELIABLE", networking::UNRELIABLE);
 	
 	registerHandleBindings<networking::ServerHandle>(scriptingEngine_, "ServerHandle");
 	registerHandleBindings<networking::ClientHandle>(scriptingEngine_, "ClientHandle");
@@ -51,13 +103,27 @@ void NetworkingEngineBindingDelegate::bind()
 	scriptingEngine_->registerObjectProperty("DisconnectEvent", "ServerHandle serverHandle", asOFFSET(networking::DisconnectEvent, serverHandle));
 	scriptingEngine_->registerObjectProperty("DisconnectEvent", "ClientHandle clientHandle", asOFFSET(networking::DisconnectEvent, clientHandle));
 	scriptingEngine_->registerObjectProperty("DisconnectEvent", "RemoteConnectionHandle remoteConnectionHandle", asOFFSET(networking::DisconnectEvent, remoteConnectionHandle));
-	scriptingEngine_->registerObjectType("MessageEvent", sizeof(networking::MessageEvent), asOBJ_VALUE | asOBJ_POD | asOBJ_APP_CLASS_ALLINTS | asGetTypeTraits<networking::MessageEvent>());
+	// Shares the received bytes rather than copying them
+	scriptingEngine_->registerObjectType("MessageBuffer", sizeof(networking::MessageBuffer), asOBJ_VALUE | asGetTypeTraits<networking::MessageBuffer>());
+	scriptingEngine_->registerObjectBehaviour("MessageBuffer", asBEHAVE_CONSTRUCT, "void f()", asFUNCTION(DefaultConstructor<networking::MessageBuffer>), asCALL_CDECL_OBJFIRST);
+	scriptingEngine_->registerObjectBehaviour("MessageBuffer", asBEHAVE_CONSTRUCT, "void f(const MessageBuffer& in)", asFUNCTION(CopyConstructor<networking::MessageBuffer>), asCALL_CDECL_OBJFIRST);
+	scriptingEngine_->registerObjectBehaviour("MessageBuffer", asBEHAVE_DESTRUCT, "void f()", asFUNCTION(DefaultDestructor<networking::MessageBuffer>), asCALL_CDECL_OBJFIRST);
+	scriptingEngine_->registerClassMethod("MessageBuffer", "MessageBuffer& opAssign(const MessageBuffer& in)", asMETHODPR(networking::MessageBuffer, operator=, (const networking::MessageBuffer&), networking::MessageBuffer&));
+	scriptingEngine_->registerObjectMethod("MessageBuffer", "uint32 size() const", asFUNCTION(messageBufferSizeProxy), asCALL_CDECL_OBJLAST);
+	scriptingEngine_->registerObjectMethod("MessageBuffer", "uint8 opIndex(const uint32) const", asFUNCTION(messageBufferIndexProxy), asCALL_CDECL_OBJLAST);
+	scriptingEngine_->registerClassMethod("MessageBuffer", "vectorUInt8 toVector() const", asMETHOD(networking::MessageBuffer, toVector));
+
+	scriptingEngine_->registerObjectType("MessageEvent", sizeof(networking::MessageEvent), asOBJ_VALUE | asGetTypeTraits<networking::MessageEvent>());
+	scriptingEngine_->registerObjectBehaviour("MessageEvent", asBEHAVE_CONSTRUCT, "void f()", asFUNCTION(DefaultConstructor<networking::MessageEvent>), asCALL_CDECL_OBJFIRST);
+	scriptingEngine_->registerObjectBehaviour("MessageEvent", asBEHAVE_CONSTRUCT, "void f(const MessageEvent& in)", asFUNCTION(CopyConstructor<networking::MessageEvent>), asCALL_CDECL_OBJFIRST);
+	scriptingEngine_->registerObjectBehaviour("MessageEvent", asBEHAVE_DESTRUCT, "void f()", asFUNCTION(DefaultDestructor<networking::MessageEvent>), asCALL_CDECL_OBJFIRST);
+	scriptingEngine_->registerClassMethod("MessageEvent", "MessageEvent& opAssign(const MessageEvent& in)", asMETHODPR(networking::MessageEvent, operator=, (const networking::MessageEvent&), networking::MessageEvent&));
 	scriptingEngine_->registerObjectProperty("MessageEvent", "uint32 type", asOFFSET(networking::MessageEvent, type));
 	scriptingEngine_->registerObjectProperty("MessageEvent", "uint32 timestamp", asOFFSET(networking::MessageEvent, timestamp));
 	scriptingEngine_->registerObjectProperty("MessageEvent", "ServerHandle serverHandle", asOFFSET(networking::MessageEvent, serverHandle));
 	scriptingEngine_->registerObjectProperty("MessageEvent", "ClientHandle clientHandle", asOFFSET(networking::MessageEvent, clientHandle));
 	scriptingEngine_->registerObjectProperty("MessageEvent", "RemoteConnectionHandle remoteConnectionHandle", asOFFSET(networking::MessageEvent, remoteConnectionHandle));
-	scriptingEngine_->registerObjectProperty("MessageEvent", "vectorUInt8 message", asOFFSET(networking::MessageEvent, message));
+	scriptingEngine_->registerObjectProperty("MessageEvent", "MessageBuffer message", asOFFSET(networking::MessageEvent, message));
 	
 	// INetworkingEngine
 	scriptingEngine_->registerObjectType("INetworkingEngine", 0, asOBJ_REF | asOBJ_NOCOUNT);
@@ -97,6 +163,24 @@ void NetworkingEngineBindingDelegate::bind()
 		"void send(const ClientHandle& in, const vectorUInt8& in)",
 		asMETHODPR(networking::INetworkingEngine, send, (const networking::ClientHandle&, const std::vector<uint8>&), void)
 	);
+	scriptingEngine_->registerObjectMethod(
+		"INetworkingEngine",
+		"void send(const ServerHandle& in, const vectorUInt8& in, const NetworkingChannel)",
+		asFUNCTION(sendServerChannelProxy),
+		asCALL_CDECL_OBJLAST
+	);
+	scriptingEngine_->registerObjectMethod(
+		"INetworkingEngine",
+		"void send(const ServerHandle& in, const RemoteConnectionHandle& in, const vectorUInt8& in, const NetworkingChannel)",
+		asFUNCTION(sendRemoteConnectionChannelProxy),
+		asCALL_CDECL_OBJLAST
+	);
+	scriptingEngine_->registerObjectMethod(
+		"INetworkingEngine",
+		"void send(const ClientHandle& in, const vectorUInt8& in, const NetworkingChannel)",
+		asFUNCTION(sendClientChannelProxy),
+		asCALL_CDECL_OBJLAST
+	);
 	scriptingEngine_->registerClassMethod(
 		"INetworkingEngine",
 		"void processEvents()",
@@ -1,43 +1,57 @@
 #include "OpenGlLoader.hpp"
+#include "Profiler.hpp"
+#include "Metrics.hpp"
 
 namespace ice_engine
 {
 
-OpenGlLoader::OpenGlLoader()
+OpenGlLoader::OpenGlLoader(const uint32 capacity)
 {
-	initialize();
+	initialize(capacity);
 }
 
 OpenGlLoader::~OpenGlLoader()
 {
 }
 
-void OpenGlLoader::initialize()
+void OpenGlLoader::initialize(const uint32 capacity)
 {
+	for (auto& lane : lanes_)
+	{
+		lane = std::make_unique<Lane>(capacity);
+	}
 }
 
 std::future<void> OpenGlLoader::postWork(const std::function<void()>& work)
 {
-	auto task = std::make_shared<std::packaged_task<void()>>([work = work]() {
-		work();
-	});
-	
-	std::lock_guard<std::mutex> lockGuard(enqueuedWorkMutex_);
-	enqueuedWork_.push_back(task);
-	
-	return task->get_future();
+	return postWork(std::function<void()>(work), Priority::PRIORITY_NORMAL);
 }
 
 std::future<void> OpenGlLoader::postWork(std::function<void()>&& work)
 {
-	auto task = std::make_shared<std::packaged_task<void()>>([work = std::move(work)]() {
-		work();
-	});
-	
-	std::lock_guard<std::mutex> lockGuard(enqueuedWorkMutex_);
-	enqueuedWork_.push_back(task);
-	
-	return task->get_future();
+	return postWork(std::move(work), Priority::PRIORITY_NORMAL);
+}
+
+std::future<void> OpenGlLoader::postWork(std::function<void()>&& work, const Priority priority, const std::chrono::microseconds cost)
+{
+	Work w;
+	w.task = std::packaged_task<void()>(std::move(work));
+	w.cost = cost;
+
+	auto future = w.task.get_future();
+
+	Lane& lane = *lanes_[priority];
+
+	++workQueueCount_;
+
+	if (lane.overflowCount.load(std::memory_order_acquire) != 0 || !lane.ringBuffer.tryPush(w))
+	{
+		std::lock_guard<std::mutex> lockGuard(lane.overflowMutex);
+		lane.overflow.push_back(std::move(w));
+		++lane.overflowCount;
+	}
+
+	return future;
 }
 
 void OpenGlLoader::waitAll()
@@ -47,34 +61,108 @@ void OpenGlLoader::waitAll()
 
 uint32 OpenGlLoader::getWorkQueueCount() const
 {
-	uint size = 0;
-	
-	std::lock_guard<std::mutex> lockGuard(enqueuedWorkMutex_);
-	size = enqueuedWork_.size();
-	
-	return size;
+	return workQueueCount_.load();
 }
 
 void OpenGlLoader::block()
 {
-	enqueuedWorkMutex_.lock();
+	tickMutex_.lock();
 }
 
 void OpenGlLoader::unblock()
 {
-	enqueuedWorkMutex_.unlock();
+	tickMutex_.unlock();
 }
 
 void OpenGlLoader::tick()
 {
-	std::lock_guard<std::mutex> lockGuard(enqueuedWorkMutex_);
-	if (enqueuedWork_.size() > 0)
+	std::lock_guard<std::mutex> lockGuard(tickMutex_);
+
+	for (auto& lane : lanes_)
 	{
-		auto work = enqueuedWork_.front();
-		enqueuedWork_.pop_front();
-		
-		(*work)();
+		Work work;
+		if (pop(*lane, work))
+		{
+			run(*lane, work);
+			return;
+		}
+	}
+}
+
+void OpenGlLoader::tick(const std::chrono::microseconds budget)
+{
+	std::lock_guard<std::mutex> lockGuard(tickMutex_);
+
+	const auto start = std::chrono::steady_clock::now();
+
+	for (auto& lane : lanes_)
+	{
+		bool first = true;
+		Work work;
+
+		while (pop(*lane, work))
+		{
+			const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+			const auto cost = (work.cost.count() > 0 ? work.cost : lane->averageCost);
+
+			// Keep it for the next frame if it doesn't fit in what's left of the budget
+			if (!first && elapsed + cost > budget)
+			{
+				lane->deferred = std::move(work);
+				lane->hasDeferred = true;
+				break;
+			}
+
+			run(*lane, work);
+			first = false;
+		}
 	}
 }
 
+bool OpenGlLoader::pop(Lane& lane, Work& work)
+{
+	if (lane.hasDeferred)
+	{
+		work = std::move(lane.deferred);
+		lane.hasDeferred = false;
+		return true;
+	}
+
+	if (lane.ringBuffer.tryPop(work))
+	{
+		return true;
+	}
+
+	if (lane.overflowCount.load(std::memory_order_acquire) != 0)
+	{
+		std::lock_guard<std::mutex> lockGuard(lane.overflowMutex);
+
+		work = std::move(lane.overflow.front());
+		lane.overflow.pop_front();
+		--lane.overflowCount;
+
+		return true;
+	}
+
+	return false;
+}
+
+void OpenGlLoader::run(Lane& lane, Work& work)
+{
+	PROFILE_ZONE("OpenGlLoader::run");
+
+	const auto start = std::chrono::steady_clock::now();
+
+	work.task();
+
+	--workQueueCount_;
+
+	// Exponential moving average, used as the cost of work posted without an estimate
+	const auto cost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+	lane.averageCost = (lane.averageCost * 7 + cost) / 8;
+
+	static auto& workTime = Metrics::instance().histogram("opengl_loader.work_us");
+	workTime.record(static_cast<uint64>(cost.count()));
+}
+
 }
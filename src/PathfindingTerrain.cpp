@@ -2,29 +2,44 @@
 #include <glm/glm.hpp>
 
 #include "PathfindingTerrain.hpp"
-
-#include "detail/GenerateVertices.hpp"
+#include "QuadtreeTerrainMesher.hpp"
 
 namespace ice_engine
 {
 
-void PathfindingTerrain::generatePathfindingTerrain(const HeightMap& heightMap)
+namespace
+{
+
+const float32 HEIGHT_SCALE = 15.0f;
+
+}
+
+void PathfindingTerrain::generatePathfindingTerrain(const HeightGrid& heightGrid, const float32 maximumError)
 {
-    std::tie(vertices_, indices_) = detail::generateGrid(heightMap.image()->width(), heightMap.image()->height());
+    const QuadtreeTerrainMesher mesher(heightGrid, heightGrid.width(), heightGrid.length(), HEIGHT_SCALE);
+    mesher.generate(maximumError, vertices_, indices_);
 
     for (auto& v : vertices_ )
     {
-        v.y = (((float32)(heightMap.height((uint32)v.x, (uint32)v.z)) / 255.0f) * 15.0f) - 7.5f;
-        v.x = v.x - (float32)heightMap.image()->width() / 2.0f;
-        v.z = v.z - (float32)heightMap.image()->height() / 2.0f;
+        v.y = v.y - HEIGHT_SCALE / 2.0f;
+        v.x = v.x - (float32)heightGrid.width() / 2.0f;
+        v.z = v.z - (float32)heightGrid.length() / 2.0f;
     }
+}
+
+void PathfindingTerrain::generatePathfindingTerrain(const HeightGrid& heightGrid, const glm::vec3& origin, const float32 maximumError)
+{
+    if (heightGrid.empty()) return;
 
-    for (int i=1; i < indices_.size()-1; i+=3)
+    const QuadtreeTerrainMesher mesher(heightGrid, heightGrid.width() - 1, heightGrid.length() - 1, HEIGHT_SCALE);
+    mesher.generate(maximumError, vertices_, indices_);
+
+    for (auto& v : vertices_ )
     {
-        uint32 temp = indices_[i-1];
-        indices_[i-1] = indices_[i+1];
-        indices_[i+1] = temp;
+        v.y = origin.y + v.y - HEIGHT_SCALE / 2.0f;
+        v.x = origin.x + v.x;
+        v.z = origin.z + v.z;
     }
 }
 
-}
\ No newline at end of file
+}
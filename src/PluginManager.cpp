@@ -1,5 +1,6 @@
 #include <iterator>
 #include <vector>
+#include <chrono>
 
 #include <boost/dll/import.hpp>
 
@@ -33,6 +34,8 @@ PluginManager::PluginManager(utilities::Properties* properties, fs::IFileSystem*
 		fileSystem_(fileSystem),
 		logger_(logger)
 {
+	const auto begin = std::chrono::high_resolution_clock::now();
+
 	LOG_INFO(logger_, "Loading plugins.");
 	
 	LOG_INFO(logger_, "Loading image resource importer plugins.");
@@ -184,7 +187,10 @@ PluginManager::PluginManager(utilities::Properties* properties, fs::IFileSystem*
 
 	LOG_INFO(logger_, "Finished loading scripting engine binding plugins.");
 
-	LOG_INFO(logger_, "Finished loading plugins.");
+	// Plugins load one after another - the dynamic loader holds a global lock while it loads a library anyway
+	const std::chrono::duration<float32> duration = std::chrono::high_resolution_clock::now() - begin;
+
+	LOG_INFO(logger_, "Finished loading plugins in %s ms.", duration.count() * 1000.0f);
 }
 
 const std::vector<std::shared_ptr<IGuiPlugin>>& PluginManager::getGuiPlugins() const
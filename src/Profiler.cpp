@@ -0,0 +1,345 @@
+#include <algorithm>
+#include <cmath>
+
+#include "Profiler.hpp"
+
+#include "exceptions/RuntimeException.hpp"
+
+#include "detail/Format.hpp"
+
+namespace ice_engine
+{
+
+namespace
+{
+
+std::atomic<uint64> nextProfilerId{1};
+
+void writeJsonString(std::ostream& stream, const std::string& value)
+{
+	stream << '"';
+
+	for (const char c : value)
+	{
+		if (c == '"' || c == '\\') stream << '\\' << c;
+		else if (static_cast<unsigned char>(c) < 0x20) stream << ' ';
+		else stream << c;
+	}
+
+	stream << '"';
+}
+
+}
+
+Profiler::Profiler(const ProfilerSettings& profilerSettings) : id_(nextProfilerId.fetch_add(1))
+{
+	initialize(profilerSettings);
+}
+
+Profiler::~Profiler() = default;
+
+Profiler& Profiler::instance()
+{
+	static Profiler profiler;
+
+	return profiler;
+}
+
+void Profiler::initialize(const ProfilerSettings& profilerSettings)
+{
+	if (profilerSettings.threadBufferSize < 2 || (profilerSettings.threadBufferSize & (profilerSettings.threadBufferSize - 1)) != 0)
+	{
+		throw RuntimeException(detail::format("Profiler thread buffer size must be a power of 2 - got %s.", profilerSettings.threadBufferSize));
+	}
+
+	if (profilerSettings.traceEvents == 0 || profilerSettings.histogramSamples == 0)
+	{
+		throw RuntimeException(detail::format("Profiler needs room for at least one trace event and histogram sample - got %s and %s.", profilerSettings.traceEvents, profilerSettings.histogramSamples));
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		profilerSettings_ = profilerSettings;
+
+		// Zone ids are baked into the PROFILE_ZONE call sites, so zones are kept - only what they recorded goes
+		for (auto& zone : zones_)
+		{
+			zone.samples.clear();
+			zone.nextSample = 0;
+			zone.buckets.fill(0);
+			zone.statistics = ProfileZoneStatistics();
+		}
+
+		trace_.clear();
+		nextTraceEvent_ = 0;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(threadBuffersMutex_);
+
+		threadBuffers_.clear();
+		id_ = nextProfilerId.fetch_add(1);
+	}
+
+	setEnabled(profilerSettings.enabled);
+}
+
+void Profiler::setEnabled(const bool enabled)
+{
+	enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+uint32 Profiler::zone(const std::string& name)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	const auto it = zoneIds_.find(name);
+	if (it != zoneIds_.end()) return it->second;
+
+	const uint32 id = static_cast<uint32>(zones_.size());
+
+	zones_.emplace_back();
+	zones_.back().name = name;
+	zoneIds_[name] = id;
+
+	return id;
+}
+
+void Profiler::setThreadName(const std::string& name)
+{
+	auto& buffer = threadBuffer();
+
+	std::lock_guard<std::mutex> lock(threadBuffersMutex_);
+
+	buffer.name = name;
+}
+
+void Profiler::record(const uint32 zone, const int64 begin, const int64 end)
+{
+	auto& buffer = threadBuffer();
+
+	Event event;
+	event.zone = zone;
+	event.begin = begin;
+	event.end = end;
+
+	if (!buffer.events.tryPush(event))
+	{
+		buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void Profiler::collect()
+{
+	std::vector<std::shared_ptr<ThreadBuffer>> threadBuffers;
+
+	{
+		std::lock_guard<std::mutex> lock(threadBuffersMutex_);
+		threadBuffers = threadBuffers_;
+	}
+
+	// Holding the lock for the whole drain also keeps this the buffers' only consumer
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	const uint32 traceEvents = profilerSettings_.traceEvents;
+
+	for (auto& threadBuffer : threadBuffers)
+	{
+		Event event;
+
+		while (threadBuffer->events.tryPop(event))
+		{
+			if (event.zone >= zones_.size()) continue;
+
+			addSample(zones_[event.zone], event.end - event.begin);
+
+			const TraceEvent traceEvent = {event.zone, threadBuffer->threadId, event.begin, event.end};
+
+			if (trace_.size() < traceEvents)
+			{
+				trace_.push_back(traceEvent);
+			}
+			else
+			{
+				trace_[nextTraceEvent_] = traceEvent;
+				nextTraceEvent_ = (nextTraceEvent_ + 1) % traceEvents;
+			}
+		}
+	}
+}
+
+const ProfileZoneStatistics& Profiler::statistics(const std::string& name)
+{
+	static const ProfileZoneStatistics EMPTY;
+
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	const auto it = zoneIds_.find(name);
+	if (it == zoneIds_.end()) return EMPTY;
+
+	auto& zone = zones_[it->second];
+	auto& statistics = zone.statistics;
+
+	statistics = ProfileZoneStatistics();
+
+	if (zone.samples.empty()) return statistics;
+
+	auto samples = zone.samples;
+	std::sort(samples.begin(), samples.end());
+
+	auto milliseconds = [](const int64 nanoseconds) {
+		return static_cast<float32>(static_cast<float64>(nanoseconds) / 1000000.0);
+	};
+
+	auto percentile = [&samples, &milliseconds](const float64 p) {
+		const size_t index = std::min(samples.size() - 1, static_cast<size_t>(std::ceil(p * static_cast<float64>(samples.size()))) - 1);
+		return milliseconds(samples[index]);
+	};
+
+	int64 total = 0;
+	for (const int64 sample : samples) total += sample;
+
+	statistics.count = static_cast<uint32>(samples.size());
+	statistics.mean = milliseconds(total) / static_cast<float32>(samples.size());
+	statistics.minimum = milliseconds(samples.front());
+	statistics.maximum = milliseconds(samples.back());
+	statistics.median = percentile(0.5);
+	statistics.percentile95 = percentile(0.95);
+	statistics.percentile99 = percentile(0.99);
+
+	return statistics;
+}
+
+std::vector<uint32> Profiler::histogram(const std::string& name) const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	const auto it = zoneIds_.find(name);
+	if (it == zoneIds_.end()) return std::vector<uint32>(NUMBER_OF_BUCKETS, 0);
+
+	const auto& buckets = zones_[it->second].buckets;
+
+	return std::vector<uint32>(buckets.begin(), buckets.end());
+}
+
+float32 Profiler::bucketLimit(const uint32 bucket)
+{
+	// Buckets grow by a factor of the square root of 2, from 1 microsecond to about 33 milliseconds
+	return std::pow(2.0f, static_cast<float32>(bucket) * 0.5f);
+}
+
+void Profiler::exportChromeTrace(std::ostream& stream) const
+{
+	std::vector<std::pair<uint32, std::string>> threadNames;
+
+	{
+		std::lock_guard<std::mutex> lock(threadBuffersMutex_);
+
+		for (const auto& threadBuffer : threadBuffers_)
+		{
+			if (!threadBuffer->name.empty()) threadNames.emplace_back(threadBuffer->threadId, threadBuffer->name);
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	int64 origin = 0;
+	if (!trace_.empty())
+	{
+		origin = std::min_element(trace_.begin(), trace_.end(), [](const TraceEvent& a, const TraceEvent& b) { return a.begin < b.begin; })->begin;
+	}
+
+	stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+	bool first = true;
+
+	for (const auto& threadName : threadNames)
+	{
+		if (!first) stream << ",";
+		first = false;
+
+		stream << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << threadName.first << ",\"args\":{\"name\":";
+		writeJsonString(stream, threadName.second);
+		stream << "}}";
+	}
+
+	// Oldest first - once the trace has wrapped, the oldest event is the next one to be overwritten
+	for (size_t i = 0; i < trace_.size(); ++i)
+	{
+		const auto& traceEvent = trace_[(nextTraceEvent_ + i) % trace_.size()];
+
+		if (!first) stream << ",";
+		first = false;
+
+		// Chrome trace times are in microseconds
+		stream << "\n{\"name\":";
+		writeJsonString(stream, zones_[traceEvent.zone].name);
+		stream << ",\"cat\":\"ice_engine\",\"ph\":\"X\",\"pid\":0,\"tid\":" << traceEvent.threadId
+			<< ",\"ts\":" << static_cast<float64>(traceEvent.begin - origin) / 1000.0
+			<< ",\"dur\":" << static_cast<float64>(traceEvent.end - traceEvent.begin) / 1000.0 << "}";
+	}
+
+	stream << "\n]}\n";
+}
+
+uint64 Profiler::droppedEvents() const
+{
+	std::lock_guard<std::mutex> lock(threadBuffersMutex_);
+
+	uint64 dropped = 0;
+	for (const auto& threadBuffer : threadBuffers_)
+	{
+		dropped += threadBuffer->dropped.load(std::memory_order_relaxed);
+	}
+
+	return dropped;
+}
+
+Profiler::ThreadBuffer& Profiler::threadBuffer()
+{
+	// A thread records into one profiler at a time, so a single cached buffer per thread is enough
+	thread_local uint64 profilerId = 0;
+	thread_local std::shared_ptr<ThreadBuffer> buffer;
+
+	if (profilerId != id_.load(std::memory_order_acquire))
+	{
+		std::lock_guard<std::mutex> lock(threadBuffersMutex_);
+
+		profilerId = id_.load(std::memory_order_relaxed);
+		buffer = std::make_shared<ThreadBuffer>(profilerSettings_.threadBufferSize, static_cast<uint32>(threadBuffers_.size()) + 1);
+		threadBuffers_.push_back(buffer);
+	}
+
+	return *buffer;
+}
+
+void Profiler::addSample(Zone& zone, const int64 duration)
+{
+	if (zone.samples.size() < profilerSettings_.histogramSamples)
+	{
+		zone.samples.push_back(duration);
+	}
+	else
+	{
+		// The window is full - the oldest sample makes room
+		--zone.buckets[bucket(zone.samples[zone.nextSample])];
+		zone.samples[zone.nextSample] = duration;
+		zone.nextSample = (zone.nextSample + 1) % profilerSettings_.histogramSamples;
+	}
+
+	++zone.buckets[bucket(duration)];
+}
+
+uint32 Profiler::bucket(const int64 duration)
+{
+	const float64 microseconds = static_cast<float64>(duration) / 1000.0;
+
+	if (microseconds <= 1.0) return 0;
+
+	const auto b = static_cast<uint32>(std::ceil(2.0 * std::log2(microseconds)));
+
+	return std::min(b, NUMBER_OF_BUCKETS - 1);
+}
+
+}
@@ -0,0 +1,413 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <tuple>
+
+#include "QuadtreeTerrainMesher.hpp"
+
+namespace ice_engine
+{
+
+namespace
+{
+
+const uint32 NO_VERTEX = std::numeric_limits<uint32>::max();
+
+struct Point
+{
+	float32 x;
+	float32 z;
+	float32 height;
+};
+
+// Height of the plane through a, b and c at (x, z)
+float32 interpolate(const float32 x, const float32 z, const Point& a, const Point& b, const Point& c)
+{
+	const float32 determinant = (b.z - c.z) * (a.x - c.x) + (c.x - b.x) * (a.z - c.z);
+
+	const float32 wa = ((b.z - c.z) * (x - c.x) + (c.x - b.x) * (z - c.z)) / determinant;
+	const float32 wb = ((c.z - a.z) * (x - c.x) + (a.x - c.x) * (z - c.z)) / determinant;
+
+	return wa * a.height + wb * b.height + (1.0f - wa - wb) * c.height;
+}
+
+class MeshBuilder
+{
+public:
+	MeshBuilder(const uint32 cellsX, const uint32 cellsZ, std::vector<glm::vec3>& vertices, std::vector<uint32>& indices)
+		:
+		cellsX_(cellsX),
+		vertexIndices_((static_cast<size_t>(cellsX) + 1) * (static_cast<size_t>(cellsZ) + 1), NO_VERTEX),
+		vertices_(vertices),
+		indices_(indices)
+	{
+		vertices_.clear();
+		indices_.clear();
+	}
+
+	template <typename HeightFunction>
+	uint32 vertex(const uint32 x, const uint32 z, const HeightFunction& height)
+	{
+		uint32& index = vertexIndices_[static_cast<size_t>(z) * (cellsX_ + 1) + x];
+
+		if (index == NO_VERTEX)
+		{
+			index = static_cast<uint32>(vertices_.size());
+			vertices_.push_back(glm::vec3(static_cast<float32>(x), height(x, z), static_cast<float32>(z)));
+		}
+
+		return index;
+	}
+
+	// a, b, c must be counter clockwise seen from above
+	void triangle(const uint32 a, const uint32 b, const uint32 c)
+	{
+		indices_.push_back(a);
+		indices_.push_back(b);
+		indices_.push_back(c);
+	}
+
+private:
+	uint32 cellsX_;
+	std::vector<uint32> vertexIndices_;
+	std::vector<glm::vec3>& vertices_;
+	std::vector<uint32>& indices_;
+};
+
+}
+
+QuadtreeTerrainMesher::QuadtreeTerrainMesher(const HeightGrid& heightGrid, const uint32 cellsX, const uint32 cellsZ, const float32 heightScale)
+	:
+	cellsX_(cellsX),
+	cellsZ_(cellsZ)
+{
+	while (rootSize_ < std::max(cellsX_, cellsZ_))
+	{
+		rootSize_ *= 2;
+		++leafLevel_;
+	}
+
+	heights_.resize((static_cast<size_t>(cellsX_) + 1) * (static_cast<size_t>(cellsZ_) + 1));
+
+	for (uint32 z = 0; z <= cellsZ_; ++z)
+	{
+		for (uint32 x = 0; x <= cellsX_; ++x)
+		{
+			heights_[static_cast<size_t>(z) * (cellsX_ + 1) + x] = heightGrid.height(x, z) * heightScale;
+		}
+	}
+
+	nodes_.resize(leafLevel_);
+	for (uint32 level = 0; level < leafLevel_; ++level)
+	{
+		nodes_[level].resize(static_cast<size_t>(1) << (2 * level));
+	}
+
+	computeErrors();
+}
+
+void QuadtreeTerrainMesher::generate(const float32 maximumError, std::vector<glm::vec3>& vertices, std::vector<uint32>& indices) const
+{
+	generate([maximumError](const uint32 level, const uint32 i, const uint32 j, const Node& node) {
+		return maximumError;
+	}, vertices, indices);
+}
+
+void QuadtreeTerrainMesher::generate(const glm::vec3& viewer, const float32 maximumError, const float32 errorPerDistance, std::vector<glm::vec3>& vertices, std::vector<uint32>& indices) const
+{
+	// The distance to a node's bounding box never decreases from parent to child, so neither does the threshold - which
+	// keeps the saturated errors meaningful
+	generate([this, &viewer, maximumError, errorPerDistance](const uint32 level, const uint32 i, const uint32 j, const Node& node) {
+		const float32 size = static_cast<float32>(rootSize_ >> level);
+
+		const glm::vec3 minimum = glm::vec3(static_cast<float32>(i) * size, node.minimumHeight, static_cast<float32>(j) * size);
+		const glm::vec3 maximum = glm::vec3(minimum.x + size, node.maximumHeight, minimum.z + size);
+
+		const float32 dx = std::max(std::max(minimum.x - viewer.x, viewer.x - maximum.x), 0.0f);
+		const float32 dy = std::max(std::max(minimum.y - viewer.y, viewer.y - maximum.y), 0.0f);
+		const float32 dz = std::max(std::max(minimum.z - viewer.z, viewer.z - maximum.z), 0.0f);
+
+		return maximumError + errorPerDistance * std::sqrt(dx * dx + dy * dy + dz * dz);
+	}, vertices, indices);
+}
+
+template <typename Threshold>
+void QuadtreeTerrainMesher::generate(const Threshold& threshold, std::vector<glm::vec3>& vertices, std::vector<uint32>& indices) const
+{
+	vertices.clear();
+	indices.clear();
+
+	if (cellsX_ == 0 || cellsZ_ == 0) return;
+
+	// Which nodes above the leaf level are split, and lists of the split nodes of each level
+	std::vector<std::vector<uint8>> split(leafLevel_);
+	std::vector<std::vector<std::pair<uint32, uint32>>> splitNodes(leafLevel_);
+
+	for (uint32 level = 0; level < leafLevel_; ++level)
+	{
+		split[level].resize(nodes_[level].size(), 0);
+	}
+
+	auto splitIndex = [](const uint32 level, const uint32 i, const uint32 j) {
+		return (static_cast<size_t>(j) << level) + i;
+	};
+
+	auto markSplit = [&](const uint32 level, const uint32 i, const uint32 j) {
+		split[level][splitIndex(level, i, j)] = 1;
+		splitNodes[level].push_back(std::make_pair(i, j));
+	};
+
+	// Split top down wherever the error is too large - nodes straddling the edge of the grid are always split, so that
+	// leaves are entirely inside or outside of it
+	std::vector<std::tuple<uint32, uint32, uint32>> stack;
+	stack.push_back(std::make_tuple(0, 0, 0));
+
+	while (!stack.empty())
+	{
+		uint32 level, i, j;
+		std::tie(level, i, j) = stack.back();
+		stack.pop_back();
+
+		if (level == leafLevel_) continue;
+
+		const bool straddles = !inside(level, i, j);
+
+		if (straddles || nodes_[level][splitIndex(level, i, j)].error > threshold(level, i, j, nodes_[level][splitIndex(level, i, j)]))
+		{
+			markSplit(level, i, j);
+
+			for (uint32 child = 0; child < 4; ++child)
+			{
+				const uint32 childI = i * 2 + (child & 1);
+				const uint32 childJ = j * 2 + (child >> 1);
+
+				if (!outside(level + 1, childI, childJ)) stack.push_back(std::make_tuple(level + 1, childI, childJ));
+			}
+		}
+	}
+
+	// Restrict the quadtree bottom up - a split node's neighbours on the same level must exist, so that no leaf borders
+	// a leaf more than one level finer than itself
+	for (uint32 level = leafLevel_ > 0 ? leafLevel_ - 1 : 0; level > 0; --level)
+	{
+		for (size_t n = 0; n < splitNodes[level].size(); ++n)
+		{
+			const int64 i = splitNodes[level][n].first;
+			const int64 j = splitNodes[level][n].second;
+
+			const int64 neighbours[4][2] = {{i - 1, j}, {i + 1, j}, {i, j - 1}, {i, j + 1}};
+
+			for (const auto& neighbour : neighbours)
+			{
+				if (outside(level, neighbour[0], neighbour[1])) continue;
+
+				uint32 parentLevel = level - 1;
+				uint32 parentI = static_cast<uint32>(neighbour[0]) >> 1;
+				uint32 parentJ = static_cast<uint32>(neighbour[1]) >> 1;
+
+				// Split the neighbour's parent, and its ancestors
+				while (!split[parentLevel][splitIndex(parentLevel, parentI, parentJ)])
+				{
+					markSplit(parentLevel, parentI, parentJ);
+
+					if (parentLevel == 0) break;
+
+					--parentLevel;
+					parentI >>= 1;
+					parentJ >>= 1;
+				}
+			}
+		}
+	}
+
+	auto isSplit = [&](const uint32 level, const int64 i, const int64 j) {
+		return level < leafLevel_ && !outside(level, i, j) && split[level][splitIndex(level, static_cast<uint32>(i), static_cast<uint32>(j))];
+	};
+
+	MeshBuilder builder(cellsX_, cellsZ_, vertices, indices);
+	auto heightFunction = [this](const uint32 x, const uint32 z) { return height(x, z); };
+
+	stack.push_back(std::make_tuple(0, 0, 0));
+
+	while (!stack.empty())
+	{
+		uint32 level, i, j;
+		std::tie(level, i, j) = stack.back();
+		stack.pop_back();
+
+		if (isSplit(level, i, j))
+		{
+			for (uint32 child = 0; child < 4; ++child)
+			{
+				const uint32 childI = i * 2 + (child & 1);
+				const uint32 childJ = j * 2 + (child >> 1);
+
+				if (!outside(level + 1, childI, childJ)) stack.push_back(std::make_tuple(level + 1, childI, childJ));
+			}
+
+			continue;
+		}
+
+		const uint32 size = rootSize_ >> level;
+		const uint32 x0 = i * size;
+		const uint32 z0 = j * size;
+		const uint32 x1 = x0 + size;
+		const uint32 z1 = z0 + size;
+
+		if (size == 1)
+		{
+			const uint32 a = builder.vertex(x0, z0, heightFunction);
+			const uint32 b = builder.vertex(x1, z0, heightFunction);
+			const uint32 c = builder.vertex(x1, z1, heightFunction);
+			const uint32 d = builder.vertex(x0, z1, heightFunction);
+
+			builder.triangle(a, c, b);
+			builder.triangle(a, d, c);
+
+			continue;
+		}
+
+		// Fan around the center, through the corners and the midpoints of edges shared with smaller leaves
+		const uint32 half = size / 2;
+		const uint32 center = builder.vertex(x0 + half, z0 + half, heightFunction);
+
+		uint32 ring[8];
+		uint32 ringSize = 0;
+
+		ring[ringSize++] = builder.vertex(x0, z0, heightFunction);
+		if (isSplit(level, static_cast<int64>(i), static_cast<int64>(j) - 1)) ring[ringSize++] = builder.vertex(x0 + half, z0, heightFunction);
+		ring[ringSize++] = builder.vertex(x1, z0, heightFunction);
+		if (isSplit(level, static_cast<int64>(i) + 1, static_cast<int64>(j))) ring[ringSize++] = builder.vertex(x1, z0 + half, heightFunction);
+		ring[ringSize++] = builder.vertex(x1, z1, heightFunction);
+		if (isSplit(level, static_cast<int64>(i), static_cast<int64>(j) + 1)) ring[ringSize++] = builder.vertex(x0 + half, z1, heightFunction);
+		ring[ringSize++] = builder.vertex(x0, z1, heightFunction);
+		if (isSplit(level, static_cast<int64>(i) - 1, static_cast<int64>(j))) ring[ringSize++] = builder.vertex(x0, z0 + half, heightFunction);
+
+		for (uint32 n = 0; n < ringSize; ++n)
+		{
+			builder.triangle(center, ring[(n + 1) % ringSize], ring[n]);
+		}
+	}
+}
+
+float32 QuadtreeTerrainMesher::height(const uint32 x, const uint32 z) const
+{
+	return heights_[static_cast<size_t>(z) * (cellsX_ + 1) + x];
+}
+
+bool QuadtreeTerrainMesher::inside(const uint32 level, const int64 i, const int64 j) const
+{
+	const int64 size = rootSize_ >> level;
+
+	return i >= 0 && j >= 0 && (i + 1) * size <= cellsX_ && (j + 1) * size <= cellsZ_;
+}
+
+bool QuadtreeTerrainMesher::outside(const uint32 level, const int64 i, const int64 j) const
+{
+	const int64 size = rootSize_ >> level;
+
+	const int64 count = int64(1) << level;
+
+	return i < 0 || j < 0 || i >= count || j >= count || i * size >= cellsX_ || j * size >= cellsZ_;
+}
+
+void QuadtreeTerrainMesher::computeErrors()
+{
+	// Finest level first, so nodes can saturate their error with their children's
+	for (uint32 level = leafLevel_; level-- > 0;)
+	{
+		const uint32 count = 1u << level;
+
+		for (uint32 j = 0; j < count; ++j)
+		{
+			for (uint32 i = 0; i < count; ++i)
+			{
+				if (inside(level, i, j)) computeNodeError(level, i, j);
+			}
+		}
+	}
+}
+
+void QuadtreeTerrainMesher::computeNodeError(const uint32 level, const uint32 i, const uint32 j)
+{
+	const uint32 size = rootSize_ >> level;
+	const uint32 half = size / 2;
+	const uint32 x0 = i * size;
+	const uint32 z0 = j * size;
+	const uint32 x1 = x0 + size;
+	const uint32 z1 = z0 + size;
+	const int64 centerX = x0 + half;
+	const int64 centerZ = z0 + half;
+
+	auto point = [this](const uint32 x, const uint32 z) {
+		return Point{static_cast<float32>(x), static_cast<float32>(z), height(x, z)};
+	};
+
+	const Point center = point(x0 + half, z0 + half);
+	const Point a = point(x0, z0);
+	const Point b = point(x1, z0);
+	const Point c = point(x1, z1);
+	const Point d = point(x0, z1);
+
+	// Edges as (start, end, midpoint)
+	const Point edges[4][3] = {
+		{a, b, point(x0 + half, z0)},
+		{b, c, point(x1, z0 + half)},
+		{d, c, point(x0 + half, z1)},
+		{a, d, point(x0, z0 + half)}
+	};
+
+	Node& node = nodes_[level][(static_cast<size_t>(j) << level) + i];
+	node.error = 0.0f;
+	node.minimumHeight = std::numeric_limits<float32>::max();
+	node.maximumHeight = std::numeric_limits<float32>::lowest();
+
+	for (uint32 z = z0; z <= z1; ++z)
+	{
+		for (uint32 x = x0; x <= x1; ++x)
+		{
+			const float32 h = height(x, z);
+
+			node.minimumHeight = std::min(node.minimumHeight, h);
+			node.maximumHeight = std::max(node.maximumHeight, h);
+
+			// The fan triangle(s) the sample falls in - the error has to hold whether or not the edge midpoint is used
+			const int64 dx = static_cast<int64>(x) - centerX;
+			const int64 dz = static_cast<int64>(z) - centerZ;
+
+			uint32 edge;
+			bool startSide;
+
+			if (dz <= -std::abs(dx)) { edge = 0; startSide = dx <= 0; }
+			else if (dx >= std::abs(dz)) { edge = 1; startSide = dz <= 0; }
+			else if (dz >= std::abs(dx)) { edge = 2; startSide = dx <= 0; }
+			else { edge = 3; startSide = dz <= 0; }
+
+			const Point& start = edges[edge][0];
+			const Point& end = edges[edge][1];
+			const Point& midpoint = edges[edge][2];
+
+			const float32 fx = static_cast<float32>(x);
+			const float32 fz = static_cast<float32>(z);
+
+			const float32 whole = interpolate(fx, fz, center, start, end);
+			const float32 halved = startSide ? interpolate(fx, fz, center, start, midpoint) : interpolate(fx, fz, center, midpoint, end);
+
+			node.error = std::max(node.error, std::max(std::abs(h - whole), std::abs(h - halved)));
+		}
+	}
+
+	// Saturate with the children (single cell children are exact)
+	if (level + 1 < leafLevel_)
+	{
+		for (uint32 child = 0; child < 4; ++child)
+		{
+			const uint32 childI = i * 2 + (child & 1);
+			const uint32 childJ = j * 2 + (child >> 1);
+
+			node.error = std::max(node.error, nodes_[level + 1][(static_cast<size_t>(childJ) << (level + 1)) + childI].error);
+		}
+	}
+}
+
+}
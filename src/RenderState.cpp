@@ -0,0 +1,144 @@
+#include "RenderState.hpp"
+
+namespace ice_engine
+{
+
+void RenderState::position(const graphics::RenderSceneHandle& renderSceneHandle, const graphics::RenderableHandle& renderableHandle, const glm::vec3& position)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	auto& transform = back().transforms[std::make_pair(renderSceneHandle, renderableHandle)];
+	transform.hasPosition = true;
+	transform.position = position;
+}
+
+void RenderState::rotation(const graphics::RenderSceneHandle& renderSceneHandle, const graphics::RenderableHandle& renderableHandle, const glm::quat& orientation)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	auto& transform = back().transforms[std::make_pair(renderSceneHandle, renderableHandle)];
+	transform.hasOrientation = true;
+	transform.orientation = orientation;
+}
+
+void RenderState::position(const graphics::RenderSceneHandle& renderSceneHandle, const graphics::PointLightHandle& pointLightHandle, const glm::vec3& position)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	back().pointLights[std::make_pair(renderSceneHandle, pointLightHandle)] = position;
+}
+
+void RenderState::update(
+	const graphics::RenderSceneHandle& renderSceneHandle,
+	const graphics::RenderableHandle& renderableHandle,
+	const graphics::BonesHandle& bonesHandle,
+	const BonePaletteArena::Palette& palette
+)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	auto& bonePaletteUpdate = back().bonePalettes[std::make_pair(renderSceneHandle, renderableHandle)];
+
+	// Animation work finishes in any order - a palette from an earlier tick must not replace a later one
+	if (bonePaletteUpdate.palette.transformations == nullptr || palette.frame >= bonePaletteUpdate.palette.frame)
+	{
+		bonePaletteUpdate.bonesHandle = bonesHandle;
+		bonePaletteUpdate.palette = palette;
+	}
+}
+
+void RenderState::destroy(const graphics::RenderSceneHandle& renderSceneHandle, const graphics::RenderableHandle& renderableHandle)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	back().destroyedRenderables.push_back(std::make_pair(renderSceneHandle, renderableHandle));
+}
+
+void RenderState::destroy(const graphics::RenderSceneHandle& renderSceneHandle, const graphics::PointLightHandle& pointLightHandle)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	back().destroyedPointLights.push_back(std::make_pair(renderSceneHandle, pointLightHandle));
+}
+
+void RenderState::swap()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	back_ = 1 - back_;
+	back().clear();
+}
+
+void RenderState::apply(graphics::IGraphicsEngine* graphicsEngine, const BonePaletteArena& bonePaletteArena) const
+{
+	const auto& buffer = front();
+
+	// Renderables and lights are created straight away but destroyed here, so one may have been destroyed (and its
+	// handle reused with a newer version) since it was written - only handles that are still valid are touched
+	for (const auto& entry : buffer.transforms)
+	{
+		if (!graphicsEngine->valid(entry.first.first, entry.first.second)) continue;
+
+		const auto& transform = entry.second;
+
+		if (transform.hasPosition) graphicsEngine->position(entry.first.first, entry.first.second, transform.position);
+		if (transform.hasOrientation) graphicsEngine->rotation(entry.first.first, entry.first.second, transform.orientation);
+	}
+
+	for (const auto& entry : buffer.pointLights)
+	{
+		if (!graphicsEngine->valid(entry.first.first, entry.first.second)) continue;
+
+		graphicsEngine->position(entry.first.first, entry.first.second, entry.second);
+	}
+
+	for (const auto& entry : buffer.bonePalettes)
+	{
+		const auto& bonePaletteUpdate = entry.second;
+
+		if (bonePaletteArena.valid(bonePaletteUpdate.palette) && graphicsEngine->valid(entry.first.first, entry.first.second))
+		{
+			graphicsEngine->update(entry.first.first, entry.first.second, bonePaletteUpdate.bonesHandle, bonePaletteUpdate.palette.transformations, bonePaletteUpdate.palette.size);
+		}
+	}
+
+	for (const auto& key : buffer.destroyedRenderables)
+	{
+		if (graphicsEngine->valid(key.first, key.second)) graphicsEngine->destroy(key.first, key.second);
+	}
+
+	for (const auto& key : buffer.destroyedPointLights)
+	{
+		if (graphicsEngine->valid(key.first, key.second)) graphicsEngine->destroy(key.first, key.second);
+	}
+}
+
+uint32 RenderState::size() const
+{
+	const auto& buffer = front();
+
+	return static_cast<uint32>(
+		buffer.transforms.size() + buffer.bonePalettes.size() + buffer.pointLights.size() + buffer.destroyedRenderables.size() + buffer.destroyedPointLights.size()
+	);
+}
+
+void RenderState::Buffer::clear()
+{
+	transforms.clear();
+	bonePalettes.clear();
+	pointLights.clear();
+	destroyedRenderables.clear();
+	destroyedPointLights.clear();
+}
+
+RenderState::Buffer& RenderState::back()
+{
+	return buffers_[back_];
+}
+
+const RenderState::Buffer& RenderState::front() const
+{
+	return buffers_[1 - back_];
+}
+
+}
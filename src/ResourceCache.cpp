@@ -1,4 +1,5 @@
 #include "ResourceCache.hpp"
+#include "Metrics.hpp"
 
 namespace ice_engine
 {
@@ -13,6 +14,9 @@ void ResourceCache::addAudio(const std::string& name, std::unique_ptr<Audio> aud
 	}
 	
 	audios_[name] = std::move(audio);
+
+	static auto& added = Metrics::instance().counter("resource_cache.audio_added");
+	added.increment();
 }
 
 void ResourceCache::addImage(const std::string& name, std::unique_ptr<Image> image)
@@ -25,6 +29,9 @@ void ResourceCache::addImage(const std::string& name, std::unique_ptr<Image> ima
 	}
 	
 	images_[name] = std::move(image);
+
+	static auto& added = Metrics::instance().counter("resource_cache.image_added");
+	added.increment();
 }
 
 void ResourceCache::addModel(const std::string& name, std::unique_ptr<Model> model)
@@ -37,6 +44,9 @@ void ResourceCache::addModel(const std::string& name, std::unique_ptr<Model> mod
 	}
 	
 	models_[name] = std::move(model);
+
+	static auto& added = Metrics::instance().counter("resource_cache.model_added");
+	added.increment();
 }
 
 void ResourceCache::removeAudio(const std::string& name)
@@ -1,4 +1,8 @@
 #include <chrono>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <limits>
 #include <fstream>
 #include <sstream>
 
@@ -12,14 +16,22 @@
 #include <glm/gtx/string_cast.hpp>
 
 #include "Scene.hpp"
+#include "SceneSnapshot.hpp"
+
+#include "serialization/BinaryOutArchive.hpp"
+#include "serialization/BinaryInArchive.hpp"
 
 #include "ecs/EntityComponentSystem.hpp"
 #include "EntityComponentSystemEventListener.hpp"
 
+#include "replication/ApplyEntityState.hpp"
+
 #include "IceEngineMotionChangeListener.hpp"
 #include "IceEnginePathfindingAgentMotionChangeListener.hpp"
 #include "IceEnginePathfindingAgentStateChangeListener.hpp"
 #include "IceEnginePathfindingMovementRequestStateChangeListener.hpp"
+#include "Profiler.hpp"
+#include "Metrics.hpp"
 
 #include "detail/Format.hpp"
 
@@ -28,53 +40,58 @@ namespace ice_engine
 
 namespace
 {
-class QueryVisitor :  public boost::static_visitor<>
+// Physics and pathfinding objects are tagged with their entity's index and version, which is enough to find the
+// entity again (and to tell if it has since been destroyed) without any type checks or allocations
+template <typename UserTag>
+UserTag userTag(const ecs::Entity& entity)
+{
+	return UserTag(entity.id().index(), entity.id().version());
+}
+
+template <typename UserTag>
+bool entityFromUserTag(ecs::EntityComponentSystem& entityComponentSystem, const UserTag& userTag, ecs::Entity& entity)
+{
+	if (!userTag)
+	{
+		return false;
+	}
+
+	const entityx::Entity::Id id(userTag.index, userTag.version);
+
+	if (!entityComponentSystem.valid(id))
+	{
+		return false;
+	}
+
+	entity = entityComponentSystem.get(id);
+
+	return true;
+}
+
+// Looks up the user tag of a query result
+class UserTagVisitor :  public boost::static_visitor<physics::UserTag>
 {
 public:
-	QueryVisitor(
-		logger::ILogger* logger,
-		physics::IPhysicsEngine& physicsEngine,
-		physics::PhysicsSceneHandle physicsSceneHandle,
-		std::vector<ecs::Entity>& entities)
+	UserTagVisitor(physics::IPhysicsEngine& physicsEngine, physics::PhysicsSceneHandle physicsSceneHandle)
 	:
-		logger_(logger),
 		physicsEngine_(physicsEngine),
-		physicsSceneHandle_(physicsSceneHandle),
-		entities_(entities)
+		physicsSceneHandle_(physicsSceneHandle)
 	{
 	}
 
-    void operator()(const physics::RigidBodyObjectHandle& rigidBodyObjectHandle)
+    physics::UserTag operator()(const physics::RigidBodyObjectHandle& rigidBodyObjectHandle) const
     {
-    	auto userData = physicsEngine_.getUserData(physicsSceneHandle_, rigidBodyObjectHandle);
-		if (userData.type() == typeid(ecs::Entity))
-		{
-			entities_.push_back(boost::any_cast<ecs::Entity>(userData));
-		}
-		else
-		{
-			LOG_WARN(logger_, "User data was empty or was not of type Entity")
-		}
+		return physicsEngine_.getUserTag(physicsSceneHandle_, rigidBodyObjectHandle);
     }
 
-    void operator()(const physics::GhostObjectHandle& ghostObjectHandle)
+    physics::UserTag operator()(const physics::GhostObjectHandle& ghostObjectHandle) const
     {
-    	auto userData = physicsEngine_.getUserData(physicsSceneHandle_, ghostObjectHandle);
-		if (userData.type() == typeid(ecs::Entity))
-		{
-			entities_.push_back(boost::any_cast<ecs::Entity>(userData));
-		}
-		else
-		{
-			LOG_WARN(logger_, "User data was empty or was not of type Entity")
-		}
+		return physicsEngine_.getUserTag(physicsSceneHandle_, ghostObjectHandle);
     }
 
 private:
-    logger::ILogger* logger_;
 	physics::IPhysicsEngine& physicsEngine_;
 	physics::PhysicsSceneHandle physicsSceneHandle_;
-    std::vector<ecs::Entity>& entities_;
 };
 }
 
@@ -105,6 +122,7 @@ Scene::Scene(
 		logger_(logger),
 		threadPool_(gameEngine->backgroundThreadPool()),
 		openGlLoader_(gameEngine->openGlLoader()),
+		renderState_(gameEngine->renderState()),
 		entityComponentSystem_(std::make_unique<ecs::EntityComponentSystem>(this))
 {
 	initialize();
@@ -137,6 +155,7 @@ Scene::Scene(
 		logger_(logger),
 		threadPool_(gameEngine->backgroundThreadPool()),
 		openGlLoader_(gameEngine->openGlLoader()),
+		renderState_(gameEngine->renderState()),
 		entityComponentSystem_(std::make_unique<ecs::EntityComponentSystem>(this))
 {
 	initialize();
@@ -144,11 +163,33 @@ Scene::Scene(
 
 Scene::~Scene()
 {
+	waitForAsyncSave();
+
+	// Not waitForAnimations() - it rethrows, and a failed pose doesn't matter anymore
+	for (auto& work : animationWork_)
+	{
+		work.wait();
+	}
+
 	destroy();
 }
 
 void Scene::initialize()
 {
+	animationLodSettings_ = AnimationLodSettings(*properties_);
+	terrainStreamingSettings_ = TerrainStreamingSettings(*properties_);
+	binarySnapshots_ = properties_->getBoolValue("scene.binarysnapshots", true);
+	compressSnapshots_ = properties_->getBoolValue("scene.compresssnapshots", true);
+
+	spatialIndex_ = SpatialIndex(
+		glm::vec3(0.0f),
+		properties_->getFloatValue("scene.spatialindexsize", 4096.0f),
+		static_cast<uint32>(properties_->getIntValue("scene.spatialindexnodesize", 16)),
+		static_cast<uint32>(properties_->getIntValue("scene.spatialindexdepth", 10))
+	);
+
+	interpolation_ = properties_->getBoolValue("simulation.interpolation", true);
+
 	audioSceneHandle_ = audioEngine_->createAudioScene();
 	renderSceneHandle_ = graphicsEngine_->createRenderScene();
 	physicsSceneHandle_ = physicsEngine_->createPhysicsScene();
@@ -174,6 +215,9 @@ void Scene::destroy()
 {
 	LOG_DEBUG(logger_, "Destroying scene: %s", name_);
 
+	// Terrain destroys its entities and resources, so it has to go before the engine scenes
+	terrain_.clear();
+
 	audioEngine_->destroyAudioScene(audioSceneHandle_);
     graphicsEngine_->destroy(renderSceneHandle_);
     physicsEngine_->destroy(physicsSceneHandle_);
@@ -201,6 +245,8 @@ void Scene::destroy()
 
 void Scene::applyChangesToEntities()
 {
+	PROFILE_ZONE("Scene::applyChangesToEntities");
+
 	std::vector<ecs::Entity> dirtyEntities;
 	for (auto entity : entityComponentSystem_->entitiesWithComponents<ecs::DirtyComponent>())
 	{
@@ -208,6 +254,19 @@ void Scene::applyChangesToEntities()
 
 		auto dirtyComponent = entity.component<ecs::DirtyComponent>();
 
+		if (dirtyComponent->dirty & ecs::DirtyFlags::DIRTY_POSITION)
+		{
+			if (auto pc = entity.component<ecs::PositionComponent>())
+			{
+				spatialIndex_.update(entity.id().id(), pc->position);
+			}
+		}
+
+		if (interpolation_ && (dirtyComponent->dirty & (ecs::DirtyFlags::DIRTY_POSITION | ecs::DirtyFlags::DIRTY_ORIENTATION)))
+		{
+			recordInterpolatedTransform(entity);
+		}
+
 		if (dirtyComponent->dirty & ecs::DirtyFlags::DIRTY_SOURCE_SCRIPT)
 		{
 			if (dirtyComponent->dirty & ecs::DirtyFlags::DIRTY_POSITION)
@@ -216,7 +275,7 @@ void Scene::applyChangesToEntities()
 
 				if (auto graphicsComponent = entity.component<ecs::GraphicsComponent>())
 				{
-					graphicsEngine_->position(renderSceneHandle_, graphicsComponent->renderableHandle, pc->position);
+					position(graphicsComponent->renderableHandle, pc->position);
 				}
 				if (auto rigidBodyObjectComponent = entity.component<ecs::RigidBodyObjectComponent>())
 				{
@@ -233,7 +292,7 @@ void Scene::applyChangesToEntities()
 
 				if (auto graphicsComponent = entity.component<ecs::GraphicsComponent>())
 				{
-					graphicsEngine_->rotation(renderSceneHandle_, graphicsComponent->renderableHandle, oc->orientation);
+					rotation(graphicsComponent->renderableHandle, oc->orientation);
 				}
 				if (auto rigidBodyObjectComponent = entity.component<ecs::RigidBodyObjectComponent>())
 				{
@@ -296,7 +355,7 @@ void Scene::applyChangesToEntities()
 
 				if (auto graphicsComponent = entity.component<ecs::GraphicsComponent>())
 				{
-					graphicsEngine_->position(renderSceneHandle_, graphicsComponent->renderableHandle, pc->position);
+					position(graphicsComponent->renderableHandle, pc->position);
 				}
 			}
 			if (dirtyComponent->dirty & ecs::DirtyFlags::DIRTY_ORIENTATION)
@@ -305,7 +364,7 @@ void Scene::applyChangesToEntities()
 
 				if (auto graphicsComponent = entity.component<ecs::GraphicsComponent>())
 				{
-					graphicsEngine_->rotation(renderSceneHandle_, graphicsComponent->renderableHandle, oc->orientation);
+					rotation(graphicsComponent->renderableHandle, oc->orientation);
 				}
 			}
 		}
@@ -318,7 +377,7 @@ void Scene::applyChangesToEntities()
 
 				if (auto graphicsComponent = entity.component<ecs::GraphicsComponent>())
 				{
-					graphicsEngine_->position(renderSceneHandle_, graphicsComponent->renderableHandle, pc->position);
+					position(graphicsComponent->renderableHandle, pc->position);
 				}
 				if (auto ghostObjectComponent = entity.component<ecs::GhostObjectComponent>())
 				{
@@ -331,7 +390,7 @@ void Scene::applyChangesToEntities()
 
 				if (auto graphicsComponent = entity.component<ecs::GraphicsComponent>())
 				{
-					graphicsEngine_->rotation(renderSceneHandle_, graphicsComponent->renderableHandle, oc->orientation);
+					rotation(graphicsComponent->renderableHandle, oc->orientation);
 				}
 				if (auto ghostObjectComponent = entity.component<ecs::GhostObjectComponent>())
 				{
@@ -377,12 +436,17 @@ void Scene::applyChangesToEntities()
 
 void Scene::tick(const float32 delta)
 {
+    PROFILE_ZONE("Scene::tick");
+
+    beginInterpolationTick();
+
     if (!active())
     {
         handleAsyncEntityCreation();
         handleAsyncEntityDeletion();
         handleParentComponentChanges();
         applyChangesToEntities();
+        handleAsyncSaves();
         return;
     }
 
@@ -399,6 +463,10 @@ void Scene::tick(const float32 delta)
 	tickPathfinding(delta);
 	tickScriptObjects(delta);
 
+	// Terrain creates and destroys graphics resources, so while pipelined it ticks at the sync point instead
+	if (renderState_ == nullptr) tickTerrain(delta);
+	else terrainDelta_ += delta;
+
 	if (scriptObjectHandle_)
 	{
 		scriptingEngine_->execute(scriptObjectHandle_, std::string("void postTick(const float)"), params, executionContextHandle_);
@@ -412,10 +480,14 @@ void Scene::tick(const float32 delta)
 	handleParentComponentChanges();
 
 	applyChangesToEntities();
+
+	handleAsyncSaves();
 }
 
 void Scene::tickPhysics(const float32 delta)
 {
+    PROFILE_ZONE("Scene::tickPhysics");
+
     auto beginPhysicsTime = std::chrono::high_resolution_clock::now();
 
     physicsEngine_->tick(physicsSceneHandle_, delta);
@@ -427,16 +499,32 @@ void Scene::tickPhysics(const float32 delta)
 
 void Scene::tickAudio(const float32 delta)
 {
+    PROFILE_ZONE("Scene::tickAudio");
+
     audioEngine_->tick(audioSceneHandle_, delta);
 }
 
 void Scene::tickPathfinding(const float32 delta)
 {
+    PROFILE_ZONE("Scene::tickPathfinding");
+
     pathfindingEngine_->tick(pathfindingSceneHandle_, delta);
 }
 
+void Scene::tickTerrain(const float32 delta)
+{
+    PROFILE_ZONE("Scene::tickTerrain");
+
+    for (auto& terrain : terrain_)
+    {
+        terrain->tick(delta);
+    }
+}
+
 void Scene::tickScriptObjects(const float32 delta)
 {
+    PROFILE_ZONE("Scene::tickScriptObjects");
+
     scripting::ParameterList params;
     params.add(delta);
 
@@ -454,6 +542,29 @@ void Scene::tickScriptObjects(const float32 delta)
 
 void Scene::tickAnimations(const float32 delta)
 {
+    PROFILE_ZONE("Scene::tickAnimations");
+
+    // Workers from the last tick read and write animationLodStates_ through raw pointers, so they have to be done
+    // before any state is reused or erased (the engine has usually waited for them already)
+    waitForAnimations();
+
+    ++animationTick_;
+
+    const bool lodEnabled = animationLodSettings_.enabled && static_cast<bool>(animationLodCameraHandle_);
+
+    glm::vec3 cameraPosition;
+    glm::vec3 cameraForward;
+    const float32 halfFieldOfView = glm::radians(animationLodSettings_.fieldOfView) * 0.5f;
+
+    if (lodEnabled)
+    {
+        // While pipelined, the camera is read at the sync point - the graphics engine may be rendering now
+        if (renderState_ == nullptr) updateAnimationLodCamera();
+
+        cameraPosition = animationLodCameraPosition_;
+        cameraForward = animationLodCameraForward_;
+    }
+
     for (auto e : entityComponentSystem_->entitiesWithComponents<ecs::GraphicsComponent, ecs::AnimationComponent>())
     {
         const auto graphicsComponent = e.component<ecs::GraphicsComponent>();
@@ -462,20 +573,198 @@ void Scene::tickAnimations(const float32 delta)
 
         if (graphicsComponent->renderableHandle && animationComponent->animationHandle)
         {
-            gameEngine_->foregroundThreadPool()->postWork([=, &transformations = animationComponent->transformations, runningTime = animationComponent->runningTime]() {
-                gameEngine_->animateSkeleton(transformations, runningTime, animationComponent->startFrame, animationComponent->endFrame, graphicsComponent->meshHandle, animationComponent->animationHandle, skeletonComponent->skeletonHandle);
-                gameEngine_->foregroundGraphicsThreadPool()->postWork([=]() {
-                    graphicsEngine_->update(renderSceneHandle_, graphicsComponent->renderableHandle, animationComponent->bonesHandle, animationComponent->transformations);
-                });
-            });
-
-            animationComponent->runningTime += std::chrono::duration<float32>(delta) * animationComponent->speed;
+            // Capture everything by value - the components may change while the work is running
+            const auto renderableHandle = graphicsComponent->renderableHandle;
+            const auto meshHandle = graphicsComponent->meshHandle;
+            const auto animationHandle = animationComponent->animationHandle;
+            const auto bonesHandle = animationComponent->bonesHandle;
+            const auto skeletonHandle = skeletonComponent->skeletonHandle;
+            const auto runningTime = animationComponent->runningTime;
+            const auto startFrame = animationComponent->startFrame;
+            const auto endFrame = animationComponent->endFrame;
+            const auto step = std::chrono::duration<float32>(delta) * animationComponent->speed;
+
+            animationComponent->runningTime += step;
+
+            uint32 interval = 1;
+            uint32 maxAnimatedDepth = std::numeric_limits<uint32>::max();
+
+            if (lodEnabled && e.hasComponent<ecs::PositionComponent>())
+            {
+                const glm::vec3 toEntity = e.component<ecs::PositionComponent>()->position - cameraPosition;
+                const float32 distance = glm::length(toEntity);
+
+                if (!visible_ || distance > animationLodSettings_.cullDistance)
+                {
+                    continue;
+                }
+
+                // Outside the camera's view cone (widened by the entity's bounding sphere)
+                if (distance > animationLodSettings_.boundingRadius)
+                {
+                    const float32 angle = std::acos(glm::clamp(glm::dot(toEntity / distance, cameraForward), -1.0f, 1.0f));
+                    const float32 boundingAngle = std::asin(animationLodSettings_.boundingRadius / distance);
+
+                    if (angle > halfFieldOfView + boundingAngle)
+                    {
+                        continue;
+                    }
+                }
+
+                if (distance > animationLodSettings_.quarterRateDistance)
+                {
+                    interval = 4;
+                }
+                else if (distance > animationLodSettings_.halfRateDistance)
+                {
+                    interval = 2;
+                }
+
+                if (distance > animationLodSettings_.reducedBonesDistance)
+                {
+                    maxAnimatedDepth = animationLodSettings_.reducedBonesDepth;
+                }
+            }
+
+            if (interval == 1)
+            {
+                animationWork_.push_back(gameEngine_->foregroundThreadPool()->postWork([=]() {
+                    PROFILE_ZONE("Scene::animateSkeleton");
+
+                    const auto palette = gameEngine_->animateSkeleton(runningTime, startFrame, endFrame, meshHandle, animationHandle, skeletonHandle, maxAnimatedDepth);
+
+                    if (renderState_ != nullptr)
+                    {
+                        renderState_->update(renderSceneHandle_, renderableHandle, bonesHandle, palette);
+                        return;
+                    }
+
+                    openGlLoader_->postWork([=]() {
+                        // If the arena has already reused the palette's frame, a newer palette for this renderable has been posted since
+                        if (gameEngine_->bonePaletteArena().valid(palette))
+                        {
+                            graphicsEngine_->update(renderSceneHandle_, renderableHandle, bonesHandle, palette.transformations, palette.size);
+                        }
+                    }, IOpenGlLoader::Priority::PRIORITY_HIGH);
+                }));
+
+                continue;
+            }
+
+            // Reduced rate - sample the pose 'interval' ticks ahead and interpolate towards it in between samples
+            auto& state = animationLodStates_[e.id().id()];
+            state.lastTick = animationTick_;
+
+            if (state.interval != interval)
+            {
+                state.interval = interval;
+                state.ticksUntilSample = 0;
+            }
+
+            const bool sample = (state.ticksUntilSample == 0);
+            if (sample)
+            {
+                state.ticksUntilSample = interval;
+            }
+
+            const float32 factor = static_cast<float32>(interval - state.ticksUntilSample) / static_cast<float32>(interval);
+            --state.ticksUntilSample;
+
+            const auto sampleTime = runningTime + step * static_cast<float32>(interval);
+
+            // Stays valid until the work is done - states are only erased after waitForAnimations(), and rehashing doesn't move them
+            AnimationLodState* statePointer = &state;
+
+            animationWork_.push_back(gameEngine_->foregroundThreadPool()->postWork([=]() {
+                PROFILE_ZONE("Scene::animateSkeleton");
+
+                if (sample)
+                {
+                    const uint32 numberOfBones = gameEngine_->numberOfBones(meshHandle);
+
+                    if (!statePointer->initialized || statePointer->next.size() != numberOfBones)
+                    {
+                        statePointer->previous.assign(numberOfBones, glm::mat4(1.0f));
+                        statePointer->next.assign(numberOfBones, glm::mat4(1.0f));
+                        gameEngine_->animateSkeleton(statePointer->previous.data(), numberOfBones, runningTime, startFrame, endFrame, meshHandle, animationHandle, skeletonHandle, maxAnimatedDepth);
+                        statePointer->initialized = true;
+                    }
+                    else
+                    {
+                        std::swap(statePointer->previous, statePointer->next);
+                    }
+
+                    gameEngine_->animateSkeleton(statePointer->next.data(), numberOfBones, sampleTime, startFrame, endFrame, meshHandle, animationHandle, skeletonHandle, maxAnimatedDepth);
+                }
+
+                // Linearly interpolating skinning matrices isn't exact, but the error is small over a few ticks and at a distance
+                auto palette = gameEngine_->bonePaletteArena().allocate(static_cast<uint32>(statePointer->next.size()));
+                for (uint32 i = 0; i < palette.size; ++i)
+                {
+                    palette.transformations[i] = statePointer->previous[i] * (1.0f - factor) + statePointer->next[i] * factor;
+                }
+
+                if (renderState_ != nullptr)
+                {
+                    renderState_->update(renderSceneHandle_, renderableHandle, bonesHandle, palette);
+                    return;
+                }
+
+                openGlLoader_->postWork([=]() {
+                    if (gameEngine_->bonePaletteArena().valid(palette))
+                    {
+                        graphicsEngine_->update(renderSceneHandle_, renderableHandle, bonesHandle, palette.transformations, palette.size);
+                    }
+                }, IOpenGlLoader::Priority::PRIORITY_HIGH);
+            }));
+        }
+    }
+
+    // Drop the state of anything that wasn't animated at a reduced rate this tick (destroyed, culled or close by)
+    for (auto it = animationLodStates_.begin(); it != animationLodStates_.end();)
+    {
+        if (it->second.lastTick != animationTick_)
+        {
+            it = animationLodStates_.erase(it);
+        }
+        else
+        {
+            ++it;
         }
     }
 }
 
+void Scene::setAnimationLodCamera(const graphics::CameraHandle& cameraHandle)
+{
+	animationLodCameraHandle_ = cameraHandle;
+}
+
+const graphics::CameraHandle& Scene::animationLodCamera() const
+{
+	return animationLodCameraHandle_;
+}
+
+void Scene::waitForAnimations()
+{
+	// Wait for all of it before rethrowing, so nothing is left running
+	for (auto& work : animationWork_)
+	{
+		work.wait();
+	}
+
+	auto animationWork = std::move(animationWork_);
+	animationWork_.clear();
+
+	for (auto& work : animationWork)
+	{
+		work.get();
+	}
+}
+
 void Scene::handleAsyncEntityCreation()
 {
+    PROFILE_ZONE("Scene::handleAsyncEntityCreation");
+
     for (auto& promise : asyncCreateEntities_)
     {
         auto entity = createEntity();
@@ -487,6 +776,8 @@ void Scene::handleAsyncEntityCreation()
 
 void Scene::handleAsyncEntityDeletion()
 {
+    PROFILE_ZONE("Scene::handleAsyncEntityDeletion");
+
     for (auto& entity : asyncDestroyEntities_)
     {
         destroy(entity);
@@ -497,6 +788,8 @@ void Scene::handleAsyncEntityDeletion()
 
 void Scene::handleParentComponentChanges()
 {
+    PROFILE_ZONE("Scene::handleParentComponentChanges");
+
     for (auto e : entityComponentSystem_->entitiesWithComponents<ecs::ParentComponent>())
     {
         auto parentComponent = e.component<ecs::ParentComponent>();
@@ -526,18 +819,154 @@ void Scene::handleParentComponentChanges()
     }
 }
 
+void Scene::updateAnimationLodCamera()
+{
+	animationLodCameraPosition_ = graphicsEngine_->position(animationLodCameraHandle_);
+	animationLodCameraForward_ = graphicsEngine_->rotation(animationLodCameraHandle_) * glm::vec3(0.0f, 0.0f, -1.0f);
+}
+
+void Scene::beginInterpolationTick()
+{
+	for (auto& entry : interpolatedTransforms_)
+	{
+		auto& interpolatedTransform = entry.second;
+
+		interpolatedTransform.previousPosition = interpolatedTransform.position;
+		interpolatedTransform.previousOrientation = interpolatedTransform.orientation;
+		interpolatedTransform.moved = false;
+	}
+}
+
+void Scene::recordInterpolatedTransform(ecs::Entity& entity)
+{
+	auto graphicsComponent = entity.component<ecs::GraphicsComponent>();
+
+	if (!graphicsComponent || !graphicsComponent->renderableHandle) return;
+
+	auto it = interpolatedTransforms_.find(entity.id().id());
+
+	if (it == interpolatedTransforms_.end())
+	{
+		InterpolatedTransform interpolatedTransform;
+		interpolatedTransform.renderableHandle = graphicsComponent->renderableHandle;
+
+		if (renderState_ == nullptr)
+		{
+			// The renderable is still where it was last drawn, so that is where it moves from
+			interpolatedTransform.previousPosition = graphicsEngine_->position(renderSceneHandle_, graphicsComponent->renderableHandle);
+			interpolatedTransform.previousOrientation = graphicsEngine_->rotation(renderSceneHandle_, graphicsComponent->renderableHandle);
+		}
+		else
+		{
+			// While pipelined the graphics engine may be rendering, so a renderable's first move isn't interpolated -
+			// later moves start from the entry kept since
+			auto pc = entity.component<ecs::PositionComponent>();
+			auto oc = entity.component<ecs::OrientationComponent>();
+
+			if (!pc || !oc) return;
+
+			interpolatedTransform.previousPosition = pc->position;
+			interpolatedTransform.previousOrientation = oc->orientation;
+		}
+
+		interpolatedTransform.position = interpolatedTransform.previousPosition;
+		interpolatedTransform.orientation = interpolatedTransform.previousOrientation;
+
+		it = interpolatedTransforms_.emplace(entity.id().id(), interpolatedTransform).first;
+	}
+
+	auto& interpolatedTransform = it->second;
+
+	if (auto pc = entity.component<ecs::PositionComponent>()) interpolatedTransform.position = pc->position;
+	if (auto oc = entity.component<ecs::OrientationComponent>()) interpolatedTransform.orientation = oc->orientation;
+
+	interpolatedTransform.renderableHandle = graphicsComponent->renderableHandle;
+	interpolatedTransform.moved = true;
+	interpolatedTransform.settled = false;
+}
+
+void Scene::position(const graphics::RenderableHandle& renderableHandle, const glm::vec3& position)
+{
+	if (renderState_ != nullptr) renderState_->position(renderSceneHandle_, renderableHandle, position);
+	else graphicsEngine_->position(renderSceneHandle_, renderableHandle, position);
+}
+
+void Scene::rotation(const graphics::RenderableHandle& renderableHandle, const glm::quat& orientation)
+{
+	if (renderState_ != nullptr) renderState_->rotation(renderSceneHandle_, renderableHandle, orientation);
+	else graphicsEngine_->rotation(renderSceneHandle_, renderableHandle, orientation);
+}
+
+void Scene::interpolate(const float32 alpha)
+{
+	PROFILE_ZONE("Scene::interpolate");
+
+	for (auto it = interpolatedTransforms_.begin(); it != interpolatedTransforms_.end();)
+	{
+		auto& interpolatedTransform = it->second;
+		const entityx::Entity::Id entityId(it->first);
+
+		// The entity (or its renderable) may have been destroyed since it moved
+		bool valid = entityComponentSystem_->valid(entityId);
+
+		if (valid)
+		{
+			auto graphicsComponent = entityComponentSystem_->component<ecs::GraphicsComponent>(entityId);
+			valid = graphicsComponent && graphicsComponent->renderableHandle == interpolatedTransform.renderableHandle;
+		}
+
+		if (valid && !interpolatedTransform.settled)
+		{
+			graphicsEngine_->position(renderSceneHandle_, interpolatedTransform.renderableHandle, glm::mix(interpolatedTransform.previousPosition, interpolatedTransform.position, alpha));
+			graphicsEngine_->rotation(renderSceneHandle_, interpolatedTransform.renderableHandle, glm::slerp(interpolatedTransform.previousOrientation, interpolatedTransform.orientation, alpha));
+		}
+
+		// Renderables that didn't move last tick are now exactly at their current transform, and need no more updates
+		if (!valid || (!interpolatedTransform.moved && renderState_ == nullptr))
+		{
+			it = interpolatedTransforms_.erase(it);
+		}
+		else
+		{
+			if (!interpolatedTransform.moved) interpolatedTransform.settled = true;
+			++it;
+		}
+	}
+}
+
 void Scene::render()
 {
+	PROFILE_ZONE("Scene::render");
+
 	if (visible())
     {
 	    graphicsEngine_->render(renderSceneHandle_);
-	    physicsEngine_->renderDebug(physicsSceneHandle_);
-	    pathfindingEngine_->renderDebug(pathfindingSceneHandle_);
 
-        audioEngine_->render(audioSceneHandle_);
+	    // While pipelined, the physics, pathfinding and audio scenes are being ticked right now
+	    if (renderState_ == nullptr) synchronize();
     }
 }
 
+void Scene::synchronize()
+{
+	if (renderState_ != nullptr)
+	{
+		// The simulation is idle, so this is when the graphics engine can be read and terrain can change its resources
+		if (animationLodSettings_.enabled && animationLodCameraHandle_) updateAnimationLodCamera();
+
+		tickTerrain(terrainDelta_);
+		terrainDelta_ = 0.0f;
+	}
+
+	if (visible())
+	{
+		physicsEngine_->renderDebug(physicsSceneHandle_);
+		pathfindingEngine_->renderDebug(pathfindingSceneHandle_);
+
+		audioEngine_->render(audioSceneHandle_);
+	}
+}
+
 void Scene::setSceneThingyInstance(void* object)
 {
 	scriptObjectHandle_ = scripting::ScriptObjectHandle(object);
@@ -727,32 +1156,32 @@ void Scene::removePathfindingMovementRequestStateChangeListener(const ecs::Entit
 
 void Scene::addUserData(const ecs::Entity& entity, const ecs::RigidBodyObjectComponent& rigidBodyObjectComponent)
 {
-	physicsEngine_->setUserData(physicsSceneHandle_, rigidBodyObjectComponent.rigidBodyObjectHandle, boost::any(entity));
+	physicsEngine_->setUserTag(physicsSceneHandle_, rigidBodyObjectComponent.rigidBodyObjectHandle, userTag<physics::UserTag>(entity));
 }
 
 void Scene::addUserData(const ecs::Entity& entity, const ecs::GhostObjectComponent& ghostObjectComponent)
 {
-	physicsEngine_->setUserData(physicsSceneHandle_, ghostObjectComponent.ghostObjectHandle, boost::any(entity));
+	physicsEngine_->setUserTag(physicsSceneHandle_, ghostObjectComponent.ghostObjectHandle, userTag<physics::UserTag>(entity));
 }
 
 void Scene::addUserData(const ecs::Entity& entity, const ecs::PathfindingAgentComponent& pathfindingAgentComponent)
 {
-	pathfindingEngine_->setUserData(pathfindingSceneHandle_, pathfindingAgentComponent.crowdHandle, pathfindingAgentComponent.agentHandle, boost::any(entity));
+	pathfindingEngine_->setUserTag(pathfindingSceneHandle_, pathfindingAgentComponent.crowdHandle, pathfindingAgentComponent.agentHandle, userTag<pathfinding::UserTag>(entity));
 }
 
 void Scene::removeUserData(const ecs::Entity& entity, const ecs::RigidBodyObjectComponent& rigidBodyObjectComponent)
 {
-	physicsEngine_->setUserData(physicsSceneHandle_, rigidBodyObjectComponent.rigidBodyObjectHandle, boost::any());
+	physicsEngine_->setUserTag(physicsSceneHandle_, rigidBodyObjectComponent.rigidBodyObjectHandle, physics::UserTag());
 }
 
 void Scene::removeUserData(const ecs::Entity& entity, const ecs::GhostObjectComponent& ghostObjectComponent)
 {
-	physicsEngine_->setUserData(physicsSceneHandle_, ghostObjectComponent.ghostObjectHandle, boost::any());
+	physicsEngine_->setUserTag(physicsSceneHandle_, ghostObjectComponent.ghostObjectHandle, physics::UserTag());
 }
 
 void Scene::removeUserData(const ecs::Entity& entity, const ecs::PathfindingAgentComponent& pathfindingAgentComponent)
 {
-	pathfindingEngine_->setUserData(pathfindingSceneHandle_, pathfindingAgentComponent.crowdHandle, pathfindingAgentComponent.agentHandle, boost::any());
+	pathfindingEngine_->setUserTag(pathfindingSceneHandle_, pathfindingAgentComponent.crowdHandle, pathfindingAgentComponent.agentHandle, pathfinding::UserTag());
 }
 
 graphics::RenderableHandle Scene::createRenderable(
@@ -778,6 +1207,13 @@ graphics::RenderableHandle Scene::createRenderable(
 
 void Scene::destroy(const graphics::RenderableHandle& renderableHandle)
 {
+	// The renderable may be drawn right now, so it goes once the frame has rendered
+	if (renderState_ != nullptr)
+	{
+		renderState_->destroy(renderSceneHandle_, renderableHandle);
+		return;
+	}
+
 	graphicsEngine_->destroy(renderSceneHandle_, renderableHandle);
 }
 
@@ -793,6 +1229,12 @@ graphics::PointLightHandle Scene::createPointLight(const glm::vec3& position)
 
 void Scene::destroy(const graphics::PointLightHandle& pointLightHandle)
 {
+	if (renderState_ != nullptr)
+	{
+		renderState_->destroy(renderSceneHandle_, pointLightHandle);
+		return;
+	}
+
 	graphicsEngine_->destroy(renderSceneHandle_, pointLightHandle);
 }
 
@@ -800,6 +1242,23 @@ void Scene::serialize(const std::string& filename)
 {
 	LOG_INFO(logger_, "Serializing scene %s to file %s", name(), filename);
 
+	waitForAsyncSave();
+
+	// Overwriting the start of an incremental save ends it
+	if (incrementalSaveState_.filename == filename)
+	{
+		incrementalSaveState_ = IncrementalSaveState();
+	}
+
+	if (binarySnapshots_)
+	{
+		auto file = fileSystem_->open(filename, fs::FileFlags::WRITE | fs::FileFlags::BINARY);
+
+		saveSnapshot(file->getOutputStream());
+
+		return;
+	}
+
 	auto file = fileSystem_->open(filename, fs::FileFlags::WRITE);
 
 	serialization::TextOutArchive ar(file->getOutputStream());
@@ -811,6 +1270,17 @@ void Scene::deserialize(const std::string& filename)
 {
 	LOG_INFO(logger_, "Deserializing scene %s from file %s", name(), filename);
 
+	{
+		auto file = fileSystem_->open(filename, fs::FileFlags::READ | fs::FileFlags::BINARY);
+
+		if (SceneSnapshot::isSnapshot(file->getInputStream()))
+		{
+			loadSnapshot(file->getInputStream(), filename);
+
+			return;
+		}
+	}
+
 	auto file = fileSystem_->open(filename, fs::FileFlags::READ);
 
 	serialization::TextInArchive ar(file->getInputStream());
@@ -818,109 +1288,601 @@ void Scene::deserialize(const std::string& filename)
 	ar & *this;
 }
 
-const std::string& Scene::name() const
+std::shared_future<void> Scene::serializeAsync(const std::string& filename, const bool incremental)
 {
-	return name_;
-}
+	AsyncSave asyncSave;
+	asyncSave.filename = filename;
+	asyncSave.incremental = incremental;
+	asyncSave.promise = std::make_unique<std::promise<void>>();
 
-void Scene::setVisible(const bool visible)
-{
-	visible_ = visible;
-}
+	auto sharedFuture = asyncSave.promise->get_future().share();
 
-bool Scene::visible() const
-{
-	return visible_;
-}
+	asyncSaves_.push_back(std::move(asyncSave));
 
-const SceneStatistics& Scene::getSceneStatistics() const
-{
-	return sceneStatistics_;
+	return sharedFuture;
 }
 
-ecs::Entity Scene::createEntity()
+void Scene::handleAsyncSaves()
 {
-	ecs::Entity e = entityComponentSystem_->create();
+	if (asyncSaves_.empty())
+	{
+		return;
+	}
 
-	LOG_DEBUG(logger_, "Created entity with id: %s", e.id().id());
+	// Saves are written one at a time, so an incremental save can compare against the one before it
+	if (saveInFlight_.valid() && saveInFlight_.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+	{
+		return;
+	}
 
-	return e;
-}
+	auto asyncSave = std::make_shared<AsyncSave>(std::move(asyncSaves_.front()));
+	asyncSaves_.erase(asyncSaves_.begin());
 
-std::shared_future<ecs::Entity> Scene::createEntityAsync()
-{
-	auto promise = std::make_unique<std::promise<ecs::Entity>>();
-	auto sharedFuture = promise->get_future().share();
+	LOG_DEBUG(logger_, "Capturing scene %s for background save to file %s", name(), asyncSave->filename);
 
-	asyncCreateEntities_.push_back(std::move(promise));
+	std::shared_ptr<CapturedScene> capturedScene;
 
-	return sharedFuture;
-}
+	try
+	{
+		capturedScene = std::make_shared<CapturedScene>(captureScene());
+	}
+	catch (const std::exception& e)
+	{
+		LOG_ERROR(logger_, std::string("Exception: ") + boost::diagnostic_information(e));
+		asyncSave->promise->set_exception(std::current_exception());
 
-void Scene::destroy(ecs::Entity& entity)
-{
-	entityComponentSystem_->destroy(entity);
-}
+		return;
+	}
 
-void Scene::destroyAsync(ecs::Entity& entity)
-{
-	asyncDestroyEntities_.push_back(entity);
-}
+	saveInFlight_ = gameEngine_->backgroundThreadPool()->postWork([this, asyncSave, capturedScene]() {
+		try
+		{
+			writeAsyncSave(*capturedScene, asyncSave->filename, asyncSave->incremental);
 
-size_t Scene::getNumEntities() const
-{
-	return entityComponentSystem_->numEntities();
+			asyncSave->promise->set_value();
+		}
+		catch (const std::exception& e)
+		{
+			LOG_ERROR(logger_, std::string("Exception: ") + boost::diagnostic_information(e));
+			asyncSave->promise->set_exception(std::current_exception());
+		}
+	}).share();
 }
 
-Raycast Scene::raycast(const ray::Ray& ray)
+void Scene::writeAsyncSave(const CapturedScene& capturedScene, const std::string& filename, const bool incremental)
 {
-	Raycast result;
-
-	auto physicsRaycast = physicsEngine_->raycast(physicsSceneHandle_, ray);
+	auto& state = incrementalSaveState_;
 
-	result.setRay(physicsRaycast.ray());
-	result.setHitPointWorld(physicsRaycast.hitPointWorld());
-	result.setHitNormalWorld(physicsRaycast.hitNormalWorld());
-
-	if (physicsRaycast.rigidBodyObjectHandle())
+	if (!incremental)
 	{
-		auto userData = physicsEngine_->getUserData(physicsSceneHandle_, physicsRaycast.rigidBodyObjectHandle());
-		if (userData.type() == typeid(ecs::Entity))
-		{
-			result.setEntity(boost::any_cast<ecs::Entity>(userData));
-		}
-		else
+		if (state.filename == filename)
 		{
-			LOG_WARN(logger_, "User data was empty or was not of type Entity")
+			state = IncrementalSaveState();
 		}
+
+		auto file = fileSystem_->open(filename, fs::FileFlags::WRITE | fs::FileFlags::BINARY);
+
+		writeSnapshot(file->getOutputStream(), capturedScene, capturedScene.entities, nullptr);
+
+		return;
 	}
-	else if (physicsRaycast.ghostObjectHandle())
+
+	try
 	{
-		auto userData = physicsEngine_->getUserData(physicsSceneHandle_, physicsRaycast.ghostObjectHandle());
-		if (userData.type() == typeid(ecs::Entity))
+		auto hashes = capturedScene.entities.hashes();
+
+		SceneSnapshot::Increment increment;
+
+		if (state.saveId == 0 || state.filename != filename)
 		{
-			result.setEntity(boost::any_cast<ecs::Entity>(userData));
+			const auto uuid = boost::uuids::random_generator()();
+			std::memcpy(&increment.saveId, uuid.data, sizeof(increment.saveId));
+
+			auto file = fileSystem_->open(filename, fs::FileFlags::WRITE | fs::FileFlags::BINARY);
+
+			writeSnapshot(file->getOutputStream(), capturedScene, capturedScene.entities, &increment);
 		}
 		else
 		{
-			LOG_WARN(logger_, "User data was empty or was not of type Entity")
+			std::vector<uint32> changed;
+
+			for (const auto& kv : hashes)
+			{
+				const auto it = state.hashes.find(kv.first);
+
+				if (it == state.hashes.end() || it->second != kv.second)
+				{
+					changed.push_back(kv.first);
+				}
+			}
+
+			for (const auto& kv : state.hashes)
+			{
+				if (hashes.find(kv.first) == hashes.end())
+				{
+					increment.removed.push_back(kv.first);
+				}
+			}
+
+			std::sort(changed.begin(), changed.end());
+
+			increment.saveId = state.saveId;
+			increment.sequence = state.sequence + 1;
+
+			const auto incrementFilename = incrementalSaveFilename(filename, increment.sequence);
+
+			LOG_DEBUG(logger_, "Writing %s changed and %s removed entities to file %s", changed.size(), increment.removed.size(), incrementFilename);
+
+			auto file = fileSystem_->open(incrementFilename, fs::FileFlags::WRITE | fs::FileFlags::BINARY);
+
+			writeSnapshot(file->getOutputStream(), capturedScene, capturedScene.entities.subset(changed), &increment);
+		}
+
+		state.filename = filename;
+		state.saveId = increment.saveId;
+		state.sequence = increment.sequence;
+		state.hashes = std::move(hashes);
+	}
+	catch (...)
+	{
+		// Start over with a full save, rather than write changes against a save that may be incomplete
+		state = IncrementalSaveState();
+
+		throw;
+	}
+}
+
+void Scene::waitForAsyncSave() const
+{
+	if (saveInFlight_.valid())
+	{
+		saveInFlight_.wait();
+	}
+}
+
+std::string Scene::incrementalSaveFilename(const std::string& filename, const uint32 sequence)
+{
+	return filename + "." + std::to_string(sequence);
+}
+
+Scene::CapturedScene Scene::captureScene()
+{
+	// The same class version the text archive passes to the callbacks
+	const unsigned int version = 0;
+
+	CapturedScene capturedScene;
+
+	LOG_DEBUG(logger_, "Calling pre serialize callbacks");
+
+	for (auto& scriptFunctionHandleWrapper : scriptPreSerializeCallbacks_)
+	{
+		scripting::ParameterList params;
+		params.addRef(*this);
+
+		scriptingEngine_->execute(scriptFunctionHandleWrapper.get(), params, executionContextHandle_);
+	}
+
+	// Callbacks write to a text archive, which is stored in the snapshot as a block of its own
+	{
+		std::ostringstream stream;
+
+		{
+			serialization::TextOutArchive ar(stream);
+
+			for (auto& callback : preSerializeCallbacks_)
+			{
+				callback(ar, *entityComponentSystem_, version);
+			}
+		}
+
+		capturedScene.preSerialize = stream.str();
+	}
+
+	LOG_DEBUG(logger_, "Calling serialize on script objects");
+
+	for (auto entity : entityComponentSystem_->entitiesWithComponents<ecs::ScriptObjectComponent>())
+	{
+		auto componentHandle = entity.component<ecs::ScriptObjectComponent>();
+
+		scripting::ParameterList params;
+		params.add(entity);
+
+		scriptingEngine_->execute(componentHandle->scriptObjectHandle, std::string("void serialize(Entity)"), params, executionContextHandle_);
+	}
+
+	{
+		std::ostringstream stream;
+
+		{
+			serialization::BinaryOutArchive ar(stream);
+
+			saveMappings(ar, version);
+
+			ar & name_ & visible_ & active_;
+		}
+
+		capturedScene.scene = stream.str();
+	}
+
+	capturedScene.entities = EntitySnapshot(*entityComponentSystem_);
+
+	LOG_DEBUG(logger_, "Calling post serialize callbacks");
+
+	{
+		std::ostringstream stream;
+
+		{
+			serialization::TextOutArchive ar(stream);
+
+			for (auto& callback : postSerializeCallbacks_)
+			{
+				callback(ar, *entityComponentSystem_, version);
+			}
+		}
+
+		capturedScene.postSerialize = stream.str();
+	}
+
+	for (auto& scriptFunctionHandleWrapper : scriptPostSerializeCallbacks_)
+	{
+		scripting::ParameterList params;
+		params.addRef(*this);
+
+		scriptingEngine_->execute(scriptFunctionHandleWrapper.get(), params, executionContextHandle_);
+	}
+
+	return capturedScene;
+}
+
+void Scene::writeSnapshot(std::ostream& outputStream, const CapturedScene& capturedScene, const EntitySnapshot& entities, const SceneSnapshot::Increment* increment) const
+{
+	SceneSnapshotWriter writer(outputStream, compressSnapshots_);
+
+	if (increment)
+	{
+		writer.writeIncrement(*increment);
+	}
+
+	writer.writeBlock(SceneSnapshot::TAG_PRE_SERIALIZE, 1, capturedScene.preSerialize);
+	writer.writeBlock(SceneSnapshot::TAG_SCENE, 1, capturedScene.scene);
+	writer.writeEntities(entities);
+	writer.writeBlock(SceneSnapshot::TAG_POST_SERIALIZE, 1, capturedScene.postSerialize);
+
+	writer.finish();
+}
+
+void Scene::saveSnapshot(std::ostream& outputStream)
+{
+	const auto capturedScene = captureScene();
+
+	writeSnapshot(outputStream, capturedScene, capturedScene.entities, nullptr);
+}
+
+void Scene::loadSnapshot(std::istream& inputStream, const std::string& filename)
+{
+	const unsigned int version = 0;
+
+	try
+	{
+		SceneSnapshotReader reader(inputStream, logger_);
+
+		// Incremental saves are applied in order, up to the first one that's missing or belongs to a different save
+		std::vector<std::unique_ptr<SceneSnapshotReader>> increments;
+
+		if (reader.hasBlock(SceneSnapshot::TAG_INCREMENT))
+		{
+			const auto saveId = reader.increment().saveId;
+
+			for (uint32 sequence = 1; fileSystem_->exists(incrementalSaveFilename(filename, sequence)); ++sequence)
+			{
+				auto file = fileSystem_->open(incrementalSaveFilename(filename, sequence), fs::FileFlags::READ | fs::FileFlags::BINARY);
+				auto incrementReader = std::make_unique<SceneSnapshotReader>(file->getInputStream(), logger_);
+
+				if (!incrementReader->hasBlock(SceneSnapshot::TAG_INCREMENT) || incrementReader->increment().saveId != saveId || incrementReader->increment().sequence != sequence)
+				{
+					break;
+				}
+
+				increments.push_back(std::move(incrementReader));
+			}
+
+			LOG_DEBUG(logger_, "Applying %s incremental saves to scene %s", increments.size(), name());
+		}
+
+		// The callback and scene blocks are written in full every time, so they come from the latest save
+		const SceneSnapshotReader& latest = (increments.empty() ? reader : *increments.back());
+
+		LOG_DEBUG(logger_, "Calling pre deserialize callbacks");
+
+		for (auto& scriptFunctionHandleWrapper : scriptPreDeserializeCallbacks_)
+		{
+			scripting::ParameterList params;
+			params.addRef(*this);
+
+			scriptingEngine_->execute(scriptFunctionHandleWrapper.get(), params, executionContextHandle_);
+		}
+
+		{
+			std::istringstream stream(latest.blockString(SceneSnapshot::TAG_PRE_SERIALIZE));
+			serialization::TextInArchive ar(stream);
+
+			for (auto& callback : preDeserializeCallbacks_)
+			{
+				callback(ar, *entityComponentSystem_, version);
+			}
+		}
+
+		SerializedHandleMaps serializedHandleMaps;
+
+		{
+			std::istringstream stream(latest.blockString(SceneSnapshot::TAG_SCENE));
+			serialization::BinaryInArchive ar(stream);
+
+			loadHandleMaps(ar, serializedHandleMaps);
+
+			ar & name_;
+
+			bool visible = true;
+			ar & visible;
+			setVisible(visible);
+
+			bool active = true;
+			ar & active;
+			setActive(active);
+		}
+
+		reader.readEntities(*entityComponentSystem_);
+
+		for (const auto& incrementReader : increments)
+		{
+			incrementReader->readEntityChanges(*entityComponentSystem_);
 		}
+
+		std::istringstream stream(latest.blockString(SceneSnapshot::TAG_POST_SERIALIZE));
+		serialization::TextInArchive ar(stream);
+
+		resolveHandleMaps(serializedHandleMaps, ar, version);
+	}
+	catch(const Exception& e)
+	{
+		LOG_ERROR(logger_, std::string("Exception: ") + boost::diagnostic_information(e));
+		std::cerr << "Exception: " << boost::diagnostic_information(e) << std::endl;
+	}
+	catch(const std::exception& e)
+	{
+		LOG_ERROR(logger_, std::string("Exception: ") + boost::diagnostic_information(e));
+		std::cerr << "Exception: " << boost::diagnostic_information(e) << std::endl;
+	}
+}
+
+void Scene::resolveHandleMaps(const SerializedHandleMaps& serializedHandleMaps, serialization::TextInArchive& ar, const unsigned int version)
+{
+	std::unordered_map<pathfinding::CrowdHandle, pathfinding::CrowdHandle> normalizedCrowdHandleMap;
+
+	auto normalizedCollisionShapeHandleMap = generateNormalizedMap(serializedHandleMaps.collisionShapeHandleMap, gameEngine_->resourceHandleCache().collisionShapeHandleMap(), logger_);
+	auto normalizedModelHandleMap = generateNormalizedMap(serializedHandleMaps.modelHandleMap, gameEngine_->resourceHandleCache().modelHandleMap(), logger_);
+	auto normalizedMeshHandleMap = generateNormalizedMap(serializedHandleMaps.meshHandleMap, gameEngine_->resourceHandleCache().meshHandleMap(), logger_);
+	auto normalizedTextureHandleMap = generateNormalizedMap(serializedHandleMaps.textureHandleMap, gameEngine_->resourceHandleCache().textureHandleMap(), logger_);
+	auto normalizedSkeletonHandleMap = generateNormalizedMap(serializedHandleMaps.skeletonHandleMap, gameEngine_->resourceHandleCache().skeletonHandleMap(), logger_);
+	auto normalizedAnimationHandleMap = generateNormalizedMap(serializedHandleMaps.animationHandleMap, gameEngine_->resourceHandleCache().animationHandleMap(), logger_);
+	auto normalizedTerrainHandleMap = generateNormalizedMap(serializedHandleMaps.terrainHandleMap, gameEngine_->resourceHandleCache().terrainHandleMap(), logger_);
+	auto normalizedNavigationMeshHandleMap = generateNormalizedMap(serializedHandleMaps.navigationMeshHandleMap, gameEngine_->resourceHandleCache().navigationMeshHandleMap(), logger_);
+//	generateNormalizedMap(scriptingEngine_, moduleHandle_, executionContextHandle_, scriptObjectHandleMap, logger_);
+
+	normalizeHandles(
+		normalizedCollisionShapeHandleMap,
+		normalizedModelHandleMap,
+		normalizedMeshHandleMap,
+		normalizedTextureHandleMap,
+		normalizedSkeletonHandleMap,
+		normalizedAnimationHandleMap,
+		normalizedTerrainHandleMap,
+		serializedHandleMaps.polygonMeshHandleMap,
+		normalizedNavigationMeshHandleMap,
+		serializedHandleMaps.scriptObjectHandleMap,
+		normalizedCrowdHandleMap
+	);
+
+	for (auto entity : entityComponentSystem_->entitiesWithComponents<ecs::ParentBoneAttachmentComponent>())
+	{
+		auto componentHandle = entity.component<ecs::ParentBoneAttachmentComponent>();
+		entity.assign<ecs::ParentBoneAttachmentComponent>(ecs::ParentBoneAttachmentComponent(*componentHandle));
+	}
+
+	for (auto entity : entityComponentSystem_->entitiesWithComponents<ecs::PathfindingObstacleComponent>())
+	{
+		auto componentHandle = entity.component<ecs::PathfindingObstacleComponent>();
+		componentHandle->obstacleHandle.invalidate();
+		entity.assign<ecs::PathfindingObstacleComponent>(ecs::PathfindingObstacleComponent(*componentHandle));
+	}
+
+	LOG_DEBUG(logger_, "Calling post deserialize callbacks");
+
+	for (auto& callback : postDeserializeCallbacks_)
+	{
+		callback(
+			ar,
+			*entityComponentSystem_,
+			normalizedCollisionShapeHandleMap,
+			normalizedModelHandleMap,
+			normalizedMeshHandleMap,
+			normalizedTextureHandleMap,
+			normalizedSkeletonHandleMap,
+			normalizedAnimationHandleMap,
+			normalizedTerrainHandleMap,
+			serializedHandleMaps.polygonMeshHandleMap,
+			normalizedNavigationMeshHandleMap,
+			serializedHandleMaps.scriptObjectHandleMap,
+			normalizedCrowdHandleMap,
+			version
+		);
 	}
 
+	for (auto& scriptFunctionHandleWrapper : scriptPostDeserializeCallbacks_)
+	{
+		scripting::ParameterList params;
+		params.addRef(*this);
+
+		scriptingEngine_->execute(scriptFunctionHandleWrapper.get(), params, executionContextHandle_);
+	}
+}
+
+const std::string& Scene::name() const
+{
+	return name_;
+}
+
+void Scene::setVisible(const bool visible)
+{
+	visible_ = visible;
+}
+
+bool Scene::visible() const
+{
+	return visible_;
+}
+
+const SceneStatistics& Scene::getSceneStatistics() const
+{
+	return sceneStatistics_;
+}
+
+StreamingTerrain* Scene::createStreamingTerrain(std::unique_ptr<ITerrainTileSource> tileSource, const SplatMap& splatMap, const DisplacementMap& displacementMap)
+{
+	auto terrain = std::make_unique<StreamingTerrain>(
+		terrainStreamingSettings_,
+		std::move(tileSource),
+		splatMap,
+		displacementMap,
+		this,
+		gameEngine_->backgroundThreadPool(),
+		logger_,
+		graphicsEngine_,
+		pathfindingEngine_,
+		physicsEngine_,
+		renderSceneHandle_
+	);
+	auto terrainPtr = terrain.get();
+
+	terrain_.push_back(std::move(terrain));
+
+	return terrainPtr;
+}
+
+ecs::Entity Scene::createEntity()
+{
+	ecs::Entity e = entityComponentSystem_->create();
+
+	static auto& entitiesCreated = Metrics::instance().counter("scene.entities_created");
+	entitiesCreated.increment();
+
+	LOG_DEBUG(logger_, "Created entity with id: %s", e.id().id());
+
+	return e;
+}
+
+std::shared_future<ecs::Entity> Scene::createEntityAsync()
+{
+	auto promise = std::make_unique<std::promise<ecs::Entity>>();
+	auto sharedFuture = promise->get_future().share();
+
+	asyncCreateEntities_.push_back(std::move(promise));
+
+	return sharedFuture;
+}
+
+void Scene::destroy(ecs::Entity& entity)
+{
+	entityComponentSystem_->destroy(entity);
+
+	static auto& entitiesDestroyed = Metrics::instance().counter("scene.entities_destroyed");
+	entitiesDestroyed.increment();
+}
+
+void Scene::destroyAsync(ecs::Entity& entity)
+{
+	asyncDestroyEntities_.push_back(entity);
+}
+
+size_t Scene::getNumEntities() const
+{
+	return entityComponentSystem_->numEntities();
+}
+
+bool Scene::entityFromQueryResult(const boost::variant<physics::RigidBodyObjectHandle, physics::GhostObjectHandle>& object, ecs::Entity& entity) const
+{
+	const auto tag = boost::apply_visitor(UserTagVisitor(*physicsEngine_, physicsSceneHandle_), object);
+
+	if (!entityFromUserTag(*entityComponentSystem_, tag, entity))
+	{
+		LOG_WARN(logger_, "User tag was empty or its entity no longer exists")
+
+		return false;
+	}
+
+	return true;
+}
+
+void Scene::fillRaycast(const physics::Raycast& physicsRaycast, Raycast& result) const
+{
+	result = Raycast();
+
+	result.setRay(physicsRaycast.ray());
+	result.setHitPointWorld(physicsRaycast.hitPointWorld());
+	result.setHitNormalWorld(physicsRaycast.hitNormalWorld());
+
+	ecs::Entity entity;
+
+	if (physicsRaycast.rigidBodyObjectHandle())
+	{
+		if (entityFromQueryResult(physicsRaycast.rigidBodyObjectHandle(), entity))
+		{
+			result.setEntity(entity);
+		}
+	}
+	else if (physicsRaycast.ghostObjectHandle())
+	{
+		if (entityFromQueryResult(physicsRaycast.ghostObjectHandle(), entity))
+		{
+			result.setEntity(entity);
+		}
+	}
+}
+
+Raycast Scene::raycast(const ray::Ray& ray)
+{
+	Raycast result;
+
+	fillRaycast(physicsEngine_->raycast(physicsSceneHandle_, ray), result);
+
 	return result;
 }
 
+void Scene::raycast(const std::vector<ray::Ray>& rays, std::vector<Raycast>& raycasts)
+{
+	physicsEngine_->raycast(physicsSceneHandle_, rays, physicsRaycasts_);
+
+	raycasts.resize(physicsRaycasts_.size());
+
+	for (size_t i = 0; i < physicsRaycasts_.size(); ++i)
+	{
+		fillRaycast(physicsRaycasts_[i], raycasts[i]);
+	}
+}
+
 std::vector<ecs::Entity> Scene::query(const glm::vec3& origin, const std::vector<glm::vec3>& points)
 {
 	std::vector<ecs::Entity> results;
 
 	const auto physicsResult = physicsEngine_->query(physicsSceneHandle_, origin, points);
 
-	QueryVisitor visitor(logger_, *physicsEngine_, physicsSceneHandle_, results);
-
 	for (const auto& variant : physicsResult)
 	{
-		boost::apply_visitor(visitor, variant);
+		ecs::Entity entity;
+		if (entityFromQueryResult(variant, entity))
+		{
+			results.push_back(entity);
+		}
 	}
 
 	return results;
@@ -932,16 +1894,158 @@ std::vector<ecs::Entity> Scene::query(const glm::vec3& origin, const float32 rad
 
 	const auto physicsResult = physicsEngine_->query(physicsSceneHandle_, origin, radius);
 
-	QueryVisitor visitor(logger_, *physicsEngine_, physicsSceneHandle_, results);
-
 	for (const auto& variant : physicsResult)
 	{
-		boost::apply_visitor(visitor, variant);
+		ecs::Entity entity;
+		if (entityFromQueryResult(variant, entity))
+		{
+			results.push_back(entity);
+		}
 	}
 
 	return results;
 }
 
+void Scene::query(const std::vector<physics::Sphere>& spheres, QueryResults<ecs::Entity>& results)
+{
+	physicsEngine_->query(physicsSceneHandle_, spheres, physicsQueryResults_);
+
+	results.clear();
+	results.reserve(physicsQueryResults_.numberOfQueries(), static_cast<uint32>(physicsQueryResults_.values().size()));
+
+	for (uint32 i = 0; i < physicsQueryResults_.numberOfQueries(); ++i)
+	{
+		for (uint32 j = 0; j < physicsQueryResults_.count(i); ++j)
+		{
+			ecs::Entity entity;
+			if (entityFromQueryResult(physicsQueryResults_.get(i, j), entity))
+			{
+				results.add(entity);
+			}
+		}
+
+		results.endQuery();
+	}
+}
+
+void Scene::entitiesFromSpatialIndexResults(std::vector<ecs::Entity>& entities)
+{
+	for (const auto id : spatialIndexResults_)
+	{
+		const entityx::Entity::Id entityId(id);
+
+		if (entityComponentSystem_->valid(entityId))
+		{
+			entities.push_back(entityComponentSystem_->get(entityId));
+		}
+	}
+
+	spatialIndexResults_.clear();
+}
+
+void Scene::entitiesInRadius(const glm::vec3& origin, const float32 radius, std::vector<ecs::Entity>& entities)
+{
+	spatialIndex_.queryRadius(origin, radius, spatialIndexResults_);
+
+	entitiesFromSpatialIndexResults(entities);
+}
+
+void Scene::entitiesInBox(const glm::vec3& minimum, const glm::vec3& maximum, std::vector<ecs::Entity>& entities)
+{
+	spatialIndex_.queryBox(minimum, maximum, spatialIndexResults_);
+
+	entitiesFromSpatialIndexResults(entities);
+}
+
+void Scene::entitiesInFrustum(const glm::mat4& viewProjection, std::vector<ecs::Entity>& entities)
+{
+	spatialIndex_.queryFrustum(SpatialIndex::frustumPlanes(viewProjection), spatialIndexResults_);
+
+	entitiesFromSpatialIndexResults(entities);
+}
+
+void Scene::nearestEntities(const glm::vec3& origin, const uint32 k, std::vector<ecs::Entity>& entities, const float32 maxDistance)
+{
+	spatialIndex_.queryNearest(origin, k, spatialIndexResults_, maxDistance);
+
+	entitiesFromSpatialIndexResults(entities);
+}
+
+SpatialIndex& Scene::spatialIndex()
+{
+	return spatialIndex_;
+}
+
+void Scene::replicationStates(std::vector<replication::EntityState>& states) const
+{
+	states.clear();
+
+	for (auto entity : entityComponentSystem_->entitiesWithComponents<ecs::ReplicatedComponent, ecs::PositionComponent, ecs::OrientationComponent>())
+	{
+		const auto replicatedComponent = entity.component<ecs::ReplicatedComponent>();
+
+		states.emplace_back(
+			replicatedComponent->networkId,
+			entity.component<ecs::PositionComponent>()->position,
+			entity.component<ecs::OrientationComponent>()->orientation,
+			replicatedComponent->custom
+		);
+	}
+}
+
+void Scene::applyReplicationStates(const std::vector<replication::EntityState>& states)
+{
+	std::unordered_map<uint32, ecs::Entity> entities;
+
+	for (auto entity : entityComponentSystem_->entitiesWithComponents<ecs::ReplicatedComponent>())
+	{
+		entities.emplace(entity.component<ecs::ReplicatedComponent>()->networkId, entity);
+	}
+
+	for (const auto& state : states)
+	{
+		auto it = entities.find(state.id);
+
+		if (it == entities.end())
+		{
+			auto entity = createEntity();
+			entity.assign<ecs::PositionComponent>(state.position);
+			entity.assign<ecs::OrientationComponent>(state.orientation);
+			entity.assign<ecs::ReplicatedComponent>(state.id, state.custom);
+			entity.assign<ecs::DirtyComponent>(ecs::DirtyFlags::DIRTY_SOURCE_SCRIPT | ecs::DirtyFlags::DIRTY_POSITION | ecs::DirtyFlags::DIRTY_ORIENTATION);
+
+			continue;
+		}
+
+		auto entity = it->second;
+		entities.erase(it);
+
+		// Most states in a snapshot are unchanged - only what moved needs its physics, pathfinding and graphics updated
+		const uint16 dirty = replication::applyEntityState(entity, state);
+
+		if (dirty == 0)
+		{
+			continue;
+		}
+
+		if (entity.hasComponent<ecs::DirtyComponent>())
+		{
+			auto dirtyComponent = entity.component<ecs::DirtyComponent>();
+			dirtyComponent->dirty |= ecs::DirtyFlags::DIRTY_SOURCE_SCRIPT | dirty;
+		}
+		else
+		{
+			entity.assign<ecs::DirtyComponent>(ecs::DirtyFlags::DIRTY_SOURCE_SCRIPT | dirty);
+		}
+	}
+
+	// Whatever is left has gone out of range or been destroyed on the server
+	for (auto& entry : entities)
+	{
+		destroy(entry.second);
+	}
+}
+
 std::unordered_map<scripting::ScriptObjectHandle, std::string> Scene::getScriptObjectNameMap() const
 {
 	std::unordered_map<scripting::ScriptObjectHandle, std::string> map;
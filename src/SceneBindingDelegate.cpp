@@ -11,6 +11,8 @@
 
 #include "ModelHandle.hpp"
 #include "Scene.hpp"
+#include "HeightMapTileSource.hpp"
+#include "NoiseTileSource.hpp"
 
 #include "graphics/IGraphicsEngine.hpp"
 
@@ -39,11 +41,73 @@ namespace raybinding
 void InitConstructor(const glm::vec3& from, const glm::vec3& to, void* memory) { new(memory) ray::Ray(from, to); }
 }
 
+namespace spherebinding
+{
+void InitConstructor(const glm::vec3& origin, const float32 radius, void* memory) { new(memory) physics::Sphere(origin, radius); }
+}
+
 uint64 sceneGetNumEntitiesProxy(const Scene* scene)
 {
     return static_cast<uint64>(scene->getNumEntities());
 }
 
+// Scripts get the flat results of a batched query as the entities plus an offset per query
+void sceneQueryProxy(Scene* scene, const std::vector<physics::Sphere>& spheres, std::vector<ecs::Entity>& entities, std::vector<uint32>& offsets)
+{
+    QueryResults<ecs::Entity> results;
+    scene->query(spheres, results);
+
+    entities = results.values();
+    offsets = results.offsets();
+}
+
+std::vector<ecs::Entity> sceneEntitiesInRadiusProxy(Scene* scene, const glm::vec3& origin, const float32 radius)
+{
+    std::vector<ecs::Entity> entities;
+    scene->entitiesInRadius(origin, radius, entities);
+
+    return entities;
+}
+
+std::vector<ecs::Entity> sceneEntitiesInBoxProxy(Scene* scene, const glm::vec3& minimum, const glm::vec3& maximum)
+{
+    std::vector<ecs::Entity> entities;
+    scene->entitiesInBox(minimum, maximum, entities);
+
+    return entities;
+}
+
+std::vector<ecs::Entity> sceneEntitiesInFrustumProxy(Scene* scene, const glm::mat4& viewProjection)
+{
+    std::vector<ecs::Entity> entities;
+    scene->entitiesInFrustum(viewProjection, entities);
+
+    return entities;
+}
+
+std::vector<ecs::Entity> sceneNearestEntitiesProxy(Scene* scene, const glm::vec3& origin, const uint32 k, const float32 maxDistance)
+{
+    std::vector<ecs::Entity> entities;
+    scene->nearestEntities(origin, k, entities, maxDistance);
+
+    return entities;
+}
+
+void sceneSerializeAsyncProxy(Scene* scene, const std::string& filename, const bool incremental)
+{
+    scene->serializeAsync(filename, incremental);
+}
+
+StreamingTerrain* sceneCreateStreamingTerrainProxy(Scene* scene, const HeightMap& heightMap, const SplatMap& splatMap, const DisplacementMap& displacementMap)
+{
+    return scene->createStreamingTerrain(std::make_unique<HeightMapTileSource>(heightMap), splatMap, displacementMap);
+}
+
+StreamingTerrain* sceneCreateStreamingTerrainProxy(Scene* scene, const noise::Noise& noise, const SplatMap& splatMap, const DisplacementMap& displacementMap)
+{
+    return scene->createStreamingTerrain(std::make_unique<NoiseTileSource>(noise), splatMap, displacementMap);
+}
+
 SceneBindingDelegate::SceneBindingDelegate(logger::ILogger* logger, scripting::IScriptingEngine* scriptingEngine, GameEngine* gameEngine, graphics::IGraphicsEngine* graphicsEngine, audio::IAudioEngine* audioEngine, networking::INetworkingEngine* networkingEngine, physics::IPhysicsEngine* physicsEngine, pathfinding::IPathfindingEngine* pathfindingEngine)
 	:
 	logger_(logger),
@@ -105,6 +169,15 @@ void SceneBindingDelegate::bind()
 		"Entity entity() const",
 		asMETHODPR(Raycast, entity, () const, ecs::Entity)
 	);
+	registerVectorBindings<ray::Ray>(scriptingEngine_, "vectorRay", "Ray");
+	registerVectorBindings<Raycast>(scriptingEngine_, "vectorRaycast", "Raycast");
+
+	scriptingEngine_->registerObjectType("Sphere", sizeof(physics::Sphere), asOBJ_VALUE | asOBJ_POD | asOBJ_APP_CLASS_ALLFLOATS | asGetTypeTraits<physics::Sphere>());
+	scriptingEngine_->registerObjectBehaviour("Sphere", asBEHAVE_CONSTRUCT, "void f(const vec3& in, const float)", asFUNCTION(spherebinding::InitConstructor), asCALL_CDECL_OBJLAST);
+	scriptingEngine_->registerObjectProperty("Sphere", "vec3 origin", asOFFSET(physics::Sphere, origin));
+	scriptingEngine_->registerObjectProperty("Sphere", "float radius", asOFFSET(physics::Sphere, radius));
+	registerVectorBindings<physics::Sphere>(scriptingEngine_, "vectorSphere", "Sphere");
+
 	//scriptingEngine_->registerObjectProperty("Raycast", "vec3 from", asOFFSET(ray::Ray, from));
 	//scriptingEngine_->registerObjectProperty("Raycast", "vec3 to", asOFFSET(ray::Ray, to));
 
@@ -127,6 +200,18 @@ void SceneBindingDelegate::bind()
 
 	scriptingEngine_->registerFunctionDefinition("void EntitiesWithComponentsCallBack(Entity)");
 
+	scriptingEngine_->registerObjectType("StreamingTerrain", 0, asOBJ_REF | asOBJ_NOCOUNT);
+	scriptingEngine_->registerClassMethod(
+		"StreamingTerrain",
+		"const vectorCrowdHandle& crowds() const",
+		asMETHODPR(StreamingTerrain, crowds, () const, const std::vector<pathfinding::CrowdHandle>&)
+	);
+	scriptingEngine_->registerClassMethod("StreamingTerrain", "void setCamera(const CameraHandle& in)", asMETHOD(StreamingTerrain, setCamera));
+	scriptingEngine_->registerClassMethod("StreamingTerrain", "void setFocus(const vec3& in)", asMETHOD(StreamingTerrain, setFocus));
+	scriptingEngine_->registerClassMethod("StreamingTerrain", "const vec3& focus() const", asMETHOD(StreamingTerrain, focus));
+	scriptingEngine_->registerClassMethod("StreamingTerrain", "uint32 numberOfLoadedTiles() const", asMETHOD(StreamingTerrain, numberOfLoadedTiles));
+	scriptingEngine_->registerClassMethod("StreamingTerrain", "uint32 numberOfPendingTiles() const", asMETHOD(StreamingTerrain, numberOfPendingTiles));
+
 	// Scene
 //	scriptingEngine_->registerObjectType("Scene", 0, asOBJ_REF | asOBJ_NOCOUNT);
 	scriptingEngine_->registerClassMethod("Scene", "const string& name() const", asMETHOD(Scene, name));
@@ -141,6 +226,8 @@ void SceneBindingDelegate::bind()
 	);
 	scriptingEngine_->registerClassMethod("Scene", "void setDebugRendering(const bool)", asMETHOD(Scene, setDebugRendering));
 	scriptingEngine_->registerClassMethod("Scene", "bool debugRendering() const", asMETHOD(Scene, debugRendering));
+	scriptingEngine_->registerClassMethod("Scene", "void setAnimationLodCamera(const CameraHandle& in)", asMETHOD(Scene, setAnimationLodCamera));
+	scriptingEngine_->registerClassMethod("Scene", "const CameraHandle& animationLodCamera() const", asMETHOD(Scene, animationLodCamera));
 	scriptingEngine_->registerClassMethod("Scene", "CrowdHandle createCrowd(const NavigationMeshHandle& in, const CrowdConfig& in)", asMETHOD(Scene, createCrowd));
 	scriptingEngine_->registerClassMethod(
 		"Scene",
@@ -208,6 +295,18 @@ void SceneBindingDelegate::bind()
 		"ITerrain@ testCreateTerrain(HeightMap, SplatMap, DisplacementMap, CollisionShapeHandle, PolygonMeshHandle, NavigationMeshHandle)",
 		asMETHOD(Scene, testCreateTerrain)
 	);
+	scriptingEngine_->registerObjectMethod(
+		"Scene",
+		"StreamingTerrain@ createStreamingTerrain(const HeightMap& in, const SplatMap& in, const DisplacementMap& in)",
+		asFUNCTIONPR(sceneCreateStreamingTerrainProxy, (Scene*, const HeightMap&, const SplatMap&, const DisplacementMap&), StreamingTerrain*),
+		asCALL_CDECL_OBJFIRST
+	);
+	scriptingEngine_->registerObjectMethod(
+		"Scene",
+		"StreamingTerrain@ createStreamingTerrain(const Noise& in, const SplatMap& in, const DisplacementMap& in)",
+		asFUNCTIONPR(sceneCreateStreamingTerrainProxy, (Scene*, const noise::Noise&, const SplatMap&, const DisplacementMap&), StreamingTerrain*),
+		asCALL_CDECL_OBJFIRST
+	);
 	scriptingEngine_->registerClassMethod(
 		"Scene",
 		"void entitiesWithComponentsScriptObjectComponent(EntitiesWithComponentsCallBack@)",
@@ -219,13 +318,20 @@ void SceneBindingDelegate::bind()
 	scriptingEngine_->registerClassMethod("Scene", "void addPostDeserializeCallback(PostDeserializeCallback@)", asMETHODPR(Scene, addPostDeserializeCallback, (void*), void));
 	scriptingEngine_->registerClassMethod("Scene", "void serialize(const string& in)", asMETHODPR(Scene, serialize, (const std::string&), void));
 	scriptingEngine_->registerClassMethod("Scene", "void deserialize(const string& in)", asMETHODPR(Scene, deserialize, (const std::string&), void));
+	scriptingEngine_->registerObjectMethod("Scene", "void serializeAsync(const string& in, const bool = false)", asFUNCTION(sceneSerializeAsyncProxy), asCALL_CDECL_OBJFIRST);
 	scriptingEngine_->registerClassMethod("Scene", "Entity createEntity()", asMETHODPR(Scene, createEntity, (), ecs::Entity));
 	scriptingEngine_->registerClassMethod("Scene", "void destroy(Entity& in)", asMETHODPR(Scene, destroy, (ecs::Entity&), void));
 	scriptingEngine_->registerClassMethod("Scene", "void destroyAsync(Entity& in)", asMETHOD(Scene, destroyAsync));
 	scriptingEngine_->registerObjectMethod("Scene", "uint64 getNumEntities() const", asFUNCTION(sceneGetNumEntitiesProxy), asCALL_CDECL_OBJFIRST);
-	scriptingEngine_->registerClassMethod("Scene", "Raycast raycast(const Ray& in)", asMETHOD(Scene, raycast));
+	scriptingEngine_->registerClassMethod("Scene", "Raycast raycast(const Ray& in)", asMETHODPR(Scene, raycast, (const ray::Ray&), Raycast));
 	scriptingEngine_->registerClassMethod("Scene", "vectorEntity query(const vec3& in, const vectorVec3& in)", asMETHODPR(Scene, query, (const glm::vec3&, const std::vector<glm::vec3>&), std::vector<ecs::Entity>));
 	scriptingEngine_->registerClassMethod("Scene", "vectorEntity query(const vec3& in, const float)", asMETHODPR(Scene, query, (const glm::vec3&, const float32), std::vector<ecs::Entity>));
+	scriptingEngine_->registerClassMethod("Scene", "void raycast(const vectorRay& in, vectorRaycast& out)", asMETHODPR(Scene, raycast, (const std::vector<ray::Ray>&, std::vector<Raycast>&), void));
+	scriptingEngine_->registerObjectMethod("Scene", "void query(const vectorSphere& in, vectorEntity& out, vectorUInt32& out)", asFUNCTION(sceneQueryProxy), asCALL_CDECL_OBJFIRST);
+	scriptingEngine_->registerObjectMethod("Scene", "vectorEntity entitiesInRadius(const vec3& in, const float)", asFUNCTION(sceneEntitiesInRadiusProxy), asCALL_CDECL_OBJFIRST);
+	scriptingEngine_->registerObjectMethod("Scene", "vectorEntity entitiesInBox(const vec3& in, const vec3& in)", asFUNCTION(sceneEntitiesInBoxProxy), asCALL_CDECL_OBJFIRST);
+	scriptingEngine_->registerObjectMethod("Scene", "vectorEntity entitiesInFrustum(const mat4& in)", asFUNCTION(sceneEntitiesInFrustumProxy), asCALL_CDECL_OBJFIRST);
+	scriptingEngine_->registerObjectMethod("Scene", "vectorEntity nearestEntities(const vec3& in, const uint32, const float = 3.402823466e+38)", asFUNCTION(sceneNearestEntitiesProxy), asCALL_CDECL_OBJFIRST);
 }
 
 };
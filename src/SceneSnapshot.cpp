@@ -0,0 +1,881 @@
+#include <cstring>
+#include <sstream>
+#include <tuple>
+#include <limits>
+#include <type_traits>
+
+#include "SceneSnapshot.hpp"
+#include "BlockCompressor.hpp"
+
+#include "ecs/SkeletonComponent.hpp"
+#include "ecs/AnimationComponent.hpp"
+#include "ecs/GraphicsTerrainComponent.hpp"
+#include "ecs/ParentComponent.hpp"
+#include "ecs/ChildrenComponent.hpp"
+#include "ecs/ParentBoneAttachmentComponent.hpp"
+#include "ecs/PropertiesComponent.hpp"
+#include "ecs/ReplicatedComponent.hpp"
+
+#include "serialization/BinaryOutArchive.hpp"
+#include "serialization/BinaryInArchive.hpp"
+
+#include "detail/Format.hpp"
+
+#include "exceptions/RuntimeException.hpp"
+
+namespace ice_engine
+{
+namespace
+{
+
+const uint32 FLAG_COMPRESSED = 1;
+const uint32 COMPONENT_BLOCK_VERSION = 1;
+
+// Persisted components, in the order they're assigned on load (the same order as the text archive)
+template <typename ... C>
+struct ComponentList
+{
+};
+
+typedef ComponentList<
+	ecs::GhostObjectComponent,
+	ecs::GraphicsComponent,
+	ecs::SkeletonComponent,
+	ecs::AnimationComponent,
+	ecs::GraphicsTerrainComponent,
+	ecs::PathfindingAgentComponent,
+	ecs::PathfindingObstacleComponent,
+	ecs::PathfindingCrowdComponent,
+	ecs::PointLightComponent,
+	ecs::PositionComponent,
+	ecs::OrientationComponent,
+	ecs::RigidBodyObjectComponent,
+	ecs::ScriptObjectComponent,
+	ecs::ParentComponent,
+	ecs::ChildrenComponent,
+	ecs::ParentBoneAttachmentComponent,
+	ecs::PropertiesComponent,
+	ecs::ReplicatedComponent
+> PersistedComponents;
+
+template <typename ... C, typename Function>
+void forEachComponent(ComponentList<C ...>, Function&& function)
+{
+	using expand = int[];
+	(void)expand{0, (function(static_cast<C*>(nullptr)), 0) ...};
+}
+
+// Components that are plain data are stored as a column of values, everything else goes through a binary archive
+template <typename C>
+struct Column
+{
+	static const bool IS_COLUMN = false;
+};
+
+template <>
+struct Column<ecs::PositionComponent>
+{
+	static const bool IS_COLUMN = true;
+	typedef glm::vec3 Type;
+
+	static const Type& get(const ecs::PositionComponent& component) { return component.position; }
+	static ecs::PositionComponent make(const Type& value) { return ecs::PositionComponent(value); }
+};
+
+template <>
+struct Column<ecs::OrientationComponent>
+{
+	static const bool IS_COLUMN = true;
+	typedef glm::quat Type;
+
+	static const Type& get(const ecs::OrientationComponent& component) { return component.orientation; }
+	static ecs::OrientationComponent make(const Type& value) { return ecs::OrientationComponent(value); }
+};
+
+static_assert(sizeof(glm::vec3) == 3 * sizeof(float32), "Position column must be tightly packed floats.");
+static_assert(sizeof(glm::quat) == 4 * sizeof(float32), "Orientation column must be tightly packed floats.");
+
+bool isLittleEndian()
+{
+	const uint16 value = 1;
+	byte first;
+	std::memcpy(&first, &value, 1);
+
+	return first == 1;
+}
+
+void writeUint32(std::ostream& outputStream, const uint32 value)
+{
+	const char bytes[4] = {
+		static_cast<char>(value & 0xFF),
+		static_cast<char>((value >> 8) & 0xFF),
+		static_cast<char>((value >> 16) & 0xFF),
+		static_cast<char>((value >> 24) & 0xFF)
+	};
+
+	outputStream.write(bytes, 4);
+}
+
+uint32 readUint32(std::istream& inputStream)
+{
+	byte bytes[4];
+	inputStream.read(reinterpret_cast<char*>(bytes), 4);
+
+	if (!inputStream)
+	{
+		throw RuntimeException("Unexpected end of scene snapshot.");
+	}
+
+	return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<uint32>(bytes[3]) << 24);
+}
+
+// Columns are written in the host's byte order, which the writer and reader check is little endian
+template <typename T>
+void appendColumn(std::vector<byte>& data, const T* values, const size_t count)
+{
+	const byte* bytes = reinterpret_cast<const byte*>(values);
+	data.insert(data.end(), bytes, bytes + count * sizeof(T));
+}
+
+template <typename T>
+void readColumn(const byte*& source, const byte* sourceEnd, T* values, const size_t count)
+{
+	const size_t size = count * sizeof(T);
+
+	if (size > static_cast<size_t>(sourceEnd - source))
+	{
+		throw RuntimeException("Unexpected end of scene snapshot block.");
+	}
+
+	std::memcpy(values, source, size);
+	source += size;
+}
+
+// get(i) returns the component for the i'th row
+template <typename C, typename Get>
+void writeComponents(std::vector<byte>& data, const size_t count, Get&& get, std::true_type)
+{
+	std::vector<typename Column<C>::Type> column;
+	column.reserve(count);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		column.push_back(Column<C>::get(get(i)));
+	}
+
+	appendColumn(data, column.data(), column.size());
+}
+
+template <typename C, typename Get>
+void writeComponents(std::vector<byte>& data, const size_t count, Get&& get, std::false_type)
+{
+	std::ostringstream stream;
+
+	{
+		serialization::BinaryOutArchive ar(stream);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			ar & get(i);
+		}
+	}
+
+	const std::string archive = stream.str();
+	data.insert(data.end(), archive.begin(), archive.end());
+}
+
+template <typename C, typename Get>
+void writeComponentBlock(SceneSnapshotWriter& writer, const std::vector<uint32>& rows, Get&& get)
+{
+	if (rows.empty())
+	{
+		return;
+	}
+
+	std::vector<byte> data;
+
+	const uint32 count = static_cast<uint32>(rows.size());
+	appendColumn(data, &count, 1);
+	appendColumn(data, rows.data(), rows.size());
+
+	writeComponents<C>(data, rows.size(), get, std::integral_constant<bool, Column<C>::IS_COLUMN>());
+
+	writer.writeBlock(SceneSnapshot::TAG_COMPONENT + C::id(), COMPONENT_BLOCK_VERSION, data);
+}
+
+void writeEntityBlock(SceneSnapshotWriter& writer, const std::vector<uint32>& indices)
+{
+	std::vector<byte> data;
+
+	const uint32 count = static_cast<uint32>(indices.size());
+	appendColumn(data, &count, 1);
+	appendColumn(data, indices.data(), indices.size());
+
+	writer.writeBlock(SceneSnapshot::TAG_ENTITIES, 1, data);
+}
+
+template <typename C>
+struct CapturedComponents
+{
+	std::vector<uint32> rows;
+	std::vector<C> components;
+};
+
+template <typename List>
+struct CapturedComponentsTuple;
+
+template <typename ... C>
+struct CapturedComponentsTuple<ComponentList<C ...>>
+{
+	typedef std::tuple<CapturedComponents<C> ...> Type;
+};
+
+// 64 bit FNV-1a
+const uint64 HASH_OFFSET = 14695981039346656037ull;
+const uint64 HASH_PRIME = 1099511628211ull;
+
+uint64 hashBytes(uint64 hash, const void* data, const size_t size)
+{
+	const byte* bytes = static_cast<const byte*>(data);
+
+	for (size_t i = 0; i < size; ++i)
+	{
+		hash ^= bytes[i];
+		hash *= HASH_PRIME;
+	}
+
+	return hash;
+}
+
+void hashComponent(std::vector<uint64>& entityHashes, const uint32 row, const uint32 tag, const uint64 componentHash)
+{
+	entityHashes[row] = hashBytes(entityHashes[row], &tag, sizeof(tag));
+	entityHashes[row] = hashBytes(entityHashes[row], &componentHash, sizeof(componentHash));
+}
+
+template <typename C>
+void hashComponents(const CapturedComponents<C>& captured, std::vector<uint64>& entityHashes, std::true_type)
+{
+	const uint32 tag = SceneSnapshot::TAG_COMPONENT + C::id();
+
+	for (size_t i = 0; i < captured.rows.size(); ++i)
+	{
+		const auto& value = Column<C>::get(captured.components[i]);
+
+		hashComponent(entityHashes, captured.rows[i], tag, hashBytes(HASH_OFFSET, &value, sizeof(value)));
+	}
+}
+
+// Components are hashed through their archived bytes.  The archive's class information is written with the first
+// component, so the first entity of a column can show up as changed when the column order changes - which only costs
+// writing that entity again.
+template <typename C>
+void hashComponents(const CapturedComponents<C>& captured, std::vector<uint64>& entityHashes, std::false_type)
+{
+	const uint32 tag = SceneSnapshot::TAG_COMPONENT + C::id();
+
+	std::ostringstream stream;
+	std::vector<size_t> ends;
+	ends.reserve(captured.rows.size());
+
+	{
+		serialization::BinaryOutArchive ar(stream);
+
+		for (const auto& component : captured.components)
+		{
+			ar & component;
+			ends.push_back(static_cast<size_t>(stream.tellp()));
+		}
+	}
+
+	const std::string archive = stream.str();
+
+	size_t begin = 0;
+	for (size_t i = 0; i < captured.rows.size(); ++i)
+	{
+		hashComponent(entityHashes, captured.rows[i], tag, hashBytes(HASH_OFFSET, archive.data() + begin, ends[i] - begin));
+		begin = ends[i];
+	}
+}
+
+template <typename C>
+void readComponents(const byte* source, const byte* sourceEnd, ecs::EntityComponentSystem& entityComponentSystem, const std::vector<ecs::Entity>& entities, const std::vector<uint32>& rows, std::true_type)
+{
+	std::vector<typename Column<C>::Type> column(rows.size());
+	readColumn(source, sourceEnd, column.data(), column.size());
+
+	for (size_t i = 0; i < rows.size(); ++i)
+	{
+		entityComponentSystem.assign<C>(entities[rows[i]].id(), Column<C>::make(column[i]));
+	}
+}
+
+template <typename C>
+void readComponents(const byte* source, const byte* sourceEnd, ecs::EntityComponentSystem& entityComponentSystem, const std::vector<ecs::Entity>& entities, const std::vector<uint32>& rows, std::false_type)
+{
+	std::istringstream stream(std::string(reinterpret_cast<const char*>(source), sourceEnd - source));
+	serialization::BinaryInArchive ar(stream);
+
+	for (const auto row : rows)
+	{
+		C component;
+		ar & component;
+
+		entityComponentSystem.assign<C>(entities[row].id(), component);
+	}
+}
+
+template <typename C>
+void readComponentBlock(const SceneSnapshotReader& reader, ecs::EntityComponentSystem& entityComponentSystem, const std::vector<ecs::Entity>& entities, logger::ILogger* logger)
+{
+	const uint32 tag = SceneSnapshot::TAG_COMPONENT + C::id();
+
+	if (!reader.hasBlock(tag))
+	{
+		return;
+	}
+
+	if (reader.blockVersion(tag) > COMPONENT_BLOCK_VERSION)
+	{
+		LOG_WARN(logger, "Skipping scene snapshot component block %s with unsupported version %s.", tag, reader.blockVersion(tag));
+		return;
+	}
+
+	const auto& data = reader.block(tag);
+	const byte* source = data.data();
+	const byte* sourceEnd = data.data() + data.size();
+
+	uint32 count = 0;
+	readColumn(source, sourceEnd, &count, 1);
+
+	std::vector<uint32> rows(count);
+	readColumn(source, sourceEnd, rows.data(), rows.size());
+
+	for (const auto row : rows)
+	{
+		if (row >= entities.size())
+		{
+			throw RuntimeException(detail::format("Scene snapshot component block %s references entity row %s, but there are only %s entities.", tag, row, entities.size()));
+		}
+	}
+
+	readComponents<C>(source, sourceEnd, entityComponentSystem, entities, rows, std::integral_constant<bool, Column<C>::IS_COLUMN>());
+}
+
+}
+
+struct EntitySnapshot::Components
+{
+	CapturedComponentsTuple<PersistedComponents>::Type columns;
+};
+
+const uint32 SceneSnapshot::MAGIC;
+const uint32 SceneSnapshot::VERSION;
+
+bool SceneSnapshot::isSnapshot(std::istream& inputStream)
+{
+	const auto position = inputStream.tellg();
+
+	byte bytes[4];
+	inputStream.read(reinterpret_cast<char*>(bytes), 4);
+
+	const bool result = (inputStream.gcount() == 4 && (bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<uint32>(bytes[3]) << 24)) == MAGIC);
+
+	inputStream.clear();
+	inputStream.seekg(position);
+
+	return result;
+}
+
+SceneSnapshotWriter::SceneSnapshotWriter(std::ostream& outputStream, const bool compress) : outputStream_(outputStream), compress_(compress)
+{
+	if (!isLittleEndian())
+	{
+		throw RuntimeException("Scene snapshots are only supported on little endian hosts.");
+	}
+
+	writeUint32(outputStream_, SceneSnapshot::MAGIC);
+	writeUint32(outputStream_, SceneSnapshot::VERSION);
+	writeUint32(outputStream_, compress_ ? FLAG_COMPRESSED : 0);
+}
+
+void SceneSnapshotWriter::writeBlock(const uint32 tag, const uint32 version, const std::string& data)
+{
+	writeBlock(tag, version, std::vector<byte>(data.begin(), data.end()));
+}
+
+void SceneSnapshotWriter::writeBlock(const uint32 tag, const uint32 version, const std::vector<byte>& data)
+{
+	uint32 flags = 0;
+	const std::vector<byte>* payload = &data;
+
+	std::vector<byte> compressed;
+	if (compress_ && !data.empty())
+	{
+		compressed = BlockCompressor::compress(data.data(), data.size());
+
+		// Incompressible blocks are stored as is
+		if (compressed.size() < data.size())
+		{
+			flags |= FLAG_COMPRESSED;
+			payload = &compressed;
+		}
+	}
+
+	writeUint32(outputStream_, tag);
+	writeUint32(outputStream_, version);
+	writeUint32(outputStream_, flags);
+	writeUint32(outputStream_, static_cast<uint32>(data.size()));
+	writeUint32(outputStream_, static_cast<uint32>(payload->size()));
+	outputStream_.write(reinterpret_cast<const char*>(payload->data()), payload->size());
+
+	if (!outputStream_)
+	{
+		throw RuntimeException(detail::format("Unable to write scene snapshot block %s.", tag));
+	}
+}
+
+void SceneSnapshotWriter::writeEntities(const ecs::EntityComponentSystem& entityComponentSystem)
+{
+	std::vector<ecs::Entity> entities;
+	std::vector<uint32> indices;
+
+	for (auto entity : entityComponentSystem.entitiesWithComponents<ecs::PersistableComponent>())
+	{
+		entities.push_back(entity);
+		indices.push_back(entity.id().index());
+	}
+
+	writeEntityBlock(*this, indices);
+
+	forEachComponent(PersistedComponents(), [&](auto* type) {
+		typedef typename std::remove_pointer<decltype(type)>::type C;
+
+		std::vector<uint32> rows;
+
+		for (uint32 row = 0; row < entities.size(); ++row)
+		{
+			if (entities[row].template hasComponent<C>())
+			{
+				rows.push_back(row);
+			}
+		}
+
+		writeComponentBlock<C>(*this, rows, [&](const size_t i) -> const C& {
+			return *entities[rows[i]].template component<const C>();
+		});
+	});
+}
+
+void SceneSnapshotWriter::writeEntities(const EntitySnapshot& entitySnapshot)
+{
+	writeEntityBlock(*this, entitySnapshot.indices_);
+
+	forEachComponent(PersistedComponents(), [&](auto* type) {
+		typedef typename std::remove_pointer<decltype(type)>::type C;
+
+		const auto& captured = std::get<CapturedComponents<C>>(entitySnapshot.components_->columns);
+
+		writeComponentBlock<C>(*this, captured.rows, [&](const size_t i) -> const C& {
+			return captured.components[i];
+		});
+	});
+}
+
+void SceneSnapshotWriter::writeIncrement(const SceneSnapshot::Increment& increment)
+{
+	std::vector<byte> data;
+
+	const uint32 saveId[2] = {static_cast<uint32>(increment.saveId & 0xFFFFFFFF), static_cast<uint32>(increment.saveId >> 32)};
+	appendColumn(data, saveId, 2);
+	appendColumn(data, &increment.sequence, 1);
+
+	const uint32 count = static_cast<uint32>(increment.removed.size());
+	appendColumn(data, &count, 1);
+	appendColumn(data, increment.removed.data(), increment.removed.size());
+
+	writeBlock(SceneSnapshot::TAG_INCREMENT, 1, data);
+}
+
+void SceneSnapshotWriter::finish()
+{
+	writeUint32(outputStream_, SceneSnapshot::TAG_END);
+	outputStream_.flush();
+}
+
+SceneSnapshotReader::SceneSnapshotReader(std::istream& inputStream, logger::ILogger* logger) : logger_(logger)
+{
+	if (!isLittleEndian())
+	{
+		throw RuntimeException("Scene snapshots are only supported on little endian hosts.");
+	}
+
+	if (readUint32(inputStream) != SceneSnapshot::MAGIC)
+	{
+		throw RuntimeException("Not a scene snapshot.");
+	}
+
+	const uint32 version = readUint32(inputStream);
+	if (version > SceneSnapshot::VERSION)
+	{
+		throw RuntimeException(detail::format("Unsupported scene snapshot version %s.", version));
+	}
+
+	readUint32(inputStream);
+
+	while (true)
+	{
+		const uint32 tag = readUint32(inputStream);
+
+		if (tag == SceneSnapshot::TAG_END)
+		{
+			break;
+		}
+
+		Block block;
+		block.version = readUint32(inputStream);
+		const uint32 flags = readUint32(inputStream);
+		const uint32 size = readUint32(inputStream);
+		const uint32 storedSize = readUint32(inputStream);
+
+		std::vector<byte> stored(storedSize);
+		inputStream.read(reinterpret_cast<char*>(stored.data()), storedSize);
+
+		if (!inputStream)
+		{
+			throw RuntimeException("Unexpected end of scene snapshot.");
+		}
+
+		if (flags & FLAG_COMPRESSED)
+		{
+			block.data.resize(size);
+			BlockCompressor::decompress(stored.data(), stored.size(), block.data.data(), block.data.size());
+		}
+		else if (storedSize == size)
+		{
+			block.data = std::move(stored);
+		}
+		else
+		{
+			throw RuntimeException(detail::format("Scene snapshot block %s has size %s, expected %s.", tag, storedSize, size));
+		}
+
+		blocks_[tag] = std::move(block);
+	}
+}
+
+bool SceneSnapshotReader::hasBlock(const uint32 tag) const
+{
+	return blocks_.find(tag) != blocks_.end();
+}
+
+const std::vector<byte>& SceneSnapshotReader::block(const uint32 tag) const
+{
+	const auto it = blocks_.find(tag);
+
+	if (it == blocks_.end())
+	{
+		throw RuntimeException(detail::format("Scene snapshot has no block %s.", tag));
+	}
+
+	return it->second.data;
+}
+
+std::string SceneSnapshotReader::blockString(const uint32 tag) const
+{
+	const auto& data = block(tag);
+
+	return std::string(data.begin(), data.end());
+}
+
+uint32 SceneSnapshotReader::blockVersion(const uint32 tag) const
+{
+	const auto it = blocks_.find(tag);
+
+	if (it == blocks_.end())
+	{
+		throw RuntimeException(detail::format("Scene snapshot has no block %s.", tag));
+	}
+
+	return it->second.version;
+}
+
+std::vector<uint32> SceneSnapshotReader::readEntityIndices() const
+{
+	const auto& data = block(SceneSnapshot::TAG_ENTITIES);
+	const byte* source = data.data();
+	const byte* sourceEnd = data.data() + data.size();
+
+	uint32 count = 0;
+	readColumn(source, sourceEnd, &count, 1);
+
+	std::vector<uint32> indices(count);
+	readColumn(source, sourceEnd, indices.data(), indices.size());
+
+	return indices;
+}
+
+void SceneSnapshotReader::readEntities(ecs::EntityComponentSystem& entityComponentSystem) const
+{
+	const auto indices = readEntityIndices();
+
+	// Recreate entities with the same indices they were saved with, so entity references in components stay valid
+	std::vector<ecs::Entity> entities;
+	std::vector<ecs::Entity> emptyEntities;
+	entities.reserve(indices.size());
+
+	for (const auto index : indices)
+	{
+		auto entity = entityComponentSystem.create();
+		while (entity.id().index() < index)
+		{
+			emptyEntities.push_back(entity);
+			entity = entityComponentSystem.create();
+		}
+
+		entities.push_back(entity);
+	}
+
+	forEachComponent(PersistedComponents(), [&](auto* type) {
+		readComponentBlock<typename std::remove_pointer<decltype(type)>::type>(*this, entityComponentSystem, entities, logger_);
+	});
+
+	for (auto& entity : entities)
+	{
+		entityComponentSystem.assign<ecs::PersistableComponent>(entity.id());
+	}
+
+	for (auto& entity : emptyEntities)
+	{
+		entity.destroy();
+	}
+}
+
+void SceneSnapshotReader::readEntityChanges(ecs::EntityComponentSystem& entityComponentSystem) const
+{
+	// entityx ids made from an index are valid for free slots too - everything a snapshot loaded is persistable though
+	auto loaded = [&entityComponentSystem](const uint32 index) {
+		return index < entityComponentSystem.capacity() && entityComponentSystem.hasComponent<ecs::PersistableComponent>(entityComponentSystem.createId(index));
+	};
+
+	for (const auto index : increment().removed)
+	{
+		if (loaded(index))
+		{
+			auto entity = entityComponentSystem.get(entityComponentSystem.createId(index));
+			entityComponentSystem.destroy(entity);
+		}
+	}
+
+	const auto indices = readEntityIndices();
+
+	std::vector<ecs::Entity> entities;
+	std::unordered_map<uint32, ecs::Entity> emptyEntities;
+	entities.reserve(indices.size());
+
+	for (const auto index : indices)
+	{
+		// Created as filler for an earlier index
+		const auto empty = emptyEntities.find(index);
+		if (empty != emptyEntities.end())
+		{
+			entities.push_back(empty->second);
+			emptyEntities.erase(empty);
+
+			continue;
+		}
+
+		if (loaded(index))
+		{
+			const auto id = entityComponentSystem.createId(index);
+
+			// Changed entities get all of their persisted components replaced
+			forEachComponent(PersistedComponents(), [&](auto* type) {
+				typedef typename std::remove_pointer<decltype(type)>::type C;
+
+				if (entityComponentSystem.hasComponent<C>(id))
+				{
+					entityComponentSystem.remove<C>(id);
+				}
+			});
+
+			entities.push_back(entityComponentSystem.get(id));
+
+			continue;
+		}
+
+		// Free slots are reused first, in no particular order, then new ones are handed out in increasing order - so
+		// once a new slot is past the index, the index is held by an entity that wasn't loaded from the snapshot
+		auto capacity = entityComponentSystem.capacity();
+		auto entity = entityComponentSystem.create();
+
+		while (entity.id().index() != index)
+		{
+			if (entity.id().index() >= capacity && entity.id().index() > index)
+			{
+				entity.destroy();
+
+				throw RuntimeException(detail::format("Unable to load entity %s from incremental snapshot - its index is already in use.", index));
+			}
+
+			emptyEntities[entity.id().index()] = entity;
+
+			capacity = entityComponentSystem.capacity();
+			entity = entityComponentSystem.create();
+		}
+
+		entities.push_back(entity);
+	}
+
+	forEachComponent(PersistedComponents(), [&](auto* type) {
+		readComponentBlock<typename std::remove_pointer<decltype(type)>::type>(*this, entityComponentSystem, entities, logger_);
+	});
+
+	for (auto& entity : entities)
+	{
+		if (!entity.hasComponent<ecs::PersistableComponent>())
+		{
+			entityComponentSystem.assign<ecs::PersistableComponent>(entity.id());
+		}
+	}
+
+	for (auto& kv : emptyEntities)
+	{
+		kv.second.destroy();
+	}
+}
+
+SceneSnapshot::Increment SceneSnapshotReader::increment() const
+{
+	const auto& data = block(SceneSnapshot::TAG_INCREMENT);
+	const byte* source = data.data();
+	const byte* sourceEnd = data.data() + data.size();
+
+	SceneSnapshot::Increment increment;
+
+	uint32 saveId[2] = {0, 0};
+	readColumn(source, sourceEnd, saveId, 2);
+	increment.saveId = saveId[0] | (static_cast<uint64>(saveId[1]) << 32);
+
+	readColumn(source, sourceEnd, &increment.sequence, 1);
+
+	uint32 count = 0;
+	readColumn(source, sourceEnd, &count, 1);
+
+	increment.removed.resize(count);
+	readColumn(source, sourceEnd, increment.removed.data(), increment.removed.size());
+
+	return increment;
+}
+
+EntitySnapshot::EntitySnapshot() : components_(std::make_unique<Components>())
+{
+}
+
+EntitySnapshot::EntitySnapshot(const ecs::EntityComponentSystem& entityComponentSystem) : EntitySnapshot()
+{
+	std::vector<ecs::Entity> entities;
+
+	for (auto entity : entityComponentSystem.entitiesWithComponents<ecs::PersistableComponent>())
+	{
+		entities.push_back(entity);
+		indices_.push_back(entity.id().index());
+	}
+
+	forEachComponent(PersistedComponents(), [&](auto* type) {
+		typedef typename std::remove_pointer<decltype(type)>::type C;
+
+		auto& captured = std::get<CapturedComponents<C>>(components_->columns);
+
+		for (uint32 row = 0; row < entities.size(); ++row)
+		{
+			if (entities[row].template hasComponent<C>())
+			{
+				captured.rows.push_back(row);
+				captured.components.push_back(*entities[row].template component<const C>());
+			}
+		}
+	});
+}
+
+EntitySnapshot::~EntitySnapshot() = default;
+
+EntitySnapshot::EntitySnapshot(EntitySnapshot&& other) = default;
+EntitySnapshot& EntitySnapshot::operator=(EntitySnapshot&& other) = default;
+
+const std::vector<uint32>& EntitySnapshot::indices() const
+{
+	return indices_;
+}
+
+std::unordered_map<uint32, uint64> EntitySnapshot::hashes() const
+{
+	std::vector<uint64> entityHashes(indices_.size(), HASH_OFFSET);
+
+	forEachComponent(PersistedComponents(), [&](auto* type) {
+		typedef typename std::remove_pointer<decltype(type)>::type C;
+
+		hashComponents<C>(std::get<CapturedComponents<C>>(components_->columns), entityHashes, std::integral_constant<bool, Column<C>::IS_COLUMN>());
+	});
+
+	std::unordered_map<uint32, uint64> hashes;
+	hashes.reserve(indices_.size());
+
+	for (size_t row = 0; row < indices_.size(); ++row)
+	{
+		hashes[indices_[row]] = entityHashes[row];
+	}
+
+	return hashes;
+}
+
+EntitySnapshot EntitySnapshot::subset(const std::vector<uint32>& indices) const
+{
+	const uint32 NO_ROW = std::numeric_limits<uint32>::max();
+
+	std::unordered_map<uint32, uint32> rowsByIndex;
+	rowsByIndex.reserve(indices_.size());
+
+	for (uint32 row = 0; row < indices_.size(); ++row)
+	{
+		rowsByIndex[indices_[row]] = row;
+	}
+
+	EntitySnapshot result;
+
+	// Maps rows in this snapshot to rows in the subset
+	std::vector<uint32> subsetRows(indices_.size(), NO_ROW);
+
+	for (const auto index : indices)
+	{
+		const auto it = rowsByIndex.find(index);
+
+		if (it != rowsByIndex.end() && subsetRows[it->second] == NO_ROW)
+		{
+			subsetRows[it->second] = static_cast<uint32>(result.indices_.size());
+			result.indices_.push_back(index);
+		}
+	}
+
+	forEachComponent(PersistedComponents(), [&](auto* type) {
+		typedef typename std::remove_pointer<decltype(type)>::type C;
+
+		const auto& captured = std::get<CapturedComponents<C>>(components_->columns);
+		auto& resultCaptured = std::get<CapturedComponents<C>>(result.components_->columns);
+
+		for (size_t i = 0; i < captured.rows.size(); ++i)
+		{
+			const uint32 row = subsetRows[captured.rows[i]];
+
+			if (row != NO_ROW)
+			{
+				resultCaptured.rows.push_back(row);
+				resultCaptured.components.push_back(captured.components[i]);
+			}
+		}
+	});
+
+	return result;
+}
+
+}
@@ -0,0 +1,82 @@
+#include <cmath>
+#include <algorithm>
+
+#include "SimulationClock.hpp"
+
+#include "exceptions/RuntimeException.hpp"
+
+#include "detail/Format.hpp"
+
+namespace ice_engine
+{
+
+SimulationClock::SimulationClock(const SimulationSettings& simulationSettings)
+	:
+	simulationSettings_(simulationSettings),
+	tickDelta_(1.0 / static_cast<float64>(simulationSettings.tickRate))
+{
+	if (simulationSettings_.tickRate <= 0.0f || simulationSettings_.maxTicksPerFrame == 0)
+	{
+		throw RuntimeException(detail::format("Simulation needs a positive tick rate and ticks per frame - got %s and %s.", simulationSettings_.tickRate, simulationSettings_.maxTicksPerFrame));
+	}
+}
+
+uint32 SimulationClock::advance(const float32 frameDelta)
+{
+	const float64 maxFrameDelta = std::max(static_cast<float64>(simulationSettings_.maxFrameDelta), tickDelta_);
+	const float64 delta = std::min(std::max(static_cast<float64>(frameDelta), 0.0), maxFrameDelta);
+
+	droppedTime_ += std::max(static_cast<float64>(frameDelta), 0.0) - delta;
+	accumulator_ += delta;
+
+	uint32 ticks = static_cast<uint32>(std::floor(accumulator_ / tickDelta_));
+
+	if (ticks > simulationSettings_.maxTicksPerFrame)
+	{
+		ticks = simulationSettings_.maxTicksPerFrame;
+	}
+
+	accumulator_ -= ticks * tickDelta_;
+
+	// Whatever is left beyond a partial tick couldn't be simulated this frame
+	const float64 backlog = simulationSettings_.catchUp ? maxFrameDelta : tickDelta_;
+
+	if (accumulator_ >= backlog)
+	{
+		const float64 kept = simulationSettings_.catchUp ? backlog : std::fmod(accumulator_, tickDelta_);
+
+		droppedTime_ += accumulator_ - kept;
+		accumulator_ = kept;
+	}
+
+	ticks_ += ticks;
+
+	return ticks;
+}
+
+float32 SimulationClock::tickDelta() const
+{
+	return static_cast<float32>(tickDelta_);
+}
+
+float32 SimulationClock::alpha() const
+{
+	return static_cast<float32>(std::min(accumulator_ / tickDelta_, 0.999999));
+}
+
+uint64 SimulationClock::ticks() const
+{
+	return ticks_;
+}
+
+float64 SimulationClock::time() const
+{
+	return static_cast<float64>(ticks_) * tickDelta_;
+}
+
+float64 SimulationClock::droppedTime() const
+{
+	return droppedTime_;
+}
+
+}
@@ -0,0 +1,469 @@
+#include <cmath>
+#include <algorithm>
+#include <queue>
+#include <utility>
+#include <functional>
+
+#include "SpatialIndex.hpp"
+
+namespace ice_engine
+{
+namespace
+{
+
+// Squared distance from a point to an axis aligned box
+float32 distanceSquared(const glm::vec3& point, const glm::vec3& center, const float32 halfSize)
+{
+	float32 result = 0.0f;
+
+	for (int i = 0; i < 3; ++i)
+	{
+		const float32 d = std::max(std::abs(point[i] - center[i]) - halfSize, 0.0f);
+		result += d * d;
+	}
+
+	return result;
+}
+
+float32 distanceSquared(const glm::vec3& a, const glm::vec3& b)
+{
+	const glm::vec3 d = a - b;
+
+	return d.x * d.x + d.y * d.y + d.z * d.z;
+}
+
+float32 planeDistance(const glm::vec4& plane, const glm::vec3& point)
+{
+	return plane.x * point.x + plane.y * point.y + plane.z * point.z + plane.w;
+}
+
+}
+
+const uint32 SpatialIndex::NO_CHILDREN;
+
+SpatialIndex::SpatialIndex(const glm::vec3& center, const float32 halfSize, const uint32 maxItemsPerNode, const uint32 maxDepth)
+	:
+	maxItemsPerNode_(maxItemsPerNode),
+	maxDepth_(maxDepth)
+{
+	Node root;
+	root.center = center;
+	root.halfSize = halfSize;
+
+	nodes_.push_back(root);
+}
+
+void SpatialIndex::update(const Id id, const glm::vec3& position)
+{
+	const auto it = itemIndices_.find(id);
+
+	if (it == itemIndices_.end())
+	{
+		const uint32 itemIndex = static_cast<uint32>(items_.size());
+
+		items_.push_back({id, position, 0, 0});
+		itemIndices_[id] = itemIndex;
+
+		insert(itemIndex);
+
+		return;
+	}
+
+	const uint32 itemIndex = it->second;
+	auto& item = items_[itemIndex];
+	item.position = position;
+
+	const Node& node = nodes_[item.node];
+
+	// Items in the root are either in a root without children, or outside of the root's bounds
+	const bool stays = (item.node == 0 ? (node.children == NO_CHILDREN || !insideBounds(node, position)) : insideLooseBounds(node, position));
+
+	if (!stays)
+	{
+		removeFromNode(itemIndex);
+		insert(itemIndex);
+	}
+}
+
+void SpatialIndex::remove(const Id id)
+{
+	const auto it = itemIndices_.find(id);
+
+	if (it == itemIndices_.end())
+	{
+		return;
+	}
+
+	const uint32 itemIndex = it->second;
+	itemIndices_.erase(it);
+
+	removeFromNode(itemIndex);
+
+	// Keep the items dense by moving the last item into the hole
+	const uint32 lastIndex = static_cast<uint32>(items_.size() - 1);
+
+	if (itemIndex != lastIndex)
+	{
+		items_[itemIndex] = items_[lastIndex];
+
+		const auto& moved = items_[itemIndex];
+		itemIndices_[moved.id] = itemIndex;
+		nodes_[moved.node].items[moved.slot] = itemIndex;
+	}
+
+	items_.pop_back();
+}
+
+bool SpatialIndex::contains(const Id id) const
+{
+	return itemIndices_.find(id) != itemIndices_.end();
+}
+
+void SpatialIndex::clear()
+{
+	nodes_.resize(1);
+	nodes_[0].children = NO_CHILDREN;
+	nodes_[0].items.clear();
+
+	items_.clear();
+	itemIndices_.clear();
+}
+
+size_t SpatialIndex::size() const
+{
+	return items_.size();
+}
+
+void SpatialIndex::queryRadius(const glm::vec3& center, const float32 radius, std::vector<Id>& results) const
+{
+	const float32 radiusSquared = radius * radius;
+
+	query(
+		[&](const glm::vec3& nodeCenter, const float32 halfSize) { return distanceSquared(center, nodeCenter, halfSize) <= radiusSquared; },
+		[&](const glm::vec3& position) { return distanceSquared(center, position) <= radiusSquared; },
+		results
+	);
+}
+
+void SpatialIndex::queryBox(const glm::vec3& minimum, const glm::vec3& maximum, std::vector<Id>& results) const
+{
+	query(
+		[&](const glm::vec3& nodeCenter, const float32 halfSize) {
+			for (int i = 0; i < 3; ++i)
+			{
+				if (nodeCenter[i] + halfSize < minimum[i] || nodeCenter[i] - halfSize > maximum[i]) return false;
+			}
+
+			return true;
+		},
+		[&](const glm::vec3& position) {
+			for (int i = 0; i < 3; ++i)
+			{
+				if (position[i] < minimum[i] || position[i] > maximum[i]) return false;
+			}
+
+			return true;
+		},
+		results
+	);
+}
+
+void SpatialIndex::queryFrustum(const std::array<glm::vec4, 6>& planes, std::vector<Id>& results) const
+{
+	query(
+		[&](const glm::vec3& nodeCenter, const float32 halfSize) {
+			// The box is outside if even its corner furthest along the plane normal is behind the plane
+			for (const auto& plane : planes)
+			{
+				const float32 extent = halfSize * (std::abs(plane.x) + std::abs(plane.y) + std::abs(plane.z));
+
+				if (planeDistance(plane, nodeCenter) + extent < 0.0f) return false;
+			}
+
+			return true;
+		},
+		[&](const glm::vec3& position) {
+			for (const auto& plane : planes)
+			{
+				if (planeDistance(plane, position) < 0.0f) return false;
+			}
+
+			return true;
+		},
+		results
+	);
+}
+
+void SpatialIndex::queryNearest(const glm::vec3& point, const uint32 k, std::vector<Id>& results, const float32 maxDistance) const
+{
+	if (k == 0)
+	{
+		return;
+	}
+
+	const float32 maxDistanceSquared = maxDistance * maxDistance;
+
+	typedef std::pair<float32, uint32> Entry;
+
+	// Visit nodes nearest first, keeping the k nearest items found so far in a max heap
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> nodeQueue;
+	std::priority_queue<Entry> nearest;
+
+	nodeQueue.push(Entry(0.0f, 0));
+
+	while (!nodeQueue.empty())
+	{
+		const auto entry = nodeQueue.top();
+
+		const float32 bound = (nearest.size() == k ? nearest.top().first : maxDistanceSquared);
+		if (entry.first > bound)
+		{
+			break;
+		}
+
+		nodeQueue.pop();
+
+		const Node& node = nodes_[entry.second];
+
+		for (const auto itemIndex : node.items)
+		{
+			const float32 d = distanceSquared(point, items_[itemIndex].position);
+
+			if (d > maxDistanceSquared)
+			{
+				continue;
+			}
+
+			if (nearest.size() < k)
+			{
+				nearest.push(Entry(d, itemIndex));
+			}
+			else if (d < nearest.top().first)
+			{
+				nearest.pop();
+				nearest.push(Entry(d, itemIndex));
+			}
+		}
+
+		if (node.children != NO_CHILDREN)
+		{
+			for (uint32 i = 0; i < 8; ++i)
+			{
+				const Node& child = nodes_[node.children + i];
+
+				if (child.items.empty() && child.children == NO_CHILDREN)
+				{
+					continue;
+				}
+
+				nodeQueue.push(Entry(distanceSquared(point, child.center, child.halfSize * 2.0f), node.children + i));
+			}
+		}
+	}
+
+	const size_t first = results.size();
+	results.resize(first + nearest.size());
+
+	for (size_t i = results.size(); i > first; --i)
+	{
+		results[i - 1] = items_[nearest.top().second].id;
+		nearest.pop();
+	}
+}
+
+std::array<glm::vec4, 6> SpatialIndex::frustumPlanes(const glm::mat4& viewProjection)
+{
+	const auto row = [&](const int r) {
+		return glm::vec4(viewProjection[0][r], viewProjection[1][r], viewProjection[2][r], viewProjection[3][r]);
+	};
+
+	std::array<glm::vec4, 6> planes = {{
+		row(3) + row(0),
+		row(3) - row(0),
+		row(3) + row(1),
+		row(3) - row(1),
+		row(3) + row(2),
+		row(3) - row(2)
+	}};
+
+	for (auto& plane : planes)
+	{
+		const float32 length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+
+		if (length > 0.0f)
+		{
+			plane /= length;
+		}
+	}
+
+	return planes;
+}
+
+void SpatialIndex::insert(const uint32 itemIndex)
+{
+	const glm::vec3 position = items_[itemIndex].position;
+
+	if (!insideBounds(nodes_[0], position))
+	{
+		addToNode(0, itemIndex);
+		return;
+	}
+
+	uint32 nodeIndex = 0;
+	while (nodes_[nodeIndex].children != NO_CHILDREN)
+	{
+		nodeIndex = nodes_[nodeIndex].children + childFor(nodes_[nodeIndex], position);
+	}
+
+	addToNode(nodeIndex, itemIndex);
+
+	if (nodes_[nodeIndex].items.size() > maxItemsPerNode_ && nodes_[nodeIndex].depth < maxDepth_)
+	{
+		split(nodeIndex);
+	}
+}
+
+void SpatialIndex::addToNode(const uint32 nodeIndex, const uint32 itemIndex)
+{
+	auto& item = items_[itemIndex];
+	auto& items = nodes_[nodeIndex].items;
+
+	item.node = nodeIndex;
+	item.slot = static_cast<uint32>(items.size());
+
+	items.push_back(itemIndex);
+}
+
+void SpatialIndex::removeFromNode(const uint32 itemIndex)
+{
+	const auto& item = items_[itemIndex];
+	auto& items = nodes_[item.node].items;
+
+	const uint32 last = items.back();
+	items[item.slot] = last;
+	items_[last].slot = item.slot;
+
+	items.pop_back();
+}
+
+void SpatialIndex::split(const uint32 nodeIndex)
+{
+	const glm::vec3 center = nodes_[nodeIndex].center;
+	const float32 halfSize = nodes_[nodeIndex].halfSize * 0.5f;
+	const uint32 depth = nodes_[nodeIndex].depth + 1;
+
+	const uint32 first = static_cast<uint32>(nodes_.size());
+
+	for (uint32 i = 0; i < 8; ++i)
+	{
+		Node child;
+		child.center = center + glm::vec3(
+			(i & 1) ? halfSize : -halfSize,
+			(i & 2) ? halfSize : -halfSize,
+			(i & 4) ? halfSize : -halfSize
+		);
+		child.halfSize = halfSize;
+		child.depth = depth;
+
+		nodes_.push_back(child);
+	}
+
+	nodes_[nodeIndex].children = first;
+
+	std::vector<uint32> items;
+	items.swap(nodes_[nodeIndex].items);
+
+	// Items that only stayed here because of the loose bounds may not fit in any child, so they're inserted again
+	std::vector<uint32> displaced;
+
+	for (const auto itemIndex : items)
+	{
+		const auto& position = items_[itemIndex].position;
+
+		if (insideBounds(nodes_[nodeIndex], position))
+		{
+			addToNode(first + childFor(nodes_[nodeIndex], position), itemIndex);
+		}
+		else if (nodeIndex == 0)
+		{
+			addToNode(0, itemIndex);
+		}
+		else
+		{
+			displaced.push_back(itemIndex);
+		}
+	}
+
+	for (uint32 i = 0; i < 8; ++i)
+	{
+		if (nodes_[first + i].items.size() > maxItemsPerNode_ && depth < maxDepth_)
+		{
+			split(first + i);
+		}
+	}
+
+	for (const auto itemIndex : displaced)
+	{
+		insert(itemIndex);
+	}
+}
+
+uint32 SpatialIndex::childFor(const Node& node, const glm::vec3& position) const
+{
+	return (position.x >= node.center.x ? 1 : 0) | (position.y >= node.center.y ? 2 : 0) | (position.z >= node.center.z ? 4 : 0);
+}
+
+bool SpatialIndex::insideLooseBounds(const Node& node, const glm::vec3& position) const
+{
+	const float32 looseHalfSize = node.halfSize * 2.0f;
+
+	return std::abs(position.x - node.center.x) <= looseHalfSize
+		&& std::abs(position.y - node.center.y) <= looseHalfSize
+		&& std::abs(position.z - node.center.z) <= looseHalfSize;
+}
+
+bool SpatialIndex::insideBounds(const Node& node, const glm::vec3& position) const
+{
+	return std::abs(position.x - node.center.x) <= node.halfSize
+		&& std::abs(position.y - node.center.y) <= node.halfSize
+		&& std::abs(position.z - node.center.z) <= node.halfSize;
+}
+
+template <typename NodeTest, typename ItemTest>
+void SpatialIndex::query(NodeTest&& nodeTest, ItemTest&& itemTest, std::vector<Id>& results) const
+{
+	// The root is always visited, since it also holds the items outside of its bounds
+	std::vector<uint32> stack;
+	stack.push_back(0);
+
+	while (!stack.empty())
+	{
+		const Node& node = nodes_[stack.back()];
+		stack.pop_back();
+
+		for (const auto itemIndex : node.items)
+		{
+			if (itemTest(items_[itemIndex].position))
+			{
+				results.push_back(items_[itemIndex].id);
+			}
+		}
+
+		if (node.children == NO_CHILDREN)
+		{
+			continue;
+		}
+
+		for (uint32 i = 0; i < 8; ++i)
+		{
+			const Node& child = nodes_[node.children + i];
+
+			if ((!child.items.empty() || child.children != NO_CHILDREN) && nodeTest(child.center, child.halfSize * 2.0f))
+			{
+				stack.push_back(node.children + i);
+			}
+		}
+	}
+}
+
+}
@@ -0,0 +1,487 @@
+#include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+#include "StreamingTerrain.hpp"
+
+#include "Scene.hpp"
+
+#include "ecs/PositionComponent.hpp"
+#include "ecs/RigidBodyObjectComponent.hpp"
+#include "ecs/GraphicsTerrainComponent.hpp"
+#include "ecs/PathfindingCrowdComponent.hpp"
+
+#include "exceptions/RuntimeException.hpp"
+
+#include "detail/Format.hpp"
+
+namespace ice_engine
+{
+
+namespace
+{
+
+/**
+ * The navigation geometry of several tiles as one.
+ */
+class CombinedGeometry : public pathfinding::ITerrain
+{
+public:
+	void add(const pathfinding::ITerrain& geometry)
+	{
+		const auto offset = static_cast<uint32>(vertices_.size());
+
+		vertices_.insert(vertices_.end(), geometry.vertices().begin(), geometry.vertices().end());
+
+		for (const auto index : geometry.indices()) indices_.push_back(index + offset);
+	}
+
+	const std::vector<glm::vec3>& vertices() const override
+	{
+		return vertices_;
+	}
+
+	const std::vector<uint32>& indices() const override
+	{
+		return indices_;
+	}
+
+private:
+	std::vector<glm::vec3> vertices_;
+	std::vector<uint32> indices_;
+};
+
+}
+
+StreamingTerrain::StreamingTerrain(
+	const TerrainStreamingSettings& settings,
+	std::unique_ptr<ITerrainTileSource> tileSource,
+	const SplatMap& splatMap,
+	const DisplacementMap& displacementMap,
+	Scene* scene,
+	IThreadPool* threadPool,
+	logger::ILogger* logger,
+	graphics::IGraphicsEngine* graphicsEngine,
+	pathfinding::IPathfindingEngine* pathfindingEngine,
+	physics::IPhysicsEngine* physicsEngine,
+	graphics::RenderSceneHandle renderSceneHandle
+)
+	:
+	settings_(settings),
+	tileSource_(std::move(tileSource)),
+	splatMap_(splatMap),
+	displacementMap_(displacementMap),
+	scene_(scene),
+	threadPool_(threadPool),
+	logger_(logger),
+	graphicsEngine_(graphicsEngine),
+	pathfindingEngine_(pathfindingEngine),
+	physicsEngine_(physicsEngine),
+	renderSceneHandle_(renderSceneHandle),
+	focus_(0.0f)
+{
+	if (settings_.tileSize == 0)
+	{
+		throw RuntimeException("Streaming terrain tile size must be greater than 0.");
+	}
+
+	settings_.unloadDistance = std::max(settings_.unloadDistance, settings_.loadDistance);
+
+	if (settings_.navigation && settings_.tiledNavigation)
+	{
+		try
+		{
+			tiledNavigationMesh_ = std::make_unique<TiledNavigationMesh>(pathfindingEngine_, threadPool_, glm::vec3(0.0f), pathfinding::PolygonMeshConfig());
+			tiledCrowdHandle_ = scene_->createCrowd(tiledNavigationMesh_->navigationMeshHandle(), pathfinding::CrowdConfig());
+			crowdHandles_.push_back(tiledCrowdHandle_);
+		}
+		catch (const RuntimeException& e)
+		{
+			LOG_WARN(logger_, "Unable to create a tiled navigation mesh, using a navigation mesh per terrain tile: %s", e.what());
+
+			tiledNavigationMesh_.reset();
+		}
+	}
+}
+
+StreamingTerrain::~StreamingTerrain()
+{
+	// The background work uses the tile source, so let it finish first
+	for (auto& kv : tiles_)
+	{
+		auto& tile = kv.second;
+
+		if (tile.state == Tile::State::PENDING) tile.future.wait();
+	}
+
+	for (auto& kv : tiles_)
+	{
+		if (kv.second.state == Tile::State::LOADED) destroyTileResources(kv.second);
+	}
+
+	if (tiledCrowdHandle_) scene_->destroy(tiledCrowdHandle_);
+}
+
+void StreamingTerrain::tick(const float32 delta)
+{
+	if (cameraHandle_) focus_ = graphicsEngine_->position(cameraHandle_);
+
+	finishTiles();
+	unloadTiles();
+	requestTiles();
+
+	if (tiledNavigationMesh_)
+	{
+		// Tiles that fail to build stay marked, and are tried again next tick
+		try
+		{
+			tiledNavigationMesh_->update();
+		}
+		catch (const std::exception& e)
+		{
+			LOG_ERROR(logger_, "Unable to build navigation mesh tiles: %s", e.what());
+		}
+	}
+}
+
+const std::vector<pathfinding::CrowdHandle>& StreamingTerrain::crowds() const
+{
+	return crowdHandles_;
+}
+
+void StreamingTerrain::setCamera(const graphics::CameraHandle& cameraHandle)
+{
+	cameraHandle_ = cameraHandle;
+}
+
+void StreamingTerrain::setFocus(const glm::vec3& focus)
+{
+	focus_ = focus;
+}
+
+const glm::vec3& StreamingTerrain::focus() const
+{
+	return focus_;
+}
+
+uint32 StreamingTerrain::numberOfLoadedTiles() const
+{
+	return static_cast<uint32>(std::count_if(tiles_.begin(), tiles_.end(), [](const auto& kv) { return kv.second.state == Tile::State::LOADED; }));
+}
+
+uint32 StreamingTerrain::numberOfPendingTiles() const
+{
+	return numberOfPendingTiles_;
+}
+
+void StreamingTerrain::finishTiles()
+{
+	uint32 finished = 0;
+
+	for (auto it = tiles_.begin(); it != tiles_.end() && finished < settings_.maxTilesPerTick;)
+	{
+		auto& tile = it->second;
+
+		if (tile.state != Tile::State::PENDING || tile.future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		{
+			++it;
+			continue;
+		}
+
+		--numberOfPendingTiles_;
+
+		try
+		{
+			tile.future.get();
+		}
+		catch (const std::exception& e)
+		{
+			LOG_ERROR(logger_, "Unable to generate terrain tile (%s, %s): %s", it->first.first, it->first.second, e.what());
+
+			// Not retried until the tile has been out of range
+			tile.state = Tile::State::FAILED;
+			tile.data.reset();
+			++it;
+			continue;
+		}
+
+		// The focus moved away while the tile was being generated
+		if (distanceToTile(it->first) > settings_.unloadDistance)
+		{
+			it = tiles_.erase(it);
+			continue;
+		}
+
+		try
+		{
+			createTileResources(it->first, tile);
+			tile.state = Tile::State::LOADED;
+		}
+		catch (const std::exception& e)
+		{
+			LOG_ERROR(logger_, "Unable to create terrain tile (%s, %s): %s", it->first.first, it->first.second, e.what());
+
+			destroyTileResources(tile);
+			tile.state = Tile::State::FAILED;
+		}
+
+		tile.data.reset();
+
+		++finished;
+		++it;
+	}
+}
+
+void StreamingTerrain::unloadTiles()
+{
+	bool crowdsChanged = false;
+
+	// Area of the tiled navigation mesh that lost geometry
+	glm::vec3 navigationMinimum(std::numeric_limits<float32>::max());
+	glm::vec3 navigationMaximum(std::numeric_limits<float32>::lowest());
+
+	for (auto it = tiles_.begin(); it != tiles_.end();)
+	{
+		auto& tile = it->second;
+
+		// Pending tiles are dropped once they are finished
+		if (tile.state == Tile::State::PENDING || distanceToTile(it->first) <= settings_.unloadDistance)
+		{
+			++it;
+			continue;
+		}
+
+		if (tile.state == Tile::State::LOADED)
+		{
+			LOG_DEBUG(logger_, "Unloading terrain tile (%s, %s)", it->first.first, it->first.second);
+
+			crowdsChanged = crowdsChanged || static_cast<bool>(tile.navigationMeshHandle);
+
+			if (!tile.pathfindingTerrain.indices().empty())
+			{
+				const auto origin = tileOrigin(it->first);
+				const float32 tileSize = static_cast<float32>(settings_.tileSize);
+
+				navigationMinimum = glm::min(navigationMinimum, origin);
+				navigationMaximum = glm::max(navigationMaximum, origin + glm::vec3(tileSize, 0.0f, tileSize));
+			}
+
+			destroyTileResources(tile);
+		}
+
+		it = tiles_.erase(it);
+	}
+
+	if (navigationMinimum.x <= navigationMaximum.x) updateNavigationGeometry(navigationMinimum, navigationMaximum);
+
+	if (crowdsChanged)
+	{
+		crowdHandles_.clear();
+
+		if (tiledCrowdHandle_) crowdHandles_.push_back(tiledCrowdHandle_);
+
+		for (auto& kv : tiles_)
+		{
+			if (kv.second.state != Tile::State::LOADED || !kv.second.entity.hasComponent<ecs::PathfindingCrowdComponent>()) continue;
+
+			crowdHandles_.push_back(kv.second.entity.component<ecs::PathfindingCrowdComponent>()->crowdHandle);
+		}
+	}
+}
+
+void StreamingTerrain::requestTiles()
+{
+	if (numberOfPendingTiles_ >= settings_.maxPendingTiles) return;
+
+	const float32 tileSize = static_cast<float32>(settings_.tileSize);
+	const int32 focusX = static_cast<int32>(std::floor(focus_.x / tileSize));
+	const int32 focusZ = static_cast<int32>(std::floor(focus_.z / tileSize));
+	const int32 range = static_cast<int32>(std::ceil(settings_.loadDistance / tileSize));
+
+	std::vector<std::pair<float32, TileCoordinate>> candidates;
+
+	for (int32 z = focusZ - range; z <= focusZ + range; ++z)
+	{
+		for (int32 x = focusX - range; x <= focusX + range; ++x)
+		{
+			const TileCoordinate coordinate(x, z);
+			const float32 distance = distanceToTile(coordinate);
+
+			if (distance > settings_.loadDistance || tiles_.find(coordinate) != tiles_.end()) continue;
+			if (!tileSource_->contains(x, z, settings_.tileSize)) continue;
+
+			candidates.push_back({distance, coordinate});
+		}
+	}
+
+	const size_t count = std::min<size_t>(candidates.size(), settings_.maxPendingTiles - numberOfPendingTiles_);
+
+	std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end());
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		const auto coordinate = candidates[i].second;
+
+		LOG_DEBUG(logger_, "Generating terrain tile (%s, %s)", coordinate.first, coordinate.second);
+
+		auto& tile = tiles_[coordinate];
+
+		const ITerrainTileSource* tileSource = tileSource_.get();
+		const glm::vec3 origin = tileOrigin(coordinate);
+		const uint32 size = settings_.tileSize;
+		const bool navigation = settings_.navigation;
+		const float32 navigationMaximumError = settings_.navigationMaximumError;
+		const bool precisePhysicsHeights = settings_.precisePhysicsHeights;
+
+		// Only read on this thread once the future is ready
+		tile.data = std::make_shared<TileData>();
+
+		auto data = tile.data;
+		tile.future = threadPool_->postWork([data, tileSource, coordinate, origin, size, navigation, navigationMaximumError, precisePhysicsHeights]() {
+			generateTile(*data, *tileSource, coordinate, origin, size, navigation, navigationMaximumError, precisePhysicsHeights);
+		});
+
+		tile.state = Tile::State::PENDING;
+
+		++numberOfPendingTiles_;
+	}
+}
+
+void StreamingTerrain::generateTile(
+	TileData& tileData,
+	const ITerrainTileSource& tileSource,
+	const TileCoordinate& coordinate,
+	const glm::vec3& origin,
+	const uint32 tileSize,
+	const bool navigation,
+	const float32 navigationMaximumError,
+	const bool precisePhysicsHeights
+)
+{
+	const uint32 samples = tileSize + 1;
+
+	const auto heights = tileSource.heights(coordinate.first, coordinate.second, tileSize);
+
+	if (heights.width() != samples || heights.length() != samples)
+	{
+		throw RuntimeException(detail::format("Tile source returned %sx%s height samples - expected %sx%s.", heights.width(), heights.length(), samples, samples));
+	}
+
+	// The graphics engine takes 8 bit rgb height maps - navigation keeps the full precision heights, and so does physics if
+	// the physics engine supports them
+	std::vector<byte> data(samples * samples * 3);
+
+	for (uint32 j = 0; j < samples; ++j)
+	{
+		for (uint32 i = 0; i < samples; ++i)
+		{
+			const byte value = static_cast<byte>(std::min(std::max(heights.height(i, j), 0.0f), 1.0f) * 255.0f + 0.5f);
+			const size_t index = (static_cast<size_t>(j) * samples + i) * 3;
+
+			data[index] = value;
+			data[index + 1] = value;
+			data[index + 2] = value;
+		}
+	}
+
+	tileData.heightMap = HeightMap(data, samples, samples);
+	tileData.heightfield = Heightfield(heights, precisePhysicsHeights);
+
+	if (navigation) tileData.pathfindingTerrain = PathfindingTerrain(heights, origin, navigationMaximumError);
+}
+
+void StreamingTerrain::createTileResources(const TileCoordinate& coordinate, Tile& tile)
+{
+	LOG_DEBUG(logger_, "Creating terrain tile (%s, %s)", coordinate.first, coordinate.second);
+
+	const auto& data = *tile.data;
+
+	const float32 halfSize = static_cast<float32>(settings_.tileSize) * 0.5f;
+	const glm::vec3 center = tileOrigin(coordinate) + glm::vec3(halfSize, 0.0f, halfSize);
+
+	tile.terrainHandle = graphicsEngine_->createStaticTerrain(data.heightMap, splatMap_, displacementMap_);
+	tile.collisionShapeHandle = physicsEngine_->createStaticTerrainShape(data.heightfield);
+
+	if (settings_.navigation && !tiledNavigationMesh_)
+	{
+		tile.polygonMeshHandle = pathfindingEngine_->createPolygonMesh(&data.pathfindingTerrain);
+		tile.navigationMeshHandle = pathfindingEngine_->createNavigationMesh(tile.polygonMeshHandle);
+	}
+
+	// Same vertical offset as the monolithic terrain - heights span [-7.5, 7.5]
+	tile.entity = scene_->createEntity();
+	tile.entity.assign<ecs::PositionComponent>(center + glm::vec3(0.0f, -7.5f, 0.0f));
+	tile.entity.assign<ecs::RigidBodyObjectComponent>(tile.collisionShapeHandle, 0.0f, 1.0f, 1.0f);
+
+	auto graphicsTerrainComponent = tile.entity.assign<ecs::GraphicsTerrainComponent>(tile.terrainHandle);
+	graphicsEngine_->position(renderSceneHandle_, graphicsTerrainComponent->terrainRenderableHandle, center);
+
+	if (settings_.navigation && !tiledNavigationMesh_)
+	{
+		auto crowdComponent = tile.entity.assign<ecs::PathfindingCrowdComponent>(pathfinding::NavigationMeshHandle(tile.navigationMeshHandle));
+		crowdHandles_.push_back(crowdComponent->crowdHandle);
+	}
+
+	// Last, so a tile that fails to be created never reaches the navigation mesh
+	if (settings_.navigation && tiledNavigationMesh_)
+	{
+		tile.pathfindingTerrain = std::move(tile.data->pathfindingTerrain);
+
+		const float32 tileSize = static_cast<float32>(settings_.tileSize);
+		const glm::vec3 origin = tileOrigin(coordinate);
+
+		updateNavigationGeometry(origin, origin + glm::vec3(tileSize, 0.0f, tileSize));
+	}
+}
+
+void StreamingTerrain::destroyTileResources(Tile& tile)
+{
+	// Destroying the entity destroys its rigid body, renderable and crowd
+	if (tile.entity.valid()) scene_->destroy(tile.entity);
+
+	if (tile.navigationMeshHandle) pathfindingEngine_->destroy(tile.navigationMeshHandle);
+	if (tile.polygonMeshHandle) pathfindingEngine_->destroy(tile.polygonMeshHandle);
+	if (tile.collisionShapeHandle) physicsEngine_->destroy(tile.collisionShapeHandle);
+	if (tile.terrainHandle) graphicsEngine_->destroy(tile.terrainHandle);
+
+	tile.entity = ecs::Entity();
+	tile.navigationMeshHandle = pathfinding::NavigationMeshHandle();
+	tile.polygonMeshHandle = pathfinding::PolygonMeshHandle();
+	tile.collisionShapeHandle = physics::CollisionShapeHandle();
+	tile.terrainHandle = graphics::TerrainHandle();
+	tile.pathfindingTerrain = PathfindingTerrain();
+}
+
+void StreamingTerrain::updateNavigationGeometry(const glm::vec3& minimum, const glm::vec3& maximum)
+{
+	CombinedGeometry geometry;
+
+	for (const auto& kv : tiles_)
+	{
+		if (!kv.second.pathfindingTerrain.indices().empty()) geometry.add(kv.second.pathfindingTerrain);
+	}
+
+	tiledNavigationMesh_->setGeometry(geometry, minimum, maximum);
+}
+
+glm::vec3 StreamingTerrain::tileOrigin(const TileCoordinate& coordinate) const
+{
+	const float32 tileSize = static_cast<float32>(settings_.tileSize);
+
+	return glm::vec3(coordinate.first * tileSize, 0.0f, coordinate.second * tileSize);
+}
+
+float32 StreamingTerrain::distanceToTile(const TileCoordinate& coordinate) const
+{
+	const float32 tileSize = static_cast<float32>(settings_.tileSize);
+	const glm::vec3 origin = tileOrigin(coordinate);
+
+	// Horizontal distance from the focus point to the nearest point of the tile
+	const float32 dx = std::max(std::max(origin.x - focus_.x, focus_.x - (origin.x + tileSize)), 0.0f);
+	const float32 dz = std::max(std::max(origin.z - focus_.z, focus_.z - (origin.z + tileSize)), 0.0f);
+
+	return std::sqrt(dx * dx + dz * dz);
+}
+
+}
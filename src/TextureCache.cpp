@@ -0,0 +1,184 @@
+#include <sstream>
+#include <iomanip>
+
+#include "TextureCache.hpp"
+
+#include "detail/Format.hpp"
+
+#include "exceptions/RuntimeException.hpp"
+
+namespace ice_engine
+{
+namespace
+{
+
+const uint32 MAGIC = 0x43544349; // "ICTC"
+const uint32 VERSION = 1;
+
+void writeUint32(std::ostream& outputStream, const uint32 value)
+{
+	const char bytes[4] = {
+		static_cast<char>(value & 0xFF),
+		static_cast<char>((value >> 8) & 0xFF),
+		static_cast<char>((value >> 16) & 0xFF),
+		static_cast<char>((value >> 24) & 0xFF)
+	};
+
+	outputStream.write(bytes, 4);
+}
+
+uint32 readUint32(std::istream& inputStream)
+{
+	byte bytes[4];
+	inputStream.read(reinterpret_cast<char*>(bytes), 4);
+
+	if (!inputStream)
+	{
+		throw RuntimeException("Unexpected end of compressed texture cache file.");
+	}
+
+	return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<uint32>(bytes[3]) << 24);
+}
+
+uint64 fnv1a(uint64 hash, const byte* data, const size_t size)
+{
+	for (size_t i = 0; i < size; ++i)
+	{
+		hash ^= data[i];
+		hash *= 1099511628211ull;
+	}
+
+	return hash;
+}
+
+}
+
+TextureCache::TextureCache(std::string cacheDirectory, fs::IFileSystem* fileSystem, logger::ILogger* logger, IThreadPool* threadPool)
+	:
+		cacheDirectory_(std::move(cacheDirectory)),
+		fileSystem_(fileSystem),
+		logger_(logger),
+		textureCompressor_(threadPool)
+{
+	if (!fileSystem_->exists(cacheDirectory_))
+	{
+		fileSystem_->makeDirectory(cacheDirectory_);
+	}
+}
+
+CompressedImage TextureCache::get(const graphics::IImage& image, const graphics::ICompressedImage::Format format)
+{
+	const auto cacheFilename = filename(image, format);
+
+	if (fileSystem_->exists(cacheFilename))
+	{
+		LOG_DEBUG(logger_, "Loading compressed texture from cache file '%s'.", cacheFilename);
+
+		try
+		{
+			auto file = fileSystem_->open(cacheFilename, fs::FileFlags::READ | fs::FileFlags::BINARY);
+
+			return load(file->getInputStream());
+		}
+		catch (const RuntimeException& e)
+		{
+			LOG_WARN(logger_, "Compressed texture cache file '%s' is invalid, it will be regenerated: %s", cacheFilename, e.what());
+		}
+	}
+
+	LOG_DEBUG(logger_, "Compressing texture into cache file '%s'.", cacheFilename);
+
+	auto compressedImage = textureCompressor_.compress(image, format);
+
+	auto file = fileSystem_->open(cacheFilename, fs::FileFlags::WRITE | fs::FileFlags::BINARY);
+	save(file->getOutputStream(), compressedImage);
+
+	return compressedImage;
+}
+
+bool TextureCache::exists(const graphics::IImage& image, const graphics::ICompressedImage::Format format) const
+{
+	return fileSystem_->exists(filename(image, format));
+}
+
+uint64 TextureCache::hash(const graphics::IImage& image)
+{
+	const uint32 header[3] = {image.width(), image.height(), static_cast<uint32>(image.format())};
+
+	uint64 result = 14695981039346656037ull;
+	result = fnv1a(result, reinterpret_cast<const byte*>(header), sizeof(header));
+	result = fnv1a(result, image.data().data(), image.data().size());
+
+	return result;
+}
+
+void TextureCache::save(std::ostream& outputStream, const CompressedImage& compressedImage)
+{
+	writeUint32(outputStream, MAGIC);
+	writeUint32(outputStream, VERSION);
+	writeUint32(outputStream, static_cast<uint32>(compressedImage.format()));
+	writeUint32(outputStream, compressedImage.levels());
+
+	for (uint32 i = 0; i < compressedImage.levels(); ++i)
+	{
+		const auto& data = compressedImage.data(i);
+
+		writeUint32(outputStream, compressedImage.width(i));
+		writeUint32(outputStream, compressedImage.height(i));
+		writeUint32(outputStream, static_cast<uint32>(data.size()));
+		outputStream.write(reinterpret_cast<const char*>(data.data()), data.size());
+	}
+}
+
+CompressedImage TextureCache::load(std::istream& inputStream)
+{
+	if (readUint32(inputStream) != MAGIC)
+	{
+		throw RuntimeException("Not a compressed texture cache file.");
+	}
+
+	const uint32 version = readUint32(inputStream);
+	if (version != VERSION)
+	{
+		throw RuntimeException(detail::format("Unsupported compressed texture cache file version %s.", version));
+	}
+
+	const auto format = static_cast<graphics::ICompressedImage::Format>(readUint32(inputStream));
+	const uint32 numberOfLevels = readUint32(inputStream);
+
+	std::vector<CompressedImage::Level> levels(numberOfLevels);
+
+	for (auto& level : levels)
+	{
+		level.width = readUint32(inputStream);
+		level.height = readUint32(inputStream);
+
+		const uint32 expectedSize = ((level.width + 3) / 4) * ((level.height + 3) / 4) * CompressedImage::blockSize(format);
+		const uint32 size = readUint32(inputStream);
+
+		if (size != expectedSize)
+		{
+			throw RuntimeException(detail::format("Compressed texture level has size %s, expected %s.", size, expectedSize));
+		}
+
+		level.data.resize(size);
+		inputStream.read(reinterpret_cast<char*>(level.data.data()), size);
+
+		if (!inputStream)
+		{
+			throw RuntimeException("Unexpected end of compressed texture cache file.");
+		}
+	}
+
+	return CompressedImage(std::move(levels), format);
+}
+
+std::string TextureCache::filename(const graphics::IImage& image, const graphics::ICompressedImage::Format format) const
+{
+	std::stringstream ss;
+	ss << cacheDirectory_ << fileSystem_->getDirectorySeperator() << std::hex << std::setw(16) << std::setfill('0') << hash(image) << std::dec << "_" << format << ".ictc";
+
+	return ss.str();
+}
+
+}
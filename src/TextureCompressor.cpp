@@ -0,0 +1,834 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+#include "TextureCompressor.hpp"
+
+#include "exceptions/InvalidArgumentException.hpp"
+#include "exceptions/RuntimeException.hpp"
+
+namespace ice_engine
+{
+namespace
+{
+
+typedef std::array<byte, 64> RgbaBlock;
+
+// BC7 4 bit index interpolation weights
+const std::array<uint32, 16> BC7_WEIGHTS = {{0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64}};
+
+/**
+ * Writes/reads bits into a 128 bit block, least significant bit first (which is the order BC7 uses).
+ */
+class BitStream
+{
+public:
+	BitStream(byte* data) : data_(data)
+	{
+	}
+
+	void write(uint32 value, const uint32 numberOfBits)
+	{
+		for (uint32 i = 0; i < numberOfBits; ++i, ++position_)
+		{
+			if ((value >> i) & 1)
+			{
+				data_[position_ / 8] |= static_cast<byte>(1 << (position_ % 8));
+			}
+		}
+	}
+
+	uint32 read(const uint32 numberOfBits)
+	{
+		uint32 value = 0;
+
+		for (uint32 i = 0; i < numberOfBits; ++i, ++position_)
+		{
+			value |= ((data_[position_ / 8] >> (position_ % 8)) & 1) << i;
+		}
+
+		return value;
+	}
+
+private:
+	byte* data_;
+	uint32 position_ = 0;
+};
+
+RgbaBlock extractBlock(const Image& image, const uint32 blockX, const uint32 blockY)
+{
+	RgbaBlock block;
+
+	const auto& data = image.data();
+
+	for (uint32 y = 0; y < 4; ++y)
+	{
+		// Clamp so that partial blocks on the right/bottom edge repeat the last row/column
+		const uint32 sourceY = std::min(blockY * 4 + y, image.height() - 1);
+
+		for (uint32 x = 0; x < 4; ++x)
+		{
+			const uint32 sourceX = std::min(blockX * 4 + x, image.width() - 1);
+			const uint32 source = (sourceY * image.width() + sourceX) * 4;
+			const uint32 destination = (y * 4 + x) * 4;
+
+			block[destination + 0] = data[source + 0];
+			block[destination + 1] = data[source + 1];
+			block[destination + 2] = data[source + 2];
+			block[destination + 3] = data[source + 3];
+		}
+	}
+
+	return block;
+}
+
+uint32 squaredDistance(const byte* a, const byte* b, const uint32 channels)
+{
+	uint32 result = 0;
+
+	for (uint32 i = 0; i < channels; ++i)
+	{
+		const int32 d = static_cast<int32>(a[i]) - static_cast<int32>(b[i]);
+		result += static_cast<uint32>(d * d);
+	}
+
+	return result;
+}
+
+/**
+ * Find the two pixels in the block that lie furthest apart along the principal axis of the block.
+ *
+ * The principal axis is found with a few iterations of the power method on the covariance matrix.
+ */
+void findEndpoints(const RgbaBlock& block, const uint32 channels, uint32& minimumIndex, uint32& maximumIndex)
+{
+	float32 mean[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+	for (uint32 i = 0; i < 16; ++i)
+	{
+		for (uint32 c = 0; c < channels; ++c)
+		{
+			mean[c] += block[i * 4 + c];
+		}
+	}
+
+	for (uint32 c = 0; c < channels; ++c)
+	{
+		mean[c] /= 16.0f;
+	}
+
+	float32 covariance[4][4] = {};
+
+	for (uint32 i = 0; i < 16; ++i)
+	{
+		for (uint32 a = 0; a < channels; ++a)
+		{
+			for (uint32 b = 0; b < channels; ++b)
+			{
+				covariance[a][b] += (block[i * 4 + a] - mean[a]) * (block[i * 4 + b] - mean[b]);
+			}
+		}
+	}
+
+	float32 axis[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+
+	for (uint32 iteration = 0; iteration < 8; ++iteration)
+	{
+		float32 next[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+		float32 length = 0.0f;
+
+		for (uint32 a = 0; a < channels; ++a)
+		{
+			for (uint32 b = 0; b < channels; ++b)
+			{
+				next[a] += covariance[a][b] * axis[b];
+			}
+
+			length = std::max(length, std::abs(next[a]));
+		}
+
+		// Flat block - any axis will do
+		if (length <= std::numeric_limits<float32>::epsilon())
+		{
+			break;
+		}
+
+		for (uint32 a = 0; a < channels; ++a)
+		{
+			axis[a] = next[a] / length;
+		}
+	}
+
+	float32 minimum = std::numeric_limits<float32>::max();
+	float32 maximum = std::numeric_limits<float32>::lowest();
+	minimumIndex = 0;
+	maximumIndex = 0;
+
+	for (uint32 i = 0; i < 16; ++i)
+	{
+		float32 projection = 0.0f;
+
+		for (uint32 c = 0; c < channels; ++c)
+		{
+			projection += (block[i * 4 + c] - mean[c]) * axis[c];
+		}
+
+		if (projection < minimum)
+		{
+			minimum = projection;
+			minimumIndex = i;
+		}
+		if (projection > maximum)
+		{
+			maximum = projection;
+			maximumIndex = i;
+		}
+	}
+}
+
+uint16 packRgb565(const byte* rgb)
+{
+	const uint32 r = (rgb[0] * 31u + 127u) / 255u;
+	const uint32 g = (rgb[1] * 63u + 127u) / 255u;
+	const uint32 b = (rgb[2] * 31u + 127u) / 255u;
+
+	return static_cast<uint16>((r << 11) | (g << 5) | b);
+}
+
+void unpackRgb565(const uint16 color, byte* rgb)
+{
+	const uint32 r = (color >> 11) & 0x1F;
+	const uint32 g = (color >> 5) & 0x3F;
+	const uint32 b = color & 0x1F;
+
+	rgb[0] = static_cast<byte>((r << 3) | (r >> 2));
+	rgb[1] = static_cast<byte>((g << 2) | (g >> 4));
+	rgb[2] = static_cast<byte>((b << 3) | (b >> 2));
+}
+
+void bc1Palette(const uint16 color0, const uint16 color1, byte palette[4][4])
+{
+	unpackRgb565(color0, palette[0]);
+	unpackRgb565(color1, palette[1]);
+	palette[0][3] = 255;
+	palette[1][3] = 255;
+
+	for (uint32 c = 0; c < 3; ++c)
+	{
+		if (color0 > color1)
+		{
+			palette[2][c] = static_cast<byte>((2 * palette[0][c] + palette[1][c]) / 3);
+			palette[3][c] = static_cast<byte>((palette[0][c] + 2 * palette[1][c]) / 3);
+		}
+		else
+		{
+			palette[2][c] = static_cast<byte>((palette[0][c] + palette[1][c]) / 2);
+			palette[3][c] = 0;
+		}
+	}
+
+	palette[2][3] = 255;
+	palette[3][3] = (color0 > color1 ? 255 : 0);
+}
+
+void encodeBc1Block(const RgbaBlock& block, byte* output)
+{
+	uint32 minimumIndex = 0;
+	uint32 maximumIndex = 0;
+	findEndpoints(block, 3, minimumIndex, maximumIndex);
+
+	uint16 color0 = packRgb565(&block[maximumIndex * 4]);
+	uint16 color1 = packRgb565(&block[minimumIndex * 4]);
+
+	// Always use the 4 color mode, which requires color0 > color1
+	if (color0 < color1)
+	{
+		std::swap(color0, color1);
+	}
+
+	uint32 indices = 0;
+
+	if (color0 != color1)
+	{
+		byte palette[4][4];
+		bc1Palette(color0, color1, palette);
+
+		for (uint32 i = 0; i < 16; ++i)
+		{
+			uint32 bestIndex = 0;
+			uint32 bestDistance = std::numeric_limits<uint32>::max();
+
+			for (uint32 p = 0; p < 4; ++p)
+			{
+				const uint32 distance = squaredDistance(&block[i * 4], palette[p], 3);
+				if (distance < bestDistance)
+				{
+					bestDistance = distance;
+					bestIndex = p;
+				}
+			}
+
+			indices |= bestIndex << (i * 2);
+		}
+	}
+
+	output[0] = static_cast<byte>(color0 & 0xFF);
+	output[1] = static_cast<byte>(color0 >> 8);
+	output[2] = static_cast<byte>(color1 & 0xFF);
+	output[3] = static_cast<byte>(color1 >> 8);
+	output[4] = static_cast<byte>(indices & 0xFF);
+	output[5] = static_cast<byte>((indices >> 8) & 0xFF);
+	output[6] = static_cast<byte>((indices >> 16) & 0xFF);
+	output[7] = static_cast<byte>((indices >> 24) & 0xFF);
+}
+
+void decodeBc1Block(const byte* input, RgbaBlock& block)
+{
+	const uint16 color0 = static_cast<uint16>(input[0] | (input[1] << 8));
+	const uint16 color1 = static_cast<uint16>(input[2] | (input[3] << 8));
+	const uint32 indices = input[4] | (input[5] << 8) | (input[6] << 16) | (static_cast<uint32>(input[7]) << 24);
+
+	byte palette[4][4];
+	bc1Palette(color0, color1, palette);
+
+	for (uint32 i = 0; i < 16; ++i)
+	{
+		const uint32 index = (indices >> (i * 2)) & 0x3;
+		std::copy(palette[index], palette[index] + 4, &block[i * 4]);
+	}
+}
+
+void bc4Palette(const byte value0, const byte value1, byte palette[8])
+{
+	palette[0] = value0;
+	palette[1] = value1;
+
+	if (value0 > value1)
+	{
+		for (uint32 i = 1; i < 7; ++i)
+		{
+			palette[i + 1] = static_cast<byte>(((7 - i) * value0 + i * value1) / 7);
+		}
+	}
+	else
+	{
+		for (uint32 i = 1; i < 5; ++i)
+		{
+			palette[i + 1] = static_cast<byte>(((5 - i) * value0 + i * value1) / 5);
+		}
+
+		palette[6] = 0;
+		palette[7] = 255;
+	}
+}
+
+/**
+ * Encode a single channel of the block (BC4 style) - used for BC3 alpha and both BC5 channels.
+ */
+void encodeBc4Block(const RgbaBlock& block, const uint32 channel, byte* output)
+{
+	byte maximum = 0;
+	byte minimum = 255;
+
+	for (uint32 i = 0; i < 16; ++i)
+	{
+		maximum = std::max(maximum, block[i * 4 + channel]);
+		minimum = std::min(minimum, block[i * 4 + channel]);
+	}
+
+	uint64 indices = 0;
+
+	if (maximum != minimum)
+	{
+		byte palette[8];
+		bc4Palette(maximum, minimum, palette);
+
+		for (uint32 i = 0; i < 16; ++i)
+		{
+			const byte value = block[i * 4 + channel];
+
+			uint32 bestIndex = 0;
+			uint32 bestDistance = std::numeric_limits<uint32>::max();
+
+			for (uint32 p = 0; p < 8; ++p)
+			{
+				const uint32 distance = static_cast<uint32>(std::abs(static_cast<int32>(value) - static_cast<int32>(palette[p])));
+				if (distance < bestDistance)
+				{
+					bestDistance = distance;
+					bestIndex = p;
+				}
+			}
+
+			indices |= static_cast<uint64>(bestIndex) << (i * 3);
+		}
+	}
+
+	output[0] = maximum;
+	output[1] = minimum;
+
+	for (uint32 i = 0; i < 6; ++i)
+	{
+		output[2 + i] = static_cast<byte>((indices >> (i * 8)) & 0xFF);
+	}
+}
+
+void decodeBc4Block(const byte* input, const uint32 channel, RgbaBlock& block)
+{
+	byte palette[8];
+	bc4Palette(input[0], input[1], palette);
+
+	uint64 indices = 0;
+	for (uint32 i = 0; i < 6; ++i)
+	{
+		indices |= static_cast<uint64>(input[2 + i]) << (i * 8);
+	}
+
+	for (uint32 i = 0; i < 16; ++i)
+	{
+		block[i * 4 + channel] = palette[(indices >> (i * 3)) & 0x7];
+	}
+}
+
+void encodeBc3Block(const RgbaBlock& block, byte* output)
+{
+	encodeBc4Block(block, 3, output);
+	encodeBc1Block(block, output + 8);
+}
+
+void decodeBc3Block(const byte* input, RgbaBlock& block)
+{
+	decodeBc1Block(input + 8, block);
+	decodeBc4Block(input, 3, block);
+}
+
+void encodeBc5Block(const RgbaBlock& block, byte* output)
+{
+	encodeBc4Block(block, 0, output);
+	encodeBc4Block(block, 1, output + 8);
+}
+
+void decodeBc5Block(const byte* input, RgbaBlock& block)
+{
+	for (uint32 i = 0; i < 16; ++i)
+	{
+		block[i * 4 + 2] = 0;
+		block[i * 4 + 3] = 255;
+	}
+
+	decodeBc4Block(input, 0, block);
+	decodeBc4Block(input + 8, 1, block);
+}
+
+/**
+ * Quantize an 8 bit RGBA endpoint to 7 bits per channel plus a shared p-bit (BC7 mode 6).
+ */
+void quantizeBc7Endpoint(const byte* rgba, byte* quantized, uint32& pBit)
+{
+	uint32 bestError = std::numeric_limits<uint32>::max();
+
+	for (uint32 p = 0; p < 2; ++p)
+	{
+		byte candidate[4];
+		uint32 error = 0;
+
+		for (uint32 c = 0; c < 4; ++c)
+		{
+			const int32 value = std::min(127, std::max(0, (static_cast<int32>(rgba[c]) - static_cast<int32>(p) + 1) / 2));
+			candidate[c] = static_cast<byte>(value);
+
+			const int32 d = static_cast<int32>(rgba[c]) - ((value << 1) | static_cast<int32>(p));
+			error += static_cast<uint32>(d * d);
+		}
+
+		if (error < bestError)
+		{
+			bestError = error;
+			pBit = p;
+			std::copy(candidate, candidate + 4, quantized);
+		}
+	}
+}
+
+void bc7Palette(const byte endpoint0[4], const byte endpoint1[4], byte palette[16][4])
+{
+	for (uint32 i = 0; i < 16; ++i)
+	{
+		for (uint32 c = 0; c < 4; ++c)
+		{
+			palette[i][c] = static_cast<byte>(((64 - BC7_WEIGHTS[i]) * endpoint0[c] + BC7_WEIGHTS[i] * endpoint1[c] + 32) >> 6);
+		}
+	}
+}
+
+/**
+ * BC7 mode 6 only - a single subset with 7777.1 RGBA endpoints and 4 bit indices.  It is the simplest of
+ * the BC7 modes and gives good quality for smooth colour/alpha content like terrain materials.
+ */
+void encodeBc7Block(const RgbaBlock& block, byte* output)
+{
+	uint32 minimumIndex = 0;
+	uint32 maximumIndex = 0;
+	findEndpoints(block, 4, minimumIndex, maximumIndex);
+
+	byte quantized[2][4];
+	uint32 pBits[2] = {0, 0};
+	quantizeBc7Endpoint(&block[minimumIndex * 4], quantized[0], pBits[0]);
+	quantizeBc7Endpoint(&block[maximumIndex * 4], quantized[1], pBits[1]);
+
+	byte endpoints[2][4];
+	for (uint32 e = 0; e < 2; ++e)
+	{
+		for (uint32 c = 0; c < 4; ++c)
+		{
+			endpoints[e][c] = static_cast<byte>((quantized[e][c] << 1) | pBits[e]);
+		}
+	}
+
+	byte palette[16][4];
+	bc7Palette(endpoints[0], endpoints[1], palette);
+
+	uint32 indices[16];
+	for (uint32 i = 0; i < 16; ++i)
+	{
+		uint32 bestDistance = std::numeric_limits<uint32>::max();
+		indices[i] = 0;
+
+		for (uint32 p = 0; p < 16; ++p)
+		{
+			const uint32 distance = squaredDistance(&block[i * 4], palette[p], 4);
+			if (distance < bestDistance)
+			{
+				bestDistance = distance;
+				indices[i] = p;
+			}
+		}
+	}
+
+	// The most significant bit of the first (anchor) index is implicit and must be 0
+	if (indices[0] & 0x8)
+	{
+		std::swap(quantized[0], quantized[1]);
+		std::swap(pBits[0], pBits[1]);
+
+		for (uint32 i = 0; i < 16; ++i)
+		{
+			indices[i] = 15 - indices[i];
+		}
+	}
+
+	std::fill(output, output + 16, 0);
+	BitStream bitStream(output);
+
+	bitStream.write(1 << 6, 7);
+
+	for (uint32 c = 0; c < 4; ++c)
+	{
+		bitStream.write(quantized[0][c], 7);
+		bitStream.write(quantized[1][c], 7);
+	}
+
+	bitStream.write(pBits[0], 1);
+	bitStream.write(pBits[1], 1);
+
+	bitStream.write(indices[0], 3);
+	for (uint32 i = 1; i < 16; ++i)
+	{
+		bitStream.write(indices[i], 4);
+	}
+}
+
+void decodeBc7Block(const byte* input, RgbaBlock& block)
+{
+	byte data[16];
+	std::copy(input, input + 16, data);
+
+	BitStream bitStream(data);
+
+	if (bitStream.read(7) != (1 << 6))
+	{
+		throw RuntimeException("Only BC7 mode 6 blocks can be decoded.");
+	}
+
+	byte endpoints[2][4];
+	for (uint32 c = 0; c < 4; ++c)
+	{
+		endpoints[0][c] = static_cast<byte>(bitStream.read(7));
+		endpoints[1][c] = static_cast<byte>(bitStream.read(7));
+	}
+
+	for (uint32 e = 0; e < 2; ++e)
+	{
+		const uint32 pBit = bitStream.read(1);
+
+		for (uint32 c = 0; c < 4; ++c)
+		{
+			endpoints[e][c] = static_cast<byte>((endpoints[e][c] << 1) | pBit);
+		}
+	}
+
+	byte palette[16][4];
+	bc7Palette(endpoints[0], endpoints[1], palette);
+
+	for (uint32 i = 0; i < 16; ++i)
+	{
+		const uint32 index = bitStream.read(i == 0 ? 3 : 4);
+		std::copy(palette[index], palette[index] + 4, &block[i * 4]);
+	}
+}
+
+Image toRgba(const graphics::IImage& image)
+{
+	if (image.format() == graphics::IImage::Format::FORMAT_RGBA)
+	{
+		return Image(image.data(), image.width(), image.height(), IImage::Format::FORMAT_RGBA);
+	}
+
+	if (image.format() != graphics::IImage::Format::FORMAT_RGB)
+	{
+		throw InvalidArgumentException("Only RGB and RGBA images can be compressed.");
+	}
+
+	const auto& source = image.data();
+	std::vector<byte> data(image.width() * image.height() * 4);
+
+	for (uint32 i = 0; i < image.width() * image.height(); ++i)
+	{
+		data[i * 4 + 0] = source[i * 3 + 0];
+		data[i * 4 + 1] = source[i * 3 + 1];
+		data[i * 4 + 2] = source[i * 3 + 2];
+		data[i * 4 + 3] = 255;
+	}
+
+	return Image(std::move(data), image.width(), image.height(), IImage::Format::FORMAT_RGBA);
+}
+
+}
+
+TextureCompressor::TextureCompressor(IThreadPool* threadPool) : threadPool_(threadPool)
+{
+}
+
+CompressedImage TextureCompressor::compress(const graphics::IImage& image, const graphics::ICompressedImage::Format format, const bool generateMipmaps) const
+{
+	if (format == graphics::ICompressedImage::Format::FORMAT_UNKNOWN)
+	{
+		throw InvalidArgumentException("Unknown compressed image format.");
+	}
+
+	if (image.width() == 0 || image.height() == 0)
+	{
+		throw InvalidArgumentException("Unable to compress an empty image.");
+	}
+
+	std::vector<Image> mipChain;
+
+	if (generateMipmaps)
+	{
+		mipChain = generateMipChain(image);
+	}
+	else
+	{
+		mipChain.push_back(toRgba(image));
+	}
+
+	std::vector<CompressedImage::Level> levels;
+	levels.reserve(mipChain.size());
+
+	for (const auto& level : mipChain)
+	{
+		levels.emplace_back(level.width(), level.height(), compressLevel(level, format));
+	}
+
+	return CompressedImage(std::move(levels), format);
+}
+
+std::vector<byte> TextureCompressor::compressLevel(const Image& image, const graphics::ICompressedImage::Format format) const
+{
+	const uint32 blockSize = CompressedImage::blockSize(format);
+	const uint32 blocksWide = (image.width() + 3) / 4;
+	const uint32 blocksHigh = (image.height() + 3) / 4;
+
+	std::vector<byte> data(blocksWide * blocksHigh * blockSize);
+
+	auto encodeRows = [&image, &data, format, blockSize, blocksWide](const uint32 startRow, const uint32 endRow) {
+		for (uint32 blockY = startRow; blockY < endRow; ++blockY)
+		{
+			for (uint32 blockX = 0; blockX < blocksWide; ++blockX)
+			{
+				const RgbaBlock block = extractBlock(image, blockX, blockY);
+				byte* output = &data[(blockY * blocksWide + blockX) * blockSize];
+
+				switch (format)
+				{
+					case graphics::ICompressedImage::Format::FORMAT_BC1:
+						encodeBc1Block(block, output);
+						break;
+
+					case graphics::ICompressedImage::Format::FORMAT_BC3:
+						encodeBc3Block(block, output);
+						break;
+
+					case graphics::ICompressedImage::Format::FORMAT_BC5:
+						encodeBc5Block(block, output);
+						break;
+
+					case graphics::ICompressedImage::Format::FORMAT_BC7:
+						encodeBc7Block(block, output);
+						break;
+
+					default:
+						throw InvalidArgumentException("Unknown compressed image format.");
+				}
+			}
+		}
+	};
+
+	const uint32 numberOfThreads = (threadPool_ != nullptr ? threadPool_->getActiveWorkerCount() + threadPool_->getInactiveWorkerCount() : 0);
+
+	// Small levels aren't worth the overhead of posting to the thread pool
+	if (numberOfThreads < 2 || blocksHigh < 2 * numberOfThreads)
+	{
+		encodeRows(0, blocksHigh);
+
+		return data;
+	}
+
+	const uint32 rowsPerTask = std::max(1u, blocksHigh / (numberOfThreads * 2));
+
+	std::vector<std::future<void>> futures;
+	futures.reserve(blocksHigh / rowsPerTask + 1);
+
+	for (uint32 row = 0; row < blocksHigh; row += rowsPerTask)
+	{
+		const uint32 endRow = std::min(row + rowsPerTask, blocksHigh);
+
+		futures.push_back(threadPool_->postWork([&encodeRows, row, endRow]() {
+			encodeRows(row, endRow);
+		}));
+	}
+
+	// Wait for everything before propagating any exception, the tasks reference our locals
+	for (auto& future : futures)
+	{
+		future.wait();
+	}
+
+	for (auto& future : futures)
+	{
+		future.get();
+	}
+
+	return data;
+}
+
+Image TextureCompressor::decompress(const graphics::ICompressedImage& image, const uint32 level) const
+{
+	if (level >= image.levels())
+	{
+		throw InvalidArgumentException("Compressed image does not have the requested level.");
+	}
+
+	const auto format = static_cast<graphics::ICompressedImage::Format>(image.format());
+	const uint32 width = image.width(level);
+	const uint32 height = image.height(level);
+	const uint32 blockSize = CompressedImage::blockSize(format);
+	const uint32 blocksWide = (width + 3) / 4;
+	const uint32 blocksHigh = (height + 3) / 4;
+	const auto& source = image.data(level);
+
+	if (source.size() < blocksWide * blocksHigh * blockSize)
+	{
+		throw RuntimeException("Compressed image level data is truncated.");
+	}
+
+	std::vector<byte> data(width * height * 4);
+
+	for (uint32 blockY = 0; blockY < blocksHigh; ++blockY)
+	{
+		for (uint32 blockX = 0; blockX < blocksWide; ++blockX)
+		{
+			RgbaBlock block;
+			const byte* input = &source[(blockY * blocksWide + blockX) * blockSize];
+
+			switch (format)
+			{
+				case graphics::ICompressedImage::Format::FORMAT_BC1:
+					decodeBc1Block(input, block);
+					break;
+
+				case graphics::ICompressedImage::Format::FORMAT_BC3:
+					decodeBc3Block(input, block);
+					break;
+
+				case graphics::ICompressedImage::Format::FORMAT_BC5:
+					decodeBc5Block(input, block);
+					break;
+
+				case graphics::ICompressedImage::Format::FORMAT_BC7:
+					decodeBc7Block(input, block);
+					break;
+
+				default:
+					throw InvalidArgumentException("Unknown compressed image format.");
+			}
+
+			for (uint32 y = 0; y < 4 && blockY * 4 + y < height; ++y)
+			{
+				for (uint32 x = 0; x < 4 && blockX * 4 + x < width; ++x)
+				{
+					const uint32 destination = ((blockY * 4 + y) * width + blockX * 4 + x) * 4;
+					std::copy(&block[(y * 4 + x) * 4], &block[(y * 4 + x) * 4] + 4, &data[destination]);
+				}
+			}
+		}
+	}
+
+	return Image(std::move(data), width, height, IImage::Format::FORMAT_RGBA);
+}
+
+std::vector<Image> TextureCompressor::generateMipChain(const graphics::IImage& image)
+{
+	std::vector<Image> mipChain;
+	mipChain.push_back(toRgba(image));
+
+	while (mipChain.back().width() > 1 || mipChain.back().height() > 1)
+	{
+		const Image& previous = mipChain.back();
+		const auto& source = previous.data();
+
+		const uint32 width = std::max(1u, previous.width() / 2);
+		const uint32 height = std::max(1u, previous.height() / 2);
+
+		std::vector<byte> data(width * height * 4);
+
+		for (uint32 y = 0; y < height; ++y)
+		{
+			const uint32 y0 = std::min(y * 2, previous.height() - 1);
+			const uint32 y1 = std::min(y * 2 + 1, previous.height() - 1);
+
+			for (uint32 x = 0; x < width; ++x)
+			{
+				const uint32 x0 = std::min(x * 2, previous.width() - 1);
+				const uint32 x1 = std::min(x * 2 + 1, previous.width() - 1);
+
+				for (uint32 c = 0; c < 4; ++c)
+				{
+					const uint32 sum = source[(y0 * previous.width() + x0) * 4 + c]
+						+ source[(y0 * previous.width() + x1) * 4 + c]
+						+ source[(y1 * previous.width() + x0) * 4 + c]
+						+ source[(y1 * previous.width() + x1) * 4 + c];
+
+					data[(y * width + x) * 4 + c] = static_cast<byte>((sum + 2) / 4);
+				}
+			}
+		}
+
+		mipChain.emplace_back(std::move(data), width, height, IImage::Format::FORMAT_RGBA);
+	}
+
+	return mipChain;
+}
+
+}
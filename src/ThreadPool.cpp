@@ -1,6 +1,8 @@
 #include <ctpl.h>
 
 #include "ThreadPool.hpp"
+#include "Profiler.hpp"
+#include "Metrics.hpp"
 
 namespace ice_engine
 {
@@ -27,12 +29,24 @@ void ThreadPool::initialize(uint32 numThreads)
 
 std::future<void> ThreadPool::postWork(const std::function<void()>& work)
 {
-	return pool_->push( [=] (int32 id) { work(); } );
+	static auto& workPosted = Metrics::instance().counter("thread_pool.work_posted");
+	workPosted.increment();
+
+	return pool_->push( [=] (int32 id) {
+		PROFILE_ZONE("ThreadPool::work");
+		work();
+	} );
 }
 
 std::future<void> ThreadPool::postWork(std::function<void()>&& work)
 {
-	return pool_->push( [work = std::move(work)] (int32 id) { work(); } );
+	static auto& workPosted = Metrics::instance().counter("thread_pool.work_posted");
+	workPosted.increment();
+
+	return pool_->push( [work = std::move(work)] (int32 id) {
+		PROFILE_ZONE("ThreadPool::work");
+		work();
+	} );
 }
 
 void ThreadPool::waitAll()
@@ -0,0 +1,303 @@
+#include <algorithm>
+#include <future>
+#include <cmath>
+
+#include "TiledNavigationMesh.hpp"
+
+#include "exceptions/RuntimeException.hpp"
+
+#include "detail/Format.hpp"
+
+namespace ice_engine
+{
+
+namespace
+{
+
+/**
+ * Geometry of a single tile - the triangles touching it, with their vertices compacted.
+ */
+class TileGeometry : public pathfinding::ITerrain
+{
+public:
+	TileGeometry(const std::vector<glm::vec3>& vertices, const std::vector<uint32>& indices, const std::vector<uint32>& triangles)
+	{
+		std::map<uint32, uint32> remapped;
+
+		indices_.reserve(triangles.size() * 3);
+
+		for (const uint32 triangle : triangles)
+		{
+			for (uint32 i = 0; i < 3; ++i)
+			{
+				const uint32 index = indices[triangle * 3 + i];
+				const auto it = remapped.emplace(index, static_cast<uint32>(vertices_.size()));
+
+				if (it.second) vertices_.push_back(vertices[index]);
+
+				indices_.push_back(it.first->second);
+			}
+		}
+	}
+
+	~TileGeometry() override = default;
+
+	const std::vector<glm::vec3>& vertices() const override
+	{
+		return vertices_;
+	}
+
+	const std::vector<uint32>& indices() const override
+	{
+		return indices_;
+	}
+
+private:
+	std::vector<glm::vec3> vertices_;
+	std::vector<uint32> indices_;
+};
+
+}
+
+TiledNavigationMesh::TiledNavigationMesh(
+	pathfinding::IPathfindingEngine* pathfindingEngine,
+	IThreadPool* threadPool,
+	const glm::vec3& origin,
+	const pathfinding::PolygonMeshConfig& polygonMeshConfig,
+	const pathfinding::NavigationMeshConfig& navigationMeshConfig
+)
+	:
+	pathfindingEngine_(pathfindingEngine),
+	threadPool_(threadPool),
+	origin_(origin),
+	tileSize_(static_cast<float32>(polygonMeshConfig.tileSize) * polygonMeshConfig.cellSize),
+	borderSize_(static_cast<float32>(polygonMeshConfig.borderSize) * polygonMeshConfig.cellSize)
+{
+	if (polygonMeshConfig.tileSize <= 0 || polygonMeshConfig.cellSize <= 0.0f)
+	{
+		throw RuntimeException(detail::format("Tiled navigation meshes need a positive tile size and cell size - got %s and %s.", polygonMeshConfig.tileSize, polygonMeshConfig.cellSize));
+	}
+
+	navigationMeshHandle_ = pathfindingEngine_->createTiledNavigationMesh(origin_, polygonMeshConfig, navigationMeshConfig);
+}
+
+TiledNavigationMesh::~TiledNavigationMesh()
+{
+	pathfindingEngine_->destroy(navigationMeshHandle_);
+}
+
+const pathfinding::NavigationMeshHandle& TiledNavigationMesh::navigationMeshHandle() const
+{
+	return navigationMeshHandle_;
+}
+
+void TiledNavigationMesh::setGeometry(const pathfinding::ITerrain& geometry)
+{
+	// Tiles the old geometry covered have to be rebuilt (or removed) too
+	for (const auto& tileTriangles : tileTriangles_)
+	{
+		dirtyTiles_.insert(tileTriangles.first);
+	}
+
+	vertices_ = geometry.vertices();
+	indices_ = geometry.indices();
+
+	assignTriangles();
+
+	for (const auto& tileTriangles : tileTriangles_)
+	{
+		dirtyTiles_.insert(tileTriangles.first);
+	}
+}
+
+void TiledNavigationMesh::setGeometry(const pathfinding::ITerrain& geometry, const glm::vec3& minimum, const glm::vec3& maximum)
+{
+	vertices_ = geometry.vertices();
+	indices_ = geometry.indices();
+
+	assignTriangles();
+
+	markTiles(minimum, maximum);
+}
+
+pathfinding::ObstacleHandle TiledNavigationMesh::createObstacle(const glm::vec3& position, const float32 radius, const float32 height)
+{
+	markTiles(position - glm::vec3(radius, 0.0f, radius), position + glm::vec3(radius, height, radius));
+
+	return obstacles_.create(position, radius, height);
+}
+
+void TiledNavigationMesh::destroy(const pathfinding::ObstacleHandle& obstacleHandle)
+{
+	const pathfinding::Obstacle* obstacle = obstacles_.get(obstacleHandle);
+
+	if (obstacle == nullptr) return;
+
+	markTiles(
+		obstacle->position - glm::vec3(obstacle->radius, 0.0f, obstacle->radius),
+		obstacle->position + glm::vec3(obstacle->radius, obstacle->height, obstacle->radius)
+	);
+
+	obstacles_.destroy(obstacleHandle);
+}
+
+uint32 TiledNavigationMesh::update()
+{
+	if (dirtyTiles_.empty()) return 0;
+
+	struct Build
+	{
+		TileCoordinate coordinate;
+		std::vector<pathfinding::Obstacle> obstacles;
+		std::vector<byte> data;
+	};
+
+	std::vector<Build> builds;
+	builds.reserve(dirtyTiles_.size());
+
+	for (auto it = dirtyTiles_.begin(); it != dirtyTiles_.end();)
+	{
+		const auto coordinate = *it;
+
+		if (tileTriangles_.find(coordinate) == tileTriangles_.end())
+		{
+			// Nothing left to walk on
+			if (tiles_.erase(coordinate) > 0) pathfindingEngine_->removeNavigationMeshTile(navigationMeshHandle_, coordinate.first, coordinate.second);
+
+			it = dirtyTiles_.erase(it);
+			continue;
+		}
+
+		++it;
+
+		Build build;
+		build.coordinate = coordinate;
+
+		for (const auto& obstacle : obstacles_)
+		{
+			const auto range = tileRange(
+				obstacle.position - glm::vec3(obstacle.radius, 0.0f, obstacle.radius),
+				obstacle.position + glm::vec3(obstacle.radius, obstacle.height, obstacle.radius)
+			);
+
+			if (coordinate.first >= range.first.first && coordinate.first <= range.second.first && coordinate.second >= range.first.second && coordinate.second <= range.second.second)
+			{
+				build.obstacles.push_back(obstacle);
+			}
+		}
+
+		builds.push_back(std::move(build));
+	}
+
+	// Rasterizing only reads the geometry and the pathfinding engine, so tiles are built in parallel
+	auto buildTile = [this](Build& build) {
+		const TileGeometry geometry(vertices_, indices_, tileTriangles_.at(build.coordinate));
+
+		build.data = pathfindingEngine_->buildNavigationMeshTile(navigationMeshHandle_, build.coordinate.first, build.coordinate.second, &geometry, build.obstacles);
+	};
+
+	if (threadPool_ == nullptr || builds.size() == 1)
+	{
+		for (auto& build : builds) buildTile(build);
+	}
+	else
+	{
+		std::vector<std::future<void>> futures;
+		futures.reserve(builds.size());
+
+		for (auto& build : builds)
+		{
+			futures.push_back(threadPool_->postWork([&buildTile, &build]() { buildTile(build); }));
+		}
+
+		// Wait for every tile before rethrowing, so no work is left running against this object
+		for (auto& future : futures) future.wait();
+		for (auto& future : futures) future.get();
+	}
+
+	// Linking tiles into the navigation mesh happens on this thread - tiles stay marked until here, so a build that
+	// throws leaves them to be built again by the next update
+	for (auto& build : builds)
+	{
+		dirtyTiles_.erase(build.coordinate);
+
+		if (build.data.empty())
+		{
+			if (tiles_.erase(build.coordinate) > 0) pathfindingEngine_->removeNavigationMeshTile(navigationMeshHandle_, build.coordinate.first, build.coordinate.second);
+		}
+		else
+		{
+			pathfindingEngine_->addNavigationMeshTile(navigationMeshHandle_, build.coordinate.first, build.coordinate.second, std::move(build.data));
+			tiles_.insert(build.coordinate);
+		}
+	}
+
+	return static_cast<uint32>(builds.size());
+}
+
+const std::set<TiledNavigationMesh::TileCoordinate>& TiledNavigationMesh::tiles() const
+{
+	return tiles_;
+}
+
+void TiledNavigationMesh::assignTriangles()
+{
+	tileTriangles_.clear();
+
+	for (uint32 triangle = 0; triangle < indices_.size() / 3; ++triangle)
+	{
+		const glm::vec3& a = vertices_[indices_[triangle * 3]];
+		const glm::vec3& b = vertices_[indices_[triangle * 3 + 1]];
+		const glm::vec3& c = vertices_[indices_[triangle * 3 + 2]];
+
+		const glm::vec3 minimum(std::min({a.x, b.x, c.x}), std::min({a.y, b.y, c.y}), std::min({a.z, b.z, c.z}));
+		const glm::vec3 maximum(std::max({a.x, b.x, c.x}), std::max({a.y, b.y, c.y}), std::max({a.z, b.z, c.z}));
+
+		const auto range = tileRange(minimum, maximum);
+
+		for (int32 z = range.first.second; z <= range.second.second; ++z)
+		{
+			for (int32 x = range.first.first; x <= range.second.first; ++x)
+			{
+				tileTriangles_[TileCoordinate(x, z)].push_back(triangle);
+			}
+		}
+	}
+}
+
+void TiledNavigationMesh::markTiles(const glm::vec3& minimum, const glm::vec3& maximum)
+{
+	const auto range = tileRange(minimum, maximum);
+
+	for (int32 z = range.first.second; z <= range.second.second; ++z)
+	{
+		for (int32 x = range.first.first; x <= range.second.first; ++x)
+		{
+			const TileCoordinate coordinate(x, z);
+
+			// Only tiles with geometry (or a tile to remove) need building
+			if (tileTriangles_.find(coordinate) != tileTriangles_.end() || tiles_.find(coordinate) != tiles_.end())
+			{
+				dirtyTiles_.insert(coordinate);
+			}
+		}
+	}
+}
+
+std::pair<TiledNavigationMesh::TileCoordinate, TiledNavigationMesh::TileCoordinate> TiledNavigationMesh::tileRange(const glm::vec3& minimum, const glm::vec3& maximum) const
+{
+	const TileCoordinate first(
+		static_cast<int32>(std::floor((minimum.x - borderSize_ - origin_.x) / tileSize_)),
+		static_cast<int32>(std::floor((minimum.z - borderSize_ - origin_.z) / tileSize_))
+	);
+
+	// Touching the far edge of a tile doesn't reach into the next one
+	const TileCoordinate last(
+		std::max(first.first, static_cast<int32>(std::ceil((maximum.x + borderSize_ - origin_.x) / tileSize_)) - 1),
+		std::max(first.second, static_cast<int32>(std::ceil((maximum.z + borderSize_ - origin_.z) / tileSize_)) - 1)
+	);
+
+	return std::make_pair(first, last);
+}
+
+}
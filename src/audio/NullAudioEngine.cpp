@@ -0,0 +1,92 @@
+#include "audio/NullAudioEngine.hpp"
+
+namespace ice_engine
+{
+namespace audio
+{
+
+AudioSceneHandle NullAudioEngine::createAudioScene()
+{
+	return AudioSceneHandle(nextIndex(), 1);
+}
+
+void NullAudioEngine::destroyAudioScene(const AudioSceneHandle& audioSceneHandle)
+{
+}
+
+void NullAudioEngine::tick(const AudioSceneHandle audioSceneHandle, const float32 delta)
+{
+}
+
+void NullAudioEngine::beginRender()
+{
+}
+
+void NullAudioEngine::render(const AudioSceneHandle& audioSceneHandle)
+{
+}
+
+void NullAudioEngine::endRender()
+{
+}
+
+SoundSourceHandle NullAudioEngine::play(const AudioSceneHandle& audioSceneHandle, const SoundHandle& soundHandle, const glm::vec3& position)
+{
+	return SoundSourceHandle(nextIndex(), 1);
+}
+
+void NullAudioEngine::stop(const AudioSceneHandle& audioSceneHandle, const SoundSourceHandle& soundSourceHandle)
+{
+}
+
+void NullAudioEngine::stopAll(const AudioSceneHandle& audioSceneHandle)
+{
+}
+
+SoundHandle NullAudioEngine::createSound(const IAudio& audio)
+{
+	return SoundHandle(nextIndex(), 1);
+}
+
+void NullAudioEngine::destroy(const SoundHandle soundHandle)
+{
+}
+
+ListenerHandle NullAudioEngine::createListener(const AudioSceneHandle& audioSceneHandle, const glm::vec3& position)
+{
+	return ListenerHandle(nextIndex(), 1);
+}
+
+void NullAudioEngine::setPosition(const AudioSceneHandle& audioSceneHandle, const SoundSourceHandle& soundSourceHandle, const float32 x, const float32 y, const float32 z)
+{
+}
+
+void NullAudioEngine::setPosition(const AudioSceneHandle& audioSceneHandle, const SoundSourceHandle& soundSourceHandle, const glm::vec3& position)
+{
+}
+
+glm::vec3 NullAudioEngine::position(const AudioSceneHandle& audioSceneHandle, const SoundSourceHandle& soundSourceHandle) const
+{
+	return glm::vec3(0.0f);
+}
+
+void NullAudioEngine::setPosition(const AudioSceneHandle& audioSceneHandle, const ListenerHandle& listenerHandle, const float32 x, const float32 y, const float32 z)
+{
+}
+
+void NullAudioEngine::setPosition(const AudioSceneHandle& audioSceneHandle, const ListenerHandle& listenerHandle, const glm::vec3& position)
+{
+}
+
+glm::vec3 NullAudioEngine::position(const AudioSceneHandle& audioSceneHandle, const ListenerHandle& listenerHandle) const
+{
+	return glm::vec3(0.0f);
+}
+
+uint32 NullAudioEngine::nextIndex()
+{
+	return nextIndex_.fetch_add(1, std::memory_order_relaxed);
+}
+
+}
+}
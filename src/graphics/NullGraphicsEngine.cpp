@@ -0,0 +1,528 @@
+#include "graphics/NullGraphicsEngine.hpp"
+
+namespace ice_engine
+{
+namespace graphics
+{
+
+void NullGraphicsEngine::setViewport(const uint32 width, const uint32 height)
+{
+	viewport_ = glm::uvec2(width, height);
+}
+
+glm::uvec2 NullGraphicsEngine::getViewport() const
+{
+	return viewport_;
+}
+
+glm::mat4 NullGraphicsEngine::getModelMatrix() const
+{
+	return glm::mat4(1.0f);
+}
+
+glm::mat4 NullGraphicsEngine::getViewMatrix() const
+{
+	return glm::mat4(1.0f);
+}
+
+glm::mat4 NullGraphicsEngine::getProjectionMatrix() const
+{
+	return glm::mat4(1.0f);
+}
+
+void NullGraphicsEngine::beginRender()
+{
+}
+
+void NullGraphicsEngine::render(const RenderSceneHandle& renderSceneHandle)
+{
+}
+
+void NullGraphicsEngine::renderLine(const glm::vec3& from, const glm::vec3& to, const glm::vec3& color)
+{
+}
+
+void NullGraphicsEngine::renderLines(const std::vector<std::tuple<glm::vec3, glm::vec3, glm::vec3>>& lineData)
+{
+}
+
+void NullGraphicsEngine::endRender()
+{
+}
+
+RenderSceneHandle NullGraphicsEngine::createRenderScene()
+{
+	return RenderSceneHandle(nextIndex(), 1);
+}
+
+bool NullGraphicsEngine::valid(const RenderSceneHandle& renderSceneHandle) const
+{
+	return static_cast<bool>(renderSceneHandle);
+}
+
+void NullGraphicsEngine::destroy(const RenderSceneHandle& renderSceneHandle)
+{
+}
+
+CameraHandle NullGraphicsEngine::createCamera(const glm::vec3& position, const glm::vec3& lookAt)
+{
+	return CameraHandle(nextIndex(), 1);
+}
+
+bool NullGraphicsEngine::valid(const CameraHandle& cameraHandle) const
+{
+	return static_cast<bool>(cameraHandle);
+}
+
+void NullGraphicsEngine::destroy(const CameraHandle& cameraHandle)
+{
+}
+
+PointLightHandle NullGraphicsEngine::createPointLight(const RenderSceneHandle& renderSceneHandle, const glm::vec3& position)
+{
+	return PointLightHandle(nextIndex(), 1);
+}
+
+bool NullGraphicsEngine::valid(const RenderSceneHandle& renderSceneHandle, const PointLightHandle& pointLightHandle) const
+{
+	return static_cast<bool>(pointLightHandle);
+}
+
+void NullGraphicsEngine::destroy(const RenderSceneHandle& renderSceneHandle, const PointLightHandle& pointLightHandle)
+{
+}
+
+MeshHandle NullGraphicsEngine::createStaticMesh(const IMesh& mesh)
+{
+	return MeshHandle(nextIndex(), 1);
+}
+
+MeshHandle NullGraphicsEngine::createDynamicMesh(const IMesh& mesh)
+{
+	return MeshHandle(nextIndex(), 1);
+}
+
+bool NullGraphicsEngine::valid(const MeshHandle& meshHandle) const
+{
+	return static_cast<bool>(meshHandle);
+}
+
+void NullGraphicsEngine::destroy(const MeshHandle& meshHandle)
+{
+}
+
+SkeletonHandle NullGraphicsEngine::createSkeleton(const MeshHandle& meshHandle, const ISkeleton& skeleton)
+{
+	return SkeletonHandle(nextIndex(), 1);
+}
+
+bool NullGraphicsEngine::valid(const SkeletonHandle& skeletonHandle) const
+{
+	return static_cast<bool>(skeletonHandle);
+}
+
+void NullGraphicsEngine::destroy(const SkeletonHandle& skeletonHandle)
+{
+}
+
+BonesHandle NullGraphicsEngine::createBones(const uint32 maxNumberOfBones)
+{
+	return BonesHandle(nextIndex(), 1);
+}
+
+bool NullGraphicsEngine::valid(const BonesHandle& bonesHandle) const
+{
+	return static_cast<bool>(bonesHandle);
+}
+
+void NullGraphicsEngine::destroy(const BonesHandle& bonesHandle)
+{
+}
+
+void NullGraphicsEngine::attach(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const BonesHandle& bonesHandle)
+{
+}
+
+void NullGraphicsEngine::detach(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const BonesHandle& bonesHandle)
+{
+}
+
+void NullGraphicsEngine::attachBoneAttachment(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const BonesHandle& bonesHandle, const glm::ivec4& boneIds, const glm::vec4& boneWeights)
+{
+}
+
+void NullGraphicsEngine::detachBoneAttachment(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle)
+{
+}
+
+TextureHandle NullGraphicsEngine::createTexture2d(const ITexture& texture)
+{
+	return TextureHandle(nextIndex(), 1);
+}
+
+TextureHandle NullGraphicsEngine::createTexture2d(const ICompressedTexture& texture)
+{
+	return TextureHandle(nextIndex(), 1);
+}
+
+bool NullGraphicsEngine::valid(const TextureHandle& textureHandle) const
+{
+	return static_cast<bool>(textureHandle);
+}
+
+void NullGraphicsEngine::destroy(const TextureHandle& textureHandle)
+{
+}
+
+MaterialHandle NullGraphicsEngine::createMaterial(const IPbrMaterial& pbrMaterial)
+{
+	return MaterialHandle(nextIndex(), 1);
+}
+
+bool NullGraphicsEngine::valid(const MaterialHandle& materialHandle) const
+{
+	return static_cast<bool>(materialHandle);
+}
+
+void NullGraphicsEngine::destroy(const MaterialHandle& materialHandle)
+{
+}
+
+TerrainHandle NullGraphicsEngine::createStaticTerrain(const IHeightMap& heightMap, const ISplatMap& splatMap, const IDisplacementMap& displacementMap)
+{
+	return TerrainHandle(nextIndex(), 1);
+}
+
+bool NullGraphicsEngine::valid(const TerrainHandle& terrainHandle) const
+{
+	return static_cast<bool>(terrainHandle);
+}
+
+void NullGraphicsEngine::destroy(const TerrainHandle& terrainHandle)
+{
+}
+
+SkyboxHandle NullGraphicsEngine::createStaticSkybox(const IImage& back, const IImage& down, const IImage& front, const IImage& left, const IImage& right, const IImage& up)
+{
+	return SkyboxHandle(nextIndex(), 1);
+}
+
+bool NullGraphicsEngine::valid(const SkyboxHandle& skyboxHandle) const
+{
+	return static_cast<bool>(skyboxHandle);
+}
+
+void NullGraphicsEngine::destroy(const SkyboxHandle& skyboxHandle)
+{
+}
+
+VertexShaderHandle NullGraphicsEngine::createVertexShader(const std::string& data)
+{
+	return VertexShaderHandle(nextIndex(), 1);
+}
+
+FragmentShaderHandle NullGraphicsEngine::createFragmentShader(const std::string& data)
+{
+	return FragmentShaderHandle(nextIndex(), 1);
+}
+
+TessellationControlShaderHandle NullGraphicsEngine::createTessellationControlShader(const std::string& data)
+{
+	return TessellationControlShaderHandle(nextIndex(), 1);
+}
+
+TessellationEvaluationShaderHandle NullGraphicsEngine::createTessellationEvaluationShader(const std::string& data)
+{
+	return TessellationEvaluationShaderHandle(nextIndex(), 1);
+}
+
+bool NullGraphicsEngine::valid(const VertexShaderHandle& shaderHandle) const
+{
+	return static_cast<bool>(shaderHandle);
+}
+
+bool NullGraphicsEngine::valid(const FragmentShaderHandle& shaderHandle) const
+{
+	return static_cast<bool>(shaderHandle);
+}
+
+bool NullGraphicsEngine::valid(const TessellationControlShaderHandle& shaderHandle) const
+{
+	return static_cast<bool>(shaderHandle);
+}
+
+bool NullGraphicsEngine::valid(const TessellationEvaluationShaderHandle& shaderHandle) const
+{
+	return static_cast<bool>(shaderHandle);
+}
+
+void NullGraphicsEngine::destroy(const VertexShaderHandle& shaderHandle)
+{
+}
+
+void NullGraphicsEngine::destroy(const FragmentShaderHandle& shaderHandle)
+{
+}
+
+void NullGraphicsEngine::destroy(const TessellationControlShaderHandle& shaderHandle)
+{
+}
+
+void NullGraphicsEngine::destroy(const TessellationEvaluationShaderHandle& shaderHandle)
+{
+}
+
+ShaderProgramHandle NullGraphicsEngine::createShaderProgram(const VertexShaderHandle& vertexShaderHandle, const FragmentShaderHandle& fragmentShaderHandle)
+{
+	return ShaderProgramHandle(nextIndex(), 1);
+}
+
+ShaderProgramHandle NullGraphicsEngine::createShaderProgram(const VertexShaderHandle& vertexShaderHandle, const TessellationControlShaderHandle& tessellationControlShaderHandle, const TessellationEvaluationShaderHandle& tessellationEvaluationShaderHandle, const FragmentShaderHandle& fragmentShaderHandle)
+{
+	return ShaderProgramHandle(nextIndex(), 1);
+}
+
+bool NullGraphicsEngine::valid(const ShaderProgramHandle& shaderProgramHandle) const
+{
+	return static_cast<bool>(shaderProgramHandle);
+}
+
+void NullGraphicsEngine::destroy(const ShaderProgramHandle& shaderProgramHandle)
+{
+}
+
+RenderableHandle NullGraphicsEngine::createRenderable(const RenderSceneHandle& renderSceneHandle, const MeshHandle& meshHandle, const TextureHandle& textureHandle, const glm::vec3& position, const glm::quat& orientation, const glm::vec3& scale, const ShaderProgramHandle& shaderProgramHandle)
+{
+	return RenderableHandle(nextIndex(), 1);
+}
+
+RenderableHandle NullGraphicsEngine::createRenderable(const RenderSceneHandle& renderSceneHandle, const MeshHandle& meshHandle, const MaterialHandle& materialHandle, const glm::vec3& position, const glm::quat& orientation, const glm::vec3& scale)
+{
+	return RenderableHandle(nextIndex(), 1);
+}
+
+bool NullGraphicsEngine::valid(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle) const
+{
+	return static_cast<bool>(renderableHandle);
+}
+
+void NullGraphicsEngine::destroy(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle)
+{
+}
+
+TerrainRenderableHandle NullGraphicsEngine::createTerrainRenderable(const RenderSceneHandle& renderSceneHandle, const TerrainHandle& terrainHandle)
+{
+	return TerrainRenderableHandle(nextIndex(), 1);
+}
+
+bool NullGraphicsEngine::valid(const RenderSceneHandle& renderSceneHandle, const TerrainRenderableHandle& terrainRenderableHandle) const
+{
+	return static_cast<bool>(terrainRenderableHandle);
+}
+
+void NullGraphicsEngine::destroy(const RenderSceneHandle& renderSceneHandle, const TerrainRenderableHandle& terrainRenderableHandle)
+{
+}
+
+SkyboxRenderableHandle NullGraphicsEngine::createSkyboxRenderable(const RenderSceneHandle& renderSceneHandle, const SkyboxHandle& skyboxHandle)
+{
+	return SkyboxRenderableHandle(nextIndex(), 1);
+}
+
+bool NullGraphicsEngine::valid(const RenderSceneHandle& renderSceneHandle, const SkyboxRenderableHandle& skyboxRenderableHandle) const
+{
+	return static_cast<bool>(skyboxRenderableHandle);
+}
+
+void NullGraphicsEngine::destroy(const RenderSceneHandle& renderSceneHandle, const SkyboxRenderableHandle& skyboxRenderableHandle)
+{
+}
+
+void NullGraphicsEngine::rotate(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const glm::quat& quaternion, const TransformSpace& relativeTo)
+{
+}
+
+void NullGraphicsEngine::rotate(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const float32 degrees, const glm::vec3& axis, const TransformSpace& relativeTo)
+{
+}
+
+void NullGraphicsEngine::rotate(const CameraHandle& cameraHandle, const glm::quat& quaternion, const TransformSpace& relativeTo)
+{
+}
+
+void NullGraphicsEngine::rotate(const CameraHandle& cameraHandle, const float32 degrees, const glm::vec3& axis, const TransformSpace& relativeTo)
+{
+}
+
+void NullGraphicsEngine::rotation(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const glm::quat& quaternion)
+{
+}
+
+void NullGraphicsEngine::rotation(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const float32 degrees, const glm::vec3& axis)
+{
+}
+
+glm::quat NullGraphicsEngine::rotation(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle) const
+{
+	return glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+}
+
+void NullGraphicsEngine::rotation(const CameraHandle& cameraHandle, const glm::quat& quaternion)
+{
+}
+
+void NullGraphicsEngine::rotation(const CameraHandle& cameraHandle, const float32 degrees, const glm::vec3& axis)
+{
+}
+
+glm::quat NullGraphicsEngine::rotation(const CameraHandle& cameraHandle) const
+{
+	return glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+}
+
+void NullGraphicsEngine::translate(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const float32 x, const float32 y, const float32 z)
+{
+}
+
+void NullGraphicsEngine::translate(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const glm::vec3& trans)
+{
+}
+
+void NullGraphicsEngine::translate(const RenderSceneHandle& renderSceneHandle, const PointLightHandle& pointLightHandle, const float32 x, const float32 y, const float32 z)
+{
+}
+
+void NullGraphicsEngine::translate(const RenderSceneHandle& renderSceneHandle, const PointLightHandle& pointLightHandle, const glm::vec3& trans)
+{
+}
+
+void NullGraphicsEngine::translate(const CameraHandle& cameraHandle, const float32 x, const float32 y, const float32 z)
+{
+}
+
+void NullGraphicsEngine::translate(const CameraHandle& cameraHandle, const glm::vec3& trans)
+{
+}
+
+void NullGraphicsEngine::scale(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const float32 x, const float32 y, const float32 z)
+{
+}
+
+void NullGraphicsEngine::scale(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const glm::vec3& scale)
+{
+}
+
+void NullGraphicsEngine::scale(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const float32 scale)
+{
+}
+
+glm::vec3 NullGraphicsEngine::scale(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle) const
+{
+	return glm::vec3(0.0f);
+}
+
+void NullGraphicsEngine::position(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const float32 x, const float32 y, const float32 z)
+{
+}
+
+void NullGraphicsEngine::position(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const glm::vec3& position)
+{
+}
+
+glm::vec3 NullGraphicsEngine::position(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle) const
+{
+	return glm::vec3(0.0f);
+}
+
+void NullGraphicsEngine::position(const RenderSceneHandle& renderSceneHandle, const TerrainRenderableHandle& terrainRenderableHandle, const glm::vec3& position)
+{
+}
+
+glm::vec3 NullGraphicsEngine::position(const RenderSceneHandle& renderSceneHandle, const TerrainRenderableHandle& terrainRenderableHandle) const
+{
+	return glm::vec3(0.0f);
+}
+
+void NullGraphicsEngine::position(const RenderSceneHandle& renderSceneHandle, const PointLightHandle& pointLightHandle, const float32 x, const float32 y, const float32 z)
+{
+}
+
+void NullGraphicsEngine::position(const RenderSceneHandle& renderSceneHandle, const PointLightHandle& pointLightHandle, const glm::vec3& position)
+{
+}
+
+glm::vec3 NullGraphicsEngine::position(const RenderSceneHandle& renderSceneHandle, const PointLightHandle& pointLightHandle) const
+{
+	return glm::vec3(0.0f);
+}
+
+void NullGraphicsEngine::position(const CameraHandle& cameraHandle, const float32 x, const float32 y, const float32 z)
+{
+}
+
+void NullGraphicsEngine::position(const CameraHandle& cameraHandle, const glm::vec3& position)
+{
+}
+
+glm::vec3 NullGraphicsEngine::position(const CameraHandle& cameraHandle) const
+{
+	return glm::vec3(0.0f);
+}
+
+void NullGraphicsEngine::lookAt(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const glm::vec3& lookAt)
+{
+}
+
+void NullGraphicsEngine::lookAt(const CameraHandle& cameraHandle, const glm::vec3& lookAt)
+{
+}
+
+void NullGraphicsEngine::assign(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const SkeletonHandle& skeletonHandle)
+{
+}
+
+void NullGraphicsEngine::update(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const BonesHandle& bonesHandle, const std::vector<glm::mat4>& transformations)
+{
+}
+
+void NullGraphicsEngine::update(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const BonesHandle& bonesHandle, const glm::mat4* transformations, const uint32 numberOfTransformations)
+{
+}
+
+void NullGraphicsEngine::setMouseRelativeMode(const bool enabled)
+{
+}
+
+void NullGraphicsEngine::setWindowGrab(const bool enabled)
+{
+}
+
+bool NullGraphicsEngine::cursorVisible() const
+{
+	return cursorVisible_;
+}
+
+void NullGraphicsEngine::setCursorVisible(const bool visible)
+{
+	cursorVisible_ = visible;
+}
+
+void NullGraphicsEngine::processEvents()
+{
+}
+
+void NullGraphicsEngine::addEventListener(IEventListener* eventListener)
+{
+}
+
+void NullGraphicsEngine::removeEventListener(IEventListener* eventListener)
+{
+}
+
+uint32 NullGraphicsEngine::nextIndex()
+{
+	return nextIndex_.fetch_add(1, std::memory_order_relaxed);
+}
+
+}
+}
@@ -0,0 +1,186 @@
+#include <chrono>
+
+#include "logger/AsyncLogger.hpp"
+
+#include "exceptions/RuntimeException.hpp"
+
+#include "detail/Format.hpp"
+
+namespace ice_engine
+{
+namespace logger
+{
+
+namespace
+{
+
+uint32 queueSize(const AsyncLoggerSettings& asyncLoggerSettings)
+{
+	if (asyncLoggerSettings.queueSize < 2 || (asyncLoggerSettings.queueSize & (asyncLoggerSettings.queueSize - 1)) != 0)
+	{
+		throw RuntimeException(detail::format("Log queue size must be a power of 2 - got %s.", asyncLoggerSettings.queueSize));
+	}
+
+	return asyncLoggerSettings.queueSize;
+}
+
+}
+
+AsyncLogger::AsyncLogger(std::unique_ptr<ILogger> logger, const AsyncLoggerSettings& asyncLoggerSettings)
+:
+	logger_(std::move(logger)),
+	asyncLoggerSettings_(asyncLoggerSettings),
+	records_(queueSize(asyncLoggerSettings))
+{
+	thread_ = std::thread(&AsyncLogger::run, this);
+}
+
+AsyncLogger::~AsyncLogger()
+{
+	running_.store(false);
+	thread_.join();
+
+	// Whatever was logged while the thread was stopping
+	drain();
+}
+
+void AsyncLogger::info(const std::string& message)
+{
+	write(LogRecord(LOG_LEVEL_INFO, message));
+}
+
+void AsyncLogger::debug(const std::string& message)
+{
+	write(LogRecord(LOG_LEVEL_DEBUG, message));
+}
+
+void AsyncLogger::trace(const std::string& message)
+{
+	write(LogRecord(LOG_LEVEL_TRACE, message));
+}
+
+void AsyncLogger::warn(const std::string& message)
+{
+	write(LogRecord(LOG_LEVEL_WARN, message));
+}
+
+void AsyncLogger::error(const std::string& message)
+{
+	write(LogRecord(LOG_LEVEL_ERROR, message));
+}
+
+void AsyncLogger::fatal(const std::string& message)
+{
+	write(LogRecord(LOG_LEVEL_FATAL, message));
+}
+
+// Wide messages are rare enough to go straight through
+void AsyncLogger::info(const std::wstring& message)
+{
+	logger_->info(message);
+}
+
+void AsyncLogger::debug(const std::wstring& message)
+{
+	logger_->debug(message);
+}
+
+void AsyncLogger::trace(const std::wstring& message)
+{
+	logger_->trace(message);
+}
+
+void AsyncLogger::warn(const std::wstring& message)
+{
+	logger_->warn(message);
+}
+
+void AsyncLogger::error(const std::wstring& message)
+{
+	logger_->error(message);
+}
+
+void AsyncLogger::fatal(const std::wstring& message)
+{
+	logger_->fatal(message);
+}
+
+void AsyncLogger::write(LogRecord&& record)
+{
+	const bool fatal = record.level() == LOG_LEVEL_FATAL;
+
+	// A fatal message is likely the last one - it is never dropped
+	while (!records_.tryPush(record))
+	{
+		if (!asyncLoggerSettings_.block && !fatal)
+		{
+			dropped_.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		std::this_thread::yield();
+	}
+
+	pushed_.fetch_add(1, std::memory_order_release);
+
+	if (fatal) flush();
+}
+
+void AsyncLogger::flush()
+{
+	const uint64 pushed = pushed_.load(std::memory_order_acquire);
+
+	while (written_.load(std::memory_order_acquire) < pushed)
+	{
+		std::this_thread::yield();
+	}
+}
+
+uint64 AsyncLogger::droppedRecords() const
+{
+	return dropped_.load(std::memory_order_relaxed);
+}
+
+void AsyncLogger::run()
+{
+	while (running_.load())
+	{
+		if (drain() == 0)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+}
+
+uint64 AsyncLogger::drain()
+{
+	uint64 count = 0;
+	LogRecord record;
+
+	while (records_.tryPop(record))
+	{
+		try
+		{
+			logger_->write(std::move(record));
+		}
+		catch (const std::exception& e)
+		{
+			logger_->error(std::string("Unable to write log message: ") + e.what());
+		}
+
+		written_.fetch_add(1, std::memory_order_release);
+		++count;
+	}
+
+	const uint64 dropped = dropped_.load(std::memory_order_relaxed);
+	if (dropped != reportedDropped_)
+	{
+		logger_->warn(detail::format("Log queue full - %s messages dropped.", dropped - reportedDropped_));
+		reportedDropped_ = dropped;
+	}
+
+	return count;
+}
+
+}
+}
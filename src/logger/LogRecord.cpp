@@ -0,0 +1,78 @@
+#include <boost/format.hpp>
+
+#include "logger/LogRecord.hpp"
+
+namespace ice_engine
+{
+namespace logger
+{
+
+namespace
+{
+
+template <typename T>
+T read(const char* data, size_t& position)
+{
+	T value;
+	std::memcpy(&value, data + position, sizeof(T));
+	position += sizeof(T);
+
+	return value;
+}
+
+}
+
+std::string LogRecord::message() const
+{
+	if (formatted_) return ownedFormat_;
+
+	boost::format format(ownedFormat_);
+
+	const char* data = arguments_.data();
+	size_t position = 0;
+
+	while (position < arguments_.size())
+	{
+		const auto type = static_cast<ArgumentType>(data[position++]);
+
+		switch (type)
+		{
+			case ARGUMENT_TYPE_BOOL:
+				format % read<bool>(data, position);
+				break;
+
+			case ARGUMENT_TYPE_CHAR:
+				format % read<char>(data, position);
+				break;
+
+			case ARGUMENT_TYPE_SIGNED:
+				format % read<int64>(data, position);
+				break;
+
+			case ARGUMENT_TYPE_UNSIGNED:
+				format % read<uint64>(data, position);
+				break;
+
+			case ARGUMENT_TYPE_FLOAT32:
+				format % read<float32>(data, position);
+				break;
+
+			case ARGUMENT_TYPE_FLOAT64:
+				format % read<float64>(data, position);
+				break;
+
+			case ARGUMENT_TYPE_STRING:
+			{
+				const auto length = read<uint32>(data, position);
+				format % std::string(data + position, length);
+				position += length;
+				break;
+			}
+		}
+	}
+
+	return std::string(function_) + " line " + std::to_string(line_) + ": " + boost::str(format);
+}
+
+}
+}
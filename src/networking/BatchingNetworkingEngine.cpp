@@ -0,0 +1,417 @@
+#include <algorithm>
+
+#include "networking/BatchingNetworkingEngine.hpp"
+
+#include "BlockCompressor.hpp"
+
+#include "exceptions/RuntimeException.hpp"
+
+#include "detail/Format.hpp"
+
+namespace ice_engine
+{
+namespace networking
+{
+
+namespace
+{
+
+enum BatchFlags : uint8
+{
+	BATCH_COMPRESSED = 1 << 0
+};
+
+// Nothing legitimate comes close - guards the decompression buffer against garbage
+const size_t MAX_UNCOMPRESSED_BATCH_SIZE = 16 * 1024 * 1024;
+
+void writeVariable(std::vector<uint8>& data, size_t value)
+{
+	while (value >= 0x80)
+	{
+		data.push_back(static_cast<uint8>(value | 0x80));
+		value >>= 7;
+	}
+
+	data.push_back(static_cast<uint8>(value));
+}
+
+size_t readVariable(const uint8* data, const size_t size, size_t& position)
+{
+	size_t value = 0;
+
+	for (uint32 shift = 0; shift < 35; shift += 7)
+	{
+		if (position >= size) throw RuntimeException("Batch ends in the middle of a length.");
+
+		const uint8 byte = data[position++];
+		value |= static_cast<size_t>(byte & 0x7f) << shift;
+
+		if ((byte & 0x80) == 0) return value;
+	}
+
+	throw RuntimeException("Batch has a length longer than 32 bits.");
+}
+
+size_t variableSize(size_t value)
+{
+	size_t size = 1;
+
+	while (value >= 0x80)
+	{
+		value >>= 7;
+		++size;
+	}
+
+	return size;
+}
+
+}
+
+BatchingNetworkingEngine::BatchingNetworkingEngine(std::unique_ptr<INetworkingEngine> networkingEngine, logger::ILogger* logger, const BatchingSettings& batchingSettings)
+	:
+	networkingEngine_(std::move(networkingEngine)),
+	logger_(logger),
+	batchingSettings_(batchingSettings)
+{
+	networkingEngine_->addEventListener(this);
+}
+
+BatchingNetworkingEngine::~BatchingNetworkingEngine()
+{
+	networkingEngine_->removeEventListener(this);
+}
+
+ServerHandle BatchingNetworkingEngine::createServer()
+{
+	return networkingEngine_->createServer();
+}
+
+ClientHandle BatchingNetworkingEngine::createClient()
+{
+	return networkingEngine_->createClient();
+}
+
+void BatchingNetworkingEngine::destroyServer(const ServerHandle& serverHandle)
+{
+	// Messages to a server that is going away are dropped, as they would be without batching
+	for (auto it = queues_.begin(); it != queues_.end();)
+	{
+		const uint32 type = std::get<0>(it->first);
+
+		if ((type == SERVER || type == SERVER_CONNECTION) && std::get<1>(it->first) == serverHandle.id()) it = queues_.erase(it);
+		else ++it;
+	}
+
+	networkingEngine_->destroyServer(serverHandle);
+}
+
+void BatchingNetworkingEngine::destroyClient(const ClientHandle& clientHandle)
+{
+	for (auto it = queues_.begin(); it != queues_.end();)
+	{
+		if (std::get<0>(it->first) == CLIENT && std::get<1>(it->first) == clientHandle.id()) it = queues_.erase(it);
+		else ++it;
+	}
+
+	networkingEngine_->destroyClient(clientHandle);
+}
+
+void BatchingNetworkingEngine::tick(const float32 delta)
+{
+	flush();
+
+	networkingEngine_->tick(delta);
+}
+
+void BatchingNetworkingEngine::send(const ServerHandle& serverHandle, const std::vector<uint8>& data)
+{
+	send(serverHandle, messageBufferPool_.allocate(data), RELIABLE);
+}
+
+void BatchingNetworkingEngine::send(const ServerHandle& serverHandle, const RemoteConnectionHandle& remoteConnectionHandle, const std::vector<uint8>& data)
+{
+	send(serverHandle, remoteConnectionHandle, messageBufferPool_.allocate(data), RELIABLE);
+}
+
+void BatchingNetworkingEngine::send(const ClientHandle& clientHandle, const std::vector<uint8>& data)
+{
+	send(clientHandle, messageBufferPool_.allocate(data), RELIABLE);
+}
+
+void BatchingNetworkingEngine::send(const ServerHandle& serverHandle, MessageBuffer data)
+{
+	send(serverHandle, std::move(data), RELIABLE);
+}
+
+void BatchingNetworkingEngine::send(const ServerHandle& serverHandle, const RemoteConnectionHandle& remoteConnectionHandle, MessageBuffer data)
+{
+	send(serverHandle, remoteConnectionHandle, std::move(data), RELIABLE);
+}
+
+void BatchingNetworkingEngine::send(const ClientHandle& clientHandle, MessageBuffer data)
+{
+	send(clientHandle, std::move(data), RELIABLE);
+}
+
+void BatchingNetworkingEngine::send(const ServerHandle& serverHandle, MessageBuffer data, const Channel channel)
+{
+	queue(Destination(SERVER, serverHandle.id(), 0, channel), std::move(data));
+}
+
+void BatchingNetworkingEngine::send(const ServerHandle& serverHandle, const RemoteConnectionHandle& remoteConnectionHandle, MessageBuffer data, const Channel channel)
+{
+	queue(Destination(SERVER_CONNECTION, serverHandle.id(), remoteConnectionHandle.id(), channel), std::move(data));
+}
+
+void BatchingNetworkingEngine::send(const ClientHandle& clientHandle, MessageBuffer data, const Channel channel)
+{
+	queue(Destination(CLIENT, clientHandle.id(), 0, channel), std::move(data));
+}
+
+void BatchingNetworkingEngine::processEvents()
+{
+	networkingEngine_->processEvents();
+}
+
+void BatchingNetworkingEngine::addEventListener(networking::IEventListener* eventListener)
+{
+	eventListeners_.push_back(eventListener);
+}
+
+void BatchingNetworkingEngine::removeEventListener(networking::IEventListener* eventListener)
+{
+	eventListeners_.erase(std::remove(eventListeners_.begin(), eventListeners_.end(), eventListener), eventListeners_.end());
+}
+
+bool BatchingNetworkingEngine::processEvent(const ConnectEvent& event)
+{
+	for (auto eventListener : eventListeners_)
+	{
+		eventListener->processEvent(event);
+	}
+
+	return false;
+}
+
+bool BatchingNetworkingEngine::processEvent(const DisconnectEvent& event)
+{
+	// Nothing queued for a connection that is gone can be delivered
+	if (event.type == CLIENTDISCONNECT)
+	{
+		for (auto it = queues_.begin(); it != queues_.end();)
+		{
+			if (std::get<0>(it->first) == SERVER_CONNECTION && std::get<2>(it->first) == event.remoteConnectionHandle.id()) it = queues_.erase(it);
+			else ++it;
+		}
+	}
+
+	for (auto eventListener : eventListeners_)
+	{
+		eventListener->processEvent(event);
+	}
+
+	return false;
+}
+
+bool BatchingNetworkingEngine::processEvent(const MessageEvent& event)
+{
+	received_.clear();
+
+	try
+	{
+		unpack(event.message.data(), event.message.size(), messageBufferPool_, received_);
+	}
+	catch (const RuntimeException& e)
+	{
+		// A bad batch from a remote peer shouldn't take the game down
+		LOG_WARN(logger_, "Dropping malformed message batch of %s bytes: %s", event.message.size(), e.what());
+
+		return false;
+	}
+
+	MessageEvent messageEvent = event;
+
+	for (auto& message : received_)
+	{
+		messageEvent.message = std::move(message);
+
+		for (auto eventListener : eventListeners_)
+		{
+			eventListener->processEvent(messageEvent);
+		}
+	}
+
+	received_.clear();
+
+	return false;
+}
+
+void BatchingNetworkingEngine::flush()
+{
+	for (auto& entry : queues_)
+	{
+		flush(entry.first, entry.second);
+	}
+}
+
+uint64 BatchingNetworkingEngine::batches() const
+{
+	return batches_;
+}
+
+uint64 BatchingNetworkingEngine::messages() const
+{
+	return messages_;
+}
+
+void BatchingNetworkingEngine::unpack(const uint8* data, const size_t size, MessageBufferPool& messageBufferPool, std::vector<MessageBuffer>& messages)
+{
+	if (size == 0) throw RuntimeException("Batch is empty.");
+
+	const uint8 flags = data[0];
+
+	const uint8* payload = data + 1;
+	size_t payloadSize = size - 1;
+
+	std::vector<uint8> decompressed;
+
+	if (flags & BATCH_COMPRESSED)
+	{
+		size_t position = 1;
+		const size_t uncompressedSize = readVariable(data, size, position);
+
+		if (uncompressedSize > MAX_UNCOMPRESSED_BATCH_SIZE)
+		{
+			throw RuntimeException(detail::format("Batch claims to decompress to %s bytes.", uncompressedSize));
+		}
+
+		decompressed.resize(uncompressedSize);
+		BlockCompressor::decompress(data + position, size - position, decompressed.data(), decompressed.size());
+
+		payload = decompressed.data();
+		payloadSize = decompressed.size();
+	}
+
+	size_t position = 0;
+
+	while (position < payloadSize)
+	{
+		const size_t messageSize = readVariable(payload, payloadSize, position);
+
+		if (messageSize > payloadSize - position)
+		{
+			throw RuntimeException(detail::format("Batch message of %s bytes runs past the end of the batch.", messageSize));
+		}
+
+		messages.push_back(messageBufferPool.allocate(payload + position, messageSize));
+		position += messageSize;
+	}
+}
+
+void BatchingNetworkingEngine::queue(const Destination& destination, MessageBuffer data)
+{
+	const uint32 type = std::get<0>(destination);
+	const uint64 server = std::get<1>(destination);
+	const uint32 channel = std::get<3>(destination);
+
+	// A broadcast reaches the same connections as the server's targeted messages - whatever is pending of the other
+	// kind on this channel goes out first, so the wrapped engine gets both in the order they were sent
+	if (type == SERVER)
+	{
+		for (auto it = queues_.lower_bound(Destination(SERVER_CONNECTION, server, 0, 0)); it != queues_.end() && std::get<0>(it->first) == SERVER_CONNECTION && std::get<1>(it->first) == server; ++it)
+		{
+			if (std::get<3>(it->first) == channel) flush(it->first, it->second);
+		}
+	}
+	else if (type == SERVER_CONNECTION)
+	{
+		const auto it = queues_.find(Destination(SERVER, server, 0, channel));
+
+		if (it != queues_.end()) flush(it->first, it->second);
+	}
+
+	queues_[destination].messages.push_back(std::move(data));
+}
+
+void BatchingNetworkingEngine::flush(const Destination& destination, Queue& queue)
+{
+	auto& messages = queue.messages;
+
+	if (messages.empty()) return;
+
+	batch_.clear();
+	batch_.push_back(0);
+
+	for (const auto& message : messages)
+	{
+		const size_t frameSize = variableSize(message.size()) + message.size();
+
+		if (batch_.size() > 1 && batch_.size() + frameSize > batchingSettings_.maxBatchSize)
+		{
+			sendBatch(destination);
+
+			batch_.clear();
+			batch_.push_back(0);
+		}
+
+		writeVariable(batch_, message.size());
+		batch_.insert(batch_.end(), message.begin(), message.end());
+	}
+
+	sendBatch(destination);
+
+	messages_ += messages.size();
+	messages.clear();
+}
+
+void BatchingNetworkingEngine::sendBatch(const Destination& destination)
+{
+	MessageBuffer messageBuffer;
+
+	const size_t payloadSize = batch_.size() - 1;
+	bool compressed = false;
+
+	if (batchingSettings_.compression && batch_.size() >= batchingSettings_.compressionThreshold)
+	{
+		const auto compressedPayload = BlockCompressor::compress(batch_.data() + 1, payloadSize);
+		const size_t compressedSize = 1 + variableSize(payloadSize) + compressedPayload.size();
+
+		// Already compressed (or random) data doesn't shrink
+		if (compressedSize < batch_.size())
+		{
+			std::vector<uint8> header;
+			header.push_back(BATCH_COMPRESSED);
+			writeVariable(header, payloadSize);
+
+			messageBuffer = messageBufferPool_.allocate(compressedSize);
+			std::copy(header.begin(), header.end(), messageBuffer.begin());
+			std::copy(compressedPayload.begin(), compressedPayload.end(), messageBuffer.begin() + header.size());
+
+			compressed = true;
+		}
+	}
+
+	if (!compressed) messageBuffer = messageBufferPool_.allocate(batch_);
+
+	const Channel channel = static_cast<Channel>(std::get<3>(destination));
+
+	switch (std::get<0>(destination))
+	{
+		case SERVER:
+			networkingEngine_->send(ServerHandle(std::get<1>(destination)), std::move(messageBuffer), channel);
+			break;
+
+		case SERVER_CONNECTION:
+			networkingEngine_->send(ServerHandle(std::get<1>(destination)), RemoteConnectionHandle(std::get<2>(destination)), std::move(messageBuffer), channel);
+			break;
+
+		case CLIENT:
+			networkingEngine_->send(ClientHandle(std::get<1>(destination)), std::move(messageBuffer), channel);
+			break;
+	}
+
+	++batches_;
+}
+
+}
+}
@@ -0,0 +1,165 @@
+#include <algorithm>
+
+#include "networking/CountingNetworkingEngine.hpp"
+
+#include "Metrics.hpp"
+
+namespace ice_engine
+{
+namespace networking
+{
+
+namespace
+{
+
+void countSent(const size_t size)
+{
+	static auto& bytesSent = Metrics::instance().counter("networking.bytes_sent");
+	static auto& batchSize = Metrics::instance().histogram("networking.batch_bytes");
+	bytesSent.increment(size);
+	batchSize.record(size);
+}
+
+}
+
+CountingNetworkingEngine::CountingNetworkingEngine(std::unique_ptr<INetworkingEngine> networkingEngine)
+	:
+	networkingEngine_(std::move(networkingEngine))
+{
+	networkingEngine_->addEventListener(this);
+}
+
+CountingNetworkingEngine::~CountingNetworkingEngine()
+{
+	networkingEngine_->removeEventListener(this);
+}
+
+ServerHandle CountingNetworkingEngine::createServer()
+{
+	return networkingEngine_->createServer();
+}
+
+ClientHandle CountingNetworkingEngine::createClient()
+{
+	return networkingEngine_->createClient();
+}
+
+void CountingNetworkingEngine::destroyServer(const ServerHandle& serverHandle)
+{
+	networkingEngine_->destroyServer(serverHandle);
+}
+
+void CountingNetworkingEngine::destroyClient(const ClientHandle& clientHandle)
+{
+	networkingEngine_->destroyClient(clientHandle);
+}
+
+void CountingNetworkingEngine::tick(const float32 delta)
+{
+	networkingEngine_->tick(delta);
+}
+
+void CountingNetworkingEngine::send(const ServerHandle& serverHandle, const std::vector<uint8>& data)
+{
+	countSent(data.size());
+	networkingEngine_->send(serverHandle, data);
+}
+
+void CountingNetworkingEngine::send(const ServerHandle& serverHandle, const RemoteConnectionHandle& remoteConnectionHandle, const std::vector<uint8>& data)
+{
+	countSent(data.size());
+	networkingEngine_->send(serverHandle, remoteConnectionHandle, data);
+}
+
+void CountingNetworkingEngine::send(const ClientHandle& clientHandle, const std::vector<uint8>& data)
+{
+	countSent(data.size());
+	networkingEngine_->send(clientHandle, data);
+}
+
+void CountingNetworkingEngine::send(const ServerHandle& serverHandle, MessageBuffer data)
+{
+	countSent(data.size());
+	networkingEngine_->send(serverHandle, std::move(data));
+}
+
+void CountingNetworkingEngine::send(const ServerHandle& serverHandle, const RemoteConnectionHandle& remoteConnectionHandle, MessageBuffer data)
+{
+	countSent(data.size());
+	networkingEngine_->send(serverHandle, remoteConnectionHandle, std::move(data));
+}
+
+void CountingNetworkingEngine::send(const ClientHandle& clientHandle, MessageBuffer data)
+{
+	countSent(data.size());
+	networkingEngine_->send(clientHandle, std::move(data));
+}
+
+void CountingNetworkingEngine::send(const ServerHandle& serverHandle, MessageBuffer data, const Channel channel)
+{
+	countSent(data.size());
+	networkingEngine_->send(serverHandle, std::move(data), channel);
+}
+
+void CountingNetworkingEngine::send(const ServerHandle& serverHandle, const RemoteConnectionHandle& remoteConnectionHandle, MessageBuffer data, const Channel channel)
+{
+	countSent(data.size());
+	networkingEngine_->send(serverHandle, remoteConnectionHandle, std::move(data), channel);
+}
+
+void CountingNetworkingEngine::send(const ClientHandle& clientHandle, MessageBuffer data, const Channel channel)
+{
+	countSent(data.size());
+	networkingEngine_->send(clientHandle, std::move(data), channel);
+}
+
+void CountingNetworkingEngine::processEvents()
+{
+	networkingEngine_->processEvents();
+}
+
+void CountingNetworkingEngine::addEventListener(networking::IEventListener* eventListener)
+{
+	eventListeners_.push_back(eventListener);
+}
+
+void CountingNetworkingEngine::removeEventListener(networking::IEventListener* eventListener)
+{
+	eventListeners_.erase(std::remove(eventListeners_.begin(), eventListeners_.end(), eventListener), eventListeners_.end());
+}
+
+bool CountingNetworkingEngine::processEvent(const ConnectEvent& event)
+{
+	for (auto eventListener : eventListeners_)
+	{
+		eventListener->processEvent(event);
+	}
+
+	return false;
+}
+
+bool CountingNetworkingEngine::processEvent(const DisconnectEvent& event)
+{
+	for (auto eventListener : eventListeners_)
+	{
+		eventListener->processEvent(event);
+	}
+
+	return false;
+}
+
+bool CountingNetworkingEngine::processEvent(const MessageEvent& event)
+{
+	static auto& bytesReceived = Metrics::instance().counter("networking.bytes_received");
+	bytesReceived.increment(event.message.size());
+
+	for (auto eventListener : eventListeners_)
+	{
+		eventListener->processEvent(event);
+	}
+
+	return false;
+}
+
+}
+}
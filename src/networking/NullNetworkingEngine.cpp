@@ -0,0 +1,72 @@
+#include "networking/NullNetworkingEngine.hpp"
+
+namespace ice_engine
+{
+namespace networking
+{
+
+ServerHandle NullNetworkingEngine::createServer()
+{
+	return ServerHandle(nextIndex(), 1);
+}
+
+ClientHandle NullNetworkingEngine::createClient()
+{
+	return ClientHandle(nextIndex(), 1);
+}
+
+void NullNetworkingEngine::destroyServer(const ServerHandle& serverHandle)
+{
+}
+
+void NullNetworkingEngine::destroyClient(const ClientHandle& clientHandle)
+{
+}
+
+void NullNetworkingEngine::tick(const float32 delta)
+{
+}
+
+void NullNetworkingEngine::send(const ServerHandle& serverHandle, const std::vector<uint8>& data)
+{
+}
+
+void NullNetworkingEngine::send(const ServerHandle& serverHandle, const RemoteConnectionHandle& remoteConnectionHandle, const std::vector<uint8>& data)
+{
+}
+
+void NullNetworkingEngine::send(const ClientHandle& clientHandle, const std::vector<uint8>& data)
+{
+}
+
+void NullNetworkingEngine::send(const ServerHandle& serverHandle, MessageBuffer data)
+{
+}
+
+void NullNetworkingEngine::send(const ServerHandle& serverHandle, const RemoteConnectionHandle& remoteConnectionHandle, MessageBuffer data)
+{
+}
+
+void NullNetworkingEngine::send(const ClientHandle& clientHandle, MessageBuffer data)
+{
+}
+
+void NullNetworkingEngine::processEvents()
+{
+}
+
+void NullNetworkingEngine::addEventListener(IEventListener* eventListener)
+{
+}
+
+void NullNetworkingEngine::removeEventListener(IEventListener* eventListener)
+{
+}
+
+uint32 NullNetworkingEngine::nextIndex()
+{
+	return nextIndex_.fetch_add(1, std::memory_order_relaxed);
+}
+
+}
+}
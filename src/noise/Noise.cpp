@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <vector>
+#include <future>
+
+#include "noise/Noise.hpp"
+#include "noise/detail/NoiseKernel.hpp"
+
+#include "IThreadPool.hpp"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace ice_engine
+{
+namespace noise
+{
+
+namespace detail
+{
+
+bool cpuSupportsSse41()
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	int info[4];
+	__cpuid(info, 1);
+
+	return (info[2] & (1 << 19)) != 0;
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+	return __builtin_cpu_supports("sse4.1");
+#else
+	return false;
+#endif
+}
+
+bool cpuSupportsAvx2()
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	int info[4];
+	__cpuid(info, 1);
+
+	// The os has to save the ymm registers too
+	const bool osxsave = (info[2] & (1 << 27)) != 0;
+	const bool avx = (info[2] & (1 << 28)) != 0;
+	if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) return false;
+
+	__cpuidex(info, 7, 0);
+
+	return (info[1] & (1 << 5)) != 0;
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+	return __builtin_cpu_supports("avx2");
+#else
+	return false;
+#endif
+}
+
+}
+
+namespace
+{
+
+static_assert(sizeof(FN_DECIMAL) == sizeof(float32), "The noise kernels only support FastNoise built with floats.");
+
+// Fewer rows than this aren't worth posting to the thread pool
+const uint32 MINIMUM_ROWS_PER_TASK = 16;
+
+detail::FillGridFunction fillGridFunction()
+{
+	static const detail::FillGridFunction function = []() -> detail::FillGridFunction {
+		if (detail::AVX2_KERNEL_AVAILABLE && detail::cpuSupportsAvx2()) return detail::fillGridAvx2;
+		if (detail::SSE41_KERNEL_AVAILABLE && detail::cpuSupportsSse41()) return detail::fillGridSse41;
+
+		return nullptr;
+	}();
+
+	return function;
+}
+
+}
+
+void Noise::fillGrid(float32* out, const glm::vec2& origin, const glm::vec2& step, const uint32 width, const uint32 height, IThreadPool* threadPool) const
+{
+	if (width == 0 || height == 0) return;
+
+	const uint32 numberOfWorkers = threadPool == nullptr ? 0 : threadPool->getActiveWorkerCount() + threadPool->getInactiveWorkerCount();
+
+	if (numberOfWorkers < 2 || height < 2 * MINIMUM_ROWS_PER_TASK)
+	{
+		fillRows(out, origin, step, width, 0, height);
+		return;
+	}
+
+	// A few tasks per worker, so one slow worker doesn't hold up the rest
+	const uint32 numberOfTasks = std::min(numberOfWorkers * 4, height / MINIMUM_ROWS_PER_TASK);
+	const uint32 rowsPerTask = (height + numberOfTasks - 1) / numberOfTasks;
+
+	std::vector<std::future<void>> futures;
+	futures.reserve(numberOfTasks);
+
+	for (uint32 rowBegin = 0; rowBegin < height; rowBegin += rowsPerTask)
+	{
+		const uint32 rowEnd = std::min(rowBegin + rowsPerTask, height);
+
+		futures.push_back(threadPool->postWork([this, out, origin, step, width, rowBegin, rowEnd]() {
+			fillRows(out, origin, step, width, rowBegin, rowEnd);
+		}));
+	}
+
+	for (auto& future : futures)
+	{
+		future.get();
+	}
+}
+
+void Noise::fillRows(float32* out, const glm::vec2& origin, const glm::vec2& step, const uint32 width, const uint32 rowBegin, const uint32 rowEnd) const
+{
+	const detail::FillGridFunction function = fillGridFunction();
+
+	if (function != nullptr)
+	{
+		detail::GridParameters parameters;
+
+		const unsigned char* perm = noise_.GetPermutationTable();
+		const unsigned char* perm12 = noise_.GetPermutationTable12();
+
+		for (uint32 i = 0; i < 512; ++i)
+		{
+			parameters.perm[i] = perm[i];
+			parameters.perm12[i] = perm12[i];
+		}
+
+		parameters.valueLookupTable = FastNoise::GetValueLookupTable();
+		parameters.gradientTableX = FastNoise::GetGradientTableX();
+		parameters.gradientTableY = FastNoise::GetGradientTableY();
+
+		parameters.noiseType = noise_.GetNoiseType();
+		parameters.fractalType = noise_.GetFractalType();
+		parameters.interpolation = noise_.GetInterp();
+
+		parameters.octaves = noise_.GetFractalOctaves();
+		parameters.frequency = noise_.GetFrequency();
+		parameters.lacunarity = noise_.GetFractalLacunarity();
+		parameters.gain = noise_.GetFractalGain();
+		parameters.fractalBounding = noise_.GetFractalBounding();
+
+		parameters.originX = origin.x;
+		parameters.originY = origin.y;
+		parameters.stepX = step.x;
+		parameters.stepY = step.y;
+		parameters.width = width;
+
+		if (function(parameters, out, rowBegin, rowEnd)) return;
+	}
+
+	for (uint32 j = rowBegin; j < rowEnd; ++j)
+	{
+		const float32 y = origin.y + static_cast<float32>(j) * step.y;
+
+		float32* row = out + static_cast<uint64>(j) * width;
+
+		for (uint32 i = 0; i < width; ++i)
+		{
+			row[i] = noise_.GetNoise(origin.x + static_cast<float32>(i) * step.x, y);
+		}
+	}
+}
+
+}
+}
@@ -0,0 +1,89 @@
+#include "noise/detail/NoiseKernel.hpp"
+
+#if defined(__AVX2__)
+#define ICEENGINE_NOISE_AVX2
+#include <immintrin.h>
+#endif
+
+#if defined(ICEENGINE_NOISE_AVX2)
+
+#include "noise/detail/NoiseKernel.inl"
+
+namespace ice_engine
+{
+namespace noise
+{
+namespace detail
+{
+
+namespace
+{
+
+struct Avx2Lanes
+{
+	typedef __m256 F;
+	typedef __m256i I;
+
+	static constexpr uint32 N = 8;
+
+	static F set(const float32 value) { return _mm256_set1_ps(value); }
+	static I seti(const int32 value) { return _mm256_set1_epi32(value); }
+	static I lanes() { return _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7); }
+
+	static F add(const F a, const F b) { return _mm256_add_ps(a, b); }
+	static F sub(const F a, const F b) { return _mm256_sub_ps(a, b); }
+	static F mul(const F a, const F b) { return _mm256_mul_ps(a, b); }
+	static F abs(const F a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+
+	static I addi(const I a, const I b) { return _mm256_add_epi32(a, b); }
+	static I subi(const I a, const I b) { return _mm256_sub_epi32(a, b); }
+	static I andi(const I a, const I b) { return _mm256_and_si256(a, b); }
+
+	static I truncate(const F a) { return _mm256_cvttps_epi32(a); }
+	static F toFloat(const I a) { return _mm256_cvtepi32_ps(a); }
+
+	static F lt(const F a, const F b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+	static F gt(const F a, const F b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+	static I maskToInt(const F mask) { return _mm256_castps_si256(mask); }
+	static F select(const F mask, const F a, const F b) { return _mm256_blendv_ps(b, a, mask); }
+
+	static I gather(const int32* table, const I index) { return _mm256_i32gather_epi32(table, index, 4); }
+	static F gatherf(const float32* table, const I index) { return _mm256_i32gather_ps(table, index, 4); }
+
+	static void store(float32* out, const F a) { _mm256_storeu_ps(out, a); }
+};
+
+}
+
+const bool AVX2_KERNEL_AVAILABLE = true;
+
+bool fillGridAvx2(const GridParameters& parameters, float32* out, const uint32 rowBegin, const uint32 rowEnd)
+{
+	return NoiseKernel<Avx2Lanes>::fillGrid(parameters, out, rowBegin, rowEnd);
+}
+
+}
+}
+}
+
+#else
+
+namespace ice_engine
+{
+namespace noise
+{
+namespace detail
+{
+
+const bool AVX2_KERNEL_AVAILABLE = false;
+
+bool fillGridAvx2(const GridParameters& parameters, float32* out, const uint32 rowBegin, const uint32 rowEnd)
+{
+	return false;
+}
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,106 @@
+#include "noise/detail/NoiseKernel.hpp"
+
+#if defined(__SSE4_1__) || (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)))
+#define ICEENGINE_NOISE_SSE41
+#include <smmintrin.h>
+#endif
+
+#if defined(ICEENGINE_NOISE_SSE41)
+
+#include "noise/detail/NoiseKernel.inl"
+
+namespace ice_engine
+{
+namespace noise
+{
+namespace detail
+{
+
+namespace
+{
+
+struct Sse41Lanes
+{
+	typedef __m128 F;
+	typedef __m128i I;
+
+	static constexpr uint32 N = 4;
+
+	static F set(const float32 value) { return _mm_set1_ps(value); }
+	static I seti(const int32 value) { return _mm_set1_epi32(value); }
+	static I lanes() { return _mm_setr_epi32(0, 1, 2, 3); }
+
+	static F add(const F a, const F b) { return _mm_add_ps(a, b); }
+	static F sub(const F a, const F b) { return _mm_sub_ps(a, b); }
+	static F mul(const F a, const F b) { return _mm_mul_ps(a, b); }
+	static F abs(const F a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+
+	static I addi(const I a, const I b) { return _mm_add_epi32(a, b); }
+	static I subi(const I a, const I b) { return _mm_sub_epi32(a, b); }
+	static I andi(const I a, const I b) { return _mm_and_si128(a, b); }
+
+	static I truncate(const F a) { return _mm_cvttps_epi32(a); }
+	static F toFloat(const I a) { return _mm_cvtepi32_ps(a); }
+
+	static F lt(const F a, const F b) { return _mm_cmplt_ps(a, b); }
+	static F gt(const F a, const F b) { return _mm_cmpgt_ps(a, b); }
+	static I maskToInt(const F mask) { return _mm_castps_si128(mask); }
+	static F select(const F mask, const F a, const F b) { return _mm_blendv_ps(b, a, mask); }
+
+	static I gather(const int32* table, const I index)
+	{
+		return _mm_setr_epi32(
+			table[_mm_extract_epi32(index, 0)],
+			table[_mm_extract_epi32(index, 1)],
+			table[_mm_extract_epi32(index, 2)],
+			table[_mm_extract_epi32(index, 3)]
+		);
+	}
+
+	static F gatherf(const float32* table, const I index)
+	{
+		return _mm_setr_ps(
+			table[_mm_extract_epi32(index, 0)],
+			table[_mm_extract_epi32(index, 1)],
+			table[_mm_extract_epi32(index, 2)],
+			table[_mm_extract_epi32(index, 3)]
+		);
+	}
+
+	static void store(float32* out, const F a) { _mm_storeu_ps(out, a); }
+};
+
+}
+
+const bool SSE41_KERNEL_AVAILABLE = true;
+
+bool fillGridSse41(const GridParameters& parameters, float32* out, const uint32 rowBegin, const uint32 rowEnd)
+{
+	return NoiseKernel<Sse41Lanes>::fillGrid(parameters, out, rowBegin, rowEnd);
+}
+
+}
+}
+}
+
+#else
+
+namespace ice_engine
+{
+namespace noise
+{
+namespace detail
+{
+
+const bool SSE41_KERNEL_AVAILABLE = false;
+
+bool fillGridSse41(const GridParameters& parameters, float32* out, const uint32 rowBegin, const uint32 rowEnd)
+{
+	return false;
+}
+
+}
+}
+}
+
+#endif
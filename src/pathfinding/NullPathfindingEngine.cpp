@@ -0,0 +1,117 @@
+#include "pathfinding/NullPathfindingEngine.hpp"
+
+namespace ice_engine
+{
+namespace pathfinding
+{
+
+void NullPathfindingEngine::tick(const PathfindingSceneHandle& pathfindingSceneHandle, const float32 delta)
+{
+}
+
+void NullPathfindingEngine::renderDebug(const PathfindingSceneHandle& pathfindingSceneHandle)
+{
+}
+
+PathfindingSceneHandle NullPathfindingEngine::createPathfindingScene()
+{
+	return PathfindingSceneHandle(nextIndex(), 1);
+}
+
+void NullPathfindingEngine::destroyPathfindingScene(const PathfindingSceneHandle& pathfindingSceneHandle)
+{
+}
+
+void NullPathfindingEngine::setPathfindingDebugRenderer(IPathfindingDebugRenderer* pathfindingDebugRenderer)
+{
+}
+
+void NullPathfindingEngine::setDebugRendering(const PathfindingSceneHandle& pathfindingSceneHandle, const bool enabled)
+{
+}
+
+PolygonMeshHandle NullPathfindingEngine::createPolygonMesh(const ITerrain* terrain, const PolygonMeshConfig& polygonMeshConfig)
+{
+	return PolygonMeshHandle(nextIndex(), 1);
+}
+
+void NullPathfindingEngine::destroy(const PolygonMeshHandle& polygonMeshHandle)
+{
+}
+
+ObstacleHandle NullPathfindingEngine::createObstacle(const PolygonMeshHandle& polygonMeshHandle, const glm::vec3& position, const float32 radius, const float32 height)
+{
+	return ObstacleHandle(nextIndex(), 1);
+}
+
+void NullPathfindingEngine::destroy(const PolygonMeshHandle& polygonMeshHandle, const ObstacleHandle& obstacleHandle)
+{
+}
+
+NavigationMeshHandle NullPathfindingEngine::createNavigationMesh(const PolygonMeshHandle& polygonMeshHandle, const NavigationMeshConfig& navigationMeshConfig)
+{
+	return NavigationMeshHandle(nextIndex(), 1);
+}
+
+void NullPathfindingEngine::destroy(const NavigationMeshHandle& navigationMeshHandle)
+{
+}
+
+CrowdHandle NullPathfindingEngine::createCrowd(const PathfindingSceneHandle& pathfindingSceneHandle, const NavigationMeshHandle& navigationMeshHandle, const CrowdConfig& crowdConfig)
+{
+	return CrowdHandle(nextIndex(), 1);
+}
+
+void NullPathfindingEngine::destroy(const PathfindingSceneHandle& pathfindingSceneHandle, const CrowdHandle& crowdHandle)
+{
+}
+
+AgentHandle NullPathfindingEngine::createAgent(const PathfindingSceneHandle& pathfindingSceneHandle, const CrowdHandle& crowdHandle, const glm::vec3& position, const AgentParams& agentParams, std::unique_ptr<IAgentMotionChangeListener> agentMotionChangeListener, std::unique_ptr<IAgentStateChangeListener> agentStateChangeListener, std::unique_ptr<IMovementRequestStateChangeListener> movementRequestStateChangeListener, const UserTag& userTag)
+{
+	return AgentHandle(nextIndex(), 1);
+}
+
+void NullPathfindingEngine::destroy(const PathfindingSceneHandle& pathfindingSceneHandle, const CrowdHandle& crowdHandle, const AgentHandle& agentHandle)
+{
+}
+
+void NullPathfindingEngine::requestMoveTarget(const PathfindingSceneHandle& pathfindingSceneHandle, const CrowdHandle& crowdHandle, const AgentHandle& agentHandle, const glm::vec3& position)
+{
+}
+
+void NullPathfindingEngine::resetMoveTarget(const PathfindingSceneHandle& pathfindingSceneHandle, const CrowdHandle& crowdHandle, const AgentHandle& agentHandle)
+{
+}
+
+void NullPathfindingEngine::requestMoveVelocity(const PathfindingSceneHandle& pathfindingSceneHandle, const CrowdHandle& crowdHandle, const AgentHandle& agentHandle, const glm::vec3& velocity)
+{
+}
+
+void NullPathfindingEngine::setMotionChangeListener(const PathfindingSceneHandle& pathfindingSceneHandle, const CrowdHandle& crowdHandle, const AgentHandle& agentHandle, std::unique_ptr<IAgentMotionChangeListener> agentMotionChangeListener)
+{
+}
+
+void NullPathfindingEngine::setStateChangeListener(const PathfindingSceneHandle& pathfindingSceneHandle, const CrowdHandle& crowdHandle, const AgentHandle& agentHandle, std::unique_ptr<IAgentStateChangeListener> agentStateChangeListener)
+{
+}
+
+void NullPathfindingEngine::setMovementRequestChangeListener(const PathfindingSceneHandle& pathfindingSceneHandle, const CrowdHandle& crowdHandle, const AgentHandle& agentHandle, std::unique_ptr<IMovementRequestStateChangeListener> movementRequestStateChangeListener)
+{
+}
+
+void NullPathfindingEngine::setUserTag(const PathfindingSceneHandle& pathfindingSceneHandle, const CrowdHandle& crowdHandle, const AgentHandle& agentHandle, const UserTag& userTag)
+{
+}
+
+UserTag NullPathfindingEngine::getUserTag(const PathfindingSceneHandle& pathfindingSceneHandle, const CrowdHandle& crowdHandle, const AgentHandle& agentHandle) const
+{
+	return UserTag();
+}
+
+uint32 NullPathfindingEngine::nextIndex()
+{
+	return nextIndex_.fetch_add(1, std::memory_order_relaxed);
+}
+
+}
+}
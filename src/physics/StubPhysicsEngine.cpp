@@ -0,0 +1,343 @@
+#include "physics/StubPhysicsEngine.hpp"
+
+#include "exceptions/RuntimeException.hpp"
+
+namespace ice_engine
+{
+namespace physics
+{
+
+void StubPhysicsEngine::tick(const PhysicsSceneHandle& physicsSceneHandle, const float32 delta)
+{
+	auto& scene = physicsScene(physicsSceneHandle);
+
+	for (auto& entry : scene.rigidBodies)
+	{
+		auto& body = *entry.second;
+
+		// Bodies without mass are static
+		if (body.mass <= 0.0f) continue;
+
+		body.velocity = body.velocity + scene.gravity * delta;
+		body.position = body.position + body.velocity * delta;
+
+		if (body.motionChangeListener) body.motionChangeListener->update(body.position, body.orientation);
+	}
+}
+
+void StubPhysicsEngine::renderDebug(const PhysicsSceneHandle& physicsSceneHandle)
+{
+}
+
+PhysicsSceneHandle StubPhysicsEngine::createPhysicsScene()
+{
+	return physicsScenes_.create();
+}
+
+void StubPhysicsEngine::destroy(const PhysicsSceneHandle& physicsSceneHandle)
+{
+	physicsScenes_.destroy(physicsSceneHandle);
+}
+
+void StubPhysicsEngine::setGravity(const PhysicsSceneHandle& physicsSceneHandle, const glm::vec3& gravity)
+{
+	physicsScene(physicsSceneHandle).gravity = gravity;
+}
+
+void StubPhysicsEngine::setPhysicsDebugRenderer(IPhysicsDebugRenderer* physicsDebugRenderer)
+{
+}
+
+void StubPhysicsEngine::setDebugRendering(const PhysicsSceneHandle& physicsSceneHandle, const bool enabled)
+{
+}
+
+CollisionShapeHandle StubPhysicsEngine::createStaticPlaneShape(const glm::vec3& planeNormal, const float32 planeConstant)
+{
+	return collisionShapes_.create();
+}
+
+CollisionShapeHandle StubPhysicsEngine::createStaticBoxShape(const glm::vec3& dimensions)
+{
+	return collisionShapes_.create();
+}
+
+CollisionShapeHandle StubPhysicsEngine::createStaticSphereShape(const float32 radius)
+{
+	return collisionShapes_.create();
+}
+
+CollisionShapeHandle StubPhysicsEngine::createStaticTerrainShape(const IHeightfield& heightfield)
+{
+	return collisionShapes_.create();
+}
+
+void StubPhysicsEngine::destroy(const CollisionShapeHandle& collisionShapeHandle)
+{
+	collisionShapes_.destroy(collisionShapeHandle);
+}
+
+void StubPhysicsEngine::destroyAllStaticShapes()
+{
+	collisionShapes_.clear();
+}
+
+RigidBodyObjectHandle StubPhysicsEngine::createRigidBodyObject(
+	const PhysicsSceneHandle& physicsSceneHandle,
+	const CollisionShapeHandle& collisionShapeHandle,
+	std::unique_ptr<IMotionChangeListener> motionStateListener,
+	const UserTag& userTag
+)
+{
+	return createRigidBodyObject(physicsSceneHandle, collisionShapeHandle, glm::vec3(0.0f), glm::quat(), 1.0f, 1.0f, 1.0f, std::move(motionStateListener), userTag);
+}
+
+RigidBodyObjectHandle StubPhysicsEngine::createRigidBodyObject(
+	const PhysicsSceneHandle& physicsSceneHandle,
+	const CollisionShapeHandle& collisionShapeHandle,
+	const float32 mass,
+	const float32 friction,
+	const float32 restitution,
+	std::unique_ptr<IMotionChangeListener> motionStateListener,
+	const UserTag& userTag
+)
+{
+	return createRigidBodyObject(physicsSceneHandle, collisionShapeHandle, glm::vec3(0.0f), glm::quat(), mass, friction, restitution, std::move(motionStateListener), userTag);
+}
+
+RigidBodyObjectHandle StubPhysicsEngine::createRigidBodyObject(
+	const PhysicsSceneHandle& physicsSceneHandle,
+	const CollisionShapeHandle& collisionShapeHandle,
+	const glm::vec3& position,
+	const glm::quat& orientation,
+	const float32 mass,
+	const float32 friction,
+	const float32 restitution,
+	std::unique_ptr<IMotionChangeListener> motionStateListener,
+	const UserTag& userTag
+)
+{
+	auto& scene = physicsScene(physicsSceneHandle);
+
+	auto body = std::make_unique<RigidBody>();
+	body->position = position;
+	body->orientation = orientation;
+	body->userTag = userTag;
+	body->mass = mass;
+	body->friction = friction;
+	body->restitution = restitution;
+	body->motionChangeListener = std::move(motionStateListener);
+
+	auto pointer = body.get();
+	scene.rigidBodies[pointer] = std::move(body);
+
+	return RigidBodyObjectHandle(pointer);
+}
+
+GhostObjectHandle StubPhysicsEngine::createGhostObject(const PhysicsSceneHandle& physicsSceneHandle, const CollisionShapeHandle& collisionShapeHandle, const UserTag& userTag)
+{
+	return createGhostObject(physicsSceneHandle, collisionShapeHandle, glm::vec3(0.0f), glm::quat(), userTag);
+}
+
+GhostObjectHandle StubPhysicsEngine::createGhostObject(
+	const PhysicsSceneHandle& physicsSceneHandle,
+	const CollisionShapeHandle& collisionShapeHandle,
+	const glm::vec3& position,
+	const glm::quat& orientation,
+	const UserTag& userTag
+)
+{
+	auto& scene = physicsScene(physicsSceneHandle);
+
+	auto ghost = std::make_unique<GhostObject>();
+	ghost->position = position;
+	ghost->orientation = orientation;
+	ghost->userTag = userTag;
+
+	auto pointer = ghost.get();
+	scene.ghostObjects[pointer] = std::move(ghost);
+
+	return GhostObjectHandle(pointer);
+}
+
+void StubPhysicsEngine::destroy(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle)
+{
+	physicsScene(physicsSceneHandle).rigidBodies.erase(static_cast<RigidBody*>(rigidBodyObjectHandle.get()));
+}
+
+void StubPhysicsEngine::destroy(const PhysicsSceneHandle& physicsSceneHandle, const GhostObjectHandle& ghostObjectHandle)
+{
+	physicsScene(physicsSceneHandle).ghostObjects.erase(static_cast<GhostObject*>(ghostObjectHandle.get()));
+}
+
+void StubPhysicsEngine::destroyAllRigidBodies()
+{
+	for (auto& scene : physicsScenes_)
+	{
+		scene.rigidBodies.clear();
+	}
+}
+
+void StubPhysicsEngine::setUserTag(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle, const UserTag& userTag)
+{
+	rigidBody(rigidBodyObjectHandle).userTag = userTag;
+}
+
+void StubPhysicsEngine::setUserTag(const PhysicsSceneHandle& physicsSceneHandle, const GhostObjectHandle& ghostObjectHandle, const UserTag& userTag)
+{
+	ghostObject(ghostObjectHandle).userTag = userTag;
+}
+
+UserTag StubPhysicsEngine::getUserTag(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle) const
+{
+	return rigidBody(rigidBodyObjectHandle).userTag;
+}
+
+UserTag StubPhysicsEngine::getUserTag(const PhysicsSceneHandle& physicsSceneHandle, const GhostObjectHandle& ghostObjectHandle) const
+{
+	return ghostObject(ghostObjectHandle).userTag;
+}
+
+Raycast StubPhysicsEngine::raycast(const PhysicsSceneHandle& physicsSceneHandle, const ray::Ray& ray)
+{
+	return Raycast(ray);
+}
+
+std::vector<boost::variant<RigidBodyObjectHandle, GhostObjectHandle>> StubPhysicsEngine::query(const PhysicsSceneHandle& physicsSceneHandle, const glm::vec3& origin, const std::vector<glm::vec3>& points)
+{
+	return {};
+}
+
+std::vector<boost::variant<RigidBodyObjectHandle, GhostObjectHandle>> StubPhysicsEngine::query(const PhysicsSceneHandle& physicsSceneHandle, const glm::vec3& origin, const float32 radius)
+{
+	std::vector<boost::variant<RigidBodyObjectHandle, GhostObjectHandle>> objects;
+
+	const auto& scene = physicsScene(physicsSceneHandle);
+
+	auto inside = [&origin, radius](const glm::vec3& position) {
+		const glm::vec3 offset = position - origin;
+		return offset.x * offset.x + offset.y * offset.y + offset.z * offset.z <= radius * radius;
+	};
+
+	for (const auto& entry : scene.rigidBodies)
+	{
+		if (inside(entry.second->position)) objects.push_back(RigidBodyObjectHandle(entry.first));
+	}
+
+	for (const auto& entry : scene.ghostObjects)
+	{
+		if (inside(entry.second->position)) objects.push_back(GhostObjectHandle(entry.first));
+	}
+
+	return objects;
+}
+
+void StubPhysicsEngine::setMotionChangeListener(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle, std::unique_ptr<IMotionChangeListener> motionStateListener)
+{
+	rigidBody(rigidBodyObjectHandle).motionChangeListener = std::move(motionStateListener);
+}
+
+void StubPhysicsEngine::rotation(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle, const glm::quat& orientation)
+{
+	rigidBody(rigidBodyObjectHandle).orientation = orientation;
+}
+
+glm::quat StubPhysicsEngine::rotation(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle) const
+{
+	return rigidBody(rigidBodyObjectHandle).orientation;
+}
+
+void StubPhysicsEngine::rotation(const PhysicsSceneHandle& physicsSceneHandle, const GhostObjectHandle& ghostObjectHandle, const glm::quat& orientation)
+{
+	ghostObject(ghostObjectHandle).orientation = orientation;
+}
+
+glm::quat StubPhysicsEngine::rotation(const PhysicsSceneHandle& physicsSceneHandle, const GhostObjectHandle& ghostObjectHandle) const
+{
+	return ghostObject(ghostObjectHandle).orientation;
+}
+
+void StubPhysicsEngine::position(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle, const float32 x, const float32 y, const float32 z)
+{
+	position(physicsSceneHandle, rigidBodyObjectHandle, glm::vec3(x, y, z));
+}
+
+void StubPhysicsEngine::position(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle, const glm::vec3& position)
+{
+	rigidBody(rigidBodyObjectHandle).position = position;
+}
+
+glm::vec3 StubPhysicsEngine::position(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle) const
+{
+	return rigidBody(rigidBodyObjectHandle).position;
+}
+
+void StubPhysicsEngine::position(const PhysicsSceneHandle& physicsSceneHandle, const GhostObjectHandle& ghostObjectHandle, const float32 x, const float32 y, const float32 z)
+{
+	position(physicsSceneHandle, ghostObjectHandle, glm::vec3(x, y, z));
+}
+
+void StubPhysicsEngine::position(const PhysicsSceneHandle& physicsSceneHandle, const GhostObjectHandle& ghostObjectHandle, const glm::vec3& position)
+{
+	ghostObject(ghostObjectHandle).position = position;
+}
+
+glm::vec3 StubPhysicsEngine::position(const PhysicsSceneHandle& physicsSceneHandle, const GhostObjectHandle& ghostObjectHandle) const
+{
+	return ghostObject(ghostObjectHandle).position;
+}
+
+void StubPhysicsEngine::mass(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle, const float32 mass)
+{
+	rigidBody(rigidBodyObjectHandle).mass = mass;
+}
+
+float32 StubPhysicsEngine::mass(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle) const
+{
+	return rigidBody(rigidBodyObjectHandle).mass;
+}
+
+void StubPhysicsEngine::friction(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle, const float32 friction)
+{
+	rigidBody(rigidBodyObjectHandle).friction = friction;
+}
+
+float32 StubPhysicsEngine::friction(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle) const
+{
+	return rigidBody(rigidBodyObjectHandle).friction;
+}
+
+void StubPhysicsEngine::restitution(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle, const float32 restitution)
+{
+	rigidBody(rigidBodyObjectHandle).restitution = restitution;
+}
+
+float32 StubPhysicsEngine::restitution(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle) const
+{
+	return rigidBody(rigidBodyObjectHandle).restitution;
+}
+
+StubPhysicsEngine::PhysicsScene& StubPhysicsEngine::physicsScene(const PhysicsSceneHandle& physicsSceneHandle) const
+{
+	auto scene = physicsScenes_.get(physicsSceneHandle);
+
+	if (scene == nullptr)
+	{
+		throw RuntimeException("Physics scene handle is not valid.");
+	}
+
+	return *scene;
+}
+
+StubPhysicsEngine::RigidBody& StubPhysicsEngine::rigidBody(const RigidBodyObjectHandle& rigidBodyObjectHandle)
+{
+	return *static_cast<RigidBody*>(rigidBodyObjectHandle.get());
+}
+
+StubPhysicsEngine::GhostObject& StubPhysicsEngine::ghostObject(const GhostObjectHandle& ghostObjectHandle)
+{
+	return *static_cast<GhostObject*>(ghostObjectHandle.get());
+}
+
+}
+}
@@ -0,0 +1,122 @@
+#include <cmath>
+#include <algorithm>
+
+#include "replication/EntityState.hpp"
+
+#include "exceptions/RuntimeException.hpp"
+
+#include "detail/Format.hpp"
+
+namespace ice_engine
+{
+namespace replication
+{
+
+namespace
+{
+
+// The three smallest components of a unit quaternion are within +-1/sqrt(2)
+const float32 ORIENTATION_RANGE = 0.70710678f;
+const uint32 ORIENTATION_BITS = 10;
+const uint32 ORIENTATION_MAXIMUM = (1 << ORIENTATION_BITS) - 1;
+
+}
+
+Quantizer::Quantizer(const float32 positionPrecision) : positionPrecision_(positionPrecision)
+{
+	if (positionPrecision_ <= 0.0f)
+	{
+		throw RuntimeException(detail::format("Position precision has to be positive - got %s.", positionPrecision_));
+	}
+}
+
+QuantizedEntityState Quantizer::quantize(const EntityState& entityState) const
+{
+	QuantizedEntityState quantizedEntityState;
+
+	quantizedEntityState.id = entityState.id;
+	quantizedEntityState.position[0] = static_cast<int32>(std::lround(entityState.position.x / positionPrecision_));
+	quantizedEntityState.position[1] = static_cast<int32>(std::lround(entityState.position.y / positionPrecision_));
+	quantizedEntityState.position[2] = static_cast<int32>(std::lround(entityState.position.z / positionPrecision_));
+	quantizedEntityState.orientation = quantize(entityState.orientation);
+	quantizedEntityState.custom = entityState.custom;
+
+	return quantizedEntityState;
+}
+
+EntityState Quantizer::dequantize(const QuantizedEntityState& quantizedEntityState) const
+{
+	EntityState entityState;
+
+	entityState.id = quantizedEntityState.id;
+	entityState.position = glm::vec3(
+		static_cast<float32>(quantizedEntityState.position[0]) * positionPrecision_,
+		static_cast<float32>(quantizedEntityState.position[1]) * positionPrecision_,
+		static_cast<float32>(quantizedEntityState.position[2]) * positionPrecision_
+	);
+	entityState.orientation = dequantizeOrientation(quantizedEntityState.orientation);
+	entityState.custom = quantizedEntityState.custom;
+
+	return entityState;
+}
+
+uint32 Quantizer::quantize(const glm::quat& orientation) const
+{
+	const float32 components[4] = {orientation.w, orientation.x, orientation.y, orientation.z};
+
+	uint32 largest = 0;
+	for (uint32 i = 1; i < 4; ++i)
+	{
+		if (std::abs(components[i]) > std::abs(components[largest])) largest = i;
+	}
+
+	// q and -q are the same rotation, so flip the sign to make the dropped component positive
+	const float32 sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+
+	uint32 packed = largest;
+
+	for (uint32 i = 0; i < 4; ++i)
+	{
+		if (i == largest) continue;
+
+		const float32 normalized = (components[i] * sign + ORIENTATION_RANGE) / (2.0f * ORIENTATION_RANGE);
+		const float32 clamped = normalized < 0.0f ? 0.0f : (normalized > 1.0f ? 1.0f : normalized);
+
+		packed = (packed << ORIENTATION_BITS) | static_cast<uint32>(std::lround(clamped * ORIENTATION_MAXIMUM));
+	}
+
+	return packed;
+}
+
+glm::quat Quantizer::dequantizeOrientation(const uint32 orientation) const
+{
+	const uint32 largest = orientation >> (ORIENTATION_BITS * 3);
+
+	float32 components[4];
+	float32 sumOfSquares = 0.0f;
+	uint32 shift = ORIENTATION_BITS * 3;
+
+	for (uint32 i = 0; i < 4; ++i)
+	{
+		if (i == largest) continue;
+
+		shift -= ORIENTATION_BITS;
+
+		const float32 normalized = static_cast<float32>((orientation >> shift) & ORIENTATION_MAXIMUM) / ORIENTATION_MAXIMUM;
+
+		components[i] = normalized * 2.0f * ORIENTATION_RANGE - ORIENTATION_RANGE;
+		sumOfSquares += components[i] * components[i];
+	}
+
+	components[largest] = std::sqrt(std::max(0.0f, 1.0f - sumOfSquares));
+
+	return glm::quat(components[0], components[1], components[2], components[3]);
+}
+
+float32 Quantizer::positionPrecision() const
+{
+	return positionPrecision_;
+}
+
+}
+}
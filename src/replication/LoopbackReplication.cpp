@@ -0,0 +1,103 @@
+#include <sstream>
+#include <iomanip>
+
+#include "replication/LoopbackReplication.hpp"
+
+#include "exceptions/RuntimeException.hpp"
+
+#include "detail/Format.hpp"
+
+namespace ice_engine
+{
+namespace replication
+{
+
+LoopbackReplication::LoopbackReplication(const uint32 numberOfClients, const ReplicationSettings& replicationSettings, const float32 packetLoss, const uint32 seed)
+	:
+	server_(&messageBufferPool_, replicationSettings),
+	clients_(numberOfClients, ReplicationClient(replicationSettings)),
+	packetLoss_(packetLoss),
+	generator_(seed),
+	distribution_(0.0f, 1.0f)
+{
+	for (ClientId clientId = 0; clientId < numberOfClients; ++clientId)
+	{
+		server_.addClient(clientId);
+	}
+}
+
+void LoopbackReplication::setFocus(const ClientId clientId, const glm::vec3& focus)
+{
+	server_.setFocus(clientId, focus);
+}
+
+void LoopbackReplication::tick(const std::vector<EntityState>& states, const float32 delta)
+{
+	time_ += delta;
+
+	server_.update(states, messages_);
+
+	for (auto& message : messages_)
+	{
+		if (dropped()) continue;
+
+		auto& c = clients_[message.first];
+
+		if (c.receive(message.second) && !dropped())
+		{
+			server_.receive(message.first, c.acknowledgement(messageBufferPool_));
+		}
+	}
+
+	messages_.clear();
+}
+
+uint32 LoopbackReplication::numberOfClients() const
+{
+	return static_cast<uint32>(clients_.size());
+}
+
+const ReplicationServer& LoopbackReplication::server() const
+{
+	return server_;
+}
+
+const ReplicationClient& LoopbackReplication::client(const ClientId clientId) const
+{
+	if (clientId >= clients_.size())
+	{
+		throw RuntimeException(detail::format("Replication client %s does not exist.", clientId));
+	}
+
+	return clients_[clientId];
+}
+
+float32 LoopbackReplication::bandwidth(const ClientId clientId) const
+{
+	if (time_ <= 0.0f) return 0.0f;
+
+	return static_cast<float32>(server_.statistics(clientId).bytes) / time_;
+}
+
+std::string LoopbackReplication::report() const
+{
+	std::stringstream ss;
+
+	for (ClientId clientId = 0; clientId < clients_.size(); ++clientId)
+	{
+		const auto& statistics = server_.statistics(clientId);
+
+		ss << "client " << clientId << ": " << std::fixed << std::setprecision(1) << bandwidth(clientId) << " bytes/s, "
+			<< statistics.messages << " messages, " << statistics.bytes << " bytes, " << statistics.entities << " entities" << std::endl;
+	}
+
+	return ss.str();
+}
+
+bool LoopbackReplication::dropped()
+{
+	return packetLoss_ > 0.0f && distribution_(generator_) < packetLoss_;
+}
+
+}
+}
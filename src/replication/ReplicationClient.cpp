@@ -0,0 +1,92 @@
+#include "replication/ReplicationClient.hpp"
+#include "replication/BitStream.hpp"
+
+namespace ice_engine
+{
+namespace replication
+{
+
+ReplicationClient::ReplicationClient(const ReplicationSettings& replicationSettings)
+	:
+	quantizer_(replicationSettings.positionPrecision),
+	snapshotHistory_(replicationSettings.snapshotHistory)
+{
+}
+
+bool ReplicationClient::receive(const networking::MessageBuffer& message)
+{
+	return receive(message.data(), message.size());
+}
+
+bool ReplicationClient::receive(const uint8* data, const size_t size)
+{
+	const uint32 messageSequence = replication::sequence(data, size);
+
+	if (messageSequence <= sequence()) return false;
+
+	const uint32 baseline = baselineSequence(data, size);
+	const Snapshot* baselineSnapshot = nullptr;
+
+	if (baseline != 0)
+	{
+		const auto it = snapshots_.find(baseline);
+
+		if (it == snapshots_.end()) return false;
+
+		baselineSnapshot = &it->second;
+	}
+
+	snapshots_[messageSequence] = decode(data, size, baselineSnapshot);
+
+	// The server only moves its baselines forward, so older snapshots won't be referenced again
+	snapshots_.erase(snapshots_.begin(), snapshots_.lower_bound(baseline));
+
+	while (snapshots_.size() > 1 && snapshots_.size() > snapshotHistory_)
+	{
+		snapshots_.erase(snapshots_.begin());
+	}
+
+	return true;
+}
+
+uint32 ReplicationClient::sequence() const
+{
+	return snapshots_.empty() ? 0 : snapshots_.rbegin()->first;
+}
+
+std::vector<EntityState> ReplicationClient::states() const
+{
+	std::vector<EntityState> result;
+	states(result);
+
+	return result;
+}
+
+void ReplicationClient::states(std::vector<EntityState>& states) const
+{
+	states.clear();
+
+	if (snapshots_.empty()) return;
+
+	const auto& entities = snapshots_.rbegin()->second.entities;
+
+	states.reserve(entities.size());
+
+	for (const auto& entity : entities)
+	{
+		states.push_back(quantizer_.dequantize(entity));
+	}
+}
+
+networking::MessageBuffer ReplicationClient::acknowledgement(networking::MessageBufferPool& messageBufferPool) const
+{
+	std::vector<uint8> data;
+
+	BitWriter writer(data);
+	writer.write(sequence(), 32);
+
+	return messageBufferPool.allocate(data);
+}
+
+}
+}
@@ -0,0 +1,184 @@
+#include <algorithm>
+
+#include "replication/ReplicationServer.hpp"
+#include "replication/BitStream.hpp"
+
+#include "exceptions/RuntimeException.hpp"
+
+#include "detail/Format.hpp"
+
+namespace ice_engine
+{
+namespace replication
+{
+
+ReplicationServer::ReplicationServer(networking::MessageBufferPool* messageBufferPool, const ReplicationSettings& replicationSettings)
+	:
+	messageBufferPool_(messageBufferPool),
+	replicationSettings_(replicationSettings),
+	quantizer_(replicationSettings.positionPrecision)
+{
+}
+
+void ReplicationServer::addClient(const ClientId clientId)
+{
+	if (!clients_.emplace(clientId, Client()).second)
+	{
+		throw RuntimeException(detail::format("Replication client %s already exists.", clientId));
+	}
+}
+
+void ReplicationServer::removeClient(const ClientId clientId)
+{
+	clients_.erase(clientId);
+}
+
+bool ReplicationServer::hasClient(const ClientId clientId) const
+{
+	return clients_.find(clientId) != clients_.end();
+}
+
+void ReplicationServer::setFocus(const ClientId clientId, const glm::vec3& focus)
+{
+	auto& c = client(clientId);
+
+	c.hasFocus = true;
+	c.focus = focus;
+}
+
+void ReplicationServer::acknowledge(const ClientId clientId, const uint32 sequence)
+{
+	auto& c = client(clientId);
+
+	// Acknowledgements can arrive out of order, and never for snapshots that weren't sent
+	if (sequence <= c.acknowledged || sequence > c.sequence) return;
+
+	c.acknowledged = sequence;
+
+	while (!c.history.empty() && c.history.front().sequence < sequence)
+	{
+		c.history.pop_front();
+	}
+}
+
+void ReplicationServer::receive(const ClientId clientId, const networking::MessageBuffer& message)
+{
+	BitReader reader(message.data(), message.size());
+
+	acknowledge(clientId, reader.read(32));
+}
+
+void ReplicationServer::update(const std::vector<EntityState>& states, std::vector<std::pair<ClientId, networking::MessageBuffer>>& messages)
+{
+	messages.clear();
+
+	states_.resize(states.size());
+	for (size_t i = 0; i < states.size(); ++i)
+	{
+		states_[i] = quantizer_.quantize(states[i]);
+	}
+
+	std::sort(states_.begin(), states_.end(), [](const QuantizedEntityState& a, const QuantizedEntityState& b) { return a.id < b.id; });
+
+	const bool filter = replicationSettings_.interestRadius > 0.0f;
+
+	if (filter) updateSpatialIndex(states);
+
+	for (auto& clientEntry : clients_)
+	{
+		auto& c = clientEntry.second;
+
+		Snapshot snapshot;
+		snapshot.sequence = ++c.sequence;
+
+		if (filter && c.hasFocus)
+		{
+			spatialIndexResults_.clear();
+			spatialIndex_.queryRadius(c.focus, replicationSettings_.interestRadius, spatialIndexResults_);
+
+			std::sort(spatialIndexResults_.begin(), spatialIndexResults_.end());
+
+			snapshot.entities.reserve(spatialIndexResults_.size());
+
+			for (const auto id : spatialIndexResults_)
+			{
+				const auto it = std::lower_bound(states_.begin(), states_.end(), id, [](const QuantizedEntityState& state, const SpatialIndex::Id id) { return state.id < id; });
+
+				if (it != states_.end() && it->id == id) snapshot.entities.push_back(*it);
+			}
+		}
+		else
+		{
+			snapshot.entities = states_;
+		}
+
+		const Snapshot* baseline = nullptr;
+
+		if (c.acknowledged != 0 && !c.history.empty() && c.history.front().sequence == c.acknowledged)
+		{
+			baseline = &c.history.front();
+		}
+
+		encode(snapshot, baseline, data_);
+
+		c.statistics.bytes += data_.size();
+		c.statistics.messages += 1;
+		c.statistics.entities = static_cast<uint32>(snapshot.entities.size());
+
+		messages.emplace_back(clientEntry.first, messageBufferPool_->allocate(data_));
+
+		c.history.push_back(std::move(snapshot));
+
+		// A client this far behind gets full snapshots until it acknowledges one of the recent ones
+		while (c.history.size() > replicationSettings_.snapshotHistory)
+		{
+			c.history.pop_front();
+		}
+	}
+}
+
+const ClientStatistics& ReplicationServer::statistics(const ClientId clientId) const
+{
+	return client(clientId).statistics;
+}
+
+ReplicationServer::Client& ReplicationServer::client(const ClientId clientId)
+{
+	auto it = clients_.find(clientId);
+
+	if (it == clients_.end())
+	{
+		throw RuntimeException(detail::format("Replication client %s does not exist.", clientId));
+	}
+
+	return it->second;
+}
+
+const ReplicationServer::Client& ReplicationServer::client(const ClientId clientId) const
+{
+	return const_cast<ReplicationServer*>(this)->client(clientId);
+}
+
+void ReplicationServer::updateSpatialIndex(const std::vector<EntityState>& states)
+{
+	// Entities barely move between updates, so most of these are just position updates
+	for (const auto& state : states)
+	{
+		spatialIndex_.update(state.id, state.position);
+	}
+
+	std::vector<uint32> ids;
+	ids.reserve(states_.size());
+
+	for (const auto& state : states_) ids.push_back(state.id);
+
+	for (const uint32 id : indexedIds_)
+	{
+		if (!std::binary_search(ids.begin(), ids.end(), id)) spatialIndex_.remove(id);
+	}
+
+	indexedIds_ = std::move(ids);
+}
+
+}
+}
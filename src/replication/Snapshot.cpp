@@ -0,0 +1,240 @@
+#include "replication/Snapshot.hpp"
+#include "replication/BitStream.hpp"
+
+#include "exceptions/RuntimeException.hpp"
+
+#include "detail/Format.hpp"
+
+namespace ice_engine
+{
+namespace replication
+{
+
+namespace
+{
+
+enum Changed : uint32
+{
+	CHANGED_POSITION = 1 << 0,
+	CHANGED_ORIENTATION = 1 << 1,
+	CHANGED_CUSTOM = 1 << 2
+};
+
+const uint32 CHANGED_BITS = 3;
+
+// New entities are encoded as a delta against this
+const QuantizedEntityState EMPTY_STATE;
+
+uint32 changes(const QuantizedEntityState& state, const QuantizedEntityState& baseline)
+{
+	uint32 changed = 0;
+
+	if (state.position[0] != baseline.position[0] || state.position[1] != baseline.position[1] || state.position[2] != baseline.position[2])
+	{
+		changed |= CHANGED_POSITION;
+	}
+	if (state.orientation != baseline.orientation) changed |= CHANGED_ORIENTATION;
+	if (state.custom != baseline.custom) changed |= CHANGED_CUSTOM;
+
+	return changed;
+}
+
+void writeChanges(BitWriter& writer, const QuantizedEntityState& state, const QuantizedEntityState& baseline, const uint32 changed)
+{
+	writer.write(changed, CHANGED_BITS);
+
+	if (changed & CHANGED_POSITION)
+	{
+		for (uint32 i = 0; i < 3; ++i)
+		{
+			writer.writeSigned(state.position[i] - baseline.position[i]);
+		}
+	}
+
+	if (changed & CHANGED_ORIENTATION) writer.write(state.orientation, 32);
+
+	if (changed & CHANGED_CUSTOM)
+	{
+		writer.writeVariable(static_cast<uint32>(state.custom.size()));
+
+		for (size_t i = 0; i < state.custom.size(); ++i)
+		{
+			const uint8 difference = state.custom[i] ^ (i < baseline.custom.size() ? baseline.custom[i] : 0);
+
+			writer.writeBool(difference != 0);
+			if (difference != 0) writer.write(difference, 8);
+		}
+	}
+}
+
+void readChanges(BitReader& reader, QuantizedEntityState& state)
+{
+	const uint32 changed = reader.read(CHANGED_BITS);
+
+	if (changed & CHANGED_POSITION)
+	{
+		for (uint32 i = 0; i < 3; ++i)
+		{
+			state.position[i] += reader.readSigned();
+		}
+	}
+
+	if (changed & CHANGED_ORIENTATION) state.orientation = reader.read(32);
+
+	if (changed & CHANGED_CUSTOM)
+	{
+		const uint32 size = reader.readVariable();
+
+		state.custom.resize(size, 0);
+
+		for (auto& byte : state.custom)
+		{
+			if (reader.readBool()) byte ^= static_cast<uint8>(reader.read(8));
+		}
+	}
+}
+
+}
+
+void encode(const Snapshot& snapshot, const Snapshot* baseline, std::vector<uint8>& data)
+{
+	static const std::vector<QuantizedEntityState> empty;
+
+	const auto& baselineEntities = baseline != nullptr ? baseline->entities : empty;
+
+	BitWriter writer(data);
+
+	writer.write(snapshot.sequence, 32);
+	writer.write(baseline != nullptr ? baseline->sequence : 0, 32);
+
+	// Both lists are sorted by id, so one pass over each finds the removed entities, and another the changed ones
+	std::vector<uint32> removed;
+
+	auto it = snapshot.entities.begin();
+	for (const auto& baselineEntity : baselineEntities)
+	{
+		while (it != snapshot.entities.end() && it->id < baselineEntity.id) ++it;
+
+		if (it == snapshot.entities.end() || it->id != baselineEntity.id) removed.push_back(baselineEntity.id);
+	}
+
+	writer.writeVariable(static_cast<uint32>(removed.size()));
+
+	uint32 previousId = 0;
+	for (const uint32 id : removed)
+	{
+		writer.writeVariable(id - previousId);
+		previousId = id;
+	}
+
+	// The count of changed entities isn't known up front, so each entry starts with a continuation bit instead
+	previousId = 0;
+	auto baselineIt = baselineEntities.begin();
+
+	for (const auto& entity : snapshot.entities)
+	{
+		while (baselineIt != baselineEntities.end() && baselineIt->id < entity.id) ++baselineIt;
+
+		const QuantizedEntityState& baselineEntity = (baselineIt != baselineEntities.end() && baselineIt->id == entity.id) ? *baselineIt : EMPTY_STATE;
+		const bool isNew = (&baselineEntity == &EMPTY_STATE);
+
+		const uint32 changed = changes(entity, baselineEntity);
+
+		if (changed == 0 && !isNew) continue;
+
+		writer.writeBool(true);
+		writer.writeVariable(entity.id - previousId);
+		previousId = entity.id;
+
+		writeChanges(writer, entity, baselineEntity, changed);
+	}
+
+	writer.writeBool(false);
+}
+
+uint32 sequence(const uint8* data, const size_t size)
+{
+	BitReader reader(data, size);
+
+	return reader.read(32);
+}
+
+uint32 baselineSequence(const uint8* data, const size_t size)
+{
+	BitReader reader(data, size);
+	reader.read(32);
+
+	return reader.read(32);
+}
+
+Snapshot decode(const uint8* data, const size_t size, const Snapshot* baseline)
+{
+	BitReader reader(data, size);
+
+	Snapshot snapshot;
+	snapshot.sequence = reader.read(32);
+
+	const uint32 baselineSequence = reader.read(32);
+
+	if (baselineSequence != (baseline != nullptr ? baseline->sequence : 0))
+	{
+		throw RuntimeException(detail::format("Snapshot %s was encoded against snapshot %s, not %s.", snapshot.sequence, baselineSequence, (baseline != nullptr ? baseline->sequence : 0)));
+	}
+
+	std::vector<uint32> removed(reader.readVariable());
+
+	uint32 id = 0;
+	for (auto& removedId : removed)
+	{
+		id += reader.readVariable();
+		removedId = id;
+	}
+
+	if (baseline != nullptr)
+	{
+		snapshot.entities.reserve(baseline->entities.size());
+
+		auto removedIt = removed.begin();
+		for (const auto& entity : baseline->entities)
+		{
+			while (removedIt != removed.end() && *removedIt < entity.id) ++removedIt;
+
+			if (removedIt == removed.end() || *removedIt != entity.id) snapshot.entities.push_back(entity);
+		}
+	}
+
+	// Changes come in id order, so apply them while merging with the baseline's entities
+	std::vector<QuantizedEntityState> entities;
+	entities.reserve(snapshot.entities.size());
+
+	auto it = snapshot.entities.begin();
+	id = 0;
+
+	while (reader.readBool())
+	{
+		id += reader.readVariable();
+
+		while (it != snapshot.entities.end() && it->id < id) entities.push_back(std::move(*it++));
+
+		if (it != snapshot.entities.end() && it->id == id)
+		{
+			entities.push_back(std::move(*it++));
+		}
+		else
+		{
+			entities.push_back(EMPTY_STATE);
+			entities.back().id = id;
+		}
+
+		readChanges(reader, entities.back());
+	}
+
+	while (it != snapshot.entities.end()) entities.push_back(std::move(*it++));
+
+	snapshot.entities = std::move(entities);
+
+	return snapshot;
+}
+
+}
+}
@@ -20,6 +20,8 @@
 #include "scripting/angel_script/AngelscriptCPreProcessor.hpp"
 
 #include "Platform.hpp"
+#include "Profiler.hpp"
+#include "Metrics.hpp"
 
 namespace ice_engine
 {
@@ -622,6 +624,11 @@ void ScriptingEngine::setArguments(asIScriptContext* context, ParameterList& arg
 
 asIScriptObject* ScriptingEngine::callFunctionWithReturnValue(asIScriptContext* context, asIScriptFunction* function)
 {
+    PROFILE_ZONE("ScriptingEngine::callFunctionWithReturnValue");
+
+    static auto& calls = Metrics::instance().counter("scripting.calls");
+    calls.increment();
+
     assert(function->GetParamCount() == 0);
 
     if (context->GetState() == asEContextState::asEXECUTION_ACTIVE)
@@ -666,6 +673,11 @@ asIScriptObject* ScriptingEngine::callFunctionWithReturnValue(asIScriptContext*
 
 void ScriptingEngine::callFunction(asIScriptContext* context, asIScriptFunction* function, asIScriptObject* object)
 {
+	PROFILE_ZONE("ScriptingEngine::callFunction");
+
+	static auto& calls = Metrics::instance().counter("scripting.calls");
+	calls.increment();
+
 	assert(function->GetParamCount() == 0);
 
 	if (context->GetState() == asEContextState::asEXECUTION_ACTIVE)
@@ -712,6 +724,8 @@ void ScriptingEngine::callFunction(asIScriptContext* context, asIScriptFunction*
 
 void ScriptingEngine::callFunction(asIScriptContext* context, asIScriptFunction* function, asIScriptObject* object, ParameterList& arguments)
 {
+	PROFILE_ZONE("ScriptingEngine::callFunction");
+
 	assert(function->GetParamCount() == arguments.size());
 
 	if (context->GetState() == asEContextState::asEXECUTION_ACTIVE)
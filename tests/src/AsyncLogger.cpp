@@ -0,0 +1,191 @@
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <cstdio>
+#include <cstring>
+
+#define BOOST_TEST_MODULE AsyncLogger
+#include <boost/test/unit_test.hpp>
+
+#include "logger/AsyncLogger.hpp"
+
+using namespace ice_engine;
+using namespace ice_engine::logger;
+
+namespace
+{
+
+struct Point
+{
+    int x;
+    int y;
+};
+
+std::ostream& operator<<(std::ostream& stream, const Point& point)
+{
+    return stream << "(" << point.x << ", " << point.y << ")";
+}
+
+class RecordingLogger : public ILogger
+{
+public:
+    RecordingLogger(std::vector<std::string>& messages, std::atomic<bool>& open) : messages_(messages), open_(open)
+    {
+    }
+
+    void info(const std::string& message) override { add("INFO " + message); }
+    void debug(const std::string& message) override { add("DEBUG " + message); }
+    void trace(const std::string& message) override { add("TRACE " + message); }
+    void warn(const std::string& message) override { add("WARN " + message); }
+    void error(const std::string& message) override { add("ERROR " + message); }
+    void fatal(const std::string& message) override { add("FATAL " + message); }
+
+    void info(const std::wstring& message) override {}
+    void debug(const std::wstring& message) override {}
+    void trace(const std::wstring& message) override {}
+    void warn(const std::wstring& message) override {}
+    void error(const std::wstring& message) override {}
+    void fatal(const std::wstring& message) override {}
+
+private:
+    std::vector<std::string>& messages_;
+    std::atomic<bool>& open_;
+
+    void add(const std::string& message)
+    {
+        // Holds up the background thread until the test lets it through
+        while (!open_.load()) std::this_thread::yield();
+
+        messages_.push_back(message);
+    }
+};
+
+AsyncLoggerSettings createAsyncLoggerSettings(const bool block)
+{
+    AsyncLoggerSettings asyncLoggerSettings;
+    asyncLoggerSettings.queueSize = 8;
+    asyncLoggerSettings.block = block;
+
+    return asyncLoggerSettings;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(logRecord_MatchesFormat)
+{
+    const std::string name = "name";
+    const Point point = {1, -2};
+
+    const LogRecord record(LOG_LEVEL_INFO, "function", 10, "%s %s %s %s %s %s %s %s %s %d", -3, 4u, 0.5f, 0.25, true, 'c', "text", name, point, -(int64_t(1) << 40));
+    BOOST_CHECK_EQUAL(record.message(), "function line 10: " + detail::format("%s %s %s %s %s %s %s %s %s %d", -3, 4u, 0.5f, 0.25, true, 'c', "text", name, point, -(int64_t(1) << 40)));
+
+    // A message built at run time is copied
+    std::unique_ptr<LogRecord> runtime;
+    {
+        const std::string message = std::string("Exception: ") + "%s";
+        runtime = std::make_unique<LogRecord>(LOG_LEVEL_ERROR, "function", 11, message, std::string(200, 'x'));
+    }
+    BOOST_CHECK_EQUAL(runtime->message(), "function line 11: Exception: " + std::string(200, 'x'));
+
+    BOOST_CHECK_EQUAL(LogRecord(LOG_LEVEL_WARN, "100% as is").message(), "100% as is");
+}
+
+BOOST_AUTO_TEST_CASE(write_InOrderAfterFlush)
+{
+    std::vector<std::string> messages;
+    std::atomic<bool> open{true};
+
+    AsyncLogger asyncLogger(std::make_unique<RecordingLogger>(messages, open), createAsyncLoggerSettings(true));
+    AsyncLogger* logger = &asyncLogger;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        LOG_INFO(logger, "message %s", i);
+    }
+    LOG_WARN(logger, "done");
+
+    asyncLogger.flush();
+
+    BOOST_REQUIRE_EQUAL(messages.size(), 101u);
+    BOOST_CHECK(messages[42].find("INFO") == 0);
+    BOOST_CHECK(messages[42].find(": message 42") != std::string::npos);
+    BOOST_CHECK(messages[100].find("WARN") == 0);
+    BOOST_CHECK_EQUAL(asyncLogger.droppedRecords(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(write_FullQueueDrops)
+{
+    std::vector<std::string> messages;
+    std::atomic<bool> open{false};
+
+    {
+        AsyncLogger asyncLogger(std::make_unique<RecordingLogger>(messages, open), createAsyncLoggerSettings(false));
+        AsyncLogger* logger = &asyncLogger;
+
+        // The background thread holds on to at most one record, the queue takes 8 more
+        for (int i = 0; i < 20; ++i)
+        {
+            LOG_INFO(logger, "message %s", i);
+        }
+
+        BOOST_CHECK_GE(asyncLogger.droppedRecords(), 11u);
+        BOOST_CHECK_LE(asyncLogger.droppedRecords(), 12u);
+
+        open.store(true);
+        asyncLogger.flush();
+    }
+
+    // Everything kept is written on destruction, followed by how many were dropped
+    BOOST_CHECK_GE(messages.size(), 9u);
+    BOOST_CHECK(messages.back().find("WARN Log queue full") == 0);
+}
+
+BOOST_AUTO_TEST_CASE(write_FullQueueBlocks)
+{
+    std::vector<std::string> messages;
+    std::atomic<bool> open{false};
+
+    AsyncLogger asyncLogger(std::make_unique<RecordingLogger>(messages, open), createAsyncLoggerSettings(true));
+    AsyncLogger* logger = &asyncLogger;
+
+    std::thread opener([&open]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        open.store(true);
+    });
+
+    for (int i = 0; i < 20; ++i)
+    {
+        LOG_INFO(logger, "message %s", i);
+    }
+
+    opener.join();
+    asyncLogger.flush();
+
+    BOOST_CHECK_EQUAL(messages.size(), 20u);
+    BOOST_CHECK_EQUAL(asyncLogger.droppedRecords(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(write_FormatFromStackBuffer)
+{
+    std::vector<std::string> messages;
+    std::atomic<bool> open{false};
+
+    AsyncLogger asyncLogger(std::make_unique<RecordingLogger>(messages, open), createAsyncLoggerSettings(true));
+    AsyncLogger* logger = &asyncLogger;
+
+    // The background thread is held up, so the buffer is gone and overwritten before it formats the record
+    {
+        char format[32];
+        std::snprintf(format, sizeof(format), "stack %d %%s", 1);
+        LOG_INFO(logger, format, 2);
+        std::memset(format, 'x', sizeof(format) - 1);
+    }
+
+    open.store(true);
+    asyncLogger.flush();
+
+    BOOST_REQUIRE_EQUAL(messages.size(), 1u);
+    BOOST_CHECK(messages[0].find(": stack 1 2") != std::string::npos);
+}
@@ -0,0 +1,78 @@
+#include <cmath>
+#include <random>
+
+#define BOOST_TEST_MODULE BakedAnimation
+#include <boost/test/unit_test.hpp>
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "BakedAnimation.hpp"
+
+using ice_engine::BakedAnimation;
+using ice_engine::uint16;
+
+namespace
+{
+
+// 1 for the same rotation - q and -q count as the same
+float angularSimilarity(const glm::quat& a, const glm::quat& b)
+{
+    return std::abs(a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w);
+}
+
+glm::quat roundTrip(const glm::quat& quaternion)
+{
+    uint16 compressed[3] = {0, 0, 0};
+    BakedAnimation::compress(quaternion, compressed);
+
+    return BakedAnimation::decompress(compressed);
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(compress_RoundTripAxes)
+{
+    // Each component is the largest (and dropped) one in turn, with both signs
+    const glm::quat quaternions[] = {
+        glm::quat(1.0f, 0.0f, 0.0f, 0.0f),
+        glm::quat(0.0f, 1.0f, 0.0f, 0.0f),
+        glm::quat(0.0f, 0.0f, 1.0f, 0.0f),
+        glm::quat(0.0f, 0.0f, 0.0f, 1.0f),
+        glm::quat(-1.0f, 0.0f, 0.0f, 0.0f),
+        glm::quat(0.0f, 0.0f, -1.0f, 0.0f)
+    };
+
+    for (const auto& quaternion : quaternions)
+    {
+        const auto result = roundTrip(quaternion);
+
+        BOOST_CHECK_CLOSE(angularSimilarity(quaternion, result), 1.0f, 0.001f);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(compress_RoundTripRandom)
+{
+    std::mt19937 generator(1234);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        glm::quat quaternion(distribution(generator), distribution(generator), distribution(generator), distribution(generator));
+
+        const float length = std::sqrt(quaternion.x * quaternion.x + quaternion.y * quaternion.y + quaternion.z * quaternion.z + quaternion.w * quaternion.w);
+        if (length < 0.01f) continue;
+
+        quaternion = glm::quat(quaternion.w / length, quaternion.x / length, quaternion.y / length, quaternion.z / length);
+
+        const auto result = roundTrip(quaternion);
+
+        // The result is unit length
+        BOOST_REQUIRE_CLOSE(angularSimilarity(result, result), 1.0f, 0.01f);
+
+        // 15 bits per component keeps the rotation within about a tenth of a degree
+        const float angle = 2.0f * std::acos(std::min(1.0f, angularSimilarity(quaternion, result)));
+        BOOST_REQUIRE_LT(angle, 0.002f);
+    }
+}
@@ -0,0 +1,316 @@
+#include <vector>
+#include <memory>
+#include <random>
+
+#define BOOST_TEST_MODULE BatchingNetworkingEngine
+#include <boost/test/unit_test.hpp>
+
+#include "networking/BatchingNetworkingEngine.hpp"
+#include "networking/CountingNetworkingEngine.hpp"
+
+#include "Metrics.hpp"
+
+namespace
+{
+
+using namespace ice_engine;
+using namespace ice_engine::networking;
+
+struct Sent
+{
+    uint64 handle;
+    uint64 remoteConnection;
+    Channel channel;
+    MessageBuffer data;
+};
+
+/**
+ * Records what is sent, and delivers events to its listeners on demand.
+ */
+class RecordingNetworkingEngine : public INetworkingEngine
+{
+public:
+    std::vector<Sent>* sent;
+    IEventListener* eventListener = nullptr;
+
+    RecordingNetworkingEngine(std::vector<Sent>* sent) : sent(sent) {}
+
+    ServerHandle createServer() override { return ServerHandle(1, 1); }
+    ClientHandle createClient() override { return ClientHandle(2, 1); }
+    void destroyServer(const ServerHandle&) override {}
+    void destroyClient(const ClientHandle&) override {}
+    void tick(const float32) override {}
+
+    void send(const ServerHandle&, const std::vector<uint8>&) override { BOOST_FAIL("Unbatched send"); }
+    void send(const ServerHandle&, const RemoteConnectionHandle&, const std::vector<uint8>&) override { BOOST_FAIL("Unbatched send"); }
+    void send(const ClientHandle&, const std::vector<uint8>&) override { BOOST_FAIL("Unbatched send"); }
+
+    void send(const ServerHandle& serverHandle, MessageBuffer data, const Channel channel) override
+    {
+        sent->push_back(Sent{serverHandle.id(), 0, channel, std::move(data)});
+    }
+
+    void send(const ServerHandle& serverHandle, const RemoteConnectionHandle& remoteConnectionHandle, MessageBuffer data, const Channel channel) override
+    {
+        sent->push_back(Sent{serverHandle.id(), remoteConnectionHandle.id(), channel, std::move(data)});
+    }
+
+    void send(const ClientHandle& clientHandle, MessageBuffer data, const Channel channel) override
+    {
+        sent->push_back(Sent{clientHandle.id(), 0, channel, std::move(data)});
+    }
+
+    void processEvents() override {}
+    void addEventListener(IEventListener* listener) override { eventListener = listener; }
+    void removeEventListener(IEventListener*) override { eventListener = nullptr; }
+};
+
+class RecordingEventListener : public IEventListener
+{
+public:
+    std::vector<std::vector<uint8>> messages;
+
+    bool processEvent(const ConnectEvent&) override { return false; }
+    bool processEvent(const DisconnectEvent&) override { return false; }
+    bool processEvent(const MessageEvent& event) override
+    {
+        messages.push_back(event.message.toVector());
+        return false;
+    }
+};
+
+std::vector<uint8> createMessage(const size_t size, const uint8 value)
+{
+    return std::vector<uint8>(size, value);
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(tick_BatchesPerConnection)
+{
+    std::vector<Sent> sent;
+    auto recordingNetworkingEngine = std::make_unique<RecordingNetworkingEngine>(&sent);
+
+    BatchingSettings batchingSettings;
+    batchingSettings.compression = false;
+
+    BatchingNetworkingEngine batchingNetworkingEngine(std::move(recordingNetworkingEngine), nullptr, batchingSettings);
+
+    const ServerHandle serverHandle(1, 1);
+    const RemoteConnectionHandle a(10, 1);
+    const RemoteConnectionHandle b(11, 1);
+
+    for (uint8 i = 0; i < 50; ++i)
+    {
+        batchingNetworkingEngine.send(serverHandle, a, createMessage(10, i));
+        batchingNetworkingEngine.send(serverHandle, b, createMessage(10, i));
+    }
+
+    BOOST_CHECK(sent.empty());
+
+    batchingNetworkingEngine.tick(0.016f);
+
+    // 50 messages of 11 bytes each fit in a single batch per connection
+    BOOST_REQUIRE_EQUAL(sent.size(), 2u);
+    BOOST_CHECK_EQUAL(batchingNetworkingEngine.batches(), 2u);
+    BOOST_CHECK_EQUAL(batchingNetworkingEngine.messages(), 100u);
+
+    std::vector<MessageBuffer> messages;
+    MessageBufferPool messageBufferPool;
+    BatchingNetworkingEngine::unpack(sent[0].data.data(), sent[0].data.size(), messageBufferPool, messages);
+
+    BOOST_REQUIRE_EQUAL(messages.size(), 50u);
+    for (uint8 i = 0; i < 50; ++i)
+    {
+        BOOST_CHECK(messages[i].toVector() == createMessage(10, i));
+    }
+
+    // Nothing new, nothing sent
+    batchingNetworkingEngine.tick(0.016f);
+    BOOST_CHECK_EQUAL(sent.size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(tick_SplitsAtMaxBatchSize)
+{
+    std::vector<Sent> sent;
+
+    BatchingSettings batchingSettings;
+    batchingSettings.compression = false;
+    batchingSettings.maxBatchSize = 1200;
+
+    BatchingNetworkingEngine batchingNetworkingEngine(std::make_unique<RecordingNetworkingEngine>(&sent), nullptr, batchingSettings);
+
+    const ClientHandle clientHandle(2, 1);
+
+    for (uint8 i = 0; i < 10; ++i) batchingNetworkingEngine.send(clientHandle, createMessage(300, i));
+
+    // A message bigger than a batch goes on its own
+    batchingNetworkingEngine.send(clientHandle, createMessage(5000, 99));
+
+    batchingNetworkingEngine.tick(0.016f);
+
+    // Three 302 byte frames per batch, then the big message
+    BOOST_REQUIRE_EQUAL(sent.size(), 5u);
+    BOOST_CHECK_LE(sent[0].data.size(), 1200u);
+    BOOST_CHECK_LE(sent[1].data.size(), 1200u);
+    BOOST_CHECK_GT(sent[4].data.size(), 5000u);
+
+    // Everything arrives in order
+    std::vector<MessageBuffer> messages;
+    MessageBufferPool messageBufferPool;
+    for (const auto& batch : sent)
+    {
+        BatchingNetworkingEngine::unpack(batch.data.data(), batch.data.size(), messageBufferPool, messages);
+    }
+
+    BOOST_REQUIRE_EQUAL(messages.size(), 11u);
+    for (uint8 i = 0; i < 10; ++i) BOOST_CHECK_EQUAL(messages[i][0], i);
+    BOOST_CHECK_EQUAL(messages[10].size(), 5000u);
+}
+
+BOOST_AUTO_TEST_CASE(send_ChannelsAreSeparate)
+{
+    std::vector<Sent> sent;
+
+    BatchingNetworkingEngine batchingNetworkingEngine(std::make_unique<RecordingNetworkingEngine>(&sent), nullptr);
+
+    MessageBufferPool messageBufferPool;
+    const ClientHandle clientHandle(2, 1);
+
+    batchingNetworkingEngine.send(clientHandle, messageBufferPool.allocate(createMessage(8, 1)), RELIABLE);
+    batchingNetworkingEngine.send(clientHandle, messageBufferPool.allocate(createMessage(8, 2)), UNRELIABLE);
+    batchingNetworkingEngine.send(clientHandle, messageBufferPool.allocate(createMessage(8, 3)), RELIABLE);
+
+    batchingNetworkingEngine.tick(0.016f);
+
+    BOOST_REQUIRE_EQUAL(sent.size(), 2u);
+    BOOST_CHECK_EQUAL(sent[0].channel, RELIABLE);
+    BOOST_CHECK_EQUAL(sent[1].channel, UNRELIABLE);
+}
+
+BOOST_AUTO_TEST_CASE(send_BroadcastsKeepOrderWithTargetedMessages)
+{
+    std::vector<Sent> sent;
+
+    BatchingSettings batchingSettings;
+    batchingSettings.compression = false;
+
+    BatchingNetworkingEngine batchingNetworkingEngine(std::make_unique<RecordingNetworkingEngine>(&sent), nullptr, batchingSettings);
+
+    const ServerHandle serverHandle(1, 1);
+    const RemoteConnectionHandle a(10, 1);
+    MessageBufferPool messageBufferPool;
+
+    batchingNetworkingEngine.send(serverHandle, a, createMessage(4, 1));
+    batchingNetworkingEngine.send(serverHandle, a, createMessage(4, 2));
+    batchingNetworkingEngine.send(serverHandle, createMessage(4, 3));
+    batchingNetworkingEngine.send(serverHandle, a, createMessage(4, 4));
+
+    // Unreliable traffic doesn't have to wait for the reliable broadcast
+    batchingNetworkingEngine.send(serverHandle, a, messageBufferPool.allocate(createMessage(4, 5)), UNRELIABLE);
+
+    batchingNetworkingEngine.tick(0.016f);
+
+    // Connection a sees 1, 2, 3, 4 on the reliable channel, in that order
+    std::vector<uint8> order;
+
+    for (const auto& s : sent)
+    {
+        if (s.channel != RELIABLE) continue;
+
+        std::vector<MessageBuffer> messages;
+        BatchingNetworkingEngine::unpack(s.data.data(), s.data.size(), messageBufferPool, messages);
+
+        for (const auto& message : messages) order.push_back(message.toVector()[0]);
+    }
+
+    BOOST_CHECK((order == std::vector<uint8>{1, 2, 3, 4}));
+    BOOST_CHECK_EQUAL(batchingNetworkingEngine.messages(), 5u);
+}
+
+BOOST_AUTO_TEST_CASE(processEvent_CompressedRoundTrip)
+{
+    std::vector<Sent> sent;
+    auto recordingNetworkingEngine = std::make_unique<RecordingNetworkingEngine>(&sent);
+    auto recording = recordingNetworkingEngine.get();
+
+    BatchingNetworkingEngine batchingNetworkingEngine(std::move(recordingNetworkingEngine), nullptr);
+
+    RecordingEventListener recordingEventListener;
+    batchingNetworkingEngine.addEventListener(&recordingEventListener);
+
+    const ServerHandle serverHandle(1, 1);
+
+    std::vector<std::vector<uint8>> expected;
+    for (uint8 i = 0; i < 20; ++i)
+    {
+        expected.push_back(createMessage(40, i % 3));
+        batchingNetworkingEngine.send(serverHandle, expected.back());
+    }
+
+    batchingNetworkingEngine.tick(0.016f);
+
+    // Repetitive messages compress well
+    BOOST_REQUIRE_EQUAL(sent.size(), 1u);
+    BOOST_CHECK_LT(sent[0].data.size(), 20u * 41u / 2u);
+
+    // Deliver the batch back, as the remote end would receive it
+    MessageEvent event;
+    event.type = CLIENTMESSAGE;
+    event.message = sent[0].data;
+    recording->eventListener->processEvent(event);
+
+    BOOST_CHECK(recordingEventListener.messages == expected);
+}
+
+BOOST_AUTO_TEST_CASE(unpack_Malformed)
+{
+    MessageBufferPool messageBufferPool;
+    std::vector<MessageBuffer> messages;
+
+    const std::vector<uint8> truncated = {0, 10, 1, 2, 3};
+    BOOST_CHECK_THROW(BatchingNetworkingEngine::unpack(truncated.data(), truncated.size(), messageBufferPool, messages), RuntimeException);
+
+    const std::vector<uint8> huge = {1, 0xff, 0xff, 0xff, 0xff, 0x0f};
+    BOOST_CHECK_THROW(BatchingNetworkingEngine::unpack(huge.data(), huge.size(), messageBufferPool, messages), RuntimeException);
+}
+
+BOOST_AUTO_TEST_CASE(countingNetworkingEngine_CountsWithoutBatching)
+{
+    std::vector<Sent> sent;
+    auto recordingNetworkingEngine = std::make_unique<RecordingNetworkingEngine>(&sent);
+    auto recording = recordingNetworkingEngine.get();
+
+    auto& bytesSent = Metrics::instance().counter("networking.bytes_sent");
+    auto& bytesReceived = Metrics::instance().counter("networking.bytes_received");
+    auto& batchSize = Metrics::instance().histogram("networking.batch_bytes");
+
+    const uint64 bytesSentBefore = bytesSent.value();
+    const uint64 bytesReceivedBefore = bytesReceived.value();
+    batchSize.snapshot(true);
+
+    CountingNetworkingEngine countingNetworkingEngine(std::move(recordingNetworkingEngine));
+
+    RecordingEventListener recordingEventListener;
+    countingNetworkingEngine.addEventListener(&recordingEventListener);
+
+    MessageBufferPool messageBufferPool;
+    countingNetworkingEngine.send(ServerHandle(1, 1), messageBufferPool.allocate(createMessage(10, 1)), RELIABLE);
+    countingNetworkingEngine.send(ClientHandle(2, 1), messageBufferPool.allocate(createMessage(30, 2)), UNRELIABLE);
+
+    BOOST_REQUIRE_EQUAL(sent.size(), 2u);
+    BOOST_CHECK_EQUAL(bytesSent.value() - bytesSentBefore, 40u);
+
+    const auto snapshot = batchSize.snapshot();
+    BOOST_CHECK_EQUAL(snapshot.count, 2u);
+    BOOST_CHECK_EQUAL(snapshot.maximum, 30u);
+
+    MessageEvent event;
+    event.type = CLIENTMESSAGE;
+    event.message = messageBufferPool.allocate(createMessage(25, 3));
+    recording->eventListener->processEvent(event);
+
+    BOOST_CHECK_EQUAL(bytesReceived.value() - bytesReceivedBefore, 25u);
+    BOOST_REQUIRE_EQUAL(recordingEventListener.messages.size(), 1u);
+    BOOST_CHECK(recordingEventListener.messages[0] == createMessage(25, 3));
+}
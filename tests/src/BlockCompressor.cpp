@@ -0,0 +1,81 @@
+#include <random>
+
+#define BOOST_TEST_MODULE BlockCompressor
+#include <boost/test/unit_test.hpp>
+
+#include "BlockCompressor.hpp"
+
+#include "exceptions/RuntimeException.hpp"
+
+namespace
+{
+
+std::vector<ice_engine::byte> roundTrip(const std::vector<ice_engine::byte>& data)
+{
+    const auto compressed = ice_engine::BlockCompressor::compress(data.data(), data.size());
+
+    BOOST_CHECK_LE(compressed.size(), ice_engine::BlockCompressor::compressBound(data.size()));
+
+    std::vector<ice_engine::byte> decompressed(data.size());
+    ice_engine::BlockCompressor::decompress(compressed.data(), compressed.size(), decompressed.data(), decompressed.size());
+
+    return decompressed;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(BlockCompressor)
+
+BOOST_AUTO_TEST_CASE(roundTripSmall)
+{
+    for (size_t size = 0; size < 40; ++size)
+    {
+        std::vector<ice_engine::byte> data(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            data[i] = static_cast<ice_engine::byte>(i % 3);
+        }
+
+        BOOST_CHECK(roundTrip(data) == data);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(roundTripRepetitive)
+{
+    std::vector<ice_engine::byte> data(200000);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<ice_engine::byte>((i / 7) % 13);
+    }
+
+    const auto compressed = ice_engine::BlockCompressor::compress(data.data(), data.size());
+
+    BOOST_CHECK_LT(compressed.size(), data.size() / 10);
+    BOOST_CHECK(roundTrip(data) == data);
+}
+
+BOOST_AUTO_TEST_CASE(roundTripRandom)
+{
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> distribution(0, 255);
+
+    std::vector<ice_engine::byte> data(100000);
+    for (auto& value : data)
+    {
+        value = static_cast<ice_engine::byte>(distribution(generator));
+    }
+
+    BOOST_CHECK(roundTrip(data) == data);
+}
+
+BOOST_AUTO_TEST_CASE(decompressTruncated)
+{
+    std::vector<ice_engine::byte> data(1000, 7);
+
+    const auto compressed = ice_engine::BlockCompressor::compress(data.data(), data.size());
+
+    std::vector<ice_engine::byte> decompressed(data.size());
+    BOOST_CHECK_THROW(ice_engine::BlockCompressor::decompress(compressed.data(), compressed.size() - 1, decompressed.data(), decompressed.size()), ice_engine::RuntimeException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,169 @@
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <functional>
+
+#define BOOST_TEST_MODULE BonePaletteArena
+#include <boost/test/unit_test.hpp>
+
+#include "BonePaletteArena.hpp"
+
+using namespace ice_engine;
+
+namespace
+{
+
+bool identity(const BonePaletteArena::Palette& palette)
+{
+    return std::all_of(palette.transformations, palette.transformations + palette.size, [](const glm::mat4& transformation) {
+        return transformation == glm::mat4(1.0f);
+    });
+}
+
+bool inside(const BonePaletteArena::Palette& palette, const glm::mat4* buffer, const uint32 capacity)
+{
+    return std::greater_equal<const glm::mat4*>()(palette.transformations, buffer)
+        && std::less_equal<const glm::mat4*>()(palette.transformations + palette.size, buffer + capacity);
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(allocate_BumpsInsideBuffer)
+{
+    BonePaletteArena bonePaletteArena(100);
+
+    // The first allocation of a frame starts the buffer
+    const auto first = bonePaletteArena.allocate(30);
+    const auto second = bonePaletteArena.allocate(50);
+    const auto third = bonePaletteArena.allocate(20);
+
+    BOOST_CHECK_EQUAL(first.size, 30u);
+    BOOST_CHECK(second.transformations == first.transformations + 30);
+    BOOST_CHECK(third.transformations == second.transformations + 50);
+    BOOST_CHECK(inside(third, first.transformations, 100));
+
+    BOOST_CHECK(identity(first));
+    BOOST_CHECK(identity(second));
+    BOOST_CHECK(identity(third));
+    BOOST_CHECK_EQUAL(bonePaletteArena.overflows(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(allocate_OverflowsPastCapacity)
+{
+    BonePaletteArena bonePaletteArena(100);
+
+    const auto first = bonePaletteArena.allocate(90);
+    const auto overflow = bonePaletteArena.allocate(20);
+    const auto another = bonePaletteArena.allocate(5);
+
+    BOOST_CHECK_EQUAL(bonePaletteArena.overflows(), 2u);
+    BOOST_CHECK(!inside(overflow, first.transformations, 100));
+    BOOST_CHECK(!inside(another, first.transformations, 100));
+    BOOST_CHECK(identity(overflow));
+
+    // Overflow storage is usable like any other palette
+    overflow.transformations[19] = glm::mat4(2.0f);
+    BOOST_CHECK(first.transformations[89] == glm::mat4(1.0f));
+}
+
+BOOST_AUTO_TEST_CASE(beginFrame_GrowsBufferOnReuse)
+{
+    BonePaletteArena bonePaletteArena(100);
+
+    bonePaletteArena.allocate(90);
+    bonePaletteArena.allocate(20);
+    BOOST_CHECK_EQUAL(bonePaletteArena.overflows(), 1u);
+
+    for (uint32 i = 0; i < BonePaletteArena::NUMBER_OF_FRAMES - 1; ++i)
+    {
+        bonePaletteArena.beginFrame();
+        BOOST_CHECK_EQUAL(bonePaletteArena.overflows(), 0u);
+    }
+
+    // Back to the first frame's buffer, which now fits everything allocated from it last time
+    bonePaletteArena.beginFrame();
+    BOOST_CHECK_EQUAL(bonePaletteArena.overflows(), 0u);
+
+    const auto first = bonePaletteArena.allocate(90);
+    const auto second = bonePaletteArena.allocate(20);
+
+    BOOST_CHECK_EQUAL(bonePaletteArena.overflows(), 0u);
+    BOOST_CHECK(second.transformations == first.transformations + 90);
+    BOOST_CHECK(inside(second, first.transformations, 110));
+}
+
+BOOST_AUTO_TEST_CASE(valid_UntilFrameIsReused)
+{
+    BonePaletteArena bonePaletteArena(100);
+
+    const auto palette = bonePaletteArena.allocate(10);
+    BOOST_CHECK_EQUAL(palette.frame, bonePaletteArena.frame());
+
+    for (uint32 i = 0; i < BonePaletteArena::NUMBER_OF_FRAMES - 1; ++i)
+    {
+        bonePaletteArena.beginFrame();
+        BOOST_CHECK(bonePaletteArena.valid(palette));
+    }
+
+    bonePaletteArena.beginFrame();
+    BOOST_CHECK(!bonePaletteArena.valid(palette));
+}
+
+BOOST_AUTO_TEST_CASE(allocate_ConcurrentPalettesDontOverlap)
+{
+    const uint32 numberOfThreads = 4;
+    const uint32 palettesPerThread = 200;
+
+    // Small enough that some threads overflow
+    BonePaletteArena bonePaletteArena(2000);
+
+    std::vector<std::vector<BonePaletteArena::Palette>> palettes(numberOfThreads);
+    std::vector<std::thread> threads;
+
+    for (uint32 i = 0; i < numberOfThreads; ++i)
+    {
+        threads.emplace_back([&bonePaletteArena, &palettes, i]() {
+            for (uint32 j = 0; j < palettesPerThread; ++j)
+            {
+                auto palette = bonePaletteArena.allocate(1 + (i + j) % 7);
+
+                // Tag the whole palette, so a palette handed out twice shows up as the wrong tag
+                std::fill(palette.transformations, palette.transformations + palette.size, glm::mat4(static_cast<float32>(i * palettesPerThread + j + 1)));
+
+                palettes[i].push_back(palette);
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    std::vector<BonePaletteArena::Palette> all;
+    for (uint32 i = 0; i < numberOfThreads; ++i)
+    {
+        for (uint32 j = 0; j < palettesPerThread; ++j)
+        {
+            const auto& palette = palettes[i][j];
+            const glm::mat4 tag(static_cast<float32>(i * palettesPerThread + j + 1));
+
+            BOOST_CHECK(std::all_of(palette.transformations, palette.transformations + palette.size, [&tag](const glm::mat4& transformation) {
+                return transformation == tag;
+            }));
+
+            all.push_back(palette);
+        }
+    }
+
+    std::sort(all.begin(), all.end(), [](const BonePaletteArena::Palette& a, const BonePaletteArena::Palette& b) {
+        return std::less<const glm::mat4*>()(a.transformations, b.transformations);
+    });
+
+    for (size_t i = 1; i < all.size(); ++i)
+    {
+        BOOST_CHECK(std::less_equal<const glm::mat4*>()(all[i - 1].transformations + all[i - 1].size, all[i].transformations));
+    }
+
+    BOOST_CHECK_GT(bonePaletteArena.overflows(), 0u);
+}
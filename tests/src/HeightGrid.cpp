@@ -0,0 +1,130 @@
+#include <vector>
+#include <cmath>
+
+#define BOOST_TEST_MODULE HeightGrid
+#include <boost/test/unit_test.hpp>
+
+#include "HeightGrid.hpp"
+
+namespace
+{
+
+using ice_engine::HeightGrid;
+
+const uint32_t WIDTH = 9;
+const uint32_t LENGTH = 7;
+
+// A plane, which both bilinear and bicubic interpolation reproduce exactly
+float plane(const float x, const float z)
+{
+    return 0.05f * x + 0.02f * z + 0.1f;
+}
+
+HeightGrid createPlane32f()
+{
+    std::vector<float> heights(WIDTH * LENGTH);
+
+    for (uint32_t j = 0; j < LENGTH; ++j)
+    {
+        for (uint32_t i = 0; i < WIDTH; ++i)
+        {
+            heights[j * WIDTH + i] = plane(static_cast<float>(i), static_cast<float>(j));
+        }
+    }
+
+    return HeightGrid(std::move(heights), WIDTH, LENGTH);
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(height_R16)
+{
+    HeightGrid heightGrid(std::vector<uint16_t>{0, 65535, 32768, 1}, 2, 2);
+
+    BOOST_CHECK(heightGrid.format() == HeightGrid::Format::R16);
+    BOOST_CHECK_EQUAL(heightGrid.height(0, 0), 0.0f);
+    BOOST_CHECK_EQUAL(heightGrid.height(1, 0), 1.0f);
+    BOOST_CHECK_CLOSE(heightGrid.height(0, 1), 32768.0f / 65535.0f, 0.0001f);
+
+    // Clamped to the edges
+    BOOST_CHECK_EQUAL(heightGrid.height(-5, -5), heightGrid.height(0, 0));
+    BOOST_CHECK_EQUAL(heightGrid.height(10, 0), heightGrid.height(1, 0));
+    BOOST_CHECK_EQUAL(heightGrid.height(10, 10), heightGrid.height(1, 1));
+}
+
+BOOST_AUTO_TEST_CASE(sample_Plane)
+{
+    const HeightGrid heightGrid = createPlane32f();
+
+    for (float z = 0.0f; z <= LENGTH - 1; z += 0.37f)
+    {
+        for (float x = 0.0f; x <= WIDTH - 1; x += 0.29f)
+        {
+            BOOST_CHECK_SMALL(heightGrid.sampleBilinear(x, z) - plane(x, z), 1e-5f);
+
+            // Clamping the outer samples breaks the plane at the edges
+            if (x >= 1.0f && x <= WIDTH - 2 && z >= 1.0f && z <= LENGTH - 2)
+            {
+                BOOST_CHECK_SMALL(heightGrid.sampleBicubic(x, z) - plane(x, z), 1e-5f);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(sample_GridPoints)
+{
+    HeightGrid heightGrid(std::vector<uint16_t>{100, 60000, 3000, 45000, 7, 20000}, 3, 2);
+
+    for (int64_t z = 0; z < 2; ++z)
+    {
+        for (int64_t x = 0; x < 3; ++x)
+        {
+            BOOST_CHECK_CLOSE(heightGrid.sampleBilinear(static_cast<float>(x), static_cast<float>(z)), heightGrid.height(x, z), 0.0001f);
+            BOOST_CHECK_CLOSE(heightGrid.sampleBicubic(static_cast<float>(x), static_cast<float>(z)), heightGrid.height(x, z), 0.0001f);
+        }
+    }
+
+    // Outside of the grid is clamped to the edge
+    BOOST_CHECK_EQUAL(heightGrid.sampleBilinear(-3.0f, 0.0f), heightGrid.height(0, 0));
+    BOOST_CHECK_EQUAL(heightGrid.sampleBilinear(2.0f, 5.0f), heightGrid.height(2, 1));
+}
+
+BOOST_AUTO_TEST_CASE(sample_Batch)
+{
+    const HeightGrid heightGrid = createPlane32f();
+
+    std::vector<glm::vec2> points;
+    for (int i = 0; i < 100; ++i)
+    {
+        points.push_back(glm::vec2(static_cast<float>(i % 13) * 0.71f - 1.0f, static_cast<float>(i % 11) * 0.67f - 1.0f));
+    }
+
+    std::vector<float> bilinear(points.size());
+    std::vector<float> bicubic(points.size());
+    heightGrid.sampleBilinear(points.data(), bilinear.data(), points.size());
+    heightGrid.sampleBicubic(points.data(), bicubic.data(), points.size());
+
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(bilinear[i], heightGrid.sampleBilinear(points[i].x, points[i].y));
+        BOOST_CHECK_EQUAL(bicubic[i], heightGrid.sampleBicubic(points[i].x, points[i].y));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(region)
+{
+    const HeightGrid heightGrid = createPlane32f();
+
+    const HeightGrid region = heightGrid.region(-2, 3, 4, 6);
+
+    BOOST_REQUIRE_EQUAL(region.width(), 4u);
+    BOOST_REQUIRE_EQUAL(region.length(), 6u);
+
+    for (int64_t z = 0; z < 6; ++z)
+    {
+        for (int64_t x = 0; x < 4; ++x)
+        {
+            BOOST_CHECK_EQUAL(region.height(x, z), heightGrid.height(x - 2, z + 3));
+        }
+    }
+}
@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+
+#define BOOST_TEST_MODULE InitializationGraph
+#include <boost/test/unit_test.hpp>
+
+#include "InitializationGraph.hpp"
+#include "ThreadPool.hpp"
+
+#include "logger/Logger.hpp"
+
+#include "exceptions/RuntimeException.hpp"
+
+using namespace ice_engine;
+
+namespace
+{
+
+class Order
+{
+public:
+    void add(const std::string& name)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        names_.push_back(name);
+    }
+
+    size_t position(const std::string& name)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return static_cast<size_t>(std::find(names_.begin(), names_.end(), name) - names_.begin());
+    }
+
+    size_t size()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return names_.size();
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<std::string> names_;
+};
+
+}
+
+BOOST_AUTO_TEST_CASE(run_DependenciesFirst)
+{
+    ice_engine::logger::Logger testLogger;
+    ThreadPool threadPool(4);
+    Order order;
+
+    const auto mainThread = std::this_thread::get_id();
+    std::thread::id windowThread;
+
+    InitializationGraph initializationGraph(&testLogger);
+    initializationGraph.add("window", [&]() { windowThread = std::this_thread::get_id(); order.add("window"); }, {}, true);
+    initializationGraph.add("audio", [&]() { order.add("audio"); });
+    initializationGraph.add("networking", [&]() { order.add("networking"); });
+    initializationGraph.add("physics", [&]() { order.add("physics"); }, {"window"});
+    initializationGraph.add("bindings", [&]() { order.add("bindings"); }, {"audio", "networking", "physics"});
+    initializationGraph.add("modules", [&]() { order.add("modules"); }, {"bindings"}, true);
+
+    initializationGraph.run(&threadPool);
+
+    BOOST_REQUIRE_EQUAL(order.size(), 6u);
+    BOOST_CHECK(windowThread == mainThread);
+    BOOST_CHECK_LT(order.position("window"), order.position("physics"));
+    BOOST_CHECK_LT(order.position("audio"), order.position("bindings"));
+    BOOST_CHECK_LT(order.position("networking"), order.position("bindings"));
+    BOOST_CHECK_LT(order.position("physics"), order.position("bindings"));
+    BOOST_CHECK_EQUAL(order.position("modules"), 5u);
+}
+
+BOOST_AUTO_TEST_CASE(run_IndependentStepsOverlap)
+{
+    ice_engine::logger::Logger testLogger;
+    ThreadPool threadPool(4);
+
+    std::atomic<int> started{0};
+    std::atomic<bool> overlapped{false};
+
+    // Each step waits a while for the other - they only both see 2 if they run at the same time
+    auto step = [&]() {
+        ++started;
+        for (int i = 0; i < 1000 && started.load() < 2; ++i) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        if (started.load() == 2) overlapped = true;
+    };
+
+    InitializationGraph initializationGraph(&testLogger);
+    initializationGraph.add("audio", step);
+    initializationGraph.add("networking", step);
+
+    initializationGraph.run(&threadPool);
+
+    BOOST_CHECK(overlapped.load());
+    BOOST_CHECK_GT(initializationGraph.duration("audio").count(), 0.0f);
+}
+
+BOOST_AUTO_TEST_CASE(run_FailureStopsDependents)
+{
+    ice_engine::logger::Logger testLogger;
+    ThreadPool threadPool(4);
+
+    std::atomic<bool> dependentRan{false};
+
+    InitializationGraph initializationGraph(&testLogger);
+    initializationGraph.add("audio", []() { throw std::runtime_error("no audio device"); });
+    initializationGraph.add("networking", []() {});
+    initializationGraph.add("bindings", [&]() { dependentRan = true; }, {"audio", "networking"});
+
+    BOOST_CHECK_THROW(initializationGraph.run(&threadPool), std::runtime_error);
+    BOOST_CHECK(!dependentRan.load());
+
+    // Steps can only depend on steps added before them
+    BOOST_CHECK_THROW(initializationGraph.add("modules", []() {}, {"scripting"}), RuntimeException);
+}
@@ -0,0 +1,112 @@
+#include <vector>
+#include <thread>
+#include <atomic>
+
+#define BOOST_TEST_MODULE MessageBuffer
+#include <boost/test/unit_test.hpp>
+
+#include "networking/MessageBuffer.hpp"
+
+using ice_engine::networking::MessageBuffer;
+using ice_engine::networking::MessageBufferPool;
+
+BOOST_AUTO_TEST_CASE(allocate_SizeClasses)
+{
+    MessageBufferPool pool;
+
+    for (const size_t size : {0u, 1u, 64u, 65u, 1000u, 65536u, 100000u})
+    {
+        MessageBuffer messageBuffer = pool.allocate(size);
+
+        BOOST_CHECK_EQUAL(messageBuffer.size(), size);
+        BOOST_CHECK_GE(messageBuffer.capacity(), size);
+        BOOST_CHECK_EQUAL(messageBuffer.useCount(), 1u);
+
+        // Every byte is usable
+        std::fill(messageBuffer.begin(), messageBuffer.end(), 0xab);
+    }
+
+    BOOST_CHECK_EQUAL(pool.allocate(65).capacity(), 256u);
+}
+
+BOOST_AUTO_TEST_CASE(copy_SharesBytes)
+{
+    MessageBufferPool pool;
+
+    const std::vector<uint8_t> data = {1, 2, 3, 4, 5};
+    MessageBuffer messageBuffer = pool.allocate(data);
+
+    MessageBuffer copy = messageBuffer;
+    BOOST_CHECK_EQUAL(copy.data(), messageBuffer.data());
+    BOOST_CHECK_EQUAL(messageBuffer.useCount(), 2u);
+    BOOST_CHECK(copy.toVector() == data);
+
+    MessageBuffer moved = std::move(copy);
+    BOOST_CHECK(copy.empty());
+    BOOST_CHECK_EQUAL(messageBuffer.useCount(), 2u);
+
+    moved.reset();
+    BOOST_CHECK_EQUAL(messageBuffer.useCount(), 1u);
+
+    // Released blocks are reused
+    const uint8_t* bytes = messageBuffer.data();
+    messageBuffer.reset();
+    BOOST_CHECK_EQUAL(pool.allocate(10).data(), bytes);
+}
+
+BOOST_AUTO_TEST_CASE(resize_WithinCapacity)
+{
+    MessageBufferPool pool;
+
+    MessageBuffer messageBuffer = pool.allocate(10);
+    messageBuffer.resize(64);
+    BOOST_CHECK_EQUAL(messageBuffer.size(), 64u);
+
+    BOOST_CHECK_THROW(messageBuffer.resize(65), ice_engine::RuntimeException);
+}
+
+BOOST_AUTO_TEST_CASE(buffers_OutlivePool)
+{
+    MessageBuffer messageBuffer;
+
+    {
+        MessageBufferPool pool;
+        messageBuffer = pool.allocate(std::vector<uint8_t>{7, 8, 9});
+    }
+
+    BOOST_CHECK_EQUAL(messageBuffer[2], 9);
+}
+
+BOOST_AUTO_TEST_CASE(allocate_Threads)
+{
+    MessageBufferPool pool;
+
+    // Boost.Test assertions aren't thread safe
+    std::atomic<int> mismatches(0);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&pool, &mismatches, t]() {
+            std::vector<MessageBuffer> messageBuffers;
+
+            for (int i = 0; i < 10000; ++i)
+            {
+                messageBuffers.push_back(pool.allocate(static_cast<size_t>(i % 300)));
+                std::fill(messageBuffers.back().begin(), messageBuffers.back().end(), static_cast<uint8_t>(t));
+
+                // Free some on the way so blocks move between threads' lists
+                if (i % 3 == 0) messageBuffers.erase(messageBuffers.begin() + messageBuffers.size() / 2);
+            }
+
+            for (const auto& messageBuffer : messageBuffers)
+            {
+                for (const uint8_t value : messageBuffer) if (value != t) ++mismatches;
+            }
+        });
+    }
+
+    for (auto& thread : threads) thread.join();
+
+    BOOST_CHECK_EQUAL(mismatches, 0);
+}
@@ -0,0 +1,92 @@
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define BOOST_TEST_MODULE Metrics
+#include <boost/test/unit_test.hpp>
+
+#include "Metrics.hpp"
+
+using namespace ice_engine;
+
+BOOST_AUTO_TEST_CASE(counter_ConcurrentIncrements)
+{
+    Metrics metrics;
+    auto& counter = metrics.counter("counter");
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&metrics]() {
+            // Looked up by name from every thread - still the same counter
+            auto& counter = metrics.counter("counter");
+            for (int i = 0; i < 10000; ++i) counter.increment();
+        });
+    }
+
+    for (auto& thread : threads) thread.join();
+
+    BOOST_CHECK_EQUAL(counter.value(), 40000u);
+}
+
+BOOST_AUTO_TEST_CASE(histogram_Buckets)
+{
+    // Exact below 64, and every bucket above starts where the previous one ended
+    for (uint32_t i = 0; i < MetricHistogram::NUMBER_OF_BUCKETS; ++i)
+    {
+        BOOST_REQUIRE_EQUAL(MetricHistogram::bucket(MetricHistogram::lowest(i)), i);
+        BOOST_REQUIRE_EQUAL(MetricHistogram::bucket(MetricHistogram::highest(i)), i);
+        if (i > 0) BOOST_REQUIRE_EQUAL(MetricHistogram::lowest(i), MetricHistogram::highest(i - 1) + 1);
+    }
+
+    BOOST_CHECK_EQUAL(MetricHistogram::bucket(63), 63u);
+    BOOST_CHECK_EQUAL(MetricHistogram::bucket(UINT64_MAX), MetricHistogram::NUMBER_OF_BUCKETS - 1);
+    BOOST_CHECK_EQUAL(MetricHistogram::highest(MetricHistogram::NUMBER_OF_BUCKETS - 1), UINT64_MAX);
+}
+
+BOOST_AUTO_TEST_CASE(histogram_Snapshot)
+{
+    MetricHistogram histogram;
+
+    for (uint64_t i = 1; i <= 100; ++i) histogram.record(i);
+
+    const auto snapshot = histogram.snapshot(true);
+    BOOST_CHECK_EQUAL(snapshot.count, 100u);
+    BOOST_CHECK_EQUAL(snapshot.minimum, 1u);
+    BOOST_CHECK_EQUAL(snapshot.percentile50, 50u);
+
+    // Within a bucket of 2 above 64
+    BOOST_CHECK_GE(snapshot.percentile99, 99u);
+    BOOST_CHECK_LE(snapshot.percentile99, 100u);
+    BOOST_CHECK_GE(snapshot.maximum, 100u);
+    BOOST_CHECK_LE(snapshot.maximum, 101u);
+    BOOST_CHECK_CLOSE(snapshot.mean, 50.5, 1.0);
+
+    BOOST_CHECK_EQUAL(histogram.snapshot().count, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(write_LineProtocol)
+{
+    Metrics metrics;
+
+    metrics.counter("scene.entities created").increment(5);
+    metrics.gauge("thread_pool.queue_depth").set(-3);
+    metrics.histogram("frame_us").record(10);
+
+    std::stringstream first;
+    metrics.write(first, 1000);
+
+    BOOST_CHECK(first.str().find("scene.entities\\ created count=5i,delta=5i 1000\n") != std::string::npos);
+    BOOST_CHECK(first.str().find("thread_pool.queue_depth value=-3i 1000\n") != std::string::npos);
+    BOOST_CHECK(first.str().find("frame_us count=1i,min=10i,mean=10,p50=10i,p95=10i,p99=10i,max=10i 1000\n") != std::string::npos);
+
+    // Deltas and histograms cover the time since the last write
+    metrics.counter("scene.entities created").increment(2);
+
+    std::stringstream second;
+    metrics.write(second, 2000);
+
+    BOOST_CHECK(second.str().find("scene.entities\\ created count=7i,delta=2i 2000\n") != std::string::npos);
+    BOOST_CHECK(second.str().find("frame_us count=0i") != std::string::npos);
+}
@@ -0,0 +1,125 @@
+#include <vector>
+#include <thread>
+
+#define BOOST_TEST_MODULE MpscRingBuffer
+#include <boost/test/unit_test.hpp>
+
+#include "detail/MpscRingBuffer.hpp"
+
+using ice_engine::detail::MpscRingBuffer;
+
+BOOST_AUTO_TEST_CASE(tryPop_Empty)
+{
+    MpscRingBuffer<int> ringBuffer(4);
+
+    int value = 7;
+    BOOST_CHECK(!ringBuffer.tryPop(value));
+    BOOST_CHECK_EQUAL(value, 7);
+
+    int pushed = 1;
+    BOOST_REQUIRE(ringBuffer.tryPush(pushed));
+    BOOST_REQUIRE(ringBuffer.tryPop(value));
+    BOOST_CHECK_EQUAL(value, 1);
+
+    BOOST_CHECK(!ringBuffer.tryPop(value));
+}
+
+BOOST_AUTO_TEST_CASE(tryPush_Full)
+{
+    MpscRingBuffer<int> ringBuffer(4);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        int value = i;
+        BOOST_REQUIRE(ringBuffer.tryPush(value));
+    }
+
+    // A value that doesn't fit is left untouched
+    int value = 4;
+    BOOST_CHECK(!ringBuffer.tryPush(value));
+    BOOST_CHECK_EQUAL(value, 4);
+
+    // Popping one frees one cell
+    int popped = -1;
+    BOOST_REQUIRE(ringBuffer.tryPop(popped));
+    BOOST_CHECK_EQUAL(popped, 0);
+    BOOST_CHECK(ringBuffer.tryPush(value));
+    BOOST_CHECK(!ringBuffer.tryPush(value));
+}
+
+BOOST_AUTO_TEST_CASE(tryPop_FifoAcrossLaps)
+{
+    MpscRingBuffer<int> ringBuffer(4);
+
+    int next = 0;
+    int expected = 0;
+
+    // Wrap around the ring several times with it partly full
+    for (int lap = 0; lap < 10; ++lap)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            int value = next++;
+            BOOST_REQUIRE(ringBuffer.tryPush(value));
+        }
+
+        for (int i = 0; i < 3; ++i)
+        {
+            int value = -1;
+            BOOST_REQUIRE(ringBuffer.tryPop(value));
+            BOOST_CHECK_EQUAL(value, expected++);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(tryPush_MultipleProducersKeepPerProducerOrder)
+{
+    const int producers = 4;
+    const int valuesPerProducer = 10000;
+
+    MpscRingBuffer<int> ringBuffer(64);
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&ringBuffer, p]() {
+            for (int i = 0; i < valuesPerProducer; ++i)
+            {
+                int value = p * valuesPerProducer + i;
+                while (!ringBuffer.tryPush(value))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Values from any one producer come out in the order that producer pushed them, and none are lost
+    std::vector<int> last(producers, -1);
+    int count = 0;
+
+    while (count < producers * valuesPerProducer)
+    {
+        int value = -1;
+        if (!ringBuffer.tryPop(value))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        const int producer = value / valuesPerProducer;
+        const int index = value % valuesPerProducer;
+
+        BOOST_REQUIRE_EQUAL(index, last[producer] + 1);
+        last[producer] = index;
+        ++count;
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    int value = -1;
+    BOOST_CHECK(!ringBuffer.tryPop(value));
+}
@@ -0,0 +1,102 @@
+#include <vector>
+#include <cstring>
+
+#define BOOST_TEST_MODULE Noise
+#include <boost/test/unit_test.hpp>
+
+#include "noise/Noise.hpp"
+#include "ThreadPool.hpp"
+
+namespace
+{
+
+using ice_engine::noise::Noise;
+
+// Odd sizes so that the kernels' partial last vectors get tested, and an origin either side of zero
+const glm::vec2 ORIGIN = glm::vec2(-37.25f, -12.5f);
+const glm::vec2 STEP = glm::vec2(0.75f, 1.25f);
+const uint32_t WIDTH = 67;
+const uint32_t HEIGHT = 45;
+
+void checkMatchesGetNoise(const Noise& noise, ice_engine::IThreadPool* threadPool = nullptr)
+{
+    std::vector<float> grid(WIDTH * HEIGHT);
+    noise.fillGrid(grid.data(), ORIGIN, STEP, WIDTH, HEIGHT, threadPool);
+
+    for (uint32_t j = 0; j < HEIGHT; ++j)
+    {
+        for (uint32_t i = 0; i < WIDTH; ++i)
+        {
+            const float expected = noise.getNoise(ORIGIN.x + static_cast<float>(i) * STEP.x, ORIGIN.y + static_cast<float>(j) * STEP.y);
+            const float actual = grid[j * WIDTH + i];
+
+            // Bit for bit
+            BOOST_REQUIRE_MESSAGE(
+                std::memcmp(&expected, &actual, sizeof(float)) == 0,
+                "noise type " << noise.getNoiseType() << " interpolation " << noise.getInterpolation() << " fractal type " << noise.getFractalType()
+                    << " at (" << i << ", " << j << "): expected " << expected << " got " << actual
+            );
+        }
+    }
+}
+
+Noise createNoise(const Noise::NoiseType noiseType)
+{
+    Noise noise(1234);
+    noise.setNoiseType(noiseType);
+    noise.setFrequency(0.05f);
+    noise.setFractalOctaves(4);
+
+    return noise;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(fillGrid_SingleNoise)
+{
+    for (const auto noiseType : {FastNoise::Value, FastNoise::Perlin, FastNoise::Simplex})
+    {
+        for (const auto interpolation : {FastNoise::Linear, FastNoise::Hermite, FastNoise::Quintic})
+        {
+            Noise noise = createNoise(noiseType);
+            noise.setInterpolation(interpolation);
+
+            checkMatchesGetNoise(noise);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(fillGrid_FractalNoise)
+{
+    for (const auto noiseType : {FastNoise::ValueFractal, FastNoise::PerlinFractal, FastNoise::SimplexFractal})
+    {
+        for (const auto fractalType : {FastNoise::FBM, FastNoise::Billow, FastNoise::RigidMulti})
+        {
+            Noise noise = createNoise(noiseType);
+            noise.setFractalType(fractalType);
+
+            checkMatchesGetNoise(noise);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(fillGrid_ScalarFallback)
+{
+    for (const auto noiseType : {FastNoise::Cellular, FastNoise::WhiteNoise, FastNoise::Cubic, FastNoise::CubicFractal})
+    {
+        checkMatchesGetNoise(createNoise(noiseType));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(fillGrid_ThreadPool)
+{
+    ice_engine::ThreadPool threadPool(4);
+
+    Noise noise = createNoise(FastNoise::SimplexFractal);
+
+    checkMatchesGetNoise(noise, &threadPool);
+
+    noise.setNoiseType(FastNoise::Cellular);
+
+    checkMatchesGetNoise(noise, &threadPool);
+}
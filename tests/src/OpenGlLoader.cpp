@@ -0,0 +1,90 @@
+#include <vector>
+#include <thread>
+#include <chrono>
+
+#define BOOST_TEST_MODULE OpenGlLoader
+#include <boost/test/unit_test.hpp>
+
+#include "OpenGlLoader.hpp"
+
+using namespace ice_engine;
+
+namespace
+{
+
+void sleep(const int milliseconds)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(tick_DefersWorkOverBudget)
+{
+    OpenGlLoader openGlLoader;
+
+    std::vector<int> ran;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        openGlLoader.postWork([&ran, i]() { sleep(5); ran.push_back(i); }, IOpenGlLoader::PRIORITY_NORMAL, std::chrono::milliseconds(5));
+    }
+
+    BOOST_CHECK_EQUAL(openGlLoader.getWorkQueueCount(), 4u);
+
+    // Room for two (with slack for a slow sleep), so the third waits for the next frame
+    openGlLoader.tick(std::chrono::milliseconds(14));
+
+    BOOST_REQUIRE_EQUAL(ran.size(), 2u);
+    BOOST_CHECK_EQUAL(openGlLoader.getWorkQueueCount(), 2u);
+
+    openGlLoader.tick(std::chrono::milliseconds(100));
+
+    BOOST_REQUIRE_EQUAL(ran.size(), 4u);
+    BOOST_CHECK_EQUAL(openGlLoader.getWorkQueueCount(), 0u);
+
+    // Deferred work keeps its place in line
+    BOOST_CHECK_EQUAL(ran[0], 0);
+    BOOST_CHECK_EQUAL(ran[1], 1);
+    BOOST_CHECK_EQUAL(ran[2], 2);
+    BOOST_CHECK_EQUAL(ran[3], 3);
+}
+
+BOOST_AUTO_TEST_CASE(tick_RunsOnePerPriorityWhenOverBudget)
+{
+    OpenGlLoader openGlLoader;
+
+    std::vector<int> ran;
+
+    openGlLoader.postWork([&ran]() { ran.push_back(0); }, IOpenGlLoader::PRIORITY_NORMAL, std::chrono::milliseconds(10));
+    openGlLoader.postWork([&ran]() { ran.push_back(1); }, IOpenGlLoader::PRIORITY_NORMAL, std::chrono::milliseconds(10));
+    openGlLoader.postWork([&ran]() { ran.push_back(2); }, IOpenGlLoader::PRIORITY_HIGH, std::chrono::milliseconds(10));
+
+    // Nothing fits, but high priority work runs first and neither priority is starved
+    openGlLoader.tick(std::chrono::microseconds(1));
+
+    BOOST_REQUIRE_EQUAL(ran.size(), 2u);
+    BOOST_CHECK_EQUAL(ran[0], 2);
+    BOOST_CHECK_EQUAL(ran[1], 0);
+    BOOST_CHECK_EQUAL(openGlLoader.getWorkQueueCount(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(postWork_OverflowKeepsOrder)
+{
+    OpenGlLoader openGlLoader(2);
+
+    std::vector<int> ran;
+
+    for (int i = 0; i < 8; ++i)
+    {
+        openGlLoader.postWork([&ran, i]() { ran.push_back(i); });
+    }
+
+    openGlLoader.tick(std::chrono::seconds(1));
+
+    BOOST_REQUIRE_EQUAL(ran.size(), 8u);
+    for (int i = 0; i < 8; ++i)
+    {
+        BOOST_CHECK_EQUAL(ran[i], i);
+    }
+}
@@ -0,0 +1,140 @@
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define ICEENGINE_ENABLE_PROFILING
+
+#define BOOST_TEST_MODULE Profiler
+#include <boost/test/unit_test.hpp>
+
+#include "Profiler.hpp"
+
+using namespace ice_engine;
+
+namespace
+{
+
+ProfilerSettings createProfilerSettings()
+{
+    ProfilerSettings profilerSettings;
+    profilerSettings.enabled = true;
+    profilerSettings.threadBufferSize = 64;
+    profilerSettings.traceEvents = 100;
+    profilerSettings.histogramSamples = 10;
+
+    return profilerSettings;
+}
+
+const int64_t MILLISECOND = 1000000;
+
+}
+
+BOOST_AUTO_TEST_CASE(statistics_RollingWindow)
+{
+    Profiler profiler(createProfilerSettings());
+    const uint32_t zone = profiler.zone("zone");
+
+    // 1 to 20 milliseconds - only the last 10 are kept
+    for (int64_t i = 1; i <= 20; ++i)
+    {
+        profiler.record(zone, 0, i * MILLISECOND);
+    }
+
+    profiler.collect();
+
+    const auto& statistics = profiler.statistics("zone");
+    BOOST_CHECK_EQUAL(statistics.count, 10u);
+    BOOST_CHECK_CLOSE(statistics.minimum, 11.0f, 0.001f);
+    BOOST_CHECK_CLOSE(statistics.maximum, 20.0f, 0.001f);
+    BOOST_CHECK_CLOSE(statistics.mean, 15.5f, 0.001f);
+    BOOST_CHECK_CLOSE(statistics.median, 15.0f, 0.001f);
+    BOOST_CHECK_CLOSE(statistics.percentile99, 20.0f, 0.001f);
+
+    const auto histogram = profiler.histogram("zone");
+    uint32_t total = 0;
+    for (const auto count : histogram) total += count;
+    BOOST_CHECK_EQUAL(total, 10u);
+
+    BOOST_CHECK_EQUAL(profiler.statistics("unknown").count, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(record_DisabledRecordsNothing)
+{
+    auto profilerSettings = createProfilerSettings();
+    profilerSettings.enabled = false;
+
+    Profiler profiler(profilerSettings);
+    const uint32_t zone = profiler.zone("zone");
+
+    {
+        const ProfileZone profileZone(profiler, zone);
+    }
+
+    profiler.collect();
+    BOOST_CHECK_EQUAL(profiler.statistics("zone").count, 0u);
+
+    profiler.setEnabled(true);
+
+    {
+        const ProfileZone profileZone(profiler, zone);
+    }
+
+    profiler.collect();
+    BOOST_CHECK_EQUAL(profiler.statistics("zone").count, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(record_FullThreadBufferDrops)
+{
+    Profiler profiler(createProfilerSettings());
+    const uint32_t zone = profiler.zone("zone");
+
+    for (int i = 0; i < 100; ++i)
+    {
+        profiler.record(zone, 0, 1);
+    }
+
+    BOOST_CHECK_EQUAL(profiler.droppedEvents(), 36u);
+}
+
+BOOST_AUTO_TEST_CASE(exportChromeTrace_Threads)
+{
+    Profiler profiler(createProfilerSettings());
+    const uint32_t zone = profiler.zone("Scene::\"tick\"");
+
+    profiler.setThreadName("main");
+    profiler.record(zone, 5 * MILLISECOND, 6 * MILLISECOND);
+
+    std::thread worker([&profiler, zone]() {
+        profiler.setThreadName("worker");
+        profiler.record(zone, 7 * MILLISECOND, 9 * MILLISECOND);
+    });
+    worker.join();
+
+    profiler.collect();
+
+    std::stringstream stream;
+    profiler.exportChromeTrace(stream);
+    const std::string json = stream.str();
+
+    BOOST_CHECK(json.find("\"traceEvents\":[") != std::string::npos);
+    BOOST_CHECK(json.find("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":1,\"args\":{\"name\":\"main\"}}") != std::string::npos);
+    BOOST_CHECK(json.find("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":2,\"args\":{\"name\":\"worker\"}}") != std::string::npos);
+
+    // Times are microseconds from the first event, and names are escaped
+    BOOST_CHECK(json.find("\"name\":\"Scene::\\\"tick\\\"\",\"cat\":\"ice_engine\",\"ph\":\"X\",\"pid\":0,\"tid\":1,\"ts\":0,\"dur\":1000}") != std::string::npos);
+    BOOST_CHECK(json.find("\"tid\":2,\"ts\":2000,\"dur\":2000}") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(profileZone_Macro)
+{
+    Profiler::instance().initialize(createProfilerSettings());
+
+    for (int i = 0; i < 3; ++i)
+    {
+        PROFILE_ZONE("macro");
+    }
+
+    Profiler::instance().collect();
+    BOOST_CHECK_EQUAL(Profiler::instance().statistics("macro").count, 3u);
+}
@@ -0,0 +1,194 @@
+#include <vector>
+#include <random>
+#include <cmath>
+#include <map>
+#include <utility>
+
+#define BOOST_TEST_MODULE QuadtreeTerrainMesher
+#include <boost/test/unit_test.hpp>
+
+#include "QuadtreeTerrainMesher.hpp"
+
+namespace
+{
+
+using ice_engine::HeightGrid;
+using ice_engine::QuadtreeTerrainMesher;
+
+const float HEIGHT_SCALE = 15.0f;
+
+HeightGrid createHills(const uint32_t width, const uint32_t length, const unsigned int seed)
+{
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> noise(-0.01f, 0.01f);
+
+    std::vector<float> heights(width * length);
+
+    for (uint32_t j = 0; j < length; ++j)
+    {
+        for (uint32_t i = 0; i < width; ++i)
+        {
+            // Flat on one side, hilly on the other
+            const float hills = i < width / 2 ? 0.0f : 0.25f * std::sin(i * 0.4f) * std::cos(j * 0.3f) + noise(generator);
+            heights[j * width + i] = 0.5f + hills;
+        }
+    }
+
+    return HeightGrid(std::move(heights), width, length);
+}
+
+struct Mesh
+{
+    std::vector<glm::vec3> vertices;
+    std::vector<uint32_t> indices;
+};
+
+float area(const Mesh& mesh, const size_t triangle)
+{
+    const glm::vec3& a = mesh.vertices[mesh.indices[triangle * 3]];
+    const glm::vec3& b = mesh.vertices[mesh.indices[triangle * 3 + 1]];
+    const glm::vec3& c = mesh.vertices[mesh.indices[triangle * 3 + 2]];
+
+    // Signed area of the footprint - positive when counter clockwise seen from above (y up, so x then -z)
+    return 0.5f * ((b.x - a.x) * (c.z - a.z) - (c.x - a.x) * (b.z - a.z)) * -1.0f;
+}
+
+bool footprintContains(const Mesh& mesh, const size_t triangle, const float x, const float z, float& height)
+{
+    const glm::vec3& a = mesh.vertices[mesh.indices[triangle * 3]];
+    const glm::vec3& b = mesh.vertices[mesh.indices[triangle * 3 + 1]];
+    const glm::vec3& c = mesh.vertices[mesh.indices[triangle * 3 + 2]];
+
+    const float determinant = (b.z - c.z) * (a.x - c.x) + (c.x - b.x) * (a.z - c.z);
+    const float wa = ((b.z - c.z) * (x - c.x) + (c.x - b.x) * (z - c.z)) / determinant;
+    const float wb = ((c.z - a.z) * (x - c.x) + (a.x - c.x) * (z - c.z)) / determinant;
+    const float wc = 1.0f - wa - wb;
+
+    const float epsilon = 1e-5f;
+    if (wa < -epsilon || wb < -epsilon || wc < -epsilon) return false;
+
+    height = wa * a.y + wb * b.y + wc * c.y;
+    return true;
+}
+
+// Every triangle faces up, they tile the grid exactly, and every interior edge is shared by exactly two triangles -
+// which rules out cracks and t-junctions
+void checkWatertight(const Mesh& mesh, const uint32_t cellsX, const uint32_t cellsZ)
+{
+    BOOST_REQUIRE_EQUAL(mesh.indices.size() % 3, 0u);
+
+    float totalArea = 0.0f;
+    std::map<std::pair<uint32_t, uint32_t>, int> edges;
+
+    for (size_t triangle = 0; triangle < mesh.indices.size() / 3; ++triangle)
+    {
+        const float triangleArea = area(mesh, triangle);
+        BOOST_REQUIRE_GT(triangleArea, 0.0f);
+        totalArea += triangleArea;
+
+        for (int k = 0; k < 3; ++k)
+        {
+            edges[std::make_pair(mesh.indices[triangle * 3 + k], mesh.indices[triangle * 3 + (k + 1) % 3])] += 1;
+        }
+    }
+
+    BOOST_CHECK_CLOSE(totalArea, static_cast<float>(cellsX * cellsZ), 0.001f);
+
+    for (const auto& edge : edges)
+    {
+        BOOST_REQUIRE_EQUAL(edge.second, 1);
+
+        if (edges.find(std::make_pair(edge.first.second, edge.first.first)) != edges.end()) continue;
+
+        // Unpaired edges have to be on the boundary of the grid
+        const glm::vec3& a = mesh.vertices[edge.first.first];
+        const glm::vec3& b = mesh.vertices[edge.first.second];
+
+        const bool boundary = (a.x == b.x && (a.x == 0.0f || a.x == cellsX)) || (a.z == b.z && (a.z == 0.0f || a.z == cellsZ));
+        BOOST_REQUIRE_MESSAGE(boundary, "Unpaired edge (" << a.x << ", " << a.z << ") - (" << b.x << ", " << b.z << ")");
+    }
+}
+
+void checkError(const Mesh& mesh, const HeightGrid& heightGrid, const uint32_t cellsX, const uint32_t cellsZ, const float maximumError)
+{
+    for (uint32_t z = 0; z <= cellsZ; ++z)
+    {
+        for (uint32_t x = 0; x <= cellsX; ++x)
+        {
+            bool found = false;
+
+            for (size_t triangle = 0; triangle < mesh.indices.size() / 3 && !found; ++triangle)
+            {
+                float height;
+                if (footprintContains(mesh, triangle, static_cast<float>(x), static_cast<float>(z), height))
+                {
+                    found = true;
+                    BOOST_REQUIRE_LE(std::abs(height - heightGrid.height(x, z) * HEIGHT_SCALE), maximumError + 1e-4f);
+                }
+            }
+
+            BOOST_REQUIRE(found);
+        }
+    }
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(generate_Flat)
+{
+    const HeightGrid heightGrid(std::vector<float>(33 * 33, 0.5f), 33, 33);
+    const QuadtreeTerrainMesher mesher(heightGrid, 32, 32, HEIGHT_SCALE);
+
+    Mesh mesh;
+    mesher.generate(0.0f, mesh.vertices, mesh.indices);
+
+    // Just the root - a fan of four triangles
+    BOOST_CHECK_EQUAL(mesh.indices.size(), 12u);
+    checkWatertight(mesh, 32, 32);
+}
+
+BOOST_AUTO_TEST_CASE(generate_ErrorBounded)
+{
+    const HeightGrid heightGrid = createHills(33, 33, 1);
+    const QuadtreeTerrainMesher mesher(heightGrid, 32, 32, HEIGHT_SCALE);
+
+    for (const float maximumError : {0.0f, 0.05f, 0.5f, 2.0f})
+    {
+        Mesh mesh;
+        mesher.generate(maximumError, mesh.vertices, mesh.indices);
+
+        checkWatertight(mesh, 32, 32);
+        checkError(mesh, heightGrid, 32, 32, maximumError);
+
+        // The flat half needs far fewer triangles than the full grid
+        BOOST_CHECK_LT(mesh.indices.size() / 3, 32u * 32u * 2u);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(generate_NonPowerOfTwo)
+{
+    const HeightGrid heightGrid = createHills(24, 18, 2);
+    const QuadtreeTerrainMesher mesher(heightGrid, 23, 17, HEIGHT_SCALE);
+
+    Mesh mesh;
+    mesher.generate(0.1f, mesh.vertices, mesh.indices);
+
+    checkWatertight(mesh, 23, 17);
+    checkError(mesh, heightGrid, 23, 17, 0.1f);
+}
+
+BOOST_AUTO_TEST_CASE(generate_ViewDependent)
+{
+    const HeightGrid heightGrid = createHills(65, 65, 3);
+    const QuadtreeTerrainMesher mesher(heightGrid, 64, 64, HEIGHT_SCALE);
+
+    Mesh near;
+    mesher.generate(glm::vec3(60.0f, 10.0f, 60.0f), 0.01f, 0.05f, near.vertices, near.indices);
+    checkWatertight(near, 64, 64);
+
+    Mesh far;
+    mesher.generate(glm::vec3(-1000.0f, 10.0f, -1000.0f), 0.01f, 0.05f, far.vertices, far.indices);
+    checkWatertight(far, 64, 64);
+
+    BOOST_CHECK_LT(far.indices.size(), near.indices.size());
+}
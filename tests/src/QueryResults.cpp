@@ -0,0 +1,172 @@
+#include <vector>
+
+#include <boost/variant.hpp>
+
+#define BOOST_TEST_MODULE QueryResults
+#include <boost/test/unit_test.hpp>
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+
+#include "QueryResults.hpp"
+
+#include "physics/StubPhysicsEngine.hpp"
+#include "physics/Sphere.hpp"
+
+using namespace ice_engine;
+
+namespace
+{
+
+typedef boost::variant<physics::RigidBodyObjectHandle, physics::GhostObjectHandle> PhysicsObjectHandle;
+
+// Only the single queries are overridden, so the batched ones are the IPhysicsEngine defaults
+class CountingPhysicsEngine : public physics::StubPhysicsEngine
+{
+public:
+    virtual physics::Raycast raycast(const physics::PhysicsSceneHandle& physicsSceneHandle, const ray::Ray& ray) override
+    {
+        ++raycasts;
+
+        physics::Raycast result(ray);
+        result.setHitPointWorld(ray.from + ray.to);
+
+        return result;
+    }
+
+    // Finds as many objects as the radius, with the object number as the handle
+    virtual std::vector<PhysicsObjectHandle> query(const physics::PhysicsSceneHandle& physicsSceneHandle, const glm::vec3& origin, const float32 radius) override
+    {
+        ++queries;
+
+        std::vector<PhysicsObjectHandle> result;
+        for (int i = 0; i < static_cast<int>(radius); ++i)
+        {
+            result.push_back(physics::RigidBodyObjectHandle(&objects[i]));
+        }
+
+        return result;
+    }
+
+    int raycasts = 0;
+    int queries = 0;
+    int objects[8] = {};
+};
+
+}
+
+BOOST_AUTO_TEST_CASE(endQuery_PacksOffsets)
+{
+    QueryResults<int> results;
+
+    BOOST_CHECK_EQUAL(results.numberOfQueries(), 0u);
+
+    results.add(1);
+    results.add(2);
+    results.endQuery();
+
+    // A query can find nothing
+    results.endQuery();
+
+    results.add(3);
+    results.endQuery();
+
+    BOOST_REQUIRE_EQUAL(results.numberOfQueries(), 3u);
+
+    BOOST_CHECK_EQUAL(results.count(0), 2u);
+    BOOST_CHECK_EQUAL(results.count(1), 0u);
+    BOOST_CHECK_EQUAL(results.count(2), 1u);
+
+    BOOST_CHECK_EQUAL(results.get(0, 0), 1);
+    BOOST_CHECK_EQUAL(results.get(0, 1), 2);
+    BOOST_CHECK_EQUAL(results.get(2, 0), 3);
+
+    const std::vector<uint32> offsets = {0, 2, 2, 3};
+    BOOST_CHECK_EQUAL_COLLECTIONS(results.offsets().begin(), results.offsets().end(), offsets.begin(), offsets.end());
+    BOOST_CHECK_EQUAL(results.values().size(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(clear_KeepsMemory)
+{
+    QueryResults<int> results;
+    results.reserve(4, 100);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        results.add(i);
+    }
+    results.endQuery();
+
+    const auto data = results.values().data();
+
+    results.clear();
+
+    BOOST_CHECK_EQUAL(results.numberOfQueries(), 0u);
+    BOOST_CHECK(results.values().empty());
+    BOOST_REQUIRE_EQUAL(results.offsets().size(), 1u);
+    BOOST_CHECK_EQUAL(results.offsets()[0], 0u);
+
+    results.add(7);
+    results.endQuery();
+
+    BOOST_CHECK_EQUAL(results.values().data(), data);
+    BOOST_CHECK_EQUAL(results.get(0, 0), 7);
+}
+
+BOOST_AUTO_TEST_CASE(query_DefaultCallsSingleQueries)
+{
+    CountingPhysicsEngine countingPhysicsEngine;
+    physics::IPhysicsEngine& physicsEngine = countingPhysicsEngine;
+
+    const auto physicsSceneHandle = physicsEngine.createPhysicsScene();
+
+    const std::vector<physics::Sphere> spheres = {
+        physics::Sphere(glm::vec3(0.0f), 3.0f),
+        physics::Sphere(glm::vec3(1.0f), 0.0f),
+        physics::Sphere(glm::vec3(2.0f), 2.0f)
+    };
+
+    QueryResults<PhysicsObjectHandle> results;
+
+    // Stale results from a previous batch are replaced
+    results.add(physics::RigidBodyObjectHandle());
+    results.endQuery();
+
+    physicsEngine.query(physicsSceneHandle, spheres, results);
+
+    BOOST_CHECK_EQUAL(countingPhysicsEngine.queries, 3);
+    BOOST_REQUIRE_EQUAL(results.numberOfQueries(), 3u);
+    BOOST_CHECK_EQUAL(results.count(0), 3u);
+    BOOST_CHECK_EQUAL(results.count(1), 0u);
+    BOOST_CHECK_EQUAL(results.count(2), 2u);
+
+    BOOST_CHECK(boost::get<physics::RigidBodyObjectHandle>(results.get(2, 1)) == physics::RigidBodyObjectHandle(&countingPhysicsEngine.objects[1]));
+}
+
+BOOST_AUTO_TEST_CASE(raycast_DefaultCallsSingleRaycasts)
+{
+    CountingPhysicsEngine countingPhysicsEngine;
+    physics::IPhysicsEngine& physicsEngine = countingPhysicsEngine;
+
+    const auto physicsSceneHandle = physicsEngine.createPhysicsScene();
+
+    std::vector<ray::Ray> rays;
+    for (int i = 0; i < 4; ++i)
+    {
+        rays.push_back(ray::Ray(glm::vec3(static_cast<float>(i)), glm::vec3(1.0f, 0.0f, 0.0f)));
+    }
+
+    // The output is resized to fit
+    std::vector<physics::Raycast> raycasts(10);
+
+    physicsEngine.raycast(physicsSceneHandle, rays, raycasts);
+
+    BOOST_CHECK_EQUAL(countingPhysicsEngine.raycasts, 4);
+    BOOST_REQUIRE_EQUAL(raycasts.size(), 4u);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        BOOST_CHECK_EQUAL(raycasts[i].hitPointWorld().x, static_cast<float>(i) + 1.0f);
+        BOOST_CHECK_EQUAL(raycasts[i].hitPointWorld().y, static_cast<float>(i));
+    }
+}
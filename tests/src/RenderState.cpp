@@ -0,0 +1,158 @@
+#include <vector>
+#include <thread>
+#include <map>
+
+#define BOOST_TEST_MODULE RenderState
+#include <boost/test/unit_test.hpp>
+
+#include "RenderState.hpp"
+
+#include "graphics/NullGraphicsEngine.hpp"
+
+using namespace ice_engine;
+
+namespace
+{
+
+const graphics::RenderSceneHandle renderSceneHandle(1, 1);
+
+graphics::RenderableHandle renderable(const uint32_t index)
+{
+    return graphics::RenderableHandle(index, 1);
+}
+
+/**
+ * Keeps the version of the renderable in each slot, like a graphics engine that reuses slots.
+ */
+class SlotGraphicsEngine : public graphics::NullGraphicsEngine
+{
+public:
+    std::map<uint32_t, uint32_t> versions;
+    uint32_t positioned = 0;
+
+    bool valid(const graphics::RenderSceneHandle&, const graphics::RenderableHandle& renderableHandle) const override
+    {
+        const auto it = versions.find(renderableHandle.index());
+
+        return it != versions.end() && it->second == renderableHandle.version();
+    }
+
+    void destroy(const graphics::RenderSceneHandle&, const graphics::RenderableHandle& renderableHandle) override
+    {
+        BOOST_REQUIRE_EQUAL(versions.erase(renderableHandle.index()), 1u);
+    }
+
+    void position(const graphics::RenderSceneHandle&, const graphics::RenderableHandle&, const glm::vec3&) override
+    {
+        ++positioned;
+    }
+};
+
+}
+
+BOOST_AUTO_TEST_CASE(swap_WritesOnlyVisibleAfterSwap)
+{
+    RenderState renderState;
+
+    renderState.position(renderSceneHandle, renderable(1), glm::vec3(1.0f, 2.0f, 3.0f));
+    BOOST_CHECK_EQUAL(renderState.size(), 0u);
+
+    renderState.swap();
+    BOOST_CHECK_EQUAL(renderState.size(), 1u);
+
+    // Writes during the frame go to the other buffer
+    renderState.position(renderSceneHandle, renderable(2), glm::vec3());
+    renderState.position(renderSceneHandle, renderable(3), glm::vec3());
+    BOOST_CHECK_EQUAL(renderState.size(), 1u);
+
+    renderState.swap();
+    BOOST_CHECK_EQUAL(renderState.size(), 2u);
+
+    // Nothing written since, so nothing to apply
+    renderState.swap();
+    BOOST_CHECK_EQUAL(renderState.size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(position_Coalesced)
+{
+    RenderState renderState;
+
+    // Several ticks in a frame move the same renderables and light
+    for (int tick = 0; tick < 5; ++tick)
+    {
+        renderState.position(renderSceneHandle, renderable(1), glm::vec3(static_cast<float>(tick)));
+        renderState.rotation(renderSceneHandle, renderable(1), glm::quat());
+        renderState.rotation(renderSceneHandle, renderable(2), glm::quat());
+        renderState.position(renderSceneHandle, graphics::PointLightHandle(1, 1), glm::vec3());
+    }
+
+    // The same renderable in another scene is a different renderable
+    renderState.position(graphics::RenderSceneHandle(2, 1), renderable(1), glm::vec3());
+
+    renderState.swap();
+    BOOST_CHECK_EQUAL(renderState.size(), 4u);
+}
+
+BOOST_AUTO_TEST_CASE(destroy_NotCoalesced)
+{
+    RenderState renderState;
+
+    renderState.position(renderSceneHandle, renderable(1), glm::vec3());
+    renderState.destroy(renderSceneHandle, renderable(1));
+    renderState.destroy(renderSceneHandle, graphics::PointLightHandle(1, 1));
+
+    renderState.swap();
+    BOOST_CHECK_EQUAL(renderState.size(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(position_ConcurrentWriters)
+{
+    RenderState renderState;
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&renderState, t]() {
+            for (uint32_t i = 0; i < 1000; ++i)
+            {
+                renderState.position(renderSceneHandle, renderable(t * 1000 + i + 1), glm::vec3());
+            }
+        });
+    }
+
+    for (auto& thread : threads) thread.join();
+
+    renderState.swap();
+    BOOST_CHECK_EQUAL(renderState.size(), 4000u);
+}
+
+BOOST_AUTO_TEST_CASE(apply_SkipsReusedHandles)
+{
+    RenderState renderState;
+    BonePaletteArena bonePaletteArena;
+    SlotGraphicsEngine graphicsEngine;
+
+    graphicsEngine.versions[1] = 1;
+
+    renderState.position(renderSceneHandle, renderable(1), glm::vec3());
+    renderState.destroy(renderSceneHandle, renderable(1));
+
+    // Destroyed directly before the sync point, and the slot reused by a new renderable
+    graphicsEngine.versions[1] = 2;
+
+    renderState.swap();
+    renderState.apply(&graphicsEngine, bonePaletteArena);
+
+    BOOST_CHECK_EQUAL(graphicsEngine.versions.at(1), 2u);
+    BOOST_CHECK_EQUAL(graphicsEngine.positioned, 0u);
+
+    // The new renderable is updated and destroyed as usual
+    renderState.position(renderSceneHandle, graphics::RenderableHandle(1, 2), glm::vec3());
+    renderState.destroy(renderSceneHandle, graphics::RenderableHandle(1, 2));
+
+    renderState.swap();
+    renderState.apply(&graphicsEngine, bonePaletteArena);
+
+    BOOST_CHECK(graphicsEngine.versions.empty());
+    BOOST_CHECK_EQUAL(graphicsEngine.positioned, 1u);
+}
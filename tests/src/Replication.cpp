@@ -0,0 +1,270 @@
+#include <vector>
+#include <random>
+#include <cmath>
+
+#define BOOST_TEST_MODULE Replication
+#include <boost/test/unit_test.hpp>
+
+#include "replication/BitStream.hpp"
+#include "replication/Snapshot.hpp"
+#include "replication/LoopbackReplication.hpp"
+#include "replication/ApplyEntityState.hpp"
+
+#include "ecs/EntityComponentSystem.hpp"
+
+namespace
+{
+
+using namespace ice_engine;
+using namespace ice_engine::replication;
+
+std::vector<EntityState> createStates(const uint32 count, const unsigned int seed)
+{
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+
+    std::vector<EntityState> states;
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        states.emplace_back(i * 3 + 1, glm::vec3(position(generator), 0.0f, position(generator)), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), std::vector<uint8>{1, 2, 3, 4});
+    }
+
+    return states;
+}
+
+// Move a few entities a little, like a typical tick
+void move(std::vector<EntityState>& states, const uint32 tick)
+{
+    for (size_t i = tick % 10; i < states.size(); i += 10)
+    {
+        states[i].position.x += 0.25f;
+        states[i].custom[0] = static_cast<uint8>(tick);
+    }
+}
+
+void checkClose(const std::vector<EntityState>& expected, const std::vector<EntityState>& actual, const float precision)
+{
+    BOOST_REQUIRE_EQUAL(expected.size(), actual.size());
+
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(expected[i].id, actual[i].id);
+        BOOST_CHECK_LE(std::abs(expected[i].position.x - actual[i].position.x), precision);
+        BOOST_CHECK_LE(std::abs(expected[i].position.z - actual[i].position.z), precision);
+        BOOST_CHECK(expected[i].custom == actual[i].custom);
+    }
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(bitStream_RoundTrip)
+{
+    std::vector<uint8> data;
+
+    BitWriter writer(data);
+    writer.write(5, 3);
+    writer.writeBool(true);
+    writer.write(0xdeadbeef, 32);
+    writer.writeVariable(300);
+    writer.writeSigned(-12345);
+    writer.writeSigned(0);
+
+    BitReader reader(data.data(), data.size());
+    BOOST_CHECK_EQUAL(reader.read(3), 5u);
+    BOOST_CHECK(reader.readBool());
+    BOOST_CHECK_EQUAL(reader.read(32), 0xdeadbeefu);
+    BOOST_CHECK_EQUAL(reader.readVariable(), 300u);
+    BOOST_CHECK_EQUAL(reader.readSigned(), -12345);
+    BOOST_CHECK_EQUAL(reader.readSigned(), 0);
+
+    BOOST_CHECK_THROW(reader.read(32), RuntimeException);
+}
+
+BOOST_AUTO_TEST_CASE(quantizer_Orientation)
+{
+    const Quantizer quantizer;
+
+    const float s = std::sqrt(0.5f);
+
+    for (const auto& orientation : {glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::quat(s, 0.0f, -s, 0.0f), glm::quat(0.5f, -0.5f, 0.5f, -0.5f)})
+    {
+        const glm::quat result = quantizer.dequantizeOrientation(quantizer.quantize(orientation));
+
+        // Either sign is the same rotation
+        const float dot = result.w * orientation.w + result.x * orientation.x + result.y * orientation.y + result.z * orientation.z;
+        BOOST_CHECK_GT(std::abs(dot), 0.9999f);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(snapshot_DeltaAgainstBaseline)
+{
+    const Quantizer quantizer;
+
+    Snapshot baseline;
+    baseline.sequence = 1;
+    for (const auto& state : createStates(100, 1)) baseline.entities.push_back(quantizer.quantize(state));
+
+    std::vector<uint8> full;
+    encode(baseline, nullptr, full);
+
+    // Change one entity, remove another and add a new one
+    Snapshot snapshot = baseline;
+    snapshot.sequence = 2;
+    snapshot.entities[10].position[0] += 7;
+    snapshot.entities[20].custom[2] = 9;
+    snapshot.entities.erase(snapshot.entities.begin() + 30);
+    snapshot.entities.push_back(quantizer.quantize(EntityState(1000, glm::vec3(1.0f, 2.0f, 3.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f))));
+
+    std::vector<uint8> delta;
+    encode(snapshot, &baseline, delta);
+
+    BOOST_CHECK_LT(delta.size() * 10, full.size());
+    BOOST_CHECK_EQUAL(baselineSequence(delta.data(), delta.size()), 1u);
+
+    const Snapshot decodedBaseline = decode(full.data(), full.size(), nullptr);
+    const Snapshot decoded = decode(delta.data(), delta.size(), &decodedBaseline);
+
+    BOOST_CHECK_EQUAL(decoded.sequence, 2u);
+    BOOST_REQUIRE_EQUAL(decoded.entities.size(), snapshot.entities.size());
+
+    for (size_t i = 0; i < snapshot.entities.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(decoded.entities[i].id, snapshot.entities[i].id);
+        BOOST_CHECK_EQUAL(decoded.entities[i].position[0], snapshot.entities[i].position[0]);
+        BOOST_CHECK_EQUAL(decoded.entities[i].orientation, snapshot.entities[i].orientation);
+        BOOST_CHECK(decoded.entities[i].custom == snapshot.entities[i].custom);
+    }
+
+    // The wrong baseline is refused
+    BOOST_CHECK_THROW(decode(delta.data(), delta.size(), nullptr), RuntimeException);
+}
+
+BOOST_AUTO_TEST_CASE(loopback_Converges)
+{
+    ReplicationSettings replicationSettings;
+
+    LoopbackReplication loopback(2, replicationSettings);
+
+    auto states = createStates(200, 2);
+
+    for (uint32 tick = 0; tick < 60; ++tick)
+    {
+        move(states, tick);
+        loopback.tick(states, 1.0f / 30.0f);
+    }
+
+    checkClose(states, loopback.client(0).states(), replicationSettings.positionPrecision);
+    checkClose(states, loopback.client(1).states(), replicationSettings.positionPrecision);
+
+    // Deltas against acknowledged snapshots are a fraction of the full snapshots
+    const auto& statistics = loopback.server().statistics(0);
+    BOOST_CHECK_EQUAL(statistics.messages, 60u);
+    BOOST_CHECK_LT(statistics.bytes, 60u * 200u * 4u);
+    BOOST_CHECK_CLOSE(loopback.bandwidth(0), statistics.bytes / 2.0f, 0.01f);
+    BOOST_CHECK(!loopback.report().empty());
+}
+
+BOOST_AUTO_TEST_CASE(loopback_PacketLoss)
+{
+    ReplicationSettings replicationSettings;
+
+    LoopbackReplication loopback(4, replicationSettings, 0.3f, 3);
+
+    auto states = createStates(100, 3);
+
+    for (uint32 tick = 0; tick < 100; ++tick)
+    {
+        move(states, tick);
+        loopback.tick(states, 1.0f / 30.0f);
+    }
+
+    // Lost snapshots and acknowledgements are recovered from - clients that got the last snapshot are up to date
+    uint32 upToDate = 0;
+
+    for (ClientId clientId = 0; clientId < loopback.numberOfClients(); ++clientId)
+    {
+        BOOST_CHECK_GT(loopback.client(clientId).sequence(), 0u);
+
+        if (loopback.client(clientId).sequence() == loopback.server().statistics(clientId).messages)
+        {
+            checkClose(states, loopback.client(clientId).states(), replicationSettings.positionPrecision);
+            ++upToDate;
+        }
+    }
+
+    BOOST_CHECK_GT(upToDate, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(loopback_InterestRadius)
+{
+    ReplicationSettings replicationSettings;
+    replicationSettings.interestRadius = 20.0f;
+
+    LoopbackReplication loopback(2, replicationSettings);
+    loopback.setFocus(0, glm::vec3(0.0f, 0.0f, 0.0f));
+
+    std::vector<EntityState> states;
+    states.emplace_back(1, glm::vec3(5.0f, 0.0f, 0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+    states.emplace_back(2, glm::vec3(50.0f, 0.0f, 0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+
+    loopback.tick(states, 0.1f);
+
+    // Client 1 has no focus, so it sees everything
+    BOOST_REQUIRE_EQUAL(loopback.client(0).states().size(), 1u);
+    BOOST_CHECK_EQUAL(loopback.client(0).states()[0].id, 1u);
+    BOOST_CHECK_EQUAL(loopback.client(1).states().size(), 2u);
+
+    // Moving out of range removes the entity, moving in adds it
+    states[0].position.x = 30.0f;
+    states[1].position.x = 10.0f;
+    loopback.tick(states, 0.1f);
+
+    BOOST_REQUIRE_EQUAL(loopback.client(0).states().size(), 1u);
+    BOOST_CHECK_EQUAL(loopback.client(0).states()[0].id, 2u);
+}
+
+BOOST_AUTO_TEST_CASE(applyEntityState_MissingTransform)
+{
+    ecs::EntityComponentSystem entityComponentSystem(nullptr);
+
+    // Marked replicated before it was given a position or orientation
+    auto entity = entityComponentSystem.create();
+    entity.assign<ecs::ReplicatedComponent>(7);
+
+    const EntityState state(7, glm::vec3(1.0f, 2.0f, 3.0f), glm::quat(0.0f, 1.0f, 0.0f, 0.0f), std::vector<uint8>{5});
+
+    BOOST_CHECK_EQUAL(applyEntityState(entity, state), ecs::DirtyFlags::DIRTY_POSITION | ecs::DirtyFlags::DIRTY_ORIENTATION);
+
+    BOOST_REQUIRE(entity.hasComponent<ecs::PositionComponent>());
+    BOOST_REQUIRE(entity.hasComponent<ecs::OrientationComponent>());
+    BOOST_CHECK(entity.component<ecs::PositionComponent>()->position == state.position);
+    BOOST_CHECK(entity.component<ecs::OrientationComponent>()->orientation == state.orientation);
+    BOOST_CHECK(entity.component<ecs::ReplicatedComponent>()->custom == state.custom);
+}
+
+BOOST_AUTO_TEST_CASE(applyEntityState_DirtyOnlyWhatChanged)
+{
+    ecs::EntityComponentSystem entityComponentSystem(nullptr);
+
+    EntityState state(7, glm::vec3(1.0f, 2.0f, 3.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+
+    auto entity = entityComponentSystem.create();
+    entity.assign<ecs::PositionComponent>(state.position);
+    entity.assign<ecs::OrientationComponent>(state.orientation);
+    entity.assign<ecs::ReplicatedComponent>(7);
+
+    BOOST_CHECK_EQUAL(applyEntityState(entity, state), 0);
+
+    state.position.x += 0.25f;
+    BOOST_CHECK_EQUAL(applyEntityState(entity, state), ecs::DirtyFlags::DIRTY_POSITION);
+    BOOST_CHECK_EQUAL(entity.component<ecs::PositionComponent>()->position.x, 1.25f);
+
+    state.orientation = glm::quat(0.0f, 0.0f, 1.0f, 0.0f);
+    BOOST_CHECK_EQUAL(applyEntityState(entity, state), ecs::DirtyFlags::DIRTY_ORIENTATION);
+
+    // Custom bytes alone don't move anything
+    state.custom = std::vector<uint8>{1};
+    BOOST_CHECK_EQUAL(applyEntityState(entity, state), 0);
+    BOOST_CHECK(entity.component<ecs::ReplicatedComponent>()->custom == state.custom);
+}
@@ -0,0 +1,189 @@
+#include <sstream>
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+#define BOOST_TEST_MODULE SceneSnapshot
+#include <boost/test/unit_test.hpp>
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+
+#include "SceneSnapshot.hpp"
+
+#include "ecs/EntityComponentSystem.hpp"
+#include "ecs/PositionComponent.hpp"
+#include "ecs/PersistableComponent.hpp"
+
+#include "logger/Logger.hpp"
+
+#include "exceptions/RuntimeException.hpp"
+
+using namespace ice_engine;
+
+namespace
+{
+
+ecs::Entity createEntity(ecs::EntityComponentSystem& entityComponentSystem, const glm::vec3& position)
+{
+    auto entity = entityComponentSystem.create();
+
+    entityComponentSystem.assign<ecs::PositionComponent>(entity.id(), position);
+    entityComponentSystem.assign<ecs::PersistableComponent>(entity.id());
+
+    return entity;
+}
+
+// Written the same way Scene writes an incremental save - only what changed since the last snapshot, plus what was removed
+std::string writeSnapshot(const ecs::EntityComponentSystem& entityComponentSystem, std::unordered_map<uint32, uint64>& hashes, const uint32 sequence)
+{
+    EntitySnapshot entitySnapshot(entityComponentSystem);
+    const auto currentHashes = entitySnapshot.hashes();
+
+    SceneSnapshot::Increment increment;
+    increment.saveId = 1234;
+    increment.sequence = sequence;
+
+    std::vector<uint32> changed;
+
+    for (const auto& kv : currentHashes)
+    {
+        const auto it = hashes.find(kv.first);
+
+        if (sequence == 0 || it == hashes.end() || it->second != kv.second)
+        {
+            changed.push_back(kv.first);
+        }
+    }
+
+    for (const auto& kv : hashes)
+    {
+        if (currentHashes.find(kv.first) == currentHashes.end())
+        {
+            increment.removed.push_back(kv.first);
+        }
+    }
+
+    std::sort(changed.begin(), changed.end());
+
+    std::ostringstream stream;
+
+    SceneSnapshotWriter writer(stream, true);
+    writer.writeIncrement(increment);
+    writer.writeEntities(entitySnapshot.subset(changed));
+    writer.finish();
+
+    hashes = currentHashes;
+
+    return stream.str();
+}
+
+std::unordered_map<uint32, glm::vec3> positions(ecs::EntityComponentSystem& entityComponentSystem)
+{
+    std::unordered_map<uint32, glm::vec3> result;
+
+    for (auto entity : entityComponentSystem.entitiesWithComponents<ecs::PositionComponent, ecs::PersistableComponent>())
+    {
+        result[entity.id().index()] = entity.component<ecs::PositionComponent>()->position;
+    }
+
+    return result;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(readEntityChanges_BaseAndTwoIncrements)
+{
+    ice_engine::logger::Logger testLogger;
+
+    ecs::EntityComponentSystem source(nullptr);
+    std::unordered_map<uint32, uint64> hashes;
+
+    std::vector<ecs::Entity> entities;
+    for (int i = 0; i < 5; ++i)
+    {
+        entities.push_back(createEntity(source, glm::vec3(static_cast<float>(i), 0.0f, 0.0f)));
+    }
+
+    const auto base = writeSnapshot(source, hashes, 0);
+
+    // Increment 1 - one entity moves and two are removed
+    entities[1].component<ecs::PositionComponent>()->position = glm::vec3(10.0f, 1.0f, 0.0f);
+    source.destroy(entities[3]);
+    source.destroy(entities[4]);
+
+    const auto increment1 = writeSnapshot(source, hashes, 1);
+
+    // Increment 2 - the removed slots are reused by new entities, and another one moves
+    entities[0].component<ecs::PositionComponent>()->position = glm::vec3(-1.0f, 2.0f, 0.0f);
+    createEntity(source, glm::vec3(40.0f, 0.0f, 0.0f));
+    createEntity(source, glm::vec3(30.0f, 0.0f, 0.0f));
+
+    const auto increment2 = writeSnapshot(source, hashes, 2);
+
+    ecs::EntityComponentSystem loaded(nullptr);
+
+    for (const auto& data : {base, increment1, increment2})
+    {
+        std::istringstream stream(data);
+        SceneSnapshotReader reader(stream, &testLogger);
+
+        BOOST_CHECK_EQUAL(reader.increment().saveId, 1234u);
+
+        if (reader.increment().sequence == 0)
+        {
+            reader.readEntities(loaded);
+        }
+        else
+        {
+            reader.readEntityChanges(loaded);
+        }
+    }
+
+    const auto expected = positions(source);
+    const auto result = positions(loaded);
+
+    BOOST_REQUIRE_EQUAL(result.size(), expected.size());
+    BOOST_CHECK_EQUAL(loaded.numEntities(), source.numEntities());
+
+    for (const auto& kv : expected)
+    {
+        const auto it = result.find(kv.first);
+
+        BOOST_REQUIRE(it != result.end());
+        BOOST_CHECK_EQUAL(it->second.x, kv.second.x);
+        BOOST_CHECK_EQUAL(it->second.y, kv.second.y);
+        BOOST_CHECK_EQUAL(it->second.z, kv.second.z);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(readEntityChanges_IndexInUse)
+{
+    ice_engine::logger::Logger testLogger;
+
+    ecs::EntityComponentSystem source(nullptr);
+    std::unordered_map<uint32, uint64> hashes;
+
+    createEntity(source, glm::vec3(0.0f));
+
+    const auto base = writeSnapshot(source, hashes, 0);
+
+    createEntity(source, glm::vec3(1.0f));
+
+    const auto increment = writeSnapshot(source, hashes, 1);
+
+    // Index 1 is already held by an entity that isn't part of the save
+    ecs::EntityComponentSystem loaded(nullptr);
+
+    {
+        std::istringstream stream(base);
+        SceneSnapshotReader(stream, &testLogger).readEntities(loaded);
+    }
+
+    loaded.create();
+
+    std::istringstream stream(increment);
+    SceneSnapshotReader reader(stream, &testLogger);
+
+    BOOST_CHECK_THROW(reader.readEntityChanges(loaded), RuntimeException);
+}
@@ -0,0 +1,72 @@
+#include <cmath>
+
+#define BOOST_TEST_MODULE SimulationClock
+#include <boost/test/unit_test.hpp>
+
+#include "SimulationClock.hpp"
+
+using ice_engine::SimulationClock;
+using ice_engine::SimulationSettings;
+
+BOOST_AUTO_TEST_CASE(advance_FixedTicks)
+{
+    SimulationClock simulationClock;
+
+    // A 144 Hz display - most frames run no tick, and alpha moves through the tick
+    uint32_t ticks = 0;
+    for (int i = 0; i < 144; ++i)
+    {
+        ticks += simulationClock.advance(1.0f / 144.0f);
+
+        BOOST_CHECK_GE(simulationClock.alpha(), 0.0f);
+        BOOST_CHECK_LT(simulationClock.alpha(), 1.0f);
+    }
+
+    BOOST_CHECK(ticks == 59 || ticks == 60);
+    BOOST_CHECK_EQUAL(simulationClock.ticks(), ticks);
+    BOOST_CHECK_CLOSE(simulationClock.time(), ticks / 60.0, 1e-9);
+    BOOST_CHECK_EQUAL(simulationClock.droppedTime(), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(advance_NoDrift)
+{
+    SimulationClock simulationClock;
+
+    // An hour of 30 Hz frames comes out at an hour of ticks
+    for (int i = 0; i < 30 * 3600; ++i) simulationClock.advance(1.0f / 30.0f);
+
+    BOOST_CHECK_LE(std::abs(simulationClock.time() - 3600.0), 0.1);
+}
+
+BOOST_AUTO_TEST_CASE(advance_SlowFramesDropTime)
+{
+    SimulationSettings simulationSettings;
+    simulationSettings.maxTicksPerFrame = 3;
+
+    SimulationClock simulationClock(simulationSettings);
+
+    // 6 ticks worth of frame, but only 3 are run and the rest is dropped rather than piling up
+    BOOST_CHECK_EQUAL(simulationClock.advance(0.1f), 3u);
+    BOOST_CHECK_CLOSE(simulationClock.droppedTime(), 0.05, 0.1);
+    BOOST_CHECK_EQUAL(simulationClock.advance(1.0f / 60.0f), 1u);
+
+    // A long stall is clamped to maxframedelta
+    BOOST_CHECK_EQUAL(simulationClock.advance(5.0f), 3u);
+    BOOST_CHECK_GT(simulationClock.droppedTime(), 4.9);
+}
+
+BOOST_AUTO_TEST_CASE(advance_CatchUp)
+{
+    SimulationSettings simulationSettings;
+    simulationSettings.maxTicksPerFrame = 3;
+    simulationSettings.catchUp = true;
+
+    SimulationClock simulationClock(simulationSettings);
+
+    // The backlog is run over the following frames
+    BOOST_CHECK_EQUAL(simulationClock.advance(0.1f), 3u);
+    BOOST_CHECK_EQUAL(simulationClock.advance(0.0f), 3u);
+    BOOST_CHECK_EQUAL(simulationClock.advance(0.0f), 0u);
+    BOOST_CHECK_EQUAL(simulationClock.ticks(), 6u);
+    BOOST_CHECK_LT(simulationClock.droppedTime(), 1e-6);
+}
@@ -0,0 +1,174 @@
+#include <random>
+#include <algorithm>
+#include <unordered_map>
+
+#define BOOST_TEST_MODULE SpatialIndex
+#include <boost/test/unit_test.hpp>
+
+#include "SpatialIndex.hpp"
+
+namespace
+{
+
+float distanceSquared(const glm::vec3& a, const glm::vec3& b)
+{
+    const glm::vec3 d = a - b;
+
+    return d.x * d.x + d.y * d.y + d.z * d.z;
+}
+
+struct Fixture
+{
+    // A small root with few items per node, so that points move between nodes and outside of the root
+    ice_engine::SpatialIndex index{glm::vec3(0.0f), 100.0f, 4, 6};
+    std::unordered_map<ice_engine::SpatialIndex::Id, glm::vec3> points;
+
+    std::mt19937 generator{42};
+    std::uniform_real_distribution<float> distribution{-150.0f, 150.0f};
+
+    glm::vec3 randomPoint()
+    {
+        return glm::vec3(distribution(generator), distribution(generator), distribution(generator));
+    }
+
+    void randomUpdates(const int count)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            const ice_engine::SpatialIndex::Id id = generator() % 500;
+
+            if (generator() % 10 < 8)
+            {
+                const auto it = points.find(id);
+
+                // Mostly small moves, like entities do from tick to tick
+                const glm::vec3 point = (it != points.end() && generator() % 2 ? it->second + randomPoint() * 0.02f : randomPoint());
+
+                index.update(id, point);
+                points[id] = point;
+            }
+            else
+            {
+                index.remove(id);
+                points.erase(id);
+            }
+        }
+    }
+};
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(SpatialIndex, Fixture)
+
+BOOST_AUTO_TEST_CASE(queryRadius)
+{
+    for (int i = 0; i < 50; ++i)
+    {
+        randomUpdates(200);
+
+        const glm::vec3 center = randomPoint();
+        const float radius = std::abs(distribution(generator)) * 0.5f;
+
+        std::vector<ice_engine::SpatialIndex::Id> results;
+        index.queryRadius(center, radius, results);
+        std::sort(results.begin(), results.end());
+
+        std::vector<ice_engine::SpatialIndex::Id> expected;
+        for (const auto& kv : points)
+        {
+            if (distanceSquared(kv.second, center) <= radius * radius) expected.push_back(kv.first);
+        }
+        std::sort(expected.begin(), expected.end());
+
+        BOOST_CHECK(results == expected);
+        BOOST_CHECK_EQUAL(index.size(), points.size());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(queryBoxAndFrustum)
+{
+    for (int i = 0; i < 50; ++i)
+    {
+        randomUpdates(200);
+
+        const glm::vec3 a = randomPoint();
+        const glm::vec3 b = randomPoint();
+        const glm::vec3 minimum(std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z));
+        const glm::vec3 maximum(std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z));
+
+        std::vector<ice_engine::SpatialIndex::Id> expected;
+        for (const auto& kv : points)
+        {
+            const auto& p = kv.second;
+            if (p.x >= minimum.x && p.x <= maximum.x && p.y >= minimum.y && p.y <= maximum.y && p.z >= minimum.z && p.z <= maximum.z) expected.push_back(kv.first);
+        }
+        std::sort(expected.begin(), expected.end());
+
+        std::vector<ice_engine::SpatialIndex::Id> results;
+        index.queryBox(minimum, maximum, results);
+        std::sort(results.begin(), results.end());
+
+        BOOST_CHECK(results == expected);
+
+        // The same box as a frustum
+        const std::array<glm::vec4, 6> planes = {{
+            glm::vec4(1.0f, 0.0f, 0.0f, -minimum.x),
+            glm::vec4(-1.0f, 0.0f, 0.0f, maximum.x),
+            glm::vec4(0.0f, 1.0f, 0.0f, -minimum.y),
+            glm::vec4(0.0f, -1.0f, 0.0f, maximum.y),
+            glm::vec4(0.0f, 0.0f, 1.0f, -minimum.z),
+            glm::vec4(0.0f, 0.0f, -1.0f, maximum.z)
+        }};
+
+        results.clear();
+        index.queryFrustum(planes, results);
+        std::sort(results.begin(), results.end());
+
+        BOOST_CHECK(results == expected);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(queryNearest)
+{
+    for (int i = 0; i < 50; ++i)
+    {
+        randomUpdates(200);
+
+        const glm::vec3 center = randomPoint();
+
+        std::vector<std::pair<float, ice_engine::SpatialIndex::Id>> sorted;
+        for (const auto& kv : points)
+        {
+            sorted.push_back({distanceSquared(kv.second, center), kv.first});
+        }
+        std::sort(sorted.begin(), sorted.end());
+
+        std::vector<ice_engine::SpatialIndex::Id> results;
+        index.queryNearest(center, 7, results);
+
+        BOOST_REQUIRE_EQUAL(results.size(), std::min<size_t>(7, sorted.size()));
+
+        for (size_t j = 0; j < results.size(); ++j)
+        {
+            BOOST_CHECK_EQUAL(results[j], sorted[j].second);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(removeAll)
+{
+    randomUpdates(1000);
+
+    for (ice_engine::SpatialIndex::Id id = 0; id < 500; ++id)
+    {
+        index.remove(id);
+    }
+
+    std::vector<ice_engine::SpatialIndex::Id> results;
+    index.queryRadius(glm::vec3(0.0f), 1000.0f, results);
+
+    BOOST_CHECK(results.empty());
+    BOOST_CHECK_EQUAL(index.size(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
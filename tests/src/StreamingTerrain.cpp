@@ -0,0 +1,297 @@
+#include <memory>
+#include <set>
+#include <thread>
+#include <stdexcept>
+
+#define BOOST_TEST_MODULE StreamingTerrain
+#include <boost/test/unit_test.hpp>
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+
+#include "StreamingTerrain.hpp"
+#include "HeightMapTileSource.hpp"
+#include "NoiseTileSource.hpp"
+#include "GameEngine.hpp"
+#include "Scene.hpp"
+#include "PluginManager.hpp"
+#include "ThreadPool.hpp"
+
+#include "graphics/NullGraphicsEngine.hpp"
+
+#include "fs/FileSystem.hpp"
+#include "utilities/Properties.hpp"
+#include "logger/Logger.hpp"
+
+using namespace ice_engine;
+
+namespace
+{
+
+// Headless, so the scene runs on the null engines without a window or plugins
+const std::string SETTINGS = R"END(
+[engine]
+headless=true
+
+[logging]
+async=false
+)END";
+
+// Tiles of 16 units, 4 by 4 of them around the origin
+const uint32 TILE_SIZE = 16;
+
+class FlatTileSource : public ITerrainTileSource
+{
+public:
+    bool contains(const int32 x, const int32 z, const uint32 tileSize) const override
+    {
+        return x >= -2 && x < 2 && z >= -2 && z < 2;
+    }
+
+    HeightGrid heights(const int32 x, const int32 z, const uint32 tileSize) const override
+    {
+        if (x == failX && z == failZ) throw std::runtime_error("no data");
+
+        return HeightGrid(std::vector<float32>((tileSize + 1) * (tileSize + 1), 0.5f), tileSize + 1, tileSize + 1);
+    }
+
+    int32 failX = 100;
+    int32 failZ = 100;
+};
+
+// Tracks the terrain StreamingTerrain creates and positions itself (on the main thread) - the tile entities' renderables
+// come from the scene's own engine
+class MockGraphicsEngine : public graphics::NullGraphicsEngine
+{
+public:
+    graphics::TerrainHandle createStaticTerrain(const graphics::IHeightMap& heightMap, const graphics::ISplatMap& splatMap, const graphics::IDisplacementMap& displacementMap) override
+    {
+        BOOST_CHECK_EQUAL(heightMap.image()->width(), TILE_SIZE + 1);
+
+        const auto terrainHandle = graphics::NullGraphicsEngine::createStaticTerrain(heightMap, splatMap, displacementMap);
+        terrains.insert(terrainHandle.id());
+
+        return terrainHandle;
+    }
+
+    void destroy(const graphics::TerrainHandle& terrainHandle) override
+    {
+        BOOST_CHECK_EQUAL(terrains.erase(terrainHandle.id()), 1u);
+        ++destroyed;
+    }
+
+    void position(const graphics::RenderSceneHandle& renderSceneHandle, const graphics::TerrainRenderableHandle& terrainRenderableHandle, const glm::vec3& position) override
+    {
+        ++positioned;
+    }
+
+    std::set<uint64> terrains;
+    uint32 destroyed = 0;
+    uint32 positioned = 0;
+};
+
+struct Fixture
+{
+    Fixture()
+    {
+        auto properties = std::make_unique<utilities::Properties>(SETTINGS);
+        auto fileSystem = std::make_unique<fs::FileSystem>();
+        auto gameEngineLogger = std::make_unique<logger::Logger>();
+        auto pluginManager = std::make_unique<PluginManager>(properties.get(), fileSystem.get(), gameEngineLogger.get());
+
+        gameEngine = std::make_unique<GameEngine>(std::move(properties), std::move(fileSystem), std::move(pluginManager), std::move(gameEngineLogger));
+        scene = gameEngine->createScene("streaming_terrain");
+
+        settings.tileSize = TILE_SIZE;
+        settings.loadDistance = 20.0f;
+        settings.unloadDistance = 40.0f;
+        settings.maxPendingTiles = 100;
+        settings.maxTilesPerTick = 100;
+        settings.navigation = false;
+    }
+
+    ~Fixture()
+    {
+        streamingTerrain.reset();
+        gameEngine->destroyScene(scene);
+    }
+
+    void create(std::unique_ptr<ITerrainTileSource> tileSource)
+    {
+        streamingTerrain = std::make_unique<StreamingTerrain>(
+            settings,
+            std::move(tileSource),
+            SplatMap(),
+            DisplacementMap(),
+            scene,
+            &threadPool,
+            gameEngine->logger(),
+            &graphicsEngine,
+            gameEngine->pathfindingEngine(),
+            gameEngine->physicsEngine(),
+            graphicsEngine.createRenderScene()
+        );
+    }
+
+    void waitForTiles()
+    {
+        while (threadPool.getWorkQueueCount() + threadPool.getActiveWorkerCount() > 0)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    std::unique_ptr<GameEngine> gameEngine;
+    Scene* scene = nullptr;
+    ThreadPool threadPool{4};
+    MockGraphicsEngine graphicsEngine;
+    TerrainStreamingSettings settings;
+    std::unique_ptr<StreamingTerrain> streamingTerrain;
+};
+
+}
+
+// Tiles within 20 units of the origin - the 2 x 2 around it, and the 8 next to their sides, but not the corners
+const uint32 TILES_IN_RANGE = 12;
+
+BOOST_FIXTURE_TEST_CASE(tick_RequestsTilesInRange, Fixture)
+{
+    create(std::make_unique<FlatTileSource>());
+
+    streamingTerrain->tick(0.0f);
+
+    BOOST_CHECK_EQUAL(streamingTerrain->numberOfPendingTiles(), TILES_IN_RANGE);
+    BOOST_CHECK_EQUAL(streamingTerrain->numberOfLoadedTiles(), 0u);
+
+    // Nothing is created on the engine until the tile's data is generated and the terrain ticks again
+    BOOST_CHECK(graphicsEngine.terrains.empty());
+}
+
+BOOST_FIXTURE_TEST_CASE(tick_LimitsPendingTiles, Fixture)
+{
+    settings.maxPendingTiles = 5;
+    create(std::make_unique<FlatTileSource>());
+
+    streamingTerrain->tick(0.0f);
+
+    BOOST_CHECK_EQUAL(streamingTerrain->numberOfPendingTiles(), 5u);
+}
+
+BOOST_FIXTURE_TEST_CASE(tick_FinishesTiles, Fixture)
+{
+    settings.maxTilesPerTick = 5;
+    create(std::make_unique<FlatTileSource>());
+
+    streamingTerrain->tick(0.0f);
+    waitForTiles();
+
+    // At most maxTilesPerTick tiles get their resources per tick
+    streamingTerrain->tick(0.0f);
+
+    BOOST_CHECK_EQUAL(streamingTerrain->numberOfLoadedTiles(), 5u);
+    BOOST_CHECK_EQUAL(graphicsEngine.terrains.size(), 5u);
+
+    streamingTerrain->tick(0.0f);
+    streamingTerrain->tick(0.0f);
+
+    BOOST_CHECK_EQUAL(streamingTerrain->numberOfLoadedTiles(), TILES_IN_RANGE);
+    BOOST_CHECK_EQUAL(streamingTerrain->numberOfPendingTiles(), 0u);
+    BOOST_CHECK_EQUAL(graphicsEngine.terrains.size(), TILES_IN_RANGE);
+    BOOST_CHECK_EQUAL(graphicsEngine.positioned, TILES_IN_RANGE);
+}
+
+BOOST_FIXTURE_TEST_CASE(tick_SkipsFailedTiles, Fixture)
+{
+    auto tileSource = std::make_unique<FlatTileSource>();
+    tileSource->failX = 0;
+    tileSource->failZ = 0;
+
+    create(std::move(tileSource));
+
+    streamingTerrain->tick(0.0f);
+    waitForTiles();
+    streamingTerrain->tick(0.0f);
+
+    BOOST_CHECK_EQUAL(streamingTerrain->numberOfLoadedTiles(), TILES_IN_RANGE - 1);
+    BOOST_CHECK_EQUAL(streamingTerrain->numberOfPendingTiles(), 0u);
+
+    // A failed tile isn't requested again while it stays in range
+    streamingTerrain->tick(0.0f);
+
+    BOOST_CHECK_EQUAL(streamingTerrain->numberOfPendingTiles(), 0u);
+}
+
+BOOST_FIXTURE_TEST_CASE(tick_UnloadsTilesOutOfRange, Fixture)
+{
+    create(std::make_unique<FlatTileSource>());
+
+    streamingTerrain->tick(0.0f);
+    waitForTiles();
+    streamingTerrain->tick(0.0f);
+
+    BOOST_REQUIRE_EQUAL(streamingTerrain->numberOfLoadedTiles(), TILES_IN_RANGE);
+
+    // Every tile is still within the unload distance, and no new one comes within the load distance
+    streamingTerrain->setFocus(glm::vec3(2.0f, 0.0f, 0.0f));
+    streamingTerrain->tick(0.0f);
+
+    BOOST_CHECK_EQUAL(graphicsEngine.destroyed, 0u);
+    BOOST_CHECK_EQUAL(streamingTerrain->numberOfPendingTiles(), 0u);
+
+    // The tile source has nothing out here, so everything is unloaded and nothing new is requested
+    streamingTerrain->setFocus(glm::vec3(1000.0f, 0.0f, 1000.0f));
+    streamingTerrain->tick(0.0f);
+
+    BOOST_CHECK_EQUAL(streamingTerrain->numberOfLoadedTiles(), 0u);
+    BOOST_CHECK_EQUAL(streamingTerrain->numberOfPendingTiles(), 0u);
+    BOOST_CHECK_EQUAL(graphicsEngine.destroyed, TILES_IN_RANGE);
+    BOOST_CHECK(graphicsEngine.terrains.empty());
+}
+
+BOOST_AUTO_TEST_CASE(HeightMapTileSource_CutsTiles)
+{
+    // 32 x 32, centered on the origin - tiles -1 and 0 along each axis
+    std::vector<byte> data(32 * 32 * 3);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<byte>((i / 3) % 32 * 8);
+    }
+
+    HeightMapTileSource tileSource(HeightMap(data, 32, 32));
+
+    BOOST_CHECK(tileSource.contains(-1, -1, TILE_SIZE));
+    BOOST_CHECK(tileSource.contains(0, 0, TILE_SIZE));
+    BOOST_CHECK(!tileSource.contains(1, 0, TILE_SIZE));
+    BOOST_CHECK(!tileSource.contains(0, -2, TILE_SIZE));
+
+    const auto left = tileSource.heights(-1, 0, TILE_SIZE);
+    const auto right = tileSource.heights(0, 0, TILE_SIZE);
+
+    BOOST_REQUIRE_EQUAL(right.width(), TILE_SIZE + 1);
+    BOOST_REQUIRE_EQUAL(right.length(), TILE_SIZE + 1);
+
+    for (uint32 j = 0; j <= TILE_SIZE; ++j)
+    {
+        // Neighbours share their edge samples, and samples past the edge of the height map are clamped to it
+        BOOST_CHECK_EQUAL(left.height(TILE_SIZE, j), right.height(0, j));
+        BOOST_CHECK_EQUAL(right.height(TILE_SIZE, j), right.height(TILE_SIZE - 1, j));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(NoiseTileSource_SharesEdges)
+{
+    NoiseTileSource tileSource((noise::Noise(1234)));
+
+    const auto left = tileSource.heights(-1, 3, TILE_SIZE);
+    const auto right = tileSource.heights(0, 3, TILE_SIZE);
+
+    BOOST_REQUIRE_EQUAL(left.width(), TILE_SIZE + 1);
+
+    for (uint32 j = 0; j <= TILE_SIZE; ++j)
+    {
+        BOOST_CHECK_SMALL(left.height(TILE_SIZE, j) - right.height(0, j), 0.00001f);
+
+        BOOST_CHECK_GE(right.height(TILE_SIZE / 2, j), 0.0f);
+        BOOST_CHECK_LE(right.height(TILE_SIZE / 2, j), 1.0f);
+    }
+}
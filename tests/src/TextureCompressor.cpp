@@ -0,0 +1,112 @@
+#include <sstream>
+#include <cmath>
+
+#define BOOST_TEST_MODULE TextureCompressor
+#include <boost/test/unit_test.hpp>
+
+#include "TextureCompressor.hpp"
+#include "TextureCache.hpp"
+
+namespace
+{
+
+ice_engine::Image createGradientImage(const ice_engine::uint32 width, const ice_engine::uint32 height)
+{
+    std::vector<ice_engine::byte> data(width * height * 4);
+
+    for (ice_engine::uint32 y = 0; y < height; ++y)
+    {
+        for (ice_engine::uint32 x = 0; x < width; ++x)
+        {
+            ice_engine::byte* pixel = &data[(y * width + x) * 4];
+            pixel[0] = static_cast<ice_engine::byte>(x * 255 / width);
+            pixel[1] = static_cast<ice_engine::byte>(y * 255 / height);
+            pixel[2] = static_cast<ice_engine::byte>((x + y) * 127 / (width + height));
+            pixel[3] = static_cast<ice_engine::byte>(255 - x * 127 / width);
+        }
+    }
+
+    return ice_engine::Image(data, width, height, ice_engine::IImage::Format::FORMAT_RGBA);
+}
+
+double rootMeanSquaredError(const ice_engine::Image& a, const ice_engine::Image& b, const ice_engine::uint32 channels)
+{
+    double error = 0.0;
+
+    for (size_t i = 0; i < a.data().size(); i += 4)
+    {
+        for (ice_engine::uint32 c = 0; c < channels; ++c)
+        {
+            const double d = static_cast<double>(a.data()[i + c]) - static_cast<double>(b.data()[i + c]);
+            error += d * d;
+        }
+    }
+
+    return std::sqrt(error / (a.data().size() / 4 * channels));
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(TextureCompressor)
+
+BOOST_AUTO_TEST_CASE(generateMipChain)
+{
+    const auto image = createGradientImage(37, 21);
+
+    const auto mipChain = ice_engine::TextureCompressor::generateMipChain(image);
+
+    BOOST_REQUIRE_EQUAL(mipChain.size(), 6);
+    BOOST_CHECK_EQUAL(mipChain[1].width(), 18);
+    BOOST_CHECK_EQUAL(mipChain[1].height(), 10);
+    BOOST_CHECK_EQUAL(mipChain.back().width(), 1);
+    BOOST_CHECK_EQUAL(mipChain.back().height(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(compressRoundTrip)
+{
+    const auto image = createGradientImage(37, 21);
+    const ice_engine::TextureCompressor textureCompressor;
+
+    const std::vector<std::pair<ice_engine::graphics::ICompressedImage::Format, ice_engine::uint32>> formats = {
+        {ice_engine::graphics::ICompressedImage::Format::FORMAT_BC1, 3},
+        {ice_engine::graphics::ICompressedImage::Format::FORMAT_BC3, 4},
+        {ice_engine::graphics::ICompressedImage::Format::FORMAT_BC5, 2},
+        {ice_engine::graphics::ICompressedImage::Format::FORMAT_BC7, 4}
+    };
+
+    for (const auto& format : formats)
+    {
+        const auto compressedImage = textureCompressor.compress(image, format.first);
+
+        BOOST_CHECK_EQUAL(compressedImage.levels(), 6);
+        BOOST_CHECK_EQUAL(compressedImage.data(0).size(), 10 * 6 * ice_engine::CompressedImage::blockSize(format.first));
+
+        const auto decompressedImage = textureCompressor.decompress(compressedImage);
+
+        BOOST_CHECK_EQUAL(decompressedImage.width(), image.width());
+        BOOST_CHECK_EQUAL(decompressedImage.height(), image.height());
+        BOOST_CHECK_LT(rootMeanSquaredError(image, decompressedImage, format.second), 8.0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(saveAndLoad)
+{
+    const auto image = createGradientImage(16, 16);
+    const ice_engine::TextureCompressor textureCompressor;
+
+    const auto compressedImage = textureCompressor.compress(image, ice_engine::graphics::ICompressedImage::Format::FORMAT_BC7);
+
+    std::stringstream ss;
+    ice_engine::TextureCache::save(ss, compressedImage);
+    const auto loadedImage = ice_engine::TextureCache::load(ss);
+
+    BOOST_REQUIRE_EQUAL(loadedImage.levels(), compressedImage.levels());
+    BOOST_CHECK_EQUAL(loadedImage.format(), compressedImage.format());
+
+    for (ice_engine::uint32 i = 0; i < loadedImage.levels(); ++i)
+    {
+        BOOST_CHECK(loadedImage.data(i) == compressedImage.data(i));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,224 @@
+#include <vector>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+#define BOOST_TEST_MODULE TiledNavigationMesh
+#include <boost/test/unit_test.hpp>
+
+#include "TiledNavigationMesh.hpp"
+#include "PathfindingTerrain.hpp"
+#include "ThreadPool.hpp"
+
+#include "detail/GenerateVertices.hpp"
+
+namespace
+{
+
+using namespace ice_engine;
+using namespace ice_engine::pathfinding;
+
+/**
+ * Records tile builds - a tile's data has a byte per triangle, each holding the number of obstacles.
+ */
+class TileRecordingPathfindingEngine : public IPathfindingEngine
+{
+public:
+    std::map<std::pair<int32, int32>, std::vector<byte>> tiles;
+    mutable std::mutex mutex;
+    mutable uint32 builds = 0;
+    bool failBuilds = false;
+
+    NavigationMeshHandle createTiledNavigationMesh(const glm::vec3&, const PolygonMeshConfig&, const NavigationMeshConfig&) override
+    {
+        return NavigationMeshHandle(1, 1);
+    }
+
+    std::vector<byte> buildNavigationMeshTile(const NavigationMeshHandle&, const int32, const int32, const ITerrain* geometry, const std::vector<Obstacle>& obstacles) const override
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++builds;
+        }
+
+        if (failBuilds) throw std::runtime_error("build failed");
+
+        return std::vector<byte>(geometry->indices().size() / 3, static_cast<byte>(obstacles.size()));
+    }
+
+    void addNavigationMeshTile(const NavigationMeshHandle&, const int32 x, const int32 z, std::vector<byte> data) override
+    {
+        tiles[std::make_pair(x, z)] = std::move(data);
+    }
+
+    void removeNavigationMeshTile(const NavigationMeshHandle&, const int32 x, const int32 z) override
+    {
+        BOOST_REQUIRE_EQUAL(tiles.erase(std::make_pair(x, z)), 1u);
+    }
+
+    void tick(const PathfindingSceneHandle&, const float32) override {}
+    void renderDebug(const PathfindingSceneHandle&) override {}
+    PathfindingSceneHandle createPathfindingScene() override { return PathfindingSceneHandle(); }
+    void destroyPathfindingScene(const PathfindingSceneHandle&) override {}
+    void setPathfindingDebugRenderer(IPathfindingDebugRenderer*) override {}
+    void setDebugRendering(const PathfindingSceneHandle&, const bool) override {}
+    PolygonMeshHandle createPolygonMesh(const ITerrain*, const PolygonMeshConfig&) override { return PolygonMeshHandle(); }
+    void destroy(const PolygonMeshHandle&) override {}
+    ObstacleHandle createObstacle(const PolygonMeshHandle&, const glm::vec3&, const float32, const float32) override { return ObstacleHandle(); }
+    void destroy(const PolygonMeshHandle&, const ObstacleHandle&) override {}
+    NavigationMeshHandle createNavigationMesh(const PolygonMeshHandle&, const NavigationMeshConfig&) override { return NavigationMeshHandle(); }
+    void destroy(const NavigationMeshHandle&) override {}
+    CrowdHandle createCrowd(const PathfindingSceneHandle&, const NavigationMeshHandle&, const CrowdConfig&) override { return CrowdHandle(); }
+    void destroy(const PathfindingSceneHandle&, const CrowdHandle&) override {}
+    AgentHandle createAgent(
+        const PathfindingSceneHandle&,
+        const CrowdHandle&,
+        const glm::vec3&,
+        const AgentParams&,
+        std::unique_ptr<IAgentMotionChangeListener>,
+        std::unique_ptr<IAgentStateChangeListener>,
+        std::unique_ptr<IMovementRequestStateChangeListener>,
+        const UserTag&
+    ) override { return AgentHandle(); }
+    void destroy(const PathfindingSceneHandle&, const CrowdHandle&, const AgentHandle&) override {}
+    void requestMoveTarget(const PathfindingSceneHandle&, const CrowdHandle&, const AgentHandle&, const glm::vec3&) override {}
+    void resetMoveTarget(const PathfindingSceneHandle&, const CrowdHandle&, const AgentHandle&) override {}
+    void requestMoveVelocity(const PathfindingSceneHandle&, const CrowdHandle&, const AgentHandle&, const glm::vec3&) override {}
+    void setMotionChangeListener(const PathfindingSceneHandle&, const CrowdHandle&, const AgentHandle&, std::unique_ptr<IAgentMotionChangeListener>) override {}
+    void setStateChangeListener(const PathfindingSceneHandle&, const CrowdHandle&, const AgentHandle&, std::unique_ptr<IAgentStateChangeListener>) override {}
+    void setMovementRequestChangeListener(const PathfindingSceneHandle&, const CrowdHandle&, const AgentHandle&, std::unique_ptr<IMovementRequestStateChangeListener>) override {}
+    void setUserTag(const PathfindingSceneHandle&, const CrowdHandle&, const AgentHandle&, const UserTag&) override {}
+    UserTag getUserTag(const PathfindingSceneHandle&, const CrowdHandle&, const AgentHandle&) const override { return UserTag(); }
+};
+
+struct Geometry : public ITerrain
+{
+    std::vector<glm::vec3> v;
+    std::vector<uint32> i;
+
+    const std::vector<glm::vec3>& vertices() const override { return v; }
+    const std::vector<uint32>& indices() const override { return i; }
+};
+
+// 64x64 cells from (0, 0) to (64, 64) - with 16 cell tiles and no border that is exactly 4x4 tiles
+PathfindingTerrain createTerrain(const float height = 0.5f)
+{
+    return PathfindingTerrain(HeightGrid(std::vector<float>(65 * 65, height), 65, 65), glm::vec3());
+}
+
+PolygonMeshConfig createPolygonMeshConfig(const int borderSize)
+{
+    PolygonMeshConfig polygonMeshConfig;
+    polygonMeshConfig.tileSize = 16;
+    polygonMeshConfig.cellSize = 1.0f;
+    polygonMeshConfig.borderSize = borderSize;
+
+    return polygonMeshConfig;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(update_BuildsEveryTile)
+{
+    TileRecordingPathfindingEngine pathfindingEngine;
+    ThreadPool threadPool(4);
+
+    // Full resolution triangles, so tiles without a border split the terrain exactly
+    Geometry geometry;
+    std::tie(geometry.v, geometry.i) = detail::generateGrid(64, 64);
+
+    TiledNavigationMesh tiledNavigationMesh(&pathfindingEngine, &threadPool, glm::vec3(), createPolygonMeshConfig(0));
+    tiledNavigationMesh.setGeometry(geometry);
+
+    BOOST_CHECK_EQUAL(tiledNavigationMesh.update(), 16u);
+    BOOST_REQUIRE_EQUAL(pathfindingEngine.tiles.size(), 16u);
+
+    for (const auto& tile : pathfindingEngine.tiles)
+    {
+        BOOST_CHECK_EQUAL(tile.second.size(), 16u * 16u * 2u);
+    }
+
+    // Nothing changed, so nothing to build
+    BOOST_CHECK_EQUAL(tiledNavigationMesh.update(), 0u);
+    BOOST_CHECK_EQUAL(tiledNavigationMesh.tiles().size(), 16u);
+}
+
+BOOST_AUTO_TEST_CASE(update_Border)
+{
+    TileRecordingPathfindingEngine pathfindingEngine;
+
+    const auto terrain = createTerrain();
+
+    TiledNavigationMesh tiledNavigationMesh(&pathfindingEngine, nullptr, glm::vec3(), createPolygonMeshConfig(2));
+    tiledNavigationMesh.setGeometry(terrain);
+    tiledNavigationMesh.update();
+
+    // The border reaches into the tiles around the terrain, which then get built too
+    BOOST_CHECK_EQUAL(pathfindingEngine.tiles.size(), 6u * 6u);
+}
+
+BOOST_AUTO_TEST_CASE(obstacles_RebuildTouchedTiles)
+{
+    TileRecordingPathfindingEngine pathfindingEngine;
+    ThreadPool threadPool(4);
+
+    const auto terrain = createTerrain();
+
+    TiledNavigationMesh tiledNavigationMesh(&pathfindingEngine, &threadPool, glm::vec3(), createPolygonMeshConfig(0));
+    tiledNavigationMesh.setGeometry(terrain);
+    tiledNavigationMesh.update();
+
+    // Straddles the corner of four tiles
+    const auto obstacleHandle = tiledNavigationMesh.createObstacle(glm::vec3(32.0f, 7.5f, 32.0f), 2.0f, 2.0f);
+
+    pathfindingEngine.builds = 0;
+    BOOST_CHECK_EQUAL(tiledNavigationMesh.update(), 4u);
+    BOOST_CHECK_EQUAL(pathfindingEngine.builds, 4u);
+    BOOST_CHECK_EQUAL(pathfindingEngine.tiles.at(std::make_pair(1, 1))[0], 1u);
+    BOOST_CHECK_EQUAL(pathfindingEngine.tiles.at(std::make_pair(2, 2))[0], 1u);
+    BOOST_CHECK_EQUAL(pathfindingEngine.tiles.at(std::make_pair(0, 0))[0], 0u);
+
+    tiledNavigationMesh.destroy(obstacleHandle);
+
+    BOOST_CHECK_EQUAL(tiledNavigationMesh.update(), 4u);
+    BOOST_CHECK_EQUAL(pathfindingEngine.tiles.at(std::make_pair(1, 1))[0], 0u);
+}
+
+BOOST_AUTO_TEST_CASE(setGeometry_RebuildsEditedArea)
+{
+    TileRecordingPathfindingEngine pathfindingEngine;
+
+    TiledNavigationMesh tiledNavigationMesh(&pathfindingEngine, nullptr, glm::vec3(), createPolygonMeshConfig(0));
+    tiledNavigationMesh.setGeometry(createTerrain());
+    tiledNavigationMesh.update();
+
+    // An edit inside a single tile
+    tiledNavigationMesh.setGeometry(createTerrain(0.6f), glm::vec3(20.0f, 0.0f, 36.0f), glm::vec3(24.0f, 10.0f, 40.0f));
+    BOOST_CHECK_EQUAL(tiledNavigationMesh.update(), 1u);
+
+    // Geometry that covers fewer tiles removes the rest
+    const PathfindingTerrain smaller(HeightGrid(std::vector<float>(17 * 17, 0.5f), 17, 17), glm::vec3());
+    tiledNavigationMesh.setGeometry(smaller);
+    tiledNavigationMesh.update();
+
+    BOOST_CHECK_EQUAL(pathfindingEngine.tiles.size(), 1u);
+    BOOST_CHECK_EQUAL(tiledNavigationMesh.tiles().size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(update_FailedBuildsStayMarked)
+{
+    TileRecordingPathfindingEngine pathfindingEngine;
+    ThreadPool threadPool(4);
+
+    TiledNavigationMesh tiledNavigationMesh(&pathfindingEngine, &threadPool, glm::vec3(), createPolygonMeshConfig(0));
+    tiledNavigationMesh.setGeometry(createTerrain());
+
+    pathfindingEngine.failBuilds = true;
+    BOOST_CHECK_THROW(tiledNavigationMesh.update(), std::runtime_error);
+    BOOST_CHECK(pathfindingEngine.tiles.empty());
+
+    // The tiles that failed are built by the next update
+    pathfindingEngine.failBuilds = false;
+    BOOST_CHECK_EQUAL(tiledNavigationMesh.update(), 16u);
+    BOOST_CHECK_EQUAL(pathfindingEngine.tiles.size(), 16u);
+}